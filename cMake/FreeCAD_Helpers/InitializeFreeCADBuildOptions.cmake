@@ -14,6 +14,7 @@ macro(InitializeFreeCADBuildOptions)
     option(BUILD_DYNAMIC_LINK_PYTHON "If OFF extension-modules do not link against python-libraries" ON)
     option(INSTALL_TO_SITEPACKAGES "If ON the freecad root namespace (python) is installed into python's site-packages" OFF)
     option(OCCT_CMAKE_FALLBACK "disable usage of occt-config files" OFF)
+    option(FREECAD_MESH_32BIT_INDICES "Store point and facet indices of meshes with 32 bits to reduce memory (max. 2^32-1 elements)." OFF)
     if (WIN32 OR APPLE)
         option(FREECAD_USE_QT_FILEDIALOG "Use Qt's file dialog instead of the native one." OFF)
     else()
@@ -13,6 +13,11 @@ macro(SetGlobalCompilerAndLinkerSettings)
         message(STATUS "Platform is 32-bit")
     endif(CMAKE_SIZEOF_VOID_P EQUAL 8)
 
+    # compact mesh elements, must be set globally as it changes the layout of the mesh kernel
+    if(FREECAD_MESH_32BIT_INDICES)
+        add_definitions(-DMESH_32BIT_INDICES)
+    endif(FREECAD_MESH_32BIT_INDICES)
+
     # check for mips64 platform
     if("${CMAKE_SYSTEM_PROCESSOR}" STREQUAL "mips64")
         message(STATUS "Architecture: mips64")
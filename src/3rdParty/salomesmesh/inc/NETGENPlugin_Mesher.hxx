@@ -122,6 +122,8 @@ class NETGENPLUGIN_EXPORT NETGENPlugin_Mesher
   void SetParameters(const NETGENPlugin_Hypothesis*          hyp);
   void SetParameters(const NETGENPlugin_SimpleHypothesis_2D* hyp);
   void SetViscousLayers2DAssigned(bool isAssigned) { _isViscousLayers2D = isAssigned; }
+  // mesh the volume domains in parallel, nbThreads == 0 keeps the netgen default
+  void SetParallelMeshing(bool toParallel, int nbThreads = 0);
 
   bool Compute();
 
@@ -188,6 +190,8 @@ class NETGENPLUGIN_EXPORT NETGENPlugin_Mesher
 
   void SetDefaultParameters();
 
+  bool compute();
+
   static void RemoveTmpFiles();
 
   static SMESH_ComputeErrorPtr ReadErrors(const std::vector< const SMDS_MeshNode* >& nodeVec);
@@ -204,6 +208,8 @@ class NETGENPLUGIN_EXPORT NETGENPlugin_Mesher
   bool                 _optimize;
   int                  _fineness;
   bool                 _isViscousLayers2D;
+  bool                 _parallelMeshing;
+  int                  _nbThreads;
 #if NETGEN_VERSION < NETGEN_VERSION_STRING(6,0,0)
   netgen::Mesh*        _ngMesh;
 #else
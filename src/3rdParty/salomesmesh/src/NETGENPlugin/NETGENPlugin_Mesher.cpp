@@ -162,6 +162,8 @@ NETGENPlugin_Mesher::NETGENPlugin_Mesher (SMESH_Mesh*         mesh,
     _optimize(true),
     _fineness(NETGENPlugin_Hypothesis::GetDefaultFineness()),
     _isViscousLayers2D(false),
+    _parallelMeshing(false),
+    _nbThreads(0),
     _ngMesh(NULL),
     _occgeom(NULL),
     _curShapeIndex(-1),
@@ -2433,11 +2435,58 @@ namespace
 
 //=============================================================================
 /*!
- * Here we are going to use the NETGEN mesher
+ * Let netgen mesh the volume domains in parallel
+ */
+//=============================================================================
+
+void NETGENPlugin_Mesher::SetParallelMeshing(bool toParallel, int nbThreads)
+{
+  _parallelMeshing = toParallel;
+  _nbThreads       = nbThreads;
+}
+
+//=============================================================================
+/*!
+ * Runs the meshing, within the netgen task manager if the volume domains are
+ * to be meshed in parallel
  */
 //=============================================================================
 
 bool NETGENPlugin_Mesher::Compute()
+{
+#if NETGEN_VERSION >= NETGEN_VERSION_STRING(6,2,2102)
+  // netgen splits the volume meshing by domain on the common surface mesh,
+  // so the solids of a compound stay conformal
+  netgen::mparam.parallel_meshing = _parallelMeshing;
+  if ( _parallelMeshing )
+  {
+    if ( _nbThreads > 0 )
+      ngcore::TaskManager::SetNumThreads( _nbThreads );
+    int nbThreads = ngcore::EnterTaskManager();
+    bool ok = false;
+    try
+    {
+      ok = compute();
+    }
+    catch (...)
+    {
+      ngcore::ExitTaskManager( nbThreads );
+      throw;
+    }
+    ngcore::ExitTaskManager( nbThreads );
+    return ok;
+  }
+#endif
+  return compute();
+}
+
+//=============================================================================
+/*!
+ * Here we are going to use the NETGEN mesher
+ */
+//=============================================================================
+
+bool NETGENPlugin_Mesher::compute()
 {
   NETGENPlugin_NetgenLibWrapper ngLib;
 
@@ -144,6 +144,7 @@ namespace bp = boost::placeholders;
 // scriptings (scripts are built-in but can be overridden by command line option)
 #include <App/InitScript.h>
 #include <App/TestScript.h>
+#include <App/BatchScript.h>
 #include <App/CMakeScript.h>
 
 #ifdef _MSC_VER // New handler for Microsoft Visual C++ compiler
@@ -669,6 +670,7 @@ std::vector<Document*> Application::openDocuments(const std::vector<std::string>
         _pendingDocs.push_back(name.c_str());
 
     std::map<Document *, DocTiming> newDocs;
+    int reopenCount = 0;
 
     FC_TIME_INIT(t);
 
@@ -740,8 +742,26 @@ std::vector<Document*> Application::openDocuments(const std::vector<std::string>
         if (_pendingDocs.empty()) {
             if (_pendingDocsReopen.empty())
                 break;
-            _allowPartial = false;
+            // The first time the partial documents that lack requested objects
+            // are reopened with the objects loaded so far plus the requested ones.
+            // If that is not enough they are fully loaded.
+            if (reopenCount++)
+                _allowPartial = false;
             _pendingDocs.swap(_pendingDocsReopen);
+
+            // close the partial documents so that they are restored again below
+            for (auto name : _pendingDocs) {
+                std::string filepath = FileInfo(name).filePath();
+                for (auto &v : DocMap) {
+                    Document *doc = v.second;
+                    if ((doc->testStatus(Document::PartialDoc) || doc->testStatus(Document::PartialRestore))
+                            && FileInfo(doc->FileName.getValue()).filePath() == filepath) {
+                        newDocs.erase(doc);
+                        closeDocument(v.first.c_str());
+                        break;
+                    }
+                }
+            }
         }
     }
 
@@ -857,6 +877,14 @@ Document* Application::openDocumentPrivate(const char * FileName,
             }
             auto &names = _pendingDocMap[FileName];
             names.clear();
+            if(_allowPartial) {
+                // keep the document partial, see openDocuments()
+                for(auto obj : it->second->getObjects()) {
+                    if(!obj->testStatus(App::PartialObject))
+                        names.insert(obj->getNameInDocument());
+                }
+                names.insert(objNames.begin(), objNames.end());
+            }
             _pendingDocsReopen.push_back(FileName);
             return 0;
         }
@@ -2098,6 +2126,7 @@ void Application::initApplication(void)
     new ScriptProducer( "CMakeVariables", CMakeVariables );
     new ScriptProducer( "FreeCADInit",    FreeCADInit    );
     new ScriptProducer( "FreeCADTest",    FreeCADTest    );
+    new ScriptProducer( "FreeCADBatch",   FreeCADBatch   );
 
     // creating the application
     if (!(mConfig["Verbose"] == "Strict")) Console().Log("Create Application\n");
@@ -2465,6 +2494,8 @@ void Application::ParseOptions(int ac, char ** av)
     ("user-cfg,u", value<string>(),"User config file to load/save user settings")
     ("system-cfg,s", value<string>(),"System config file to load/save system settings")
     ("run-test,t",   value<string>()   ,"Test case - or 0 for all")
+    ("batch",        value<string>()   ,"Runs the jobs of a JSON batch file")
+    ("workers",      value<int>()      ,"Number of worker processes for --batch")
     ("module-path,M", value< vector<string> >()->composing(),"Additional module paths")
     ("python-path,P", value< vector<string> >()->composing(),"Additional python paths")
     ("single-instance", "Allow to run a single instance of the application")
@@ -2687,6 +2718,14 @@ void Application::ParseOptions(int ac, char ** av)
         //sScriptName = FreeCADTest;
     }
 
+    if (vm.count("batch")) {
+        mConfig["BatchFile"] = vm["batch"].as<string>();
+        if (vm.count("workers"))
+            mConfig["BatchWorkers"] = std::to_string(vm["workers"].as<int>());
+        mConfig["RunMode"] = "Internal";
+        mConfig["ScriptFileName"] = "FreeCADBatch";
+    }
+
     if (vm.count("single-instance")) {
         mConfig["SingleInstance"] = "1";
     }
@@ -153,6 +153,96 @@ void ComplexGeoData::getFaces(std::vector<Base::Vector3d> &Points,
     (void)flags;
 }
 
+namespace {
+
+template <typename T>
+void toBuffer(const std::vector<Base::Vector3d> &vectors, std::vector<T> &values)
+{
+    values.resize(vectors.size() * 3);
+    T* ptr = values.data();
+    for (std::vector<Base::Vector3d>::const_iterator it = vectors.begin(); it != vectors.end(); ++it) {
+        *ptr++ = static_cast<T>(it->x);
+        *ptr++ = static_cast<T>(it->y);
+        *ptr++ = static_cast<T>(it->z);
+    }
+}
+
+template <typename T>
+void pointBuffer(const ComplexGeoData* data, ComplexGeoData::GeometryBuffer<T> &buffer,
+                 float Accuracy, bool withNormals, uint16_t flags)
+{
+    std::vector<Base::Vector3d> points, normals;
+    data->getPoints(points, normals, Accuracy, flags);
+    toBuffer(points, buffer.points);
+    buffer.normals.clear();
+    if (withNormals && normals.size() == points.size())
+        toBuffer(normals, buffer.normals);
+    buffer.facets.clear();
+}
+
+template <typename T>
+void faceBuffer(const ComplexGeoData* data, ComplexGeoData::GeometryBuffer<T> &buffer,
+                float Accuracy, bool withNormals, uint16_t flags)
+{
+    std::vector<Base::Vector3d> points;
+    std::vector<ComplexGeoData::Facet> facets;
+    data->getFaces(points, facets, Accuracy, flags);
+    toBuffer(points, buffer.points);
+
+    buffer.facets.resize(facets.size() * 3);
+    uint32_t* ptr = buffer.facets.data();
+    for (std::vector<ComplexGeoData::Facet>::const_iterator it = facets.begin(); it != facets.end(); ++it) {
+        *ptr++ = it->I1;
+        *ptr++ = it->I2;
+        *ptr++ = it->I3;
+    }
+
+    buffer.normals.clear();
+    if (withNormals) {
+        // area weighted average of the normals of the adjacent facets
+        std::vector<Base::Vector3d> normals(points.size());
+        for (std::vector<ComplexGeoData::Facet>::const_iterator it = facets.begin(); it != facets.end(); ++it) {
+            if (it->I1 >= points.size() || it->I2 >= points.size() || it->I3 >= points.size())
+                continue;
+            Base::Vector3d normal = (points[it->I2] - points[it->I1]) % (points[it->I3] - points[it->I1]);
+            normals[it->I1] += normal;
+            normals[it->I2] += normal;
+            normals[it->I3] += normal;
+        }
+        for (std::vector<Base::Vector3d>::iterator it = normals.begin(); it != normals.end(); ++it) {
+            if (it->Sqr() > 0.0)
+                it->Normalize();
+        }
+        toBuffer(normals, buffer.normals);
+    }
+}
+
+}
+
+void ComplexGeoData::getPointBuffer(GeometryBuffer<float> &buffer,
+                                    float Accuracy, bool withNormals, uint16_t flags) const
+{
+    pointBuffer(this, buffer, Accuracy, withNormals, flags);
+}
+
+void ComplexGeoData::getPointBuffer(GeometryBuffer<double> &buffer,
+                                    float Accuracy, bool withNormals, uint16_t flags) const
+{
+    pointBuffer(this, buffer, Accuracy, withNormals, flags);
+}
+
+void ComplexGeoData::getFaceBuffer(GeometryBuffer<float> &buffer,
+                                   float Accuracy, bool withNormals, uint16_t flags) const
+{
+    faceBuffer(this, buffer, Accuracy, withNormals, flags);
+}
+
+void ComplexGeoData::getFaceBuffer(GeometryBuffer<double> &buffer,
+                                   float Accuracy, bool withNormals, uint16_t flags) const
+{
+    faceBuffer(this, buffer, Accuracy, withNormals, flags);
+}
+
 bool ComplexGeoData::getCenterOfGravity(Base::Vector3d&) const
 {
     return false;
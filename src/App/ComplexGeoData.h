@@ -66,6 +66,19 @@ public:
         std::vector<Base::Vector3d> points;
         std::vector<Facet> facets;
     };
+    /** Contiguous geometry buffer
+     *  The points and normals are stored as consecutive x,y,z coordinates,
+     *  the facets as consecutive triples of point indices.
+     */
+    template <typename T>
+    struct GeometryBuffer {
+        std::vector<T> points;
+        std::vector<T> normals;
+        std::vector<uint32_t> facets;
+
+        std::size_t countPoints() const { return points.size() / 3; }
+        std::size_t countFacets() const { return facets.size() / 3; }
+    };
 
     /// Constructor
     ComplexGeoData(void);
@@ -149,6 +162,22 @@ public:
     /** Get faces from object with given accuracy */
     virtual void getFaces(std::vector<Base::Vector3d> &Points,std::vector<Facet> &faces,
         float Accuracy, uint16_t flags=0) const;
+    /** Get points from object with given accuracy into a contiguous buffer
+     * The normals are only filled if \a withNormals is true and the object has any.
+     * The default implementation converts the result of getPoints().
+     */
+    virtual void getPointBuffer(GeometryBuffer<float> &buffer,
+        float Accuracy, bool withNormals=false, uint16_t flags=0) const;
+    virtual void getPointBuffer(GeometryBuffer<double> &buffer,
+        float Accuracy, bool withNormals=false, uint16_t flags=0) const;
+    /** Get faces from object with given accuracy into a contiguous buffer
+     * If \a withNormals is true the normals of the points are filled, too.
+     * The default implementation converts the result of getFaces().
+     */
+    virtual void getFaceBuffer(GeometryBuffer<float> &buffer,
+        float Accuracy, bool withNormals=false, uint16_t flags=0) const;
+    virtual void getFaceBuffer(GeometryBuffer<double> &buffer,
+        float Accuracy, bool withNormals=false, uint16_t flags=0) const;
     /** Get the center of gravity
      * If this method is implemented then true is returned and the center of gravity.
      * The default implementation only returns false.
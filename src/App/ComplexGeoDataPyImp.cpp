@@ -23,6 +23,10 @@
 
 #include "PreCompiled.h"
 
+#ifndef _PreComp_
+# include <cstring>
+#endif
+
 #include "ComplexGeoData.h"
 
 // inclusion of the generated files (generated out of ComplexGeoDataPy.xml)
@@ -82,6 +86,162 @@ PyObject*  ComplexGeoDataPy::getFacesFromSubelement(PyObject *args)
     return Py::new_reference_to(tuple);
 }
 
+namespace {
+
+// Without an explicit accuracy sample shapes with 0.5% of their size
+float arrayAccuracy(const Data::ComplexGeoData* data, double accuracy)
+{
+    if (accuracy > 0.0)
+        return static_cast<float>(accuracy);
+    Base::BoundBox3d bbox = data->getBoundBox();
+    return bbox.IsValid() ? static_cast<float>(bbox.CalcDiagonalLength() * 0.005) : 0.1f;
+}
+
+// Copy the array into a bytes object and return a read-only memoryview of
+// shape (rows,3) on it, which numpy.asarray() wraps without another copy
+PyObject* arrayView(const void* data, std::size_t rows, std::size_t itemsize, const char* format)
+{
+#if PY_MAJOR_VERSION >= 3
+    Py::Object bytes(PyBytes_FromStringAndSize(static_cast<const char*>(data),
+                                               static_cast<Py_ssize_t>(rows * 3 * itemsize)), true);
+    Py::Object view(PyMemoryView_FromObject(bytes.ptr()), true);
+    Py::Tuple shape(2);
+    shape.setItem(0, Py::Long(static_cast<long>(rows)));
+    shape.setItem(1, Py::Long(3));
+    return PyObject_CallMethod(view.ptr(), "cast", "sO", format, shape.ptr());
+#else
+    (void)data; (void)rows; (void)itemsize; (void)format;
+    throw Py::RuntimeError("Array views require Python 3");
+#endif
+}
+
+template <typename T, typename S>
+T itemAs(const char* ptr)
+{
+    S value;
+    std::memcpy(&value, ptr, sizeof(S));
+    return static_cast<T>(value);
+}
+
+template <typename T>
+T itemValue(const char* ptr, char code)
+{
+    switch (code) {
+    case 'f': return itemAs<T, float>(ptr);
+    case 'd': return itemAs<T, double>(ptr);
+    case 'b': return itemAs<T, signed char>(ptr);
+    case 'B': return itemAs<T, unsigned char>(ptr);
+    case 'h': return itemAs<T, short>(ptr);
+    case 'H': return itemAs<T, unsigned short>(ptr);
+    case 'i': return itemAs<T, int>(ptr);
+    case 'I': return itemAs<T, unsigned int>(ptr);
+    case 'l': return itemAs<T, long>(ptr);
+    case 'L': return itemAs<T, unsigned long>(ptr);
+    case 'q': return itemAs<T, long long>(ptr);
+    default:  return itemAs<T, unsigned long long>(ptr);
+    }
+}
+
+// Read a C-contiguous buffer of shape (n,3) whose item type is one of 'codes'
+template <typename T>
+bool readArray(PyObject* obj, const char* codes, std::vector<T>& values)
+{
+    Py_buffer view;
+    if (PyObject_GetBuffer(obj, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0)
+        return false;
+
+    const char* format = view.format ? view.format : "B";
+    if (*format == '@' || *format == '=')
+        ++format;
+
+    bool ok = view.ndim == 2 && view.shape[1] == 3 && format[0] != 0 && format[1] == 0
+           && std::strchr(codes, format[0]);
+    if (ok) {
+        Py_ssize_t count = view.shape[0] * 3;
+        values.resize(count);
+        const char* ptr = static_cast<const char*>(view.buf);
+        for (Py_ssize_t i = 0; i < count; ++i, ptr += view.itemsize)
+            values[i] = itemValue<T>(ptr, format[0]);
+    }
+    else {
+        PyErr_SetString(PyExc_TypeError, "expect a contiguous array with shape (n,3)");
+    }
+
+    PyBuffer_Release(&view);
+    return ok;
+}
+
+}
+
+bool ComplexGeoDataPy::readPointArray(PyObject* obj, std::vector<Base::Vector3d>& points)
+{
+    std::vector<double> values;
+    if (!readArray(obj, "fdbBhHiIlLqQ", values))
+        return false;
+
+    points.clear();
+    points.reserve(values.size() / 3);
+    for (std::size_t i = 0; i < values.size(); i += 3)
+        points.emplace_back(values[i], values[i+1], values[i+2]);
+    return true;
+}
+
+bool ComplexGeoDataPy::readFacetArray(PyObject* obj, std::vector<Data::ComplexGeoData::Facet>& facets)
+{
+    std::vector<long long> values;
+    if (!readArray(obj, "bBhHiIlLqQ", values))
+        return false;
+
+    facets.clear();
+    facets.reserve(values.size() / 3);
+    for (std::size_t i = 0; i < values.size(); i += 3) {
+        for (std::size_t j = 0; j < 3; j++) {
+            if (values[i+j] < 0 || values[i+j] > 0xffffffffLL) {
+                PyErr_SetString(PyExc_ValueError, "point index out of range");
+                return false;
+            }
+        }
+        Data::ComplexGeoData::Facet f;
+        f.I1 = static_cast<uint32_t>(values[i]);
+        f.I2 = static_cast<uint32_t>(values[i+1]);
+        f.I3 = static_cast<uint32_t>(values[i+2]);
+        facets.push_back(f);
+    }
+    return true;
+}
+
+PyObject*  ComplexGeoDataPy::getPointArray(PyObject *args)
+{
+    double accuracy = 0.0;
+    if (!PyArg_ParseTuple(args, "|d", &accuracy))
+        return 0;
+
+    PY_TRY {
+        Data::ComplexGeoData::GeometryBuffer<double> buffer;
+        getComplexGeoDataPtr()->getPointBuffer(buffer, arrayAccuracy(getComplexGeoDataPtr(), accuracy));
+        return arrayView(buffer.points.data(), buffer.countPoints(), sizeof(double), "d");
+    }
+    PY_CATCH
+}
+
+PyObject*  ComplexGeoDataPy::getFaceArrays(PyObject *args)
+{
+    double accuracy = 0.0;
+    if (!PyArg_ParseTuple(args, "|d", &accuracy))
+        return 0;
+
+    PY_TRY {
+        Data::ComplexGeoData::GeometryBuffer<double> buffer;
+        getComplexGeoDataPtr()->getFaceBuffer(buffer, arrayAccuracy(getComplexGeoDataPtr(), accuracy));
+
+        Py::Tuple tuple(2);
+        tuple.setItem(0, Py::asObject(arrayView(buffer.points.data(), buffer.countPoints(), sizeof(double), "d")));
+        tuple.setItem(1, Py::asObject(arrayView(buffer.facets.data(), buffer.countFacets(), sizeof(uint32_t), "I")));
+        return Py::new_reference_to(tuple);
+    }
+    PY_CATCH
+}
+
 Py::Object ComplexGeoDataPy::getBoundBox(void) const
 {
     return Py::BoundingBox(getComplexGeoDataPtr()->getBoundBox());
@@ -88,8 +88,14 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include <unordered_map>
 #include <random>
 
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <ctime>
+
 #include <QCoreApplication>
 #include <QCryptographicHash>
+#include <QtConcurrentMap>
 
 #include "AutoTransaction.h"
 #include "Document.h"
@@ -97,6 +103,7 @@ recompute path. Also, it enables more complicated dependencies beyond trees.
 #include "DocumentObject.h"
 #include "MergeDocuments.h"
 #include "ExpressionParser.h"
+#include "PropertyPythonObject.h"
 #include <App/DocumentPy.h>
 
 #include <Base/Console.h>
@@ -170,6 +177,17 @@ struct DocumentP
     std::unordered_set<App::DocumentObject*> touchedObjs;
     std::unordered_map<std::string,DocumentObject*> objectMap;
     std::unordered_map<long,DocumentObject*> objectIdMap;
+    // Numeric suffixes in use per object name stem, e.g. "Box" -> {"001", "002"},
+    // so that getUniqueObjectName() does not have to scan all names
+    struct SuffixCompare {
+        // same order as used by Base::Tools::getUniqueName()
+        bool operator()(const std::string &a, const std::string &b) const {
+            return a.size() < b.size() || (a.size() == b.size() && a < b);
+        }
+    };
+    std::unordered_map<std::string, std::set<std::string, SuffixCompare> > nameSuffixes;
+    // Objects by label, updated on relabel, see Document::_relabelObject()
+    std::unordered_map<std::string, std::vector<DocumentObject*> > labelMap;
     std::unordered_map<std::string, bool> partialLoadObjects;
     long lastObjectId;
     DocumentObject* activeObject;
@@ -192,6 +210,157 @@ struct DocumentP
     std::multimap<const App::DocumentObject*,
         std::unique_ptr<App::DocumentObjectExecReturn> > _RecomputeLog;
 
+    // Used by the parallel recompute. While objects are executed in worker
+    // threads, property change notifications are queued and emitted in the
+    // main thread once the batch has finished.
+    std::mutex recomputeMutex;
+    bool deferChangeSignals;
+    struct DeferredChange {
+        DocumentObject *obj;
+        const Property *prop;
+        bool before;
+    };
+    std::vector<DeferredChange> deferredChanges;
+
+    // Used by Document::beginBatchUpdate(). Property change notifications are
+    // coalesced per object and property, and emitted once the outermost batch
+    // is closed. Objects and properties are referred to by ID and name, so
+    // that anything removed while batching is simply skipped.
+    int batchUpdate;
+    struct BatchChange {
+        long id;
+        std::string prop;
+        bool before;
+        bool changed;
+    };
+    std::vector<BatchChange> batchChanges;
+    std::map<std::pair<long,std::string>, std::size_t> batchIndex;
+
+    void queueBatchChange(const DocumentObject *obj, const Property *prop, bool before) {
+        const char *name = prop->getName();
+        if(!name || !obj->getNameInDocument())
+            return;
+        auto key = std::make_pair(obj->getID(),std::string(name));
+        auto it = batchIndex.find(key);
+        if(it == batchIndex.end()) {
+            it = batchIndex.emplace(key,batchChanges.size()).first;
+            batchChanges.push_back({key.first,key.second,false,false});
+        }
+        auto &change = batchChanges[it->second];
+        if(before)
+            change.before = true;
+        else
+            change.changed = true;
+    }
+
+    // Cached topological order of all objects in this document, used by
+    // Document::getDependencyList() to avoid rebuilding the dependency graph
+    // on each call. The cache is invalidated whenever any link property of
+    // the document changes, or an object is added or removed.
+    struct DependencyCache {
+        long revision = -1;
+        bool valid = false;
+        std::vector<DocumentObject*> objects;
+        std::unordered_map<const DocumentObject*, size_t> index;
+    };
+    std::map<int, DependencyCache> depCaches;
+    // Results of Document::getObjectsOfType() by type key, invalidated
+    // together with the dependency caches
+    std::unordered_map<unsigned int, std::vector<DocumentObject*> > typeCache;
+    long typeCacheRevision = -1;
+    long depRevision;
+    Document::DependencyCacheStats depStats;
+
+    void dependencyChanged() {
+        ++depRevision;
+    }
+
+    static bool splitName(const std::string &name, std::string &stem, std::string &suffix) {
+        std::string::size_type pos = name.find_last_not_of("0123456789");
+        if (pos == std::string::npos || pos+1 == name.size())
+            return false;
+        stem = name.substr(0, pos+1);
+        suffix = name.substr(pos+1);
+        return true;
+    }
+
+    void addObjectName(const std::string &name) {
+        std::string stem, suffix;
+        if (splitName(name, stem, suffix))
+            nameSuffixes[stem].insert(suffix);
+    }
+
+    void removeObjectName(const std::string &name) {
+        std::string stem, suffix;
+        if (!splitName(name, stem, suffix))
+            return;
+        auto it = nameSuffixes.find(stem);
+        if (it != nameSuffixes.end()) {
+            it->second.erase(suffix);
+            if (it->second.empty())
+                nameSuffixes.erase(it);
+        }
+    }
+
+    void addObjectLabel(DocumentObject *obj, const std::string &label) {
+        auto &objs = labelMap[label];
+        if (std::find(objs.begin(), objs.end(), obj) == objs.end())
+            objs.push_back(obj);
+    }
+
+    void removeObjectLabel(DocumentObject *obj, const std::string &label) {
+        auto it = labelMap.find(label);
+        if (it == labelMap.end())
+            return;
+        auto &objs = it->second;
+        objs.erase(std::remove(objs.begin(), objs.end(), obj), objs.end());
+        if (objs.empty())
+            labelMap.erase(it);
+    }
+
+    // Recompute profiling, see Document::setRecomputeProfiling()
+    struct ProfileEvent {
+        std::string name;
+        double start;
+        double duration;
+        int thread;
+    };
+    bool profiling;
+    std::chrono::steady_clock::time_point profileStart;
+    std::map<std::string, Document::RecomputeProfile> profile;
+    std::vector<ProfileEvent> profileEvents;
+    std::map<std::thread::id, int> profileThreads;
+
+    void addProfile(DocumentObject *obj,
+            std::chrono::steady_clock::time_point start, double wallTime, double cpuTime)
+    {
+        // cap the number of trace events to keep memory bounded in long sessions
+        static const std::size_t MaxProfileEvents = 100000;
+
+        std::lock_guard<std::mutex> lock(recomputeMutex);
+        const char *name = obj->getNameInDocument();
+        if(!name)
+            return;
+        auto &entry = profile[name];
+        if(!entry.count)
+            entry.name = name;
+        entry.label = obj->Label.getStrValue();
+        ++entry.count;
+        entry.wallTime += wallTime;
+        entry.cpuTime += cpuTime;
+        if(profileEvents.size() < MaxProfileEvents) {
+            auto res = profileThreads.insert(std::make_pair(
+                        std::this_thread::get_id(), (int)profileThreads.size()));
+            profileEvents.push_back({name,
+                    std::chrono::duration<double>(start-profileStart).count(),
+                    wallTime, res.first->second});
+        }
+    }
+
+    bool getCachedDependencyList(Document *doc,
+            const std::vector<DocumentObject*> &objs,
+            int options, std::vector<DocumentObject*> &ret);
+
     DocumentP() {
         static std::random_device _RD;
         static std::mt19937 _RGEN(_RD());
@@ -207,6 +376,11 @@ struct DocumentP
         undoing = false;
         committing = false;
         opentransaction = false;
+        deferChangeSignals = false;
+        batchUpdate = 0;
+        depRevision = 0;
+        depStats = {0, 0, 0};
+        profiling = false;
         StatusBits.set((size_t)Document::Closable, true);
         StatusBits.set((size_t)Document::KeepTrailingDigits, true);
         StatusBits.set((size_t)Document::Restoring, false);
@@ -228,6 +402,7 @@ struct DocumentP
             delete returnCode;
             return;
         }
+        std::lock_guard<std::mutex> lock(recomputeMutex);
         _RecomputeLog.emplace(returnCode->Which, std::unique_ptr<DocumentObjectExecReturn>(returnCode));
         returnCode->Which->setStatus(ObjectStatus::Error,true);
     }
@@ -1240,6 +1415,19 @@ void Document::_commitTransaction(bool notify)
             delete mUndoTransactions.front();
             mUndoTransactions.pop_front();
         }
+        if(d->UndoMemSize) {
+            mUndoTransactions.back()->compact();
+            // keep the most recent transactions within the budget in memory
+            // and move the older ones into temporary files
+            unsigned long size = 0;
+            for(auto rit=mUndoTransactions.rbegin();rit!=mUndoTransactions.rend();++rit) {
+                if((*rit)->isSpilled())
+                    continue;
+                size += (*rit)->getMemSize();
+                if(size > d->UndoMemSize && rit!=mUndoTransactions.rbegin())
+                    (*rit)->spill();
+            }
+        }
         signalCommitTransaction(*this);
 
         // closeActiveTransaction() may call again _commitTransaction()
@@ -1331,12 +1519,15 @@ void Document::clearDocument()
     if(this->d->objectArray.size()) {
         GetApplication().signalDeleteDocument(*this);
         this->d->objectArray.clear();
+        this->d->dependencyChanged();
         for(auto &v : this->d->objectMap) {
             v.second->setStatus(ObjectStatus::Destroy, true);
             delete(v.second);
         }
         this->d->objectMap.clear();
         this->d->objectIdMap.clear();
+        this->d->nameSuffixes.clear();
+        this->d->labelMap.clear();
         GetApplication().signalNewDocument(*this,false);
     }
 
@@ -1346,8 +1537,11 @@ void Document::clearDocument()
 
     this->d->clearRecomputeLog();
     this->d->objectArray.clear();
+    this->d->dependencyChanged();
     this->d->objectMap.clear();
     this->d->objectIdMap.clear();
+    this->d->nameSuffixes.clear();
+    this->d->labelMap.clear();
     this->d->lastObjectId = 0;
 }
 
@@ -1435,6 +1629,16 @@ int Document::getUndoMode(void) const
 }
 
 unsigned int Document::getUndoMemSize (void) const
+{
+    unsigned int size = 0;
+    for (auto transaction : mUndoTransactions)
+        size += transaction->getMemSize();
+    for (auto transaction : mRedoTransactions)
+        size += transaction->getMemSize();
+    return size;
+}
+
+unsigned int Document::getUndoLimit() const
 {
     return d->UndoMemSize;
 }
@@ -1507,8 +1711,23 @@ void Document::onChanged(const Property* prop)
 
 void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Property *What)
 {
-    if(Who->isDerivedFrom(App::DocumentObject::getClassTypeId()))
-        signalBeforeChangeObject(*static_cast<const App::DocumentObject*>(Who), *What);
+    if(d->deferChangeSignals) {
+        std::lock_guard<std::mutex> lock(d->recomputeMutex);
+        if(Who->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
+            d->deferredChanges.push_back({const_cast<DocumentObject*>(
+                        static_cast<const DocumentObject*>(Who)),What,true});
+        }
+        if(!d->rollback && !_IsRelabeling && d->activeUndoTransaction)
+            d->activeUndoTransaction->addObjectChange(Who,What);
+        return;
+    }
+    if(Who->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
+        auto obj = static_cast<const App::DocumentObject*>(Who);
+        if(d->batchUpdate)
+            d->queueBatchChange(obj,What,true);
+        else
+            signalBeforeChangeObject(*obj, *What);
+    }
     if(!d->rollback && !_IsRelabeling) {
         _checkTransaction(0,What,__LINE__);
         if (d->activeUndoTransaction)
@@ -1518,9 +1737,63 @@ void Document::onBeforeChangeProperty(const TransactionalObject *Who, const Prop
 
 void Document::onChangedProperty(const DocumentObject *Who, const Property *What)
 {
+    if(d->deferChangeSignals) {
+        std::lock_guard<std::mutex> lock(d->recomputeMutex);
+        d->deferredChanges.push_back({const_cast<DocumentObject*>(Who),What,false});
+        return;
+    }
+    if(d->batchUpdate) {
+        d->queueBatchChange(Who,What,false);
+        return;
+    }
     signalChangedObject(*Who, *What);
 }
 
+bool Document::isDeferringChangeSignals() const
+{
+    return d->deferChangeSignals || d->batchUpdate>0;
+}
+
+void Document::beginBatchUpdate()
+{
+    ++d->batchUpdate;
+}
+
+void Document::endBatchUpdate()
+{
+    if(d->batchUpdate<=0) {
+        FC_WARN("Unbalanced endBatchUpdate() call in document " << getName());
+        return;
+    }
+    if(--d->batchUpdate)
+        return;
+
+    std::vector<DocumentP::BatchChange> changes;
+    changes.swap(d->batchChanges);
+    d->batchIndex.clear();
+    for(auto &change : changes) {
+        auto obj = getObjectByID(change.id);
+        if(!obj || !obj->getNameInDocument())
+            continue;
+        auto prop = obj->getPropertyByName(change.prop.c_str());
+        if(!prop)
+            continue;
+        if(change.before) {
+            signalBeforeChangeObject(*obj, *prop);
+            obj->signalBeforeChange(*obj, *prop);
+        }
+        if(change.changed) {
+            signalChangedObject(*obj, *prop);
+            obj->signalChanged(*obj, *prop);
+        }
+    }
+}
+
+bool Document::isBatchUpdating() const
+{
+    return d->batchUpdate>0;
+}
+
 void Document::setTransactionMode(int iMode)
 {
     d->iTransactionMode = iMode;
@@ -1650,6 +1923,7 @@ Document::~Document()
 #endif
 
     d->objectArray.clear();
+    d->dependencyChanged();
     for (auto it = d->objectMap.begin(); it != d->objectMap.end(); ++it) {
         it->second->setStatus(ObjectStatus::Destroy, true);
         delete(it->second);
@@ -2595,6 +2869,18 @@ bool Document::saveToFile(const char* filename) const
 
     auto hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
     int compression = hGrp->GetInt("CompressionLevel",3);
+    // a document may override the compression level, e.g. large documents
+    // mostly consisting of binary data can be saved faster with level 0 or 1
+    const auto &meta = Meta.getValues();
+    auto itLevel = meta.find("CompressionLevel");
+    if (itLevel != meta.end() && !itLevel->second.empty()) {
+        try {
+            compression = std::stoi(itLevel->second);
+        }
+        catch (const std::exception&) {
+            FC_WARN("Invalid compression level '" << itLevel->second << "' in document " << getName());
+        }
+    }
     compression = Base::clamp<int>(compression, Z_NO_COMPRESSION, Z_BEST_COMPRESSION);
 
     bool policy = App::GetApplication().GetParameterGroupByPath
@@ -2621,10 +2907,19 @@ bool Document::saveToFile(const char* filename) const
 
         writer.setComment("FreeCAD Document");
         writer.setLevel(compression);
+        writer.setParallel(hGrp->GetBool("ParallelSave",true));
         writer.putNextEntry("Document.xml");
 
-        if (hGrp->GetBool("SaveBinaryBrep", false))
+        if (hGrp->GetBool("SaveBinaryBrep", true))
             writer.setMode("BinaryBrep");
+        // Note: files written with shared shapes cannot be fully read by
+        // versions that don't know about it
+        if (hGrp->GetBool("SaveSharedShapes", false))
+            writer.setMode("SharedShapes");
+        // Store the triangulation of shapes so that they don't need to be
+        // tessellated again for display when the file is opened
+        if (hGrp->GetBool("SaveTriangulation", false))
+            writer.setMode("SaveTriangulation");
 
         writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl
                         << "<!--" << endl
@@ -2694,12 +2989,15 @@ void Document::restore (const char *filename,
         signal = true;
         GetApplication().signalDeleteDocument(*this);
         d->objectArray.clear();
+        d->dependencyChanged();
         for(auto &v : d->objectMap) {
             v.second->setStatus(ObjectStatus::Destroy, true);
             delete(v.second);
         }
         d->objectMap.clear();
         d->objectIdMap.clear();
+        d->nameSuffixes.clear();
+        d->labelMap.clear();
     }
 
     Base::FlagToggler<> flag(_IsRestoring,false);
@@ -2708,8 +3006,11 @@ void Document::restore (const char *filename,
 
     d->clearRecomputeLog();
     d->objectArray.clear();
+    d->dependencyChanged();
     d->objectMap.clear();
     d->objectIdMap.clear();
+    d->nameSuffixes.clear();
+    d->labelMap.clear();
     d->lastObjectId = 0;
 
     if(signal) {
@@ -2756,6 +3057,12 @@ void Document::restore (const char *filename,
     // Note: This file doesn't need to be available if the document has been created
     // without GUI. But if available then follow after all data files of the App document.
     signalRestoreDocument(reader);
+    // Let heavy data like shapes be read from the file on first access or
+    // at least be parsed in parallel
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Document");
+    reader.setDeferFiles(hGrp->GetBool("LazyLoading",false));
+    reader.setParallel(hGrp->GetBool("ParallelRestore",true));
     reader.readFiles(zipstream);
 
     if (reader.testStatus(Base::XMLReader::ReaderStatus::PartialRestore)) {
@@ -3103,11 +3410,11 @@ static void _buildDependencyList(const std::vector<App::DocumentObject*> &object
     }
 }
 
-std::vector<App::DocumentObject*> Document::getDependencyList(
-    const std::vector<App::DocumentObject*>& objectArray, int options)
+static std::vector<App::DocumentObject*> _getDependencyList(
+    const std::vector<App::DocumentObject*>& objectArray, int options, bool *hasCycle=0)
 {
     std::vector<App::DocumentObject*> ret;
-    if(!(options & DepSort)) {
+    if(!(options & Document::DepSort)) {
         _buildDependencyList(objectArray,options,&ret,0,0);
         return ret;
     }
@@ -3125,7 +3432,12 @@ std::vector<App::DocumentObject*> Document::getDependencyList(
     try {
         boost::topological_sort(depList, std::front_inserter(make_order));
     } catch (const std::exception& e) {
-        if(options & DepNoCycle) {
+        if(hasCycle) {
+            // caller only wants to know about the cycle
+            *hasCycle = true;
+            return ret;
+        }
+        if(options & Document::DepNoCycle) {
             // Use boost::strong_components to find cycles. It groups strongly
             // connected vertices as components, and therefore each component
             // forms a cycle.
@@ -3180,6 +3492,108 @@ std::vector<App::DocumentObject*> Document::getDependencyList(
     return ret;
 }
 
+bool DocumentP::getCachedDependencyList(Document *doc,
+        const std::vector<DocumentObject*> &objs, int options, std::vector<DocumentObject*> &ret)
+{
+    int op = options & Document::DepNoXLinked;
+    auto &cache = depCaches[op];
+    if(cache.revision != depRevision) {
+        ++depStats.rebuilds;
+        cache.revision = depRevision;
+        cache.objects.clear();
+        cache.index.clear();
+        bool hasCycle = false;
+        cache.objects = _getDependencyList(objectArray, op|Document::DepSort, &hasCycle);
+        // Only cache an acyclic graph that is fully contained in this
+        // document, because we are not notified about changes of external
+        // documents.
+        cache.valid = !hasCycle;
+        for(size_t i=0; cache.valid && i<cache.objects.size(); ++i) {
+            auto obj = cache.objects[i];
+            if(obj->getDocument() != doc)
+                cache.valid = false;
+            else
+                cache.index[obj] = i;
+        }
+        if(!cache.valid) {
+            cache.objects.clear();
+            cache.index.clear();
+        }
+    }
+    if(!cache.valid) {
+        ++depStats.misses;
+        return false;
+    }
+
+    if(&objs == &objectArray) {
+        ++depStats.hits;
+        ret = cache.objects;
+        return true;
+    }
+
+    // Collect the dependency closure of the given objects, and order it
+    // using the cached topological order of the whole document.
+    int outListOption = (options & Document::DepNoXLinked)?DocumentObject::OutListNoXLinked:0;
+    std::vector<size_t> indices;
+    std::unordered_set<DocumentObject*> visited;
+    std::vector<DocumentObject*> pending(objs.begin(), objs.end());
+    while(pending.size()) {
+        auto obj = pending.back();
+        pending.pop_back();
+        if(!obj || !obj->getNameInDocument() || !visited.insert(obj).second)
+            continue;
+        auto it = cache.index.find(obj);
+        if(it == cache.index.end()) {
+            ++depStats.misses;
+            return false;
+        }
+        indices.push_back(it->second);
+        for(auto dep : obj->getOutList(outListOption))
+            pending.push_back(dep);
+    }
+    std::sort(indices.begin(), indices.end());
+    ret.clear();
+    ret.reserve(indices.size());
+    for(auto i : indices)
+        ret.push_back(cache.objects[i]);
+    ++depStats.hits;
+    return true;
+}
+
+std::vector<App::DocumentObject*> Document::getDependencyList(
+    const std::vector<App::DocumentObject*>& objectArray, int options)
+{
+    if(options & DepSort) {
+        // Use the cached order if all objects come from the same document
+        Document *doc = 0;
+        bool sameDoc = true;
+        for(auto obj : objectArray) {
+            if(!obj || !obj->getNameInDocument())
+                continue;
+            if(!doc)
+                doc = obj->getDocument();
+            else if(doc != obj->getDocument()) {
+                sameDoc = false;
+                break;
+            }
+        }
+        std::vector<App::DocumentObject*> ret;
+        if(doc && sameDoc && doc->d->getCachedDependencyList(doc,objectArray,options,ret))
+            return ret;
+    }
+    return _getDependencyList(objectArray,options);
+}
+
+Document::DependencyCacheStats Document::getDependencyCacheStats() const
+{
+    return d->depStats;
+}
+
+void Document::_dependencyChanged()
+{
+    d->dependencyChanged();
+}
+
 std::vector<App::Document*> Document::getDependentDocuments(bool sort) {
     return getDependentDocuments({this},sort);
 }
@@ -3275,6 +3689,14 @@ void Document::renameObjectIdentifiers(const std::map<App::ObjectIdentifier, App
             (*it)->renameObjectIdentifiers(extendedPaths);
 }
 
+static bool _canRecomputeConcurrently(DocumentObject *obj)
+{
+    // Expressions may call into Python, so only objects without any
+    // expression bound are dispatched to worker threads.
+    return obj->allowConcurrentRecompute()
+        && obj->ExpressionEngine.numExpressions() == 0;
+}
+
 #ifdef USE_OLD_DAG
 int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool force)
 {
@@ -3471,8 +3893,31 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
     ParameterGrp::handle hGrp = GetApplication().GetParameterGroupByPath(
             "User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute",true);
+    bool parallel = hGrp->GetBool("ParallelRecompute",false);
+
+    // For parallel recompute, stable sort the objects by their dependency
+    // depth. Objects of the same depth do not depend on each other, and the
+    // resulting order is still a valid topological order.
+    std::unordered_map<App::DocumentObject*, int> levels;
+    if(parallel && topoSortedObjects.size()>1) {
+        for(auto obj : topoSortedObjects) {
+            int level = 0;
+            for(auto dep : obj->getOutList()) {
+                auto it = levels.find(dep);
+                if(it!=levels.end() && it->second>=level)
+                    level = it->second+1;
+            }
+            levels[obj] = level;
+        }
+        std::stable_sort(topoSortedObjects.begin(),topoSortedObjects.end(),
+            [&levels](App::DocumentObject *a, App::DocumentObject *b) {
+                return levels[a] < levels[b];
+            });
+    } else
+        parallel = false;
 
     std::set<App::DocumentObject *> filter;
+    std::map<App::DocumentObject *, int> batchResults;
     size_t idx = 0;
 
     FC_TIME_INIT(t2);
@@ -3484,16 +3929,47 @@ int Document::recompute(const std::vector<App::DocumentObject*> &objs, bool forc
             if(canAbort)
                 seq.reset(new Base::SequencerLauncher("Recompute...", topoSortedObjects.size()));
             FC_LOG("Recompute pass " << passes);
+            batchResults.clear();
             for (;idx<topoSortedObjects.size();(seq?seq->next(true):true),++idx) {
                 auto obj = topoSortedObjects[idx];
                 if(!obj->getNameInDocument() || filter.find(obj)!=filter.end())
                     continue;
                 // ask the object if it should be recomputed
                 bool doRecompute = false;
-                if (obj->mustRecompute()) {
+                auto itRes = batchResults.find(obj);
+                if (itRes!=batchResults.end() || obj->mustRecompute()) {
                     doRecompute = true;
                     ++objectCount;
-                    int res = _recomputeFeature(obj);
+                    int res;
+                    if(itRes!=batchResults.end()) {
+                        // already recomputed as part of a parallel batch
+                        res = itRes->second;
+                        batchResults.erase(itRes);
+                    } else if(parallel && _canRecomputeConcurrently(obj)) {
+                        // collect the following objects of the same
+                        // dependency depth that can be recomputed together
+                        std::vector<App::DocumentObject*> batch(1,obj);
+                        int level = levels[obj];
+                        for(size_t j=idx+1; j<topoSortedObjects.size(); ++j) {
+                            auto o = topoSortedObjects[j];
+                            if(levels[o] != level)
+                                break;
+                            if(o->getNameInDocument() && !filter.count(o)
+                                    && _canRecomputeConcurrently(o)
+                                    && o->mustRecompute())
+                                batch.push_back(o);
+                        }
+                        if(batch.size() == 1)
+                            res = _recomputeFeature(obj);
+                        else {
+                            FC_LOG("Recompute " << batch.size() << " objects in parallel");
+                            auto results = _recomputeFeatures(batch);
+                            for(size_t j=1; j<batch.size(); ++j)
+                                batchResults[batch[j]] = results[j];
+                            res = results[0];
+                        }
+                    } else
+                        res = _recomputeFeature(obj);
                     if(res) {
                         if(hasError)
                             *hasError = true;
@@ -3733,11 +4209,151 @@ const char * Document::getErrorDescription(const App::DocumentObject*Obj) const
     return d->findRecomputeLog(Obj);
 }
 
+static double _threadCpuTime()
+{
+#if defined(FC_OS_LINUX) || defined(FC_OS_MACOSX) || defined(FC_OS_BSD)
+    struct timespec ts;
+    if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return ts.tv_sec + ts.tv_nsec*1e-9;
+#endif
+    return double(std::clock())/CLOCKS_PER_SEC;
+}
+
+namespace App {
+// Helper class to time a call of Document::_recomputeFeature()
+class RecomputeTimer {
+public:
+    RecomputeTimer(DocumentP *d, DocumentObject *obj)
+        : d(d), obj(obj), enabled(d->profiling)
+    {
+        if(enabled) {
+            start = std::chrono::steady_clock::now();
+            cpuStart = _threadCpuTime();
+        }
+    }
+    ~RecomputeTimer() {
+        if(enabled) {
+            std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+            d->addProfile(obj, start, wall.count(), _threadCpuTime()-cpuStart);
+        }
+    }
+private:
+    DocumentP *d;
+    DocumentObject *obj;
+    bool enabled;
+    std::chrono::steady_clock::time_point start;
+    double cpuStart;
+};
+}
+
+void Document::setRecomputeProfiling(bool enable)
+{
+    if(enable && !d->profiling && d->profile.empty())
+        d->profileStart = std::chrono::steady_clock::now();
+    d->profiling = enable;
+}
+
+bool Document::isRecomputeProfiling() const
+{
+    return d->profiling;
+}
+
+std::vector<Document::RecomputeProfile> Document::getRecomputeProfile() const
+{
+    std::vector<RecomputeProfile> ret;
+    std::lock_guard<std::mutex> lock(d->recomputeMutex);
+    ret.reserve(d->profile.size());
+    for(auto &v : d->profile)
+        ret.push_back(v.second);
+    std::sort(ret.begin(), ret.end(), [](const RecomputeProfile &a, const RecomputeProfile &b) {
+        return a.wallTime > b.wallTime;
+    });
+    return ret;
+}
+
+void Document::clearRecomputeProfile()
+{
+    std::lock_guard<std::mutex> lock(d->recomputeMutex);
+    d->profile.clear();
+    d->profileEvents.clear();
+    d->profileThreads.clear();
+    d->profileStart = std::chrono::steady_clock::now();
+}
+
+static std::string _jsonString(const std::string &s)
+{
+    std::ostringstream ss;
+    ss << '"';
+    for(unsigned char c : s) {
+        switch(c) {
+        case '"':
+            ss << "\\\"";
+            break;
+        case '\\':
+            ss << "\\\\";
+            break;
+        case '\n':
+            ss << "\\n";
+            break;
+        case '\t':
+            ss << "\\t";
+            break;
+        default:
+            if(c < 0x20) {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                ss << buf;
+            } else
+                ss << c;
+        }
+    }
+    ss << '"';
+    return ss.str();
+}
+
+void Document::exportRecomputeProfile(std::ostream &out, bool chromeTrace) const
+{
+    if(!chromeTrace) {
+        out << "[";
+        bool first = true;
+        for(auto &entry : getRecomputeProfile()) {
+            out << (first?"\n  ":",\n  ")
+                << "{\"name\": " << _jsonString(entry.name)
+                << ", \"label\": " << _jsonString(entry.label)
+                << ", \"count\": " << entry.count
+                << ", \"wallTime\": " << entry.wallTime
+                << ", \"cpuTime\": " << entry.cpuTime << "}";
+            first = false;
+        }
+        out << "\n]\n";
+        return;
+    }
+
+    // Chrome trace event format with timestamps in micro seconds
+    std::lock_guard<std::mutex> lock(d->recomputeMutex);
+    out << "{\"traceEvents\": [";
+    bool first = true;
+    for(auto &ev : d->profileEvents) {
+        auto it = d->profile.find(ev.name);
+        out << (first?"\n  ":",\n  ")
+            << "{\"name\": " << _jsonString(it!=d->profile.end()?it->second.label:ev.name)
+            << ", \"cat\": \"recompute\", \"ph\": \"X\""
+            << ", \"ts\": " << std::fixed << ev.start*1e6
+            << ", \"dur\": " << ev.duration*1e6 << std::defaultfloat
+            << ", \"pid\": 0, \"tid\": " << ev.thread
+            << ", \"args\": {\"object\": " << _jsonString(ev.name) << "}}";
+        first = false;
+    }
+    out << "\n], \"displayTimeUnit\": \"ms\"}\n";
+}
+
 // call the recompute of the Feature and handle the exceptions and errors.
 int Document::_recomputeFeature(DocumentObject* Feat)
 {
     FC_LOG("Recomputing " << Feat->getFullName());
 
+    RecomputeTimer timer(d, Feat);
+
     DocumentObjectExecReturn  *returnCode = 0;
     try {
         returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
@@ -3789,6 +4405,47 @@ int Document::_recomputeFeature(DocumentObject* Feat)
     return 0;
 }
 
+std::vector<int> Document::_recomputeFeatures(const std::vector<DocumentObject*> &objs)
+{
+    std::vector<int> results(objs.size(), 0);
+    std::vector<size_t> indices(objs.size());
+    for(size_t i=0; i<indices.size(); ++i)
+        indices[i] = i;
+
+    d->deferChangeSignals = true;
+    {
+        // Release the GIL while waiting, because the worker threads may
+        // need it, e.g. when resolving sub-objects of their linked objects.
+        std::unique_ptr<Base::PyGILStateRelease> unlock;
+        if(PyGILState_Check())
+            unlock.reset(new Base::PyGILStateRelease);
+        QtConcurrent::blockingMap(indices, [&](size_t &i) {
+            results[i] = _recomputeFeature(objs[i]);
+        });
+    }
+    d->deferChangeSignals = false;
+
+    // Now emit the queued property change signals from the main thread
+    std::vector<DocumentP::DeferredChange> changes;
+    changes.swap(d->deferredChanges);
+    for(auto &change : changes) {
+        if(!change.obj->getNameInDocument())
+            continue;
+        if(d->batchUpdate) {
+            d->queueBatchChange(change.obj,change.prop,change.before);
+            continue;
+        }
+        if(change.before) {
+            signalBeforeChangeObject(*change.obj, *change.prop);
+            change.obj->signalBeforeChange(*change.obj, *change.prop);
+        } else {
+            signalChangedObject(*change.obj, *change.prop);
+            change.obj->signalChanged(*change.obj, *change.prop);
+        }
+    }
+    return results;
+}
+
 bool Document::recomputeFeature(DocumentObject* Feat, bool recursive)
 {
     // delete recompute log
@@ -3846,6 +4503,8 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName,
 
     // insert in the name map
     d->objectMap[ObjectName] = pcObject;
+    d->addObjectName(ObjectName);
+    d->addObjectLabel(pcObject, pcObject->Label.getStrValue());
     // generate object id and add to id map;
     pcObject->_Id = ++d->lastObjectId;
     d->objectIdMap[pcObject->_Id] = pcObject;
@@ -3853,6 +4512,7 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName,
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
     // insert in the vector
     d->objectArray.push_back(pcObject);
+    d->dependencyChanged();
     // insert in the adjacence list and reference through the ConectionMap
     //_DepConMap[pcObject] = add_vertex(_DepList);
 
@@ -3905,12 +4565,8 @@ std::vector<DocumentObject *> Document::addObjects(const char* sType, const std:
     std::generate(objects.begin(), objects.end(),
                   [&]{ return static_cast<App::DocumentObject*>(type.createInstance()); });
 
-    // get all existing object names
-    std::vector<std::string> reservedNames;
-    reservedNames.reserve(d->objectMap.size());
-    for (auto pos = d->objectMap.begin();pos != d->objectMap.end();++pos) {
-        reservedNames.push_back(pos->first);
-    }
+    // Coalesce the property change notifications of the whole batch
+    BatchUpdate batch(*this);
 
     for (auto it = objects.begin(); it != objects.end(); ++it) {
         auto index = std::distance(objects.begin(), it);
@@ -3927,27 +4583,13 @@ std::vector<DocumentObject *> Document::addObjects(const char* sType, const std:
         }
 
         // get unique name
-        std::string ObjectName = objectNames[index];
-        if (ObjectName.empty())
-            ObjectName = sType;
-        ObjectName = Base::Tools::getIdentifier(ObjectName);
-        if (d->objectMap.find(ObjectName) != d->objectMap.end()) {
-            // remove also trailing digits from clean name which is to avoid to create lengthy names
-            // like 'Box001001'
-            if (!testStatus(KeepTrailingDigits)) {
-                std::string::size_type index = ObjectName.find_last_not_of("0123456789");
-                if (index+1 < ObjectName.size()) {
-                    ObjectName = ObjectName.substr(0,index+1);
-                }
-            }
-
-            ObjectName = Base::Tools::getUniqueName(ObjectName, reservedNames, 3);
-        }
-
-        reservedNames.push_back(ObjectName);
+        const std::string &name = objectNames[index];
+        std::string ObjectName = getUniqueObjectName(name.empty() ? sType : name.c_str());
 
         // insert in the name map
         d->objectMap[ObjectName] = pcObject;
+        d->addObjectName(ObjectName);
+        d->addObjectLabel(pcObject, pcObject->Label.getStrValue());
         // generate object id and add to id map;
         pcObject->_Id = ++d->lastObjectId;
         d->objectIdMap[pcObject->_Id] = pcObject;
@@ -3955,6 +4597,7 @@ std::vector<DocumentObject *> Document::addObjects(const char* sType, const std:
         pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
         // insert in the vector
         d->objectArray.push_back(pcObject);
+        d->dependencyChanged();
 
         pcObject->Label.setValue(ObjectName);
 
@@ -4012,6 +4655,8 @@ void Document::addObject(DocumentObject* pcObject, const char* pObjectName)
 
     // insert in the name map
     d->objectMap[ObjectName] = pcObject;
+    d->addObjectName(ObjectName);
+    d->addObjectLabel(pcObject, pcObject->Label.getStrValue());
     // generate object id and add to id map;
     if(!pcObject->_Id) pcObject->_Id = ++d->lastObjectId;
     d->objectIdMap[pcObject->_Id] = pcObject;
@@ -4019,6 +4664,7 @@ void Document::addObject(DocumentObject* pcObject, const char* pObjectName)
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
     // insert in the vector
     d->objectArray.push_back(pcObject);
+    d->dependencyChanged();
 
     pcObject->Label.setValue( ObjectName );
 
@@ -4042,10 +4688,13 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
 {
     std::string ObjectName = getUniqueObjectName(pObjectName);
     d->objectMap[ObjectName] = pcObject;
+    d->addObjectName(ObjectName);
+    d->addObjectLabel(pcObject, pcObject->Label.getStrValue());
     // generate object id and add to id map;
     if(!pcObject->_Id) pcObject->_Id = ++d->lastObjectId;
     d->objectIdMap[pcObject->_Id] = pcObject;
     d->objectArray.push_back(pcObject);
+    d->dependencyChanged();
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
 
@@ -4174,12 +4823,15 @@ void Document::removeObject(const char* sName)
     for (std::vector<DocumentObject*>::iterator obj = d->objectArray.begin(); obj != d->objectArray.end(); ++obj) {
         if (*obj == pos->second) {
             d->objectArray.erase(obj);
+            d->dependencyChanged();
             break;
         }
     }
 
     pos->second->setStatus(ObjectStatus::Remove, false); // Unset the bit to be on the safe side
     d->objectIdMap.erase(pos->second->_Id);
+    d->removeObjectName(pos->first);
+    d->removeObjectLabel(pos->second, pos->second->Label.getStrValue());
     d->objectMap.erase(pos);
 }
 
@@ -4244,11 +4896,14 @@ void Document::_removeObject(DocumentObject* pcObject)
     // remove from map
     pcObject->setStatus(ObjectStatus::Remove, false); // Unset the bit to be on the safe side
     d->objectIdMap.erase(pcObject->_Id);
+    d->removeObjectName(pos->first);
+    d->removeObjectLabel(pos->second, pos->second->Label.getStrValue());
     d->objectMap.erase(pos);
 
     for (std::vector<DocumentObject*>::iterator it = d->objectArray.begin(); it != d->objectArray.end(); ++it) {
         if (*it == pcObject) {
             d->objectArray.erase(it);
+            d->dependencyChanged();
             break;
         }
     }
@@ -4280,6 +4935,23 @@ std::vector<DocumentObject*> Document::copyObject(
                 "Document must be saved at least once before link to external objects");
     }
 
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Document");
+    if (hGrp->GetBool("CopyInMemory", true) && canCloneObjects(deps)) {
+        std::vector<App::DocumentObject*> imported = cloneObjects(deps);
+        if (returnAll || imported.size()!=deps.size())
+            return imported;
+        std::unordered_map<App::DocumentObject*,size_t> indices;
+        size_t i=0;
+        for(auto o : deps)
+            indices[o] = i++;
+        std::vector<App::DocumentObject*> result;
+        result.reserve(objs.size());
+        for(auto o : objs)
+            result.push_back(imported[indices[o]]);
+        return result;
+    }
+
     MergeDocuments md(this);
     // if not copying recursively then suppress possible warnings
     md.setVerbose(recursive);
@@ -4332,6 +5004,203 @@ std::vector<DocumentObject*> Document::copyObject(
     return result;
 }
 
+namespace {
+// Maps the names of the copied objects like the reader of MergeDocuments
+class XMLCloneReader : public Base::XMLReader
+{
+public:
+    XMLCloneReader(const std::map<std::string, std::string>& name, std::istream& str)
+      : Base::XMLReader("<memory>", str), nameMap(name)
+    {}
+
+    const char* getName(const char* name) const
+    {
+        auto it = nameMap.find(name);
+        if (it != nameMap.end())
+            return it->second.c_str();
+        return name;
+    }
+    bool doNameMapping() const
+    {
+        return true;
+    }
+
+private:
+    const std::map<std::string, std::string>& nameMap;
+};
+
+bool isClonedBySerializing(const App::Property* prop)
+{
+    // the object references of links are mapped while restoring them
+    return prop->isDerivedFrom(PropertyLinkBase::getClassTypeId());
+}
+}
+
+// Python features and external links need the round trip through a file
+bool Document::canCloneObjects(const std::vector<App::DocumentObject*>& objs)
+{
+    if (PropertyXLink::hasXLink(objs))
+        return false;
+    for (auto obj : objs) {
+        std::vector<Property*> props;
+        obj->getPropertyList(props);
+        for (auto prop : props) {
+            if (prop->isDerivedFrom(PropertyPythonObject::getClassTypeId()))
+                return false;
+        }
+    }
+    return true;
+}
+
+/* Copies the objects within the process. Other than importing the exported
+ * objects the property values are passed with Property::Paste(), so shapes and
+ * meshes are not written to and parsed from a zip stream, and shapes share
+ * their geometry with the originals. Only the link properties are saved and
+ * restored, so that they are mapped to the copied objects like on import.
+ */
+std::vector<App::DocumentObject*>
+Document::cloneObjects(const std::vector<App::DocumentObject*>& deps)
+{
+    Base::FlagToggler<> flag(_IsRestoring,false);
+    Base::ObjectStatusLocker<Status, Document> restoreBit(Status::Restoring, this);
+    Base::ObjectStatusLocker<Status, Document> restoreBit2(Status::Importing, this);
+    bool keepDigits = testStatus(Document::KeepTrailingDigits);
+    setStatus(Document::KeepTrailingDigits, false);
+    d->touchedObjs.clear();
+
+    std::map<std::string, std::string> nameMap;
+    std::vector<App::DocumentObject*> sources;
+    std::vector<App::DocumentObject*> objs;
+    Base::StringWriter writer;
+    {
+        // names and links of objects of other documents as on export
+        DocumentExporting exporting(deps);
+
+        for (auto src : deps) {
+            std::string viewType = src->getViewProviderNameStored();
+            if (viewType == src->getViewProviderName())
+                viewType.clear();
+            App::DocumentObject* obj = nullptr;
+            try {
+                obj = addObject(src->getTypeId().getName(), src->getNameInDocument(),
+                                /*isNew=*/ false, viewType.empty() ? nullptr : viewType.c_str());
+            }
+            catch (const Base::Exception& e) {
+                Base::Console().Error("Cannot create object '%s': (%s)\n",
+                                      src->getNameInDocument(), e.what());
+            }
+            if (!obj)
+                continue;
+            nameMap[src->getExportName()] = obj->getNameInDocument();
+            sources.push_back(src);
+            objs.push_back(obj);
+            if (src->testStatus(ObjectStatus::Touch))
+                d->touchedObjs.insert(obj);
+            if (src->testStatus(ObjectStatus::Error)) {
+                obj->setStatus(ObjectStatus::Error, true);
+                auto desc = src->getDocument()->getErrorDescription(src);
+                if (desc)
+                    d->addRecomputeLog(desc, obj);
+            }
+        }
+
+        writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl
+                        << "<Objects Count=\"" << objs.size() << "\">" << endl;
+        for (std::size_t i = 0; i < objs.size(); ++i) {
+            App::DocumentObject* src = sources[i];
+            App::DocumentObject* obj = objs[i];
+            obj->setStatus(ObjectStatus::Restore, true);
+
+            std::map<std::string, Property*> props;
+            src->getPropertyMap(props);
+            std::vector<Property*> links;
+            for (auto &v : props) {
+                Property* prop = v.second;
+                if (prop->testStatus(Property::PropNoPersist))
+                    continue;
+                if (!prop->testStatus(Property::PropDynamic)
+                        && (prop->testStatus(Property::Transient) ||
+                            src->getPropertyType(prop) & Prop_Transient))
+                    continue;
+
+                Property* target = obj->getPropertyByName(v.first.c_str());
+                if (!target && prop->testStatus(Property::PropDynamic)) {
+                    auto data = src->getDynamicPropertyData(prop);
+                    target = obj->addDynamicProperty(prop->getTypeId().getName(), data.getName(),
+                            data.group.c_str(), data.doc.c_str(), data.attr, data.readonly, data.hidden);
+                }
+                if (!target || target->getTypeId() != prop->getTypeId())
+                    continue;
+
+                if (isClonedBySerializing(prop)) {
+                    links.push_back(prop);
+                    continue;
+                }
+                try {
+                    target->Paste(*prop);
+                }
+                catch (const Base::Exception& e) {
+                    e.ReportException();
+                }
+            }
+
+            writer.Stream() << "<Object name=\"" << obj->getNameInDocument()
+                            << "\" Count=\"" << links.size() << "\">" << endl;
+            for (auto prop : links) {
+                writer.Stream() << "<Property name=\"" << prop->getName() << "\">" << endl;
+                prop->Save(writer);
+                writer.Stream() << "</Property>" << endl;
+            }
+            writer.Stream() << "</Object>" << endl;
+        }
+        writer.Stream() << "</Objects>" << endl;
+    }
+
+    std::istringstream stream(writer.getString());
+    XMLCloneReader reader(nameMap, stream);
+    ExpressionParser::ExpressionImporter expImporter(reader);
+    reader.readElement("Objects");
+    int count = reader.getAttributeAsInteger("Count");
+    for (int i = 0; i < count; ++i) {
+        reader.readElement("Object");
+        App::DocumentObject* obj = getObject(reader.getAttribute("name"));
+        int props = reader.getAttributeAsInteger("Count");
+        for (int j = 0; j < props; ++j) {
+            reader.readElement("Property");
+            Property* prop = obj ? obj->getPropertyByName(reader.getAttribute("name")) : nullptr;
+            if (prop) {
+                try {
+                    prop->Restore(reader);
+                }
+                catch (const Base::Exception& e) {
+                    e.ReportException();
+                }
+            }
+            reader.readEndElement("Property");
+        }
+        reader.readEndElement("Object");
+    }
+    reader.readEndElement("Objects");
+    setStatus(Document::KeepTrailingDigits, keepDigits);
+
+    for (auto obj : objs) {
+        obj->setStatus(ObjectStatus::Restore, false);
+        obj->setStatus(App::ObjImporting, true);
+        FC_LOG("cloning " << obj->getFullName());
+    }
+
+    signalCloneObjects(sources, objs);
+    afterRestore(objs, true);
+    signalFinishImportObjects(objs);
+
+    for (auto obj : objs) {
+        if (obj->getNameInDocument())
+            obj->setStatus(App::ObjImporting, false);
+    }
+
+    return objs;
+}
+
 std::vector<App::DocumentObject*>
 Document::importLinks(const std::vector<App::DocumentObject*> &objArray)
 {
@@ -4466,6 +5335,24 @@ DocumentObject * Document::getObject(const char *Name) const
         return 0;
 }
 
+std::vector<DocumentObject*> Document::getObjectsByLabel(const std::string &label) const
+{
+    auto it = d->labelMap.find(label);
+    if (it != d->labelMap.end())
+        return it->second;
+    return std::vector<DocumentObject*>();
+}
+
+void Document::_relabelObject(DocumentObject *pcObject, const std::string &oldLabel)
+{
+    // Objects removed to the undo stack may still be relabeled
+    auto it = d->objectIdMap.find(pcObject->getID());
+    if (it == d->objectIdMap.end() || it->second != pcObject)
+        return;
+    d->removeObjectLabel(pcObject, oldLabel);
+    d->addObjectLabel(pcObject, pcObject->Label.getStrValue());
+}
+
 DocumentObject * Document::getObjectByID(long id) const
 {
     auto it = d->objectIdMap.find(id);
@@ -4520,9 +5407,20 @@ std::string Document::getUniqueObjectName(const char *Name) const
         }
 
         std::vector<std::string> names;
-        names.reserve(d->objectMap.size());
-        for (pos = d->objectMap.begin();pos != d->objectMap.end();++pos) {
-            names.push_back(pos->first);
+        std::string stem, suffix;
+        if (!DocumentP::splitName(CleanName, stem, suffix)) {
+            // Only names made of the stem and a numeric suffix take part,
+            // so it is enough to pass the one with the highest suffix.
+            auto it = d->nameSuffixes.find(CleanName);
+            if (it != d->nameSuffixes.end())
+                names.push_back(CleanName + *it->second.rbegin());
+        }
+        else {
+            // Trailing digits kept, fall back to a full scan
+            names.reserve(d->objectMap.size());
+            for (pos = d->objectMap.begin();pos != d->objectMap.end();++pos) {
+                names.push_back(pos->first);
+            }
         }
         return Base::Tools::getUniqueName(CleanName, names, 3);
     }
@@ -4554,12 +5452,20 @@ const std::vector<DocumentObject*> &Document::getObjects() const
 
 std::vector<DocumentObject*> Document::getObjectsOfType(const Base::Type& typeId) const
 {
-    std::vector<DocumentObject*> Objects;
-    for (std::vector<DocumentObject*>::const_iterator it = d->objectArray.begin(); it != d->objectArray.end(); ++it) {
-        if ((*it)->getTypeId().isDerivedFrom(typeId))
-            Objects.push_back(*it);
+    if (d->typeCacheRevision != d->depRevision) {
+        d->typeCache.clear();
+        d->typeCacheRevision = d->depRevision;
     }
-    return Objects;
+
+    auto res = d->typeCache.emplace(typeId.getKey(), std::vector<DocumentObject*>());
+    if (res.second) {
+        std::vector<DocumentObject*>& Objects = res.first->second;
+        for (std::vector<DocumentObject*>::const_iterator it = d->objectArray.begin(); it != d->objectArray.end(); ++it) {
+            if ((*it)->getTypeId().isDerivedFrom(typeId))
+                Objects.push_back(*it);
+        }
+    }
+    return res.first->second;
 }
 
 std::vector< DocumentObject* > Document::getObjectsWithExtension(const Base::Type& typeId, bool derived) const {
@@ -163,6 +163,9 @@ public:
     boost::signals2::signal<void (const std::vector<App::DocumentObject*>&, Base::Reader&,
                                   const std::map<std::string, std::string>&)> signalImportViewObjects;
     boost::signals2::signal<void (const std::vector<App::DocumentObject*>&)> signalFinishImportObjects;
+    /// signal on objects copied without serialization, with the source objects and their copies
+    boost::signals2::signal<void (const std::vector<App::DocumentObject*>&,
+                                  const std::vector<App::DocumentObject*>&)> signalCloneObjects;
     //signal starting a save action to a file
     boost::signals2::signal<void (const App::Document&, const std::string&)> signalStartSave;
     //signal finishing a save action to a file
@@ -256,7 +259,8 @@ public:
     DocumentObject *addObject(const char* sType, const char* pObjectName=0,
             bool isNew=true, const char *viewType=0, bool isPartial=false);
     /** Add an array of features of the given types and names.
-     * Unicode names are set through the Label property.
+     * Unicode names are set through the Label property. Property change
+     * notifications are coalesced into one batch update for all objects.
      * @param sType       The type of created object
      * @param objectNames A list of object names
      * @param isNew       If false don't call the \c DocumentObject::setupObject() callback (default is true)
@@ -301,6 +305,8 @@ public:
     DocumentObject *getObject(const char *Name) const;
     /// Returns a Object of this document by its id
     DocumentObject *getObjectByID(long id) const;
+    /// Returns the Objects of this document with the given label, using a hashed index
+    std::vector<DocumentObject*> getObjectsByLabel(const std::string &label) const;
     /// Returns true if the DocumentObject is contained in this document
     bool isIn(const DocumentObject *pFeat) const;
     /// Returns a Name of an Object or 0
@@ -356,6 +362,38 @@ public:
     void setStatus(Status pos, bool on);
     //@}
 
+    /** @name Recompute profiling
+     *
+     * When enabled, each call of _recomputeFeature() is timed and the
+     * statistics are accumulated per object until cleared.
+     */
+    //@{
+    struct RecomputeProfile {
+        std::string name;
+        std::string label;
+        /// number of recomputes
+        long count;
+        /// accumulated wall time in seconds
+        double wallTime;
+        /// accumulated CPU time of the recomputing thread in seconds
+        double cpuTime;
+    };
+    /// enable or disable recording the recompute profile
+    void setRecomputeProfiling(bool enable);
+    bool isRecomputeProfiling() const;
+    /// returns the accumulated profile, sorted by wall time, longest first
+    std::vector<RecomputeProfile> getRecomputeProfile() const;
+    void clearRecomputeProfile();
+    /** Export the recorded profile as JSON
+     *
+     * @param out: the output stream
+     * @param chromeTrace: if true, write each recompute as event in the
+     * Chrome trace event format (chrome://tracing), otherwise write the
+     * accumulated statistics per object.
+     */
+    void exportRecomputeProfile(std::ostream &out, bool chromeTrace=false) const;
+    //@}
+
 
     /** @name methods for the UNDO REDO and Transaction handling
      *
@@ -402,8 +440,13 @@ public:
     /// Check if a transaction is open and its list is empty.
     /// If no transaction is open true is returned.
     bool isTransactionEmpty() const;
-    /// Set the Undo limit in Byte!
+    /** Set the Undo limit in Byte!
+     * Transactions exceeding it are stored in compact form and the oldest
+     * ones are moved into temporary files. 0 means no limit.
+     */
     void setUndoLimit(unsigned int UndoMemSize=0);
+    /// Returns the Undo limit in Byte
+    unsigned int getUndoLimit() const;
     /// Returns the actual memory consumption of the Undo redo stuff.
     unsigned int getUndoMemSize (void) const;
     /// Set the Undo limit as stack size
@@ -426,10 +469,45 @@ public:
     bool redo(int id=0) ;
     /// returns true if the document is in an Transaction phase, e.g. currently performing a redo/undo or rollback
     bool isPerformingTransaction() const;
+    /// returns true while property change signals are queued, i.e. during parallel recompute or a batch update
+    bool isDeferringChangeSignals() const;
     /// \internal add or remove property from a transactional object
     void addOrRemovePropertyOfObject(TransactionalObject*, Property *prop, bool add);
     //@}
 
+    /** @name Batch update
+     *
+     * While a batch update is active, property change notifications
+     * (signalBeforeChangeObject, signalChangedObject and the per object
+     * signals) are not emitted immediately. Instead, they are collected and
+     * de-duplicated per object and property, and emitted once when the
+     * outermost batch is closed. Undo/redo recording is not affected.
+     * Batches may be nested.
+     */
+    //@{
+    /// Starts (or nests) a batch update
+    void beginBatchUpdate();
+    /// Ends a batch update, emits the pending notifications on the outermost one
+    void endBatchUpdate();
+    /// returns true if a batch update is active
+    bool isBatchUpdating() const;
+
+    /// Helper class to run a batch update for the lifetime of the object
+    class BatchUpdate {
+    public:
+        explicit BatchUpdate(Document &doc):doc(doc) {
+            doc.beginBatchUpdate();
+        }
+        ~BatchUpdate() {
+            doc.endBatchUpdate();
+        }
+    private:
+        BatchUpdate(const BatchUpdate&) = delete;
+        BatchUpdate &operator=(const BatchUpdate&) = delete;
+        Document &doc;
+    };
+    //@}
+
     /** @name dependency stuff */
     //@{
     /// write GraphViz file
@@ -460,6 +538,17 @@ public:
     static std::vector<App::DocumentObject*> getDependencyList(
             const std::vector<App::DocumentObject*> &objs, int options=0);
 
+    /// Statistics of the cached topological order used by getDependencyList()
+    struct DependencyCacheStats {
+        /// number of sorted dependency queries answered from the cache
+        long hits;
+        /// number of sorted dependency queries that fell back to a full graph build
+        long misses;
+        /// number of times the cache was rebuilt after a dependency change
+        long rebuilds;
+    };
+    DependencyCacheStats getDependencyCacheStats() const;
+
     std::vector<App::Document*> getDependentDocuments(bool sort=true);
     static std::vector<App::Document*> getDependentDocuments(std::vector<App::Document*> docs, bool sort);
 
@@ -521,10 +610,16 @@ protected:
 
     void _removeObject(DocumentObject* pcObject);
     void _addObject(DocumentObject* pcObject, const char* pObjectName);
+    /// updates the label index, called by DocumentObject on label change
+    void _relabelObject(DocumentObject* pcObject, const std::string &oldLabel);
     /// checks if a valid transaction is open
     void _checkTransaction(DocumentObject* pcDelObj, const Property *What, int line);
     void breakDependency(DocumentObject* pcObject, bool clear);
+    /// invalidates the cached dependency order, called when any link of the document changes
+    void _dependencyChanged();
     std::vector<App::DocumentObject*> readObjects(Base::XMLReader& reader);
+    static bool canCloneObjects(const std::vector<App::DocumentObject*>& objs);
+    std::vector<App::DocumentObject*> cloneObjects(const std::vector<App::DocumentObject*>& objs);
     void writeObjects(const std::vector<App::DocumentObject*>&, Base::Writer &writer) const;
     bool saveToFile(const char* filename) const;
 
@@ -537,6 +632,10 @@ protected:
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
     int _recomputeFeature(DocumentObject* Feat);
+    /** Recompute a batch of independent objects in worker threads
+     * @return the result of _recomputeFeature() for each object
+     */
+    std::vector<int> _recomputeFeatures(const std::vector<DocumentObject*> &objs);
     void _clearRedos();
 
     /// refresh the internal dependency graph
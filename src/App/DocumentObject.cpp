@@ -694,7 +694,9 @@ void DocumentObject::onBeforeChange(const Property* prop)
     if (_pDoc)
         onBeforeChangeProperty(_pDoc, prop);
 
-    signalBeforeChange(*this,*prop);
+    // During parallel recompute or batch update, the document emits the signal later
+    if (!_pDoc || !_pDoc->isDeferringChangeSignals())
+        signalBeforeChange(*this,*prop);
 }
 
 /// get called by the container when a Property was changed
@@ -721,8 +723,10 @@ void DocumentObject::onChanged(const Property* prop)
     // if (_pDoc)
     //     _pDoc->onChangedProperty(this,prop);
 
-    if (prop == &Label && _pDoc && oldLabel != Label.getStrValue())
+    if (prop == &Label && _pDoc && oldLabel != Label.getStrValue()) {
+        _pDoc->_relabelObject(this, oldLabel);
         _pDoc->signalRelabelObject(*this);
+    }
 
     // set object touched if it is an input property
     if (!testStatus(ObjectStatus::NoTouch) 
@@ -745,13 +749,17 @@ void DocumentObject::onChanged(const Property* prop)
     if (_pDoc)
         _pDoc->onChangedProperty(this,prop);
 
-    signalChanged(*this,*prop);
+    // During parallel recompute or batch update, the document emits the signal later
+    if (!_pDoc || !_pDoc->isDeferringChangeSignals())
+        signalChanged(*this,*prop);
 }
 
 void DocumentObject::clearOutListCache() const {
     _outList.clear();
     _outListMap.clear();
     _outListCached = false;
+    if(_pDoc)
+        _pDoc->_dependencyChanged();
 }
 
 PyObject *DocumentObject::getPyObject(void)
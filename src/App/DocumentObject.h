@@ -130,6 +130,9 @@ public:
     DocumentObject(void);
     virtual ~DocumentObject();
 
+    /// Objects are allocated from App::ObjectPool, see there
+    FC_OBJECT_POOL_ALLOCATOR
+
     /// returns the name which is set in the document for this object (not the name property!)
     const char *getNameInDocument(void) const;
     /// Return the object ID that is unique within its owner document
@@ -299,6 +302,16 @@ public:
      */
     virtual short mustExecute(void) const;
 
+    /** Check if this object can be recomputed in a worker thread
+     *
+     * Used by Document::recompute() when parallel recompute is enabled in
+     * the preferences. An object returning true promises that its execute()
+     * only reads its own properties and the (already recomputed) output of
+     * its dependencies, and does not call into any GUI code. Python based
+     * features always stay on the main thread. The default is false.
+     */
+    virtual bool allowConcurrentRecompute() const {return false;}
+
     /** Recompute only this feature
      *
      * @param recursive: set to true to recompute any dependent objects as well
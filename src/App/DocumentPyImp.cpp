@@ -187,6 +187,48 @@ PyObject*  DocumentPy::exportGraphviz(PyObject * args)
     }
 }
 
+PyObject*  DocumentPy::getRecomputeProfile(PyObject * args)
+{
+    PyObject *clear = Py_False;
+    if (!PyArg_ParseTuple(args, "|O",&clear))
+        return NULL;
+    PY_TRY {
+        Py::List ret;
+        for (auto &entry : getDocumentPtr()->getRecomputeProfile()) {
+            Py::Dict dict;
+            dict.setItem("Name", Py::String(entry.name));
+            dict.setItem("Label", Py::String(entry.label));
+            dict.setItem("Count", Py::Long(entry.count));
+            dict.setItem("WallTime", Py::Float(entry.wallTime));
+            dict.setItem("CpuTime", Py::Float(entry.cpuTime));
+            ret.append(dict);
+        }
+        if (PyObject_IsTrue(clear))
+            getDocumentPtr()->clearRecomputeProfile();
+        return Py::new_reference_to(ret);
+    } PY_CATCH;
+}
+
+PyObject*  DocumentPy::exportRecomputeProfile(PyObject * args)
+{
+    char* fn=0;
+    PyObject *chrome = Py_False;
+    if (!PyArg_ParseTuple(args, "|zO",&fn,&chrome))
+        return NULL;
+    PY_TRY {
+        if (fn) {
+            Base::FileInfo fi(fn);
+            Base::ofstream str(fi);
+            getDocumentPtr()->exportRecomputeProfile(str, PyObject_IsTrue(chrome));
+            str.close();
+            Py_Return;
+        }
+        std::stringstream str;
+        getDocumentPtr()->exportRecomputeProfile(str, PyObject_IsTrue(chrome));
+        return Py::new_reference_to(Py::String(str.str()));
+    } PY_CATCH;
+}
+
 PyObject*  DocumentPy::addObject(PyObject *args, PyObject *kwd)
 {
     char *sType,*sName=0,*sViewType=0;
@@ -271,6 +313,27 @@ PyObject*  DocumentPy::addObject(PyObject *args, PyObject *kwd)
     }
 }
 
+PyObject*  DocumentPy::addObjects(PyObject *args)
+{
+    char *sType;
+    PyObject *pyNames;
+    if (!PyArg_ParseTuple(args, "sO", &sType, &pyNames))
+        return NULL;    // NULL triggers exception
+
+    PY_TRY {
+        std::vector<std::string> names;
+        Py::Sequence seq(pyNames);
+        names.reserve(seq.size());
+        for (Py_ssize_t i=0;i<seq.size();++i)
+            names.push_back(Py::String(seq[i]).as_std_string("utf-8"));
+
+        Py::List res;
+        for (auto obj : getDocumentPtr()->addObjects(sType, names))
+            res.append(Py::asObject(obj->getPyObject()));
+        return Py::new_reference_to(res);
+    } PY_CATCH;
+}
+
 PyObject*  DocumentPy::removeObject(PyObject *args)
 {
     char *sName;
@@ -535,12 +598,9 @@ PyObject*  DocumentPy::getObjectsByLabel(PyObject *args)
         return NULL;                             // NULL triggers exception
 
     Py::List list;
-    std::string name = sName;
-    std::vector<DocumentObject*> objs = getDocumentPtr()->getObjects();
-    for (std::vector<DocumentObject*>::iterator it = objs.begin(); it != objs.end(); ++it) {
-        if (name == (*it)->Label.getValue())
-            list.append(Py::asObject((*it)->getPyObject()));
-    }
+    std::vector<DocumentObject*> objs = getDocumentPtr()->getObjectsByLabel(sName);
+    for (std::vector<DocumentObject*>::iterator it = objs.begin(); it != objs.end(); ++it)
+        list.append(Py::asObject((*it)->getPyObject()));
 
     return Py::new_reference_to(list);
 }
@@ -654,6 +714,19 @@ Py::Int DocumentPy::getUndoRedoMemSize(void) const
     return Py::Int((long)getDocumentPtr()->getUndoMemSize());
 }
 
+Py::Int DocumentPy::getUndoMemoryLimit(void) const
+{
+    return Py::Int((long)getDocumentPtr()->getUndoLimit());
+}
+
+void DocumentPy::setUndoMemoryLimit(Py::Int arg)
+{
+    long limit = arg;
+    if (limit < 0)
+        throw Py::ValueError("Memory limit must not be negative");
+    getDocumentPtr()->setUndoLimit(static_cast<unsigned int>(limit));
+}
+
 Py::Int DocumentPy::getUndoCount(void) const
 {
     return Py::Int((long)getDocumentPtr()->getAvailableUndos());
@@ -698,6 +771,16 @@ Py::String DocumentPy::getName(void) const
     return Py::String(getDocumentPtr()->getName());
 }
 
+Py::Boolean DocumentPy::getRecomputeProfiling(void) const
+{
+    return Py::Boolean(getDocumentPtr()->isRecomputeProfiling());
+}
+
+void DocumentPy::setRecomputeProfiling(Py::Boolean arg)
+{
+    getDocumentPtr()->setRecomputeProfiling(arg.isTrue());
+}
+
 Py::Boolean DocumentPy::getRecomputesFrozen(void) const
 {
     return Py::Boolean(getDocumentPtr()->testStatus(Document::Status::SkipRecompute));
@@ -708,6 +791,48 @@ void DocumentPy::setRecomputesFrozen(Py::Boolean arg)
     getDocumentPtr()->setStatus(Document::Status::SkipRecompute, arg.isTrue());
 }
 
+PyObject* DocumentPy::getMemoryReport(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+
+    PY_TRY {
+        Document* doc = getDocumentPtr();
+        unsigned long total = 0;
+
+        Py::Dict objects;
+        std::vector<DocumentObject*> objs = doc->getObjects();
+        for (std::vector<DocumentObject*>::iterator it = objs.begin(); it != objs.end(); ++it) {
+            std::map<std::string,App::Property*> props;
+            (*it)->getPropertyMap(props);
+            Py::Dict propSizes;
+            unsigned long objSize = 0;
+            for (std::map<std::string,App::Property*>::iterator jt = props.begin(); jt != props.end(); ++jt) {
+                unsigned int size = jt->second->getMemSize();
+                propSizes.setItem(jt->first, Py::Int((long)size));
+                objSize += size;
+            }
+            Py::Dict info;
+            info.setItem("Total", Py::Int((long)objSize));
+            info.setItem("Properties", propSizes);
+            objects.setItem((*it)->getNameInDocument(), info);
+            total += objSize;
+        }
+
+        unsigned long docSize = doc->PropertyContainer::getMemSize();
+        unsigned long undoSize = doc->getUndoMemSize();
+        total += docSize + undoSize;
+
+        Py::Dict report;
+        report.setItem("Objects", objects);
+        report.setItem("Document", Py::Int((long)docSize));
+        report.setItem("UndoRedo", Py::Int((long)undoSize));
+        report.setItem("Total", Py::Int((long)total));
+        return Py::new_reference_to(report);
+    }
+    PY_CATCH;
+}
+
 PyObject* DocumentPy::getTempFileName(PyObject *args)
 {
     PyObject *value;
@@ -856,6 +981,37 @@ PyObject *DocumentPy::getDependentDocuments(PyObject *args) {
     } PY_CATCH;
 }
 
+PyObject *DocumentPy::getDependencyCacheStats(PyObject *args) {
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+    PY_TRY {
+        auto stats = getDocumentPtr()->getDependencyCacheStats();
+        Py::Dict ret;
+        ret.setItem("Hits", Py::Long(stats.hits));
+        ret.setItem("Misses", Py::Long(stats.misses));
+        ret.setItem("Rebuilds", Py::Long(stats.rebuilds));
+        return Py::new_reference_to(ret);
+    } PY_CATCH;
+}
+
+PyObject *DocumentPy::beginBatchUpdate(PyObject *args) {
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+    PY_TRY {
+        getDocumentPtr()->beginBatchUpdate();
+        Py_Return;
+    } PY_CATCH;
+}
+
+PyObject *DocumentPy::endBatchUpdate(PyObject *args) {
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+    PY_TRY {
+        getDocumentPtr()->endBatchUpdate();
+        Py_Return;
+    } PY_CATCH;
+}
+
 Py::Boolean DocumentPy::getRestoring(void) const
 {
     return Py::Boolean(getDocumentPtr()->testStatus(Document::Status::Restoring));
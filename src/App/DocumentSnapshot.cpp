@@ -0,0 +1,121 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include "DocumentSnapshot.h"
+#include "Document.h"
+#include "DocumentObject.h"
+#include "PropertyGeo.h"
+#include "PropertyLinks.h"
+#include "PropertyPythonObject.h"
+
+using namespace App;
+
+
+DocumentSnapshot::DocumentSnapshot()
+{
+}
+
+DocumentSnapshot::~DocumentSnapshot()
+{
+}
+
+DocumentSnapshot::Pointer DocumentSnapshot::create(const Document* doc,
+                                                   const std::vector<DocumentObject*>& objects)
+{
+    std::shared_ptr<DocumentSnapshot> snapshot(new DocumentSnapshot());
+    snapshot->documentName = doc->getName();
+
+    std::vector<DocumentObject*> objs = objects.empty() ? doc->getObjects() : objects;
+    for (DocumentObject* obj : objs) {
+        if (!obj || !obj->getNameInDocument() || obj->getDocument() != doc)
+            continue;
+
+        std::string name = obj->getNameInDocument();
+        ObjectData& data = snapshot->objects[name];
+        if (data.type != Base::Type::badType())
+            continue; // listed twice
+        snapshot->objectNames.push_back(name);
+        data.label = obj->Label.getValue();
+        data.type = obj->getTypeId();
+
+        std::map<std::string, Property*> props;
+        obj->getPropertyMap(props);
+        for (const auto& it : props) {
+            Property* prop = it.second;
+            if (prop->isDerivedFrom(PropertyLinkBase::getClassTypeId()) ||
+                prop->isDerivedFrom(PropertyPythonObject::getClassTypeId()))
+                continue;
+            data.properties[it.first].reset(prop->Copy());
+        }
+    }
+
+    return snapshot;
+}
+
+const DocumentSnapshot::ObjectData* DocumentSnapshot::getObjectData(const char* object) const
+{
+    auto it = objects.find(object);
+    return it != objects.end() ? &it->second : nullptr;
+}
+
+bool DocumentSnapshot::hasObject(const char* object) const
+{
+    return getObjectData(object) != nullptr;
+}
+
+Base::Type DocumentSnapshot::getObjectType(const char* object) const
+{
+    const ObjectData* data = getObjectData(object);
+    return data ? data->type : Base::Type::badType();
+}
+
+std::string DocumentSnapshot::getObjectLabel(const char* object) const
+{
+    const ObjectData* data = getObjectData(object);
+    return data ? data->label : std::string();
+}
+
+std::vector<std::string> DocumentSnapshot::getPropertyNames(const char* object) const
+{
+    std::vector<std::string> names;
+    if (const ObjectData* data = getObjectData(object)) {
+        for (const auto& it : data->properties)
+            names.push_back(it.first);
+    }
+    return names;
+}
+
+const Property* DocumentSnapshot::getPropertyByName(const char* object, const char* property) const
+{
+    const ObjectData* data = getObjectData(object);
+    if (!data)
+        return nullptr;
+    auto it = data->properties.find(property);
+    return it != data->properties.end() ? it->second.get() : nullptr;
+}
+
+Base::Placement DocumentSnapshot::getPlacement(const char* object) const
+{
+    const PropertyPlacement* prop = getProperty<PropertyPlacement>(object, "Placement");
+    return prop ? prop->getValue() : Base::Placement();
+}
@@ -0,0 +1,117 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#ifndef APP_DOCUMENTSNAPSHOT_H
+#define APP_DOCUMENTSNAPSHOT_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Base/Placement.h>
+#include <Base/Type.h>
+#include <App/Property.h>
+
+namespace App
+{
+class Document;
+class DocumentObject;
+
+/** An immutable copy of the property values of document objects.
+ *
+ * A snapshot is made in the thread that owns the document, usually the GUI
+ * thread, and can then be passed to worker threads that read it without any
+ * locking while the document keeps being edited:
+ * \code
+ * auto snapshot = App::DocumentSnapshot::create(doc, objects);
+ * std::thread([snapshot]() {
+ *     auto shape = snapshot->getProperty<Part::PropertyPartShape>("Box", "Shape");
+ *     ...
+ * }).detach();
+ * \endcode
+ *
+ * The property values are copied with Property::Copy(). Links are left out as
+ * they refer to the live objects, and so are Python objects which can't be
+ * used without the GIL. Geometry like OCC shapes is shared with the document,
+ * not copied, which is safe as long as it is only read. Algorithms that modify
+ * a shape in place, e.g. by adding a triangulation, must work on a copy.
+ */
+class AppExport DocumentSnapshot
+{
+public:
+    typedef std::shared_ptr<const DocumentSnapshot> Pointer;
+
+    /** Makes a snapshot of \a objects of \a doc, or of all its objects if
+     * \a objects is empty.
+     */
+    static Pointer create(const Document* doc,
+                          const std::vector<DocumentObject*>& objects = std::vector<DocumentObject*>());
+    ~DocumentSnapshot();
+
+    /// Returns the name of the document
+    const std::string& getDocumentName() const {
+        return documentName;
+    }
+    /// Returns the names of the objects, in the order of the document
+    const std::vector<std::string>& getObjectNames() const {
+        return objectNames;
+    }
+    bool hasObject(const char* object) const;
+    /// Returns the type of the object or Base::Type::badType() if there is no such object
+    Base::Type getObjectType(const char* object) const;
+    std::string getObjectLabel(const char* object) const;
+
+    /// Returns the names of the copied properties of the object
+    std::vector<std::string> getPropertyNames(const char* object) const;
+    /// Returns the copy of the property or null if it is not part of the snapshot
+    const Property* getPropertyByName(const char* object, const char* property) const;
+    template<typename T>
+    const T* getProperty(const char* object, const char* property) const {
+        const Property* prop = getPropertyByName(object, property);
+        if (prop && prop->isDerivedFrom(T::getClassTypeId()))
+            return static_cast<const T*>(prop);
+        return nullptr;
+    }
+    /// Returns the value of the Placement property of the object, if any
+    Base::Placement getPlacement(const char* object) const;
+
+private:
+    DocumentSnapshot();
+    DocumentSnapshot(const DocumentSnapshot&) = delete;
+    DocumentSnapshot& operator=(const DocumentSnapshot&) = delete;
+
+    struct ObjectData {
+        std::string label;
+        Base::Type type;
+        std::map<std::string, std::unique_ptr<Property> > properties;
+    };
+    const ObjectData* getObjectData(const char* object) const;
+
+private:
+    std::string documentName;
+    std::vector<std::string> objectNames;
+    std::map<std::string, ObjectData> objects;
+};
+
+} //namespace App
+
+#endif // APP_DOCUMENTSNAPSHOT_H
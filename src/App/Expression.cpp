@@ -50,10 +50,12 @@
 #include <string>
 #include <sstream>
 #include <math.h>
+#include <cmath>
 #include <stdio.h>
 #include <stack>
 #include <deque>
 #include <algorithm>
+#include <atomic>
 #include "ExpressionParser.h"
 #include <Base/Unit.h>
 #include <App/PropertyUnits.h>
@@ -1928,9 +1930,113 @@ public:
     }
 };
 
+// Reduce the values gathered by evalAggregate() with the same unit. The
+// loops are kept free of branches on the unit, so that the compiler can
+// vectorize them.
+static Quantity reduceAggregate(int f,
+        const std::vector<double> &values, const Base::Unit &unit)
+{
+    const std::size_t n = values.size();
+    const double *v = values.data();
+
+    auto sum = [v,n]() {
+        // Independent partial sums to break the dependency chain
+        double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        std::size_t i = 0;
+        for(; i+4 <= n; i+=4) {
+            s0 += v[i];
+            s1 += v[i+1];
+            s2 += v[i+2];
+            s3 += v[i+3];
+        }
+        for(; i<n; ++i)
+            s0 += v[i];
+        return (s0 + s1) + (s2 + s3);
+    };
+
+    switch(f) {
+    case FunctionExpression::SUM:
+        if(!n)
+            return Quantity();
+        return Quantity(sum(), unit);
+    case FunctionExpression::AVERAGE:
+        if(!n)
+            return Quantity()/(double)n;
+        return Quantity(sum()/(double)n, unit);
+    case FunctionExpression::STDDEV: {
+        if (n < 2)
+            throw ExpressionError("Invalid number of entries: at least two required.");
+        double mean = sum()/(double)n;
+        double m2 = 0;
+        for(std::size_t i=0; i<n; ++i)
+            m2 += (v[i]-mean)*(v[i]-mean);
+        return Quantity(std::sqrt(m2/(n-1.0)), unit);
+    }
+    case FunctionExpression::COUNT:
+        return Quantity(n);
+    case FunctionExpression::MIN:
+    case FunctionExpression::MAX: {
+        if(!n)
+            return Quantity();
+        double res = v[0];
+        if(f == FunctionExpression::MIN) {
+            for(std::size_t i=1; i<n; ++i)
+                res = v[i] < res ? v[i] : res;
+        } else {
+            for(std::size_t i=1; i<n; ++i)
+                res = v[i] > res ? v[i] : res;
+        }
+        return Quantity(res, unit);
+    }
+    default:
+        assert(false);
+    }
+    return Quantity();
+}
+
 Py::Object FunctionExpression::evalAggregate(
         const Expression *owner, int f, const std::vector<Expression*> &args)
 {
+    // Fast path. Gather the values into a contiguous buffer and reduce them in
+    // one go. If the units differ, fall back to the collectors below, which
+    // report the mismatch in the same way as before.
+    std::vector<double> values;
+    Base::Unit unit;
+    bool mismatch = false;
+    auto gather = [&](const Quantity &q) {
+        if(values.empty())
+            unit = q.getUnit();
+        else if(q.getUnit() != unit)
+            mismatch = true;
+        values.push_back(q.getValue());
+    };
+    for (auto &arg : args) {
+        if (arg->isDerivedFrom(RangeExpression::getClassTypeId())) {
+            const auto &props = static_cast<const RangeExpression&>(*arg).getRangeProperties();
+            values.reserve(values.size() + props.size());
+            for(auto p : props) {
+                PropertyQuantity * qp;
+                PropertyFloat * fp;
+                PropertyInteger * ip;
+                if ((qp = freecad_dynamic_cast<PropertyQuantity>(p)) != 0)
+                    gather(qp->getQuantityValue());
+                else if ((fp = freecad_dynamic_cast<PropertyFloat>(p)) != 0)
+                    gather(Quantity(fp->getValue()));
+                else if ((ip = freecad_dynamic_cast<PropertyInteger>(p)) != 0)
+                    gather(Quantity(ip->getValue()));
+                else
+                    _EXPR_THROW("Invalid property type for aggregate.", owner);
+            }
+        }
+        else {
+            Quantity q;
+            if(pyToQuantity(q,arg->getPyValue()))
+                gather(q);
+        }
+    }
+    if(!mismatch || f == COUNT)
+        return pyFromQuantity(reduceAggregate(f, values, unit));
+
     std::unique_ptr<Collector> c;
 
     switch (f) {
@@ -2956,13 +3062,28 @@ bool RangeExpression::isTouched() const
 
 Py::Object RangeExpression::_getPyValue() const {
     Py::List list;
+    for(auto p : getRangeProperties())
+        list.append(Py::asObject(p->getPyObject()));
+    return list;
+}
+
+const std::vector<App::Property*> &RangeExpression::getRangeProperties() const {
+    long revision = ExpressionProgram::getRevision();
+    if(cachedRevision == revision && cachedBegin == begin && cachedEnd == end)
+        return cachedProps;
+
+    cachedProps.clear();
+    cachedRevision = -1;
     Range range(getRange());
     do {
         Property * p = owner->getPropertyByName(range.address().c_str());
         if(p)
-            list.append(Py::asObject(p->getPyObject()));
+            cachedProps.push_back(p);
     } while (range.next());
-    return list;
+    cachedBegin = begin;
+    cachedEnd = end;
+    cachedRevision = revision;
+    return cachedProps;
 }
 
 void RangeExpression::_toString(std::ostream &ss, bool,int) const
@@ -3101,6 +3222,271 @@ void RangeExpression::_offsetCells(int rowOffset, int colOffset, ExpressionVisit
     }
 }
 
+//
+// ExpressionProgram class
+//
+
+// Bumped whenever a cached property reference of any program may have become
+// stale. Each reference remembers the revision it was resolved at.
+static std::atomic<long> _ProgramRevision(0);
+
+// Python int is arbitrary precision. Stay within the range of double that is
+// exact, and let the tree evaluation handle anything beyond.
+static const double _ProgramIntLimit = 9007199254740992.0;
+
+namespace {
+enum ProgramOpCode {
+    ProgramPushConstant,
+    ProgramPushProperty,
+    ProgramAdd,
+    ProgramSub,
+    ProgramMul,
+    ProgramDiv,
+    ProgramPow,
+    ProgramNeg,
+};
+}
+
+void ExpressionProgram::invalidateReferences() {
+    ++_ProgramRevision;
+}
+
+long ExpressionProgram::getRevision() {
+    return _ProgramRevision;
+}
+
+void ExpressionProgram::readValue(const Property *prop, Value &v) {
+    if(prop->isDerivedFrom(PropertyQuantity::getClassTypeId())) {
+        v.quantity = static_cast<const PropertyQuantity*>(prop)->getQuantityValue();
+        v.type = ValueQuantity;
+    } else if(prop->isDerivedFrom(PropertyFloat::getClassTypeId())) {
+        v.quantity = Quantity(static_cast<const PropertyFloat*>(prop)->getValue());
+        v.type = ValueFloat;
+    } else {
+        v.quantity = Quantity(static_cast<const PropertyInteger*>(prop)->getValue());
+        v.type = ValueInt;
+    }
+}
+
+bool ExpressionProgram::isUpToDate() const {
+    if(!valid)
+        return false;
+    for(auto &ref : references) {
+        if(ref.revision != _ProgramRevision)
+            return false;
+        Value v;
+        readValue(ref.prop,v);
+        if(v.type != ref.last.type || !(v.quantity == ref.last.quantity))
+            return false;
+    }
+    return true;
+}
+
+const Property *ExpressionProgram::resolve(const ObjectIdentifier &path) {
+    if(path.getSubObjectName().size())
+        return 0;
+    int ptype = 0;
+    auto prop = path.getProperty(&ptype);
+    if(!prop || ptype || path.getPropertyComponents().size()!=1)
+        return 0;
+    if(prop->isDerivedFrom(PropertyFloat::getClassTypeId())
+            || prop->isDerivedFrom(PropertyInteger::getClassTypeId()))
+        return prop;
+    return 0;
+}
+
+ExpressionProgram *ExpressionProgram::compile(const Expression *expr) {
+    if(!expr)
+        return 0;
+    std::unique_ptr<ExpressionProgram> program(new ExpressionProgram);
+    try {
+        if(!program->compileNode(expr,1))
+            return 0;
+    } catch (Base::Exception &) {
+        return 0;
+    }
+    return program.release();
+}
+
+bool ExpressionProgram::compileNode(const Expression *expr, int depth) {
+    if(expr->hasComponent())
+        return false;
+
+    stackSize = std::max(stackSize,depth);
+
+    if(expr->getTypeId() == UnitExpression::getClassTypeId()
+            || expr->getTypeId() == NumberExpression::getClassTypeId()
+            || (expr->getTypeId() == ConstantExpression::getClassTypeId()
+                && static_cast<const ConstantExpression*>(expr)->isNumber()))
+    {
+        // Same typing as pyFromQuantity()
+        auto &q = static_cast<const UnitExpression*>(expr)->getQuantity();
+        long l;
+        Value v;
+        v.quantity = q;
+        if(!q.getUnit().isEmpty())
+            v.type = ValueQuantity;
+        else if(essentiallyInteger(q.getValue(),l))
+            v.type = ValueInt;
+        else
+            v.type = ValueFloat;
+        code.push_back({ProgramPushConstant,(int)constants.size()});
+        constants.push_back(v);
+        return true;
+    }
+
+    if(expr->getTypeId() == VariableExpression::getClassTypeId()) {
+        auto path = static_cast<const VariableExpression*>(expr)->getPath();
+        auto prop = resolve(path);
+        if(!prop)
+            return false;
+        code.push_back({ProgramPushProperty,(int)references.size()});
+        references.push_back({path,prop,_ProgramRevision,Value()});
+        return true;
+    }
+
+    if(expr->getTypeId() == OperatorExpression::getClassTypeId()) {
+        auto opExpr = static_cast<const OperatorExpression*>(expr);
+        int op;
+        switch(opExpr->getOperator()) {
+        case OperatorExpression::ADD:
+            op = ProgramAdd;
+            break;
+        case OperatorExpression::SUB:
+            op = ProgramSub;
+            break;
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            op = ProgramMul;
+            break;
+        case OperatorExpression::DIV:
+            op = ProgramDiv;
+            break;
+        case OperatorExpression::POW:
+            op = ProgramPow;
+            break;
+        case OperatorExpression::NEG:
+            op = ProgramNeg;
+            break;
+        case OperatorExpression::POS:
+            return compileNode(opExpr->getLeft(),depth);
+        default:
+            return false;
+        }
+        if(!compileNode(opExpr->getLeft(),depth))
+            return false;
+        if(op != ProgramNeg && !compileNode(opExpr->getRight(),depth+1))
+            return false;
+        code.push_back({op,0});
+        return true;
+    }
+    return false;
+}
+
+bool ExpressionProgram::eval(App::any &value) const {
+    valid = false;
+    std::vector<Value> stack;
+    stack.reserve(stackSize);
+    try {
+        for(auto &instr : code) {
+            if(instr.op == ProgramPushConstant) {
+                stack.push_back(constants[instr.index]);
+                continue;
+            }
+            if(instr.op == ProgramPushProperty) {
+                auto &ref = references[instr.index];
+                if(ref.revision != _ProgramRevision) {
+                    ref.prop = resolve(ref.path);
+                    ref.revision = _ProgramRevision;
+                }
+                if(!ref.prop)
+                    return false;
+                readValue(ref.prop,ref.last);
+                stack.push_back(ref.last);
+                continue;
+            }
+            if(instr.op == ProgramNeg) {
+                auto &v = stack.back();
+                v.quantity = -v.quantity;
+                continue;
+            }
+
+            Value r = stack.back();
+            stack.pop_back();
+            Value &l = stack.back();
+            ValueType type = std::max(l.type,r.type);
+            switch(instr.op) {
+            case ProgramAdd:
+                if(type == ValueQuantity)
+                    l.quantity = l.quantity + r.quantity;
+                else
+                    l.quantity.setValue(l.quantity.getValue() + r.quantity.getValue());
+                break;
+            case ProgramSub:
+                if(type == ValueQuantity)
+                    l.quantity = l.quantity - r.quantity;
+                else
+                    l.quantity.setValue(l.quantity.getValue() - r.quantity.getValue());
+                break;
+            case ProgramMul:
+                l.quantity = l.quantity * r.quantity;
+                break;
+            case ProgramDiv:
+                if(r.quantity.getValue() == 0.0)
+                    return false;
+                l.quantity = l.quantity / r.quantity;
+                if(type == ValueInt)
+                    type = ValueFloat;
+                break;
+            case ProgramPow:
+                if(l.type == ValueQuantity) {
+                    if(r.type == ValueQuantity)
+                        l.quantity = l.quantity.pow(r.quantity);
+                    else
+                        l.quantity = l.quantity.pow(r.quantity.getValue());
+                } else if(r.type == ValueQuantity) {
+                    // Python refuses number ** Quantity
+                    return false;
+                } else {
+                    double base = l.quantity.getValue();
+                    double exponent = r.quantity.getValue();
+                    long tmp;
+                    // Python returns complex number in this case
+                    if(base < 0.0 && r.type != ValueInt && !essentiallyInteger(exponent,tmp))
+                        return false;
+                    if(base == 0.0 && exponent < 0.0)
+                        return false;
+                    l.quantity.setValue(std::pow(base,exponent));
+                    if(type == ValueInt && exponent < 0.0)
+                        type = ValueFloat;
+                }
+                break;
+            default:
+                return false;
+            }
+            l.type = type;
+            if(!std::isfinite(l.quantity.getValue())
+                    || (type == ValueInt && std::fabs(l.quantity.getValue()) > _ProgramIntLimit))
+                return false;
+        }
+    } catch (Base::Exception &) {
+        return false;
+    }
+
+    if(stack.size() != 1)
+        return false;
+
+    // Same conversion as pyObjectToAny(pyFromQuantity())
+    auto &res = stack.back();
+    if(res.type == ValueQuantity)
+        value = res.quantity;
+    else if(res.type == ValueInt)
+        value = (long)res.quantity.getValue();
+    else
+        value = res.quantity.getValue();
+    valid = true;
+    return true;
+}
 
 ////////////////////////////////////////////////////////////////////////////////////
 
@@ -430,6 +430,14 @@ public:
 
     Range getRange() const;
 
+    /** Return the existing cell properties of the range
+     *
+     * The result is cached until the range is changed, or any object or
+     * dynamic property is added, removed or relabeled, see
+     * ExpressionProgram::invalidateReferences().
+     */
+    const std::vector<App::Property*> &getRangeProperties() const;
+
 protected:
     virtual Expression * _copy() const override;
     virtual void _toString(std::ostream &ss, bool persistent, int indent) const override;
@@ -443,6 +451,91 @@ protected:
 protected:
     std::string begin;
     std::string end;
+
+    mutable std::vector<App::Property*> cachedProps;
+    mutable std::string cachedBegin;
+    mutable std::string cachedEnd;
+    mutable long cachedRevision = -1;
+};
+
+/**
+  * Class implementing a flat, stack based program compiled from an expression
+  * tree made of numbers, units, property references and arithmetic operators.
+  *
+  * The program avoids the virtual dispatch, path resolution and Python boxing
+  * of the tree evaluation. Property references are resolved once, and resolved
+  * again after any object, dynamic property or label has changed (see
+  * invalidateReferences()).
+  */
+
+class AppExport ExpressionProgram {
+public:
+    /** Compile an expression
+     *
+     * @param expr: the expression to compile
+     * @return The new program, or null if the expression contains anything
+     * that is not supported, in which case the caller evaluates the
+     * expression as usual.
+     */
+    static ExpressionProgram *compile(const Expression *expr);
+
+    /** Evaluate the program
+     *
+     * @param value: output value, of the same type as the one returned by
+     * Expression::getValueAsAny()
+     *
+     * @return false if the program is unable to produce the exact result of
+     * the tree evaluation, e.g. on unit mismatch or division by zero. The
+     * caller shall then call Expression::getValueAsAny() to obtain the value
+     * or the proper error.
+     */
+    bool eval(App::any &value) const;
+
+    /** Check if the program would produce the same value again
+     *
+     * @return true if the last call of eval() succeeded, and none of the
+     * referenced property values has changed since then.
+     */
+    bool isUpToDate() const;
+
+    /// Invalidate the cached property references of all programs
+    static void invalidateReferences();
+
+    /// Return a counter that is increased by each invalidateReferences() call
+    static long getRevision();
+
+private:
+    ExpressionProgram() {}
+
+    enum ValueType {
+        ValueInt,
+        ValueFloat,
+        ValueQuantity,
+    };
+    struct Value {
+        Base::Quantity quantity;
+        ValueType type;
+    };
+    struct Reference {
+        ObjectIdentifier path;
+        mutable const Property *prop;
+        mutable long revision;
+        mutable Value last;
+    };
+    struct Instruction {
+        int op;
+        int index;
+    };
+
+    bool compileNode(const Expression *expr, int depth);
+    static const Property *resolve(const ObjectIdentifier &path);
+    static void readValue(const Property *prop, Value &value);
+
+    std::vector<Instruction> code;
+    std::vector<Value> constants;
+    std::vector<Reference> references;
+    int stackSize = 0;
+    mutable bool valid = false;
 };
 
 namespace ExpressionParser {
@@ -142,13 +142,21 @@ PyObject *ExtensionContainerPy::getCustomAttributes(const char* attr) const
     // be called for the correct instance.
     PyObject *func = 0;
     ExtensionContainer::ExtensionIterator it = this->getExtensionContainerPtr()->extensionBegin();
+    if (it == this->getExtensionContainerPtr()->extensionEnd())
+        return 0;
+
+    Py::Object nameobj(PyUnicode_FromString(attr), true);
     for (; it != this->getExtensionContainerPtr()->extensionEnd(); ++it) {
         // The PyTypeObject is shared by all instances of this type and therefore
         // we have to add new methods only once.
         PyObject* obj = (*it).second->getExtensionPyObject();
-        PyObject *nameobj = PyUnicode_FromString(attr);
-        func = PyObject_GenericGetAttr(obj, nameobj);
-        Py_DECREF(nameobj);
+        // Most attributes are properties, look them up in the type first to
+        // avoid raising and clearing an AttributeError for each extension
+        if (!_PyType_Lookup(Py_TYPE(obj), nameobj.ptr())) {
+            Py_DECREF(obj);
+            continue;
+        }
+        func = PyObject_GenericGetAttr(obj, nameobj.ptr());
         Py_DECREF(obj);
         if (func && PyCFunction_Check(func)) {
             PyCFunctionObject* cfunc = reinterpret_cast<PyCFunctionObject*>(func);
@@ -187,6 +187,10 @@ public:
         if(ret) return ret;
         return imp->mustExecute()?1:0;
     }
+    /// Python features are always recomputed in the main thread
+    virtual bool allowConcurrentRecompute() const override {
+        return false;
+    }
     /// recalculate the Feature
     virtual DocumentObjectExecReturn *execute(void) override {
         try {
@@ -0,0 +1,228 @@
+#***************************************************************************
+#*   Copyright (c) 2021 FreeCAD Developers                                 *
+#*                                                                         *
+#*   This file is part of the FreeCAD CAx development system.              *
+#*                                                                         *
+#*   This program is free software; you can redistribute it and/or modify  *
+#*   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#*   as published by the Free Software Foundation; either version 2 of     *
+#*   the License, or (at your option) any later version.                   *
+#*   for detail see the LICENCE text file.                                 *
+#*                                                                         *
+#*   FreeCAD is distributed in the hope that it will be useful,            *
+#*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#*   GNU Lesser General Public License for more details.                   *
+#*                                                                         *
+#*   You should have received a copy of the GNU Library General Public     *
+#*   License along with FreeCAD; if not, write to the Free Software        *
+#*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#*   USA                                                                   *
+#*                                                                         *
+#***************************************************************************/
+
+# FreeCAD batch module
+#
+# Runs the jobs of a batch file given with --batch. A batch file is a JSON
+# file with either a list of jobs or an object of the form
+#
+#   { "jobs": [...], "workers": 4, "timeout": 600, "memory": 4096,
+#     "results": "results.json" }
+#
+# Each job is an object with the keys
+#
+#   "file":      the document to open (required)
+#   "recompute": recompute the document (default true)
+#   "save":      true to save the document, or a file name to save it as
+#   "export":    a list of { "file": ..., "objects": [names] }, exported with
+#                the module registered for the file extension. Without
+#                "objects" the root objects of the document are exported.
+#   "timeout":   seconds after which the job is aborted
+#
+# On POSIX systems the jobs are distributed over worker processes forked
+# from this already initialized process, so the start up cost is only paid
+# once. A worker that exceeds the timeout is killed and replaced, and the
+# memory limit (in MB) is set as address space limit of each worker.
+# Elsewhere the jobs run one after the other in this process.
+
+import sys
+import os
+import json
+import time
+import traceback
+
+import FreeCAD
+
+
+def runJob(job):
+    result = {"file": job.get("file"), "status": "ok"}
+    start = time.time()
+    doc = None
+    try:
+        doc = FreeCAD.openDocument(job["file"])
+        if job.get("recompute", True):
+            doc.recompute()
+            invalid = [obj.Name for obj in doc.Objects if not obj.isValid()]
+            if invalid:
+                result["status"] = "invalid"
+                result["invalid"] = invalid
+        for export in job.get("export", []):
+            names = export.get("objects")
+            if names is None:
+                objs = doc.RootObjects
+            else:
+                objs = [doc.getObject(name) for name in names]
+                missing = [name for name, obj in zip(names, objs) if obj is None]
+                if missing:
+                    raise ValueError("No such objects: " + ", ".join(missing))
+            ext = os.path.splitext(export["file"])[1][1:].lower()
+            modules = FreeCAD.getExportType(ext)
+            if not modules:
+                raise ValueError("No exporter for '" + ext + "' files")
+            module = __import__(modules[0])
+            module.export(objs, export["file"])
+        save = job.get("save")
+        if save is True:
+            doc.save()
+        elif save:
+            doc.saveAs(save)
+    except Exception as e:
+        result["status"] = "error"
+        result["error"] = str(e)
+        FreeCAD.Console.PrintLog(traceback.format_exc())
+    finally:
+        if doc:
+            FreeCAD.closeDocument(doc.Name)
+    result["time"] = time.time() - start
+    return result
+
+
+def workerMain(conn, memory):
+    if memory:
+        import resource
+        limit = int(memory) * 1024 * 1024
+        resource.setrlimit(resource.RLIMIT_AS, (limit, limit))
+    while True:
+        job = conn.recv()
+        if job is None:
+            break
+        conn.send(runJob(job))
+
+
+class Worker:
+    def __init__(self, context, memory):
+        import multiprocessing
+        self.conn, child = multiprocessing.Pipe()
+        self.process = context.Process(target=workerMain, args=(child, memory))
+        self.process.daemon = True
+        self.process.start()
+        child.close()
+        self.index = None
+        self.start = 0.0
+
+    def submit(self, index, job):
+        self.index = index
+        self.start = time.time()
+        self.conn.send(job)
+
+    def stop(self):
+        try:
+            self.conn.send(None)
+        except Exception:
+            pass
+        self.process.join(5)
+        if self.process.is_alive():
+            self.process.terminate()
+
+    def kill(self):
+        self.process.terminate()
+        self.process.join()
+        self.conn.close()
+
+
+def runParallel(jobs, workers, timeout, memory):
+    import multiprocessing
+    from multiprocessing.connection import wait
+    context = multiprocessing.get_context("fork")
+    results = [None] * len(jobs)
+    pending = list(range(len(jobs)))
+    pending.reverse()
+    pool = [Worker(context, memory) for _ in range(min(workers, len(jobs)))]
+    busy = []
+
+    while pending or busy:
+        for worker in pool:
+            if worker.index is None and pending:
+                index = pending.pop()
+                worker.submit(index, jobs[index])
+                busy.append(worker)
+
+        ready = wait([worker.conn for worker in busy], 1.0)
+        now = time.time()
+        for worker in list(busy):
+            job = jobs[worker.index]
+            failure = None
+            if worker.conn in ready:
+                try:
+                    results[worker.index] = worker.conn.recv()
+                except EOFError:
+                    failure = "worker process died"
+            elif now - worker.start > job.get("timeout", timeout or float("inf")):
+                failure = "timeout"
+            else:
+                continue
+
+            busy.remove(worker)
+            if failure:
+                results[worker.index] = {"file": job.get("file"), "status": failure,
+                                         "time": now - worker.start}
+                worker.kill()
+                pool[pool.index(worker)] = Worker(context, memory)
+            else:
+                worker.index = None
+
+    for worker in pool:
+        worker.stop()
+    return results
+
+
+def runBatch(batchFile, workers):
+    with open(batchFile) as f:
+        batch = json.load(f)
+    if isinstance(batch, list):
+        batch = {"jobs": batch}
+    jobs = batch.get("jobs", [])
+    if not workers:
+        workers = int(batch.get("workers", 0)) or os.cpu_count() or 1
+    timeout = batch.get("timeout")
+
+    start = time.time()
+    if workers > 1 and len(jobs) > 1 and hasattr(os, "fork"):
+        results = runParallel(jobs, workers, timeout, batch.get("memory"))
+    else:
+        results = [runJob(job) for job in jobs]
+
+    failed = [r for r in results if r["status"] != "ok"]
+    for r in failed:
+        FreeCAD.Console.PrintError("%s: %s %s\n" % (r["file"], r["status"], r.get("error", "")))
+    FreeCAD.Console.PrintMessage("Batch: %d jobs, %d failed, %.3f s\n"
+                                 % (len(results), len(failed), time.time() - start))
+
+    output = batch.get("results")
+    if output:
+        with open(output, "w") as f:
+            json.dump(results, f, indent=2)
+    return not failed
+
+
+Log("FreeCAD batch running...\n")
+
+batchResult = False
+try:
+    batchResult = runBatch(FreeCAD.ConfigGet("BatchFile"), int(FreeCAD.ConfigGet("BatchWorkers") or 0))
+except Exception as e:
+    FreeCAD.Console.PrintError("Batch failed: " + str(e) + "\n")
+
+Log("FreeCAD batch done\n")
+
+sys.exit(0 if batchResult else 1)
@@ -43,6 +43,19 @@ def removeFromPath(module_name):
 	else:
 		Wrn(module_name + " not found in sys.path\n")
 
+def reportInitTimes(stage, times):
+	"""prints the time spent in the init script of each module, slowest first.
+		Only done if the parameter 'ProfileStartup' in
+		BaseApp/Preferences/General is set."""
+	if not FreeCAD.ParamGet("User parameter:BaseApp/Preferences/General").GetBool("ProfileStartup",False):
+		return
+	total = 0.0
+	for name, seconds in times:
+		total += seconds
+	Msg('Init: %d %s init scripts took %.3f s\n' % (len(times), stage, total))
+	for name, seconds in sorted(times, key=lambda entry: entry[1], reverse=True):
+		Msg('Init:   %8.3f s  %s\n' % (seconds, name))
+
 def setupSearchPaths(PathExtension):
 	# DLL resolution in Python 3.8 on Windows has changed
 	import sys, os
@@ -164,12 +177,15 @@ def InitApplications():
 	# proper python modules this can eventuelly be removed.
 	sys.path = [ModDir] + libpaths + [ExtDir] + sys.path
 
+	import time
+	InitTimes = []
 	for Dir in ModDict.values():
 		if ((Dir != '') & (Dir != 'CVS') & (Dir != '__init__.py')):
 			sys.path.insert(0,Dir)
 			PathExtension.append(Dir)
 			InstallFile = os.path.join(Dir,"Init.py")
 			if (os.path.exists(InstallFile)):
+				StartTime = time.time()
 				try:
 					# XXX: This looks scary securitywise...
 					if sys.version_info.major < 3:
@@ -186,7 +202,8 @@ def InitApplications():
 					Err('During initialization the error "' + str(inst) + '" occurred in ' + InstallFile + '\n')
 					Err('Please look into the log file for further information\n')
 				else:
-					Log('Init:      Initializing ' + Dir + '... done\n')
+					Log('Init:      Initializing ' + Dir + '... done (%.3f s)\n' % (time.time() - StartTime))
+				InitTimes.append((Dir, time.time() - StartTime))
 			else:
 				Log('Init:      Initializing ' + Dir + '(Init.py not found)... ignore\n')
 
@@ -199,6 +216,7 @@ def InitApplications():
 		for _, freecad_module_name, freecad_module_ispkg in pkgutil.iter_modules(freecad.__path__, "freecad."):
 			if freecad_module_ispkg:
 				Log('Init: Initializing ' + freecad_module_name + '\n')
+				StartTime = time.time()
 				try:
 					freecad_module = importlib.import_module(freecad_module_name)
 					extension_modules += [freecad_module_name]
@@ -216,9 +234,12 @@ def InitApplications():
 					Log('-'*80+'\n')
 					Log(traceback.format_exc())
 					Log('-'*80+'\n')
+				InitTimes.append((freecad_module_name, time.time() - StartTime))
 	except ImportError as inst:
 		Err('During initialization the error "' + str(inst) + '" occurred\n')
 
+	reportInitTimes('application', InitTimes)
+
 	Log("Using "+ModDir+" as module path!\n")
 	# In certain cases the PathExtension list can contain invalid strings. We concatenate them to a single string
 	# but check that the output is a valid string
@@ -630,6 +651,30 @@ class FCADLogger(object):
 
 FreeCAD.Logger = FCADLogger
 
+class FCBatchUpdate(object):
+    '''Context manager to coalesce property change notifications
+
+        with FreeCAD.BatchUpdate(doc):
+            ...
+
+    * doc: the document, defaults to the active document.
+
+    Inside the block, change notifications of the document's objects are
+    queued, and emitted once per object and property on exit.
+    '''
+    def __init__(self,doc=None):
+        self.doc = doc if doc else FreeCAD.ActiveDocument
+
+    def __enter__(self):
+        self.doc.beginBatchUpdate()
+        return self.doc
+
+    def __exit__(self,*_args):
+        self.doc.endBatchUpdate()
+        return False
+
+FreeCAD.BatchUpdate = FCBatchUpdate
+
 # init every application by importing Init.py
 try:
 	import traceback
@@ -567,6 +567,7 @@ bool LinkBaseExtension::extensionGetSubObjects(std::vector<std::string> &ret, in
                 ret = linked->getSubObjects(reason);
             else{
                 char index[30];
+                ret.reserve(ret.size()+_getElementCountValue());
                 for(int i=0,count=_getElementCountValue();i<count;++i) {
                     snprintf(index,sizeof(index),"%d.",i);
                     ret.push_back(index);
@@ -121,7 +121,9 @@ public:
       "The link element object list", ##__VA_ARGS__)
 
 #define LINK_PARAM_SHOW_ELEMENT(...) \
-    (ShowElement, bool, App::PropertyBool, true, "Enable link element list", ##__VA_ARGS__)
+    (ShowElement, bool, App::PropertyBool, true, "Enable link element list.\n"\
+      "If disabled, the array only stores PlacementList and ScaleList and\n"\
+      "shares the linked object's shape, without creating element objects", ##__VA_ARGS__)
 
 #define LINK_PARAM_MODE(...) \
     (LinkMode, long, App::PropertyEnumeration, ((long)0), "Link group mode", ##__VA_ARGS__)
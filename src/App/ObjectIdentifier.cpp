@@ -242,7 +242,13 @@ std::vector<ObjectIdentifier::Component> ObjectIdentifier::getPropertyComponents
 
 bool ObjectIdentifier::operator ==(const ObjectIdentifier &other) const
 {
-    return owner==other.owner && toString() == other.toString();
+    if(owner != other.owner)
+        return false;
+    // The hash is cached along with the string, so most mismatches are
+    // decided without comparing strings.
+    if(hash() != other.hash())
+        return false;
+    return toString() == other.toString();
 }
 
 /**
@@ -363,7 +369,9 @@ const std::string &ObjectIdentifier::toString() const
 
     s << components[result.propertyIndex].getName();
     getSubPathStr(s,result);
-    const_cast<ObjectIdentifier*>(this)->_cache = s.str();
+    auto self = const_cast<ObjectIdentifier*>(this);
+    self->_cache = s.str();
+    self->_hash = boost::hash_value(_cache);
     return _cache;
 }
 
@@ -422,9 +430,9 @@ std::string ObjectIdentifier::toPersistentString() const {
 
 std::size_t ObjectIdentifier::hash() const
 {
-    if(_hash && _cache.size())
-        return _hash;
-    const_cast<ObjectIdentifier*>(this)->_hash = boost::hash_value(toString());
+    // toString() refreshes _hash whenever it rebuilds the cached string
+    if(toString().empty())
+        return boost::hash_value(_cache);
     return _hash;
 }
 
@@ -847,17 +855,13 @@ App::DocumentObject * ObjectIdentifier::getDocumentObject(const App::Document *
             return 0;
     }
 
-    std::vector<DocumentObject*> docObjects = doc->getObjects();
-    for (std::vector<DocumentObject*>::iterator j = docObjects.begin(); j != docObjects.end(); ++j) {
-        if (strcmp((*j)->Label.getValue(), static_cast<const char*>(name)) == 0) {
-            // Found object with matching label
-            if (objectByLabel != 0)  {
-                FC_WARN("duplicate object label " << doc->getName() << '#' << name);
-                return 0;
-            }
-            objectByLabel = *j;
-        }
+    std::vector<DocumentObject*> docObjects = doc->getObjectsByLabel(name.getString());
+    if (docObjects.size() > 1) {
+        FC_WARN("duplicate object label " << doc->getName() << '#' << name);
+        return 0;
     }
+    if (docObjects.size())
+        objectByLabel = docObjects.front(); // Found object with matching label
 
     if (objectByLabel == 0 && objectById == 0) // Not found at all
         return 0;
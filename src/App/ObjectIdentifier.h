@@ -286,7 +286,10 @@ public:
     std::string getPropertyName() const;
 
     template<typename C>
-    void addComponents(const C &cs) { components.insert(components.end(), cs.begin(), cs.end()); }
+    void addComponents(const C &cs) {
+        components.insert(components.end(), cs.begin(), cs.end());
+        _cache.clear();
+    }
 
     const Component & getPropertyComponent(int i, int *idx=0) const;
 
@@ -0,0 +1,91 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <mutex>
+# include <new>
+# include <vector>
+#endif
+
+#include "ObjectPool.h"
+
+using namespace App;
+
+namespace {
+
+struct Pool {
+    std::mutex mutex;
+    // Free list per size class, linked through the first word of each slot
+    void *freeList[ObjectPool::MaxSize / ObjectPool::Granularity] = {};
+    std::vector<void*> blocks;
+
+    void *allocate(std::size_t index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        void *p = freeList[index];
+        if (!p) {
+            // Carve a new block into slots of this size class
+            std::size_t slot = (index + 1) * ObjectPool::Granularity;
+            std::size_t count = ObjectPool::BlockSize / slot;
+            char *block = static_cast<char*>(::operator new(slot * count));
+            blocks.push_back(block);
+            for (std::size_t i = count; i-- > 0;) {
+                void *s = block + i * slot;
+                *static_cast<void**>(s) = p;
+                p = s;
+            }
+        }
+        freeList[index] = *static_cast<void**>(p);
+        return p;
+    }
+
+    void deallocate(void *p, std::size_t index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        *static_cast<void**>(p) = freeList[index];
+        freeList[index] = p;
+    }
+};
+
+// Intentionally leaked, objects may still be freed during static destruction
+Pool &getPool() {
+    static Pool *pool = new Pool;
+    return *pool;
+}
+
+} // anonymous namespace
+
+void *ObjectPool::allocate(std::size_t size)
+{
+    if (size == 0 || size > MaxSize)
+        return ::operator new(size);
+    return getPool().allocate((size - 1) / Granularity);
+}
+
+void ObjectPool::deallocate(void *p, std::size_t size)
+{
+    if (!p)
+        return;
+    if (size == 0 || size > MaxSize)
+        ::operator delete(p);
+    else
+        getPool().deallocate(p, (size - 1) / Granularity);
+}
@@ -0,0 +1,68 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#ifndef APP_OBJECTPOOL_H
+#define APP_OBJECTPOOL_H
+
+#include <cstddef>
+
+namespace App
+{
+
+/** Size bucketed memory pool for document objects and properties
+ *
+ * A document holds many small, long lived objects of only a few distinct
+ * sizes. DocumentObject and Property route their class specific operator
+ * new and delete through this pool. Memory is carved from large blocks, so
+ * objects created together, e.g. by an importer, end up close together,
+ * and a freed slot is reused by the next object of the same size class.
+ * Requests larger than MaxSize go to the global heap.
+ *
+ * Blocks are never returned to the system, only recycled.
+ */
+class AppExport ObjectPool
+{
+public:
+    enum {
+        /// Allocation granularity, also the guaranteed alignment
+        Granularity = 16,
+        /// Largest size served from the pool
+        MaxSize = 4096,
+        /// Size of the blocks the slots are carved from
+        BlockSize = 64 * 1024,
+    };
+
+    static void *allocate(std::size_t size);
+    static void deallocate(void *p, std::size_t size);
+};
+
+} //namespace App
+
+/// Declare class specific operator new and delete that use App::ObjectPool
+#define FC_OBJECT_POOL_ALLOCATOR \
+    static void *operator new(std::size_t size) {\
+        return App::ObjectPool::allocate(size);\
+    }\
+    static void operator delete(void *p, std::size_t size) {\
+        App::ObjectPool::deallocate(p, size);\
+    }
+
+#endif // APP_OBJECTPOOL_H
@@ -78,6 +78,8 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <iterator>
+#include <mutex>
+#include <new>
 
 // Boost
 #include <boost_signals2.hpp>
@@ -28,7 +28,9 @@
 
 #include <Base/Exception.h>
 #include <Base/Persistence.h>
+#include <App/ObjectPool.h>
 #include <boost/any.hpp>
+#include <algorithm>
 #include <string>
 #include <bitset>
 
@@ -100,6 +102,9 @@ public:
     Property();
     virtual ~Property();
 
+    /// Dynamic properties and copies are allocated from App::ObjectPool
+    FC_OBJECT_POOL_ALLOCATOR
+
     /// For safe deleting of a dynamic property
     static void destroy(Property *p);
 
@@ -401,6 +406,36 @@ public:
         _touchList.clear();
     }
 
+    /** @name Compact undo/redo support */
+    //@{
+    /** Reduce a copy of the former value of this list to the elements that
+     * differ from the current value.
+     *
+     * @param copy: a copy of this property made by Copy() before the change
+     * @param start: returns the index of the first differing element
+     * @param count: returns the number of elements in the current value that
+     * replaced the remaining elements of \a copy
+     *
+     * @return Returns true if \a copy has been reduced. The default
+     * implementation does nothing and returns false.
+     */
+    virtual bool trimCopy(Property &copy, int &start, int &count) const {
+        (void)copy;
+        (void)start;
+        (void)count;
+        return false;
+    }
+    /** Reverse trimCopy()
+     * The current value must be the same as at the time when the copy was
+     * trimmed.
+     */
+    virtual void expandCopy(Property &copy, int start, int count) const {
+        (void)copy;
+        (void)start;
+        (void)count;
+    }
+    //@}
+
 protected:
     virtual void setPyValues(const std::vector<PyObject*> &vals, const std::vector<int> &indices) {
         (void)vals;
@@ -509,6 +544,51 @@ public:
         guard.tryInvoke();
     }
 
+    virtual bool trimCopy(Property &copy, int &start, int &count) const override {
+        if (copy.getTypeId() != this->getTypeId())
+            return false;
+        ListT &values = static_cast<PropertyListsT&>(copy)._lValueList;
+        std::size_t oldSize = values.size();
+        std::size_t newSize = _lValueList.size();
+        std::size_t common = std::min(oldSize, newSize);
+        std::size_t prefix = 0;
+        while (prefix < common && values[prefix] == _lValueList[prefix])
+            ++prefix;
+        std::size_t suffix = 0;
+        while (suffix < common - prefix
+                && values[oldSize-suffix-1] == _lValueList[newSize-suffix-1])
+            ++suffix;
+        if (prefix + suffix == 0)
+            return false;
+
+        ListT range;
+        range.resize(oldSize - prefix - suffix);
+        for (std::size_t i=0; i<range.size(); ++i)
+            range[i] = values[prefix+i];
+        values.swap(range);
+        start = static_cast<int>(prefix);
+        count = static_cast<int>(newSize - prefix - suffix);
+        return true;
+    }
+
+    virtual void expandCopy(Property &copy, int start, int count) const override {
+        if (copy.getTypeId() != this->getTypeId())
+            return;
+        ListT &range = static_cast<PropertyListsT&>(copy)._lValueList;
+        std::size_t first = static_cast<std::size_t>(start);
+        std::size_t last = first + static_cast<std::size_t>(count);
+        std::size_t suffix = _lValueList.size() - last;
+        ListT values;
+        values.resize(first + range.size() + suffix);
+        for (std::size_t i=0; i<first; ++i)
+            values[i] = _lValueList[i];
+        for (std::size_t i=0; i<range.size(); ++i)
+            values[first+i] = range[i];
+        for (std::size_t i=0; i<suffix; ++i)
+            values[first+range.size()+i] = _lValueList[last+i];
+        range.swap(values);
+    }
+
 protected:
 
     void setPyValues(const std::vector<PyObject*> &vals, const std::vector<int> &indices) override 
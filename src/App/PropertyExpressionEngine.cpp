@@ -29,12 +29,14 @@
 #include <Base/Reader.h>
 #include <Base/Tools.h>
 #include "Expression.h"
+#include "ExpressionParser.h"
 #include "ExpressionVisitors.h"
 #include "PropertyExpressionEngine.h"
 #include "PropertyStandard.h"
 #include "PropertyUnits.h"
 #include <CXX/Objects.hxx>
 #include <boost/bind/bind.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/graph/graph_traits.hpp>
 
 
@@ -51,6 +53,22 @@ PropertyExpressionContainer::PropertyExpressionContainer() {
     if(!inited) {
         inited = true;
         GetApplication().signalRelabelDocument.connect(PropertyExpressionContainer::slotRelabelDocument);
+
+        // Any of these may change what a compiled expression refers to
+        auto invalidate = [](const App::DocumentObject &) {
+            ExpressionProgram::invalidateReferences();
+        };
+        auto invalidateProp = [](const App::Property &) {
+            ExpressionProgram::invalidateReferences();
+        };
+        GetApplication().signalNewObject.connect(invalidate);
+        GetApplication().signalDeletedObject.connect(invalidate);
+        GetApplication().signalRelabelObject.connect(invalidate);
+        GetApplication().signalAppendDynamicProperty.connect(invalidateProp);
+        GetApplication().signalRemoveDynamicProperty.connect(invalidateProp);
+        GetApplication().signalDeleteDocument.connect([](const App::Document &) {
+            ExpressionProgram::invalidateReferences();
+        });
     }
     _ExprContainers.insert(this);
 }
@@ -65,6 +83,7 @@ void PropertyExpressionContainer::slotRelabelDocument(const App::Document &doc)
     // because document relabel is not undoable/redoable.
     
     if(doc.getOldLabel() != doc.Label.getValue()) {
+        ExpressionProgram::invalidateReferences();
         for(auto prop : _ExprContainers)
             prop->onRelabeledDocument(doc);
     }
@@ -119,6 +138,10 @@ Property *PropertyExpressionEngine::Copy() const
 
 void PropertyExpressionEngine::hasSetValue()
 {
+    // Expressions may have been modified in place, e.g. by a rename
+    clearPrograms();
+    evaluationOrders.clear();
+
     App::DocumentObject *owner = dynamic_cast<App::DocumentObject*>(getContainer());
     if(!owner || !owner->getNameInDocument() || owner->isRestoring() || testFlag(LinkDetached)) {
         PropertyExpressionContainer::hasSetValue();
@@ -457,9 +480,21 @@ void PropertyExpressionEngine::buildGraph(const ExpressionMap & exprs,
  * order, in case properties depends on each other.
  */
 
-std::vector<App::ObjectIdentifier> PropertyExpressionEngine::computeEvaluationOrder(ExecuteOption option)
+PropertyExpressionEngine::EvaluationOrder
+PropertyExpressionEngine::computeEvaluationOrder(ExecuteOption option)
 {
-    std::vector<App::ObjectIdentifier> evaluationOrder;
+    // The graph depends on the expressions, and on how their references are
+    // resolved, e.g. by label. So reuse the order until either changes.
+    long revision = ExpressionProgram::getRevision();
+    if(revision != evaluationOrderRevision) {
+        evaluationOrders.clear();
+        evaluationOrderRevision = revision;
+    }
+    auto &cached = evaluationOrders[option];
+    if(cached)
+        return cached;
+
+    auto evaluationOrder = boost::make_shared<std::vector<App::ObjectIdentifier> >();
     boost::unordered_map<int, ObjectIdentifier> revNodes;
     DiGraph g;
 
@@ -471,10 +506,11 @@ std::vector<App::ObjectIdentifier> PropertyExpressionEngine::computeEvaluationOr
 
     for (std::vector<int>::iterator i = c.begin(); i != c.end(); ++i) {
         if (revNodes.find(*i) != revNodes.end())
-            evaluationOrder.push_back(revNodes[*i]);
+            evaluationOrder->push_back(revNodes[*i]);
     }
 
-    return evaluationOrder;
+    cached = evaluationOrder;
+    return cached;
 }
 
 /**
@@ -526,15 +562,17 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
     resetter r(running);
 
     // Compute evaluation order
-    std::vector<App::ObjectIdentifier> evaluationOrder = computeEvaluationOrder(option);
-    std::vector<ObjectIdentifier>::const_iterator it = evaluationOrder.begin();
+    // Compute evaluation order. Keep a reference, as the cache may be cleared
+    // while evaluating.
+    EvaluationOrder evaluationOrder = computeEvaluationOrder(option);
+    std::vector<ObjectIdentifier>::const_iterator it = evaluationOrder->begin();
 
 #ifdef FC_PROPERTYEXPRESSIONENGINE_LOG
     std::clog << "Computing expressions for " << getName() << std::endl;
 #endif
 
     /* Evaluate the expressions, and update properties */
-    for (;it != evaluationOrder.end();++it) {
+    for (;it != evaluationOrder->end();++it) {
 
         // Get property to update
         Property * prop = it->getProperty();
@@ -549,10 +587,20 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
             throw Base::RuntimeError("Invalid property owner.");
 
         /* Set value of property */
+        // Skip the expression if it was evaluated by the compiled program, and
+        // neither its inputs nor the bound property has changed since then.
+        // Changes propagate in evaluation order, as any re-evaluated
+        // expression changes the inputs of its dependents.
+        auto &info = expressions[*it];
+        if(info.evaluated && !prop->isTouched() && info.program->isUpToDate())
+            continue;
+        info.evaluated = false;
+
         App::any value;
         try {
             // Evaluate expression
-            value = expressions[*it].expression->getValueAsAny();
+            bool compiled = false;
+            value = evaluate(info, compiled);
             if(option == ExecuteOnRestore && prop->testStatus(Property::EvalOnRestore)) {
                 if(isAnyEqual(value, prop->getPathValue(*it)))
                     continue;
@@ -560,6 +608,7 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute(ExecuteOption o
                     *touched = true;
             }
             prop->setPathValue(*it, value);
+            info.evaluated = compiled;
         }catch(Base::Exception &e) {
             std::ostringstream ss;
             ss << e.what() << std::endl << "in property binding '" << prop->getName() << "'";
@@ -926,4 +975,33 @@ void PropertyExpressionEngine::onRelabeledDocument(const App::Document &doc)
     RelabelDocumentExpressionVisitor v(doc);
     for(auto &e : expressions) 
         e.second.expression->visit(v);
+    clearPrograms();
+}
+
+/**
+ * @brief Evaluate an expression, using its compiled program if possible.
+ * @param info Expression to evaluate
+ * @return The value of the expression
+ */
+
+App::any PropertyExpressionEngine::evaluate(ExpressionInfo &info, bool &compiled)
+{
+    if(!info.compiled) {
+        info.compiled = true;
+        info.program.reset(ExpressionProgram::compile(info.expression.get()));
+    }
+    App::any value;
+    compiled = info.program && info.program->eval(value);
+    if(compiled)
+        return value;
+    return info.expression->getValueAsAny();
+}
+
+void PropertyExpressionEngine::clearPrograms()
+{
+    for(auto &e : expressions) {
+        e.second.program.reset();
+        e.second.compiled = false;
+        e.second.evaluated = false;
+    }
 }
@@ -43,6 +43,7 @@ class DocumentObject;
 class DocumentObjectExecReturn;
 class ObjectIdentifier;
 class Expression;
+class ExpressionProgram;
 
 class AppExport PropertyExpressionContainer : public App::PropertyXLinkContainer
 {
@@ -85,6 +86,9 @@ public:
 
     struct ExpressionInfo {
         boost::shared_ptr<App::Expression> expression; /**< The actual expression tree */
+        boost::shared_ptr<App::ExpressionProgram> program; /**< The compiled expression, if supported */
+        bool compiled = false; /**< Whether compilation has been attempted */
+        bool evaluated = false; /**< Whether the current value was assigned by the compiled program */
 
         ExpressionInfo(boost::shared_ptr<App::Expression> expression = boost::shared_ptr<App::Expression>()) {
             this->expression = expression;
@@ -96,6 +100,9 @@ public:
 
         ExpressionInfo & operator=(const ExpressionInfo & other) {
             expression = other.expression;
+            program.reset();
+            compiled = false;
+            evaluated = false;
             return *this;
         }
     };
@@ -176,7 +183,8 @@ private:
     typedef std::pair<int, int> Edge;
     typedef boost::unordered_map<const App::ObjectIdentifier, ExpressionInfo> ExpressionMap;
 
-    std::vector<App::ObjectIdentifier> computeEvaluationOrder(ExecuteOption option);
+    typedef boost::shared_ptr<const std::vector<App::ObjectIdentifier> > EvaluationOrder;
+    EvaluationOrder computeEvaluationOrder(ExecuteOption option);
 
     void buildGraphStructures(const App::ObjectIdentifier &path,
                               const boost::shared_ptr<Expression> expression, boost::unordered_map<App::ObjectIdentifier, int> &nodes,
@@ -186,11 +194,19 @@ private:
                 boost::unordered_map<int, App::ObjectIdentifier> &revNodes, 
                 DiGraph &g, ExecuteOption option=ExecuteAll) const;
 
+    App::any evaluate(ExpressionInfo &info, bool &compiled);
+    void clearPrograms();
+
     bool running; /**< Boolean used to avoid loops */
     bool restoring = false;
 
     ExpressionMap expressions; /**< Stored expressions */
 
+    /**< Cached evaluation order per ExecuteOption, cleared whenever the
+     * expressions or the references in the application change */
+    std::map<int, EvaluationOrder> evaluationOrders;
+    long evaluationOrderRevision = -1;
+
     ValidatorFunc validator; /**< Valdiator functor */
 
     struct RestoredExpression {
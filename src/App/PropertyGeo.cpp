@@ -362,19 +362,13 @@ void PropertyVectorList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    if (!isSinglePrecision()) {
-        for (std::vector<Base::Vector3d>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << it->x << it->y << it->z;
-        }
-    }
-    else {
-        for (std::vector<Base::Vector3d>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float x = (float)it->x;
-            float y = (float)it->y;
-            float z = (float)it->z;
-            str << x << y << z;
-        }
-    }
+    // Vector3d is three packed doubles, write the whole list at once
+    static_assert(sizeof(Base::Vector3d) == 3*sizeof(double), "Vector3d is expected to be packed");
+    const double *values = _lValueList.empty() ? 0 : &_lValueList.front().x;
+    if (!isSinglePrecision())
+        str.write(values, 3*_lValueList.size());
+    else
+        str.writeAsFloat(values, 3*_lValueList.size());
 }
 
 void PropertyVectorList::RestoreDocFile(Base::Reader &reader)
@@ -383,18 +377,11 @@ void PropertyVectorList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<Base::Vector3d> values(uCt);
-    if (!isSinglePrecision()) {
-        for (std::vector<Base::Vector3d>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> it->x >> it->y >> it->z;
-        }
-    }
-    else {
-        float x,y,z;
-        for (std::vector<Base::Vector3d>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> x >> y >> z;
-            it->Set(x, y, z);
-        }
-    }
+    double *data = values.empty() ? 0 : &values.front().x;
+    if (!isSinglePrecision())
+        str.read(data, 3*values.size());
+    else
+        str.readAsFloat(data, 3*values.size());
     setValues(values);
 }
 
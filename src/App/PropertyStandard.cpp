@@ -96,7 +96,7 @@ long PropertyInteger::getValue(void) const
 
 PyObject *PropertyInteger::getPyObject(void)
 {
-    return Py_BuildValue("l", _lValue);
+    return PyInt_FromLong(_lValue);
 }
 
 void PropertyInteger::setPyObject(PyObject *value)
@@ -984,7 +984,7 @@ double PropertyFloat::getValue(void) const
 
 PyObject *PropertyFloat::getPyObject(void)
 {
-    return Py_BuildValue("d", _dValue);
+    return PyFloat_FromDouble(_dValue);
 }
 
 void PropertyFloat::setPyObject(PyObject *value)
@@ -1283,15 +1283,10 @@ void PropertyFloatList::SaveDocFile (Base::Writer &writer) const
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
     if (!isSinglePrecision()) {
-        for (std::vector<double>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << *it;
-        }
+        str.write(_lValueList.data(), _lValueList.size());
     }
     else {
-        for (std::vector<double>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float v = (float)*it;
-            str << v;
-        }
+        str.writeAsFloat(_lValueList.data(), _lValueList.size());
     }
 }
 
@@ -1301,18 +1296,10 @@ void PropertyFloatList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<double> values(uCt);
-    if (!isSinglePrecision()) {
-        for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> *it;
-        }
-    }
-    else {
-        for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-            float val;
-            str >> val;
-            (*it) = val;
-        }
-    }
+    if (!isSinglePrecision())
+        str.read(values.data(), values.size());
+    else
+        str.readAsFloat(values.data(), values.size());
     setValues(values);
 }
 
@@ -1378,21 +1365,24 @@ void PropertyString::setValue(const char* newLabel)
         }
         App::Document* doc = obj->getDocument();
         if(doc && !_hPGrp->GetBool("DuplicateLabels") && !obj->allowDuplicateLabel()) {
-            std::vector<std::string> objectLabels;
-            std::vector<App::DocumentObject*>::const_iterator it;
-            std::vector<App::DocumentObject*> objs = doc->getObjects();
             bool match = false;
-            for (it = objs.begin();it != objs.end();++it) {
-                if (*it == obj)
-                    continue; // don't compare object with itself
-                std::string objLabel = (*it)->Label.getValue();
-                if (!match && objLabel == newLabel)
+            for (auto o : doc->getObjectsByLabel(newLabel)) {
+                if (o != obj) { // don't compare object with itself
                     match = true;
-                objectLabels.push_back(objLabel);
+                    break;
+                }
             }
 
             // make sure that there is a name conflict otherwise we don't have to do anything
             if (match && *newLabel) {
+                std::vector<std::string> objectLabels;
+                std::vector<App::DocumentObject*>::const_iterator it;
+                std::vector<App::DocumentObject*> objs = doc->getObjects();
+                for (it = objs.begin();it != objs.end();++it) {
+                    if (*it != obj)
+                        objectLabels.push_back((*it)->Label.getValue());
+                }
+
                 label = newLabel;
                 // remove number from end to avoid lengthy names
                 size_t lastpos = label.length()-1;
@@ -2450,6 +2440,14 @@ PropertyColorList::~PropertyColorList()
 
 }
 
+void PropertyColorList::setValues(std::vector<Color>&& values)
+{
+    atomic_change guard(*this);
+    this->_touchList.clear();
+    this->_lValueList = std::move(values);
+    guard.tryInvoke();
+}
+
 //**************************************************************************
 // Base class implementer
 
@@ -904,6 +904,10 @@ public:
      */
     virtual ~PropertyColorList();
 
+    using PropertyListsT<Color>::setValues;
+    /// Takes over the values without copying them
+    void setValues (std::vector<Color>&& values);
+
     virtual PyObject *getPyObject(void) override;
 
     virtual void Save (Base::Writer &writer) const override;
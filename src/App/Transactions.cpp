@@ -29,6 +29,7 @@
 #endif
 
 #include <atomic>
+#include <sstream>
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include <Base/Writer.h>
@@ -36,8 +37,13 @@ using Base::Writer;
 #include <Base/Reader.h>
 using Base::XMLReader;
 #include <Base/Console.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
 #include "Transactions.h"
+#include "Application.h"
 #include "Property.h"
+#include "PropertyGeo.h"
+#include "PropertyLinks.h"
 #include "Document.h"
 #include "DocumentObject.h"
 
@@ -52,6 +58,7 @@ TYPESYSTEM_SOURCE(App::Transaction, Base::Persistence)
 // Construction/Destruction
 
 Transaction::Transaction(int id)
+  : spilled(false), memSize(0)
 {
     if(!id) id = getNewID();
     transID = id;
@@ -95,6 +102,11 @@ Transaction::~Transaction()
         }
         delete It->second;
     }
+
+    if (!spillFile.empty()) {
+        Base::FileInfo fi(spillFile);
+        fi.deleteFile();
+    }
 }
 
 static std::atomic<int> _TransactionID;
@@ -112,7 +124,69 @@ int Transaction::getLastID() {
 
 unsigned int Transaction::getMemSize (void) const
 {
-    return 0;
+    if (!memSize) {
+        memSize = sizeof(*this);
+        for (auto &info : _Objects.get<0>())
+            memSize += info.second->getMemSize();
+    }
+    return memSize;
+}
+
+void Transaction::compact()
+{
+    for (auto &info : _Objects.get<0>()) {
+        if (info.second->status == TransactionObject::Chn && info.first->isAttachedToDocument())
+            info.second->compact(info.first);
+    }
+    memSize = 0;
+}
+
+void Transaction::spill()
+{
+    if (spilled)
+        return;
+    spilled = true;
+
+    std::string fileName = App::Application::getTempFileName();
+    Base::FileInfo fi(fileName);
+    int count = 0;
+    {
+        Base::ofstream out(fi, std::ios::out | std::ios::binary);
+        if (!out) {
+            FC_WARN("Cannot create temporary file for transaction '" << Name << "'");
+            return;
+        }
+        for (auto &info : _Objects.get<0>())
+            count += info.second->spill(out);
+    }
+
+    if (count)
+        spillFile = fileName;
+    else
+        fi.deleteFile();
+    memSize = 0;
+}
+
+bool Transaction::isSpilled() const
+{
+    return spilled;
+}
+
+void Transaction::unspill()
+{
+    spilled = false;
+    if (spillFile.empty())
+        return;
+
+    Base::FileInfo fi(spillFile);
+    {
+        Base::ifstream in(fi, std::ios::in | std::ios::binary);
+        for (auto &info : _Objects.get<0>())
+            info.second->unspill(in);
+    }
+    fi.deleteFile();
+    spillFile.clear();
+    memSize = 0;
 }
 
 void Transaction::Save (Base::Writer &/*writer*/) const
@@ -143,6 +217,7 @@ bool Transaction::hasObject(const TransactionalObject *Obj) const
 void Transaction::addOrRemoveProperty(TransactionalObject *Obj,
                                     const Property* pcProp, bool add)
 {
+    memSize = 0;
     auto &index = _Objects.get<1>();
     auto pos = index.find(Obj);
 
@@ -168,6 +243,7 @@ void Transaction::apply(Document &Doc, bool forward)
 {
     std::string errMsg;
     try {
+        unspill();
         auto &index = _Objects.get<0>();
         for(auto &info : index) 
             info.second->applyDel(Doc, const_cast<TransactionalObject*>(info.first));
@@ -191,6 +267,7 @@ void Transaction::apply(Document &Doc, bool forward)
 
 void Transaction::addObjectNew(TransactionalObject *Obj)
 {
+    memSize = 0;
     auto &index = _Objects.get<1>();
     auto pos = index.find(Obj);
     if (pos != index.end()) {
@@ -217,6 +294,7 @@ void Transaction::addObjectNew(TransactionalObject *Obj)
 
 void Transaction::addObjectDel(const TransactionalObject *Obj)
 {
+    memSize = 0;
     auto &index = _Objects.get<1>();
     auto pos = index.find(Obj);
 
@@ -238,6 +316,7 @@ void Transaction::addObjectDel(const TransactionalObject *Obj)
 
 void Transaction::addObjectChange(const TransactionalObject *Obj, const Property *Prop)
 {
+    memSize = 0;
     auto &index = _Objects.get<1>();
     auto pos = index.find(Obj);
 
@@ -293,7 +372,7 @@ void TransactionObject::applyNew(Document & /*Doc*/, TransactionalObject * /*pcO
 {
 }
 
-void TransactionObject::applyChn(Document & /*Doc*/, TransactionalObject *pcObj, bool /* Forward */)
+void TransactionObject::applyChn(Document & /*Doc*/, TransactionalObject *pcObj, bool Forward)
 {
     if (status == New || status == Chn) {
         // Property change order is not preserved, as it is recursive in nature
@@ -348,6 +427,18 @@ void TransactionObject::applyChn(Document & /*Doc*/, TransactionalObject *pcObj,
             //             << " -> " << prop->getTypeId().getName());
             //     continue;
             // }
+            if (data.rangeStart >= 0) {
+                // only the changed range of the list is stored, see compact()
+                auto list = dynamic_cast<PropertyListsBase*>(prop);
+                if (!list || prop->getTypeId() != data.property->getTypeId()
+                          || list->getSize() != data.listSize) {
+                    FC_ERR("Cannot " << (Forward?"redo":"undo") << " change of "
+                            << prop->getFullName() << " because it has been modified outside of a transaction");
+                    continue;
+                }
+                list->expandCopy(*data.property, data.rangeStart, data.rangeCount);
+                data.rangeStart = -1;
+            }
             try {
                 prop->Paste(*data.property);
             } catch (Base::Exception &e) {
@@ -404,9 +495,125 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
     }
 }
 
+void TransactionObject::compact(const TransactionalObject *pcObj)
+{
+    for (auto &v : _PropChangeMap) {
+        auto &data = v.second;
+        if (!data.property || data.rangeStart >= 0)
+            continue;
+        // the property may have been removed in the meantime, see applyChn()
+        if (!pcObj->getPropertyName(v.first))
+            continue;
+        // Output properties may be changed by a recompute outside of any
+        // transaction, so the stored range would not fit anymore.
+        if (v.first->testStatus(Property::Output) || (v.first->getType() & Prop_Output))
+            continue;
+        auto list = dynamic_cast<const PropertyListsBase*>(v.first);
+        if (!list)
+            continue;
+        int start, count;
+        if (list->trimCopy(*data.property, start, count)) {
+            data.rangeStart = start;
+            data.rangeCount = count;
+            data.listSize = list->getSize();
+        }
+    }
+}
+
+static bool canSpill(const Property *prop)
+{
+    // Only plain data is written. Properties referring to other objects
+    // cannot be restored without their container.
+    if (prop->getMemSize() < 4096)
+        return false;
+    if (prop->isDerivedFrom(PropertyComplexGeoData::getClassTypeId()))
+        return true;
+    return prop->isDerivedFrom(PropertyLists::getClassTypeId())
+        && !prop->isDerivedFrom(PropertyLinkBase::getClassTypeId());
+}
+
+int TransactionObject::spill(std::ostream &out)
+{
+    int count = 0;
+    for (auto &v : _PropChangeMap) {
+        auto &data = v.second;
+        if (!data.property || !canSpill(data.property))
+            continue;
+
+        std::streamoff offset = out.tellp();
+        try {
+            data.property->dumpToStream(out, 1);
+        }
+        catch (Base::Exception &e) {
+            FC_WARN("Failed to write transaction data of " << data.property->getTypeId().getName()
+                    << ": " << e.what());
+            continue;
+        }
+        if (!out)
+            break;
+
+        data.spillType = data.property->getTypeId();
+        data.spillStatus = data.property->getStatus();
+        data.spillOffset = offset;
+        data.spillSize = static_cast<std::streamsize>(out.tellp() - offset);
+        delete data.property;
+        data.property = 0;
+        ++count;
+    }
+    return count;
+}
+
+void TransactionObject::unspill(std::istream &in)
+{
+    for (auto it = _PropChangeMap.begin(); it != _PropChangeMap.end();) {
+        auto &data = it->second;
+        if (data.spillOffset < 0) {
+            ++it;
+            continue;
+        }
+
+        Property *prop = static_cast<Property*>(data.spillType.createInstance());
+        try {
+            if (!prop)
+                throw Base::TypeError("Cannot create property");
+            std::string buffer(static_cast<std::size_t>(data.spillSize), '\0');
+            in.seekg(data.spillOffset);
+            in.read(&buffer[0], data.spillSize);
+            if (!in)
+                throw Base::FileException("Failed to read transaction data");
+            std::istringstream str(buffer);
+            prop->restoreFromStream(str);
+            prop->setStatusValue(data.spillStatus);
+        }
+        catch (Base::Exception &e) {
+            FC_ERR("Failed to restore transaction data of " << data.spillType.getName()
+                    << ": " << e.what());
+            delete prop;
+            prop = 0;
+        }
+
+        if (!prop) {
+            // A null property would mean the property has been added by the
+            // transaction, so drop the change instead.
+            it = _PropChangeMap.erase(it);
+            continue;
+        }
+
+        data.property = prop;
+        data.spillOffset = -1;
+        ++it;
+    }
+}
+
 unsigned int TransactionObject::getMemSize (void) const
 {
-    return 0;
+    unsigned int size = sizeof(*this);
+    for (auto &v : _PropChangeMap) {
+        size += sizeof(v);
+        if (v.second.property)
+            size += v.second.property->getMemSize();
+    }
+    return size;
 }
 
 void TransactionObject::Save (Base::Writer &/*writer*/) const
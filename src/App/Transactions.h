@@ -87,8 +87,27 @@ public:
     void addObjectDel(const TransactionalObject *Obj);
     void addObjectChange(const TransactionalObject *Obj, const Property *Prop);
 
+    /** @name Memory reduction */
+    //@{
+    /** Store only the changed range of list properties
+     * Must be called right after the transaction has been committed, because
+     * the stored ranges are relative to the current property values.
+     */
+    void compact();
+    /// Move large property values into a temporary file until the transaction is applied
+    void spill();
+    /// Check if spill() has been called since the transaction was last applied
+    bool isSpilled() const;
+    //@}
+
+private:
+    void unspill();
+
 private:
     int transID;
+    std::string spillFile;
+    bool spilled;
+    mutable unsigned int memSize;
     typedef std::pair<const TransactionalObject*, TransactionObject*> Info;
     bmi::multi_index_container<
         Info,
@@ -120,6 +139,10 @@ public:
     void setProperty(const Property* pcProp);
     void addOrRemoveProperty(const Property* pcProp, bool add);
 
+    void compact(const TransactionalObject *pcObj);
+    int spill(std::ostream &out);
+    void unspill(std::istream &in);
+
     virtual unsigned int getMemSize (void) const;
     virtual void Save (Base::Writer &writer) const;
     /// This method is used to restore properties from an XML document.
@@ -132,6 +155,15 @@ protected:
 
     struct PropData : DynamicProperty::PropData {
         Base::Type propertyType;
+        // range of a list property stored by compact()
+        int rangeStart = -1;
+        int rangeCount = 0;
+        int listSize = 0;
+        // location of the value in the file written by spill()
+        Base::Type spillType;
+        unsigned long spillStatus = 0;
+        std::streamoff spillOffset = -1;
+        std::streamsize spillSize = 0;
     };
     std::unordered_map<const Property*, PropData> _PropChangeMap;
 
@@ -33,12 +33,15 @@
 #  include <unistd.h>
 # endif
 # include "fcntl.h"
+# include <mutex>
+# include <vector>
 #endif
 
 #include "Console.h"
 #include "Exception.h"
 #include "PyObjectBase.h"
 #include <QCoreApplication>
+#include <QThread>
 #include <frameobject.h>
 
 using namespace Base;
@@ -50,66 +53,118 @@ using namespace Base;
 
 namespace Base {
 
-class ConsoleEvent : public QEvent {
-public:
-    ConsoleSingleton::FreeCAD_ConsoleMsgType msgtype;
-    std::string msg;
-
-    ConsoleEvent(ConsoleSingleton::FreeCAD_ConsoleMsgType type, const std::string& msg)
-        : QEvent(QEvent::User), msgtype(type), msg(msg)
-    {
-    }
-    ~ConsoleEvent()
-    {
-    }
-};
-
+/* Queue of messages to be delivered to the observers by the main thread.
+ * The messages are collected in a buffer and only one event is posted for
+ * all messages arriving until the main thread processes it. So, the calling
+ * thread only ever holds the lock for appending a string.
+ */
 class ConsoleOutput : public QObject
 {
 public:
     static ConsoleOutput* getInstance() {
-        if (!instance)
+        std::lock_guard<std::mutex> lock(instanceMutex);
+        if (!instance) {
             instance = new ConsoleOutput;
+            // the messages must be delivered by the main thread no matter
+            // which thread has created the queue
+            if (QCoreApplication::instance())
+                instance->moveToThread(QCoreApplication::instance()->thread());
+        }
         return instance;
     }
     static void destruct() {
-        delete instance;
-        instance = 0;
+        ConsoleOutput* output;
+        {
+            std::lock_guard<std::mutex> lock(instanceMutex);
+            output = instance;
+            instance = 0;
+        }
+        if (output)
+            output->flush();
+        delete output;
+    }
+    /* Delivers the queued messages of other threads before a message of the
+     * main thread to keep their order, and in case no event loop is running.
+     */
+    static void flushPending() {
+        ConsoleOutput* output;
+        {
+            std::lock_guard<std::mutex> lock(instanceMutex);
+            output = instance;
+        }
+        if (output)
+            output->flush();
+    }
+
+    void post(ConsoleSingleton::FreeCAD_ConsoleMsgType type, const char* msg) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.emplace_back(type, msg);
+        if (!posted) {
+            posted = true;
+            QCoreApplication::postEvent(this, new QEvent(QEvent::User));
+        }
     }
 
     void customEvent(QEvent* ev) {
-        if (ev->type() == QEvent::User) {
-            ConsoleEvent* ce = static_cast<ConsoleEvent*>(ev);
-            switch (ce->msgtype) {
+        if (ev->type() == QEvent::User)
+            flush();
+    }
+
+private:
+    void flush() {
+        std::vector<std::pair<ConsoleSingleton::FreeCAD_ConsoleMsgType, std::string> > messages;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            messages.swap(pending);
+            posted = false;
+        }
+
+        for (const auto& it : messages) {
+            const char* msg = it.second.c_str();
+            switch (it.first) {
             case ConsoleSingleton::MsgType_Txt:
-                Console().NotifyMessage(ce->msg.c_str());
+                Console().DeliverMessage(msg);
                 break;
             case ConsoleSingleton::MsgType_Log:
-                Console().NotifyLog(ce->msg.c_str());
+                Console().DeliverLog(msg);
                 break;
             case ConsoleSingleton::MsgType_Wrn:
-                Console().NotifyWarning(ce->msg.c_str());
+                Console().DeliverWarning(msg);
                 break;
             case ConsoleSingleton::MsgType_Err:
-                Console().NotifyError(ce->msg.c_str());
+                Console().DeliverError(msg);
                 break;
             }
         }
     }
 
-private:
-    ConsoleOutput()
+    ConsoleOutput() : posted(false)
     {
     }
     ~ConsoleOutput()
     {
     }
 
+    std::mutex mutex;
+    std::vector<std::pair<ConsoleSingleton::FreeCAD_ConsoleMsgType, std::string> > pending;
+    bool posted;
+
+    static std::mutex instanceMutex;
     static ConsoleOutput* instance;
 };
 
+std::mutex ConsoleOutput::instanceMutex;
 ConsoleOutput* ConsoleOutput::instance = 0;
 
+/* Messages of threads other than the main thread are always queued because
+ * the observers, e.g. the report view, are not thread safe.
+ */
+static inline bool isMainThread()
+{
+    QCoreApplication* app = QCoreApplication::instance();
+    return !app || QThread::currentThread() == app->thread();
+}
+
 }
 
 //**************************************************************************
@@ -255,6 +310,8 @@ void ConsoleSingleton::SetConnectionMode(ConnectionMode mode)
 void ConsoleSingleton::Message( const char *pMsg, ... )
 {
 #define FC_CONSOLE_FMT(_type,_type2) \
+    if (!hasObserver(MsgType_##_type2))\
+        return;\
     char format[BufferSize];\
     format[sizeof(format)-4] = '.';\
     format[sizeof(format)-3] = '.';\
@@ -269,7 +326,7 @@ void ConsoleSingleton::Message( const char *pMsg, ... )
     if (connectionMode == Direct)\
         Notify##_type(format);\
     else\
-        QCoreApplication::postEvent(ConsoleOutput::getInstance(), new ConsoleEvent(MsgType_##_type2, format));
+        ConsoleOutput::getInstance()->post(MsgType_##_type2, format);
 
     FC_CONSOLE_FMT(Message,Txt);
 }
@@ -384,7 +441,75 @@ void ConsoleSingleton::DetachObserver(ILogger *pcObserver)
     _aclObservers.erase(pcObserver);
 }
 
+/** Checks whether any observer accepts messages of the given type
+ *  This is used to reject messages before they are formatted.
+ */
+bool ConsoleSingleton::hasObserver(FreeCAD_ConsoleMsgType type) const
+{
+    for (std::set<ILogger * >::const_iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
+        switch (type) {
+        case MsgType_Txt:
+            if ((*Iter)->bMsg)
+                return true;
+            break;
+        case MsgType_Log:
+            if ((*Iter)->bLog)
+                return true;
+            break;
+        case MsgType_Wrn:
+            if ((*Iter)->bWrn)
+                return true;
+            break;
+        case MsgType_Err:
+            if ((*Iter)->bErr)
+                return true;
+            break;
+        }
+    }
+    return false;
+}
+
 void ConsoleSingleton::NotifyMessage(const char *sMsg)
+{
+    if (!isMainThread())
+        ConsoleOutput::getInstance()->post(MsgType_Txt, sMsg);
+    else {
+        ConsoleOutput::flushPending();
+        DeliverMessage(sMsg);
+    }
+}
+
+void ConsoleSingleton::NotifyWarning(const char *sMsg)
+{
+    if (!isMainThread())
+        ConsoleOutput::getInstance()->post(MsgType_Wrn, sMsg);
+    else {
+        ConsoleOutput::flushPending();
+        DeliverWarning(sMsg);
+    }
+}
+
+void ConsoleSingleton::NotifyError(const char *sMsg)
+{
+    if (!isMainThread())
+        ConsoleOutput::getInstance()->post(MsgType_Err, sMsg);
+    else {
+        ConsoleOutput::flushPending();
+        DeliverError(sMsg);
+    }
+}
+
+void ConsoleSingleton::NotifyLog(const char *sMsg)
+{
+    if (!isMainThread())
+        ConsoleOutput::getInstance()->post(MsgType_Log, sMsg);
+    else {
+        ConsoleOutput::flushPending();
+        DeliverLog(sMsg);
+    }
+}
+
+void ConsoleSingleton::DeliverMessage(const char *sMsg)
 {
     for (std::set<ILogger * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
         if ((*Iter)->bMsg)
@@ -392,7 +517,7 @@ void ConsoleSingleton::NotifyMessage(const char *sMsg)
     }
 }
 
-void ConsoleSingleton::NotifyWarning(const char *sMsg)
+void ConsoleSingleton::DeliverWarning(const char *sMsg)
 {
     for (std::set<ILogger * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
         if ((*Iter)->bWrn)
@@ -400,7 +525,7 @@ void ConsoleSingleton::NotifyWarning(const char *sMsg)
     }
 }
 
-void ConsoleSingleton::NotifyError(const char *sMsg)
+void ConsoleSingleton::DeliverError(const char *sMsg)
 {
     for (std::set<ILogger * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
         if ((*Iter)->bErr)
@@ -408,7 +533,7 @@ void ConsoleSingleton::NotifyError(const char *sMsg)
     }
 }
 
-void ConsoleSingleton::NotifyLog(const char *sMsg)
+void ConsoleSingleton::DeliverLog(const char *sMsg)
 {
     for (std::set<ILogger * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();++Iter) {
         if ((*Iter)->bLog)
@@ -587,6 +587,15 @@ namespace Base {
             void EnableRefresh(bool enable);
 
         protected:
+            /// Returns true if at least one observer accepts messages of this type
+            bool hasObserver(FreeCAD_ConsoleMsgType type) const;
+
+            // send the message to the observers, must be called by the main thread
+            void DeliverMessage(const char *sMsg);
+            void DeliverWarning(const char *sMsg);
+            void DeliverError  (const char *sMsg);
+            void DeliverLog    (const char *sMsg);
+
             // python exports goes here +++++++++++++++++++++++++++++++++++++++++++
             // static python wrapper of the exported functions
             static PyObject *sPyLog      (PyObject *self,PyObject *args);
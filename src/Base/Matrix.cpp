@@ -125,6 +125,38 @@ double Matrix4D::determinant() const
     return fDet;
 }
 
+namespace {
+template <typename T>
+void transformArray(const double (&mat)[4][4], Vector3<T>* points, std::size_t count)
+{
+    // Keep the coefficients in locals. Otherwise the compiler must reload
+    // them after every store because the points might alias the matrix.
+    const double m00 = mat[0][0], m01 = mat[0][1], m02 = mat[0][2], m03 = mat[0][3];
+    const double m10 = mat[1][0], m11 = mat[1][1], m12 = mat[1][2], m13 = mat[1][3];
+    const double m20 = mat[2][0], m21 = mat[2][1], m22 = mat[2][2], m23 = mat[2][3];
+
+    for (std::size_t i = 0; i < count; i++) {
+        Vector3<T>& pnt = points[i];
+        const double sx = static_cast<double>(pnt.x);
+        const double sy = static_cast<double>(pnt.y);
+        const double sz = static_cast<double>(pnt.z);
+        pnt.x = static_cast<T>(m00*sx + m01*sy + m02*sz + m03);
+        pnt.y = static_cast<T>(m10*sx + m11*sy + m12*sz + m13);
+        pnt.z = static_cast<T>(m20*sx + m21*sy + m22*sz + m23);
+    }
+}
+}
+
+void Matrix4D::transformPoints(Vector3d* points, std::size_t count) const
+{
+    transformArray(dMtrx4D, points, count);
+}
+
+void Matrix4D::transformPoints(Vector3f* points, std::size_t count) const
+{
+    transformArray(dMtrx4D, points, count);
+}
+
 void Matrix4D::move (const Vector3f& rclVct)
 {
     move(convertTo<Vector3d>(rclVct));
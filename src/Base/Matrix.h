@@ -26,6 +26,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdio>
 #include <string>
 
@@ -85,6 +86,9 @@ public:
   inline Vector3d  operator *  (const Vector3d& rclVct) const;
   inline void multVec(const Vector3d & src, Vector3d & dst) const;
   inline void multVec(const Vector3f & src, Vector3f & dst) const;
+  /// Transform an array of points in place
+  void transformPoints(Vector3d* points, std::size_t count) const;
+  void transformPoints(Vector3f* points, std::size_t count) const;
   /// Comparison
   inline bool      operator != (const Matrix4D& rclMtrx) const;
   /// Comparison
@@ -58,6 +58,7 @@
 #endif
 
 #include <map>
+#include <string>
 #include <vector>
 #include <xercesc/util/XercesDefs.hpp>
 
@@ -273,6 +274,99 @@ protected:
 
 };
 
+/** A cached handle to a single parameter of a group
+ *  Reading a parameter with ParameterGrp searches the DOM tree and transcodes
+ *  the strings on every call. The handle instead keeps the value and only
+ *  reads it again after the group has notified its observers about a change
+ *  of this parameter. This makes it cheap to query a preference in a loop.
+ *  \code
+ *  static ParameterHandle<double> deviation(App::GetApplication().
+ *      GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Part"),
+ *      "MeshDeviation", 0.2);
+ *  double value = deviation.getValue();
+ *  \endcode
+ *  The supported types are bool, long, unsigned long, double and std::string.
+ *  @see ParameterGrp
+ */
+template<typename T>
+class ParameterHandle : public ParameterGrp::ObserverType
+{
+public:
+    ParameterHandle(const ParameterGrp::handle& hGrp, const char* Name, const T& Preset = T())
+      : _hGrp(hGrp), _cName(Name), _Preset(Preset), _Value(Preset), _bValid(false)
+    {
+        _hGrp->Attach(this);
+    }
+    virtual ~ParameterHandle()
+    {
+        _hGrp->Detach(this);
+    }
+
+    /// returns the cached value and reads it from the group if needed
+    const T& getValue() const
+    {
+        if (!_bValid) {
+            _Value = read(*_hGrp, _cName.c_str(), _Preset);
+            _bValid = true;
+        }
+        return _Value;
+    }
+    operator const T&() const
+    {
+        return getValue();
+    }
+    /// writes the value to the group
+    void setValue(const T& Value)
+    {
+        write(*_hGrp, _cName.c_str(), Value);
+    }
+    /// forces to read the value again with the next access
+    void invalidate()
+    {
+        _bValid = false;
+    }
+
+    /// the group notifies with the parameter name, or an empty name if it was cleared
+    virtual void OnChange(Base::Subject<const char*>&, const char* sReason)
+    {
+        if (!sReason || !sReason[0] || _cName == sReason)
+            _bValid = false;
+    }
+
+private:
+    static bool read(const ParameterGrp& hGrp, const char* Name, bool Preset)
+    { return hGrp.GetBool(Name, Preset); }
+    static long read(const ParameterGrp& hGrp, const char* Name, long Preset)
+    { return hGrp.GetInt(Name, Preset); }
+    static unsigned long read(const ParameterGrp& hGrp, const char* Name, unsigned long Preset)
+    { return hGrp.GetUnsigned(Name, Preset); }
+    static double read(const ParameterGrp& hGrp, const char* Name, double Preset)
+    { return hGrp.GetFloat(Name, Preset); }
+    static std::string read(const ParameterGrp& hGrp, const char* Name, const std::string& Preset)
+    { return hGrp.GetASCII(Name, Preset.c_str()); }
+
+    static void write(ParameterGrp& hGrp, const char* Name, bool Value)
+    { hGrp.SetBool(Name, Value); }
+    static void write(ParameterGrp& hGrp, const char* Name, long Value)
+    { hGrp.SetInt(Name, Value); }
+    static void write(ParameterGrp& hGrp, const char* Name, unsigned long Value)
+    { hGrp.SetUnsigned(Name, Value); }
+    static void write(ParameterGrp& hGrp, const char* Name, double Value)
+    { hGrp.SetFloat(Name, Value); }
+    static void write(ParameterGrp& hGrp, const char* Name, const std::string& Value)
+    { hGrp.SetASCII(Name, Value.c_str()); }
+
+    ParameterHandle(const ParameterHandle&) = delete;
+    ParameterHandle& operator=(const ParameterHandle&) = delete;
+
+private:
+    ParameterGrp::handle _hGrp;
+    std::string _cName;
+    T _Preset;
+    mutable T _Value;
+    mutable bool _bValid;
+};
+
 /** The parameter serializer class
  *  This is a helper class to serialize a parameter XML document.
  *  Does loading and saving the DOM document from and to files.
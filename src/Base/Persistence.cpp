@@ -72,6 +72,13 @@ void Persistence::RestoreDocFile(Reader &/*reader*/)
 {
 }
 
+bool Persistence::RestoreDocFileDeferred(const std::string &/*archive*/,
+                                         const std::string &/*fileName*/,
+                                         int /*fileVersion*/)
+{
+    return false;
+}
+
 std::string Persistence::encodeAttribute(const std::string& str)
 {
     std::string tmp;
@@ -146,6 +146,29 @@ public:
      * @see Base::Reader,Base::XMLReader
      */
     virtual void RestoreDocFile(Reader &/*reader*/);
+    /** This method is called instead of RestoreDocFile() if the reader defers
+     * the loading of additional files (see XMLReader::setDeferFiles()).
+     * An object that is able to read its data later on, e.g. on first access,
+     * remembers the archive path, the entry name and the file version and
+     * returns true. The default implementation returns false in which case
+     * RestoreDocFile() is called immediately.
+     */
+    virtual bool RestoreDocFileDeferred(const std::string &/*archive*/,
+                                        const std::string &/*fileName*/,
+                                        int /*fileVersion*/);
+    /** Returns true if the additional file can be parsed in a worker thread.
+     * In this case the reader may call RestoreDocFileConcurrent() with an
+     * in-memory copy of the file from any thread and finishRestoreDocFile()
+     * afterwards from the main thread, in the order the files were registered.
+     * The default implementation returns false.
+     */
+    virtual bool allowConcurrentRestore() const {return false;}
+    /** Parses the file into an intermediate state. It must not change anything
+     * that is observable by others, e.g. by emitting signals.
+     */
+    virtual void RestoreDocFileConcurrent(Reader &/*reader*/) {}
+    /// Applies the state parsed by RestoreDocFileConcurrent()
+    virtual void finishRestoreDocFile() {}
     /// Encodes an attribute upon saving.
     static std::string encodeAttribute(const std::string&);
 
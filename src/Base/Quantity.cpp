@@ -27,6 +27,9 @@
 # define _USE_MATH_DEFINES
 # endif // FC_OS_WIN32
 # include <cmath>
+# include <cstdlib>
+# include <cstring>
+# include <map>
 #endif
 
 #include "Quantity.h"
@@ -455,10 +458,152 @@ int QuantityLexer(void);
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 }
 
+namespace {
+
+// The most common units of QuantityParser.l. Keep them in sync with the lexer.
+std::map<std::string, Quantity> createSimpleUnits()
+{
+    std::map<std::string, Quantity> units;
+    units["nm"] = Quantity::NanoMetre;
+    units["um"] = Quantity::MicroMetre;
+    units["\xC2\xB5m"] = Quantity::MicroMetre;
+    units["mm"] = Quantity::MilliMetre;
+    units["cm"] = Quantity::CentiMetre;
+    units["dm"] = Quantity::DeciMetre;
+    units["m"] = Quantity::Metre;
+    units["km"] = Quantity::KiloMetre;
+    units["in"] = Quantity::Inch;
+    units["\""] = Quantity::Inch;
+    units["ft"] = Quantity::Foot;
+    units["'"] = Quantity::Foot;
+    units["thou"] = Quantity::Thou;
+    units["mil"] = Quantity::Thou;
+    units["yd"] = Quantity::Yard;
+    units["mi"] = Quantity::Mile;
+    units["l"] = Quantity::Liter;
+    units["ml"] = Quantity::MilliLiter;
+    units["mg"] = Quantity::MilliGram;
+    units["g"] = Quantity::Gram;
+    units["kg"] = Quantity::KiloGram;
+    units["t"] = Quantity::Ton;
+    units["lb"] = Quantity::Pound;
+    units["s"] = Quantity::Second;
+    units["min"] = Quantity::Minute;
+    units["h"] = Quantity::Hour;
+    units["K"] = Quantity::Kelvin;
+    units["N"] = Quantity::Newton;
+    units["kN"] = Quantity::KiloNewton;
+    units["Pa"] = Quantity::Pascal;
+    units["kPa"] = Quantity::KiloPascal;
+    units["MPa"] = Quantity::MegaPascal;
+    units["GPa"] = Quantity::GigaPascal;
+    units["psi"] = Quantity::PSI;
+    units["W"] = Quantity::Watt;
+    units["J"] = Quantity::Joule;
+    units["\xC2\xB0"] = Quantity::Degree;
+    units["deg"] = Quantity::Degree;
+    units["rad"] = Quantity::Radian;
+    units["gon"] = Quantity::Gon;
+    return units;
+}
+
+/* Handles the most common input of a number optionally followed by a simple
+ * unit, e.g. "10 mm" or "-2.5e3kg", without running the generated parser.
+ * Returns false for everything else, which is then passed to the parser.
+ */
+bool parseSimpleQuantity(const char* str, Quantity& result)
+{
+    const char* c = str;
+    while (*c == ' ' || *c == '\t' || *c == '\n')
+        c++;
+
+    bool negative = false;
+    if (*c == '-') {
+        negative = true;
+        c++;
+    }
+    else if (strncmp(c, "\xe2\x88\x92", 3) == 0) {
+        negative = true;
+        c += 3;
+    }
+
+    // same number formats as accepted by the lexer, see num_change()
+    char number[40];
+    int len = 0;
+    int digits = 0;
+    bool delimiter = false;
+    for (; (*c >= '0' && *c <= '9') || *c == '.' || *c == ','; c++) {
+        if (*c == '.' || *c == ',') {
+            if (delimiter)
+                return false;
+            delimiter = true;
+            number[len++] = '.';
+        }
+        else {
+            number[len++] = *c;
+            digits++;
+        }
+        if (len > 30)
+            return false;
+    }
+    if (digits == 0)
+        return false;
+    if (*c == 'e' || *c == 'E') {
+        const char* e = c + 1;
+        if (*e == '+' || *e == '-')
+            e++;
+        // 'e' not followed by digits is the constant e or part of a unit
+        if (*e < '0' || *e > '9')
+            return false;
+        number[len++] = *c++;
+        if (*c == '+' || *c == '-')
+            number[len++] = *c++;
+        for (; *c >= '0' && *c <= '9'; c++) {
+            number[len++] = *c;
+            if (len > 38)
+                return false;
+        }
+    }
+    number[len] = '\0';
+    double value = atof(number);
+    if (negative)
+        value = -value;
+
+    while (*c == ' ' || *c == '\t')
+        c++;
+    const char* unit = c;
+    while (*c && *c != ' ' && *c != '\t' && *c != '\n')
+        c++;
+    std::string unitName(unit, c - unit);
+    while (*c == ' ' || *c == '\t' || *c == '\n')
+        c++;
+    if (*c)
+        return false;
+
+    if (unitName.empty()) {
+        result = Quantity(value);
+        return true;
+    }
+
+    static const std::map<std::string, Quantity> units = createSimpleUnits();
+    auto it = units.find(unitName);
+    if (it == units.end())
+        return false;
+    result = Quantity(value) * it->second;
+    return true;
+}
+
+}
+
 Quantity Quantity::parse(const QString &string)
 {
+    QByteArray utf8 = string.toUtf8();
+    Quantity result;
+    if (parseSimpleQuantity(utf8.constData(), result))
+        return result;
+
     // parse from buffer
-    QuantityParser::YY_BUFFER_STATE my_string_buffer = QuantityParser::yy_scan_string (string.toUtf8().data());
+    QuantityParser::YY_BUFFER_STATE my_string_buffer = QuantityParser::yy_scan_string (utf8.constData());
     // set the global return variables
     QuantResult = Quantity(DOUBLE_MIN);
     // run the parser
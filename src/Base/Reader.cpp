@@ -30,7 +30,14 @@
 # include <xercesc/sax2/SAX2XMLReader.hpp>
 #endif
 
+#include <deque>
+#include <iterator>
 #include <locale>
+#include <memory>
+#include <sstream>
+
+#include <QThread>
+#include <QtConcurrentRun>
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include "Reader.h"
@@ -63,8 +70,8 @@ using namespace std;
 
 Base::XMLReader::XMLReader(const char* FileName, std::istream& str)
   : DocumentSchema(0), ProgramVersion(""), FileVersion(0), Level(0),
-    CharacterCount(0), ReadType(None), _File(FileName), _valid(false),
-    _verbose(true)
+    CharacterCount(0), AttrCount(0), ReadType(None), _File(FileName), _valid(false),
+    _verbose(true), _deferFiles(false), _parallel(false)
 {
 #ifdef _MSC_VER
     str.imbue(std::locale::empty());
@@ -122,15 +129,24 @@ const char* Base::XMLReader::localName(void) const
 
 unsigned int Base::XMLReader::getAttributeCount(void) const
 {
-    return (unsigned int)AttrMap.size();
+    return (unsigned int)AttrCount;
+}
+
+const std::string *Base::XMLReader::findAttribute(const char* AttrName) const
+{
+    for (std::size_t i = 0; i < AttrCount; ++i) {
+        if (Attrs[i].name == AttrName)
+            return &Attrs[i].value;
+    }
+    return 0;
 }
 
 long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    const std::string *value = findAttribute(AttrName);
 
-    if (pos != AttrMap.end()) {
-        return atol(pos->second.c_str());
+    if (value) {
+        return atol(value->c_str());
     }
     else {
         // wrong name, use hasAttribute if not sure!
@@ -142,10 +158,10 @@ long Base::XMLReader::getAttributeAsInteger(const char* AttrName) const
 
 unsigned long Base::XMLReader::getAttributeAsUnsigned(const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    const std::string *value = findAttribute(AttrName);
 
-    if (pos != AttrMap.end()) {
-        return strtoul(pos->second.c_str(),0,10);
+    if (value) {
+        return strtoul(value->c_str(),0,10);
     }
     else {
         // wrong name, use hasAttribute if not sure!
@@ -157,10 +173,10 @@ unsigned long Base::XMLReader::getAttributeAsUnsigned(const char* AttrName) cons
 
 double Base::XMLReader::getAttributeAsFloat  (const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    const std::string *value = findAttribute(AttrName);
 
-    if (pos != AttrMap.end()) {
-        return atof(pos->second.c_str());
+    if (value) {
+        return atof(value->c_str());
     }
     else {
         // wrong name, use hasAttribute if not sure!
@@ -172,10 +188,10 @@ double Base::XMLReader::getAttributeAsFloat  (const char* AttrName) const
 
 const char*  Base::XMLReader::getAttribute (const char* AttrName) const
 {
-    AttrMapType::const_iterator pos = AttrMap.find(AttrName);
+    const std::string *value = findAttribute(AttrName);
 
-    if (pos != AttrMap.end()) {
-        return pos->second.c_str();
+    if (value) {
+        return value->c_str();
     }
     else {
         // wrong name, use hasAttribute if not sure!
@@ -187,7 +203,7 @@ const char*  Base::XMLReader::getAttribute (const char* AttrName) const
 
 bool Base::XMLReader::hasAttribute (const char* AttrName) const
 {
-    return AttrMap.find(AttrName) != AttrMap.end();
+    return findAttribute(AttrName) != 0;
 }
 
 bool Base::XMLReader::read(void)
@@ -326,6 +342,29 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream &zipstream) const
         // project file was created without GUI
         return;
     }
+    // Files that are parsed in the thread pool. They are finished in the
+    // order they have been registered and before any sequentially read file.
+    struct PendingFile {
+        Base::Persistence *Object;
+        std::string Name;
+        QFuture<bool> Result;
+    };
+    std::deque<PendingFile> pending;
+    const std::size_t maxPending = std::max(2, QThread::idealThreadCount() * 2);
+    auto finishFile = [&pending]() {
+        PendingFile file = pending.front();
+        pending.pop_front();
+        bool ok = file.Result.result();
+        try {
+            file.Object->finishRestoreDocFile();
+        }
+        catch(...) {
+            ok = false;
+        }
+        if (!ok)
+            Base::Console().Error("Reading failed from embedded file: %s\n", file.Name.c_str());
+    };
+
     std::vector<FileEntry>::const_iterator it = FileList.begin();
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
     while (entry->isValid() && it != FileList.end()) {
@@ -338,10 +377,45 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream &zipstream) const
         // no file name for the current entry in the zip was registered.
         if (jt != FileList.end()) {
             try {
-                Base::Reader reader(zipstream, jt->FileName, FileVersion);
-                jt->Object->RestoreDocFile(reader);
-                if (reader.getLocalReader())
-                    reader.getLocalReader()->readFiles(zipstream);
+                // The object may choose to read the file later on directly
+                // from the archive. Nested readers are never deferred.
+                bool deferred = _deferFiles && jt->Object->RestoreDocFileDeferred(
+                            _File.filePath(), jt->FileName, FileVersion);
+                if (deferred) {
+                    // nothing to do now
+                }
+                else if (_parallel && jt->Object->allowConcurrentRestore()) {
+                    std::shared_ptr<std::string> data = std::make_shared<std::string>(
+                        std::istreambuf_iterator<char>(zipstream), std::istreambuf_iterator<char>());
+                    Base::Persistence *object = jt->Object;
+                    std::string fileName = jt->FileName;
+                    int fileVersion = FileVersion;
+                    PendingFile file;
+                    file.Object = object;
+                    file.Name = entry->toString();
+                    file.Result = QtConcurrent::run([object, fileName, fileVersion, data]() {
+                        try {
+                            std::istringstream str(*data);
+                            Base::Reader reader(str, fileName, fileVersion);
+                            object->RestoreDocFileConcurrent(reader);
+                            return true;
+                        }
+                        catch (...) {
+                            return false;
+                        }
+                    });
+                    pending.push_back(file);
+                    while (pending.size() >= maxPending)
+                        finishFile();
+                }
+                else {
+                    while (!pending.empty())
+                        finishFile();
+                    Base::Reader reader(zipstream, jt->FileName, FileVersion);
+                    jt->Object->RestoreDocFile(reader);
+                    if (reader.getLocalReader())
+                        reader.getLocalReader()->readFiles(zipstream);
+                }
             }
             catch(...) {
                 // For any exception we just continue with the next file.
@@ -366,6 +440,29 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream &zipstream) const
             break;
         }
     }
+
+    while (!pending.empty())
+        finishFile();
+}
+
+void Base::XMLReader::setDeferFiles(bool on)
+{
+    _deferFiles = on;
+}
+
+bool Base::XMLReader::isDeferFiles() const
+{
+    return _deferFiles;
+}
+
+void Base::XMLReader::setParallel(bool on)
+{
+    _parallel = on;
+}
+
+bool Base::XMLReader::isParallel() const
+{
+    return _parallel;
 }
 
 const char *Base::XMLReader::addFile(const char* Name, Base::Persistence *Object)
@@ -414,6 +511,24 @@ bool Base::XMLReader::doNameMapping() const
 // ---------------------------------------------------------------------------
 //  Base::XMLReader: Implementation of the SAX DocumentHandler interface
 // ---------------------------------------------------------------------------
+
+/// Transcode into a reused string. Document files are almost entirely ASCII,
+/// which is copied directly, anything else goes through the Xerces transcoders.
+static void transcode(std::string &out, const XMLCh* const chars, bool utf8)
+{
+    out.clear();
+    for (const XMLCh *c = chars; *c; ++c) {
+        if (*c >= 0x80) {
+            if (utf8)
+                out = StrXUTF8(chars).str;
+            else
+                out = StrX(chars).c_str();
+            return;
+        }
+        out += static_cast<char>(*c);
+    }
+}
+
 void Base::XMLReader::startDocument()
 {
     ReadType = StartDocument;
@@ -427,12 +542,15 @@ void Base::XMLReader::endDocument()
 void Base::XMLReader::startElement(const XMLCh* const /*uri*/, const XMLCh* const localname, const XMLCh* const /*qname*/, const XERCES_CPP_NAMESPACE_QUALIFIER Attributes& attrs)
 {
     Level++; // new scope
-    LocalName = StrX(localname).c_str();
-
-    // saving attributes of the current scope, delete all previously stored ones
-    AttrMap.clear();
-    for (unsigned int i = 0; i < attrs.getLength(); i++) {
-        AttrMap[StrX(attrs.getQName(i)).c_str()] = StrXUTF8(attrs.getValue(i)).c_str();
+    transcode(LocalName, localname, false);
+
+    // saving attributes of the current scope, overwriting the previously stored ones
+    AttrCount = attrs.getLength();
+    if (Attrs.size() < AttrCount)
+        Attrs.resize(AttrCount);
+    for (std::size_t i = 0; i < AttrCount; i++) {
+        transcode(Attrs[i].name, attrs.getQName(i), false);
+        transcode(Attrs[i].value, attrs.getValue(i), true);
     }
 
     ReadType = StartElement;
@@ -441,7 +559,7 @@ void Base::XMLReader::startElement(const XMLCh* const /*uri*/, const XMLCh* cons
 void Base::XMLReader::endElement  (const XMLCh* const /*uri*/, const XMLCh *const localname, const XMLCh *const /*qname*/)
 {
     Level--; // end of scope
-    LocalName = StrX(localname).c_str();
+    transcode(LocalName, localname, false);
 
     if (ReadType == StartElement)
         ReadType = StartEndElement;
@@ -465,7 +583,7 @@ void Base::XMLReader::characters(const   XMLCh* const chars, const unsigned int
 void Base::XMLReader::characters(const   XMLCh* const chars, const XMLSize_t length)
 #endif
 {
-    Characters = StrX(chars).c_str();
+    transcode(Characters, chars, false);
     ReadType = Chars;
     CharacterCount += length;
 }
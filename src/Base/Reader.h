@@ -26,6 +26,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <bitset>
 #include <memory>
 
@@ -188,6 +189,20 @@ public:
     virtual void addName(const char*, const char*);
     virtual const char* getName(const char*) const;
     virtual bool doNameMapping() const;
+    /** Defer reading of the registered files
+     * If enabled readFiles() gives each object the chance to load its file
+     * on demand (see Persistence::RestoreDocFileDeferred()) instead of
+     * reading it immediately.
+     */
+    void setDeferFiles(bool on);
+    bool isDeferFiles() const;
+    /** Parse the registered files in parallel
+     * If enabled readFiles() parses the files of objects which allow it
+     * (see Persistence::allowConcurrentRestore()) in the thread pool while
+     * the archive is inflated on the calling thread.
+     */
+    void setParallel(bool on);
+    bool isParallel() const;
     //@}
 
     /// Schema Version of the document
@@ -265,8 +280,18 @@ protected:
     std::string Characters;
     unsigned int CharacterCount;
 
-    std::map<std::string,std::string> AttrMap;
-    typedef std::map<std::string,std::string> AttrMapType;
+    /** Attributes of the current element
+     * A flat list reused from element to element, so that the strings keep
+     * their buffers. Elements only carry a handful of attributes, a linear
+     * search is faster than any map here.
+     */
+    struct Attribute {
+        std::string name;
+        std::string value;
+    };
+    std::vector<Attribute> Attrs;
+    std::size_t AttrCount;
+    const std::string *findAttribute(const char* AttrName) const;
 
     enum {
         None = 0,
@@ -286,6 +311,8 @@ protected:
     XERCES_CPP_NAMESPACE_QUALIFIER XMLPScanToken token;
     bool _valid;
     bool _verbose;
+    bool _deferFiles;
+    bool _parallel;
 
     std::vector<std::string> FileNames;
 
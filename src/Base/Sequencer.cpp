@@ -136,6 +136,14 @@ bool SequencerBase::next(bool canAbort)
     return this->nProgress < this->nTotalSteps;
 }
 
+bool SequencerBase::advance(size_t steps, bool canAbort)
+{
+    if (steps == 0)
+        return this->nProgress < this->nTotalSteps;
+    this->nProgress += steps - 1;
+    return next(canAbort);
+}
+
 void SequencerBase::nextStep( bool )
 {
 }
@@ -292,6 +300,14 @@ bool SequencerLauncher::next(bool canAbort)
     return SequencerBase::Instance().next(canAbort);
 }
 
+bool SequencerLauncher::advance(size_t steps, bool canAbort)
+{
+    QMutexLocker locker(&SequencerP::mutex);
+    if (SequencerP::_topLauncher != this)
+        return true; // ignore
+    return SequencerBase::Instance().advance(steps, canAbort);
+}
+
 void SequencerLauncher::setProgress(size_t pos)
 {
     QMutexLocker locker(&SequencerP::mutex);
@@ -311,6 +327,37 @@ bool SequencerLauncher::wasCanceled() const
 
 // ---------------------------------------------------------
 
+ParallelSequencerLauncher::ParallelSequencerLauncher(const char* pszStr, size_t steps)
+  : launcher(pszStr, steps), counter(0), canceled(false), reported(0)
+{
+}
+
+ParallelSequencerLauncher::~ParallelSequencerLauncher()
+{
+}
+
+void ParallelSequencerLauncher::update(bool canAbort)
+{
+    size_t count = counter.load(std::memory_order_relaxed);
+    try {
+        if (count > reported) {
+            launcher.advance(count - reported);
+            reported = count;
+        }
+        // give the user the chance to cancel even if there is no progress
+        if (canAbort && !wasCanceled())
+            Sequencer().checkAbort();
+        if (launcher.wasCanceled())
+            cancel();
+    }
+    catch (const Base::AbortException&) {
+        reported = count;
+        cancel();
+    }
+}
+
+// ---------------------------------------------------------
+
 void ProgressIndicatorPy::init_type()
 {
     behaviors().name("ProgressIndicator");
@@ -24,6 +24,7 @@
 #ifndef BASE_SEQUENCER_H
 #define BASE_SEQUENCER_H
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <CXX/Extensions.hxx>
@@ -175,6 +176,11 @@ protected:
      * is thrown.
      */
     bool next(bool canAbort = false);
+    /**
+     * Performs several steps at once. The user gets the same feedback as with
+     * calling next() \a steps times.
+     */
+    bool advance(size_t steps, bool canAbort = false);
     /**
      * Stops the sequencer if all operations are finished. It returns false if
      * there are still pending operations, otherwise it returns true.
@@ -372,10 +378,73 @@ public:
     size_t numberOfSteps() const;
     void setText (const char* pszTxt);
     bool next(bool canAbort = false);
+    bool advance(size_t steps, bool canAbort = false);
     void setProgress(size_t);
     bool wasCanceled() const;
 };
 
+/** The ParallelSequencerLauncher class reports the progress of an operation
+ * running in several worker threads, e.g. with QtConcurrent.
+ *
+ * The workers only call next(), which increments an atomic counter and returns
+ * false after the operation was canceled, so that they can stop cooperatively.
+ * The thread that has created the instance regularly calls update() while it
+ * waits for the workers. This forwards the progress to the sequencer and
+ * checks whether the user wants to cancel.
+ *
+ * \code
+ *  Base::ParallelSequencerLauncher seq("my text", points.size());
+ *  QFuture<void> future = QtConcurrent::map(points, [&seq](Base::Vector3f& pnt) {
+ *    if (seq.next()) {
+ *      // do something
+ *    }
+ *  });
+ *  while (!future.isFinished()) {
+ *    seq.update(true);
+ *    QThread::msleep(50);
+ *  }
+ *  if (seq.wasCanceled()) {
+ *    // the points are only partially processed
+ *  }
+ * \endcode
+ *
+ * \note Unlike SequencerLauncher::next() an AbortException is never thrown
+ * by update() because the workers may still be accessing data of the caller.
+ */
+class BaseExport ParallelSequencerLauncher
+{
+public:
+    ParallelSequencerLauncher(const char* pszStr, size_t steps);
+    ~ParallelSequencerLauncher();
+    /// Counts finished steps, can be called from any thread. Returns false if canceled.
+    bool next(size_t steps = 1)
+    {
+        counter.fetch_add(steps, std::memory_order_relaxed);
+        return !canceled.load(std::memory_order_relaxed);
+    }
+    /// Requests the workers to stop, can be called from any thread
+    void cancel()
+    {
+        canceled.store(true, std::memory_order_relaxed);
+    }
+    bool wasCanceled() const
+    {
+        return canceled.load(std::memory_order_relaxed);
+    }
+    /**
+     * Forwards the progress to the sequencer. It must be called by the
+     * thread that has created this instance. If \a canAbort is true the
+     * user can cancel the operation.
+     */
+    void update(bool canAbort = false);
+
+private:
+    SequencerLauncher launcher;
+    std::atomic<size_t> counter;
+    std::atomic<bool> canceled;
+    size_t reported;
+};
+
 /** Access to the only SequencerBase instance */
 inline SequencerBase& Sequencer ()
 {
@@ -32,6 +32,7 @@
 # include <string>
 # include <cstdio>
 # include <cstring>
+# include <algorithm>
 #ifdef __GNUC__
 # include <stdint.h>
 #endif
@@ -144,6 +145,42 @@ OutputStream& OutputStream::operator << (double d)
     return *this;
 }
 
+OutputStream& OutputStream::write(const float *values, std::size_t count)
+{
+    if (!_swap) {
+        _out.write((const char*)values, count * sizeof(float));
+        return *this;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+        *this << values[i];
+    return *this;
+}
+
+OutputStream& OutputStream::write(const double *values, std::size_t count)
+{
+    if (!_swap) {
+        _out.write((const char*)values, count * sizeof(double));
+        return *this;
+    }
+    for (std::size_t i = 0; i < count; ++i)
+        *this << values[i];
+    return *this;
+}
+
+OutputStream& OutputStream::writeAsFloat(const double *values, std::size_t count)
+{
+    float buffer[1024];
+    while (count) {
+        std::size_t n = std::min<std::size_t>(count, 1024);
+        for (std::size_t i = 0; i < n; ++i)
+            buffer[i] = (float)values[i];
+        write(buffer, n);
+        values += n;
+        count -= n;
+    }
+    return *this;
+}
+
 InputStream::InputStream(std::istream &rin) : _in(rin)
 {
 }
@@ -226,6 +263,40 @@ InputStream& InputStream::operator >> (double& d)
     return *this;
 }
 
+InputStream& InputStream::read(float *values, std::size_t count)
+{
+    _in.read((char*)values, count * sizeof(float));
+    if (_swap) {
+        for (std::size_t i = 0; i < count; ++i)
+            SwapEndian<float>(values[i]);
+    }
+    return *this;
+}
+
+InputStream& InputStream::read(double *values, std::size_t count)
+{
+    _in.read((char*)values, count * sizeof(double));
+    if (_swap) {
+        for (std::size_t i = 0; i < count; ++i)
+            SwapEndian<double>(values[i]);
+    }
+    return *this;
+}
+
+InputStream& InputStream::readAsFloat(double *values, std::size_t count)
+{
+    float buffer[1024];
+    while (count) {
+        std::size_t n = std::min<std::size_t>(count, 1024);
+        read(buffer, n);
+        for (std::size_t i = 0; i < n; ++i)
+            values[i] = buffer[i];
+        values += n;
+        count -= n;
+    }
+    return *this;
+}
+
 // ----------------------------------------------------------------------
 
 ByteArrayOStreambuf::ByteArrayOStreambuf(QByteArray& ba) : _buffer(new QBuffer(&ba))
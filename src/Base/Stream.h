@@ -81,6 +81,12 @@ public:
     OutputStream& operator << (float f);
     OutputStream& operator << (double d);
 
+    /// Write \a count values at once, much faster than one by one for large arrays
+    OutputStream& write(const float *values, std::size_t count);
+    OutputStream& write(const double *values, std::size_t count);
+    /// Write \a count values converted to single precision
+    OutputStream& writeAsFloat(const double *values, std::size_t count);
+
 private:
     OutputStream (const OutputStream&);
     void operator = (const OutputStream&);
@@ -111,6 +117,12 @@ public:
     InputStream& operator >> (float& f);
     InputStream& operator >> (double& d);
 
+    /// Read \a count values at once, much faster than one by one for large arrays
+    InputStream& read(float *values, std::size_t count);
+    InputStream& read(double *values, std::size_t count);
+    /// Read \a count single precision values into \a values
+    InputStream& readAsFloat(double *values, std::size_t count);
+
     operator bool() const
     {
         // test if _Ipfx succeeded
@@ -49,6 +49,8 @@ struct Base::TypeData
   Type parent;
   Type type;
   Type::instantiationMethod instMethod;
+  /// keys of all base types from the root down to this type, see isDerivedFrom()
+  std::vector<unsigned int> ancestors;
 };
 
 map<string,unsigned int> Type::typemap;
@@ -144,6 +146,9 @@ const Type Type::createType(const Type parent, const char *name, instantiationMe
   Type newType;
   newType.index = Type::typedata.size();
   TypeData * typeData = new TypeData(name, newType, parent,method);
+  if (!parent.isBad())
+    typeData->ancestors = Type::typedata[parent.getKey()]->ancestors;
+  typeData->ancestors.push_back(newType.getKey());
   Type::typedata.push_back(typeData);
 
   // add to dictionary for fast lookup
@@ -158,7 +163,9 @@ void Type::init(void)
   assert(Type::typedata.size() == 0);
 
 
-  Type::typedata.push_back(new TypeData("BadType"));
+  TypeData * typeData = new TypeData("BadType");
+  typeData->ancestors.push_back(0);
+  Type::typedata.push_back(typeData);
   Type::typemap["BadType"] = 0;
 
 
@@ -204,15 +211,11 @@ const Type Type::getParent(void) const
 
 bool Type::isDerivedFrom(const Type type) const
 {
-
-  Type temp(*this);
-  do {
-    if (temp == type)
-      return true;
-    temp = temp.getParent();
-  } while (temp != badType());
-
-  return false;
+  // A type at depth n in the hierarchy is a base of this type if it is
+  // the n-th ancestor of this type. This avoids walking up the parents.
+  const std::vector<unsigned int>& ancestors = typedata[index]->ancestors;
+  const std::size_t depth = typedata[type.index]->ancestors.size() - 1;
+  return depth < ancestors.size() && ancestors[depth] == type.index;
 }
 
 int Type::getAllDerivedFrom(const Type type, std::vector<Type> & List)
@@ -36,8 +36,15 @@
 #include "Tools.h"
 
 #include <algorithm>
+#include <cstring>
+#include <deque>
 #include <locale>
 #include <limits>
+#include <memory>
+
+#include <zlib.h>
+#include <QThread>
+#include <QtConcurrentRun>
 
 using namespace Base;
 using namespace std;
@@ -179,6 +186,17 @@ std::string Writer::addFile(const char* Name,const Base::Persistence *Object)
     return temp.FileName;
 }
 
+std::string Writer::addSharedFile(const char* Name, const Base::Persistence *Object, const std::string& key)
+{
+    std::map<std::string, std::string>::iterator it = SharedFiles.find(key);
+    if (it != SharedFiles.end())
+        return it->second;
+
+    std::string fileName = addFile(Name, Object);
+    SharedFiles[key] = fileName;
+    return fileName;
+}
+
 std::string Writer::getUniqueFileName(const char *Name)
 {
     // name in use?
@@ -241,7 +259,7 @@ void Writer::decInd(void)
 // ----------------------------------------------------------------------------
 
 ZipWriter::ZipWriter(const char* FileName)
-  : ZipStream(FileName)
+  : ZipStream(FileName), EntryStream(0), Level(6), Parallel(false)
 {
 #ifdef _MSC_VER
     ZipStream.imbue(std::locale::empty());
@@ -253,7 +271,7 @@ ZipWriter::ZipWriter(const char* FileName)
 }
 
 ZipWriter::ZipWriter(std::ostream& os)
-  : ZipStream(os)
+  : ZipStream(os), EntryStream(0), Level(6), Parallel(false)
 {
 #ifdef _MSC_VER
     ZipStream.imbue(std::locale::empty());
@@ -266,6 +284,11 @@ ZipWriter::ZipWriter(std::ostream& os)
 
 void ZipWriter::writeFiles(void)
 {
+    if (Parallel) {
+        writeFilesParallel();
+        return;
+    }
+
     // use a while loop because it is possible that while
     // processing the files new ones can be added
     size_t index = 0;
@@ -277,6 +300,121 @@ void ZipWriter::writeFiles(void)
     }
 }
 
+namespace {
+struct CompressedEntry {
+    std::string FileName;
+    std::string Data;
+    uLong Crc;
+    uLong Size;
+    zipios::StorageMethod Method;
+    bool Failed;
+};
+
+CompressedEntry deflateEntry(const std::string& fileName, const std::string& data, int level)
+{
+    CompressedEntry entry;
+    entry.FileName = fileName;
+    entry.Size = static_cast<uLong>(data.size());
+    entry.Crc = crc32(crc32(0, Z_NULL, 0), reinterpret_cast<const Bytef*>(data.data()),
+                      static_cast<uInt>(data.size()));
+    entry.Method = zipios::DEFLATED;
+    entry.Failed = true;
+
+    // with no compression requested there is no need to run the data
+    // through zlib at all, just store it
+    if (level == Z_NO_COMPRESSION) {
+        entry.Data = data;
+        entry.Method = zipios::STORED;
+        entry.Failed = false;
+        return entry;
+    }
+
+    // raw deflate stream without zlib header as expected by the zip format
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return entry;
+
+    entry.Data.resize(deflateBound(&zs, static_cast<uLong>(data.size())));
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    zs.avail_in = static_cast<uInt>(data.size());
+    zs.next_out = reinterpret_cast<Bytef*>(&entry.Data[0]);
+    zs.avail_out = static_cast<uInt>(entry.Data.size());
+    int ret = deflate(&zs, Z_FINISH);
+    entry.Data.resize(zs.total_out);
+    deflateEnd(&zs);
+    entry.Failed = (ret != Z_STREAM_END);
+
+    // Already compressed data (e.g. images or embedded archives) doesn't
+    // shrink any more. Store it instead so that reading it back later
+    // doesn't have to inflate it either. The reader handles both methods.
+    if (!entry.Failed && entry.Data.size() >= data.size()) {
+        entry.Data = data;
+        entry.Method = zipios::STORED;
+    }
+    return entry;
+}
+}
+
+void ZipWriter::writeFilesParallel(void)
+{
+    // Limit the number of serialized entries held in memory at the same time
+    const std::size_t maxPending = std::max(2, QThread::idealThreadCount() * 2);
+    std::deque<QFuture<CompressedEntry> > pending;
+
+    auto writeEntry = [this](const CompressedEntry& entry) {
+        if (entry.Failed) {
+            addError(std::string("Failed to compress ") + entry.FileName);
+            return;
+        }
+        ZipStream.putRawEntry(entry.FileName, entry.Data.c_str(),
+                              static_cast<zipios::uint32>(entry.Data.size()),
+                              static_cast<zipios::uint32>(entry.Crc),
+                              static_cast<zipios::uint32>(entry.Size), entry.Method);
+    };
+
+    // use a while loop because it is possible that while
+    // processing the files new ones can be added
+    size_t index = 0;
+    while (index < FileList.size()) {
+        FileEntry entry = FileList.begin()[index];
+
+        // serialize into memory with the same formatting as the zip stream
+        std::ostringstream str;
+        str.imbue(ZipStream.getloc());
+        str.precision(ZipStream.precision());
+        str.flags(ZipStream.flags());
+        EntryStream = &str;
+        try {
+            entry.Object->SaveDocFile(*this);
+        }
+        catch (...) {
+            EntryStream = 0;
+            throw;
+        }
+        EntryStream = 0;
+
+        std::shared_ptr<std::string> data = std::make_shared<std::string>(str.str());
+        std::string fileName = entry.FileName;
+        int level = Level;
+        pending.push_back(QtConcurrent::run([fileName, data, level]() {
+            return deflateEntry(fileName, *data, level);
+        }));
+
+        while (pending.size() >= maxPending) {
+            writeEntry(pending.front().result());
+            pending.pop_front();
+        }
+
+        index++;
+    }
+
+    while (!pending.empty()) {
+        writeEntry(pending.front().result());
+        pending.pop_front();
+    }
+}
+
 ZipWriter::~ZipWriter()
 {
     ZipStream.close();
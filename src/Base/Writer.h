@@ -24,6 +24,7 @@
 #define BASE_WRITER_H
 
 
+#include <map>
 #include <set>
 #include <string>
 #include <sstream>
@@ -77,6 +78,11 @@ public:
     //@{
     /// add a write request of a persistent object
     std::string addFile(const char* Name, const Base::Persistence *Object);
+    /** add a write request of a persistent object whose file content is identified by \a key
+     * If a file with the same key has already been requested its name is returned and
+     * no further file is written, otherwise it behaves like addFile().
+     */
+    std::string addSharedFile(const char* Name, const Base::Persistence *Object, const std::string& key);
     /// process the requested file storing
     virtual void writeFiles(void)=0;
     /// get all registered file names
@@ -126,6 +132,7 @@ protected:
     };
     std::vector<FileEntry> FileList;
     std::vector<std::string> FileNames;
+    std::map<std::string, std::string> SharedFiles;
     std::vector<std::string> Errors;
     std::set<std::string> Modes;
 
@@ -152,14 +159,30 @@ public:
 
     virtual void writeFiles(void);
 
-    virtual std::ostream &Stream(void){return ZipStream;}
+    virtual std::ostream &Stream(void){return EntryStream ? *EntryStream : ZipStream;}
 
     void setComment(const char* str){ZipStream.setComment(str);}
-    void setLevel(int level){ZipStream.setLevel( level );}
+    void setLevel(int level){ZipStream.setLevel( level ); Level = level;}
     void putNextEntry(const char* str){ZipStream.putNextEntry(str);}
+    /** Compress the additional files in worker threads.
+     * The files are still serialized one after another by the calling thread
+     * into memory, because SaveDocFile() implementations are in general not
+     * reentrant. Only the deflation runs in parallel, and the compressed
+     * entries are written in their original order.
+     * Entries that don't get smaller by deflating them, like embedded images,
+     * and all entries if the compression level is 0, are stored uncompressed.
+     */
+    void setParallel(bool on) {Parallel = on;}
+    bool isParallel() const {return Parallel;}
+
+private:
+    void writeFilesParallel(void);
 
 private:
     zipios::ZipOutputStream ZipStream;
+    std::ostringstream *EntryStream;
+    int Level;
+    bool Parallel;
 };
 
 /** The StringWriter class
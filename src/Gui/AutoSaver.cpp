@@ -30,6 +30,8 @@
 # include <QRunnable>
 # include <QTextStream>
 # include <QThreadPool>
+# include <atomic>
+# include <limits>
 # include <boost_bind_bind.hpp>
 # include <sstream>
 #endif
@@ -131,13 +133,21 @@ void AutoSaver::slotDeleteDocument(const App::Document& Doc)
     }
 }
 
-void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
+bool AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
 {
-    Gui::WaitCursor wc;
     App::Document* doc = App::GetApplication().getDocument(name.c_str());
     if (doc && !doc->testStatus(App::Document::PartialDoc)
             && !doc->testStatus(App::Document::TempDoc))
     {
+        // The compressed recovery file is written by a worker thread. If the
+        // previous one isn't finished yet try again at the next interval.
+        if (this->compressed && !saver.touched.empty() && !finishRecoveryJob(saver)) {
+            FC_LOG("auto saver still busy with document " << name);
+            return false;
+        }
+
+        Gui::WaitCursor wc;
+
         // Set the document's current transient directory
         std::string dirName = doc->TransientDir.getValue();
         dirName += "/fc_recovery_files";
@@ -192,28 +202,7 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
             }
             // only create the file if something has changed
             else if (!saver.touched.empty()) {
-                std::string fn = doc->TransientDir.getValue();
-                fn += "/fc_recovery_file.fcstd";
-                Base::FileInfo tmp(fn);
-                Base::ofstream file(tmp, std::ios::out | std::ios::binary);
-                if (file.is_open())
-                {
-                    Base::ZipWriter writer(file);
-                    if (hGrp->GetBool("SaveBinaryBrep", true))
-                        writer.setMode("BinaryBrep");
-
-                    writer.setComment("AutoRecovery file");
-                    writer.setLevel(1); // apparently the fastest compression
-                    writer.putNextEntry("Document.xml");
-
-                    doc->Save(writer);
-
-                    // Special handling for Gui document.
-                    doc->signalSaveDocument(writer);
-
-                    // write additional files
-                    writer.writeFiles();
-                }
+                startRecoveryJob(doc, saver);
             }
         }
 
@@ -221,6 +210,8 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
         Base::Console().Log("Save AutoRecovery file: %s\n", str.c_str());
         hGrp->SetBool("SaveThumbnail",save);
     }
+
+    return true;
 }
 
 void AutoSaver::timerEvent(QTimerEvent * event)
@@ -229,8 +220,8 @@ void AutoSaver::timerEvent(QTimerEvent * event)
     for (std::map<std::string, AutoSaveProperty*>::iterator it = saverMap.begin(); it != saverMap.end(); ++it) {
         if (it->second->timerId == id) {
             try {
-                saveDocument(it->first, *it->second);
-                it->second->touched.clear();
+                if (saveDocument(it->first, *it->second))
+                    it->second->touched.clear();
                 break;
             }
             catch (...) {
@@ -363,6 +354,227 @@ private:
 
 }
 
+namespace Gui {
+
+/*!
+ A snapshot of a document taken by the main thread to write a compressed
+ recovery file in a worker thread. Data files of unchanged properties are
+ reused from the previous recovery file, changed properties are copied and
+ only serialized by the worker thread.
+ */
+class RecoveryJob
+{
+public:
+    struct Entry {
+        std::string address;
+        std::string fileName;
+        std::unique_ptr<App::Property> prop;
+        std::shared_ptr<std::string> data;
+    };
+
+    RecoveryJob() : level(1), done(false), failed(false) {}
+
+    std::string name;
+    std::string dirName;
+    std::string document;
+    std::vector<Entry> entries;
+    std::set<std::string> modes;
+    int level;
+    std::atomic<bool> done;
+    bool failed;
+};
+
+/*!
+ The writer used by the main thread to take the snapshot of a document. It
+ uses the same stream settings as Base::ZipWriter.
+ */
+class RecoverySnapshotWriter : public Base::Writer
+{
+public:
+    RecoverySnapshotWriter()
+    {
+        StrStream.imbue(std::locale::classic());
+        StrStream.precision(std::numeric_limits<double>::digits10 + 1);
+        StrStream.setf(std::ios::fixed,std::ios::floatfield);
+    }
+
+    virtual std::ostream &Stream(void) {return StrStream;}
+    virtual void writeFiles(void) {}
+
+    std::shared_ptr<std::string> takeData()
+    {
+        auto data = std::make_shared<std::string>(StrStream.str());
+        StrStream.str(std::string());
+        return data;
+    }
+
+    void takeSnapshot(AutoSaveProperty& saver, RecoveryJob& job)
+    {
+        job.document = StrStream.str();
+        StrStream.str(std::string());
+
+        // use a while loop because it is possible that while
+        // processing the files new ones can be added
+        size_t index = 0;
+        while (index < FileList.size()) {
+            FileEntry entry = FileList.begin()[index];
+            RecoveryJob::Entry item;
+            item.fileName = entry.FileName;
+
+            if (entry.Object->isDerivedFrom(App::Property::getClassTypeId())) {
+                const App::Property* prop = static_cast<const App::Property*>(entry.Object);
+
+                // Property files of a view provider are rather small and
+                // therefore not worth to be cached.
+                const App::PropertyContainer* parent = prop->getContainer();
+                if (!parent || !parent->isDerivedFrom(Gui::ViewProvider::getClassTypeId())) {
+                    std::stringstream str;
+                    str << static_cast<const void *>(prop) << std::ends;
+                    item.address = str.str();
+
+                    auto it = saver.dataCache.find(item.address);
+                    if (it != saver.dataCache.end() && it->second.first == item.fileName
+                            && saver.touched.find(item.address) == saver.touched.end())
+                        item.data = it->second.second;
+                }
+
+                if (!item.data)
+                    item.prop.reset(prop->Copy());
+            }
+            else {
+                entry.Object->SaveDocFile(*this);
+                item.data = takeData();
+            }
+
+            job.entries.push_back(std::move(item));
+            index++;
+        }
+    }
+
+private:
+    std::ostringstream StrStream;
+};
+
+class RecoveryZipRunnable : public QRunnable
+{
+public:
+    RecoveryZipRunnable(const std::shared_ptr<RecoveryJob>& job)
+        : job(job)
+    {
+    }
+    virtual void run()
+    {
+        QString dirName = QString::fromUtf8(job->dirName.c_str());
+        QString fileName = QString::fromLatin1("fc_recovery_file.fcstd");
+        QString tmpName = QString::fromLatin1("%1.tmp%2").arg(fileName).arg(rand());
+
+        try {
+            for (auto& entry : job->entries) {
+                if (entry.prop) {
+                    RecoverySnapshotWriter writer;
+                    writer.setModes(job->modes);
+                    entry.prop->SaveDocFile(writer);
+                    entry.data = writer.takeData();
+                    entry.prop.reset();
+                }
+            }
+
+            Base::FileInfo tmp(job->dirName + "/" + tmpName.toUtf8().constData());
+            Base::ofstream file(tmp, std::ios::out | std::ios::binary);
+            if (!file.is_open()) {
+                job->failed = true;
+            }
+            else {
+                // open extra scope to close ZipWriter properly
+                {
+                    Base::ZipWriter writer(file);
+                    writer.setComment("AutoRecovery file");
+                    writer.setLevel(job->level);
+                    writer.putNextEntry("Document.xml");
+                    writer.Stream().write(job->document.c_str(), job->document.size());
+                    for (const auto& entry : job->entries) {
+                        writer.putNextEntry(entry.fileName.c_str());
+                        writer.Stream().write(entry.data->c_str(), entry.data->size());
+                    }
+                }
+                file.close();
+                job->failed = file.fail();
+            }
+        }
+        catch (...) {
+            job->failed = true;
+        }
+
+        // let the main thread replace the previous recovery file, see RecoveryRunnable
+        if (!job->failed) {
+            QMetaObject::invokeMethod(AutoSaver::instance(), "renameFile",
+                    Qt::QueuedConnection, Q_ARG(QString,dirName)
+                    ,Q_ARG(QString,fileName),Q_ARG(QString,tmpName));
+        }
+
+        job->done = true;
+    }
+
+private:
+    std::shared_ptr<RecoveryJob> job;
+};
+
+}
+
+bool AutoSaver::finishRecoveryJob(AutoSaveProperty& saver)
+{
+    if (!saver.job)
+        return true;
+    if (!saver.job->done)
+        return false;
+
+    std::shared_ptr<RecoveryJob> job = saver.job;
+    saver.job.reset();
+
+    // keep the serialized data files of this recovery file for the next one
+    saver.dataCache.clear();
+    if (job->failed) {
+        Base::Console().Error("Failed to auto-save document '%s'\n", job->name.c_str());
+        return true;
+    }
+
+    for (const auto& entry : job->entries) {
+        if (!entry.address.empty() && entry.data)
+            saver.dataCache[entry.address] = std::make_pair(entry.fileName, entry.data);
+    }
+    return true;
+}
+
+bool AutoSaver::startRecoveryJob(App::Document* doc, AutoSaveProperty& saver)
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Document");
+
+    std::shared_ptr<RecoveryJob> job = std::make_shared<RecoveryJob>();
+    job->name = doc->getName();
+    job->dirName = doc->TransientDir.getValue();
+    // 1 is the fastest deflate level, 0 stores the entries uncompressed
+    job->level = Base::clamp<int>(hGrp->GetInt("AutoSaveCompressionLevel", 1), 0, 9);
+
+    RecoverySnapshotWriter writer;
+
+    // The data files are serialized by a worker thread. So, always force
+    // binary format because ASCII is not reentrant. See PropertyPartShape::SaveDocFile
+    writer.setMode("BinaryBrep");
+
+    doc->Save(writer);
+
+    // Special handling for Gui document.
+    doc->signalSaveDocument(writer);
+
+    writer.takeSnapshot(saver, *job);
+    job->modes = writer.getModes();
+
+    saver.job = job;
+    QThreadPool::globalInstance()->start(new RecoveryZipRunnable(job));
+    return true;
+}
+
 void RecoveryWriter::writeFiles(void)
 {
 #if 0
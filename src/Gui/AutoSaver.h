@@ -27,6 +27,7 @@
 #include <QObject>
 #include <Base/Writer.h>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <boost_signals2.hpp>
@@ -39,6 +40,7 @@ class Property;
 
 namespace Gui {
 class ViewProvider;
+class RecoveryJob;
 
 class AutoSaveProperty
 {
@@ -49,6 +51,10 @@ public:
     std::set<std::string> touched;
     std::string dirName;
     std::map<std::string, std::string> fileMap;
+    /// serialized data files of the last compressed recovery file, keyed by property address
+    std::map<std::string, std::pair<std::string, std::shared_ptr<std::string> > > dataCache;
+    /// the compressed recovery file currently written in the background
+    std::shared_ptr<RecoveryJob> job;
 
 private:
     void slotNewObject(const App::DocumentObject&);
@@ -86,7 +92,9 @@ protected:
     void slotCreateDocument(const App::Document& Doc);
     void slotDeleteDocument(const App::Document& Doc);
     void timerEvent(QTimerEvent * event);
-    void saveDocument(const std::string&, AutoSaveProperty&);
+    bool saveDocument(const std::string&, AutoSaveProperty&);
+    bool startRecoveryJob(App::Document*, AutoSaveProperty&);
+    bool finishRecoveryJob(AutoSaveProperty&);
 
 public Q_SLOTS:
     void renameFile(QString dirName, QString file, QString tmpFile);
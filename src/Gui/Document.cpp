@@ -50,6 +50,7 @@
 
 #include <App/Document.h>
 #include <App/DocumentObject.h>
+#include <App/PropertyPythonObject.h>
 #include <App/DocumentObjectGroup.h>
 #include <App/Transactions.h>
 #include <App/AutoTransaction.h>
@@ -112,6 +113,16 @@ struct DocumentP
     std::map<std::string,ViewProvider*> _ViewProviderMapAnnotation;
     std::list<ViewProviderDocumentObject*> _redoViewProviders;
 
+    // view provider updates deferred until the end of a recompute, in the
+    // order of the first change of each property
+    struct PendingUpdate {
+        const App::DocumentObject *obj;
+        ViewProvider *vp;
+        const App::Property *prop;
+    };
+    std::vector<PendingUpdate> _pendingUpdates;
+    std::set<std::pair<ViewProvider*, const App::Property*> > _pendingUpdateSet;
+
     typedef boost::signals2::connection Connection;
     Connection connectNewObject;
     Connection connectDelObject;
@@ -127,6 +138,7 @@ struct DocumentP
     Connection connectExportObjects;
     Connection connectImportObjects;
     Connection connectFinishImportObjects;
+    Connection connectCloneObjects;
     Connection connectUndoDocument;
     Connection connectRedoDocument;
     Connection connectRecomputed;
@@ -199,6 +211,8 @@ Document::Document(App::Document* pcDocument,Application * app)
         (boost::bind(&Gui::Document::importObjects, this, bp::_1, bp::_2, bp::_3));
     d->connectFinishImportObjects = pcDocument->signalFinishImportObjects.connect
         (boost::bind(&Gui::Document::slotFinishImportObjects, this, bp::_1));
+    d->connectCloneObjects = pcDocument->signalCloneObjects.connect
+        (boost::bind(&Gui::Document::slotCloneObjects, this, bp::_1, bp::_2));
 
     d->connectUndoDocument = pcDocument->signalUndo.connect
         (boost::bind(&Gui::Document::slotUndoDocument, this, bp::_1));
@@ -225,6 +239,9 @@ Document::Document(App::Document* pcDocument,Application * app)
         d->_pcDocument->setUndoMode(1);
         // set the maximum stack size
         d->_pcDocument->setMaxUndoStackSize(hGrp->GetInt("MaxUndoSize",20));
+        // memory budget of the undo stack in MB
+        unsigned long limit = std::min<unsigned long>(hGrp->GetUnsigned("UndoMemoryLimit",0), 4095);
+        d->_pcDocument->setUndoLimit(static_cast<unsigned int>(limit * 1024 * 1024));
     }
 
     d->_changeViewTouchDocument = hGrp->GetBool("ChangeViewProviderTouchDocument", true);
@@ -248,6 +265,7 @@ Document::~Document()
     d->connectExportObjects.disconnect();
     d->connectImportObjects.disconnect();
     d->connectFinishImportObjects.disconnect();
+    d->connectCloneObjects.disconnect();
     d->connectUndoDocument.disconnect();
     d->connectRedoDocument.disconnect();
     d->connectRecomputed.disconnect();
@@ -757,6 +775,18 @@ void Document::slotDeletedObject(const App::DocumentObject& Obj)
 
     handleChildren3D(viewProvider,true);
 
+    if (!d->_pendingUpdates.empty()) {
+        auto &updates = d->_pendingUpdates;
+        for (auto it = updates.begin(); it != updates.end();) {
+            if (it->obj == &Obj) {
+                d->_pendingUpdateSet.erase(std::make_pair(it->vp, it->prop));
+                it = updates.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
 #if 0 // With this we can show child objects again if this method was called by undo
     viewProvider->onDelete(std::vector<std::string>());
 #endif
@@ -797,42 +827,17 @@ void Document::slotChangedObject(const App::DocumentObject& Obj, const App::Prop
     //Base::Console().Log("Document::slotChangedObject() called\n");
     ViewProvider* viewProvider = getViewProvider(&Obj);
     if (viewProvider) {
-        try {
-            viewProvider->update(&Prop);
-            if(d->_editingViewer
-                    && d->_editingObject
-                    && d->_editViewProviderParent
-                    && (Prop.isDerivedFrom(App::PropertyPlacement::getClassTypeId())
-                        // Issue ID 0004230 : getName() can return null in which case strstr() crashes
-                        || (Prop.getName() && strstr(Prop.getName(),"Scale")))
-                    && d->_editObjs.count(&Obj))
-            {
-                Base::Matrix4D mat;
-                auto sobj = d->_editViewProviderParent->getObject()->getSubObject(
-                                                        d->_editSubname.c_str(),0,&mat);
-                if(sobj == d->_editingObject && d->_editingTransform!=mat) {
-                    d->_editingTransform = mat;
-                    d->_editingViewer->setEditingTransform(d->_editingTransform);
-                }
-            }
-        }
-        catch(const Base::MemoryException& e) {
-            FC_ERR("Memory exception in " << Obj.getFullName() << " thrown: " << e.what());
+        if (d->_pcDocument->testStatus(App::Document::Recomputing)) {
+            // Defer the update to the end of the recompute, so that a view
+            // provider is updated only once for each changed property, no
+            // matter how often it has changed in between.
+            if (d->_pendingUpdateSet.insert(std::make_pair(viewProvider, &Prop)).second)
+                d->_pendingUpdates.push_back({&Obj, viewProvider, &Prop});
         }
-        catch(Base::Exception& e){
-            e.ReportException();
-        }
-        catch(const std::exception& e){
-            FC_ERR("C++ exception in " << Obj.getFullName() << " thrown " << e.what());
-        }
-        catch (...) {
-            FC_ERR("Cannot update representation for " << Obj.getFullName());
+        else {
+            flushPendingUpdates();
+            updateViewProvider(Obj, viewProvider, Prop);
         }
-
-        handleChildren3D(viewProvider);
-
-        if (viewProvider->isDerivedFrom(ViewProviderDocumentObject::getClassTypeId()))
-            signalChangedObject(static_cast<ViewProviderDocumentObject&>(*viewProvider), Prop);
     }
 
     // a property of an object has changed
@@ -844,6 +849,63 @@ void Document::slotChangedObject(const App::DocumentObject& Obj, const App::Prop
     getMainWindow()->updateActions(true);
 }
 
+void Document::flushPendingUpdates()
+{
+    if (d->_pendingUpdates.empty())
+        return;
+
+    std::vector<DocumentP::PendingUpdate> updates;
+    updates.swap(d->_pendingUpdates);
+    d->_pendingUpdateSet.clear();
+    for (auto &update : updates) {
+        // skip properties that have been removed meanwhile
+        if (update.obj->getNameInDocument()
+                && getViewProvider(update.obj) == update.vp
+                && update.obj->getPropertyName(update.prop))
+            updateViewProvider(*update.obj, update.vp, *update.prop);
+    }
+}
+
+void Document::updateViewProvider(const App::DocumentObject& Obj, ViewProvider* viewProvider, const App::Property& Prop)
+{
+    try {
+        viewProvider->update(&Prop);
+        if(d->_editingViewer
+                && d->_editingObject
+                && d->_editViewProviderParent
+                && (Prop.isDerivedFrom(App::PropertyPlacement::getClassTypeId())
+                    // Issue ID 0004230 : getName() can return null in which case strstr() crashes
+                    || (Prop.getName() && strstr(Prop.getName(),"Scale")))
+                && d->_editObjs.count(&Obj))
+        {
+            Base::Matrix4D mat;
+            auto sobj = d->_editViewProviderParent->getObject()->getSubObject(
+                                                    d->_editSubname.c_str(),0,&mat);
+            if(sobj == d->_editingObject && d->_editingTransform!=mat) {
+                d->_editingTransform = mat;
+                d->_editingViewer->setEditingTransform(d->_editingTransform);
+            }
+        }
+    }
+    catch(const Base::MemoryException& e) {
+        FC_ERR("Memory exception in " << Obj.getFullName() << " thrown: " << e.what());
+    }
+    catch(Base::Exception& e){
+        e.ReportException();
+    }
+    catch(const std::exception& e){
+        FC_ERR("C++ exception in " << Obj.getFullName() << " thrown " << e.what());
+    }
+    catch (...) {
+        FC_ERR("Cannot update representation for " << Obj.getFullName());
+    }
+
+    handleChildren3D(viewProvider);
+
+    if (viewProvider->isDerivedFrom(ViewProviderDocumentObject::getClassTypeId()))
+        signalChangedObject(static_cast<ViewProviderDocumentObject&>(*viewProvider), Prop);
+}
+
 void Document::slotRelabelObject(const App::DocumentObject& Obj)
 {
     ViewProvider* viewProvider = getViewProvider(&Obj);
@@ -911,6 +973,7 @@ void Document::slotRecomputed(const App::Document& doc)
 {
     if (d->_pcDocument != &doc)
         return;
+    flushPendingUpdates();
     getMainWindow()->updateActions();
     TreeWidget::updateStatus();
 }
@@ -1643,6 +1706,42 @@ void Document::importObjects(const std::vector<App::DocumentObject*>& obj, Base:
         reader.initLocalReader(localreader);
 }
 
+void Document::slotCloneObjects(const std::vector<App::DocumentObject*> &sources,
+                                const std::vector<App::DocumentObject*> &objs)
+{
+    // Copy the properties of the view providers as importObjects() would
+    // restore them. finishRestoring() is triggered by signalFinishRestoreObject.
+    for (std::size_t i=0; i<sources.size() && i<objs.size(); ++i) {
+        Gui::ViewProvider* src = Application::Instance->getViewProvider(sources[i]);
+        Gui::ViewProvider* vp = getViewProvider(objs[i]);
+        if (!src || !vp)
+            continue;
+
+        vp->setStatus(Gui::isRestoring,true);
+        auto vpd = Base::freecad_dynamic_cast<ViewProviderDocumentObject>(vp);
+        if (vpd)
+            vpd->startRestoring();
+
+        std::map<std::string,App::Property*> props;
+        src->getPropertyMap(props);
+        for (auto &v : props) {
+            App::Property* prop = v.second;
+            if (prop->testStatus(App::Property::PropNoPersist)
+                    || prop->isDerivedFrom(App::PropertyLinkBase::getClassTypeId())
+                    || prop->isDerivedFrom(App::PropertyPythonObject::getClassTypeId()))
+                continue;
+            App::Property* target = vp->getPropertyByName(v.first.c_str());
+            if (!target && prop->testStatus(App::Property::PropDynamic)) {
+                auto data = src->getDynamicPropertyData(prop);
+                target = vp->addDynamicProperty(prop->getTypeId().getName(), data.getName(),
+                        data.group.c_str(), data.doc.c_str(), data.attr, data.readonly, data.hidden);
+            }
+            if (target && target->getTypeId() == prop->getTypeId())
+                target->Paste(*prop);
+        }
+    }
+}
+
 void Document::slotFinishImportObjects(const std::vector<App::DocumentObject*> &objs) {
     (void)objs;
     // finishRestoring() is now triggered by signalFinishRestoreObject
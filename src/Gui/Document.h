@@ -86,6 +86,8 @@ protected:
     void slotRedoDocument(const App::Document&);
     void slotShowHidden(const App::Document&);
     void slotFinishImportObjects(const std::vector<App::DocumentObject*> &);
+    void slotCloneObjects(const std::vector<App::DocumentObject*> &,
+                          const std::vector<App::DocumentObject*> &);
     void slotFinishRestoreObject(const App::DocumentObject &obj);
     void slotRecomputed(const App::Document&);
     void slotSkipRecompute(const App::Document &doc, const std::vector<App::DocumentObject*> &objs);
@@ -304,6 +306,11 @@ private:
     //handles the scene graph nodes to correctly group child and parents
     void handleChildren3D(ViewProvider* viewProvider, bool deleting=false);
 
+    /// Updates the view provider of the object for the changed property
+    void updateViewProvider(const App::DocumentObject&, ViewProvider*, const App::Property&);
+    /// Runs the view provider updates deferred during a recompute
+    void flushPendingUpdates();
+
     /// Check other documents for the same transaction ID
     bool checkTransactionID(bool undo, int iSteps);
 
@@ -105,7 +105,7 @@ class NoneWorkbench ( Workbench ):
         return "Gui::NoneWorkbench"
 
 def InitApplications():
-    import sys,os,traceback
+    import sys,os,traceback,time
     try:
         # Python3
         import io as cStringIO
@@ -117,10 +117,12 @@ def InitApplications():
     ModDirs = FreeCAD.__ModDirs__
     #print ModDirs
     Log('Init:   Searching modules...\n')
+    InitTimes = []
     for Dir in ModDirs:
         if ((Dir != '') & (Dir != 'CVS') & (Dir != '__init__.py')):
             InstallFile = os.path.join(Dir,"InitGui.py")
             if (os.path.exists(InstallFile)):
+                StartTime = time.time()
                 try:
                     # XXX: This looks scary securitywise...
                     if sys.version_info.major < 3:
@@ -137,7 +139,8 @@ def InitApplications():
                     Err('During initialization the error "' + str(inst) + '" occurred in ' + InstallFile + '\n')
                     Err('Please look into the log file for further information\n')
                 else:
-                    Log('Init:      Initializing ' + Dir + '... done\n')
+                    Log('Init:      Initializing ' + Dir + '... done (%.3f s)\n' % (time.time() - StartTime))
+                InitTimes.append((Dir, time.time() - StartTime))
             else:
                 Log('Init:      Initializing ' + Dir + '(InitGui.py not found)... ignore\n')
 
@@ -150,6 +153,7 @@ def InitApplications():
         for _, freecad_module_name, freecad_module_ispkg in pkgutil.iter_modules(freecad.__path__, "freecad."):
             if freecad_module_ispkg:
                 Log('Init: Initializing ' + freecad_module_name + '\n')
+                StartTime = time.time()
                 try:
                     freecad_module = importlib.import_module(freecad_module_name)
                     if any (module_name == 'init_gui' for _, module_name, ispkg in pkgutil.iter_modules(freecad_module.__path__)):
@@ -166,9 +170,12 @@ def InitApplications():
                     Log('-'*80+'\n')
                     Log(traceback.format_exc())
                     Log('-'*80+'\n')
+                InitTimes.append((freecad_module_name, time.time() - StartTime))
     except ImportError as inst:
         Err('During initialization the error "' + str(inst) + '" occurred\n')
 
+    reportInitTimes('gui', InitTimes)
+
 Log ('Init: Running FreeCADGuiInit.py start script...\n')
 
 
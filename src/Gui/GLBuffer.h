@@ -43,6 +43,7 @@ public:
 
     void destroy();
     void allocate(const void *data, int count);
+    void update(int offset, const void *data, int count);
     bool bind();
     void release();
     GLuint getBufferId() const;
@@ -72,6 +73,7 @@ public:
 
     void destroy();
     void allocate(const void *data, int count);
+    void update(int offset, const void *data, int count);
     bool bind();
     void release();
     GLuint getBufferId() const;
@@ -86,6 +86,10 @@ PropertyView::PropertyView(QWidget *parent)
     timer->setSingleShot(true);
     connect(timer, SIGNAL(timeout()), this, SLOT(onTimer()));
 
+    propTimer = new QTimer(this);
+    propTimer->setSingleShot(true);
+    connect(propTimer, SIGNAL(timeout()), this, SLOT(onPropTimer()));
+
     tabs = new QTabWidget (this);
     tabs->setObjectName(QString::fromUtf8("propertyTab"));
     tabs->setTabPosition(QTabWidget::South);
@@ -178,6 +182,8 @@ void PropertyView::setShowAll(bool enable) {
 
 void PropertyView::hideEvent(QHideEvent *ev) {
     this->timer->stop();
+    this->propTimer->stop();
+    pendingProps.clear();
     this->detachSelection();
     // clear the properties before hiding.
     propertyEditorData->buildUp();
@@ -210,14 +216,60 @@ void PropertyView::slotRollback() {
     clearPropertyItemSelection();
 }
 
-void PropertyView::slotChangePropertyData(const App::DocumentObject&, const App::Property& prop)
+static bool isRecomputing() {
+    for(auto doc : App::GetApplication().getDocuments()) {
+        if(doc->testStatus(App::Document::Recomputing))
+            return true;
+    }
+    return false;
+}
+
+void PropertyView::deferUpdate(const App::Property& prop)
 {
-    propertyEditorData->updateProperty(prop);
+    pendingProps.insert(&prop);
+    if(!propTimer->isActive())
+        propTimer->start(100);
+}
+
+void PropertyView::onPropTimer()
+{
+    // Keep collecting the changes until all recomputes are finished, so that
+    // a property touched by many objects is only updated once.
+    if(isRecomputing()) {
+        propTimer->start(100);
+        return;
+    }
+
+    std::set<const App::Property*> props;
+    props.swap(pendingProps);
+    for(auto prop : props) {
+        auto parent = prop->getContainer();
+        if(propertyEditorData->propOwners.count(parent))
+            propertyEditorData->updateProperty(*prop);
+        else if(propertyEditorView->propOwners.count(parent))
+            propertyEditorView->updateProperty(*prop);
+    }
+}
+
+void PropertyView::slotChangePropertyData(const App::DocumentObject& obj, const App::Property& prop)
+{
+    if(!propertyEditorData->propOwners.count(prop.getContainer()))
+        return;
+    auto doc = obj.getDocument();
+    if(doc && doc->testStatus(App::Document::Recomputing))
+        deferUpdate(prop);
+    else
+        propertyEditorData->updateProperty(prop);
 }
 
 void PropertyView::slotChangePropertyView(const Gui::ViewProvider&, const App::Property& prop)
 {
-    propertyEditorView->updateProperty(prop);
+    if(!propertyEditorView->propOwners.count(prop.getContainer()))
+        return;
+    if(isRecomputing())
+        deferUpdate(prop);
+    else
+        propertyEditorView->updateProperty(prop);
 }
 
 bool PropertyView::isPropertyHidden(const App::Property *prop) {
@@ -239,6 +291,7 @@ void PropertyView::slotAppendDynamicProperty(const App::Property& prop)
 
 void PropertyView::slotRemoveDynamicProperty(const App::Property& prop)
 {
+    pendingProps.erase(&prop);
     App::PropertyContainer* parent = prop.getContainer();
     if(propertyEditorData->propOwners.count(parent))
         propertyEditorData->removeProperty(prop);
@@ -276,6 +329,7 @@ void PropertyView::slotChangePropertyEditor(const App::Document &, const App::Pr
 
 void PropertyView::slotDeleteDocument(const Gui::Document &doc) {
     if(propertyEditorData->propOwners.count(doc.getDocument())) {
+        pendingProps.clear();
         propertyEditorView->buildUp();
         propertyEditorData->buildUp();
         clearPropertyItemSelection();
@@ -285,6 +339,7 @@ void PropertyView::slotDeleteDocument(const Gui::Document &doc) {
 
 void PropertyView::slotDeletedViewObject(const Gui::ViewProvider &vp) {
     if(propertyEditorView->propOwners.count(&vp)) {
+        pendingProps.clear();
         propertyEditorView->buildUp();
         propertyEditorData->buildUp();
         clearPropertyItemSelection();
@@ -294,6 +349,7 @@ void PropertyView::slotDeletedViewObject(const Gui::ViewProvider &vp) {
 
 void PropertyView::slotDeletedObject(const App::DocumentObject &obj) {
     if(propertyEditorData->propOwners.count(&obj)) {
+        pendingProps.clear();
         propertyEditorView->buildUp();
         propertyEditorData->buildUp();
         clearPropertyItemSelection();
@@ -323,13 +379,35 @@ struct PropertyView::PropInfo
     std::vector<App::Property*> propList;
 };
 
+/* Keeps the properties that are common to all the objects added so far.
+ * Only the properties of the first object are inserted, any later object
+ * can only extend the entries it shares with all the previous ones. So the
+ * lookup stays cheap even for thousands of selected objects.
+ */
 struct PropertyView::PropFind {
-    const PropInfo& item;
-    PropFind(const PropInfo& item) : item(item) {}
-    bool operator () (const PropInfo& elem) const
-    {
-        return (elem.propId == item.propId) &&
-               (elem.propName == item.propName);
+    std::vector<PropInfo> items;
+    std::unordered_map<std::string, std::size_t> index;
+    std::size_t count = 0;
+
+    void add(const char *name, App::Property *prop) {
+        int id = prop->getTypeId().getKey();
+        if(count == 0) {
+            if(index.emplace(name, items.size()).second) {
+                items.emplace_back();
+                items.back().propName = name;
+                items.back().propId = id;
+                items.back().propList.push_back(prop);
+            }
+            return;
+        }
+        auto it = index.find(name);
+        if(it == index.end())
+            return;
+        auto &info = items[it->second];
+        // skip the properties of the same name but of another type, and
+        // the ones already missing from a previous object
+        if(info.propId == id && info.propList.size() == count)
+            info.propList.push_back(prop);
     }
 };
 
@@ -347,6 +425,15 @@ void PropertyView::onSelectionChanged(const SelectionChanges& msg)
 
 void PropertyView::onTimer() {
 
+    // Do not rebuild the editors for every object being recomputed, but
+    // once the recompute is done.
+    if(isRecomputing()) {
+        timer->start(100);
+        return;
+    }
+
+    pendingProps.clear();
+    propTimer->stop();
     propertyEditorData->buildUp();
     propertyEditorView->buildUp();
     clearPropertyItemSelection();
@@ -376,8 +463,8 @@ void PropertyView::onTimer() {
     std::set<App::DocumentObject *> objSet;
 
     // group the properties by <name,id>
-    std::vector<PropInfo> propDataMap;
-    std::vector<PropInfo> propViewMap;
+    PropFind propDataMap;
+    PropFind propViewMap;
     bool checkLink = true;
     ViewProviderDocumentObject *vpLast = 0;
     auto sels = Gui::Selection().getSelectionEx("*");
@@ -412,52 +499,24 @@ void PropertyView::onTimer() {
         vp->getPropertyMap(viewList);
 
         // store the properties with <name,id> as key in a map
-        {
-            for (auto prop : dataList) {
-                if (isPropertyHidden(prop))
-                    continue;
-
-                PropInfo nameType;
-                nameType.propName = prop->getName();
-                nameType.propId = prop->getTypeId().getKey();
-
-                std::vector<PropInfo>::iterator pi = std::find_if(propDataMap.begin(), propDataMap.end(), PropFind(nameType));
-                if (pi != propDataMap.end()) {
-                    pi->propList.push_back(prop);
-                }
-                else {
-                    nameType.propList.push_back(prop);
-                    propDataMap.push_back(nameType);
-                }
-            }
+        for (auto prop : dataList) {
+            if (!isPropertyHidden(prop))
+                propDataMap.add(prop->getName(), prop);
         }
-        // the same for the view properties
-        {
-            std::map<std::string, App::Property*>::iterator pt;
-            for (pt = viewList.begin(); pt != viewList.end(); ++pt) {
-                if (isPropertyHidden(pt->second))
-                    continue;
+        ++propDataMap.count;
 
-                PropInfo nameType;
-                nameType.propName = pt->first;
-                nameType.propId = pt->second->getTypeId().getKey();
-
-                std::vector<PropInfo>::iterator pi = std::find_if(propViewMap.begin(), propViewMap.end(), PropFind(nameType));
-                if (pi != propViewMap.end()) {
-                    pi->propList.push_back(pt->second);
-                }
-                else {
-                    nameType.propList.push_back(pt->second);
-                    propViewMap.push_back(nameType);
-                }
-            }
+        // the same for the view properties
+        for (auto &v : viewList) {
+            if (!isPropertyHidden(v.second))
+                propViewMap.add(v.first.c_str(), v.second);
         }
+        ++propViewMap.count;
     }
 
     // the property must be part of each selected object, i.e. the number
     // of selected objects is equal to the number of properties with same
     // name and id
-    std::vector<PropInfo>::const_iterator it;
+    std::vector<PropInfo>::iterator it;
     PropertyModel::PropertyList dataProps;
     std::map<std::string, std::vector<App::Property*> > dataPropsMap;
     PropertyModel::PropertyList viewProps;
@@ -510,7 +569,7 @@ void PropertyView::onTimer() {
 
     dataPropsMap.clear();
 
-    for (it = propDataMap.begin(); it != propDataMap.end(); ++it) {
+    for (it = propDataMap.items.begin(); it != propDataMap.items.end(); ++it) {
         if (it->propList.size() == sels.size()) {
             if(it->propList[0]->testStatus(App::Property::PropDynamic))
                 dataPropsMap.emplace(it->propName, std::move(it->propList));
@@ -524,7 +583,7 @@ void PropertyView::onTimer() {
 
     propertyEditorData->buildUp(std::move(dataProps),true);
 
-    for (it = propViewMap.begin(); it != propViewMap.end(); ++it) {
+    for (it = propViewMap.items.begin(); it != propViewMap.items.end(); ++it) {
         if (it->propList.size() == sels.size())
             viewProps.emplace_back(it->propName, std::move(it->propList));
     }
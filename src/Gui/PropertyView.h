@@ -29,6 +29,7 @@
 #include "DockWindow.h"
 #include "Selection.h"
 #include <boost_signals2.hpp>
+#include <set>
 
 class QPixmap;
 class QTabWidget;
@@ -73,6 +74,7 @@ public Q_SLOTS:
     /// Stores a preference for the last tab selected
     void tabChanged(int index);
     void onTimer();
+    void onPropTimer();
 
 protected:
     void changeEvent(QEvent *e) override;
@@ -93,6 +95,7 @@ private:
     void slotDeletedObject(const App::DocumentObject&);
 
     void checkEnable(const char *doc = 0);
+    void deferUpdate(const App::Property&);
 
 private:
     struct PropInfo;
@@ -111,6 +114,8 @@ private:
     Connection connectDelViewObject;
     QTabWidget* tabs;
     QTimer* timer;
+    QTimer* propTimer;
+    std::set<const App::Property*> pendingProps;
 };
 
 namespace DockWnd {
@@ -497,7 +497,26 @@ std::vector<SelectionSingleton::SelObj> SelectionSingleton::getPickedList(const
 
 std::vector<SelectionObject> SelectionSingleton::getSelectionEx(
         const char* pDocName, Base::Type typeId, int resolve, bool single) const {
-    return getObjectList(pDocName,typeId,_SelList,resolve,single);
+    // Commands and task panels tend to ask for the same selection several
+    // times in a row, which resolves every sub-element each time
+    const App::Document *pDoc = 0;
+    if(!pDocName || strcmp(pDocName,"*")!=0) {
+        pDoc = getDocument(pDocName);
+        if(!pDoc)
+            return std::vector<SelectionObject>();
+    }
+    auto &cache = _SelExCache;
+    if(cache.valid && cache.pDoc==pDoc && cache.typeId==typeId
+            && cache.resolve==resolve && cache.single==single)
+        return cache.objects;
+
+    cache.objects = getObjectList(pDocName,typeId,_SelList,resolve,single);
+    cache.pDoc = pDoc;
+    cache.typeId = typeId;
+    cache.resolve = resolve;
+    cache.single = single;
+    cache.valid = true;
+    return cache.objects;
 }
 
 std::vector<SelectionObject> SelectionSingleton::getPickedListEx(const char* pDocName, Base::Type typeId) const {
@@ -1096,7 +1115,7 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
     if(!logDisabled)
         temp.log(false,clearPreselect);
 
-    _SelList.push_back(temp);
+    addToSelList(temp);
     _SelStackForward.clear();
 
     if(clearPreselect)
@@ -1260,7 +1279,7 @@ bool SelectionSingleton::addSelections(const char* pDocName, const char* pObject
         temp.y        = 0;
         temp.z        = 0;
 
-        _SelList.push_back(temp);
+        addToSelList(temp);
         _SelStackForward.clear();
 
         SelectionChanges Chng(SelectionChanges::AddSelection,
@@ -1385,7 +1404,7 @@ void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectN
                 It->DocName,It->FeatName,It->SubName,It->TypeName);
 
         // destroy the _SelObj item
-        _SelList.erase(It);
+        eraseFromSelList(It);
     }
 
     // NOTE: It can happen that there are nested calls of rmvSelection()
@@ -1523,7 +1542,7 @@ void SelectionSingleton::setSelection(const char* pDocName, const std::vector<Ap
         if(ret!=0)
             continue;
         touched = true;
-        _SelList.push_back(temp);
+        addToSelList(temp);
     }
 
     if(touched) {
@@ -1559,7 +1578,7 @@ void SelectionSingleton::clearSelection(const char* pDocName, bool clearPreSelec
         for (auto it=_SelList.begin();it!=_SelList.end();) {
             if (it->DocName == docName) {
                 touched = true;
-                it = _SelList.erase(it);
+                it = eraseFromSelList(it);
             }
             else {
                 ++it;
@@ -1602,7 +1621,7 @@ void SelectionSingleton::clearCompleteSelection(bool clearPreSelect)
                 clearPreSelect?"Gui.Selection.clearSelection()"
                               :"Gui.Selection.clearSelection(False)");
 
-    _SelList.clear();
+    clearSelList();
 
     SelectionChanges Chng(SelectionChanges::ClrSelection);
 
@@ -1685,12 +1704,17 @@ int SelectionSingleton::checkSelection(const char *pDocName, const char *pObject
     if(!pSubName)
         pSubName = "";
 
-    for (auto &s : *selList) {
-        if (s.DocName==pDocName && s.FeatName==sel.FeatName) {
-            if(s.SubName==pSubName)
-                return 1;
-            if(resolve>1 && boost::starts_with(s.SubName,prefix))
-                return 1;
+    if(selList == &_SelList && resolve<=1) {
+        if(_SelIndex.count(selIndexKey(sel.DocName,sel.FeatName,pSubName)))
+            return 1;
+    } else {
+        for (auto &s : *selList) {
+            if (s.DocName==pDocName && s.FeatName==sel.FeatName) {
+                if(s.SubName==pSubName)
+                    return 1;
+                if(resolve>1 && boost::starts_with(s.SubName,prefix))
+                    return 1;
+            }
         }
     }
     if(resolve==1) {
@@ -1727,8 +1751,53 @@ const char *SelectionSingleton::getSelectedElement(App::DocumentObject *obj, con
     return 0;
 }
 
+std::string SelectionSingleton::selIndexKey(const std::string &docName,
+        const std::string &featName, const std::string &subName)
+{
+    // document and object names are identifiers, so the separators are unique
+    std::string key;
+    key.reserve(docName.size()+featName.size()+subName.size()+2);
+    key += docName;
+    key += '#';
+    key += featName;
+    key += '.';
+    key += subName;
+    return key;
+}
+
+void SelectionSingleton::addToSelList(const _SelObj &sel)
+{
+    _SelList.push_back(sel);
+    ++_SelIndex[selIndexKey(sel.DocName,sel.FeatName,sel.SubName)];
+    _SelExCache.valid = false;
+}
+
+std::list<SelectionSingleton::_SelObj>::iterator
+SelectionSingleton::eraseFromSelList(std::list<_SelObj>::iterator it)
+{
+    auto iter = _SelIndex.find(selIndexKey(it->DocName,it->FeatName,it->SubName));
+    if(iter != _SelIndex.end() && --iter->second <= 0)
+        _SelIndex.erase(iter);
+    _SelExCache.valid = false;
+    return _SelList.erase(it);
+}
+
+void SelectionSingleton::clearSelList()
+{
+    _SelList.clear();
+    _SelIndex.clear();
+    _SelExCache.valid = false;
+}
+
+void SelectionSingleton::slotChangedObject(const App::DocumentObject&, const App::Property&)
+{
+    // the sub-elements of the cached selection may resolve differently now
+    _SelExCache.valid = false;
+}
+
 void SelectionSingleton::slotDeletedObject(const App::DocumentObject& Obj)
 {
+    _SelExCache.valid = false;
     if(!Obj.getNameInDocument()) return;
 
     // For safety reason, don't bother checking
@@ -1742,7 +1811,7 @@ void SelectionSingleton::slotDeletedObject(const App::DocumentObject& Obj)
         if(it->pResolvedObject == &Obj || it->pObject==&Obj) {
             changes.emplace_back(SelectionChanges::RmvSelection,
                     it->DocName,it->FeatName,it->SubName,it->TypeName);
-            _SelList.erase(it);
+            eraseFromSelList(it);
         }
     }
     if(changes.size()) {
@@ -1788,6 +1857,7 @@ SelectionSingleton::SelectionSingleton()
     ActiveGate = 0;
     gateResolve = 1;
     App::GetApplication().signalDeletedObject.connect(boost::bind(&Gui::SelectionSingleton::slotDeletedObject, this, bp::_1));
+    App::GetApplication().signalChangedObject.connect(boost::bind(&Gui::SelectionSingleton::slotChangedObject, this, bp::_1, bp::_2));
     signalSelectionChanged.connect(boost::bind(&Gui::SelectionSingleton::slotSelectionChanged, this, bp::_1));
 }
 
@@ -32,6 +32,7 @@
 #include <list>
 #include <map>
 #include <deque>
+#include <unordered_map>
 #include <boost_signals2.hpp>
 #include <CXX/Objects.hxx>
 
@@ -670,6 +671,7 @@ protected:
 
     /// Observer message from the App doc
     void slotDeletedObject(const App::DocumentObject&);
+    void slotChangedObject(const App::DocumentObject&, const App::Property&);
 
     /// helper to retrieve document by name
     App::Document* getDocument(const char* pDocName=0) const;
@@ -703,6 +705,27 @@ protected:
     };
     mutable std::list<_SelObj> _SelList;
 
+    // Number of entries in _SelList per document, object and sub-element
+    // name, to find exact matches without walking the whole list
+    std::unordered_map<std::string, int> _SelIndex;
+    static std::string selIndexKey(const std::string &docName,
+            const std::string &featName, const std::string &subName);
+    void addToSelList(const _SelObj &sel);
+    std::list<_SelObj>::iterator eraseFromSelList(std::list<_SelObj>::iterator it);
+    void clearSelList();
+
+    // Result of the last getSelectionEx() call, it is reset when the
+    // selection or any document object changes
+    struct SelectionExCache {
+        bool valid = false;
+        const App::Document *pDoc = 0;
+        Base::Type typeId;
+        int resolve = 0;
+        bool single = false;
+        std::vector<Gui::SelectionObject> objects;
+    };
+    mutable SelectionExCache _SelExCache;
+
     mutable std::list<_SelObj> _PickedList;
     bool _needPickedList;
 
@@ -24,6 +24,7 @@
 #ifndef _PreComp_
 # include <Inventor/actions/SoGLRenderAction.h>
 # include <Inventor/elements/SoGLCacheContextElement.h>
+# include <Inventor/misc/SoContextHandler.h>
 # include <Inventor/fields/SoSFImage.h>
 # include <Inventor/nodes/SoNode.h>
 # include <QBuffer>
@@ -416,7 +417,12 @@ void SoQtOffscreenRenderer::init(const SbViewportRegion & vpr,
     this->pixelbuffer = NULL;                // constructed later
 #endif
     this->framebuffer = NULL;
+    this->framebufferSamples = -1;
     this->numSamples = -1;
+#if defined(HAVE_QT5_OPENGL)
+    this->context = NULL;
+    this->surface = NULL;
+#endif
 #if defined(HAVE_QT5_OPENGL)
     //this->texFormat = GL_RGBA32F_ARB;
     this->texFormat = GL_RGB32F_ARB;
@@ -454,6 +460,19 @@ SoQtOffscreenRenderer::~SoQtOffscreenRenderer()
 {
 #if !defined(HAVE_QT5_OPENGL)
     delete pixelbuffer;
+#else
+    if (context) {
+        // let Coin free its display lists and buffers of our context, and
+        // delete the frame buffer while its context is current
+        context->makeCurrent(surface);
+        if (cache_context)
+            SoContextHandler::destructingContext(cache_context);
+        delete framebuffer;
+        framebuffer = NULL;
+        context->doneCurrent();
+        delete context;
+        delete surface;
+    }
 #endif
     delete framebuffer;
 
@@ -630,7 +649,10 @@ SoQtOffscreenRenderer::makeFrameBuffer(int width, int height, int samples)
 #endif
 
     framebuffer = new QtGLFramebufferObject(width, height, fmt);
+    framebufferSamples = samples;
+#if !defined(HAVE_QT5_OPENGL)
     cache_context = SoGLCacheContextElement::getUniqueCacheContext(); // unique per pixel buffer object, just to be sure
+#endif
 }
 
 SbBool
@@ -639,16 +661,25 @@ SoQtOffscreenRenderer::renderFromBase(SoBase * base)
     const SbVec2s fullsize = this->viewport.getViewportSizePixels();
 
 #if defined(HAVE_QT5_OPENGL)
-    QSurfaceFormat format;
-    format.setSamples(PRIVATE(this)->numSamples);
-    QOpenGLContext context;
-    context.setFormat(format);
-    if (!context.create())
+    // The context is created once and reused by all further calls. The cache
+    // context id belongs to it, so that Coin's caches stay valid.
+    if (!context) {
+        QSurfaceFormat format;
+        format.setSamples(PRIVATE(this)->numSamples);
+        context = new QOpenGLContext;
+        context->setFormat(format);
+        if (!context->create()) {
+            delete context;
+            context = NULL;
+            return false;
+        }
+        surface = new QOffscreenSurface;
+        surface->setFormat(format);
+        surface->create();
+        cache_context = SoGLCacheContextElement::getUniqueCacheContext();
+    }
+    if (!context->makeCurrent(surface))
         return false;
-    QOffscreenSurface offscreen;
-    offscreen.setFormat(format);
-    offscreen.create();
-    context.makeCurrent(&offscreen);
 #endif
 
 #if !defined(HAVE_QT5_OPENGL)
@@ -669,7 +700,8 @@ SoQtOffscreenRenderer::renderFromBase(SoBase * base)
         if (!framebuffer) {
             makeFrameBuffer(fullsize[0], fullsize[1], PRIVATE(this)->numSamples);
         }
-        else if (framebuffer->width() != fullsize[0] || framebuffer->height() != fullsize[1]) {
+        else if (framebuffer->width() != fullsize[0] || framebuffer->height() != fullsize[1] ||
+                 framebufferSamples != PRIVATE(this)->numSamples) {
             // get the size right!
             makeFrameBuffer(fullsize[0], fullsize[1], PRIVATE(this)->numSamples);
         }
@@ -717,7 +749,7 @@ SoQtOffscreenRenderer::renderFromBase(SoBase * base)
 
 #if defined(HAVE_QT5_OPENGL)
     glImage = framebuffer->toImage();
-    context.doneCurrent();
+    context->doneCurrent();
 #endif
 
     return true;
@@ -31,6 +31,9 @@
 #include <QStringList>
 #include <QtOpenGL.h>
 
+class QOpenGLContext;
+class QOffscreenSurface;
+
 namespace Gui {
 
 /**
@@ -98,6 +101,15 @@ public:
   std::string createMIBA(const SbMatrix& mat) const;
 };
 
+/**
+ * Offscreen renderer using a Qt frame buffer object.
+ *
+ * The GL context, the frame buffer and the Coin cache context are kept
+ * between calls of render(), so a single instance can render a series of
+ * images without recreating them and with the render caches of the scene
+ * still valid. The frame buffer is only recreated if the size or the number
+ * of samples changes.
+ */
 class GuiExport SoQtOffscreenRenderer
 {
 public:
@@ -142,6 +154,7 @@ private:
     QGLPixelBuffer*         pixelbuffer; // the offscreen rendering supported by Qt
 #endif
     QtGLFramebufferObject*  framebuffer;
+    int                     framebufferSamples;
     uint32_t                cache_context; // our unique context id
 
     SbViewportRegion viewport;
@@ -154,6 +167,8 @@ private:
     GLenum texFormat;
 #if defined(HAVE_QT5_OPENGL)
     QImage glImage;
+    QOpenGLContext*    context;
+    QOffscreenSurface* surface;
 #endif
 };
 
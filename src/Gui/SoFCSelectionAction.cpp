@@ -946,7 +946,8 @@ void SoUpdateVBOAction::initClass()
   SO_ACTION_ADD_METHOD(SoFCSelection,callDoAction);
 }
 
-SoUpdateVBOAction::SoUpdateVBOAction ()
+SoUpdateVBOAction::SoUpdateVBOAction (UpdateType type)
+  : _type(type)
 {
   SO_ACTION_CONSTRUCTOR(SoUpdateVBOAction);
 }
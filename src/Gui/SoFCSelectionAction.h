@@ -354,17 +354,26 @@ class GuiExport SoUpdateVBOAction : public SoAction
     SO_ACTION_HEADER(SoUpdateVBOAction);
 
 public:
-    SoUpdateVBOAction ();
+    /// What has changed: everything, or only the colors
+    enum UpdateType {All, Color};
+
+    SoUpdateVBOAction (UpdateType type=All);
     ~SoUpdateVBOAction();
 
     static void initClass();
     static void finish(void);
 
+    UpdateType getUpdateType() const {
+        return _type;
+    }
+
 protected:
     virtual void beginTraversal(SoNode *node);
 
 private:
     static void callDoAction(SoAction *action,SoNode *node);
+
+    UpdateType _type;
 };
 
 } // namespace Gui
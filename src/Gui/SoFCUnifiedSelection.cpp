@@ -32,6 +32,7 @@
 #include <Inventor/elements/SoOverrideElement.h>
 #include <Inventor/elements/SoLazyElement.h>
 #include <Inventor/elements/SoCacheElement.h>
+#include <Inventor/elements/SoCullElement.h>
 #include <Inventor/elements/SoWindowElement.h>
 
 #include <Inventor/SoFullPath.h>
@@ -63,6 +64,7 @@
 #include <Inventor/nodes/SoMaterialBinding.h>
 #include <Inventor/nodes/SoNormalBinding.h>
 #include <Inventor/events/SoLocation2Event.h>
+#include <Inventor/SoEventManager.h>
 #include <Inventor/SoPickedPoint.h>
 #include <Inventor/threads/SbStorage.h>
 
@@ -113,7 +115,8 @@ SO_NODE_SOURCE(SoFCUnifiedSelection)
 /*!
   Constructor.
 */
-SoFCUnifiedSelection::SoFCUnifiedSelection() : pcDocument(0)
+SoFCUnifiedSelection::SoFCUnifiedSelection()
+    : pcDocument(0), pcViewer(0), preselSensor(preselectionSensorCB, this)
 {
     SO_NODE_CONSTRUCTOR(SoFCUnifiedSelection);
 
@@ -139,6 +142,11 @@ SoFCUnifiedSelection::SoFCUnifiedSelection() : pcDocument(0)
     setPreSelection = false;
     preSelection = -1;
     useNewSelection = ViewParams::instance()->getUseNewSelection();
+
+    preselPos.setValue(-1,-1);
+    preselNodeId = 0;
+    preselTime = SbTime::zero();
+    preselShift = preselCtrl = preselAlt = false;
 }
 
 /*!
@@ -747,18 +755,47 @@ SoFCUnifiedSelection::handleEvent(SoHandleEventAction * action)
         // down extremely the system on really big data sets. In this case we just check for a picked point if the data
         // set has been selected.
         if (mymode == AUTO || mymode == ON) {
-            // check to see if the mouse is over our geometry...
-            auto infos = this->getPickedList(action,true);
-            if(infos.size())
-                setHighlight(infos[0]);
+            const SbVec2s pos = event->getPosition();
+            SoNode *head = action->getCurPath()->getHead();
+            SbTime now = SbTime::getTimeOfDay();
+            int interval = ViewParams::instance()->getPreselectionInterval();
+            if (pos == preselPos && head->getNodeId() == preselNodeId) {
+                // Neither the mouse nor anything in the scene (including the
+                // camera) has changed since the last pick, so the result
+                // would be the same.
+            }
+            else if (interval > 0 && pcViewer && (now - preselTime).getValue()*1000.0 < interval) {
+                // Too soon after the last pick. Remember the position and
+                // pick once the interval has passed, so that the highlight
+                // always ends up at the final mouse position.
+                preselPendingPos = pos;
+                preselShift = event->wasShiftDown();
+                preselCtrl = event->wasCtrlDown();
+                preselAlt = event->wasAltDown();
+                if (!preselSensor.isScheduled()) {
+                    preselSensor.setTimeFromNow(SbTime(interval/1000.0) - (now - preselTime));
+                    preselSensor.schedule();
+                }
+            }
             else {
-                setHighlight(PickedInfo());
-                if (this->preSelection > 0) {
-                    this->preSelection = 0;
-                    // touch() makes sure to call GLRenderBelowPath so that the cursor can be updated
-                    // because only from there the SoGLWidgetElement delivers the OpenGL window
-                    this->touch();
+                preselSensor.unschedule();
+                // check to see if the mouse is over our geometry...
+                auto infos = this->getPickedList(action,true);
+                if(infos.size())
+                    setHighlight(infos[0]);
+                else {
+                    setHighlight(PickedInfo());
+                    if (this->preSelection > 0) {
+                        this->preSelection = 0;
+                        // touch() makes sure to call GLRenderBelowPath so that the cursor can be updated
+                        // because only from there the SoGLWidgetElement delivers the OpenGL window
+                        this->touch();
+                    }
                 }
+                // read the node id after highlighting, which touches the scene
+                preselPos = pos;
+                preselTime = now;
+                preselNodeId = head->getNodeId();
             }
         }
     }
@@ -777,6 +814,23 @@ SoFCUnifiedSelection::handleEvent(SoHandleEventAction * action)
     inherited::handleEvent(action);
 }
 
+void SoFCUnifiedSelection::preselectionSensorCB(void *data, SoSensor *)
+{
+    auto self = static_cast<SoFCUnifiedSelection*>(data);
+    if (!self->pcViewer)
+        return;
+
+    // replay the last throttled mouse move
+    SoLocation2Event ev;
+    ev.setPosition(self->preselPendingPos);
+    ev.setShiftDown(self->preselShift);
+    ev.setCtrlDown(self->preselCtrl);
+    ev.setAltDown(self->preselAlt);
+    ev.setTime(SbTime::getTimeOfDay());
+    self->preselTime = SbTime::zero();
+    self->pcViewer->getSoEventManager()->processEvent(&ev);
+}
+
 void SoFCUnifiedSelection::GLRenderBelowPath(SoGLRenderAction * action)
 {
     inherited::GLRenderBelowPath(action);
@@ -1087,6 +1141,20 @@ static void so_bbox_cleanup(void)
     delete so_bbox_storage;
 }
 
+static SoFCBBoxRenderInfo * so_bbox_get_data(void)
+{
+    auto data = (SoFCBBoxRenderInfo*) so_bbox_storage->get();
+    if (data->bboxaction == NULL) {
+        // The viewport region will be replaced every time the action is
+        // used, so we can just feed it a dummy here.
+        data->bboxaction = new SoGetBoundingBoxAction(SbViewportRegion());
+        data->cube = new SoCube;
+        data->cube->ref();
+        data->packer = new SoColorPacker;
+    }
+    return data;
+}
+
 // ---------------------------------------------------------------------------------
 
 SoFCSelectionRoot::Stack SoFCSelectionRoot::SelStack;
@@ -1228,15 +1296,7 @@ std::pair<bool,SoFCSelectionContextBasePtr*> SoFCSelectionRoot::findActionContex
 
 bool SoFCSelectionRoot::renderBBox(SoGLRenderAction *action, SoNode *node, SbColor color)
 {
-    auto data = (SoFCBBoxRenderInfo*) so_bbox_storage->get();
-    if (data->bboxaction == NULL) {
-        // The viewport region will be replaced every time the action is
-        // used, so we can just feed it a dummy here.
-        data->bboxaction = new SoGetBoundingBoxAction(SbViewportRegion());
-        data->cube = new SoCube;
-        data->cube->ref();
-        data->packer = new SoColorPacker;
-    }
+    auto data = so_bbox_get_data();
 
     SbBox3f bbox;
     data->bboxaction->setViewportRegion(action->getViewportRegion());
@@ -1277,7 +1337,30 @@ bool SoFCSelectionRoot::renderBBox(SoGLRenderAction *action, SoNode *node, SbCol
 
 static std::time_t _CyclicLastReported;
 
+bool SoFCSelectionRoot::cullTest(SoGLRenderAction * action) {
+    auto state = action->getState();
+
+    // Do not cull while a parent render cache is being built, or the cache
+    // would miss whatever is out of view at the moment.
+    if(!ViewParams::instance()->getRenderCulling()
+            || SoCacheElement::anyOpen(state)
+            || SoCullElement::completelyInside(state))
+        return false;
+
+    if(cullNodeId != getNodeId()) {
+        auto data = so_bbox_get_data();
+        data->bboxaction->setViewportRegion(action->getViewportRegion());
+        data->bboxaction->apply(this);
+        cullBox = data->bboxaction->getBoundingBox();
+        cullNodeId = getNodeId();
+    }
+    // the box is in local coordinates, so let cullTest() apply the model matrix
+    return !cullBox.isEmpty() && SoCullElement::cullTest(state, cullBox, TRUE);
+}
+
 void SoFCSelectionRoot::renderPrivate(SoGLRenderAction * action, bool inPath) {
+    if(!inPath && cullTest(action))
+        return;
     if(ViewParams::instance()->getCoinCycleCheck()
             && !SelStack.nodeSet.insert(this).second)
     {
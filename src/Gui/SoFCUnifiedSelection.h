@@ -30,6 +30,9 @@
 #include <Inventor/fields/SoSFEnum.h>
 #include <Inventor/fields/SoSFString.h>
 #include <Inventor/nodes/SoLightModel.h>
+#include <Inventor/sensors/SoAlarmSensor.h>
+#include <Inventor/SbTime.h>
+#include <Inventor/SbBox3f.h>
 #include "View3DInventorViewer.h"
 #include "SoFCSelectionContext.h"
 #include <list>
@@ -117,7 +120,10 @@ private:
 
     std::vector<PickedInfo> getPickedList(SoHandleEventAction* action, bool singlePick) const;
 
+    static void preselectionSensorCB(void *data, SoSensor *);
+
     Gui::Document       *pcDocument;
+    View3DInventorViewer *pcViewer;
 
     static SoFullPath * currenthighlight;
     SoFullPath * detailPath;
@@ -127,6 +133,17 @@ private:
     // -1 = not handled, 0 = not selected, 1 = selected
     int32_t preSelection;
     SoColorPacker colorpacker;
+
+    // state of the last preselection pick, used to skip picks that give the
+    // same result and to limit the pick rate while the mouse moves
+    SoAlarmSensor preselSensor;
+    SbVec2s preselPos;
+    SbUniqueId preselNodeId;
+    SbTime preselTime;
+    SbVec2s preselPendingPos;
+    bool preselShift;
+    bool preselCtrl;
+    bool preselAlt;
 };
 
 class GuiExport SoFCPathAnnotation : public SoSeparator {
@@ -329,6 +346,7 @@ protected:
 
     void renderPrivate(SoGLRenderAction *, bool inPath);
     bool _renderPrivate(SoGLRenderAction *, bool inPath);
+    bool cullTest(SoGLRenderAction *);
 
     class Stack : public std::vector<SoFCSelectionRoot*> {
     public:
@@ -372,6 +390,11 @@ protected:
     float transOverride = 0.0f;
     SoColorPacker shapeColorPacker;
 
+    // local bounding box used for view frustum culling, recomputed whenever
+    // the node id changes
+    SbBox3f cullBox;
+    SbUniqueId cullNodeId = 0;
+
     bool doActionPrivate(Stack &stack, SoAction *);
 };
 
@@ -358,7 +358,7 @@ public:
     void testStatus(bool resetStatus = false) {
         QIcon icon,icon2;
         for(auto item : items)
-            item->testStatus(resetStatus,icon,icon2);
+            item->testShownStatus(resetStatus,icon,icon2);
     }
 
     void slotChangeIcon() {
@@ -2571,6 +2571,20 @@ void TreeWidget::onItemCollapsed(QTreeWidgetItem * item)
     }
 }
 
+static void testPendingStatus(QTreeWidgetItem *item)
+{
+    for(int i=0, count=item->childCount(); i<count; ++i) {
+        auto child = item->child(i);
+        if(child->type() == TreeWidget::ObjectType) {
+            auto childItem = static_cast<DocumentObjectItem*>(child);
+            if(childItem->isStatusPending())
+                childItem->testStatus(false);
+        }
+        if(child->isExpanded())
+            testPendingStatus(child);
+    }
+}
+
 void TreeWidget::onItemExpanded(QTreeWidgetItem * item)
 {
     // object item expanded
@@ -2579,6 +2593,11 @@ void TreeWidget::onItemExpanded(QTreeWidgetItem * item)
         objItem->setExpandedStatus(true);
         objItem->getOwnerDocument()->populateItem(objItem,false,false);
     }
+
+    // the status of the items below a collapsed item is not updated,
+    // so catch up with the ones that are shown now
+    if (item)
+        testPendingStatus(item);
 }
 
 void TreeWidget::scrollItemToTop()
@@ -4527,6 +4546,20 @@ void DocumentObjectItem::testStatus(bool resetStatus)
     testStatus(resetStatus,icon,icon2);
 }
 
+void DocumentObjectItem::testShownStatus(bool resetStatus, QIcon &icon1, QIcon &icon2)
+{
+    // With large documents most of the items are hidden below collapsed
+    // parents. Testing their status on every update would make the cost of
+    // an update proportional to the document size instead of the visible part.
+    for(auto parent=QTreeWidgetItem::parent(); parent; parent=parent->parent()) {
+        if(!parent->isExpanded()) {
+            previousStatus = -1;
+            return;
+        }
+    }
+    testStatus(resetStatus,icon1,icon2);
+}
+
 void DocumentObjectItem::testStatus(bool resetStatus, QIcon &icon1, QIcon &icon2)
 {
     App::DocumentObject* pObject = object()->getObject();
@@ -390,6 +390,10 @@ public:
     Gui::ViewProviderDocumentObject* object() const;
     void testStatus(bool resetStatus, QIcon &icon1, QIcon &icon2);
     void testStatus(bool resetStatus);
+    // Tests the status only if all parent items are expanded. Otherwise the
+    // test is postponed until the item is shown, see TreeWidget::onItemExpanded()
+    void testShownStatus(bool resetStatus, QIcon &icon1, QIcon &icon2);
+    bool isStatusPending() const { return previousStatus == -1; }
     void displayStatusInfo();
     void setExpandedStatus(bool);
     void setData(int column, int role, const QVariant & value);
@@ -1123,6 +1123,11 @@ void LinkView::setSize(int _size) {
     for(auto &info : nodeArray)
         pcLinkRoot->addChild(info->pcSwitch);
 
+    // All elements share the same linked root node, and therefore its render
+    // and bounding box cache, and only differ by their transform. Each element
+    // is still a separate SoFCSelectionRoot so that it can carry its own
+    // selection context, color override and visibility, and so that elements
+    // outside the view are culled individually.
     while(nodeArray.size()<size) {
         nodeArray.push_back(std::unique_ptr<Element>(new Element(*this)));
         auto &info = *nodeArray.back();
@@ -233,6 +233,7 @@ void PropertyModel::buildUp(const PropertyModel::PropertyList& props)
 
     // fill up the listview with the properties
     rootItem->reset();
+    itemMap.clear();
 
     // sort the properties into their groups
     std::map<std::string, std::vector<PropItemInfo> > propGroup;
@@ -276,6 +277,8 @@ void PropertyModel::buildUp(const PropertyModel::PropertyList& props)
                     setPropertyItemName(child,prop->getName(),groupName);
 
                     child->setPropertyData(info.props);
+                    for (auto p : info.props)
+                        itemMap[p] = child;
                 }
             }
         }
@@ -286,20 +289,18 @@ void PropertyModel::buildUp(const PropertyModel::PropertyList& props)
 
 void PropertyModel::updateProperty(const App::Property& prop)
 {
+    auto it = itemMap.find(&prop);
+    if (it == itemMap.end())
+        return;
+
     int column = 1;
-    int numChild = rootItem->childCount();
-    for (int row=0; row<numChild; row++) {
-        PropertyItem* child = rootItem->child(row);
-        if (child->hasProperty(&prop)) {
-            child->updateData();
-            QModelIndex data = this->index(row, column, QModelIndex());
-            if (data.isValid()) {
-                child->assignProperty(&prop);
-                dataChanged(data, data);
-                updateChildren(child, column, data);
-            }
-            break;
-        }
+    PropertyItem* child = it->second;
+    child->updateData();
+    QModelIndex data = this->index(child->row(), column, QModelIndex());
+    if (data.isValid()) {
+        child->assignProperty(&prop);
+        dataChanged(data, data);
+        updateChildren(child, column, data);
     }
 }
 
@@ -385,6 +386,7 @@ void PropertyModel::appendProperty(const App::Property& prop)
 
         setPropertyItemName(item,prop.getName(),groupName);
         item->setPropertyData(data);
+        itemMap[&prop] = item;
 
         endInsertRows();
     }
@@ -392,16 +394,14 @@ void PropertyModel::appendProperty(const App::Property& prop)
 
 void PropertyModel::removeProperty(const App::Property& prop)
 {
-    int numChild = rootItem->childCount();
-    for (int row=0; row<numChild; row++) {
-        PropertyItem* child = rootItem->child(row);
-        if (child->hasProperty(&prop)) {
-            if (child->removeProperty(&prop)) {
-                removeRow(row, QModelIndex());
-            }
-            break;
-        }
-    }
+    auto it = itemMap.find(&prop);
+    if (it == itemMap.end())
+        return;
+
+    PropertyItem* child = it->second;
+    itemMap.erase(it);
+    if (child->removeProperty(&prop))
+        removeRow(child->row(), QModelIndex());
 }
 
 void PropertyModel::updateChildren(PropertyItem* item, int column, const QModelIndex& parent)
@@ -433,6 +433,12 @@ bool PropertyModel::removeRows(int row, int count, const QModelIndex& parent)
 
     int start = row;
     int end = row+count-1;
+    if (item == rootItem) {
+        for (int i=start; i<=end && i<item->childCount(); i++) {
+            for (auto prop : item->child(i)->getPropertyData())
+                itemMap.erase(prop);
+        }
+    }
     beginRemoveRows(parent, start, end);
     item->removeChildren(start, end);
     endRemoveRows();
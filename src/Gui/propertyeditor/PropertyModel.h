@@ -28,6 +28,7 @@
 #include <QStringList>
 #include <vector>
 #include <map>
+#include <unordered_map>
 
 namespace App {
 class Property;
@@ -72,6 +73,8 @@ private:
 
 private:
     PropertyItem *rootItem;
+    /// maps the properties to the top level items showing them
+    std::unordered_map<const App::Property*, PropertyItem*> itemMap;
 };
 
 } //namespace PropertyEditor
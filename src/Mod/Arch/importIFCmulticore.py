@@ -33,6 +33,8 @@ import importIFC
 import importIFCHelper
 from FreeCAD import Base
 import ArchIFC
+import ArchComponent
+import ArchSpace
 
 # global dicts to store ifc object/freecad object relationships
 
@@ -43,6 +45,9 @@ subs = {} #host_ifcid: [child_ifcid,...]
 adds = {} #host_ifcid: [child_ifcid,...]
 colors = {} # objname : (r,g,b)
 
+# number of products whose shapes are built and objects created at once
+BATCH_SIZE = 256
+
 
 def open(filename):
 
@@ -106,16 +111,21 @@ def insert(filename,docname=None,preferences=None):
     count = 0
 
     # process objects
+    batch = []
     while True:
         item = iterator.get()
         if item:
-            brep = item.geometry.brep_data
             ifcproduct = ifcfile.by_id(item.guid)
-            obj = createProduct(ifcproduct,brep)
-            progressbar.next(True)
+            batch.append((ifcproduct,item.geometry.brep_data))
+        more = iterator.next()
+        if len(batch) >= BATCH_SIZE or (batch and not more):
+            createProducts(batch)
+            for i in range(len(batch)):
+                progressbar.next(True)
+            count += len(batch)
             writeProgress(count,productscount,starttime)
-            count += 1
-        if not iterator.next():
+            batch = []
+        if not more:
             break
 
     # post-processing
@@ -154,19 +164,40 @@ def writeProgress(count=None,total=None,starttime=None):
         sys.stdout.write(fstring.format(hashes, int(r*100),eta))
 
 
-def createProduct(ifcproduct,brep):
+def createProducts(items):
 
-    """creates an Arch object from an IFC product"""
+    """creates the Arch objects of a list of (IFC product, brep) tuples"""
 
     import Part
 
-    shape = Part.Shape()
-    shape.importBrepFromString(brep,False)
-    shape.scale(1000.0) # IfcOpenShell outputs in meters
-    if ifcproduct.is_a("IfcSpace"):
-        obj = Arch.makeSpace()
-    else:
-        obj = Arch.makeComponent()
+    # IfcOpenShell outputs in meters
+    shapes = Part.readBreps([brep for ifcproduct,brep in items],1000.0)
+    spaces = [i for i,item in enumerate(items) if item[0].is_a("IfcSpace")]
+    components = [i for i,item in enumerate(items) if not item[0].is_a("IfcSpace")]
+    objs = [None] * len(items)
+    doc = FreeCAD.ActiveDocument
+    for indices,name in ((spaces,"Space"),(components,"Component")):
+        if not indices:
+            continue
+        for i,obj in zip(indices,doc.addObjects("Part::FeaturePython",[name]*len(indices))):
+            if name == "Space":
+                ArchSpace._Space(obj)
+                if FreeCAD.GuiUp:
+                    ArchSpace._ViewProviderSpace(obj.ViewObject)
+            else:
+                ArchComponent.Component(obj)
+                if FreeCAD.GuiUp:
+                    ArchComponent.ViewProviderComponent(obj.ViewObject)
+            objs[i] = obj
+    for (ifcproduct,brep),shape,obj in zip(items,shapes,objs):
+        createProduct(ifcproduct,shape,obj)
+    return objs
+
+
+def createProduct(ifcproduct,shape,obj):
+
+    """sets up an Arch object created from an IFC product"""
+
     obj.Shape = shape
     objects[ifcproduct.id()] = obj
     setAttributes(obj,ifcproduct)
@@ -26,6 +26,8 @@
 #ifndef _PreComp_
 # include <sstream>
 # include <cmath>
+# include <algorithm>
+# include <vector>
 # include <BRepAdaptor_Curve.hxx>
 # include <Geom_Circle.hxx>
 # include <gp_Circ.hxx>
@@ -73,6 +75,8 @@
 #include <GeomConvert_BSplineCurveToBezierCurve.hxx>
 #include <GeomConvert_BSplineCurveKnotSplitting.hxx>
 #include <Geom2d_BSplineCurve.hxx>
+
+#include <Mod/Part/App/Tools.h>
 #include <BRepLProp_CLProps.hxx>
 #include <Standard_Failure.hxx>
 
@@ -177,38 +181,59 @@ SVGOutput::SVGOutput()
 
 std::string SVGOutput::exportEdges(const TopoDS_Shape& input)
 {
-    std::stringstream result;
+    std::vector<TopoDS_Edge> edges;
+    for (TopExp_Explorer expl(input, TopAbs_EDGE); expl.More(); expl.Next())
+        edges.push_back(TopoDS::Edge(expl.Current()));
+
+    // the edges are converted in blocks, each into its own buffer. The buffers
+    // are joined in the order of the edges.
+    const std::size_t blockSize = 256;
+    std::size_t blockCount = (edges.size() + blockSize - 1) / blockSize;
+    std::vector<std::string> blocks(blockCount);
+    Part::Tools::parallelFor(blockCount, [&](std::size_t block) {
+        std::stringstream out;
+        std::size_t end = std::min(edges.size(), (block + 1) * blockSize);
+        for (std::size_t i = block * blockSize; i < end; i++)
+            printEdge(edges[i], static_cast<int>(i + 1), out);
+        blocks[block] = out.str();
+    });
+
+    std::size_t length = 0;
+    for (const auto& it : blocks)
+        length += it.size();
+    std::string result;
+    result.reserve(length);
+    for (const auto& it : blocks)
+        result += it;
+    return result;
+}
 
-    TopExp_Explorer edges(input, TopAbs_EDGE);
-    for (int i = 1 ; edges.More(); edges.Next(),i++) {
-        const TopoDS_Edge& edge = TopoDS::Edge(edges.Current());
-        BRepAdaptor_Curve adapt(edge);
-        if (adapt.GetType() == GeomAbs_Circle) {
-            printCircle(adapt, result);
-        }
-        else if (adapt.GetType() == GeomAbs_Ellipse) {
-            printEllipse(adapt, i, result);
-        }
-        else if (adapt.GetType() == GeomAbs_BSplineCurve) {
-//            TopoDS_Edge circle = asCircle(adapt);
-//            if (circle.IsNull()) {
-                printBSpline(adapt, i, result);
-//            }
-//            else {
-//                BRepAdaptor_Curve adapt_circle(circle);
-//                printCircle(adapt_circle, result);
-//            }
-        }
-        else if (adapt.GetType() == GeomAbs_BezierCurve) {
-            printBezier(adapt, i, result);
-        }
-        // fallback
-        else {
-            printGeneric(adapt, i, result);
-        }
+void SVGOutput::printEdge(const TopoDS_Edge& edge, int id, std::ostream& out)
+{
+    BRepAdaptor_Curve adapt(edge);
+    if (adapt.GetType() == GeomAbs_Circle) {
+        printCircle(adapt, out);
+    }
+    else if (adapt.GetType() == GeomAbs_Ellipse) {
+        printEllipse(adapt, id, out);
+    }
+    else if (adapt.GetType() == GeomAbs_BSplineCurve) {
+//        TopoDS_Edge circle = asCircle(adapt);
+//        if (circle.IsNull()) {
+            printBSpline(adapt, id, out);
+//        }
+//        else {
+//            BRepAdaptor_Curve adapt_circle(circle);
+//            printCircle(adapt_circle, out);
+//        }
+    }
+    else if (adapt.GetType() == GeomAbs_BezierCurve) {
+        printBezier(adapt, id, out);
+    }
+    // fallback
+    else {
+        printGeneric(adapt, id, out);
     }
-
-    return result.str();
 }
 
 void SVGOutput::printCircle(const BRepAdaptor_Curve& c, std::ostream& out)
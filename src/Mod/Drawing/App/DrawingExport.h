@@ -46,9 +46,11 @@ class DrawingExport SVGOutput : public DrawingOutput
 {
 public:
     SVGOutput();
+    /// Converts the edges of the shape, using all cores for many edges
     std::string exportEdges(const TopoDS_Shape&);
 
 private:
+    void printEdge(const TopoDS_Edge&, int id, std::ostream&);
     void printCircle(const BRepAdaptor_Curve&, std::ostream&);
     void printEllipse(const BRepAdaptor_Curve&, int id, std::ostream&);
     void printBSpline(const BRepAdaptor_Curve&, int id, std::ostream&);
@@ -48,6 +48,7 @@
 #include <Poly_Triangulation.hxx>
 #include <Poly_PolygonOnTriangulation.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Vertex.hxx>
@@ -58,6 +59,7 @@
 #include <TopTools_ListOfShape.hxx>
 #include <TColgp_Array1OfPnt2d.hxx>
 #include <BRep_Tool.hxx>
+#include <BRep_Builder.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepLib.hxx>
 #include <BRepAdaptor_CompCurve.hxx>
@@ -75,6 +77,7 @@
 #include <Base/FileInfo.h>
 #include <Base/Tools.h>
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/Tools.h>
 
 #include "ProjectionAlgos.h"
 #include "DrawingExport.h"
@@ -109,12 +112,15 @@ static const TopoDS_Shape& build3dCurves(const TopoDS_Shape &shape)
   return shape;
 }
 
-void ProjectionAlgos::execute(void)
+namespace {
+
+const int lineSetCount = 10;
+
+void projectShape(const TopoDS_Shape& input, const gp_Ax2& transform, TopoDS_Shape lines[lineSetCount])
 {
     Handle( HLRBRep_Algo ) brep_hlr = new HLRBRep_Algo;
-    brep_hlr->Add(Input);
+    brep_hlr->Add(input);
 
-    gp_Ax2 transform(gp_Pnt(0,0,0),gp_Dir(Direction.x,Direction.y,Direction.z));
     HLRAlgo_Projector projector( transform );
     brep_hlr->Projector(projector);
     brep_hlr->Update();
@@ -123,16 +129,62 @@ void ProjectionAlgos::execute(void)
     // extracting the result sets:
     HLRBRep_HLRToShape shapes( brep_hlr );
 
-    V  = build3dCurves(shapes.VCompound       ());// hard edge visibly
-    V1 = build3dCurves(shapes.Rg1LineVCompound());// Smoth edges visibly
-    VN = build3dCurves(shapes.RgNLineVCompound());// contour edges visibly
-    VO = build3dCurves(shapes.OutLineVCompound());// contours apparents visibly
-    VI = build3dCurves(shapes.IsoLineVCompound());// isoparamtriques   visibly
-    H  = build3dCurves(shapes.HCompound       ());// hard edge       invisibly
-    H1 = build3dCurves(shapes.Rg1LineHCompound());// Smoth edges  invisibly
-    HN = build3dCurves(shapes.RgNLineHCompound());// contour edges invisibly
-    HO = build3dCurves(shapes.OutLineHCompound());// contours apparents invisibly
-    HI = build3dCurves(shapes.IsoLineHCompound());// isoparamtriques   invisibly
+    lines[0] = build3dCurves(shapes.VCompound       ());// hard edge visibly
+    lines[1] = build3dCurves(shapes.Rg1LineVCompound());// Smoth edges visibly
+    lines[2] = build3dCurves(shapes.RgNLineVCompound());// contour edges visibly
+    lines[3] = build3dCurves(shapes.OutLineVCompound());// contours apparents visibly
+    lines[4] = build3dCurves(shapes.IsoLineVCompound());// isoparamtriques   visibly
+    lines[5] = build3dCurves(shapes.HCompound       ());// hard edge       invisibly
+    lines[6] = build3dCurves(shapes.Rg1LineHCompound());// Smoth edges  invisibly
+    lines[7] = build3dCurves(shapes.RgNLineHCompound());// contour edges invisibly
+    lines[8] = build3dCurves(shapes.OutLineHCompound());// contours apparents invisibly
+    lines[9] = build3dCurves(shapes.IsoLineHCompound());// isoparamtriques   invisibly
+}
+
+struct LineSets
+{
+    TopoDS_Shape lines[lineSetCount];
+};
+
+}
+
+void ProjectionAlgos::execute(void)
+{
+    gp_Ax2 transform(gp_Pnt(0,0,0),gp_Dir(Direction.x,Direction.y,Direction.z));
+    TopoDS_Shape* lines[lineSetCount] = { &V, &V1, &VN, &VO, &VI, &H, &H1, &HN, &HO, &HI };
+
+    // parts of the shape whose projections don't overlap are projected in parallel
+    std::vector<TopoDS_Shape> groups = Part::Tools::splitByProjection(Input, transform);
+    if (groups.empty()) {
+        TopoDS_Shape result[lineSetCount];
+        projectShape(Input, transform, result);
+        for (int i = 0; i < lineSetCount; i++)
+            *lines[i] = result[i];
+        return;
+    }
+
+    std::vector<LineSets> results(groups.size());
+    Part::Tools::parallelFor(groups.size(), [&](std::size_t i) {
+        projectShape(groups[i], transform, results[i].lines);
+    });
+
+    BRep_Builder builder;
+    for (int i = 0; i < lineSetCount; i++) {
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        bool found = false;
+        for (const auto& it : results) {
+            if (!it.lines[i].IsNull()) {
+                builder.Add(comp, it.lines[i]);
+                found = true;
+            }
+        }
+        // like a single projection, a set without lines stays null
+        if (found)
+            *lines[i] = comp;
+        else
+            lines[i]->Nullify();
+    }
 }
 
 string ProjectionAlgos::getSVG(ExtractionType type, 
@@ -26,6 +26,7 @@
 # include <Python.h>
 #endif
 
+#include <App/Application.h>
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
 #include <CXX/Extensions.hxx>
@@ -61,6 +62,7 @@
 #include "FemConstraintTransform.h"
 
 #include "FemResultObject.h"
+#include "PropertyResultField.h"
 #include "FemSolverObject.h"
 
 #ifdef FC_USE_VTK
@@ -68,6 +70,7 @@
 #include "FemPostFilter.h"
 #include "FemPostFunction.h"
 #include "PropertyPostDataObject.h"
+#include <vtkSMPTools.h>
 #endif
 
 namespace Fem {
@@ -166,6 +169,9 @@ PyMOD_INIT_FUNC(Fem)
 
     Fem::FemResultObject                      ::init();
     Fem::FemResultObjectPython                ::init();
+    Fem::PropertyResultField                  ::init();
+    Fem::PropertyResultScalarField            ::init();
+    Fem::PropertyResultVectorField            ::init();
 
     Fem::FemSetObject                         ::init();
     Fem::FemSetElementsObject                 ::init();
@@ -193,6 +199,12 @@ PyMOD_INIT_FUNC(Fem)
     Fem::FemPostSphereFunction                ::init();
 
     Fem::PropertyPostDataObject               ::init();
+
+    // the threaded vtk filters (probing, warping, the clipping and cutting of linear
+    // grids) use the SMP backend vtk was built with, 0 lets it pick the thread count
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Fem/General");
+    vtkSMPTools::Initialize(static_cast<int>(hGrp->GetInt("PostThreads", 0)));
 #endif
 
     PyMOD_Return(femModule);
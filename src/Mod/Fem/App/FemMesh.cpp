@@ -24,7 +24,10 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <cstdio>
 # include <cstdlib>
+# include <functional>
 # include <memory>
 # include <Python.h>
 # include <Bnd_Box.hxx>
@@ -38,6 +41,8 @@
 # include <TopoDS_Solid.hxx>
 # include <TopoDS_Shape.hxx>
 # include <ShapeAnalysis_ShapeTolerance.hxx>
+# include <TopExp.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
 
 # include <boost/assign/list_of.hpp>
 # include <boost/tokenizer.hpp> //to simplify parsing input files we use the boost lib
@@ -78,6 +83,7 @@
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/Core/Evaluation.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Part/App/Tools.h>
 
 #include "FemMesh.h"
 #ifdef FC_USE_VTK
@@ -856,49 +862,102 @@ std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face &face) const
     return result;
 }
 
-std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid &solid) const
+// Gets the nodes the mesher has put on shape and its sub-shapes. Returns false if the
+// mesh isn't made from a shape containing shape, e.g. if it has been imported.
+static bool getMesherNodes(SMESH_Mesh* mesh, const TopoDS_Shape& shape, std::set<int>& result)
 {
-    std::set<int> result;
-
-    Bnd_Box box;
-    BRepBndLib::Add(solid, box);
-
-    // limit where the mesh node belongs to the solid
-    TopAbs_ShapeEnum shapetype = TopAbs_SHAPE;
-    ShapeAnalysis_ShapeTolerance analysis;
-    double limit = analysis.Tolerance(solid, 1, shapetype);
-    Base::Console().Log("The limit if a node is in or out: %.12lf in scientific: %.4e \n", limit, limit);
-
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
+    if (!mesh->HasShapeToMesh())
+        return false;
+    SMESHDS_Mesh* meshDS = mesh->GetMeshDS();
+    if (meshDS->ShapeToIndex(shape) == 0)
+        return false;
+
+    // a node is assigned to the sub-shape of the lowest dimension it lies on
+    TopTools_IndexedMapOfShape subShapes;
+    TopExp::MapShapes(shape, subShapes);
+    std::set<int> nodes;
+    for (int i = 1; i <= subShapes.Extent(); i++) {
+        SMESHDS_SubMesh* subMesh = meshDS->MeshElements(subShapes(i));
+        if (!subMesh)
+            continue;
+        SMDS_NodeIteratorPtr aNodeIter = subMesh->GetNodes();
+        while (aNodeIter->more())
+            nodes.insert(aNodeIter->next()->GetID());
+    }
+    if (nodes.empty())
+        return false;
+    result.swap(nodes);
+    return true;
+}
 
-        if (!box.IsOut(gp_Pnt(vec.x,vec.y,vec.z))) {
+// Gets the nodes inside box whose distance to shape is less than limit. The
+// distances are measured in parallel blocks of nodes.
+static std::set<int> getNodesByDistance(const FemMesh& mesh, const TopoDS_Shape& shape,
+                                        const Bnd_Box& box, double limit)
+{
+    std::vector<int> ids;
+    std::vector<Base::Vector3d> points;
+    mesh.getNodeCoordinates(ids, points);
+
+    std::vector<std::size_t> candidates;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (!box.IsOut(gp_Pnt(points[i].x, points[i].y, points[i].z)))
+            candidates.push_back(i);
+    }
+
+    std::vector<char> inside(candidates.size(), 0);
+    const std::size_t blockSize = 256;
+    Part::Tools::parallelFor((candidates.size() + blockSize - 1) / blockSize, [&](std::size_t block) {
+        // the decomposition of shape is done once per block, only the vertex changes
+        BRepExtrema_DistShapeShape measure;
+        measure.LoadS1(shape);
+        std::size_t end = std::min((block + 1) * blockSize, candidates.size());
+        for (std::size_t i = block * blockSize; i < end; i++) {
+            const Base::Vector3d& vec = points[candidates[i]];
             // create a vertex
             BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x,vec.y,vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
+            measure.LoadS2(aBuilder.Vertex());
             // measure distance
-            BRepExtrema_DistShapeShape measure(solid,s);
             measure.Perform();
             if (!measure.IsDone() || measure.NbSolution() < 1)
                 continue;
 
             if (measure.Value() < limit)
-                result.insert(aNode->GetID());
+                inside[i] = 1;
         }
+    });
+
+    std::set<int> result;
+    for (std::size_t i = 0; i < candidates.size(); i++) {
+        if (inside[i])
+            result.insert(result.end(), ids[candidates[i]]);
     }
     return result;
 }
 
+std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid &solid) const
+{
+    std::set<int> result;
+    if (getMesherNodes(myMesh, solid, result))
+        return result;
+
+    Bnd_Box box;
+    BRepBndLib::Add(solid, box);
+
+    // limit where the mesh node belongs to the solid
+    TopAbs_ShapeEnum shapetype = TopAbs_SHAPE;
+    ShapeAnalysis_ShapeTolerance analysis;
+    double limit = analysis.Tolerance(solid, 1, shapetype);
+    Base::Console().Log("The limit if a node is in or out: %.12lf in scientific: %.4e \n", limit, limit);
+
+    return getNodesByDistance(*this, solid, box, limit);
+}
+
 std::set<int> FemMesh::getNodesByFace(const TopoDS_Face &face) const
 {
     std::set<int> result;
+    if (getMesherNodes(myMesh, face, result))
+        return result;
 
     Bnd_Box box;
     BRepBndLib::Add(face, box, Standard_False);  // https://forum.freecadweb.org/viewtopic.php?f=18&t=21571&start=70#p221591
@@ -906,37 +965,14 @@ std::set<int> FemMesh::getNodesByFace(const TopoDS_Face &face) const
     double limit = BRep_Tool::Tolerance(face);
     box.Enlarge(limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x,vec.y,vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x,vec.y,vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(face,s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1)
-                continue;
-
-            if (measure.Value() < limit)
-                result.insert(aNode->GetID());
-        }
-    }
-
-    return result;
+    return getNodesByDistance(*this, face, box, limit);
 }
 
 std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge &edge) const
 {
     std::set<int> result;
+    if (getMesherNodes(myMesh, edge, result))
+        return result;
 
     Bnd_Box box;
     BRepBndLib::Add(edge, box);
@@ -944,54 +980,26 @@ std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge &edge) const
     double limit = BRep_Tool::Tolerance(edge);
     box.Enlarge(limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x,vec.y,vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x,vec.y,vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(edge,s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1)
-                continue;
-
-            if (measure.Value() < limit)
-                result.insert(aNode->GetID());
-        }
-    }
-
-    return result;
+    return getNodesByDistance(*this, edge, box, limit);
 }
 
 std::set<int> FemMesh::getNodesByVertex(const TopoDS_Vertex &vertex) const
 {
     std::set<int> result;
+    if (getMesherNodes(myMesh, vertex, result))
+        return result;
 
     double limit = BRep_Tool::Tolerance(vertex);
     limit *= limit; // use square to improve speed
     gp_Pnt pnt = BRep_Tool::Pnt(vertex);
     Base::Vector3d node(pnt.X(), pnt.Y(), pnt.Z());
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        Base::Vector3d vec(aNode->X(),aNode->Y(),aNode->Z());
-        vec = Mtrx * vec;
-
-        if (Base::DistanceP2(node, vec) <= limit) {
-            result.insert(aNode->GetID());
+    std::vector<int> ids;
+    std::vector<Base::Vector3d> points;
+    getNodeCoordinates(ids, points);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (Base::DistanceP2(node, points[i]) <= limit) {
+            result.insert(result.end(), ids[i]);
         }
     }
 
@@ -1105,6 +1113,77 @@ std::set<int> FemMesh::getFacesOnly(void) const
     return resultIDs;
 }
 
+// number of nodes, elements or output lines one task of the bulk accessors and writers works on
+static const std::size_t bulkBlockSize = 16384;
+
+// calls func(begin, end) for the blocks of [0, count) in parallel
+static void forEachBlock(std::size_t count, const std::function<void(std::size_t, std::size_t)>& func)
+{
+    Part::Tools::parallelFor((count + bulkBlockSize - 1) / bulkBlockSize, [&](std::size_t block) {
+        std::size_t begin = block * bulkBlockSize;
+        func(begin, std::min(begin + bulkBlockSize, count));
+    });
+}
+
+template <typename T>
+static void sortByID(std::vector<const T*>& elements)
+{
+    // SMDS iterates its elements by increasing ID unless the mesh has been renumbered
+    auto byID = [](const T* a, const T* b) { return a->GetID() < b->GetID(); };
+    if (!std::is_sorted(elements.begin(), elements.end(), byID))
+        std::sort(elements.begin(), elements.end(), byID);
+}
+
+void FemMesh::getNodeCoordinates(std::vector<int>& ids, std::vector<Base::Vector3d>& points) const
+{
+    std::vector<const SMDS_MeshNode*> nodes;
+    nodes.reserve(myMesh->GetMeshDS()->NbNodes());
+    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
+    while (aNodeIter->more())
+        nodes.push_back(aNodeIter->next());
+    sortByID(nodes);
+
+    ids.resize(nodes.size());
+    points.resize(nodes.size());
+    // unlike X(), Y() and Z() SMDS_MeshNode::GetXYZ() is thread safe
+    forEachBlock(nodes.size(), [&](std::size_t begin, std::size_t end) {
+        double xyz[3];
+        for (std::size_t i = begin; i < end; i++) {
+            nodes[i]->GetXYZ(xyz);
+            ids[i] = nodes[i]->GetID();
+            points[i] = _Mtrx * Base::Vector3d(xyz[0], xyz[1], xyz[2]);
+        }
+    });
+}
+
+void FemMesh::getConnectivity(SMDSAbs_ElementType type, std::vector<int>& ids,
+                              std::vector<int>& offsets, std::vector<int>& nodes) const
+{
+    std::vector<const SMDS_MeshElement*> elements;
+    elements.reserve(myMesh->GetMeshDS()->GetMeshInfo().NbElements(type));
+    SMDS_ElemIteratorPtr aElemIter = myMesh->GetMeshDS()->elementsIterator(type);
+    while (aElemIter->more())
+        elements.push_back(aElemIter->next());
+    sortByID(elements);
+
+    ids.resize(elements.size());
+    offsets.resize(elements.size() + 1);
+    offsets[0] = 0;
+    for (std::size_t i = 0; i < elements.size(); i++) {
+        ids[i] = elements[i]->GetID();
+        offsets[i+1] = offsets[i] + elements[i]->NbNodes();
+    }
+
+    nodes.resize(offsets.back());
+    forEachBlock(elements.size(), [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            int* elemNodes = &nodes[offsets[i]];
+            for (int j = 0; j < offsets[i+1] - offsets[i]; j++)
+                elemNodes[j] = elements[i]->GetNode(j)->GetID();
+        }
+    });
+}
+
 void FemMesh::readNastran(const std::string &Filename)
 {
     Base::TimeInfo Start;
@@ -1402,6 +1481,37 @@ void FemMesh::read(const char *FileName)
     }
 }
 
+static void appendNumber(std::string& text, int value)
+{
+    char buf[16];
+    text.append(buf, snprintf(buf, sizeof(buf), "%d", value));
+}
+
+static void appendNumber(std::string& text, double value)
+{
+    // same as a stream with a precision of 13
+    char buf[32];
+    text.append(buf, snprintf(buf, sizeof(buf), "%.13g", value));
+}
+
+// formats the lines [0, count) with format(i, text) in parallel blocks and writes them in order
+static void writeLines(std::ostream& out, std::size_t count, const std::function<void(std::size_t, std::string&)>& format)
+{
+    const std::size_t blocksPerRound = 64;
+    std::vector<std::string> blocks(blocksPerRound);
+    for (std::size_t first = 0; first < count; first += blocksPerRound * bulkBlockSize) {
+        std::size_t last = std::min(first + blocksPerRound * bulkBlockSize, count);
+        forEachBlock(last - first, [&](std::size_t begin, std::size_t end) {
+            std::string& text = blocks[begin / bulkBlockSize];
+            text.clear();
+            for (std::size_t i = begin; i < end; i++)
+                format(first + i, text);
+        });
+        for (std::size_t i = 0; i < (last - first + bulkBlockSize - 1) / bulkBlockSize; i++)
+            out.write(blocks[i].data(), blocks[i].size());
+    }
+}
+
 void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool groupParam) const
 {
     /*
@@ -1525,113 +1635,93 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
     }
 
     // get all data --> Extract Nodes and Elements of the current SMESH datastructure
-    typedef std::map<int, Base::Vector3d> VertexMap;
-    typedef std::map<int, std::vector<int> > NodesMap;
-    typedef std::map<std::string, NodesMap> ElementsMap;
+    struct ElementData {
+        std::vector<int> ids;
+        std::vector<int> offsets;
+        std::vector<int> nodes;
+    };
+    // indices of the elements of each ABAQUS element type in their ElementData
+    typedef std::map<std::string, std::vector<std::size_t> > ElementsMap;
+
+    // sorts the elements by their number of nodes into the types of typeMap, if filter is
+    // given only the elements with an ID in filter are used
+    auto sortByType = [](const ElementData& data, const std::map<int, std::string>& typeMap,
+                         const std::set<int>* filter, ElementsMap& elementsMap) {
+        for (std::size_t i = 0; i < data.ids.size(); i++) {
+            if (filter && filter->find(data.ids[i]) == filter->end())
+                continue;
+            std::map<int, std::string>::const_iterator it = typeMap.find(data.offsets[i+1] - data.offsets[i]);
+            if (it != typeMap.end())
+                elementsMap[it->second].push_back(i);
+        }
+    };
 
     // get nodes
-    VertexMap vertexMap;  // empty nodes map
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    Base::Vector3d current_node;
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        current_node.Set(aNode->X(),aNode->Y(),aNode->Z());
-        current_node = _Mtrx * current_node;
-        vertexMap[aNode->GetID()] = current_node;
-    }
+    std::vector<int> nodeIds;
+    std::vector<Base::Vector3d> nodePoints;
+    getNodeCoordinates(nodeIds, nodePoints);
 
     // get volumes
+    ElementData volumes;
     ElementsMap elementsMapVol;  // empty volumes map
-    SMDS_VolumeIteratorPtr aVolIter = myMesh->GetMeshDS()->volumesIterator();
-    while (aVolIter->more()) {
-        const SMDS_MeshVolume* aVol = aVolIter->next();
-        std::pair<int, std::vector<int> > apair;
-        apair.first = aVol->GetID();
-        int numNodes = aVol->NbNodes();
-        std::map<int, std::string>::iterator it = volTypeMap.find(numNodes);
-        if (it != volTypeMap.end()) {
-            const std::vector<int>& order = elemOrderMap[it->second];
-            for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
-                apair.second.push_back(aVol->GetNode(*jt)->GetID());
-            elementsMapVol[it->second].insert(apair);
-        }
-    }
+    getConnectivity(SMDSAbs_Volume, volumes.ids, volumes.offsets, volumes.nodes);
+    sortByType(volumes, volTypeMap, nullptr, elementsMapVol);
 
     //get faces
+    ElementData faces;
     ElementsMap elementsMapFac;  // empty faces map used for elemParam = 1  and elementsMapVol is not empty
     if ((elemParam == 0) || (elemParam == 1 && elementsMapVol.empty())) {
         // for elemParam = 1 we only fill the elementsMapFac if the elmentsMapVol is empty
         // we're going to fill the elementsMapFac with all faces
-        SMDS_FaceIteratorPtr aFaceIter = myMesh->GetMeshDS()->facesIterator();
-        while (aFaceIter->more()) {
-            const SMDS_MeshFace* aFace = aFaceIter->next();
-            std::pair<int, std::vector<int> > apair;
-            apair.first = aFace->GetID();
-            int numNodes = aFace->NbNodes();
-            std::map<int, std::string>::iterator it = faceTypeMap.find(numNodes);
-            if (it != faceTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
-                    apair.second.push_back(aFace->GetNode(*jt)->GetID());
-                elementsMapFac[it->second].insert(apair);
-            }
-        }
+        getConnectivity(SMDSAbs_Face, faces.ids, faces.offsets, faces.nodes);
+        sortByType(faces, faceTypeMap, nullptr, elementsMapFac);
     }
     if (elemParam == 2) {
         // we're going to fill the elementsMapFac with the facesOnly
         std::set<int> facesOnly = getFacesOnly();
-        for (std::set<int>::iterator itfa = facesOnly.begin(); itfa != facesOnly.end(); ++itfa) {
-            std::pair<int, std::vector<int> > apair;
-            apair.first = *itfa;
-            const SMDS_MeshElement* aFace = myMesh->GetMeshDS()->FindElement(*itfa);
-            int numNodes = aFace->NbNodes();
-            std::map<int, std::string>::iterator it = faceTypeMap.find(numNodes);
-            if (it != faceTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
-                    apair.second.push_back(aFace->GetNode(*jt)->GetID());
-                elementsMapFac[it->second].insert(apair);
-            }
-        }
+        getConnectivity(SMDSAbs_Face, faces.ids, faces.offsets, faces.nodes);
+        sortByType(faces, faceTypeMap, &facesOnly, elementsMapFac);
     }
 
     // get edges
+    ElementData edges;
     ElementsMap elementsMapEdg;  // empty edges map used for elemParam == 1 and either elementMapVol or elementsMapFac are not empty
     if ((elemParam == 0) || (elemParam == 1 && elementsMapVol.empty() && elementsMapFac.empty())) {
         // for elemParam = 1 we only fill the elementsMapEdg if the elmentsMapVol and elmentsMapFac are empty
         // we're going to fill the elementsMapEdg with all edges
-        SMDS_EdgeIteratorPtr aEdgeIter = myMesh->GetMeshDS()->edgesIterator();
-        while (aEdgeIter->more()) {
-            const SMDS_MeshEdge* aEdge = aEdgeIter->next();
-            std::pair<int, std::vector<int> > apair;
-            apair.first = aEdge->GetID();
-            int numNodes = aEdge->NbNodes();
-            std::map<int, std::string>::iterator it = edgeTypeMap.find(numNodes);
-            if (it != edgeTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
-                    apair.second.push_back(aEdge->GetNode(*jt)->GetID());
-                elementsMapEdg[it->second].insert(apair);
-            }
-        }
+        getConnectivity(SMDSAbs_Edge, edges.ids, edges.offsets, edges.nodes);
+        sortByType(edges, edgeTypeMap, nullptr, elementsMapEdg);
     }
     if (elemParam == 2) {
         // we're going to fill the elementsMapEdg with the edgesOnly
         std::set<int> edgesOnly = getEdgesOnly();
-        for (std::set<int>::iterator ited = edgesOnly.begin(); ited != edgesOnly.end(); ++ited) {
-            std::pair<int, std::vector<int> > apair;
-            apair.first = *ited;
-            const SMDS_MeshElement* aEdge = myMesh->GetMeshDS()->FindElement(*ited);
-            int numNodes = aEdge->NbNodes();
-            std::map<int, std::string>::iterator it = edgeTypeMap.find(numNodes);
-            if (it != edgeTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (std::vector<int>::const_iterator jt = order.begin(); jt != order.end(); ++jt)
-                    apair.second.push_back(aEdge->GetNode(*jt)->GetID());
-                elementsMapEdg[it->second].insert(apair);
+        getConnectivity(SMDSAbs_Edge, edges.ids, edges.offsets, edges.nodes);
+        sortByType(edges, edgeTypeMap, &edgesOnly, elementsMapEdg);
+    }
+
+    // writes the elements of one type with their nodes in the order of elemOrderMap
+    auto writeElements = [](std::ostream& out, const ElementData& data, const std::vector<std::size_t>& elements,
+                            const std::vector<int>& order, bool wrapLines) {
+        writeLines(out, elements.size(), [&](std::size_t k, std::string& text) {
+            std::size_t i = elements[k];
+            const int* elemNodes = &data.nodes[data.offsets[i]];
+            appendNumber(text, data.ids[i]);
+            // Calculix allows max 16 entries in one line, a hexa20 has more !
+            for (std::size_t ct = 0; ct < order.size(); ++ct) {
+                if (!wrapLines || ct < 15) {
+                    text += ", ";
+                    appendNumber(text, elemNodes[order[ct]]);
+                }
+                else {
+                    if (ct == 15)
+                        text += ",\n";
+                    appendNumber(text, elemNodes[order[ct]]);
+                    text += ", ";
+                }
             }
-        }
-    }
+            text += '\n';
+        });
+    };
 
     // write all data to file
     // take also care of special characters in path https://forum.freecadweb.org/viewtopic.php?f=10&t=37436
@@ -1656,12 +1746,16 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
     anABAQUS_Output << "*Node, NSET=Nall" << std::endl;
     // This way we get sorted output.
     // See http://forum.freecadweb.org/viewtopic.php?f=18&t=12646&start=40#p103004
-    for (VertexMap::iterator it = vertexMap.begin(); it != vertexMap.end(); ++it) {
-        anABAQUS_Output << it->first << ", "
-            << it->second.x << ", "
-            << it->second.y << ", "
-            << it->second.z << std::endl;
-    }
+    writeLines(anABAQUS_Output, nodeIds.size(), [&](std::size_t i, std::string& text) {
+        appendNumber(text, nodeIds[i]);
+        text += ", ";
+        appendNumber(text, nodePoints[i].x);
+        text += ", ";
+        appendNumber(text, nodePoints[i].y);
+        text += ", ";
+        appendNumber(text, nodePoints[i].z);
+        text += '\n';
+    });
     anABAQUS_Output << std::endl << std::endl;;
 
 
@@ -1671,25 +1765,7 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
         for (ElementsMap::iterator it = elementsMapVol.begin(); it != elementsMapVol.end(); ++it) {
             anABAQUS_Output << "** Volume elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it->first << ", ELSET=Evolumes" << std::endl;
-            for (NodesMap::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
-                anABAQUS_Output << jt->first;
-                // Calculix allows max 16 entries in one line, a hexa20 has more !
-                int ct = 0;  // counter
-                bool first_line = true;
-                for (std::vector<int>::iterator kt = jt->second.begin(); kt != jt->second.end(); ++kt, ++ct) {
-                    if (ct < 15) {
-                        anABAQUS_Output  << ", " << *kt;
-                    }
-                    else {
-                        if (first_line == true) {
-                            anABAQUS_Output << "," << std::endl;
-                            first_line = false;
-                        }
-                        anABAQUS_Output << *kt << ", ";
-                    }
-                }
-                anABAQUS_Output << std::endl;
-            }
+            writeElements(anABAQUS_Output, volumes, it->second, elemOrderMap[it->first], true);
         }
         elsetname += "Evolumes";
         anABAQUS_Output << std::endl;
@@ -1700,13 +1776,7 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
         for (ElementsMap::iterator it = elementsMapFac.begin(); it != elementsMapFac.end(); ++it) {
             anABAQUS_Output << "** Face elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it->first << ", ELSET=Efaces" << std::endl;
-            for (NodesMap::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
-                anABAQUS_Output << jt->first;
-                for (std::vector<int>::iterator kt = jt->second.begin(); kt != jt->second.end(); ++kt) {
-                    anABAQUS_Output << ", " << *kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
+            writeElements(anABAQUS_Output, faces, it->second, elemOrderMap[it->first], false);
         }
         if (elsetname == "")
             elsetname += "Efaces";
@@ -1720,13 +1790,7 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
         for (ElementsMap::iterator it = elementsMapEdg.begin(); it != elementsMapEdg.end(); ++it) {
             anABAQUS_Output << "** Edge elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it->first << ", ELSET=Eedges" << std::endl;
-            for (NodesMap::iterator jt = it->second.begin(); jt != it->second.end(); ++jt) {
-                anABAQUS_Output << jt->first;
-                for (std::vector<int>::iterator kt = jt->second.begin(); kt != jt->second.end(); ++kt) {
-                    anABAQUS_Output << ", " << *kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
+            writeElements(anABAQUS_Output, edges, it->second, elemOrderMap[it->first], false);
         }
         if (elsetname == "")
             elsetname += "Eedges";
@@ -1783,7 +1847,7 @@ void FemMesh::writeABAQUS(const std::string &Filename, int elemParam, bool group
                 ids.insert(aElement->GetID());
             }
             for (std::set<int>::iterator it = ids.begin(); it != ids.end(); ++it) {
-                anABAQUS_Output << *it << std::endl;
+                anABAQUS_Output << *it << '\n';
             }
 
             // write newline after each group
@@ -1876,7 +1940,16 @@ void FemMesh::write(const char *FileName) const
 
 unsigned int FemMesh::getMemSize (void) const
 {
-    return 0;
+    // estimated from the nodes and the node pointers the elements keep
+    const SMESHDS_Mesh* meshDS = myMesh->GetMeshDS();
+    unsigned long size = sizeof(SMESH_Mesh) + sizeof(SMESHDS_Mesh);
+    size += meshDS->NbNodes() * sizeof(SMDS_MeshNode);
+    SMDS_ElemIteratorPtr it = meshDS->elementsIterator();
+    while (it->more()) {
+        const SMDS_MeshElement* elem = it->next();
+        size += sizeof(SMDS_MeshElement) + elem->NbNodes() * sizeof(SMDS_MeshNode*);
+    }
+    return static_cast<unsigned int>(size);
 }
 
 void FemMesh::Save (Base::Writer &writer) const
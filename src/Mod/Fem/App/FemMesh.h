@@ -114,6 +114,17 @@ public:
     std::set<int> getFacesOnly(void) const;
      //@}
 
+    /** @name Bulk access */
+    //@{
+    /// retrieving IDs and coordinates of all nodes sorted by ID, the placement is applied
+    void getNodeCoordinates(std::vector<int>& ids, std::vector<Base::Vector3d>& points) const;
+    /** retrieving IDs and node IDs of all elements of a type sorted by ID,
+     *  the nodes of the i-th element are nodes[offsets[i]] to nodes[offsets[i+1]-1]
+     */
+    void getConnectivity(SMDSAbs_ElementType type, std::vector<int>& ids,
+                         std::vector<int>& offsets, std::vector<int>& nodes) const;
+    //@}
+
     /** @name Placement control */
     //@{
     /// set the transformation
@@ -66,6 +66,7 @@ FemMeshShapeNetgenObject::FemMeshShapeNetgenObject()
     ADD_PROPERTY_TYPE(NbSegsPerEdge,(1),    "MeshParams",Prop_None,"allows to define the minimum number of mesh segments in which edges will be split");
     ADD_PROPERTY_TYPE(NbSegsPerRadius,(2),  "MeshParams",Prop_None,"allows to define the minimum number of mesh segments in which radiuses will be split");
     ADD_PROPERTY_TYPE(Optimize,(true),      "MeshParams",Prop_None,"Optimize the resulting mesh");
+    ADD_PROPERTY_TYPE(ParallelMeshing,(false),"MeshParams",Prop_None,"Mesh the volumes of the solids in parallel (needs netgen 6.2.2102 or newer)");
 
 }
 
@@ -99,6 +100,7 @@ App::DocumentObjectExecReturn *FemMeshShapeNetgenObject::execute(void)
         tet->SetNbSegPerRadius(NbSegsPerRadius.getValue());
     }
     myNetGenMesher.SetParameters( tet);
+    myNetGenMesher.SetParallelMeshing(ParallelMeshing.getValue());
     newMesh.getSMesh()->ShapeToMesh(shape);
 
     myNetGenMesher.Compute();
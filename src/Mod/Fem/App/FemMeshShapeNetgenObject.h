@@ -48,6 +48,7 @@ public:
     App::PropertyInteger        NbSegsPerEdge;
     App::PropertyInteger        NbSegsPerRadius;
     App::PropertyBool           Optimize;
+    App::PropertyBool           ParallelMeshing;
 
     /// returns the type name of the ViewProvider
     virtual const char* getViewProviderName(void) const {
@@ -43,6 +43,8 @@ PROPERTY_SOURCE(Fem::FemPostFilter, Fem::FemPostObject)
 
 
 FemPostFilter::FemPostFilter()
+    : m_dataOutdated(false)
+    , m_updatingData(false)
 {
     ADD_PROPERTY(Input,(0));
 }
@@ -67,8 +69,56 @@ void FemPostFilter::setActiveFilterPipeline(std::string name) {
     }
 }
 
+bool FemPostFilter::isDataRequired(void) const {
+
+    return Visibility.getValue();
+}
+
+bool FemPostFilter::skipExecute(void) {
+
+    if(m_updatingData || isDataRequired()) {
+        m_dataOutdated = false;
+        return false;
+    }
+    m_dataOutdated = true;
+    return true;
+}
+
+void FemPostFilter::updateData(void) {
+
+    if(!m_dataOutdated || m_updatingData)
+        return;
+
+    // the data isn't a result of a recompute, so it must not touch the filter
+    bool touched = isTouched();
+    m_updatingData = true;
+    try {
+        execute();
+    }
+    catch (...) {
+        m_updatingData = false;
+        throw;
+    }
+    m_updatingData = false;
+    m_dataOutdated = false;
+    if(!touched)
+        purgeTouched();
+}
+
+void FemPostFilter::onChanged(const Property* prop) {
+
+    if(prop == &Visibility && Visibility.getValue() && m_dataOutdated
+            && !isRestoring() && getDocument() && !getDocument()->isPerformingTransaction()) {
+        updateData();
+    }
+    Fem::FemPostObject::onChanged(prop);
+}
+
 DocumentObjectExecReturn* FemPostFilter::execute(void) {
 
+    if(skipExecute())
+        return StdReturn;
+
     if(!m_pipelines.empty() && !m_activePipeline.empty()) {
         FemPostFilter::FilterPipeline& pipe = m_pipelines[m_activePipeline];
         if (m_activePipeline.length() >= 11) {
@@ -93,6 +143,8 @@ DocumentObjectExecReturn* FemPostFilter::execute(void) {
 vtkDataObject* FemPostFilter::getInputData() {
 
     if(Input.getValue()) {
+        if(Input.getValue()->isDerivedFrom(FemPostFilter::getClassTypeId()))
+            Input.getValue<FemPostFilter*>()->updateData();
         return Input.getValue<FemPostObject*>()->Data.getValue();
     }
     else {
@@ -422,6 +474,9 @@ FemPostScalarClipFilter::~FemPostScalarClipFilter() {
 
 DocumentObjectExecReturn* FemPostScalarClipFilter::execute(void) {
 
+    if(skipExecute())
+        return StdReturn;
+
     std::string val;
     if(m_scalarFields.getEnums() && Scalars.getValue() >= 0)
         val = Scalars.getValueAsString();
@@ -521,6 +576,9 @@ FemPostWarpVectorFilter::~FemPostWarpVectorFilter() {
 
 DocumentObjectExecReturn* FemPostWarpVectorFilter::execute(void) {
 
+    if(skipExecute())
+        return StdReturn;
+
     std::string val;
     if(m_vectorFields.getEnums() && Vector.getValue() >= 0)
         val = Vector.getValueAsString();
@@ -56,9 +56,21 @@ public:
 
     virtual App::DocumentObjectExecReturn* execute(void);
 
+    /// runs the pipeline of the filter if it has been skipped by the last execute
+    void updateData(void);
+
 protected:
+    virtual void onChanged(const App::Property* prop);
     vtkDataObject* getInputData();
 
+    /** The output of a filter which isn't shown is only computed once it is shown
+     *  or used by another filter. Filters whose output is used while they are
+     *  hidden return true.
+     */
+    virtual bool isDataRequired(void) const;
+    /// returns true and marks the data outdated if execute can be skipped
+    bool skipExecute(void);
+
     //pipeline handling for derived filter
     struct FilterPipeline {
        vtkSmartPointer<vtkAlgorithm>                    source, target;
@@ -73,6 +85,8 @@ private:
     //handling of multiple pipelines which can be the filter
     std::map<std::string, FilterPipeline> m_pipelines;
     std::string m_activePipeline;
+    bool m_dataOutdated;
+    bool m_updatingData;
 };
 
 class AppFemExport FemPostClipFilter : public FemPostFilter {
@@ -124,6 +138,8 @@ public:
 protected:
     virtual App::DocumentObjectExecReturn* execute(void);
     virtual void onChanged(const App::Property* prop);
+    // the plot data is used while the filter is hidden
+    virtual bool isDataRequired(void) const { return true; }
     void GetAxisData();
 
 private:
@@ -155,6 +171,8 @@ public:
 protected:
     virtual App::DocumentObjectExecReturn* execute(void);
     virtual void onChanged(const App::Property* prop);
+    // the point data is used while the filter is hidden
+    virtual bool isDataRequired(void) const { return true; }
     void GetPointData();
 
 private:
@@ -93,7 +93,10 @@ DocumentObjectExecReturn* FemPostPipeline::execute(void) {
     if(Mode.getValue() == 0) {
 
         //serial
-        Data.setValue(getLastPostObject()->Data.getValue());
+        FemPostObject* last = getLastPostObject();
+        if(last->isDerivedFrom(FemPostFilter::getClassTypeId()))
+            static_cast<FemPostFilter*>(last)->updateData();
+        Data.setValue(last->Data.getValue());
     }
     else {
 
@@ -104,6 +107,8 @@ DocumentObjectExecReturn* FemPostPipeline::execute(void) {
         vtkSmartPointer<vtkAppendFilter> append = vtkSmartPointer<vtkAppendFilter>::New();
         for(;it != filters.end(); ++it) {
 
+            if((*it)->isDerivedFrom(FemPostFilter::getClassTypeId()))
+                static_cast<FemPostFilter*>(*it)->updateData();
             append->AddInputDataObject(static_cast<FemPostObject*>(*it)->Data.getValue());
         }
 
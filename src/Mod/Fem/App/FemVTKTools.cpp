@@ -26,7 +26,9 @@
 
 #ifndef _PreComp_
 # include <Python.h>
+# include <algorithm>
 # include <cstdlib>
+# include <functional>
 # include <memory>
 # include <cmath>
 # include <map>
@@ -60,20 +62,10 @@
 # include <vtkCellArray.h>
 # include <vtkDataArray.h>
 # include <vtkDoubleArray.h>
+# include <vtkFloatArray.h>
 # include <vtkIdList.h>
+# include <vtkIdTypeArray.h>
 # include <vtkCellTypes.h>
-# include <vtkTriangle.h>
-# include <vtkQuad.h>
-# include <vtkQuadraticTriangle.h>
-# include <vtkQuadraticQuad.h>
-# include <vtkTetra.h>
-# include <vtkPyramid.h>
-# include <vtkWedge.h>
-# include <vtkHexahedron.h>
-# include <vtkQuadraticTetra.h>
-# include <vtkQuadraticPyramid.h>
-# include <vtkQuadraticWedge.h>
-# include <vtkQuadraticHexahedron.h>
 #endif
 
 #include <Base/FileInfo.h>
@@ -86,8 +78,11 @@
 #include <App/Document.h>
 #include <App/DocumentObject.h>
 
+#include <Mod/Part/App/Tools.h>
+
 #include "FemVTKTools.h"
 #include "FemMeshProperty.h"
+#include "PropertyResultField.h"
 #include "FemAnalysis.h"
 
 namespace Fem
@@ -112,6 +107,23 @@ template<class TWriter> void writeVTKFile(const char* filename, vtkSmartPointer<
   writer->Write();
 }
 
+// number of nodes, cells or values one task of the bulk conversions works on
+static const vtkIdType conversionChunk = 65536;
+
+static std::size_t numConversionChunks(vtkIdType count)
+{
+    return static_cast<std::size_t>((count + conversionChunk - 1) / conversionChunk);
+}
+
+// calls func(chunk, begin, end) for the chunks of [0, count) in parallel
+static void forEachChunk(vtkIdType count, const std::function<void(std::size_t, vtkIdType, vtkIdType)>& func)
+{
+    Part::Tools::parallelFor(numConversionChunks(count), [&](std::size_t chunk) {
+        vtkIdType begin = static_cast<vtkIdType>(chunk) * conversionChunk;
+        func(chunk, begin, std::min(begin + conversionChunk, count));
+    });
+}
+
 
 void FemVTKTools::importVTKMesh(vtkSmartPointer<vtkDataSet> dataset, FemMesh* mesh, float scale)
 {
@@ -120,79 +132,111 @@ void FemVTKTools::importVTKMesh(vtkSmartPointer<vtkDataSet> dataset, FemMesh* me
     Base::Console().Log("%d nodes/points and %d cells/elements found!\n", nPoints, nCells);
     Base::Console().Log("Build SMESH mesh out of the vtk mesh data.\n", nPoints, nCells);
 
-    //vtkSmartPointer<vtkCellArray> cells = dataset->GetCells();  // works only for vtkUnstructuredGrid
-    vtkSmartPointer<vtkIdList> idlist= vtkSmartPointer<vtkIdList>::New();
+    // The SMESH data structure can only be filled from one thread, but the connectivity of the
+    // vtk cells is collected in parallel chunks first. vtkDataSet::GetCellPoints() is thread
+    // safe once it has been called from a single thread.
+    struct CellChunk {
+        std::vector<int> types;
+        std::vector<int> sizes;
+        std::vector<int> nodes;  // SMESH node ids, i.e. vtk point ids + 1
+    };
+    std::vector<CellChunk> chunks(numConversionChunks(nCells));
+    if (nCells > 0) {
+        vtkSmartPointer<vtkIdList> idlist = vtkSmartPointer<vtkIdList>::New();
+        dataset->GetCellType(0);
+        dataset->GetCellPoints(0, idlist);
+    }
+    forEachChunk(nCells, [&](std::size_t c, vtkIdType begin, vtkIdType end) {
+        CellChunk& chunk = chunks[c];
+        chunk.types.reserve(end - begin);
+        chunk.sizes.reserve(end - begin);
+        vtkSmartPointer<vtkIdList> idlist = vtkSmartPointer<vtkIdList>::New();
+        for (vtkIdType iCell=begin; iCell<end; iCell++) {
+            dataset->GetCellPoints(iCell, idlist);
+            const vtkIdType nIds = idlist->GetNumberOfIds();
+            chunk.types.push_back(dataset->GetCellType(iCell));
+            chunk.sizes.push_back(static_cast<int>(nIds));
+            for (vtkIdType j=0; j<nIds; j++)
+                chunk.nodes.push_back(static_cast<int>(idlist->GetId(j) + 1));
+        }
+    });
 
     //Now fill the SMESH datastructure
     SMESH_Mesh* smesh = const_cast<SMESH_Mesh*>(mesh->getSMesh());
     SMESHDS_Mesh* meshds = smesh->GetMeshDS();
     meshds->ClearMesh();
+    // the node coordinates go to the vtk points of the SMESH grid, reserve them at once
+    meshds->getGrid()->GetPoints()->Allocate(nPoints);
 
+    double p[3];
     for(vtkIdType i=0; i<nPoints; i++)
     {
-        double* p = dataset->GetPoint(i);
+        dataset->GetPoint(i, p);
         meshds->AddNodeWithID(p[0]*scale, p[1]*scale, p[2]*scale, i+1);
     }
 
-    for(vtkIdType iCell=0; iCell<nCells; iCell++)
+    int iCell = 0;
+    for(const CellChunk& chunk : chunks)
     {
-        idlist->Reset();
-        idlist = dataset->GetCell(iCell)->GetPointIds();
-        vtkIdType *ids = idlist->GetPointer(0);
-        switch(dataset->GetCellType(iCell))
+        const int* ids = chunk.nodes.data();
+        for(std::size_t i=0; i<chunk.types.size(); ids += chunk.sizes[i], i++)
         {
-            // 2D faces
-            case VTK_TRIANGLE:  // tria3
-                meshds->AddFaceWithID(ids[0]+1, ids[1]+1, ids[2]+1, iCell+1);
-                break;
-            case VTK_QUADRATIC_TRIANGLE:  // tria6
-                meshds->AddFaceWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, ids[4]+1, ids[5]+1, iCell+1);
-                break;
-            case VTK_QUAD:  // quad4
-                meshds->AddFaceWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, iCell+1);
-                break;
-            case VTK_QUADRATIC_QUAD:  // quad8
-                meshds->AddFaceWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, ids[4]+1, ids[5]+1, ids[6]+1, ids[7]+1, iCell+1);
-                break;
-
-            // 3D volumes
-            case VTK_TETRA:  // tetra4
-                meshds->AddVolumeWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, iCell+1);
-                break;
-            case VTK_QUADRATIC_TETRA:  // tetra10
-                meshds->AddVolumeWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, ids[4]+1, ids[5]+1, ids[6]+1, ids[7]+1, ids[8]+1, ids[9]+1, iCell+1);
-                break;
-            case VTK_HEXAHEDRON:  // hexa8
-                meshds->AddVolumeWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, ids[4]+1, ids[5]+1, ids[6]+1, ids[7]+1, iCell+1);
-                break;
-            case VTK_QUADRATIC_HEXAHEDRON:  // hexa20
-                meshds->AddVolumeWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, ids[4]+1, ids[5]+1, ids[6]+1, ids[7]+1, ids[8]+1, ids[9]+1,\
-                                        ids[10]+1, ids[11]+1, ids[12]+1, ids[13]+1, ids[14]+1, ids[15]+1, ids[16]+1, ids[17]+1, ids[18]+1, ids[19]+1,\
-                                        iCell+1);
-                break;
-            case VTK_WEDGE:  // penta6
-                meshds->AddVolumeWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, ids[4]+1, ids[5]+1, iCell+1);
-                break;
-            case VTK_QUADRATIC_WEDGE:  // penta15
-                meshds->AddVolumeWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, ids[4]+1, ids[5]+1, ids[6]+1, ids[7]+1, ids[8]+1, ids[9]+1,\
-                                        ids[10]+1, ids[11]+1, ids[12]+1, ids[13]+1, ids[14]+1,\
-                                        iCell+1);
-                break;
-            case VTK_PYRAMID:  // pyra5
-                meshds->AddVolumeWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, ids[4]+1, iCell+1);
-                break;
-            case VTK_QUADRATIC_PYRAMID:  // pyra13
-                meshds->AddVolumeWithID(ids[0]+1, ids[1]+1, ids[2]+1, ids[3]+1, ids[4]+1, ids[5]+1, ids[6]+1, ids[7]+1, ids[8]+1, ids[9]+1,\
-                                        ids[10]+1, ids[11]+1, ids[12]+1,\
-                                        iCell+1);
-                break;
-
-            // not handled cases
-            default:
+            iCell++;
+            switch(chunk.types[i])
             {
-                Base::Console().Error("Only common 2D and 3D Cells are supported in VTK mesh import\n");
-                break;
+                // 2D faces
+                case VTK_TRIANGLE:  // tria3
+                    meshds->AddFaceWithID(ids[0], ids[1], ids[2], iCell);
+                    break;
+                case VTK_QUADRATIC_TRIANGLE:  // tria6
+                    meshds->AddFaceWithID(ids[0], ids[1], ids[2], ids[3], ids[4], ids[5], iCell);
+                    break;
+                case VTK_QUAD:  // quad4
+                    meshds->AddFaceWithID(ids[0], ids[1], ids[2], ids[3], iCell);
+                    break;
+                case VTK_QUADRATIC_QUAD:  // quad8
+                    meshds->AddFaceWithID(ids[0], ids[1], ids[2], ids[3], ids[4], ids[5], ids[6], ids[7], iCell);
+                    break;
+
+                // 3D volumes
+                case VTK_TETRA:  // tetra4
+                    meshds->AddVolumeWithID(ids[0], ids[1], ids[2], ids[3], iCell);
+                    break;
+                case VTK_QUADRATIC_TETRA:  // tetra10
+                    meshds->AddVolumeWithID(ids[0], ids[1], ids[2], ids[3], ids[4], ids[5], ids[6], ids[7], ids[8], ids[9], iCell);
+                    break;
+                case VTK_HEXAHEDRON:  // hexa8
+                    meshds->AddVolumeWithID(ids[0], ids[1], ids[2], ids[3], ids[4], ids[5], ids[6], ids[7], iCell);
+                    break;
+                case VTK_QUADRATIC_HEXAHEDRON:  // hexa20
+                    meshds->AddVolumeWithID(ids[0], ids[1], ids[2], ids[3], ids[4], ids[5], ids[6], ids[7], ids[8], ids[9],\
+                                            ids[10], ids[11], ids[12], ids[13], ids[14], ids[15], ids[16], ids[17], ids[18], ids[19],\
+                                            iCell);
+                    break;
+                case VTK_WEDGE:  // penta6
+                    meshds->AddVolumeWithID(ids[0], ids[1], ids[2], ids[3], ids[4], ids[5], iCell);
+                    break;
+                case VTK_QUADRATIC_WEDGE:  // penta15
+                    meshds->AddVolumeWithID(ids[0], ids[1], ids[2], ids[3], ids[4], ids[5], ids[6], ids[7], ids[8], ids[9],\
+                                            ids[10], ids[11], ids[12], ids[13], ids[14],\
+                                            iCell);
+                    break;
+                case VTK_PYRAMID:  // pyra5
+                    meshds->AddVolumeWithID(ids[0], ids[1], ids[2], ids[3], ids[4], iCell);
+                    break;
+                case VTK_QUADRATIC_PYRAMID:  // pyra13
+                    meshds->AddVolumeWithID(ids[0], ids[1], ids[2], ids[3], ids[4], ids[5], ids[6], ids[7], ids[8], ids[9],\
+                                            ids[10], ids[11], ids[12],\
+                                            iCell);
+                    break;
+
+                // not handled cases
+                default:
+                {
+                    Base::Console().Error("Only common 2D and 3D Cells are supported in VTK mesh import\n");
+                    break;
 
+                }
             }
         }
     }
@@ -225,83 +269,69 @@ FemMesh* FemVTKTools::readVTKMesh(const char* filename, FemMesh* mesh)
     return mesh;
 }
 
-void exportFemMeshFaces(vtkSmartPointer<vtkUnstructuredGrid> grid, const SMDS_FaceIteratorPtr& aFaceIter)
+// Converts the connectivity of SMESH elements to vtk cells. cellTypes maps the number of nodes
+// of an element to its vtk cell type, the cell arrays are set in the order of this map.
+// The node ids of the elements are read in parallel chunks straight into the cell arrays.
+static void exportFemMeshElements(vtkSmartPointer<vtkUnstructuredGrid> grid,
+                                  const std::vector<const SMDS_MeshElement*>& elements,
+                                  const std::map<int, int>& cellTypes,
+                                  const char* error)
 {
-    Base::Console().Log("  Start: VTK mesh builder faces.\n");
-
-    vtkSmartPointer<vtkCellArray> triangleArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadTriangleArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadQuadArray = vtkSmartPointer<vtkCellArray>::New();
-
-    for (;aFaceIter->more();)
-    {
-        const SMDS_MeshFace* aFace = aFaceIter->next();
-
-        //triangle
-        if(aFace->NbNodes() == 3)
-        {
-            vtkSmartPointer<vtkTriangle> tria = vtkSmartPointer<vtkTriangle>::New();
-            tria->GetPointIds()->SetId(0, aFace->GetNode(0)->GetID()-1);
-            tria->GetPointIds()->SetId(1, aFace->GetNode(1)->GetID()-1);
-            tria->GetPointIds()->SetId(2, aFace->GetNode(2)->GetID()-1);
-
-            triangleArray->InsertNextCell(tria);
+    // position of each element in the cell array of its type
+    std::map<int, vtkIdType> counts;
+    std::vector<int> nbNodes(elements.size());
+    std::vector<vtkIdType> index(elements.size());
+    for (std::size_t i=0; i<elements.size(); i++) {
+        nbNodes[i] = elements[i]->NbNodes();
+        if (cellTypes.find(nbNodes[i]) == cellTypes.end())
+            throw std::runtime_error(error);
+        index[i] = counts[nbNodes[i]]++;
+    }
+
+    // the arrays have the legacy layout (npts, id0, id1, ...) of vtkCellArray
+    std::map<int, vtkSmartPointer<vtkIdTypeArray> > arrays;
+    std::map<int, vtkIdType*> connectivity;
+    for (auto it : counts) {
+        vtkSmartPointer<vtkIdTypeArray> array = vtkSmartPointer<vtkIdTypeArray>::New();
+        array->SetNumberOfValues(it.second * (it.first + 1));
+        arrays[it.first] = array;
+        connectivity[it.first] = array->GetPointer(0);
+    }
+
+    forEachChunk(static_cast<vtkIdType>(elements.size()), [&](std::size_t, vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i=begin; i<end; i++) {
+            const int n = nbNodes[i];
+            vtkIdType* cell = connectivity.at(n) + index[i] * (n + 1);
+            cell[0] = n;
+            for (int j=0; j<n; j++)
+                cell[j+1] = elements[i]->GetNode(j)->GetID()-1;
         }
-        //quad
-        else if(aFace->NbNodes() == 4)
-        {
-            vtkSmartPointer<vtkQuad> quad = vtkSmartPointer<vtkQuad>::New();
-            quad->GetPointIds()->SetId(0, aFace->GetNode(0)->GetID()-1);
-            quad->GetPointIds()->SetId(1, aFace->GetNode(1)->GetID()-1);
-            quad->GetPointIds()->SetId(2, aFace->GetNode(2)->GetID()-1);
-            quad->GetPointIds()->SetId(3, aFace->GetNode(3)->GetID()-1);
+    });
 
-            quadArray->InsertNextCell(quad);
-        }
-        //quadratic triangle
-        else if (aFace->NbNodes() == 6)
-        {
-            vtkSmartPointer<vtkQuadraticTriangle> tria = vtkSmartPointer<vtkQuadraticTriangle>::New();
-            tria->GetPointIds()->SetId(0, aFace->GetNode(0)->GetID()-1);
-            tria->GetPointIds()->SetId(1, aFace->GetNode(1)->GetID()-1);
-            tria->GetPointIds()->SetId(2, aFace->GetNode(2)->GetID()-1);
-            tria->GetPointIds()->SetId(3, aFace->GetNode(3)->GetID()-1);
-            tria->GetPointIds()->SetId(4, aFace->GetNode(4)->GetID()-1);
-            tria->GetPointIds()->SetId(5, aFace->GetNode(5)->GetID()-1);
-            quadTriangleArray->InsertNextCell(tria);
-        }
-        //quadratic quad
-        else if(aFace->NbNodes() == 8)
-        {
-            vtkSmartPointer<vtkQuadraticQuad> quad = vtkSmartPointer<vtkQuadraticQuad>::New();
-            quad->GetPointIds()->SetId(0, aFace->GetNode(0)->GetID()-1);
-            quad->GetPointIds()->SetId(1, aFace->GetNode(1)->GetID()-1);
-            quad->GetPointIds()->SetId(2, aFace->GetNode(2)->GetID()-1);
-            quad->GetPointIds()->SetId(3, aFace->GetNode(3)->GetID()-1);
-            quad->GetPointIds()->SetId(4, aFace->GetNode(4)->GetID()-1);
-            quad->GetPointIds()->SetId(5, aFace->GetNode(5)->GetID()-1);
-            quad->GetPointIds()->SetId(6, aFace->GetNode(6)->GetID()-1);
-            quad->GetPointIds()->SetId(7, aFace->GetNode(7)->GetID()-1);
-
-            quadQuadArray->InsertNextCell(quad);
-        }
-        else
-        {
-            throw std::runtime_error("Face not yet supported by FreeCAD's VTK mesh builder\n");
-        }
+    for (auto it : cellTypes) {
+        auto jt = counts.find(it.first);
+        if (jt == counts.end())
+            continue;
+        vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+        cells->SetCells(jt->second, arrays[it.first]);
+        grid->SetCells(it.second, cells);
     }
-    if(triangleArray->GetNumberOfCells()>0)
-       grid->SetCells(VTK_TRIANGLE, triangleArray);
+}
 
-    if(quadArray->GetNumberOfCells()>0)
-       grid->SetCells(VTK_QUAD, quadArray);
+void exportFemMeshFaces(vtkSmartPointer<vtkUnstructuredGrid> grid, const SMDS_FaceIteratorPtr& aFaceIter)
+{
+    Base::Console().Log("  Start: VTK mesh builder faces.\n");
 
-    if(quadTriangleArray->GetNumberOfCells()>0)
-       grid->SetCells(VTK_QUADRATIC_TRIANGLE, quadTriangleArray);
+    std::vector<const SMDS_MeshElement*> faces;
+    for (;aFaceIter->more();)
+        faces.push_back(aFaceIter->next());
 
-    if(quadQuadArray->GetNumberOfCells()>0)
-       grid->SetCells(VTK_QUADRATIC_QUAD, quadQuadArray);
+    std::map<int, int> cellTypes;
+    cellTypes[3] = VTK_TRIANGLE;
+    cellTypes[4] = VTK_QUAD;
+    cellTypes[6] = VTK_QUADRATIC_TRIANGLE;
+    cellTypes[8] = VTK_QUADRATIC_QUAD;
+    exportFemMeshElements(grid, faces, cellTypes, "Face not yet supported by FreeCAD's VTK mesh builder\n");
 
     Base::Console().Log("  End: VTK mesh builder faces.\n");
 }
@@ -310,124 +340,20 @@ void exportFemMeshCells(vtkSmartPointer<vtkUnstructuredGrid> grid, const SMDS_Vo
 {
     Base::Console().Log("  Start: VTK mesh builder volumes.\n");
 
-    vtkSmartPointer<vtkCellArray> tetraArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> pyramidArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> wedgeArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> hexaArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadTetraArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadPyramidArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadWedgeArray = vtkSmartPointer<vtkCellArray>::New();
-    vtkSmartPointer<vtkCellArray> quadHexaArray = vtkSmartPointer<vtkCellArray>::New();
-
+    std::vector<const SMDS_MeshElement*> volumes;
     for (;aVolIter->more();)
-    {
-        const SMDS_MeshVolume* aVol = aVolIter->next();
-
-        if (aVol->NbNodes() == 4) { // tetra4
-            Base::Console().Log("    Volume tetra4\n");
-            vtkSmartPointer<vtkTetra> cell = vtkSmartPointer<vtkTetra>::New();
-            cell->GetPointIds()->SetId(0, aVol->GetNode(0)->GetID()-1);
-            cell->GetPointIds()->SetId(1, aVol->GetNode(1)->GetID()-1);
-            cell->GetPointIds()->SetId(2, aVol->GetNode(2)->GetID()-1);
-            cell->GetPointIds()->SetId(3, aVol->GetNode(3)->GetID()-1);
-            tetraArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 5) { // pyra5
-            Base::Console().Log("    Volume pyra5\n");
-            vtkSmartPointer<vtkPyramid> cell = vtkSmartPointer<vtkPyramid>::New();
-            cell->GetPointIds()->SetId(0, aVol->GetNode(0)->GetID()-1);
-            cell->GetPointIds()->SetId(1, aVol->GetNode(1)->GetID()-1);
-            cell->GetPointIds()->SetId(2, aVol->GetNode(2)->GetID()-1);
-            cell->GetPointIds()->SetId(3, aVol->GetNode(3)->GetID()-1);
-            cell->GetPointIds()->SetId(4, aVol->GetNode(4)->GetID()-1);
-            pyramidArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 6) { // penta6
-            Base::Console().Log("    Volume penta6\n");
-            vtkSmartPointer<vtkWedge> cell = vtkSmartPointer<vtkWedge>::New();
-            cell->GetPointIds()->SetId(0, aVol->GetNode(0)->GetID()-1);
-            cell->GetPointIds()->SetId(1, aVol->GetNode(1)->GetID()-1);
-            cell->GetPointIds()->SetId(2, aVol->GetNode(2)->GetID()-1);
-            cell->GetPointIds()->SetId(3, aVol->GetNode(3)->GetID()-1);
-            cell->GetPointIds()->SetId(4, aVol->GetNode(4)->GetID()-1);
-            cell->GetPointIds()->SetId(5, aVol->GetNode(5)->GetID()-1);
-            wedgeArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 8) { // hexa8
-            Base::Console().Log("    Volume hexa8\n");
-            vtkSmartPointer<vtkHexahedron> cell = vtkSmartPointer<vtkHexahedron>::New();
-            cell->GetPointIds()->SetId(0, aVol->GetNode(0)->GetID()-1);
-            cell->GetPointIds()->SetId(1, aVol->GetNode(1)->GetID()-1);
-            cell->GetPointIds()->SetId(2, aVol->GetNode(2)->GetID()-1);
-            cell->GetPointIds()->SetId(3, aVol->GetNode(3)->GetID()-1);
-            cell->GetPointIds()->SetId(4, aVol->GetNode(4)->GetID()-1);
-            cell->GetPointIds()->SetId(5, aVol->GetNode(5)->GetID()-1);
-            cell->GetPointIds()->SetId(6, aVol->GetNode(6)->GetID()-1);
-            cell->GetPointIds()->SetId(7, aVol->GetNode(7)->GetID()-1);
-            hexaArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 10) { // tetra10
-            Base::Console().Log("    Volume tetra10\n");
-            vtkSmartPointer<vtkQuadraticTetra> tetra = vtkSmartPointer<vtkQuadraticTetra>::New();
-            for(int i=0; i<10; i++){
-                tetra->GetPointIds()->SetId(i, aVol->GetNode(i)->GetID()-1);
-            }
-            quadTetraArray->InsertNextCell(tetra);
-        }
-
-        else if (aVol->NbNodes() == 13) { // pyra13
-            Base::Console().Log("    Volume pyra13\n");
-            vtkSmartPointer<vtkQuadraticPyramid> cell = vtkSmartPointer<vtkQuadraticPyramid>::New();
-            for(int i=0; i<13; i++){
-                cell->GetPointIds()->SetId(i, aVol->GetNode(i)->GetID()-1);
-                // Base::Console().Log("node ids: %i\n", aVol->GetNode(i)->GetID()-1);
-            }
-            quadPyramidArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 15) { // penta15
-            Base::Console().Log("    Volume penta15\n");
-            vtkSmartPointer<vtkQuadraticWedge> cell = vtkSmartPointer<vtkQuadraticWedge>::New();
-            for(int i=0; i<15; i++){
-                cell->GetPointIds()->SetId(i, aVol->GetNode(i)->GetID()-1);
-            }
-            quadWedgeArray->InsertNextCell(cell);
-        }
-        else if (aVol->NbNodes() == 20) { // hexa20
-            Base::Console().Log("    Volume hexa20\n");
-            vtkSmartPointer<vtkQuadraticHexahedron> cell = vtkSmartPointer<vtkQuadraticHexahedron>::New();
-            for(int i=0; i<20; i++){
-                cell->GetPointIds()->SetId(i, aVol->GetNode(i)->GetID()-1);
-            }
-            quadHexaArray->InsertNextCell(cell);
-        }
-        else {
-            throw std::runtime_error("Volume not yet supported by FreeCAD's VTK mesh builder\n");
-        }
-    }
-
-    if(tetraArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_TETRA, tetraArray);
-
-    if(pyramidArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_PYRAMID, pyramidArray);
-
-    if(wedgeArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_WEDGE, wedgeArray);
-
-    if(hexaArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_HEXAHEDRON, hexaArray);
-
-    if(quadTetraArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_QUADRATIC_TETRA, quadTetraArray);
-
-    if(quadPyramidArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_QUADRATIC_PYRAMID, quadPyramidArray);
-
-    if(quadWedgeArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_QUADRATIC_WEDGE, quadWedgeArray);
-
-    if(quadHexaArray->GetNumberOfCells()>0)
-        grid->SetCells(VTK_QUADRATIC_HEXAHEDRON, quadHexaArray);
+        volumes.push_back(aVolIter->next());
+
+    std::map<int, int> cellTypes;
+    cellTypes[4] = VTK_TETRA;
+    cellTypes[5] = VTK_PYRAMID;
+    cellTypes[6] = VTK_WEDGE;
+    cellTypes[8] = VTK_HEXAHEDRON;
+    cellTypes[10] = VTK_QUADRATIC_TETRA;
+    cellTypes[13] = VTK_QUADRATIC_PYRAMID;
+    cellTypes[15] = VTK_QUADRATIC_WEDGE;
+    cellTypes[20] = VTK_QUADRATIC_HEXAHEDRON;
+    exportFemMeshElements(grid, volumes, cellTypes, "Volume not yet supported by FreeCAD's VTK mesh builder\n");
 
     Base::Console().Log("  End: VTK mesh builder volumes.\n");
 }
@@ -442,17 +368,31 @@ void FemVTKTools::exportVTKMesh(const FemMesh* mesh, vtkSmartPointer<vtkUnstruct
     // nodes
     Base::Console().Log("  Start: VTK mesh builder nodes.\n");
 
-    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    std::vector<const SMDS_MeshNode*> nodes;
     SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* node = aNodeIter->next();  // why float, not double?
-        double coords[3] = {double(node->X()*scale), double(node->Y()*scale), double(node->Z()*scale)};
-        points->InsertPoint(node->GetID()-1, coords);
-        // memory is allocated by VTK points size for max node id, not for point count
-        // if the SMESH mesh has gaps in node numbering, points without any element assignment will be inserted in these point gaps too
-        // this needs to be taken into account on node mapping when FreeCAD FEM results are exported to vtk
-    }
+    while (aNodeIter->more())
+        nodes.push_back(aNodeIter->next());
+
+    // memory is allocated by VTK points size for max node id, not for point count
+    // if the SMESH mesh has gaps in node numbering, points without any element assignment will be inserted in these point gaps too
+    // this needs to be taken into account on node mapping when FreeCAD FEM results are exported to vtk
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();  // why float, not double?
+    points->SetNumberOfPoints(nodes.empty() ? 0 : meshDS->MaxNodeID());
+    float* coordinates = static_cast<float*>(points->GetVoidPointer(0));
+    std::fill(coordinates, coordinates + 3*points->GetNumberOfPoints(), 0.0f);
+
+    // SMDS_MeshNode::X() isn't thread safe, the coordinates are read from the SMESH grid directly
+    vtkPoints* meshPoints = meshDS->getGrid()->GetPoints();
+    forEachChunk(static_cast<vtkIdType>(nodes.size()), [&](std::size_t, vtkIdType begin, vtkIdType end) {
+        double coords[3];
+        for (vtkIdType i=begin; i<end; i++) {
+            meshPoints->GetPoint(nodes[i]->getVtkId(), coords);
+            float* point = coordinates + 3*(nodes[i]->GetID()-1);
+            point[0] = float(coords[0]*scale);
+            point[1] = float(coords[1]*scale);
+            point[2] = float(coords[2]*scale);
+        }
+    });
     grid->SetPoints(points);
     // nodes debugging
     const SMDS_MeshInfo& info = meshDS->GetMeshInfo();
@@ -725,6 +665,60 @@ std::map<std::string, std::string> _getFreeCADMechResultScalarProperties() {
 }
 
 
+// The compact result fields are single precision like the arrays of the pipeline,
+// so the values are copied as they are, in one go if the array is a float array
+static void importResultField(vtkDataArray* array, vtkIdType nPoints, PropertyResultField* field)
+{
+    const int dim = field->getComponents();
+    PropertyResultField::Field values(dim * nPoints, 0.0f);
+    const vtkIdType nTuples = std::min(nPoints, array->GetNumberOfTuples());
+    vtkFloatArray* floats = vtkFloatArray::SafeDownCast(array);
+    if (floats) {
+        const float* data = floats->GetPointer(0);
+        std::copy(data, data + dim * nTuples, values.begin());
+    }
+    else {
+        forEachChunk(nTuples, [&](std::size_t, vtkIdType begin, vtkIdType end) {
+            double p[3];
+            for (vtkIdType i = begin; i < end; i++) {
+                array->GetTuple(i, p);
+                for (int j = 0; j < dim; j++)
+                    values[dim * i + j] = static_cast<float>(p[j]);
+            }
+        });
+    }
+    field->setValues(std::move(values));
+}
+
+static void exportResultField(const PropertyResultField* field, const char* name,
+                              const std::vector<vtkIdType>& pointIds, bool sequential,
+                              vtkSmartPointer<vtkDataSet> grid)
+{
+    const int dim = field->getComponents();
+    const vtkIdType nPoints = grid->GetNumberOfPoints();
+    const PropertyResultField::Field& values = field->getValues();
+    vtkSmartPointer<vtkFloatArray> data = vtkSmartPointer<vtkFloatArray>::New();
+    data->SetNumberOfComponents(dim);
+    data->SetNumberOfTuples(nPoints);
+    data->SetName(name);
+
+    float* tuples = data->GetPointer(0);
+    const vtkIdType nValues = static_cast<vtkIdType>(std::min<std::size_t>(field->getSize(), pointIds.size()));
+    if (nValues != nPoints)
+        std::fill(tuples, tuples + dim * nPoints, 0.0f);
+
+    if (sequential) {
+        std::copy(values.begin(), values.begin() + dim * nValues, tuples);
+    }
+    else {
+        forEachChunk(nValues, [&](std::size_t, vtkIdType begin, vtkIdType end) {
+            for (vtkIdType i = begin; i < end; i++)
+                std::copy(&values[dim * i], &values[dim * i] + dim, tuples + dim * pointIds[i]);
+        });
+    }
+    grid->GetPointData()->AddArray(data);
+}
+
 void FemVTKTools::importFreeCADResult(vtkSmartPointer<vtkDataSet> dataset, App::DocumentObject* result) {
     Base::Console().Log("Start: import vtk result file data into a FreeCAD result object.\n");
 
@@ -755,13 +749,22 @@ void FemVTKTools::importFreeCADResult(vtkSmartPointer<vtkDataSet> dataset, App::
         int dim = 3;  // Fixme: currently 3D only, here we could run into trouble, FreeCAD only supports dim 3D, I do not know about VTK
         vtkDataArray* vector_field = vtkDataArray::SafeDownCast(pd->GetArray(it->second.c_str()));
         if(vector_field && vector_field->GetNumberOfComponents() == dim) {
+            App::Property* prop = result->getPropertyByName(it->first.c_str());
+            if (prop && prop->isDerivedFrom(PropertyResultField::getClassTypeId())) {
+                importResultField(vector_field, nPoints, static_cast<PropertyResultField*>(prop));
+                continue;
+            }
             App::PropertyVectorList* vector_list = static_cast<App::PropertyVectorList*>(result->getPropertyByName(it->first.c_str()));
             if(vector_list) {
                 std::vector<Base::Vector3d> vec(nPoints);
-                for(vtkIdType i=0; i<nPoints; ++i) {
-                    double *p = vector_field->GetTuple(i); // both vtkFloatArray and vtkDoubleArray return double* for GetTuple(i)
-                    vec[i] = (Base::Vector3d(p[0], p[1], p[2]));
-                }
+                const vtkIdType nTuples = std::min(nPoints, vector_field->GetNumberOfTuples());
+                forEachChunk(nTuples, [&](std::size_t, vtkIdType begin, vtkIdType end) {
+                    double p[3];
+                    for(vtkIdType i=begin; i<end; ++i) {
+                        vector_field->GetTuple(i, p); // copies into p, GetTuple(i) shares one buffer for all threads
+                        vec[i] = (Base::Vector3d(p[0], p[1], p[2]));
+                    }
+                });
                 // PropertyVectorList will not show up in PropertyEditor
                 vector_list->setValues(vec);
                 Base::Console().Log("    A PropertyVectorList has been filled with values: %s\n", it->first.c_str());
@@ -779,21 +782,23 @@ void FemVTKTools::importFreeCADResult(vtkSmartPointer<vtkDataSet> dataset, App::
     for (std::map<std::string, std::string>::iterator it = scalars.begin(); it != scalars.end(); ++it) {
         vtkDataArray* vec = vtkDataArray::SafeDownCast(pd->GetArray(it->second.c_str()));
         if(nPoints && vec && vec->GetNumberOfComponents() == 1) {
+            App::Property* prop = result->getPropertyByName(it->first.c_str());
+            if (prop && prop->isDerivedFrom(PropertyResultField::getClassTypeId())) {
+                importResultField(vec, nPoints, static_cast<PropertyResultField*>(prop));
+                continue;
+            }
             App::PropertyFloatList* field = static_cast<App::PropertyFloatList*>(result->getPropertyByName(it->first.c_str()));
             if (!field) {
                 Base::Console().Error("static_cast<App::PropertyFloatList*>((result->getPropertyByName(\"%s\")) failed.\n", it->first.c_str());
                 continue;
             }
 
-            double vmin=1.0e100, vmean=0.0, vmax=-1.0e100;
             std::vector<double> values(nPoints, 0.0);
-            for(vtkIdType i = 0; i < vec->GetNumberOfTuples(); i++) {
-                double v = *(vec->GetTuple(i));
-                values[i] = v;
-                vmean += v;
-                if(v > vmax) vmax = v;
-                if(v < vmin) vmin = v;
-            }
+            const vtkIdType nTuples = std::min(nPoints, vec->GetNumberOfTuples());
+            forEachChunk(nTuples, [&](std::size_t, vtkIdType begin, vtkIdType end) {
+                for(vtkIdType i = begin; i < end; i++)
+                    vec->GetTuple(i, &values[i]);
+            });
             field->setValues(values);
             Base::Console().Log("    A PropertyFloatList has been filled with vales: %s\n", it->first.c_str());
         }
@@ -827,9 +832,25 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
     SMESH_Mesh* smesh = const_cast<SMESH_Mesh*>(static_cast<FemMeshObject*>(meshObj)->FemMesh.getValue().getSMesh());
     SMESHDS_Mesh* meshDS = smesh->GetMeshDS();
 
+    // the result values are stored in the order of the node iterator, each one goes to the vtk point of its node
+    std::vector<vtkIdType> pointIds;
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
+    while (aNodeIter->more())
+        pointIds.push_back(aNodeIter->next()->GetID()-1);
+    bool sequential = true;
+    for (std::size_t i = 0; i < pointIds.size() && sequential; i++)
+        sequential = pointIds[i] == static_cast<vtkIdType>(i);
+
     // vectors
     for (std::map<std::string, std::string>::iterator it = vectors.begin(); it != vectors.end(); ++it) {
         const int dim=3;  //Fixme, detect dim, but FreeCAD PropertyVectorList ATM only has DIM of 3
+        const App::Property* prop = res->getPropertyByName(it->first.c_str());
+        if (prop && prop->isDerivedFrom(PropertyResultField::getClassTypeId())) {
+            const PropertyResultField* resultField = static_cast<const PropertyResultField*>(prop);
+            if (resultField->getSize() > 0 && resultField->getComponents() == dim)
+                exportResultField(resultField, it->second.c_str(), pointIds, sequential, grid);
+            continue;
+        }
         App::PropertyVectorList* field = nullptr;
         if (res->getPropertyByName(it->first.c_str()))
             field = static_cast<App::PropertyVectorList*>(res->getPropertyByName(it->first.c_str()));
@@ -845,21 +866,22 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
             data->SetNumberOfTuples(nPoints);
             data->SetName(it->second.c_str());
 
+            double* values = data->GetPointer(0);
+
             //we need to set values for the unused points.
             //TODO: ensure that the result bar does not include the used 0 if it is not part of the result (e.g. does the result bar show 0 as smallest value?)
-            if (nPoints != field->getSize()) {
-                double tuple[] = {0,0,0};
-                for (vtkIdType i=0; i<nPoints; ++i) {
-                    data->SetTuple(i, tuple);
+            if (nPoints != field->getSize())
+                std::fill(values, values + dim*nPoints, 0.0);
+
+            const vtkIdType nValues = static_cast<vtkIdType>(std::min(vel.size(), pointIds.size()));
+            forEachChunk(nValues, [&](std::size_t, vtkIdType begin, vtkIdType end) {
+                for (vtkIdType i=begin; i<end; ++i) {
+                    double* tuple = values + dim*pointIds[i];
+                    tuple[0] = vel[i].x;
+                    tuple[1] = vel[i].y;
+                    tuple[2] = vel[i].z;
                 }
-            }
-
-            SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-            for (std::vector<Base::Vector3d>::const_iterator jt=vel.begin(); jt!=vel.end(); ++jt) {
-                const SMDS_MeshNode* node = aNodeIter->next();
-                double tuple[] = {jt->x, jt->y, jt->z};
-                data->SetTuple(node->GetID()-1, tuple);
-            }
+            });
             grid->GetPointData()->AddArray(data);
             Base::Console().Log("    The PropertyVectorList %s was exported to VTK vector list: %s\n", it->first.c_str(), it->second.c_str());
         }
@@ -870,6 +892,13 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
 
     // scalars
     for (std::map<std::string, std::string>::iterator it = scalars.begin(); it != scalars.end(); ++it) {
+        const App::Property* prop = res->getPropertyByName(it->first.c_str());
+        if (prop && prop->isDerivedFrom(PropertyResultField::getClassTypeId())) {
+            const PropertyResultField* resultField = static_cast<const PropertyResultField*>(prop);
+            if (resultField->getSize() > 0 && resultField->getComponents() == 1)
+                exportResultField(resultField, it->second.c_str(), pointIds, sequential, grid);
+            continue;
+        }
         App::PropertyFloatList* field = nullptr;
         if (res->getPropertyByName(it->first.c_str()))
             field = static_cast<App::PropertyFloatList*>(res->getPropertyByName(it->first.c_str()));
@@ -884,19 +913,18 @@ void FemVTKTools::exportFreeCADResult(const App::DocumentObject* result, vtkSmar
             data->SetNumberOfValues(nPoints);
             data->SetName(it->second.c_str());
 
+            double* values = data->GetPointer(0);
+
             //we need to set values for the unused points.
             //TODO: ensure that the result bar does not include the used 0 if it is not part of the result (e.g. does the result bar show 0 as smallest value?)
-            if (nPoints != field->getSize()) {
-                for (vtkIdType i=0; i<nPoints; ++i) {
-                    data->SetValue(i, 0);
-                }
-             }
-
-            SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-            for (size_t i=0; i<vec.size(); ++i) {
-                const SMDS_MeshNode* node = aNodeIter->next();
-                data->SetValue(node->GetID()-1, vec[i]);
-            }
+            if (nPoints != field->getSize())
+                std::fill(values, values + nPoints, 0.0);
+
+            const vtkIdType nValues = static_cast<vtkIdType>(std::min(vec.size(), pointIds.size()));
+            forEachChunk(nValues, [&](std::size_t, vtkIdType begin, vtkIdType end) {
+                for (vtkIdType i=begin; i<end; ++i)
+                    values[pointIds[i]] = vec[i];
+            });
 
             grid->GetPointData()->AddArray(data);
             Base::Console().Log("    The PropertyFloatList %s was exported to VTK scalar list: %s\n", it->first.c_str(), it->second.c_str());
@@ -33,7 +33,11 @@
 # include <vtkCompositeDataSet.h>
 # include <vtkMultiBlockDataSet.h>
 # include <vtkMultiPieceDataSet.h>
-# include <vtkXMLDataSetWriter.h>
+# include <vtkXMLPolyDataWriter.h>
+# include <vtkXMLStructuredGridWriter.h>
+# include <vtkXMLUnstructuredGridWriter.h>
+# include <vtkXMLRectilinearGridWriter.h>
+# include <vtkXMLImageDataWriter.h>
 # include <vtkXMLPolyDataReader.h>
 # include <vtkXMLStructuredGridReader.h>
 # include <vtkXMLUnstructuredGridReader.h>
@@ -45,6 +49,7 @@
 #include <Base/Console.h>
 #include <Base/Writer.h>
 #include <Base/Reader.h>
+#include <Base/Parameter.h>
 #include <App/Application.h>
 #include <App/DocumentObject.h>
 
@@ -56,6 +61,73 @@
 
 using namespace Fem;
 
+namespace {
+
+// file extension of the vtk XML format for a data object, empty if it isn't supported
+std::string getFileExtension(vtkDataObject* data)
+{
+    switch( data->GetDataObjectType() ) {
+
+        case VTK_POLY_DATA:
+            return "vtp";
+        case VTK_STRUCTURED_GRID:
+            return "vts";
+        case VTK_RECTILINEAR_GRID:
+            return "vtr";
+        case VTK_UNSTRUCTURED_GRID:
+            return "vtu";
+        case VTK_UNIFORM_GRID:
+            return "vti"; //image data
+        //TODO:multi-datasets use multiple files, this needs to be implemented specially
+//         case VTK_COMPOSITE_DATA_SET:
+//             prop->m_dataObject = vtkCompositeDataSet::New();
+//             break;
+//         case VTK_MULTIBLOCK_DATA_SET:
+//             prop->m_dataObject = vtkMultiBlockDataSet::New();
+//             break;
+//         case VTK_MULTIPIECE_DATA_SET:
+//             prop->m_dataObject = vtkMultiPieceDataSet::New();
+//             break;
+        default:
+            return std::string();
+    };
+}
+
+vtkSmartPointer<vtkXMLWriter> createXMLWriter(const std::string& extension)
+{
+    vtkSmartPointer<vtkXMLWriter> xmlWriter;
+    if(extension == "vtp")
+        xmlWriter = vtkSmartPointer<vtkXMLPolyDataWriter>::New();
+    else if (extension == "vts")
+        xmlWriter = vtkSmartPointer<vtkXMLStructuredGridWriter>::New();
+    else if (extension == "vtr")
+        xmlWriter = vtkSmartPointer<vtkXMLRectilinearGridWriter>::New();
+    else if (extension == "vtu")
+        xmlWriter = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+    else if (extension == "vti")
+        xmlWriter = vtkSmartPointer<vtkXMLImageDataWriter>::New();
+    return xmlWriter;
+}
+
+vtkSmartPointer<vtkXMLReader> createXMLReader(const std::string& extension)
+{
+    //TODO: read in of composite data structures need to be coded, including replace of "GetOutputAsDataSet()"
+    vtkSmartPointer<vtkXMLReader> xmlReader;
+    if(extension == "vtp")
+        xmlReader = vtkSmartPointer<vtkXMLPolyDataReader>::New();
+    else if (extension == "vts")
+        xmlReader = vtkSmartPointer<vtkXMLStructuredGridReader>::New();
+    else if (extension == "vtr")
+        xmlReader = vtkSmartPointer<vtkXMLRectilinearGridReader>::New();
+    else if (extension == "vtu")
+        xmlReader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
+    else if (extension == "vti")
+        xmlReader = vtkSmartPointer<vtkXMLImageDataReader>::New();
+    return xmlReader;
+}
+
+}
+
 TYPESYSTEM_SOURCE(Fem::PropertyPostDataObject , App::Property)
 
 PropertyPostDataObject::PropertyPostDataObject()
@@ -70,9 +142,14 @@ void PropertyPostDataObject::setValue(const vtkSmartPointer<vtkDataObject>& ds)
 {
     aboutToSetValue();
 
+    // The data object is shared with the copies of the property, e.g. by undo/redo
+    // or by the filters using it as input, so it's never modified after it has been
+    // set. A shallow copy is enough as vtk algorithms replace the arrays of their
+    // output on an update instead of writing to them.
+    m_restoredData.reset();
     if(ds) {
         createDataObjectByExternalType(ds);
-        m_dataObject->DeepCopy(ds);
+        m_dataObject->ShallowCopy(ds);
     }
     else
         m_dataObject = NULL;
@@ -82,21 +159,25 @@ void PropertyPostDataObject::setValue(const vtkSmartPointer<vtkDataObject>& ds)
 
 const vtkSmartPointer<vtkDataObject>& PropertyPostDataObject::getValue(void)const
 {
+    loadRestoredData();
     return m_dataObject;
 }
 
 bool PropertyPostDataObject::isComposite() {
 
+    loadRestoredData();
     return m_dataObject && !m_dataObject->IsA("vtkDataSet");
 }
 
 bool PropertyPostDataObject::isDataSet() {
 
+    loadRestoredData();
     return m_dataObject && m_dataObject->IsA("vtkDataSet");
 }
 
 int PropertyPostDataObject::getDataType() {
 
+    loadRestoredData();
     if(!m_dataObject)
         return -1;
 
@@ -117,12 +198,11 @@ void PropertyPostDataObject::setPyObject(PyObject * /*value*/)
 
 App::Property *PropertyPostDataObject::Copy(void) const
 {
+    // the data object is never modified, see setValue()
     PropertyPostDataObject *prop = new PropertyPostDataObject();
-    if (m_dataObject) {
-
-        prop->createDataObjectByExternalType(m_dataObject);
-        prop->m_dataObject->DeepCopy(m_dataObject);
-    }
+    prop->m_dataObject = m_dataObject;
+    prop->m_restoredData = m_restoredData;
+    prop->m_restoredExtension = m_restoredExtension;
 
     return prop;
 }
@@ -164,13 +244,21 @@ void PropertyPostDataObject::createDataObjectByExternalType(vtkSmartPointer< vtk
 void PropertyPostDataObject::Paste(const App::Property &from)
 {
     aboutToSetValue();
-    m_dataObject = dynamic_cast<const PropertyPostDataObject&>(from).m_dataObject;
+    const PropertyPostDataObject& prop = dynamic_cast<const PropertyPostDataObject&>(from);
+    m_dataObject = prop.m_dataObject;
+    m_restoredData = prop.m_restoredData;
+    m_restoredExtension = prop.m_restoredExtension;
     hasSetValue();
 }
 
 unsigned int PropertyPostDataObject::getMemSize (void) const
 {
-    return m_dataObject->GetActualMemorySize();
+    if (m_restoredData)
+        return static_cast<unsigned int>(m_restoredData->size());
+    if (!m_dataObject)
+        return 0;
+    // vtk reports the size in kibibytes
+    return m_dataObject->GetActualMemorySize() * 1024;
 }
 
 void PropertyPostDataObject::getPaths(std::vector<App::ObjectIdentifier> & /*paths*/) const
@@ -190,40 +278,13 @@ void PropertyPostDataObject::getPaths(std::vector<App::ObjectIdentifier> & /*pat
 void PropertyPostDataObject::Save (Base::Writer &writer) const
 {
     std::string extension;
-    if(!m_dataObject)
+    if(m_restoredData)
+        extension = m_restoredExtension;
+    else if(m_dataObject)
+        extension = getFileExtension(m_dataObject);
+    else
         return;
 
-    switch( m_dataObject->GetDataObjectType() ) {
-
-        case VTK_POLY_DATA:
-            extension = "vtp";
-            break;
-        case VTK_STRUCTURED_GRID:
-            extension = "vts";
-            break;
-        case VTK_RECTILINEAR_GRID:
-            extension = "vtr";
-            break;
-        case VTK_UNSTRUCTURED_GRID:
-            extension = "vtu";
-            break;
-        case VTK_UNIFORM_GRID:
-            extension = "vti"; //image data
-            break;
-        //TODO:multi-datasets use multiple files, this needs to be implemented specially
-//         case VTK_COMPOSITE_DATA_SET:
-//             prop->m_dataObject = vtkCompositeDataSet::New();
-//             break;
-//         case VTK_MULTIBLOCK_DATA_SET:
-//             prop->m_dataObject = vtkMultiBlockDataSet::New();
-//             break;
-//         case VTK_MULTIPIECE_DATA_SET:
-//             prop->m_dataObject = vtkMultiPieceDataSet::New();
-//             break;
-        default:
-            break;
-    };
-
     if(!writer.isForceXML()) {
         std::string file = "Data." + extension;
         writer.Stream() << writer.ind() << "<Data file=\""
@@ -248,112 +309,113 @@ void PropertyPostDataObject::Restore(Base::XMLReader &reader)
 
 void PropertyPostDataObject::SaveDocFile (Base::Writer &writer) const
 {
+    // a restored file which hasn't been read yet is stored as it is
+    if (m_restoredData) {
+        writer.Stream().write(m_restoredData->data(), m_restoredData->size());
+        return;
+    }
+
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (!m_dataObject)
         return;
 
-    // create a temporary file and copy the content to the zip stream
-    // once the tmp. filename is known use always the same because otherwise
-    // we may run into some problems on the Linux platform
-    static Base::FileInfo fi(App::Application::getTempFileName());
+    vtkSmartPointer<vtkXMLWriter> xmlWriter = createXMLWriter(getFileExtension(m_dataObject));
+    if (!xmlWriter)
+        return;
 
-    vtkSmartPointer<vtkXMLDataSetWriter> xmlWriter = vtkSmartPointer<vtkXMLDataSetWriter>::New();
+    // The arrays are appended as raw binary data to the XML structure, which saves
+    // the base64 encoding. If they are compressed by the vtk writer the zip file
+    // can't compress them any further.
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Fem/General");
     xmlWriter->SetInputDataObject(m_dataObject);
-    xmlWriter->SetFileName(fi.filePath().c_str());
-    xmlWriter->SetDataModeToBinary();
+    xmlWriter->WriteToOutputStringOn();
+    xmlWriter->SetDataModeToAppended();
+    xmlWriter->EncodeAppendedDataOff();
+    if (hGrp->GetBool("CompressPostData", true))
+        xmlWriter->SetCompressorTypeToZLib();
+    else
+        xmlWriter->SetCompressorTypeToNone();
 
     if ( xmlWriter->Write() != 1 ) {
-        // Note: Do NOT throw an exception here because if the tmp. file could
-        // not be created we should not abort.
+        // Note: Do NOT throw an exception here because if the data could not be
+        // written we should not abort.
         // We only print an error message but continue writing the next files to the
         // stream...
         App::PropertyContainer* father = this->getContainer();
         if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
             App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
-            Base::Console().Error("Dataset of '%s' cannot be written to vtk file '%s'\n",
-                obj->Label.getValue(),fi.filePath().c_str());
+            Base::Console().Error("Dataset of '%s' cannot be written to vtk file\n",
+                obj->Label.getValue());
         }
         else {
-            Base::Console().Error("Cannot save vtk file '%s'\n", fi.filePath().c_str());
+            Base::Console().Error("Cannot save vtk file\n");
         }
 
-        std::stringstream ss;
-        ss << "Cannot save vtk file '" << fi.filePath() << "'";
-        writer.addError(ss.str());
-    }
-
-    Base::ifstream file(fi, std::ios::in | std::ios::binary);
-    if (file){
-        std::streambuf* buf = file.rdbuf();
-        writer.Stream() << buf;
+        writer.addError("Cannot save vtk file");
+        return;
     }
 
-    file.close();
-    // remove temp file
-    fi.deleteFile();
+    const std::string& data = xmlWriter->GetOutputString();
+    writer.Stream().write(data.data(), data.size());
 }
 
 void PropertyPostDataObject::RestoreDocFile(Base::Reader &reader)
 {
     Base::FileInfo xml(reader.getFileName());
-    // create a temporary file and copy the content from the zip stream
-    Base::FileInfo fi(App::Application::getTempFileName());
 
-    // read in the ASCII file and write back to the file stream
-    Base::ofstream file(fi, std::ios::out | std::ios::binary);
-    unsigned long ulSize = 0;
+    // the file is only kept in memory, it is read when the data object is accessed
+    // for the first time, see loadRestoredData()
+    std::shared_ptr<std::string> data = std::make_shared<std::string>();
     if (reader) {
-        std::streambuf* buf = file.rdbuf();
-        reader >> buf;
-        file.flush();
-        ulSize = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+        std::ostringstream str;
+        str << reader.rdbuf();
+        *data = str.str();
     }
-    file.close();
-
-    // Read the data from the temp file
-    if (ulSize > 0) {
-        std::string extension = xml.extension();
-
-        //TODO: read in of composite data structures need to be coded, including replace of "GetOutputAsDataSet()"
-        vtkSmartPointer<vtkXMLReader> xmlReader;
-        if(extension == "vtp")
-            xmlReader = vtkSmartPointer<vtkXMLPolyDataReader>::New();
-        else if (extension == "vts")
-            xmlReader = vtkSmartPointer<vtkXMLStructuredGridReader>::New();
-        else if (extension == "vtr")
-            xmlReader = vtkSmartPointer<vtkXMLRectilinearGridReader>::New();
-        else if (extension == "vtu")
-            xmlReader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
-        else if (extension == "vti")
-            xmlReader = vtkSmartPointer<vtkXMLImageDataReader>::New();
-
-        xmlReader->SetFileName(fi.filePath().c_str());
+
+    if (!data->empty()) {
+        aboutToSetValue();
+        m_dataObject = NULL;
+        m_restoredData = data;
+        m_restoredExtension = xml.extension();
+        hasSetValue();
+    }
+}
+
+void PropertyPostDataObject::loadRestoredData() const
+{
+    if (!m_restoredData)
+        return;
+
+    std::shared_ptr<const std::string> data;
+    data.swap(m_restoredData);
+
+    vtkSmartPointer<vtkXMLReader> xmlReader = createXMLReader(m_restoredExtension);
+    if (xmlReader) {
+        xmlReader->ReadFromInputStringOn();
+        xmlReader->SetInputString(*data);
         xmlReader->Update();
+    }
 
-        if (!xmlReader->GetOutputAsDataSet()) {
-            // Note: Do NOT throw an exception here because if the tmp. created file could
-            // not be read it's NOT an indication for an invalid input stream 'reader'.
-            // We only print an error message but continue reading the next files from the
-            // stream...
-            App::PropertyContainer* father = this->getContainer();
-            if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
-                App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
-                Base::Console().Error("Dataset file '%s' with data of '%s' seems to be empty\n",
-                    fi.filePath().c_str(),obj->Label.getValue());
-            }
-            else {
-                Base::Console().Warning("Loaded Dataset file '%s' seems to be empty\n", fi.filePath().c_str());
-            }
+    if (!xmlReader || !xmlReader->GetOutputAsDataSet()) {
+        // Note: Do NOT throw an exception here because if the file could not be
+        // read it's NOT an indication for an invalid document.
+        // We only print an error message and leave the data empty...
+        App::PropertyContainer* father = this->getContainer();
+        if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
+            App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
+            Base::Console().Error("Dataset file with data of '%s' seems to be empty\n",
+                obj->Label.getValue());
         }
         else {
-            aboutToSetValue();
-            createDataObjectByExternalType(xmlReader->GetOutputAsDataSet());
-            m_dataObject->DeepCopy(xmlReader->GetOutputAsDataSet());
-            hasSetValue();
+            Base::Console().Warning("Loaded Dataset file seems to be empty\n");
         }
     }
-
-    // delete the temp file
-    fi.deleteFile();
+    else {
+        // the data object is created on demand, this doesn't change the value of the property
+        PropertyPostDataObject* self = const_cast<PropertyPostDataObject*>(this);
+        self->createDataObjectByExternalType(xmlReader->GetOutputAsDataSet());
+        m_dataObject->ShallowCopy(xmlReader->GetOutputAsDataSet());
+    }
 }
@@ -24,6 +24,8 @@
 #ifndef FEM_PROPERTYPOSTDATASET_H
 #define FEM_PROPERTYPOSTDATASET_H
 
+#include <memory>
+#include <string>
 #include <App/Property.h>
 #include <vtkSmartPointer.h>
 #include <vtkDataObject.h>
@@ -79,7 +81,13 @@ public:
 
 protected:
     void createDataObjectByExternalType(vtkSmartPointer<vtkDataObject> ex);
-    vtkSmartPointer<vtkDataObject> m_dataObject;
+    /// creates the data object from the file restored by RestoreDocFile()
+    void loadRestoredData() const;
+
+    mutable vtkSmartPointer<vtkDataObject> m_dataObject;
+    /// the restored file and its extension, they are kept until the data object is accessed
+    mutable std::shared_ptr<const std::string> m_restoredData;
+    std::string m_restoredExtension;
 };
 
 } //namespace FEM
@@ -0,0 +1,256 @@
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <Python.h>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/Reader.h>
+#include <Base/Stream.h>
+#include <Base/VectorPy.h>
+#include <Base/Writer.h>
+
+#include "PropertyResultField.h"
+
+using namespace Fem;
+
+namespace {
+std::shared_ptr<const PropertyResultField::Field> emptyField()
+{
+    static std::shared_ptr<const PropertyResultField::Field> field =
+        std::make_shared<const PropertyResultField::Field>();
+    return field;
+}
+
+float pyToFloat(PyObject* item)
+{
+    if (PyFloat_Check(item))
+        return static_cast<float>(PyFloat_AsDouble(item));
+    if (PyNumber_Check(item)) {
+        Py::Float value = Py::Float(Py::Object(item));
+        return static_cast<float>(static_cast<double>(value));
+    }
+    std::string error = std::string("type in list must be float, not ");
+    error += item->ob_type->tp_name;
+    throw Base::TypeError(error);
+}
+}
+
+TYPESYSTEM_SOURCE_ABSTRACT(Fem::PropertyResultField, App::Property)
+
+PropertyResultField::PropertyResultField(int components)
+  : _components(components)
+  , _values(emptyField())
+{
+}
+
+PropertyResultField::~PropertyResultField()
+{
+}
+
+int PropertyResultField::getSize() const
+{
+    return static_cast<int>(_values->size() / _components);
+}
+
+const PropertyResultField::Field& PropertyResultField::getValues() const
+{
+    return *_values;
+}
+
+void PropertyResultField::setValues(const Field& values)
+{
+    setField(std::make_shared<const Field>(values));
+}
+
+void PropertyResultField::setValues(Field&& values)
+{
+    setField(std::make_shared<const Field>(std::move(values)));
+}
+
+void PropertyResultField::setValues(const std::vector<double>& values)
+{
+    setField(std::make_shared<const Field>(values.begin(), values.end()));
+}
+
+void PropertyResultField::setValues(const std::vector<Base::Vector3d>& values)
+{
+    if (_components != 3)
+        throw Base::TypeError("Vectors can only be set to a vector field");
+    auto field = std::make_shared<Field>(3 * values.size());
+    float* value = field->data();
+    for (const auto& v : values) {
+        *value++ = static_cast<float>(v.x);
+        *value++ = static_cast<float>(v.y);
+        *value++ = static_cast<float>(v.z);
+    }
+    setField(field);
+}
+
+void PropertyResultField::setField(const std::shared_ptr<const Field>& field)
+{
+    if (!field)
+        throw Base::ValueError("No field given");
+    if (field->size() % _components != 0)
+        throw Base::ValueError("Number of values doesn't match the number of components");
+    aboutToSetValue();
+    _values = field;
+    hasSetValue();
+}
+
+PyObject *PropertyResultField::getPyObject(void)
+{
+    int size = getSize();
+    const float* value = _values->data();
+    PyObject* list = PyList_New(size);
+    for (int i = 0; i < size; i++, value += _components) {
+        if (_components == 3)
+            PyList_SetItem(list, i, new Base::VectorPy(Base::Vector3d(value[0], value[1], value[2])));
+        else
+            PyList_SetItem(list, i, PyFloat_FromDouble(value[0]));
+    }
+    return list;
+}
+
+void PropertyResultField::setPyObject(PyObject *value)
+{
+    if (!PySequence_Check(value)) {
+        std::string error = std::string("type must be a sequence, not ");
+        error += value->ob_type->tp_name;
+        throw Base::TypeError(error);
+    }
+
+    Py::Sequence list(value);
+    Py::Sequence::size_type size = list.size();
+    Field values;
+    values.reserve(size * _components);
+    for (Py::Sequence::size_type i = 0; i < size; i++) {
+        Py::Object item = list[i];
+        if (_components == 1) {
+            values.push_back(pyToFloat(item.ptr()));
+        }
+        else if (PyObject_TypeCheck(item.ptr(), &(Base::VectorPy::Type))) {
+            const Base::Vector3d& v = *static_cast<Base::VectorPy*>(item.ptr())->getVectorPtr();
+            values.push_back(static_cast<float>(v.x));
+            values.push_back(static_cast<float>(v.y));
+            values.push_back(static_cast<float>(v.z));
+        }
+        else if (PySequence_Check(item.ptr()) && PySequence_Size(item.ptr()) == _components) {
+            Py::Sequence tuple(item);
+            for (int j = 0; j < _components; j++)
+                values.push_back(pyToFloat(Py::Object(tuple[j]).ptr()));
+        }
+        else {
+            std::string error = std::string("type in list must be a vector, not ");
+            error += item.ptr()->ob_type->tp_name;
+            throw Base::TypeError(error);
+        }
+    }
+
+    setValues(std::move(values));
+}
+
+void PropertyResultField::Save (Base::Writer &writer) const
+{
+    writer.Stream() << writer.ind() << "<ResultField components=\"" << _components
+                    << "\" count=\"" << getSize() << "\" file=\""
+                    << (_values->empty() ? "" : writer.addFile(getName(), this))
+                    << "\"/>" << std::endl;
+}
+
+void PropertyResultField::Restore(Base::XMLReader &reader)
+{
+    reader.readElement("ResultField");
+    std::string file (reader.getAttribute("file"));
+
+    if (!file.empty()) {
+        // initiate a file read
+        reader.addFile(file.c_str(),this);
+    }
+    else {
+        setField(emptyField());
+    }
+}
+
+void PropertyResultField::SaveDocFile (Base::Writer &writer) const
+{
+    Base::OutputStream str(writer.Stream());
+    uint32_t uCt = static_cast<uint32_t>(_values->size());
+    str << uCt;
+    str.write(_values->data(), _values->size());
+}
+
+void PropertyResultField::RestoreDocFile(Base::Reader &reader)
+{
+    Base::InputStream str(reader);
+    uint32_t uCt=0;
+    str >> uCt;
+    Field values(uCt);
+    str.read(values.data(), values.size());
+    setValues(std::move(values));
+}
+
+App::Property *PropertyResultField::Copy(void) const
+{
+    PropertyResultField* p = static_cast<PropertyResultField*>(getTypeId().createInstance());
+    p->_values = _values;
+    return p;
+}
+
+void PropertyResultField::Paste(const App::Property &from)
+{
+    setField(dynamic_cast<const PropertyResultField&>(from)._values);
+}
+
+unsigned int PropertyResultField::getMemSize (void) const
+{
+    return static_cast<unsigned int>(_values->size() * sizeof(float));
+}
+
+// ----------------------------------------------------------------------------
+
+TYPESYSTEM_SOURCE(Fem::PropertyResultScalarField, Fem::PropertyResultField)
+
+PropertyResultScalarField::PropertyResultScalarField()
+  : PropertyResultField(1)
+{
+}
+
+PropertyResultScalarField::~PropertyResultScalarField()
+{
+}
+
+// ----------------------------------------------------------------------------
+
+TYPESYSTEM_SOURCE(Fem::PropertyResultVectorField, Fem::PropertyResultField)
+
+PropertyResultVectorField::PropertyResultVectorField()
+  : PropertyResultField(3)
+{
+}
+
+PropertyResultVectorField::~PropertyResultVectorField()
+{
+}
@@ -0,0 +1,117 @@
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef FEM_PROPERTYRESULTFIELD_H
+#define FEM_PROPERTYRESULTFIELD_H
+
+#include <memory>
+#include <vector>
+#include <App/Property.h>
+#include <Base/Vector3D.h>
+
+namespace Fem
+{
+
+/** Base class of the compact node result fields.
+ * The values are stored contiguously in single precision, with a fixed number of
+ * components per node. The buffer is shared between copies of the property, e.g.
+ * the ones kept by the transactions, and only replaced when a new value is set,
+ * so undo/redo doesn't duplicate the results. The buffer is saved as binary file.
+ */
+class AppFemExport PropertyResultField : public App::Property
+{
+    TYPESYSTEM_HEADER();
+
+public:
+    typedef std::vector<float> Field;
+
+    PropertyResultField(int components = 1);
+    ~PropertyResultField();
+
+    /** @name Getter/setter */
+    //@{
+    /// number of values per node
+    int getComponents() const { return _components; }
+    /// number of nodes
+    int getSize() const;
+    /// the values of all nodes, the components of a node are consecutive
+    const Field& getValues() const;
+    /// the shared buffer, it must not be modified
+    std::shared_ptr<const Field> getField() const { return _values; }
+    void setValues(const Field&);
+    void setValues(Field&&);
+    void setValues(const std::vector<double>&);
+    void setValues(const std::vector<Base::Vector3d>&);
+    /// takes the buffer, the number of values must be a multiple of the components
+    void setField(const std::shared_ptr<const Field>&);
+    //@}
+
+    /** @name Python interface */
+    //@{
+    PyObject* getPyObject(void);
+    void setPyObject(PyObject *value);
+    //@}
+
+    /** @name Save/restore */
+    //@{
+    void Save (Base::Writer &writer) const;
+    void Restore(Base::XMLReader &reader);
+
+    void SaveDocFile (Base::Writer &writer) const;
+    void RestoreDocFile(Base::Reader &reader);
+
+    App::Property *Copy(void) const;
+    void Paste(const App::Property &from);
+    unsigned int getMemSize (void) const;
+    //@}
+
+private:
+    int _components;
+    std::shared_ptr<const Field> _values;
+};
+
+/** Scalar node results, e.g. stresses and strains.
+ */
+class AppFemExport PropertyResultScalarField : public PropertyResultField
+{
+    TYPESYSTEM_HEADER();
+
+public:
+    PropertyResultScalarField();
+    ~PropertyResultScalarField();
+};
+
+/** Vector node results, e.g. displacements.
+ */
+class AppFemExport PropertyResultVectorField : public PropertyResultField
+{
+    TYPESYSTEM_HEADER();
+
+public:
+    PropertyResultVectorField();
+    ~PropertyResultVectorField();
+};
+
+} //namespace Fem
+
+
+#endif // FEM_PROPERTYRESULTFIELD_H
@@ -41,6 +41,7 @@
 
 # include <QApplication>
 # include <QMessageBox>
+# include <QTimer>
 #endif
 
 #include "ui_TaskPostDisplay.h"
@@ -306,6 +307,13 @@ TaskPostBox::TaskPostBox(Gui::ViewProviderDocumentObject* view, const QPixmap &i
 
     m_view = view;
     m_object = view->getObject();
+
+    // the slider and spin boxes emit a change for every step, so the recompute is deferred
+    // until the pending events are processed and the steps in between are dropped
+    m_recomputeTimer = new QTimer(this);
+    m_recomputeTimer->setSingleShot(true);
+    m_recomputeTimer->setInterval(0);
+    connect(m_recomputeTimer, SIGNAL(timeout()), this, SLOT(onRecomputeTimeout()));
 }
 
 TaskPostBox::~TaskPostBox() {
@@ -321,7 +329,14 @@ bool TaskPostBox::autoApply() {
 void TaskPostBox::recompute() {
 
     if(autoApply())
-        App::GetApplication().getActiveDocument()->recompute();
+        m_recomputeTimer->start();
+}
+
+void TaskPostBox::onRecomputeTimeout() {
+
+    App::Document* doc = App::GetApplication().getActiveDocument();
+    if(doc)
+        doc->recompute();
 }
 
 void TaskPostBox::updateEnumerationList(App::PropertyEnumeration& prop, QComboBox* box) {
@@ -32,6 +32,7 @@
 #include "ViewProviderFemPostFunction.h"
 
 class QComboBox;
+class QTimer;
 class Ui_TaskPostDisplay;
 class Ui_TaskPostClip;
 class Ui_TaskPostDataAlongLine;
@@ -153,9 +154,13 @@ protected:
 
     static void updateEnumerationList(App::PropertyEnumeration&, QComboBox* box);
 
+private Q_SLOTS:
+    void onRecomputeTimeout();
+
 private:
     App::DocumentObject*              m_object;
     Gui::ViewProviderDocumentObject*  m_view;
+    QTimer*                           m_recomputeTimer;
 };
 
 /// simulation dialog for the TaskView
@@ -139,6 +139,7 @@ PROPERTY_SOURCE(FemGui::ViewProviderFemPostFunction, Gui::ViewProviderDocumentOb
 
 ViewProviderFemPostFunction::ViewProviderFemPostFunction()
     : m_manip(nullptr), m_autoscale(false), m_isDragging(false), m_autoRecompute(false)
+    , m_recomputeSensor(recomputeCallback, this)
 {
 
     ADD_PROPERTY_TYPE(AutoScaleFactorX, (1), "AutoScale", App::Prop_Hidden, "Automatic scaling factor");
@@ -158,6 +159,7 @@ ViewProviderFemPostFunction::ViewProviderFemPostFunction()
 
 ViewProviderFemPostFunction::~ViewProviderFemPostFunction()
 {
+    m_recomputeSensor.unschedule();
     m_geometrySeperator->unref();
     m_manip->unref();
     m_scale->unref();
@@ -247,6 +249,7 @@ void ViewProviderFemPostFunction::dragFinishCallback(void *data, SoDragger *)
     Gui::Application::Instance->activeDocument()->commitCommand();
 
     ViewProviderFemPostFunction* that = reinterpret_cast<ViewProviderFemPostFunction*>(data);
+    that->m_recomputeSensor.unschedule();
     if(that->m_autoRecompute)
         that->getObject()->getDocument()->recompute();
 
@@ -258,8 +261,16 @@ void ViewProviderFemPostFunction::dragMotionCallback(void *data, SoDragger *drag
     ViewProviderFemPostFunction* that = reinterpret_cast<ViewProviderFemPostFunction*>(data);
     that->draggerUpdate(drag);
 
-    if(that->m_autoRecompute)
-        that->getObject()->getDocument()->recompute();
+    // the dragger reports many more motions than the pipelines can follow on large
+    // results, so only recompute once the queued motion events are handled
+    if(that->m_autoRecompute && !that->m_recomputeSensor.isScheduled())
+        that->m_recomputeSensor.schedule();
+}
+
+void ViewProviderFemPostFunction::recomputeCallback(void *data, SoSensor *)
+{
+    ViewProviderFemPostFunction* that = reinterpret_cast<ViewProviderFemPostFunction*>(data);
+    that->getObject()->getDocument()->recompute();
 }
 
 
@@ -27,6 +27,7 @@
 #include <Gui/ViewProviderDocumentObject.h>
 #include <Mod/Fem/App/FemPostFunction.h>
 #include <Inventor/SbMatrix.h>
+#include <Inventor/sensors/SoIdleSensor.h>
 #include <QWidget>
 #include <boost_signals2.hpp>
 
@@ -135,12 +136,14 @@ private:
     static void dragStartCallback(void * data, SoDragger * d);
     static void dragFinishCallback(void * data, SoDragger * d);
     static void dragMotionCallback(void * data, SoDragger * d);
+    static void recomputeCallback(void * data, SoSensor * s);
 
     SoSeparator*        m_geometrySeperator;
     SoTransformManip*   m_manip;
     SoScale*            m_scale;
     SoTransform*        m_transform;
     bool                m_autoscale, m_isDragging, m_autoRecompute;
+    SoIdleSensor        m_recomputeSensor;  //!< recomputes once per idle pass while dragging
 };
 
 
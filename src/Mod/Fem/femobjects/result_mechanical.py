@@ -30,6 +30,8 @@ __url__    = "https://www.freecadweb.org"
 #  \ingroup FEM
 #  \brief mechanical result object
 
+import FreeCAD
+
 from . import base_fempythonobject
 
 
@@ -43,6 +45,17 @@ class ResultMechanical(base_fempythonobject.BaseFemPythonObject):
     def __init__(self, obj):
         super(ResultMechanical, self).__init__(obj)
 
+        # the node results can be stored as compact single precision fields
+        compact = FreeCAD.ParamGet(
+            "User parameter:BaseApp/Preferences/Mod/Fem/General"
+        ).GetBool("CompactResults", False)
+        if compact:
+            vector_list = "Fem::PropertyResultVectorField"
+            float_list = "Fem::PropertyResultScalarField"
+        else:
+            vector_list = "App::PropertyVectorList"
+            float_list = "App::PropertyFloatList"
+
         obj.addProperty(
             "App::PropertyString",
             "ResultType",
@@ -73,42 +86,42 @@ class ResultMechanical(base_fempythonobject.BaseFemPythonObject):
         # https://forum.freecadweb.org/viewtopic.php?f=18&t=13460&start=10#p108072
         # do not show up in propertyEditor of comboView
         obj.addProperty(
-            "App::PropertyVectorList",
+            vector_list,
             "DisplacementVectors",
             "NodeData",
             "List of displacement vectors",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "Peeq",
             "NodeData",
             "List of equivalent plastic strain values",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "MohrCoulomb",
             "NodeData",
             "List of Mohr Coulomb stress values",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "ReinforcementRatio_x",
             "NodeData",
             "Reinforcement ratio x-direction",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "ReinforcementRatio_y",
             "NodeData",
             "Reinforcement ratio y-direction",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "ReinforcementRatio_z",
             "NodeData",
             "Reinforcement ratio z-direction",
@@ -117,21 +130,21 @@ class ResultMechanical(base_fempythonobject.BaseFemPythonObject):
         # these three principal vectors are used only if there is a reinforced mat obj
         # https://forum.freecadweb.org/viewtopic.php?f=18&t=33106&p=416006#p416006
         obj.addProperty(
-            "App::PropertyVectorList",
+            vector_list,
             "PS1Vector",
             "NodeData",
             "List of 1st Principal Stress Vectors",
             True
         )
         obj.addProperty(
-            "App::PropertyVectorList",
+            vector_list,
             "PS2Vector",
             "NodeData",
             "List of 2nd Principal Stress Vectors",
             True
         )
         obj.addProperty(
-            "App::PropertyVectorList",
+            vector_list,
             "PS3Vector",
             "NodeData",
             "List of 3rd Principal Stress Vectors",
@@ -140,153 +153,153 @@ class ResultMechanical(base_fempythonobject.BaseFemPythonObject):
 
         # readonly in propertyEditor of comboView
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "DisplacementLengths",
             "NodeData",
             "List of displacement lengths",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "vonMises",
             "NodeData",
             "List of von Mises equivalent stresses",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "PrincipalMax",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "PrincipalMed",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "PrincipalMin",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "MaxShear",
             "NodeData",
             "List of Maximum Shear stress values",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "MassFlowRate",
             "NodeData",
             "List of mass flow rate values",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NetworkPressure",
             "NodeData",
             "List of network pressure values",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "UserDefined",
             "NodeData",
             "User Defined Results",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "Temperature",
             "NodeData",
             "Temperature field",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStressXX",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStressYY",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStressZZ",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStressXY",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStressXZ",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStressYZ",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStrainXX",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStrainYY",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStrainZZ",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStrainXY", "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStrainXZ",
             "NodeData",
             "",
             True
         )
         obj.addProperty(
-            "App::PropertyFloatList",
+            float_list,
             "NodeStrainYZ",
             "NodeData",
             "",
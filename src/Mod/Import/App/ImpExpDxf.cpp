@@ -64,6 +64,7 @@
 #include <App/Document.h>
 #include <App/Annotation.h>
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/Tools.h>
 
 using namespace Import;
 
@@ -77,6 +78,14 @@ ImpExpDxfRead::ImpExpDxfRead(std::string filepath, App::Document *pcDoc) : CDxfR
     setOptions();
 }
 
+ImpExpDxfRead::~ImpExpDxfRead()
+{
+    for (std::map<std::string,std::vector<Part::TopoShape*> >::iterator i = layers.begin(); i != layers.end(); ++i) {
+        for (std::vector<Part::TopoShape*>::iterator j = i->second.begin(); j != i->second.end(); ++j)
+            delete *j;
+    }
+}
+
 void ImpExpDxfRead::setOptions(void)
 {
     ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(getOptionSource().c_str());
@@ -208,7 +217,7 @@ void ImpExpDxfRead::OnReadInsert(const double* point, const double* scale, const
             BRep_Builder builder;
             TopoDS_Compound comp;
             builder.MakeCompound(comp);
-            std::vector<Part::TopoShape*> v = i->second;
+            const std::vector<Part::TopoShape*>& v = i->second;
             for(std::vector<Part::TopoShape*>::const_iterator j = v.begin(); j != v.end(); ++j) { 
                 const TopoDS_Shape& sh = (*j)->getShape();
                 if (!sh.IsNull())
@@ -243,13 +252,10 @@ void ImpExpDxfRead::OnReadDimension(const double* s, const double* e, const doub
 void ImpExpDxfRead::AddObject(Part::TopoShape *shape)
 {
     //std::cout << "layer:" << LayerName() << std::endl;
-    std::vector <Part::TopoShape*> vec;
-    if (layers.count(LayerName()))
-        vec = layers[LayerName()];
-    vec.push_back(shape);
-    layers[LayerName()] = vec;
+    std::string layer = LayerName();
+    layers[layer].push_back(shape);
     if (!optionGroupLayers) {
-        if(LayerName().substr(0, 6) != "BLOCKS") {
+        if(layer.compare(0, 6, "BLOCKS") != 0) {
             Part::Feature *pcFeature = (Part::Feature *)document->addObject("Part::Feature", "Shape");
             pcFeature->Shape.setValue(shape->getShape());
         }
@@ -306,7 +312,7 @@ void ImpExpDxfRead::AddGraphics() const
             std::string k = i->first;
             if (k == "0") // FreeCAD doesn't like an object name being '0'...
                 k = "LAYER_0";
-            std::vector<Part::TopoShape*> v = i->second;
+            const std::vector<Part::TopoShape*>& v = i->second;
             if(k.substr(0, 6) != "BLOCKS") {
                 for(std::vector<Part::TopoShape*>::const_iterator j = v.begin(); j != v.end(); ++j) { 
                     const TopoDS_Shape& sh = (*j)->getShape();
@@ -366,94 +372,18 @@ void ImpExpDxfWrite::setOptions(void)
 void ImpExpDxfWrite::exportShape(const TopoDS_Shape input)
 {
     //export Edges
-    TopExp_Explorer edges(input, TopAbs_EDGE);
-    for (int i = 1 ; edges.More(); edges.Next(),i++) {
-        const TopoDS_Edge& edge = TopoDS::Edge(edges.Current());
-        BRepAdaptor_Curve adapt(edge);
-        if (adapt.GetType() == GeomAbs_Circle) {
-            double f = adapt.FirstParameter();
-            double l = adapt.LastParameter();
-            gp_Pnt s = adapt.Value(f);
-            gp_Pnt e = adapt.Value(l);
-            if (fabs(l-f) > 1.0 && s.SquareDistance(e) < 0.001) {
-                exportCircle(adapt);
-            } else {
-                exportArc(adapt);
-            }
-        } else if (adapt.GetType() == GeomAbs_Ellipse) {
-            double f = adapt.FirstParameter();
-            double l = adapt.LastParameter();
-            gp_Pnt s = adapt.Value(f);
-            gp_Pnt e = adapt.Value(l);
-            if (fabs(l-f) > 1.0 && s.SquareDistance(e) < 0.001) {
-                if (m_polyOverride) {
-                    if (m_version >= 14) {
-                        exportLWPoly(adapt);
-                    } else {           //m_version < 14
-                        exportPolyline(adapt);
-                    }
-                } else if (optionPolyLine) {
-                    if (m_version >= 14) {
-                        exportLWPoly(adapt);
-                    } else {           //m_version < 14
-                        exportPolyline(adapt);
-                    }
-                } else {                                  //no overrides, do what's right!
-                    if (m_version < 14) {
-                        exportPolyline(adapt);
-                    } else {
-                    exportEllipse(adapt);
-                    }
-                }
-            } else {                                     // it's an arc
-                if (m_polyOverride) {
-                    if (m_version >= 14) {
-                        exportLWPoly(adapt);
-                    } else {           //m_version < 14
-                        exportPolyline(adapt);
-                    }
-                } else if (optionPolyLine) {
-                    if (m_version >= 14) {
-                        exportLWPoly(adapt);
-                    } else {           //m_version < 14
-                        exportPolyline(adapt);
-                    }
-                } else {                                  //no overrides, do what's right!
-                    if (m_version < 14) {
-                        exportPolyline(adapt);
-                    } else {
-                        exportEllipseArc(adapt);
-                    }
-                }
-            }
-        } else if (adapt.GetType() == GeomAbs_BSplineCurve) {
-                if (m_polyOverride) {
-                    if (m_version >= 14) {
-                        exportLWPoly(adapt);
-                    } else {           //m_version < 14
-                        exportPolyline(adapt);
-                    }
-                } else if (optionPolyLine) {
-                    if (m_version >= 14) {
-                        exportLWPoly(adapt);
-                    } else {           //m_version < 14
-                        exportPolyline(adapt);
-                    }
-                } else {                                  //no overrides, do what's right!
-                    if (m_version < 14) {
-                        exportPolyline(adapt);
-                    } else {
-                        exportBSpline(adapt);
-                    }
-                }
-        } else if (adapt.GetType() == GeomAbs_BezierCurve) {
-            exportBCurve(adapt);
-        } else if (adapt.GetType() == GeomAbs_Line) {
-            exportLine(adapt);
-        } else {
-            Base::Console().Warning("ImpExpDxf - unknown curve type: %d\n",adapt.GetType());
-        }
-    }
+    std::vector<TopoDS_Edge> edgeList;
+    for (TopExp_Explorer edges(input, TopAbs_EDGE); edges.More(); edges.Next())
+        edgeList.push_back(TopoDS::Edge(edges.Current()));
+
+    // the edges are approximated and discretized in parallel, only writing them
+    // keeps the order because of the entity handles
+    std::vector<EdgeEntity> entities(edgeList.size());
+    Part::Tools::parallelFor(edgeList.size(), [&](std::size_t i) {
+        prepareEdge(edgeList[i], entities[i]);
+    });
+    for (const auto& entity : entities)
+        writeEdge(entity);
 
     if (optionExpPoints) {
         TopExp_Explorer verts(input, TopAbs_VERTEX);
@@ -501,76 +431,152 @@ bool ImpExpDxfWrite::gp_PntCompare(gp_Pnt p1, gp_Pnt p2)
 }
 
 
-void ImpExpDxfWrite::exportCircle(BRepAdaptor_Curve& c)
+void ImpExpDxfWrite::prepareEdge(const TopoDS_Edge& edge, EdgeEntity& entity) const
+{
+    BRepAdaptor_Curve adapt(edge);
+    // a closed ellipse, an elliptic arc or a B-spline is written as polyline if requested
+    // or if the version doesn't support the entity
+    bool asPolyline = m_polyOverride || optionPolyLine || m_version < 14;
+    if (adapt.GetType() == GeomAbs_Circle) {
+        double f = adapt.FirstParameter();
+        double l = adapt.LastParameter();
+        gp_Pnt s = adapt.Value(f);
+        gp_Pnt e = adapt.Value(l);
+        if (fabs(l-f) > 1.0 && s.SquareDistance(e) < 0.001) {
+            exportCircle(adapt, entity);
+        } else {
+            exportArc(adapt, entity);
+        }
+    } else if (adapt.GetType() == GeomAbs_Ellipse) {
+        double f = adapt.FirstParameter();
+        double l = adapt.LastParameter();
+        gp_Pnt s = adapt.Value(f);
+        gp_Pnt e = adapt.Value(l);
+        if (asPolyline) {
+            exportPolyline(adapt, entity);
+        } else if (fabs(l-f) > 1.0 && s.SquareDistance(e) < 0.001) {
+            exportEllipse(adapt, entity);
+        } else {                                     // it's an arc
+            exportEllipseArc(adapt, entity);
+        }
+    } else if (adapt.GetType() == GeomAbs_BSplineCurve) {
+        if (asPolyline) {
+            exportPolyline(adapt, entity);
+        } else {
+            exportBSpline(adapt, entity);
+        }
+    } else if (adapt.GetType() == GeomAbs_BezierCurve) {
+        entity.type = EdgeEntity::BCurve;
+    } else if (adapt.GetType() == GeomAbs_Line) {
+        exportLine(adapt, entity);
+    } else {
+        entity.type = EdgeEntity::Unknown;
+        entity.curveType = adapt.GetType();
+    }
+}
+
+void ImpExpDxfWrite::writeEdge(const EdgeEntity& entity)
+{
+    switch (entity.type) {
+    case EdgeEntity::Circle:
+        writeCircle(entity.center, entity.radius);
+        break;
+    case EdgeEntity::Arc:
+        writeArc(entity.start, entity.end, entity.center, entity.dir);
+        break;
+    case EdgeEntity::Ellipse:
+        writeEllipse(entity.center, entity.major, entity.minor, entity.rotation,
+                     entity.startAngle, entity.endAngle, entity.dir);
+        break;
+    case EdgeEntity::Spline:
+        writeSpline(entity.spline);
+        break;
+    case EdgeEntity::Line:
+        writeLine(entity.start, entity.end);
+        break;
+    case EdgeEntity::Polyline:
+        if (entity.poly.nVert > 0) {
+            if (m_version >= 14)
+                writeLWPolyLine(entity.poly);
+            else
+                writePolyline(entity.poly);
+        }
+        break;
+    case EdgeEntity::BCurve:
+        Base::Console().Message("BCurve dxf export not yet supported\n");
+        break;
+    case EdgeEntity::Unknown:
+        Base::Console().Warning("ImpExpDxf - unknown curve type: %d\n", entity.curveType);
+        break;
+    }
+}
+
+void ImpExpDxfWrite::exportCircle(BRepAdaptor_Curve& c, EdgeEntity& entity) const
 {
     gp_Circ circ = c.Circle();
     gp_Pnt p = circ.Location();
-    double center[3] = {0,0,0};
-    gPntToTuple(center, p);
+    gPntToTuple(entity.center, p);
 
-    double  radius = circ.Radius();
-
-    writeCircle(center, radius);
+    entity.radius = circ.Radius();
+    entity.type = EdgeEntity::Circle;
 }
 
-void ImpExpDxfWrite::exportEllipse(BRepAdaptor_Curve& c)
+void ImpExpDxfWrite::exportEllipse(BRepAdaptor_Curve& c, EdgeEntity& entity) const
 {
     gp_Elips ellp = c.Ellipse();
     gp_Pnt p = ellp.Location();
-    double center[3] = {0,0,0};
-    gPntToTuple(center, p);
+    gPntToTuple(entity.center, p);
 
-    double major = ellp.MajorRadius();
-    double minor = ellp.MinorRadius();
+    entity.major = ellp.MajorRadius();
+    entity.minor = ellp.MinorRadius();
 
     gp_Dir xaxis = ellp.XAxis().Direction();       //direction of major axis
     //rotation appears to be the clockwise(?) angle between major & +Y??
-    double rotation = xaxis.AngleWithRef(gp_Dir(0, 1, 0), gp_Dir(0, 0, 1));
-    
+    entity.rotation = xaxis.AngleWithRef(gp_Dir(0, 1, 0), gp_Dir(0, 0, 1));
+
     //2*M_PI = 6.28319 is invalid(doesn't display in LibreCAD), but 2PI = 6.28318 is valid!
     //writeEllipse(center, major, minor, rotation, 0.0, 2 * M_PI, true );
-    writeEllipse(center, major, minor, rotation, 0.0, 6.28318, true );
+    entity.startAngle = 0.0;
+    entity.endAngle = 6.28318;
+    entity.dir = true;
+    entity.type = EdgeEntity::Ellipse;
 }
 
-void ImpExpDxfWrite::exportArc(BRepAdaptor_Curve& c)
+void ImpExpDxfWrite::exportArc(BRepAdaptor_Curve& c, EdgeEntity& entity) const
 {
     gp_Circ circ = c.Circle();
     gp_Pnt p = circ.Location();
-    double center[3] = {0,0,0};
-    gPntToTuple(center, p);
+    gPntToTuple(entity.center, p);
 
     double f = c.FirstParameter();
     double l = c.LastParameter();
     gp_Pnt s = c.Value(f);
-    double start[3];
-    gPntToTuple(start, s);
+    gPntToTuple(entity.start, s);
     gp_Pnt m = c.Value((l+f)/2.0);
     gp_Pnt e = c.Value(l);
-    double end[3] = {0,0,0};
-    gPntToTuple(end, e);
+    gPntToTuple(entity.end, e);
 
     gp_Vec v1(m,s);
     gp_Vec v2(m,e);
     gp_Vec v3(0,0,1);
     double a = v3.DotCross(v1,v2);
 
-    bool dir = (a < 0) ? true: false;
-    writeArc(start, end, center, dir );
+    entity.dir = (a < 0) ? true: false;
+    entity.type = EdgeEntity::Arc;
 }
 
-void ImpExpDxfWrite::exportEllipseArc(BRepAdaptor_Curve& c)
+void ImpExpDxfWrite::exportEllipseArc(BRepAdaptor_Curve& c, EdgeEntity& entity) const
 {
     gp_Elips ellp = c.Ellipse();
     gp_Pnt p = ellp.Location();
-    double center[3] = {0,0,0};
-    gPntToTuple(center, p);
+    gPntToTuple(entity.center, p);
 
-    double major = ellp.MajorRadius();
-    double minor = ellp.MinorRadius();
+    entity.major = ellp.MajorRadius();
+    entity.minor = ellp.MinorRadius();
 
     gp_Dir xaxis = ellp.XAxis().Direction();       //direction of major axis
     //rotation appears to be the clockwise angle between major & +Y??
-    double rotation = xaxis.AngleWithRef(gp_Dir(0, 1, 0), gp_Dir(0, 0, 1));
+    entity.rotation = xaxis.AngleWithRef(gp_Dir(0, 1, 0), gp_Dir(0, 0, 1));
 
     double f = c.FirstParameter();
     double l = c.LastParameter();
@@ -595,12 +601,15 @@ void ImpExpDxfWrite::exportEllipseArc(BRepAdaptor_Curve& c)
         endAngle   = -endAngle;
     }
 
-    writeEllipse(center, major, minor, rotation, startAngle, endAngle, endIsCW);
+    entity.startAngle = startAngle;
+    entity.endAngle = endAngle;
+    entity.dir = endIsCW;
+    entity.type = EdgeEntity::Ellipse;
 }
 
-void ImpExpDxfWrite::exportBSpline(BRepAdaptor_Curve& c)
+void ImpExpDxfWrite::exportBSpline(BRepAdaptor_Curve& c, EdgeEntity& entity) const
 {
-    SplineDataOut sd;
+    SplineDataOut& sd = entity.spline;
     Handle(Geom_BSplineCurve) spline;
     double f,l;
     gp_Pnt s,ePt;
@@ -620,8 +629,8 @@ void ImpExpDxfWrite::exportBSpline(BRepAdaptor_Curve& c)
             l = c.LastParameter();
             s = c.Value(f);
             ePt = c.Value(l);
-            Base::Console().Message("DxfWrite::exportBSpline - no result- from:(%.3f,%.3f) to:(%.3f,%.3f) poles: %d\n",
-                                 s.X(),s.Y(),ePt.X(),ePt.Y(),spline->NbPoles());
+            Base::Console().Message("DxfWrite::exportBSpline - no result- from:(%.3f,%.3f) to:(%.3f,%.3f)\n",
+                                 s.X(),s.Y(),ePt.X(),ePt.Y());
             TColgp_Array1OfPnt controlPoints(0,1);
             controlPoints.SetValue(0,s);
             controlPoints.SetValue(1,ePt);
@@ -669,57 +678,24 @@ void ImpExpDxfWrite::exportBSpline(BRepAdaptor_Curve& c)
         sd.control.push_back(gPntTopoint3D(poles(i)));
     }
     //OCC doesn't have separate lists for control points and fit points. 
-    
-    writeSpline(sd);
-}
 
-void ImpExpDxfWrite::exportBCurve(BRepAdaptor_Curve& c)
-{
-    (void) c;
-    Base::Console().Message("BCurve dxf export not yet supported\n");
+    entity.type = EdgeEntity::Spline;
 }
 
-void ImpExpDxfWrite::exportLine(BRepAdaptor_Curve& c)
+void ImpExpDxfWrite::exportLine(BRepAdaptor_Curve& c, EdgeEntity& entity) const
 {
     double f = c.FirstParameter();
     double l = c.LastParameter();
     gp_Pnt s = c.Value(f);
-    double start[3] = {0,0,0};
-    gPntToTuple(start, s);
+    gPntToTuple(entity.start, s);
     gp_Pnt e = c.Value(l);
-    double end[3] = {0,0,0};
-    gPntToTuple(end, e);
-    writeLine(start, end);
-}
-
-void ImpExpDxfWrite::exportLWPoly(BRepAdaptor_Curve& c)
-{
-    LWPolyDataOut pd;
-    pd.Flag = c.IsClosed();
-    pd.Elev = 0.0;
-    pd.Thick = 0.0;
-    pd.Extr.x = 0.0;
-    pd.Extr.y = 0.0;
-    pd.Extr.z = 1.0;
-    pd.nVert = 0;
-
-    GCPnts_UniformAbscissa discretizer;
-    discretizer.Initialize (c, optionMaxLength);
-    std::vector<point3D> points;
-    if (discretizer.IsDone () && discretizer.NbPoints () > 0) {
-        int nbPoints = discretizer.NbPoints ();
-        for (int i=1; i<=nbPoints; i++) {
-            gp_Pnt p = c.Value (discretizer.Parameter (i));
-            pd.Verts.push_back(gPntTopoint3D(p));
-        }
-        pd.nVert = discretizer.NbPoints ();
-        writeLWPolyLine(pd);
-    }
+    gPntToTuple(entity.end, e);
+    entity.type = EdgeEntity::Line;
 }
 
-void ImpExpDxfWrite::exportPolyline(BRepAdaptor_Curve& c)
+void ImpExpDxfWrite::exportPolyline(BRepAdaptor_Curve& c, EdgeEntity& entity) const
 {
-    LWPolyDataOut pd;
+    LWPolyDataOut& pd = entity.poly;
     pd.Flag = c.IsClosed();
     pd.Elev = 0.0;
     pd.Thick = 0.0;
@@ -730,16 +706,16 @@ void ImpExpDxfWrite::exportPolyline(BRepAdaptor_Curve& c)
 
     GCPnts_UniformAbscissa discretizer;
     discretizer.Initialize (c, optionMaxLength);
-    std::vector<point3D> points;
     if (discretizer.IsDone () && discretizer.NbPoints () > 0) {
         int nbPoints = discretizer.NbPoints ();
+        pd.Verts.reserve(nbPoints);
         for (int i=1; i<=nbPoints; i++) {
             gp_Pnt p = c.Value (discretizer.Parameter (i));
             pd.Verts.push_back(gPntTopoint3D(p));
         }
         pd.nVert = discretizer.NbPoints ();
-        writePolyline(pd);
     }
+    entity.type = EdgeEntity::Polyline;
 }
 
 void ImpExpDxfWrite::exportText(const char* text, Base::Vector3d position1, Base::Vector3d position2, double size, int just)
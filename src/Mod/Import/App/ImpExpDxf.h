@@ -29,6 +29,7 @@
 #include <gp_Pnt.hxx>
 
 class BRepAdaptor_Curve;
+class TopoDS_Edge;
 
 namespace Import
 {
@@ -36,6 +37,7 @@ namespace Import
     {
     public:
         ImpExpDxfRead(std::string filepath, App::Document *pcDoc);
+        ~ImpExpDxfRead();
     
         // CDxfRead's virtual functions
         void OnReadLine(const double* s, const double* e, bool hidden);
@@ -100,15 +102,36 @@ namespace Import
         static bool gp_PntCompare(gp_Pnt p1, gp_Pnt p2);
 
     protected:
-        void exportCircle(BRepAdaptor_Curve& c);
-        void exportEllipse(BRepAdaptor_Curve& c);
-        void exportArc(BRepAdaptor_Curve& c);
-        void exportEllipseArc(BRepAdaptor_Curve& c);
-        void exportBSpline(BRepAdaptor_Curve& c);
-        void exportBCurve(BRepAdaptor_Curve& c);
-        void exportLine(BRepAdaptor_Curve& c);
-        void exportLWPoly(BRepAdaptor_Curve& c);   //LWPolyline not supported in R12?
-        void exportPolyline(BRepAdaptor_Curve& c);
+        /// the data of an edge, prepared in parallel with the other edges before it is written
+        struct EdgeEntity {
+            enum Type { Unknown, Circle, Arc, Ellipse, Spline, Line, Polyline, BCurve };
+            Type type = Unknown;
+            int curveType = 0;
+            double center[3] = {0,0,0};
+            double start[3] = {0,0,0};
+            double end[3] = {0,0,0};
+            double radius = 0.0;
+            double major = 0.0;
+            double minor = 0.0;
+            double rotation = 0.0;
+            double startAngle = 0.0;
+            double endAngle = 0.0;
+            bool dir = false;
+            SplineDataOut spline;
+            LWPolyDataOut poly;
+        };
+
+        void prepareEdge(const TopoDS_Edge& edge, EdgeEntity& entity) const;
+        void writeEdge(const EdgeEntity& entity);
+
+        void exportCircle(BRepAdaptor_Curve& c, EdgeEntity& entity) const;
+        void exportEllipse(BRepAdaptor_Curve& c, EdgeEntity& entity) const;
+        void exportArc(BRepAdaptor_Curve& c, EdgeEntity& entity) const;
+        void exportEllipseArc(BRepAdaptor_Curve& c, EdgeEntity& entity) const;
+        void exportBSpline(BRepAdaptor_Curve& c, EdgeEntity& entity) const;
+        void exportLine(BRepAdaptor_Curve& c, EdgeEntity& entity) const;
+        // written as LWPolyline, or as Polyline for R12
+        void exportPolyline(BRepAdaptor_Curve& c, EdgeEntity& entity) const;
 
 //        std::string m_optionSource;
         double optionMaxLength;
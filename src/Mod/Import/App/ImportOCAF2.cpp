@@ -158,6 +158,7 @@ ImportOCAF2::ImportOCAF2(Handle(TDocStd_Document) h, App::Document* d, const std
     reduceObjects = hGrp->GetBool("ReduceObjects",true);
     showProgress = hGrp->GetBool("ShowProgress",true);
     expandCompound = hGrp->GetBool("ExpandCompound",true);
+    linkInstances = hGrp->GetBool("LinkInstances",false);
 
     if(d->isSaved()) {
         Base::FileInfo fi(d->FileName.getValue());
@@ -230,10 +231,23 @@ void ImportOCAF2::setObjectName(Info &info, TDF_Label label) {
 }
 
 
-bool ImportOCAF2::getColor(const TopoDS_Shape &shape, Info &info, bool check, bool noDefault) {
+bool ImportOCAF2::getColor(const TopoDS_Shape &shape, Info &info,
+        bool check, bool noDefault, TDF_Label label)
+{
+    // Querying the color by shape searches the label of the shape for every
+    // color type. Do the search only once, or not at all if the caller has
+    // already found the label.
+    if(label.IsNull())
+        aShapeTool->Search(shape,label,Standard_True,Standard_True,Standard_False);
+    auto queryColor = [&](XCAFDoc_ColorType type, Quantity_Color &color) {
+        if(label.IsNull())
+            return aColorTool->GetColor(shape,type,color);
+        return aColorTool->GetColor(label,type,color);
+    };
+
     bool ret = false;
     Quantity_Color aColor;
-    if(aColorTool->GetColor(shape, XCAFDoc_ColorSurf, aColor)) {
+    if(queryColor(XCAFDoc_ColorSurf, aColor)) {
         App::Color c(aColor.Red(),aColor.Green(),aColor.Blue());
         if(!check || info.faceColor!=c) {
             info.faceColor = c;
@@ -241,7 +255,7 @@ bool ImportOCAF2::getColor(const TopoDS_Shape &shape, Info &info, bool check, bo
             ret = true;
         }
     }
-    if(!noDefault && !info.hasFaceColor && aColorTool->GetColor(shape, XCAFDoc_ColorGen, aColor)) {
+    if(!noDefault && !info.hasFaceColor && queryColor(XCAFDoc_ColorGen, aColor)) {
         App::Color c(aColor.Red(),aColor.Green(),aColor.Blue());
         if(!check || info.faceColor!=c) {
             info.faceColor = c;
@@ -249,7 +263,7 @@ bool ImportOCAF2::getColor(const TopoDS_Shape &shape, Info &info, bool check, bo
             ret = true;
         }
     }
-    if(aColorTool->GetColor(shape, XCAFDoc_ColorCurv, aColor)) {
+    if(queryColor(XCAFDoc_ColorCurv, aColor)) {
         App::Color c(aColor.Red(),aColor.Green(),aColor.Blue());
         // Some STEP include a curve color with the same value of the face
         // color. And this will look weird in FC. So for shape with face
@@ -331,7 +345,7 @@ bool ImportOCAF2::createObject(App::Document *doc, TDF_Label label,
         return false;
     }
 
-    getColor(shape,info);
+    getColor(shape,info,false,false,label);
     bool hasFaceColors = false;
     bool hasEdgeColors = false;
 
@@ -679,6 +693,10 @@ App::DocumentObject *ImportOCAF2::loadShape(App::Document *doc,
         if(!res)
             return 0;
         setObjectName(info,baseLabel);
+        // With linkInstances, every occurrence of the shape becomes a link
+        // to this object, so hide it to not show the prototype twice.
+        if(linkInstances)
+            info.obj->Visibility.setValue(false);
         it = myShapes.emplace(baseShape,info).first;
     }
     if(baseOnly)
@@ -689,9 +707,11 @@ App::DocumentObject *ImportOCAF2::loadShape(App::Document *doc,
         getSHUOColors(label,shuoColors,false);
 
     auto info = it->second;
-    getColor(shape,info,true);
+    getColor(shape,info,true,false,label);
 
-    if(shuoColors.empty() && info.free && doc==info.obj->getDocument()) {
+    if(shuoColors.empty() && info.free && !linkInstances
+            && doc==info.obj->getDocument())
+    {
         it->second.free = false;
         auto name = getLabelName(label);
         if(info.faceColor!=it->second.faceColor ||
@@ -783,7 +803,8 @@ bool ImportOCAF2::createAssembly(App::Document *_doc,
         childInfo.labels.push_back(childLabel);
         childInfo.plas.emplace_back(Part::TopoShape::convert(childShape.Location().Transformation()));
         Quantity_Color aColor;
-        if (aColorTool->GetColor(childShape, XCAFDoc_ColorSurf, aColor)) {
+        if (childLabel.IsNull() ? aColorTool->GetColor(childShape, XCAFDoc_ColorSurf, aColor)
+                                : aColorTool->GetColor(childLabel, XCAFDoc_ColorSurf, aColor)) {
             auto &color = childInfo.colors[childInfo.plas.size()-1];
             color.r = (float)aColor.Red();
             color.g = (float)aColor.Green();
@@ -1094,6 +1115,7 @@ void ExportOCAF2::exportObjects(std::vector<App::DocumentObject*> &objs, const c
     if(objs.empty())
         return;
     myObjects.clear();
+    myShapes.clear();
     myNames.clear();
     mySetups.clear();
     if(objs.size()==1)
@@ -1201,17 +1223,23 @@ TDF_Label ExportOCAF2::exportObject(App::DocumentObject* parentObj,
     if(subs.empty()) {
 
         if(!parent.IsNull()) {
-            // Search for non-located shape to see if we've stored the original shape before
-            if(!aShapeTool->FindShape(shape.getShape(),label)) {
+            // Search for non-located shape to see if we've stored the original
+            // shape before. Use our own map instead of ShapeTool::FindShape(),
+            // which scans all free shapes of the document, and thus makes the
+            // export quadratic in the number of unique parts.
+            auto &shapeLabel = myShapes[shape.getShape().Located(TopLoc_Location())];
+            if(shapeLabel.IsNull()) {
                 auto baseShape = linkedShape;
                 auto linked = links.empty()?obj:links.back();
                 baseShape.setShape(baseShape.getShape().Located(TopLoc_Location()));
-                label = aShapeTool->NewShape();
-                aShapeTool->SetShape(label,baseShape.getShape());
-                setupObject(label,linked,baseShape,prefix);
+                shapeLabel = aShapeTool->NewShape();
+                aShapeTool->SetShape(shapeLabel,baseShape.getShape());
+                setupObject(shapeLabel,linked,baseShape,prefix);
             }
 
-            label = aShapeTool->AddComponent(parent,shape.getShape(),Standard_False);
+            // Add the component by its referred label, because adding it by
+            // shape searches the free shapes again.
+            label = aShapeTool->AddComponent(parent,shapeLabel,shape.getShape().Location());
             setupObject(label,name?parentObj:obj,shape,prefix,name);
 
         }else{
@@ -80,6 +80,7 @@ public:
     void setReduceObjects(bool enable) {reduceObjects=enable;}
     void setShowProgress(bool enable) {showProgress=enable;}
     void setExpandCompound(bool enable) {expandCompound=enable;}
+    void setLinkInstances(bool enable) {linkInstances=enable;}
 
     enum ImportMode {
         SingleDoc = 0,
@@ -114,7 +115,8 @@ private:
     bool createGroup(App::Document *doc, Info &info, 
             const TopoDS_Shape &shape, std::vector<App::DocumentObject*> &children, 
             const boost::dynamic_bitset<> &visibilities, bool canReduce=false);
-    bool getColor(const TopoDS_Shape &shape, Info &info, bool check=false, bool noDefault=false);
+    bool getColor(const TopoDS_Shape &shape, Info &info, bool check=false,
+            bool noDefault=false, TDF_Label label=TDF_Label());
     void getSHUOColors(TDF_Label label, std::map<std::string,App::Color> &colors, bool appendFirst);
     void setObjectName(Info &info, TDF_Label label);
     std::string getLabelName(TDF_Label label);
@@ -153,6 +155,7 @@ private:
     bool reduceObjects;
     bool showProgress;
     bool expandCompound;
+    bool linkInstances;
 
     int mode;
     std::string filePath;
@@ -194,6 +197,9 @@ private:
 
     std::unordered_map<App::DocumentObject *, TDF_Label> myObjects;
 
+    // Labels of the exported non-located leaf shapes
+    std::unordered_map<TopoDS_Shape, TDF_Label, ShapeHasher> myShapes;
+
     std::unordered_map<TDF_Label, std::vector<std::string>, LabelHasher> myNames;
 
     std::set<std::pair<App::DocumentObject*,std::string> > mySetups;
@@ -241,10 +241,16 @@ public:
     void makeBlockSectionHead(void);
 };
 
+class QFile;
+
 // derive a class from this and implement it's virtual functions
 class ImportExport CDxfRead{
 private:
-    std::ifstream* m_ifs;
+    QFile* m_file;
+    std::vector<char> m_buffer; // the file content, if the file can't be mapped
+    const char* m_pos;          // the next line to read
+    const char* m_end;
+    bool m_eof;
 
     bool m_fail;
     char m_str[1024];
@@ -280,6 +286,8 @@ private:
     bool ReadBlockInfo();
 
     void get_line();
+    bool get_value(int& value) const;    // parses the current line
+    bool get_value(double& value) const;
     void put_line(const char *value);
     void DerefACI();
 
@@ -22,18 +22,33 @@
 
 
 #include "PreCompiled.h"
+#include <cfloat>
 #include <numeric>
 #include <gp_Pnt.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
+#include <BRepClass_FaceClassifier.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepGProp_Face.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepTools.hxx>
+#include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
+#include <Extrema_ExtPS.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Vertex.hxx>
 
 #include <QEventLoop>
 #include <QFuture>
 #include <QFutureWatcher>
+#include <QThread>
 #include <QtConcurrentMap>
 
 #include <boost_bind_bind.hpp>
@@ -43,11 +58,13 @@
 #include <Base/FutureWatcherProgress.h>
 #include <Base/Parameter.h>
 #include <Base/Sequencer.h>
+#include <Base/TimeInfo.h>
 #include <Base/Tools.h>
 #include <App/Application.h>
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
@@ -104,6 +121,15 @@ Base::Vector3f InspectActualPoints::getPoint(unsigned long index) const
 
 // ----------------------------------------------------------------
 
+void InspectNominalGeometry::getDistances(const std::vector<Base::Vector3f>& points, std::vector<float>& dists) const
+{
+    dists.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); i++)
+        dists[i] = getDistance(points[i]);
+}
+
+// ----------------------------------------------------------------
+
 InspectActualShape::InspectActualShape(const Part::TopoShape& shape) : _rShape(shape)
 {
     ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
@@ -257,65 +283,78 @@ namespace Inspection {
     };
 }
 
-InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offset) : _mesh(rMesh.getKernel())
+InspectNominalMesh::InspectNominalMesh(const Mesh::MeshObject& rMesh, float offset)
+    : _mesh(rMesh.getKernel())
+    , _pTransformed(0)
 {
+    // The BVH works on the geometry of the kernel, so apply the placement to a copy
+    // of it instead to each facet for every query
     Base::Matrix4D tmp;
-    _clTrf = rMesh.getTransform();
-    _bApply = _clTrf != tmp;
-
-    // Max. limit of grid elements
-    float fMaxGridElements=8000000.0f;
-    Base::BoundBox3f box = _mesh.GetBoundBox().Transformed(rMesh.getTransform());
-
-    // estimate the minimum allowed grid length
-    float fMinGridLen = (float)pow((box.LengthX()*box.LengthY()*box.LengthZ()/fMaxGridElements), 0.3333f);
-    float fGridLen = 5.0f * MeshCore::MeshAlgorithm(_mesh).GetAverageEdgeLength();
-
-    // We want to avoid to get too small grid elements otherwise building up the grid structure would take
-    // too much time and memory. 
-    // Having quite a dense grid speeds up more the following algorithms extremely. Due to the issue above it's
-    // always a compromise between speed and memory usage.
-    fGridLen = std::max<float>(fMinGridLen, fGridLen);
+    Base::Matrix4D trf = rMesh.getTransform();
+    const MeshCore::MeshKernel* kernel = &_mesh;
+    if (trf != tmp) {
+        _pTransformed = new MeshCore::MeshKernel(_mesh);
+        _pTransformed->Transform(trf);
+        kernel = _pTransformed;
+    }
 
-    // build up grid structure to speed up algorithms
-    _pGrid = new MeshInspectGrid(_mesh, fGridLen, rMesh.getTransform());
-    _box = box;
+    // In contrast to a regular grid the BVH adapts to the facet density of the mesh
+    // and thus doesn't degenerate on scans with very fine and very coarse regions.
+    _pBVH = new MeshCore::MeshFacetBVH(*kernel);
+    _box = kernel->GetBoundBox();
     _box.Enlarge(offset);
+
+    // every point inside the box has a nearest facet within this distance
+    _fMaxDist = _box.CalcDiagonalLength();
 }
 
 InspectNominalMesh::~InspectNominalMesh()
 {
-    delete this->_pGrid;
+    delete this->_pBVH;
+    delete this->_pTransformed;
 }
 
 float InspectNominalMesh::getDistance(const Base::Vector3f& point) const
 {
-    if (!_box.IsInBox(point))
-        return FLT_MAX; // must be inside bbox
+    unsigned long hint = ULONG_MAX;
+    return getDistance(point, hint);
+}
 
-    std::vector<unsigned long> indices;
-    //_pGrid->GetElements(point, indices);
-    if (indices.empty()) {
-        std::set<unsigned long> inds;
-        _pGrid->MeshGrid::SearchNearestFromPoint(point, inds);
-        indices.insert(indices.begin(), inds.begin(), inds.end());
-    }
+void InspectNominalMesh::getDistances(const std::vector<Base::Vector3f>& points, std::vector<float>& dists) const
+{
+    // Neighbouring points of a batch mostly have the same or an adjacent nearest facet.
+    // So, the distance to the nearest facet of the previous point is a tight upper bound
+    // that lets the tree traversal skip most of its nodes from the very beginning.
+    dists.resize(points.size());
+    unsigned long hint = ULONG_MAX;
+    for (std::size_t i = 0; i < points.size(); i++)
+        dists[i] = getDistance(points[i], hint);
+}
 
-    float fMinDist=FLT_MAX;
-    bool positive = true;
-    for (std::vector<unsigned long>::iterator it = indices.begin(); it != indices.end(); ++it) {
-        MeshCore::MeshGeomFacet geomFace = _mesh.GetFacet(*it);
-        if (_bApply) {
-            geomFace.Transform(_clTrf);
-        }
+float InspectNominalMesh::getDistance(const Base::Vector3f& point, unsigned long& hint) const
+{
+    if (!_box.IsInBox(point))
+        return FLT_MAX; // must be inside bbox
 
-        float fDist = geomFace.DistanceToPoint(point);
-        if (fabs(fDist) < fabs(fMinDist)) {
-            fMinDist = fDist;
-            positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
-        }
+    const MeshCore::MeshKernel& kernel = _pTransformed ? *_pTransformed : _mesh;
+    float fMaxDist = _fMaxDist;
+    if (hint != ULONG_MAX) {
+        // enlarge the bound a bit so that the hint itself is not lost due to rounding
+        float fHintDist = kernel.GetFacet(hint).DistanceToPoint(point);
+        fMaxDist = std::min<float>(fMaxDist, fHintDist * 1.001f + FLT_EPSILON);
     }
 
+    Base::Vector3f res;
+    float fMinDist;
+    unsigned long index = _pBVH->NearestFacet(point, fMaxDist, res, fMinDist);
+    if (index == ULONG_MAX && fMaxDist < _fMaxDist)
+        index = _pBVH->NearestFacet(point, _fMaxDist, res, fMinDist);
+    if (index == ULONG_MAX)
+        return FLT_MAX;
+    hint = index;
+
+    MeshCore::MeshGeomFacet geomFace = kernel.GetFacet(index);
+    bool positive = point.DistanceToPlane(geomFace._aclPoints[0], geomFace.GetNormal()) > 0;
     if (!positive)
         fMinDist = -fMinDist;
     return fMinDist;
@@ -438,9 +477,78 @@ float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 
 // ----------------------------------------------------------------
 
-InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radius*/)
+namespace Inspection {
+/**
+ * The tessellation of the nominal shape. It is used to quickly find the faces that
+ * are near to a point so that the exact distance must be computed only for them.
+ */
+struct InspectNominalShape::Proxy
+{
+    MeshCore::MeshKernel mesh;
+    MeshCore::MeshFacetBVH bvh;
+    /// the index of the face of each facet of the mesh
+    std::vector<int> faceOfFacet;
+    TopTools_IndexedMapOfShape faces;
+    double deflection;
+
+    bool build(const TopoDS_Shape& shape)
+    {
+        Bnd_Box bounds;
+        BRepBndLib::Add(shape, bounds);
+        if (bounds.IsVoid())
+            return false;
+
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Part");
+        float deviation = hGrp->GetFloat("MeshDeviation",0.2);
+
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        deflection = ((xMax-xMin) + (yMax-yMin) + (zMax-zMin))/300.0 * deviation;
+        BRepMesh_IncrementalMesh(shape, deflection);
+
+        MeshCore::MeshPointArray points;
+        MeshCore::MeshFacetArray facets;
+        TopExp::MapShapes(shape, TopAbs_FACE, faces);
+        for (int index = 1; index <= faces.Extent(); index++) {
+            const TopoDS_Face& face = TopoDS::Face(faces(index));
+            TopLoc_Location loc;
+            Handle(Poly_Triangulation) poly = BRep_Tool::Triangulation(face, loc);
+            if (poly.IsNull())
+                return false; // without the whole tessellation faces could be missed
+
+            unsigned long offset = points.size();
+            const TColgp_Array1OfPnt& nodes = poly->Nodes();
+            for (int i = nodes.Lower(); i <= nodes.Upper(); i++) {
+                gp_Pnt p = nodes(i).Transformed(loc.Transformation());
+                points.push_back(MeshCore::MeshPoint((float)p.X(), (float)p.Y(), (float)p.Z()));
+            }
+
+            const Poly_Array1OfTriangle& triangles = poly->Triangles();
+            for (int i = triangles.Lower(); i <= triangles.Upper(); i++) {
+                Standard_Integer n1, n2, n3;
+                triangles(i).Get(n1, n2, n3);
+                facets.push_back(MeshCore::MeshFacet(offset + n1 - nodes.Lower(),
+                                                     offset + n2 - nodes.Lower(),
+                                                     offset + n3 - nodes.Lower()));
+                faceOfFacet.push_back(index);
+            }
+        }
+
+        if (facets.empty())
+            return false;
+        mesh.Adopt(points, facets);
+        bvh.Attach(mesh);
+        return true;
+    }
+};
+}
+
+InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float radius)
     : _rShape(shape)
     , isSolid(false)
+    , radius(radius)
+    , proxy(0)
 {
     distss = new BRepExtrema_DistShapeShape();
     distss->LoadS1(_rShape);
@@ -457,15 +565,110 @@ InspectNominalShape::InspectNominalShape(const TopoDS_Shape& shape, float /*radi
 
     }
     //distss->SetDeflection(radius);
+
+    if (!_rShape.IsNull()) {
+        proxy = new Proxy();
+        try {
+            if (!proxy->build(_rShape)) {
+                delete proxy;
+                proxy = 0;
+            }
+        }
+        catch (const Standard_Failure&) {
+            delete proxy;
+            proxy = 0;
+        }
+    }
 }
 
 InspectNominalShape::~InspectNominalShape()
 {
+    delete proxy;
     delete distss;
 }
 
+float InspectNominalShape::getDistanceFromProxy(const Base::Vector3f& point) const
+{
+    // The nearest facet of the tessellation gives an upper bound of the distance to
+    // the shape. Every face whose tessellation is within this distance plus twice the
+    // deflection may contain the nearest point.
+    Base::Vector3f res;
+    float fDist;
+    float fMaxDist = radius + (float)proxy->deflection;
+    if (proxy->bvh.NearestFacet(point, fMaxDist, res, fDist) == ULONG_MAX)
+        return FLT_MAX;
+
+    std::vector<unsigned long> facets;
+    proxy->bvh.FacetsWithinDistance(point, fDist + 2.0f * (float)proxy->deflection, facets);
+    std::set<int> candidates;
+    for (std::vector<unsigned long>::iterator it = facets.begin(); it != facets.end(); ++it)
+        candidates.insert(proxy->faceOfFacet[*it]);
+
+    gp_Pnt pnt3d(point.x,point.y,point.z);
+    Standard_Real fMinDist = DBL_MAX;
+    bool positive = true;
+    for (std::set<int>::iterator it = candidates.begin(); it != candidates.end(); ++it) {
+        const TopoDS_Face& face = TopoDS::Face(proxy->faces(*it));
+        BRepAdaptor_Surface surface(face);
+        Standard_Real u1, u2, v1, v2;
+        BRepTools::UVBounds(face, u1, u2, v1, v2);
+
+        // search for the nearest extremum that lies inside the face
+        Standard_Real fFaceDist = DBL_MAX;
+        Standard_Real uMin = 0, vMin = 0;
+        const Standard_Real tol = Precision::Confusion();
+        Extrema_ExtPS ext(pnt3d, surface, u1, u2, v1, v2, tol, tol);
+        if (ext.IsDone()) {
+            for (int i = 1; i <= ext.NbExt(); i++) {
+                if (ext.SquareDistance(i) >= fFaceDist * fFaceDist)
+                    continue;
+                Standard_Real u, v;
+                ext.Point(i).Parameter(u, v);
+                BRepClass_FaceClassifier classifier(face, gp_Pnt2d(u, v), tol);
+                if (classifier.State() == TopAbs_IN || classifier.State() == TopAbs_ON) {
+                    fFaceDist = sqrt(ext.SquareDistance(i));
+                    uMin = u;
+                    vMin = v;
+                }
+            }
+        }
+
+        if (fFaceDist < DBL_MAX) {
+            if (fFaceDist < fMinDist) {
+                fMinDist = fFaceDist;
+                gp_Pnt pnt;
+                gp_Vec du, dv;
+                surface.D1(uMin, vMin, pnt, du, dv);
+                gp_Vec normal = du.Crossed(dv);
+                if (face.Orientation() == TopAbs_REVERSED)
+                    normal.Reverse();
+                positive = normal.Dot(gp_Vec(pnt, pnt3d)) >= 0;
+            }
+        }
+        else {
+            // the nearest point lies on the boundary of the face
+            BRepBuilderAPI_MakeVertex mkVert(pnt3d);
+            BRepExtrema_DistShapeShape dss(face, mkVert.Vertex());
+            if (dss.IsDone() && dss.NbSolution() > 0 && dss.Value() < fMinDist) {
+                fMinDist = dss.Value();
+                // use the tessellation to decide on which side the point is
+                unsigned long index = proxy->bvh.NearestFacet(point, fMaxDist, res, fDist);
+                MeshCore::MeshGeomFacet facet = proxy->mesh.GetFacet(index);
+                positive = point.DistanceToPlane(facet._aclPoints[0], facet.GetNormal()) >= 0;
+            }
+        }
+    }
+
+    if (fMinDist == DBL_MAX)
+        return FLT_MAX;
+    return positive ? (float)fMinDist : -(float)fMinDist;
+}
+
 float InspectNominalShape::getDistance(const Base::Vector3f& point) const
 {
+    if (proxy)
+        return getDistanceFromProxy(point);
+
     gp_Pnt pnt3d(point.x,point.y,point.z);
     BRepBuilderAPI_MakeVertex mkVert(pnt3d);
     distss->LoadS2(mkVert.Vertex());
@@ -692,19 +895,39 @@ struct DistanceInspection
 // Helper internal class for QtConcurrent map operation. Holds sums-of-squares and counts for RMS calculation
 class DistanceInspectionRMS {
 public:
-    DistanceInspectionRMS() : m_numv(0), m_sumsq(0.0) {}
+    DistanceInspectionRMS() : m_numv(0), m_sumsq(0.0), m_min(FLT_MAX), m_max(-FLT_MAX) {}
     DistanceInspectionRMS& operator += (const DistanceInspectionRMS& rhs)
     {
         this->m_numv += rhs.m_numv;
         this->m_sumsq += rhs.m_sumsq;
+        this->m_min = std::min(this->m_min, rhs.m_min);
+        this->m_max = std::max(this->m_max, rhs.m_max);
         return *this;
     }
+    void add(float dist)
+    {
+        this->m_sumsq += dist * dist;
+        this->m_numv++;
+        this->m_min = std::min(this->m_min, dist);
+        this->m_max = std::max(this->m_max, dist);
+    }
     double getRMS()
     {
+        if (this->m_numv == 0)
+            return 0.0;
         return sqrt(this->m_sumsq / (double)this->m_numv);
     }
-    int m_numv;
+    unsigned long m_numv;
     double m_sumsq;
+    float m_min, m_max;
+};
+
+// A range of points that is inspected by one task
+struct DistanceInspectionBlock {
+    unsigned long start;
+    unsigned long end;
+    bool done;
+    DistanceInspectionRMS res;
 };
 }
 
@@ -785,6 +1008,7 @@ App::DocumentObjectExecReturn* Feature::execute(void)
             inspectNominal.push_back(nominal);
     }
 
+    bool canceled = false;
 #if 0
 #if 1 // test with some huge data sets
     std::vector<unsigned long> index(actual->countPoints());
@@ -841,67 +1065,116 @@ App::DocumentObjectExecReturn* Feature::execute(void)
         this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), fRMS);
 #else
     unsigned long count = actual->countPoints();
-    std::vector<float> vals(count);
-    std::function<DistanceInspectionRMS(int)> fMap = [&](unsigned int index)
+    float fSearchRadius = this->SearchRadius.getValue();
+    // points that are not yet inspected are shown as outside of the search radius
+    std::vector<float> vals(count, FLT_MAX);
+    auto inspectBlock = [&](DistanceInspectionBlock& block)
     {
-        DistanceInspectionRMS res;
-        Base::Vector3f pnt = actual->getPoint(index);
-
-        float fMinDist = FLT_MAX;
+        // the nominals get the points of the whole block at once
+        std::vector<Base::Vector3f> points;
+        points.reserve(block.end - block.start);
+        for (unsigned long index = block.start; index < block.end; index++)
+            points.push_back(actual->getPoint(index));
+
+        std::vector<float> minDists(points.size(), FLT_MAX);
+        std::vector<float> dists;
         for (std::vector<InspectNominalGeometry*>::iterator it = inspectNominal.begin(); it != inspectNominal.end(); ++it) {
-            float fDist = (*it)->getDistance(pnt);
-            if (fabs(fDist) < fabs(fMinDist))
-                fMinDist = fDist;
+            (*it)->getDistances(points, dists);
+            for (std::size_t i = 0; i < points.size(); i++) {
+                if (fabs(dists[i]) < fabs(minDists[i]))
+                    minDists[i] = dists[i];
+            }
         }
 
-        if (fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = FLT_MAX;
+        for (unsigned long index = block.start; index < block.end; index++) {
+            float fMinDist = minDists[index - block.start];
+
+            if (fMinDist > fSearchRadius) {
+                fMinDist = FLT_MAX;
+            }
+            else if (-fMinDist > fSearchRadius) {
+                fMinDist = -FLT_MAX;
+            }
+            else {
+                block.res.add(fMinDist);
+            }
+
+            vals[index] = fMinDist;
         }
-        else if (-fMinDist > this->SearchRadius.getValue()) {
-            fMinDist = -FLT_MAX;
+        block.done = true;
+    };
+
+    // The points are inspected chunk by chunk. Between two chunks the running statistics and
+    // the distances computed so far are published, so that large inspections give feedback
+    // while they are running and can be canceled without losing the finished part.
+    const unsigned long blockSize = 1024;
+    const unsigned long chunkSize = std::max<unsigned long>(256 * blockSize, count / 100);
+    const float publishInterval = 2.0f;
+
+    std::stringstream str;
+    str << "Inspecting " << this->Label.getValue() << "...";
+    Base::ParallelSequencerLauncher seq(str.str().c_str(), count);
+    Base::TimeInfo lastPublish;
+
+    DistanceInspectionRMS res;
+    for (unsigned long chunk = 0; chunk < count && !seq.wasCanceled(); chunk += chunkSize) {
+        std::vector<DistanceInspectionBlock> blocks;
+        unsigned long chunkEnd = std::min(chunk + chunkSize, count);
+        for (unsigned long start = chunk; start < chunkEnd; start += blockSize) {
+            DistanceInspectionBlock block;
+            block.start = start;
+            block.end = std::min(start + blockSize, chunkEnd);
+            block.done = false;
+            blocks.push_back(block);
+        }
+
+        if (useMultithreading) {
+            QFuture<void> future = QtConcurrent::map(blocks, [&](DistanceInspectionBlock& block) {
+                if (seq.wasCanceled())
+                    return;
+                inspectBlock(block);
+                seq.next(block.end - block.start);
+            });
+            while (!future.isFinished()) {
+                seq.update(true);
+                QThread::msleep(20);
+            }
         }
         else {
-            res.m_sumsq += fMinDist * fMinDist;
-            res.m_numv++;
+            // Single-threaded operation
+            for (std::vector<DistanceInspectionBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+                if (seq.wasCanceled())
+                    break;
+                inspectBlock(*it);
+                seq.next(it->end - it->start);
+                seq.update(true);
+            }
         }
+        seq.update(true);
 
-        vals[index] = fMinDist;
-        return res;
-    };
-
-    DistanceInspectionRMS res;
+        for (std::vector<DistanceInspectionBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+            if (it->done)
+                res += it->res;
+        }
 
-    if (useMultithreading) {
-        // Build vector of increasing indices
-        std::vector<unsigned long> index(count);
-        std::iota(index.begin(), index.end(), 0);
-        // Perform map-reduce operation : compute distances and update sum of squares for RMS computation
-        QFuture<DistanceInspectionRMS> future = QtConcurrent::mappedReduced(
-            index, fMap, &DistanceInspectionRMS::operator+=);
-        // Setup progress bar
-        Base::FutureWatcherProgress progress("Inspecting...", actual->countPoints());
-        QFutureWatcher<DistanceInspectionRMS> watcher;
-        QObject::connect(&watcher, SIGNAL(progressValueChanged(int)),
-            &progress, SLOT(progressValueChanged(int)));
-        // Keep UI responsive during computation
-        QEventLoop loop;
-        QObject::connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
-        watcher.setFuture(future);
-        loop.exec();
-        res = future.result();
+        if (chunkEnd < count && !seq.wasCanceled() &&
+            Base::TimeInfo::diffTimeF(lastPublish) > publishInterval) {
+            Distances.setValues(vals);
+            Base::Console().Message("Inspecting '%s': %lu of %lu points, RMS %.4f, min %.4f, max %.4f\n",
+                this->Label.getValue(), chunkEnd, count, res.getRMS(),
+                res.m_numv > 0 ? res.m_min : 0.0f, res.m_numv > 0 ? res.m_max : 0.0f);
+            lastPublish.setCurrent();
+        }
     }
-    else {
-        // Single-threaded operation
-        std::stringstream str;
-        str << "Inspecting " << this->Label.getValue() << "...";
-        Base::SequencerLauncher seq(str.str().c_str(), count);
 
-        for (unsigned int i = 0; i < count; i++)
-            res += fMap(i);
+    canceled = seq.wasCanceled();
+    if (canceled) {
+        Base::Console().Warning("Inspection of '%s' was canceled, the distances are incomplete\n",
+            this->Label.getValue());
     }
-
-    Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f\n",
-        this->Label.getValue(), -this->SearchRadius.getValue(), this->SearchRadius.getValue(), res.getRMS());
+    Base::Console().Message("RMS value for '%s' with search radius [%.4f,%.4f] is: %.4f (min %.4f, max %.4f)\n",
+        this->Label.getValue(), -fSearchRadius, fSearchRadius, res.getRMS(),
+        res.m_numv > 0 ? res.m_min : 0.0f, res.m_numv > 0 ? res.m_max : 0.0f);
     Distances.setValues(vals);
 #endif
 
@@ -909,6 +1182,8 @@ App::DocumentObjectExecReturn* Feature::execute(void)
     for (std::vector<InspectNominalGeometry*>::iterator it = inspectNominal.begin(); it != inspectNominal.end(); ++it)
         delete *it;
 
+    if (canceled)
+        return new App::DocumentObjectExecReturn("Inspection canceled");
     return 0;
 }
 
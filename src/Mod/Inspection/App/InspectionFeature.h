@@ -37,6 +37,7 @@ class BRepExtrema_DistShapeShape;
 namespace MeshCore {
 class MeshKernel;
 class MeshGrid;
+class MeshFacetBVH;
 }
 
 namespace Mesh   { class MeshObject; }
@@ -101,6 +102,11 @@ public:
     InspectNominalGeometry() {}
     virtual ~InspectNominalGeometry() {}
     virtual float getDistance(const Base::Vector3f&) const = 0;
+    /** Computes the distances of a batch of points and writes them to \a dists.
+     * The default implementation calls getDistance() for each point. Sub-classes
+     * can reimplement it to process the whole batch at once.
+     */
+    virtual void getDistances(const std::vector<Base::Vector3f>& points, std::vector<float>& dists) const;
 };
 
 class InspectionExport InspectNominalMesh : public InspectNominalGeometry
@@ -109,13 +115,17 @@ public:
     InspectNominalMesh(const Mesh::MeshObject& rMesh, float offset);
     ~InspectNominalMesh();
     virtual float getDistance(const Base::Vector3f&) const;
+    virtual void getDistances(const std::vector<Base::Vector3f>& points, std::vector<float>& dists) const;
+
+private:
+    float getDistance(const Base::Vector3f&, unsigned long& hint) const;
 
 private:
     const MeshCore::MeshKernel& _mesh;
-    MeshCore::MeshGrid* _pGrid;
+    MeshCore::MeshKernel* _pTransformed;
+    MeshCore::MeshFacetBVH* _pBVH;
     Base::BoundBox3f _box;
-    bool _bApply;
-    Base::Matrix4D _clTrf;
+    float _fMaxDist;
 };
 
 class InspectionExport InspectNominalFastMesh : public InspectNominalGeometry
@@ -154,9 +164,18 @@ public:
     virtual float getDistance(const Base::Vector3f&) const;
 
 private:
+    /** Uses the tessellation of the shape to find the candidate faces and computes the
+     * exact distance only to them.
+     */
+    float getDistanceFromProxy(const Base::Vector3f&) const;
+
+private:
+    struct Proxy;
     BRepExtrema_DistShapeShape* distss;
     const TopoDS_Shape& _rShape;
     bool isSolid;
+    float radius;
+    Proxy* proxy;
 };
 
 class InspectionExport PropertyDistanceList: public App::PropertyLists
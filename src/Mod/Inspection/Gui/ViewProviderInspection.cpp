@@ -279,10 +279,12 @@ void ViewProviderInspection::updateData(const App::Property* prop)
         }
     }
     else if (prop->getTypeId() == Inspection::PropertyDistanceList::getClassTypeId()) {
-        // force an update of the Inventor data nodes
+        // force an update of the Inventor data nodes if the geometry doesn't match, otherwise
+        // only the colours change, e.g. while the partial results of an inspection arrive
         if (this->pcObject) {
+            const std::vector<float>& fValues = static_cast<const Inspection::PropertyDistanceList*>(prop)->getValues();
             App::Property* link = this->pcObject->getPropertyByName("Actual");
-            if (link)
+            if (link && (int)fValues.size() != this->pcCoords->point.getNum())
                 updateData(link);
             setDistances();
         }
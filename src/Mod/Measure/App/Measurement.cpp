@@ -49,6 +49,7 @@
 #include <Mod/Part/App/Geometry.h>
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/Tools.h>
 
 #include "Measurement.h"
 #include "MeasurementPy.h"
@@ -219,6 +220,78 @@ TopoDS_Shape Measurement::getShape(App::DocumentObject *obj , const char *subNam
     }
 }
 
+std::vector<TopoDS_Shape> Measurement::getShapes() const
+{
+    const std::vector<App::DocumentObject*> &objects = References3D.getValues();
+    const std::vector<std::string> &subElements = References3D.getSubValues();
+
+    std::vector<TopoDS_Shape> shapes;
+    shapes.reserve(objects.size());
+    for (std::size_t i = 0; i < objects.size() && i < subElements.size(); i++) {
+        shapes.push_back(getShape(objects[i], subElements[i].c_str()));
+    }
+    return shapes;
+}
+
+namespace {
+// length of an edge, returns false if the curve type is not handled
+bool curveLength(const BRepAdaptor_Curve& curve, double& length)
+{
+    switch(curve.GetType()) {
+        case GeomAbs_Line : {
+            gp_Pnt P1 = curve.Value(curve.FirstParameter());
+            gp_Pnt P2 = curve.Value(curve.LastParameter());
+            gp_XYZ diff = P2.XYZ() - P1.XYZ();
+            length = diff.Modulus();
+            return true;
+        }
+        case GeomAbs_Circle : {
+            double u = curve.FirstParameter();
+            double v = curve.LastParameter();
+            double radius = curve.Circle().Radius();
+            if (u > v) // if arc is reversed
+                std::swap(u, v);
+
+            double range = v-u;
+            length = radius * range;
+            return true;
+        }
+        case GeomAbs_Ellipse:
+        case GeomAbs_BSplineCurve:
+        case GeomAbs_Hyperbola:
+        case GeomAbs_BezierCurve: {
+            length = GCPnts_AbscissaPoint::Length(curve);
+            return true;
+        }
+        default: {
+            length = 0.0;
+            return false;
+        }
+    }
+}
+
+// shortest vector from shape1 to shape2
+bool shapeDelta(const TopoDS_Shape& shape1, const TopoDS_Shape& shape2, Base::Vector3d& delta)
+{
+    gp_Pnt P1, P2;
+    if (shape1.ShapeType() == TopAbs_VERTEX && shape2.ShapeType() == TopAbs_VERTEX) {
+        P1 = BRep_Tool::Pnt(TopoDS::Vertex(shape1));
+        P2 = BRep_Tool::Pnt(TopoDS::Vertex(shape2));
+    }
+    else {
+        BRepExtrema_DistShapeShape extrema(shape1, shape2);
+        if (!extrema.IsDone() || extrema.NbSolution() < 1)
+            return false;
+        // NOTE we will assume there is only 1 solution (cyclic topology will create multiple solutions.
+        P1 = extrema.PointOnShape1(1);
+        P2 = extrema.PointOnShape2(1);
+    }
+    gp_XYZ diff = P2.XYZ() - P1.XYZ();
+    delta = Base::Vector3d(diff.X(), diff.Y(), diff.Z());
+    return true;
+}
+}
+
 //TODO:: add lengthX, lengthY (and lengthZ??) support
 // Methods for distances (edge length, two points, edge and a point
 double Measurement::length() const
@@ -254,37 +327,14 @@ double Measurement::length() const
                 const TopoDS_Edge& edge = TopoDS::Edge(shape);
                 BRepAdaptor_Curve curve(edge);
 
-                switch(curve.GetType()) {
-                    case GeomAbs_Line : {
-                        gp_Pnt P1 = curve.Value(curve.FirstParameter());
-                        gp_Pnt P2 = curve.Value(curve.LastParameter());
-                        gp_XYZ diff = P2.XYZ() - P1.XYZ();
-                        result += diff.Modulus();
-                        break;
-                    }
-                    case GeomAbs_Circle : {
-                        double u = curve.FirstParameter();
-                        double v = curve.LastParameter();
-                        double radius = curve.Circle().Radius();
-                        if (u > v) // if arc is reversed
-                            std::swap(u, v);
-
-                        double range = v-u;
-                        result += radius * range;
-                        break;
-                    }
-                    case GeomAbs_Ellipse:
-                    case GeomAbs_BSplineCurve:
-                    case GeomAbs_Hyperbola:
-                    case GeomAbs_BezierCurve: {
-                        result += GCPnts_AbscissaPoint::Length(curve);
-                        break;
-                    }
-                    default: {
-                        Base::Console().Error("Measurement::length - curve type: %d not implemented\n");
+                double len;
+                if (curveLength(curve, len)) {
+                    result += len;
+                }
+                else {
+                    Base::Console().Error("Measurement::length - curve type: %d not implemented\n");
 //                    throw Base::ValueError("Measurement - length - Curve type not currently handled");
-                    }
-                }  //end switch
+                }
             }  //end for
         } //end measureType == Edges
     }
@@ -505,6 +555,64 @@ Base::Vector3d Measurement::massCenter() const
     return result;
 }
 
+std::vector<double> Measurement::lengths() const
+{
+    std::vector<TopoDS_Shape> shapes = getShapes();
+    std::vector<double> result(shapes.size(), 0.0);
+    try {
+        Part::Tools::parallelFor(shapes.size(), [&](std::size_t i) {
+            if (shapes[i].ShapeType() == TopAbs_EDGE) {
+                BRepAdaptor_Curve curve(TopoDS::Edge(shapes[i]));
+                curveLength(curve, result[i]);
+            }
+        });
+    }
+    catch (Standard_Failure& e) {
+        throw Base::CADKernelError(e.GetMessageString());
+    }
+    return result;
+}
+
+std::vector<double> Measurement::radii() const
+{
+    std::vector<TopoDS_Shape> shapes = getShapes();
+    std::vector<double> result(shapes.size(), 0.0);
+    try {
+        Part::Tools::parallelFor(shapes.size(), [&](std::size_t i) {
+            if (shapes[i].ShapeType() == TopAbs_EDGE) {
+                BRepAdaptor_Curve curve(TopoDS::Edge(shapes[i]));
+                if (curve.GetType() == GeomAbs_Circle)
+                    result[i] = curve.Circle().Radius();
+            }
+        });
+    }
+    catch (Standard_Failure& e) {
+        throw Base::CADKernelError(e.GetMessageString());
+    }
+    return result;
+}
+
+std::vector<Base::Vector3d> Measurement::deltas(const std::vector<std::pair<int, int> >& pairs) const
+{
+    std::vector<TopoDS_Shape> shapes = getShapes();
+    int numRefs = static_cast<int>(shapes.size());
+    for (const auto& it : pairs) {
+        if (it.first < 0 || it.first >= numRefs || it.second < 0 || it.second >= numRefs)
+            throw Base::IndexError("Measurement::deltas - reference index out of range");
+    }
+
+    std::vector<Base::Vector3d> result(pairs.size());
+    try {
+        Part::Tools::parallelFor(pairs.size(), [&](std::size_t i) {
+            shapeDelta(shapes[pairs[i].first], shapes[pairs[i].second], result[i]);
+        });
+    }
+    catch (Standard_Failure& e) {
+        throw Base::CADKernelError(e.GetMessageString());
+    }
+    return result;
+}
+
 unsigned int Measurement::getMemSize(void) const
 {
     return 0;
@@ -81,8 +81,21 @@ public:
   // Calculate volumetric/mass properties
   Base::Vector3d massCenter() const;
 
+  // Batch methods: the references are resolved once per call and the
+  // measurements are computed in parallel
+
+  // Calculates the length of each edge reference, 0 for other references
+  std::vector<double> lengths() const;
+
+  // Calculates the radius of each circular edge reference, 0 for other references
+  std::vector<double> radii() const;
+
+  // Calculates the shortest vector from the first to the second reference of each pair
+  std::vector<Base::Vector3d> deltas(const std::vector<std::pair<int, int> >& pairs) const;
+
 protected:
   TopoDS_Shape getShape(App::DocumentObject *obj , const char *subName) const;
+  std::vector<TopoDS_Shape> getShapes() const;
   MeasureType measureType;
   Py::Object PythonObject;
 };
@@ -161,6 +161,56 @@ PyObject* MeasurementPy::com(PyObject *args)
     return Py::new_reference_to(com);
 }
 
+PyObject* MeasurementPy::lengths(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    PY_TRY {
+        Py::List list;
+        for (double it : this->getMeasurementPtr()->lengths())
+            list.append(Py::Float(it));
+        return Py::new_reference_to(list);
+    } PY_CATCH
+}
+
+PyObject* MeasurementPy::radii(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+
+    PY_TRY {
+        Py::List list;
+        for (double it : this->getMeasurementPtr()->radii())
+            list.append(Py::Float(it));
+        return Py::new_reference_to(list);
+    } PY_CATCH
+}
+
+PyObject* MeasurementPy::deltas(PyObject *args)
+{
+    PyObject *pcObj;
+    if (!PyArg_ParseTuple(args, "O", &pcObj))
+        return 0;
+
+    PY_TRY {
+        std::vector<std::pair<int, int> > pairs;
+        Py::Sequence seq(pcObj);
+        for (Py::Sequence::iterator it = seq.begin(); it != seq.end(); ++it) {
+            Py::Sequence pair(*it);
+            if (pair.size() != 2)
+                throw Py::TypeError("expected a list of index pairs");
+            pairs.emplace_back(static_cast<int>(Py::Long(pair[0])),
+                               static_cast<int>(Py::Long(pair[1])));
+        }
+
+        Py::List list;
+        for (const auto& it : this->getMeasurementPtr()->deltas(pairs))
+            list.append(Py::Vector(it));
+        return Py::new_reference_to(list);
+    } PY_CATCH
+}
+
 PyObject *MeasurementPy::getCustomAttributes(const char* /*attr*/) const
 {
     return 0;
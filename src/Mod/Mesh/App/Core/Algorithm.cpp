@@ -32,6 +32,7 @@
 #include "Elements.h"
 #include "Iterator.h"
 #include "Grid.h"
+#include "BVH.h"
 #include "Triangulation.h"
 
 #include <Base/Console.h>
@@ -140,6 +141,12 @@ bool MeshAlgorithm::NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::
     return false;
 }
 
+bool MeshAlgorithm::NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, const MeshFacetBVH &rclBVH,
+                                       Base::Vector3f &rclRes, unsigned long &rulFacet) const
+{
+    return rclBVH.NearestFacetOnRay(rclPt, rclDir, rclRes, rulFacet);
+}
+
 bool MeshAlgorithm::NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, const std::vector<unsigned long> &raulFacets,
                                        Base::Vector3f &rclRes, unsigned long &rulFacet) const
 {
@@ -1686,7 +1693,7 @@ bool MeshAlgorithm::Distance (const Base::Vector3f &rclPt, unsigned long ulFacet
 {
   const MeshFacetArray &rclFAry = _rclMesh._aclFacetArray;
   const MeshPointArray &rclPAry = _rclMesh._aclPointArray;
-  const unsigned long *pulIdx = rclFAry[ulFacetIdx]._aulPoints;
+  const ElementIndex *pulIdx = rclFAry[ulFacetIdx]._aulPoints;
 
   BoundBox3f clBB;
   clBB.Add(rclPAry[*(pulIdx++)]);
@@ -1883,14 +1890,11 @@ void MeshRefFacetToFacets::Rebuild (void)
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
     _map.resize(rFacets.size());
 
-    MeshRefPointToFacets  vertexFace(_rclMesh);
-    MeshFacetArray::_TConstIterator pFBegin = rFacets.begin();
-    for (MeshFacetArray::_TConstIterator pFIter = pFBegin; pFIter != rFacets.end(); ++pFIter) {
-        for (int i = 0; i < 3; i++) {
-            const std::set<unsigned long>& faces = vertexFace[pFIter->_aulPoints[i]];
-            for (std::set<unsigned long>::const_iterator it = faces.begin(); it != faces.end(); ++it)
-                _map[pFIter - pFBegin].insert(*it);
-        }
+    MeshAdjacency vertexFace(_rclMesh);
+    std::vector<unsigned long> faces;
+    for (unsigned long index = 0; index < rFacets.size(); index++) {
+        vertexFace.FacetFacets(index, faces);
+        _map[index].insert(faces.begin(), faces.end());
     }
 }
 
@@ -1984,6 +1988,79 @@ void MeshRefPointToPoints::RemoveNeighbour(unsigned long pos, unsigned long face
 
 //----------------------------------------------------------------------------
 
+void MeshAdjacency::Rebuild (void)
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    unsigned long ulCtPoints = rPoints.size();
+
+    // count the references of each point
+    _pointFacetOffsets.assign(ulCtPoints + 1, 0);
+    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
+        for (int i = 0; i < 3; i++)
+            _pointFacetOffsets[pFIter->_aulPoints[i] + 1]++;
+    }
+    for (unsigned long i = 0; i < ulCtPoints; i++)
+        _pointFacetOffsets[i + 1] += _pointFacetOffsets[i];
+
+    // each point references two other points per facet
+    _pointPointOffsets.resize(ulCtPoints + 1);
+    for (unsigned long i = 0; i <= ulCtPoints; i++)
+        _pointPointOffsets[i] = 2 * _pointFacetOffsets[i];
+
+    _pointFacets.resize(_pointFacetOffsets.back());
+    _pointPoints.resize(_pointPointOffsets.back());
+    std::vector<unsigned long> fillFacets(_pointFacetOffsets.begin(), _pointFacetOffsets.end() - 1);
+    std::vector<unsigned long> fillPoints(_pointPointOffsets.begin(), _pointPointOffsets.end() - 1);
+
+    unsigned long index = 0;
+    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter, ++index) {
+        for (int i = 0; i < 3; i++) {
+            unsigned long ulP = pFIter->_aulPoints[i];
+            _pointFacets[fillFacets[ulP]++] = index;
+            _pointPoints[fillPoints[ulP]++] = pFIter->_aulPoints[(i+1)%3];
+            _pointPoints[fillPoints[ulP]++] = pFIter->_aulPoints[(i+2)%3];
+        }
+    }
+
+    Compress(_pointFacets, _pointFacetOffsets);
+    Compress(_pointPoints, _pointPointOffsets);
+}
+
+void MeshAdjacency::Compress(std::vector<unsigned long>& indices, std::vector<unsigned long>& offsets)
+{
+    // sort the indices of each row and remove duplicates
+    unsigned long ulNext = 0;
+    unsigned long ulBegin = 0;
+    for (std::size_t row = 0; row + 1 < offsets.size(); row++) {
+        unsigned long ulEnd = offsets[row + 1];
+        std::vector<unsigned long>::iterator first = indices.begin() + ulBegin;
+        std::vector<unsigned long>::iterator last = indices.begin() + ulEnd;
+        std::sort(first, last);
+        last = std::unique(first, last);
+        offsets[row] = ulNext;
+        ulNext = std::copy(first, last, indices.begin() + ulNext) - indices.begin();
+        ulBegin = ulEnd;
+    }
+    offsets.back() = ulNext;
+    indices.resize(ulNext);
+    std::vector<unsigned long>(indices).swap(indices);
+}
+
+void MeshAdjacency::FacetFacets (unsigned long ulFacetIndex, std::vector<unsigned long>& raulFacets) const
+{
+    const MeshFacet& rFacet = _rclMesh.GetFacets()[ulFacetIndex];
+    raulFacets.clear();
+    for (int i = 0; i < 3; i++) {
+        IndexRange faces = PointFacets(rFacet._aulPoints[i]);
+        raulFacets.insert(raulFacets.end(), faces.begin(), faces.end());
+    }
+    std::sort(raulFacets.begin(), raulFacets.end());
+    raulFacets.erase(std::unique(raulFacets.begin(), raulFacets.end()), raulFacets.end());
+}
+
+//----------------------------------------------------------------------------
+
 void MeshRefEdgeToFacets::Rebuild (void)
 {
     _map.clear();
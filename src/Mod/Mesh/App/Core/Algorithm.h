@@ -45,6 +45,7 @@ class MeshGeomFacet;
 class MeshGeomEdge;
 class MeshKernel;
 class MeshFacetGrid;
+class MeshFacetBVH;
 class MeshFacetArray;
 class MeshRefPointToFacets;
 class AbstractPolygonTriangulator;
@@ -92,6 +93,17 @@ public:
    */
   bool NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, const std::vector<unsigned long> &raulFacets,
                           Base::Vector3f &rclRes, unsigned long &rulFacet) const;
+  /**
+   * Searches for the nearest facet to the ray defined by
+   * (\a rclPt, \a rclDir).
+   * The point \a rclRes holds the intersection point with the ray and the
+   * nearest facet with index \a rulFacet.
+   * \note This method uses a bounding volume hierarchy and doesn't depend on
+   * a uniform distribution of the facets. Only facets in direction of \a rclDir
+   * are found.
+   */
+  bool NearestFacetOnRay (const Base::Vector3f &rclPt, const Base::Vector3f &rclDir, const MeshFacetBVH &rclBVH,
+                          Base::Vector3f &rclRes, unsigned long &rulFacet) const;
   /**
    * Searches for the nearest facet to the ray defined by (\a rclPt, \a  rclDir). The point \a rclRes holds
    * the intersection point with the ray and the nearest facet with index \a rulFacet.
@@ -459,6 +471,74 @@ protected:
     std::vector<std::set<unsigned long> > _map;
 };
 
+/**
+ * The MeshAdjacency class gives access to all facets and all neighbour points of a point.
+ * Unlike MeshRefPointToFacets and MeshRefPointToPoints the indices are stored in compressed
+ * row format, i.e. one contiguous array of indices and an array of offsets per point. This needs
+ * only a fraction of the memory of a set per point and is friendlier to the cache. As the
+ * structure cannot be modified it can be shared between several algorithms and threads.
+ * The indices of a point are sorted in ascending order.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshAdjacency
+{
+public:
+    /// A read-only range of indices
+    class IndexRange
+    {
+    public:
+        IndexRange(const unsigned long* b, const unsigned long* e) : _begin(b), _end(e) {}
+        const unsigned long* begin() const { return _begin; }
+        const unsigned long* end() const { return _end; }
+        std::size_t size() const { return static_cast<std::size_t>(_end - _begin); }
+        bool empty() const { return _begin == _end; }
+        unsigned long operator[] (std::size_t i) const { return _begin[i]; }
+
+    private:
+        const unsigned long* _begin;
+        const unsigned long* _end;
+    };
+
+    /// Construction
+    MeshAdjacency (const MeshKernel &rclM) : _rclMesh(rclM)
+    { Rebuild(); }
+    /// Destruction
+    ~MeshAdjacency (void)
+    { }
+
+    /// Rebuilds up data structure
+    void Rebuild (void);
+    /// Returns the number of points the structure was built for.
+    std::size_t CountPoints (void) const
+    { return _pointFacetOffsets.empty() ? 0 : _pointFacetOffsets.size() - 1; }
+    /// Returns the facets that reference the point with index \a ulPointIndex.
+    IndexRange PointFacets (unsigned long ulPointIndex) const
+    { return range(_pointFacets, _pointFacetOffsets, ulPointIndex); }
+    /// Returns the points that share an edge with the point with index \a ulPointIndex.
+    IndexRange PointPoints (unsigned long ulPointIndex) const
+    { return range(_pointPoints, _pointPointOffsets, ulPointIndex); }
+    /// Returns the sorted indices of all facets sharing at least one point with the facet
+    /// with index \a ulFacetIndex. The facet itself is included.
+    void FacetFacets (unsigned long ulFacetIndex, std::vector<unsigned long>& raulFacets) const;
+
+private:
+    static IndexRange range(const std::vector<unsigned long>& indices,
+                            const std::vector<unsigned long>& offsets, unsigned long pos)
+    {
+        const unsigned long* data = indices.empty() ? 0 : &indices[0];
+        return IndexRange(data + offsets[pos], data + offsets[pos + 1]);
+    }
+    static void Compress(std::vector<unsigned long>& indices, std::vector<unsigned long>& offsets);
+
+protected:
+    const MeshKernel  &_rclMesh; /**< The mesh kernel. */
+    std::vector<unsigned long> _pointFacetOffsets;
+    std::vector<unsigned long> _pointFacets;
+    std::vector<unsigned long> _pointPointOffsets;
+    std::vector<unsigned long> _pointPoints;
+};
+
 /**
  * The MeshRefEdgeToFacets builds up a structure to have access to all facets 
  * of an edge. On a manifold mesh an edge has one or two facets associated.
@@ -0,0 +1,421 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <climits>
+#endif
+
+#include "BVH.h"
+#include "Definitions.h"
+#include "MeshKernel.h"
+
+using namespace MeshCore;
+
+namespace {
+// Facets per leaf below that no split is tried
+const unsigned long minLeafSize = 4;
+// Facets per leaf above that a split is forced
+const unsigned long maxLeafSize = 16;
+// Depth above that the nodes are split at the median
+const int maxSAHDepth = 48;
+// Number of bins per axis used to approximate the surface area heuristic
+const int numBins = 16;
+
+float halfArea(const Base::BoundBox3f& box)
+{
+    if (!box.IsValid())
+        return 0.0f;
+    float dx = box.LengthX();
+    float dy = box.LengthY();
+    float dz = box.LengthZ();
+    return dx * dy + dy * dz + dz * dx;
+}
+
+float squaredDistance(const Base::BoundBox3f& box, const Base::Vector3f& pt)
+{
+    float dx = std::max<float>(std::max<float>(box.MinX - pt.x, 0.0f), pt.x - box.MaxX);
+    float dy = std::max<float>(std::max<float>(box.MinY - pt.y, 0.0f), pt.y - box.MaxY);
+    float dz = std::max<float>(std::max<float>(box.MinZ - pt.z, 0.0f), pt.z - box.MaxZ);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+bool intersectBox(const Base::BoundBox3f& box, const Base::Vector3f& pt,
+                  const Base::Vector3f& invDir, float tMax)
+{
+    float t1 = (box.MinX - pt.x) * invDir.x;
+    float t2 = (box.MaxX - pt.x) * invDir.x;
+    float tmin = std::min<float>(t1, t2);
+    float tmax = std::max<float>(t1, t2);
+
+    t1 = (box.MinY - pt.y) * invDir.y;
+    t2 = (box.MaxY - pt.y) * invDir.y;
+    tmin = std::max<float>(tmin, std::min<float>(t1, t2));
+    tmax = std::min<float>(tmax, std::max<float>(t1, t2));
+
+    t1 = (box.MinZ - pt.z) * invDir.z;
+    t2 = (box.MaxZ - pt.z) * invDir.z;
+    tmin = std::max<float>(tmin, std::min<float>(t1, t2));
+    tmax = std::min<float>(tmax, std::max<float>(t1, t2));
+
+    return tmax >= std::max<float>(tmin, 0.0f) && tmin <= tMax;
+}
+
+float component(const Base::Vector3f& v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+}
+
+MeshFacetBVH::MeshFacetBVH()
+  : _pclMesh(0), _ulCtElements(0)
+{
+}
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& rclM)
+  : _pclMesh(&rclM), _ulCtElements(0)
+{
+    Rebuild();
+}
+
+MeshFacetBVH::~MeshFacetBVH()
+{
+}
+
+void MeshFacetBVH::Attach(const MeshKernel& rclM)
+{
+    _pclMesh = &rclM;
+    Rebuild();
+}
+
+void MeshFacetBVH::Clear()
+{
+    _ulCtElements = 0;
+    _nodes.clear();
+    _triangles.clear();
+    _facets.clear();
+}
+
+void MeshFacetBVH::Validate()
+{
+    if (_pclMesh && _pclMesh->CountFacets() != _ulCtElements)
+        Rebuild();
+}
+
+void MeshFacetBVH::Rebuild()
+{
+    Clear();
+    if (!_pclMesh)
+        return;
+
+    _ulCtElements = _pclMesh->CountFacets();
+    if (_ulCtElements == 0)
+        return;
+
+    std::vector<Base::BoundBox3f> boxes(_ulCtElements);
+    std::vector<Base::Vector3f> centers(_ulCtElements);
+    _facets.resize(_ulCtElements);
+    for (unsigned long i = 0; i < _ulCtElements; i++) {
+        MeshGeomFacet facet = _pclMesh->GetFacet(i);
+        Base::BoundBox3f& box = boxes[i];
+        box.Add(facet._aclPoints[0]);
+        box.Add(facet._aclPoints[1]);
+        box.Add(facet._aclPoints[2]);
+        centers[i] = box.GetCenter();
+        _facets[i] = i;
+    }
+
+    // a binary tree with leaves of at least one facet has less than 2n nodes
+    _nodes.reserve(2 * _ulCtElements / minLeafSize + 1);
+    BuildNode(0, _ulCtElements, 0, boxes, centers);
+
+    _triangles.resize(_ulCtElements);
+    for (unsigned long i = 0; i < _ulCtElements; i++) {
+        MeshGeomFacet facet = _pclMesh->GetFacet(_facets[i]);
+        Triangle& tria = _triangles[i];
+        tria.p0 = facet._aclPoints[0];
+        tria.e1 = facet._aclPoints[1] - facet._aclPoints[0];
+        tria.e2 = facet._aclPoints[2] - facet._aclPoints[0];
+    }
+}
+
+unsigned long MeshFacetBVH::BuildNode(unsigned long ulFirst, unsigned long ulLast, int depth,
+                                      const std::vector<Base::BoundBox3f>& boxes,
+                                      const std::vector<Base::Vector3f>& centers)
+{
+    unsigned long ulIndex = _nodes.size();
+    _nodes.push_back(Node());
+
+    Base::BoundBox3f box, centerBox;
+    for (unsigned long i = ulFirst; i < ulLast; i++) {
+        box.Add(boxes[_facets[i]]);
+        centerBox.Add(centers[_facets[i]]);
+    }
+    _nodes[ulIndex].box = box;
+
+    unsigned long ulCount = ulLast - ulFirst;
+    if (ulCount <= minLeafSize) {
+        _nodes[ulIndex].offset = ulFirst;
+        _nodes[ulIndex].count = ulCount;
+        return ulIndex;
+    }
+
+    // Find the best split plane among the bin boundaries of all three axes
+    int bestAxis = -1;
+    int bestBin = 0;
+    float bestCost = float(ulCount) * halfArea(box);
+    for (int axis = 0; axis < 3 && depth < maxSAHDepth; axis++) {
+        float fMin = component(Base::Vector3f(centerBox.MinX, centerBox.MinY, centerBox.MinZ), axis);
+        float fMax = component(Base::Vector3f(centerBox.MaxX, centerBox.MaxY, centerBox.MaxZ), axis);
+        if (fMax <= fMin)
+            continue;
+
+        Base::BoundBox3f binBoxes[numBins];
+        unsigned long binCounts[numBins] = {};
+        float fScale = float(numBins) / (fMax - fMin);
+        for (unsigned long i = ulFirst; i < ulLast; i++) {
+            unsigned long ulFacet = _facets[i];
+            int bin = std::min<int>(int((component(centers[ulFacet], axis) - fMin) * fScale), numBins - 1);
+            binCounts[bin]++;
+            binBoxes[bin].Add(boxes[ulFacet]);
+        }
+
+        // sweep from the right to get the cost of all right-hand sides
+        float rightArea[numBins];
+        unsigned long rightCount[numBins];
+        Base::BoundBox3f rightBox;
+        unsigned long ulRight = 0;
+        for (int bin = numBins - 1; bin > 0; bin--) {
+            rightBox.Add(binBoxes[bin]);
+            ulRight += binCounts[bin];
+            rightArea[bin] = halfArea(rightBox);
+            rightCount[bin] = ulRight;
+        }
+
+        Base::BoundBox3f leftBox;
+        unsigned long ulLeft = 0;
+        for (int bin = 1; bin < numBins; bin++) {
+            leftBox.Add(binBoxes[bin - 1]);
+            ulLeft += binCounts[bin - 1];
+            if (ulLeft == 0 || rightCount[bin] == 0)
+                continue;
+            float cost = float(ulLeft) * halfArea(leftBox) + float(rightCount[bin]) * rightArea[bin];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = bin;
+            }
+        }
+    }
+
+    unsigned long ulMid;
+    if (bestAxis >= 0) {
+        float fMin = component(Base::Vector3f(centerBox.MinX, centerBox.MinY, centerBox.MinZ), bestAxis);
+        float fMax = component(Base::Vector3f(centerBox.MaxX, centerBox.MaxY, centerBox.MaxZ), bestAxis);
+        float fScale = float(numBins) / (fMax - fMin);
+        std::vector<unsigned long>::iterator it = std::partition(_facets.begin() + ulFirst, _facets.begin() + ulLast,
+            [&](unsigned long ulFacet) {
+                int bin = std::min<int>(int((component(centers[ulFacet], bestAxis) - fMin) * fScale), numBins - 1);
+                return bin < bestBin;
+            });
+        ulMid = it - _facets.begin();
+    }
+    else if (ulCount > maxLeafSize || depth >= maxSAHDepth) {
+        // splitting is not worth it or all centers coincide, but the leaf would be too big
+        int axis = 0;
+        if (centerBox.LengthY() > centerBox.LengthX())
+            axis = 1;
+        if (centerBox.LengthZ() > std::max<float>(centerBox.LengthX(), centerBox.LengthY()))
+            axis = 2;
+        ulMid = ulFirst + ulCount / 2;
+        std::nth_element(_facets.begin() + ulFirst, _facets.begin() + ulMid, _facets.begin() + ulLast,
+            [&](unsigned long ulFacet1, unsigned long ulFacet2) {
+                return component(centers[ulFacet1], axis) < component(centers[ulFacet2], axis);
+            });
+    }
+    else {
+        _nodes[ulIndex].offset = ulFirst;
+        _nodes[ulIndex].count = ulCount;
+        return ulIndex;
+    }
+
+    // the left child directly follows its parent
+    _nodes[ulIndex].count = 0;
+    BuildNode(ulFirst, ulMid, depth + 1, boxes, centers);
+    unsigned long ulRight = BuildNode(ulMid, ulLast, depth + 1, boxes, centers);
+    _nodes[ulIndex].offset = ulRight;
+    return ulIndex;
+}
+
+inline bool MeshFacetBVH::IntersectTriangle(const Triangle& tria, const Base::Vector3f& rclPt,
+                                            const Base::Vector3f& rclDir, float& t) const
+{
+    // Moeller-Trumbore algorithm
+    Base::Vector3f pvec = rclDir % tria.e2;
+    float det = tria.e1 * pvec;
+    if (det == 0.0f)
+        return false; // parallel or degenerated facet
+
+    float invDet = 1.0f / det;
+    Base::Vector3f tvec = rclPt - tria.p0;
+    float u = (tvec * pvec) * invDet;
+    if (u < 0.0f || u > 1.0f)
+        return false;
+
+    Base::Vector3f qvec = tvec % tria.e1;
+    float v = (rclDir * qvec) * invDet;
+    if (v < 0.0f || u + v > 1.0f)
+        return false;
+
+    t = (tria.e2 * qvec) * invDet;
+    return t >= 0.0f;
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f& rclPt, const Base::Vector3f& rclDir,
+                                     Base::Vector3f& rclRes, unsigned long& rulFacet) const
+{
+    if (_nodes.empty())
+        return false;
+
+    Base::Vector3f invDir(1.0f / rclDir.x, 1.0f / rclDir.y, 1.0f / rclDir.z);
+    float tBest = FLOAT_MAX;
+    unsigned long ulBest = ULONG_MAX;
+
+    std::vector<unsigned long> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        unsigned long ulNode = stack.back();
+        stack.pop_back();
+        const Node& node = _nodes[ulNode];
+        if (!intersectBox(node.box, rclPt, invDir, tBest))
+            continue;
+
+        if (node.count > 0) {
+            for (unsigned long i = node.offset; i < node.offset + node.count; i++) {
+                float t;
+                if (IntersectTriangle(_triangles[i], rclPt, rclDir, t) && t < tBest) {
+                    tBest = t;
+                    ulBest = i;
+                }
+            }
+        }
+        else {
+            stack.push_back(node.offset);
+            stack.push_back(ulNode + 1);
+        }
+    }
+
+    if (ulBest == ULONG_MAX)
+        return false;
+
+    rclRes = rclPt + tBest * rclDir;
+    rulFacet = _facets[ulBest];
+    return true;
+}
+
+unsigned long MeshFacetBVH::NearestFacet(const Base::Vector3f& rclPt, float fMaxDist,
+                                         Base::Vector3f& rclRes, float& rfDist) const
+{
+    if (_nodes.empty())
+        return ULONG_MAX;
+
+    float fBest = fMaxDist;
+    unsigned long ulBest = ULONG_MAX;
+
+    std::vector<unsigned long> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        unsigned long ulNode = stack.back();
+        stack.pop_back();
+        const Node& node = _nodes[ulNode];
+        if (squaredDistance(node.box, rclPt) > fBest * fBest)
+            continue;
+
+        if (node.count > 0) {
+            for (unsigned long i = node.offset; i < node.offset + node.count; i++) {
+                const Triangle& tria = _triangles[i];
+                MeshGeomFacet facet(tria.p0, tria.p0 + tria.e1, tria.p0 + tria.e2);
+                Base::Vector3f res;
+                float fDist = facet.DistanceToPoint(rclPt, res);
+                if (fDist <= fBest) {
+                    fBest = fDist;
+                    ulBest = i;
+                    rclRes = res;
+                }
+            }
+        }
+        else {
+            // visit the nearer child first
+            unsigned long ulFar = ulNode + 1;
+            unsigned long ulNear = node.offset;
+            if (squaredDistance(_nodes[ulFar].box, rclPt) < squaredDistance(_nodes[ulNear].box, rclPt))
+                std::swap(ulFar, ulNear);
+            stack.push_back(ulFar);
+            stack.push_back(ulNear);
+        }
+    }
+
+    if (ulBest == ULONG_MAX)
+        return ULONG_MAX;
+
+    rfDist = fBest;
+    return _facets[ulBest];
+}
+
+unsigned long MeshFacetBVH::FacetsWithinDistance(const Base::Vector3f& rclPt, float fMaxDist,
+                                                 std::vector<unsigned long>& raulFacets) const
+{
+    if (_nodes.empty())
+        return 0;
+
+    std::size_t ulCount = raulFacets.size();
+    std::vector<unsigned long> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        unsigned long ulNode = stack.back();
+        stack.pop_back();
+        if (squaredDistance(node.box, rclPt) > fMaxDist * fMaxDist)
+            continue;
+
+        if (node.count > 0) {
+            for (unsigned long i = node.offset; i < node.offset + node.count; i++) {
+                const Triangle& tria = _triangles[i];
+                MeshGeomFacet facet(tria.p0, tria.p0 + tria.e1, tria.p0 + tria.e2);
+                Base::Vector3f res;
+                if (facet.DistanceToPoint(rclPt, res) <= fMaxDist)
+                    raulFacets.push_back(_facets[i]);
+            }
+        }
+        else {
+            stack.push_back(ulNode + 1);
+            stack.push_back(node.offset);
+        }
+    }
+
+    return static_cast<unsigned long>(raulFacets.size() - ulCount);
+}
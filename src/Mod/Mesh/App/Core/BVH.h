@@ -0,0 +1,126 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <vector>
+
+#include "Elements.h"
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh.
+ * Unlike MeshFacetGrid the tree adapts to the distribution of the facets, so ray casting
+ * and nearest facet queries stay fast on meshes with a very non-uniform facet density
+ * such as scanned data.
+ * The tree is built with the surface area heuristic and stored as a flat array of nodes.
+ * A copy of the facet geometry is kept in tree order so that queries don't need to
+ * access the mesh kernel.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /// Construction
+    MeshFacetBVH();
+    /// Construction
+    MeshFacetBVH(const MeshKernel& rclM);
+    /// Destruction
+    ~MeshFacetBVH();
+
+    /** Attaches the mesh kernel to this tree and rebuilds it. */
+    void Attach(const MeshKernel& rclM);
+    /** Rebuilds the tree of the attached mesh. */
+    void Rebuild();
+    /** Rebuilds the tree if the number of facets of the attached mesh has changed. */
+    void Validate();
+    /** Removes all data. */
+    void Clear();
+    /** Returns true if the tree doesn't contain any facets. */
+    bool IsEmpty() const
+    { return _facets.empty(); }
+
+    /**
+     * Searches for the nearest facet intersected by the ray starting at \a rclPt in
+     * direction \a rclDir. The intersection point is returned by \a rclRes and the
+     * index of the facet by \a rulFacet.
+     * In contrast to MeshAlgorithm::NearestFacetOnRay() the backward direction of the
+     * ray is not considered.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt, const Base::Vector3f& rclDir,
+                           Base::Vector3f& rclRes, unsigned long& rulFacet) const;
+    /**
+     * Searches for the nearest facet to the point \a rclPt whose distance is not higher than
+     * \a fMaxDist. The index of the facet is returned, or ULONG_MAX if no such facet exists.
+     * \a rclRes is the nearest point on the facet and \a rfDist its distance to \a rclPt.
+     */
+    unsigned long NearestFacet(const Base::Vector3f& rclPt, float fMaxDist,
+                               Base::Vector3f& rclRes, float& rfDist) const;
+    /**
+     * Searches for all facets whose distance to the point \a rclPt is not higher than \a fMaxDist.
+     * The indices of the facets are appended to \a raulFacets, the number of found facets is returned.
+     */
+    unsigned long FacetsWithinDistance(const Base::Vector3f& rclPt, float fMaxDist,
+                                       std::vector<unsigned long>& raulFacets) const;
+
+private:
+    struct Node
+    {
+        Base::BoundBox3f box;
+        /// index of the first facet of a leaf or of the second child of an inner node
+        unsigned long offset;
+        /// number of facets of a leaf, 0 for inner nodes
+        unsigned long count;
+    };
+
+    struct Triangle
+    {
+        Base::Vector3f p0, e1, e2;
+    };
+
+    unsigned long BuildNode(unsigned long ulFirst, unsigned long ulLast, int depth,
+                            const std::vector<Base::BoundBox3f>& boxes,
+                            const std::vector<Base::Vector3f>& centers);
+    inline bool IntersectTriangle(const Triangle& tria, const Base::Vector3f& rclPt,
+                                  const Base::Vector3f& rclDir, float& t) const;
+
+private:
+    const MeshKernel* _pclMesh;
+    unsigned long _ulCtElements;
+    std::vector<Node> _nodes;
+    std::vector<Triangle> _triangles;
+    std::vector<unsigned long> _facets;
+
+    MeshFacetBVH(const MeshFacetBVH&);
+    void operator= (const MeshFacetBVH&);
+};
+
+} // namespace MeshCore
+
+
+#endif  // MESH_BVH_H
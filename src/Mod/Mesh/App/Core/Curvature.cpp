@@ -35,7 +35,8 @@
 #include <Eigen/Eigenvalues>
 #else
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
-#include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix2.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Matrix3.h>
 #endif
 
 #include "Curvature.h"
@@ -289,51 +290,188 @@ void MeshCurvature::ComputePerVertex()
     }
 }
 #else
-void MeshCurvature::ComputePerVertex()
+namespace MeshCore {
+/**
+ * Computes the curvature per vertex the same way as Wm4::MeshCurvature does. But instead of
+ * scattering the contributions of each triangle to its vertices each vertex gathers them from
+ * its adjacent facets. This way the vertices are independent of each other and can be handled
+ * in parallel, and the per-vertex matrices don't need to be stored.
+ */
+class VertexCurvature
 {
-    myCurvature.clear();
+public:
+    typedef Wm4::Vector3<double> Vector3;
+    typedef Wm4::Matrix3<double> Matrix3;
+    typedef Wm4::Matrix2<double> Matrix2;
+
+    VertexCurvature(const MeshKernel& kernel, const MeshAdjacency& adjacency,
+                    std::vector<CurvatureInfo>& curvature)
+      : points(kernel.GetPoints())
+      , facets(kernel.GetFacets())
+      , adjacency(adjacency)
+      , normals(kernel.CountPoints())
+      , curvature(curvature)
+    {
+    }
 
-    // get all points
-    std::vector< Wm4::Vector3<double> > aPnts;
-    aPnts.reserve(myKernel.CountPoints());
-    MeshPointIterator cPIt(myKernel);
-    for (cPIt.Init(); cPIt.More(); cPIt.Next()) {
-        Wm4::Vector3<double> cP(cPIt->x, cPIt->y, cPIt->z);
-        aPnts.push_back(cP);
+    void ComputeNormal(unsigned long index)
+    {
+        Vector3 normal(0, 0, 0);
+        MeshAdjacency::IndexRange faces = adjacency.PointFacets(index);
+        for (const unsigned long* it = faces.begin(); it != faces.end(); ++it) {
+            const MeshFacet& face = facets[*it];
+            Vector3 v0 = vertex(face._aulPoints[0]);
+            Vector3 kNormal = (vertex(face._aulPoints[1]) - v0).Cross(vertex(face._aulPoints[2]) - v0);
+            // a degenerated facet may reference the point several times
+            for (int j = 0; j < 3; j++) {
+                if (face._aulPoints[j] == index)
+                    normal += kNormal;
+            }
+        }
+        normal.Normalize();
+        normals[index] = normal;
+    }
+
+    void ComputeCurvature(unsigned long index)
+    {
+        // compute the matrix of normal derivatives
+        Matrix3 kWWTrn(0,0,0,0,0,0,0,0,0);
+        Matrix3 kDWTrn(0,0,0,0,0,0,0,0,0);
+        const Vector3& kN = normals[index];
+        Vector3 kV0 = vertex(index);
+
+        MeshAdjacency::IndexRange faces = adjacency.PointFacets(index);
+        for (const unsigned long* it = faces.begin(); it != faces.end(); ++it) {
+            const MeshFacet& face = facets[*it];
+            for (int j = 0; j < 3; j++) {
+                if (face._aulPoints[j] != index)
+                    continue;
+                AddEdge(kV0, kN, face._aulPoints[(j+1)%3], kWWTrn, kDWTrn);
+                AddEdge(kV0, kN, face._aulPoints[(j+2)%3], kWWTrn, kDWTrn);
+            }
+        }
+
+        // Add in N*N^T to W*W^T for numerical stability.  In theory 0*0^T gets
+        // added to D*W^T, but of course no update needed in the implementation.
+        // Compute the matrix of normal derivatives.
+        for (int iRow = 0; iRow < 3; iRow++) {
+            for (int iCol = 0; iCol < 3; iCol++) {
+                kWWTrn[iRow][iCol] = 0.5*kWWTrn[iRow][iCol] + kN[iRow]*kN[iCol];
+                kDWTrn[iRow][iCol] *= 0.5;
+            }
+        }
+
+        Matrix3 kDNormal = kDWTrn*kWWTrn.Inverse();
+
+        // compute U and V given N
+        Vector3 kU, kV;
+        Vector3::GenerateComplementBasis(kU,kV,kN);
+
+        // Compute S = J^T * dN/dX * J.  In theory S is symmetric, but
+        // because we have estimated dN/dX, we must slightly adjust our
+        // calculations to make sure S is symmetric.
+        double fS01 = kU.Dot(kDNormal*kV);
+        double fS10 = kV.Dot(kDNormal*kU);
+        double fSAvr = 0.5*(fS01+fS10);
+        Matrix2 kS
+        (
+            kU.Dot(kDNormal*kU), fSAvr,
+            fSAvr, kV.Dot(kDNormal*kV)
+        );
+
+        // compute the eigenvalues of S (min and max curvatures)
+        double fTrace = kS[0][0] + kS[1][1];
+        double fDet = kS[0][0]*kS[1][1] - kS[0][1]*kS[1][0];
+        double fDiscr = fTrace*fTrace - 4.0*fDet;
+        double fRootDiscr = sqrt(fabs(fDiscr));
+        double fMinCurvature = 0.5*(fTrace - fRootDiscr);
+        double fMaxCurvature = 0.5*(fTrace + fRootDiscr);
+
+        CurvatureInfo& ci = curvature[index];
+        ci.fMinCurvature = static_cast<float>(fMinCurvature);
+        ci.fMaxCurvature = static_cast<float>(fMaxCurvature);
+        ci.cMinCurvDir = direction(kS, fMinCurvature, kU, kV);
+        ci.cMaxCurvDir = direction(kS, fMaxCurvature, kU, kV);
+    }
+
+private:
+    Vector3 vertex(unsigned long index) const
+    {
+        const MeshPoint& p = points[index];
+        return Vector3(p.x, p.y, p.z);
+    }
+
+    void AddEdge(const Vector3& kV0, const Vector3& kN0, unsigned long index1,
+                 Matrix3& kWWTrn, Matrix3& kDWTrn) const
+    {
+        // Compute edge from V0 to V1, project to tangent plane of vertex,
+        // and compute difference of adjacent normals.
+        Vector3 kE = vertex(index1) - kV0;
+        Vector3 kW = kE - (kE.Dot(kN0))*kN0;
+        Vector3 kD = normals[index1] - kN0;
+        for (int iRow = 0; iRow < 3; iRow++) {
+            for (int iCol = 0; iCol < 3; iCol++) {
+                kWWTrn[iRow][iCol] += kW[iRow]*kW[iCol];
+                kDWTrn[iRow][iCol] += kD[iRow]*kW[iCol];
+            }
+        }
     }
 
-    // get all point connections
-    std::vector<int> aIdx;
-    aIdx.reserve(3*myKernel.CountFacets());
-    const MeshFacetArray& raFts = myKernel.GetFacets();
-    for (MeshFacetArray::const_iterator jt = raFts.begin(); jt != raFts.end(); ++jt) {
-        for (int i=0; i<3; i++) {
-            aIdx.push_back((int)jt->_aulPoints[i]);
+    // compute the eigenvector of S to the eigenvalue fCurvature
+    static Base::Vector3f direction(const Matrix2& kS, double fCurvature,
+                                    const Vector3& kU, const Vector3& kV)
+    {
+        Wm4::Vector2<double> kW0(kS[0][1],fCurvature-kS[0][0]);
+        Wm4::Vector2<double> kW1(fCurvature-kS[1][1],kS[1][0]);
+        Vector3 dir;
+        if (kW0.SquaredLength() >= kW1.SquaredLength()) {
+            kW0.Normalize();
+            dir = kW0.X()*kU + kW0.Y()*kV;
+        }
+        else {
+            kW1.Normalize();
+            dir = kW1.X()*kU + kW1.Y()*kV;
         }
+        return Base::Vector3f((float)dir.X(), (float)dir.Y(), (float)dir.Z());
     }
 
+private:
+    const MeshPointArray& points;
+    const MeshFacetArray& facets;
+    const MeshAdjacency& adjacency;
+    std::vector<Vector3> normals;
+    std::vector<CurvatureInfo>& curvature;
+};
+}
+
+void MeshCurvature::ComputePerVertex()
+{
+    myCurvature.clear();
+
     // in case of an empty mesh no curvature can be calculated
     if (myKernel.CountPoints() == 0 || myKernel.CountFacets() == 0)
         return;
 
-    // compute vertex based curvatures
-    Wm4::MeshCurvature<double> meshCurv(myKernel.CountPoints(), &(aPnts[0]), myKernel.CountFacets(), &(aIdx[0]));
-
-    // get curvature information now
-    const Wm4::Vector3<double>* aMaxCurvDir = meshCurv.GetMaxDirections();
-    const Wm4::Vector3<double>* aMinCurvDir = meshCurv.GetMinDirections();
-    const double* aMaxCurv = meshCurv.GetMaxCurvatures();
-    const double* aMinCurv = meshCurv.GetMinCurvatures();
-
-    myCurvature.reserve(myKernel.CountPoints());
-    for (unsigned long i=0; i<myKernel.CountPoints(); i++) {
-        CurvatureInfo ci;
-        ci.cMaxCurvDir = Base::Vector3f((float)aMaxCurvDir[i].X(), (float)aMaxCurvDir[i].Y(), (float)aMaxCurvDir[i].Z());
-        ci.cMinCurvDir = Base::Vector3f((float)aMinCurvDir[i].X(), (float)aMinCurvDir[i].Y(), (float)aMinCurvDir[i].Z());
-        ci.fMaxCurvature = (float)aMaxCurv[i];
-        ci.fMinCurvature = (float)aMinCurv[i];
-        myCurvature.push_back(ci);
-    }
+    unsigned long numPoints = myKernel.CountPoints();
+    myCurvature.resize(numPoints);
+    MeshAdjacency adjacency(myKernel);
+    VertexCurvature vertCurv(myKernel, adjacency, myCurvature);
+
+    // The vertices are processed in blocks to keep the scheduling overhead low
+    const unsigned long blockSize = 4096;
+    std::vector<std::pair<unsigned long, unsigned long> > blocks;
+    for (unsigned long i = 0; i < numPoints; i += blockSize)
+        blocks.push_back(std::make_pair(i, std::min<unsigned long>(i + blockSize, numPoints)));
+
+    // the curvature of a vertex depends on the normals of its neighbours
+    QtConcurrent::blockingMap(blocks, [&vertCurv](const std::pair<unsigned long, unsigned long>& block) {
+        for (unsigned long i = block.first; i < block.second; i++)
+            vertCurv.ComputeNormal(i);
+    });
+    QtConcurrent::blockingMap(blocks, [&vertCurv](const std::pair<unsigned long, unsigned long>& block) {
+        for (unsigned long i = block.first; i < block.second; i++)
+            vertCurv.ComputeCurvature(i);
+    });
 }
 #endif // OPTIMIZE_CURVATURE
 
@@ -23,8 +23,13 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <climits>
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include "Decimation.h"
 #include "MeshKernel.h"
 #include "Algorithm.h"
@@ -36,6 +41,75 @@
 
 using namespace MeshCore;
 
+namespace {
+// Meshes are only split into blocks if each of them gets at least this number of facets
+const std::size_t minFacetsPerBlock = 50000;
+
+struct DecimationBlock
+{
+    std::vector<unsigned long> facets;
+    // result of the decimation: locked points keep their global index, others get ULONG_MAX
+    MeshPointArray points;
+    std::vector<unsigned long> globalIndex;
+    MeshFacetArray result;
+};
+
+void simplifyBlock(const MeshKernel& kernel, const std::vector<char>& shared,
+                   float reduction, double tolerance, DecimationBlock& block)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    const MeshFacetArray& facets = kernel.GetFacets();
+
+    // the sorted list of points used by this block maps local to global indices
+    std::vector<unsigned long> blockPoints;
+    blockPoints.reserve(block.facets.size() * 3);
+    for (std::vector<unsigned long>::const_iterator it = block.facets.begin(); it != block.facets.end(); ++it) {
+        for (int j = 0; j < 3; j++)
+            blockPoints.push_back(facets[*it]._aulPoints[j]);
+    }
+    std::sort(blockPoints.begin(), blockPoints.end());
+    blockPoints.erase(std::unique(blockPoints.begin(), blockPoints.end()), blockPoints.end());
+
+    Simplify alg;
+    alg.vertices.resize(blockPoints.size());
+    for (std::size_t i = 0; i < blockPoints.size(); i++) {
+        alg.vertices[i].p = points[blockPoints[i]];
+        // points shared with other blocks must stay where they are
+        if (shared[blockPoints[i]])
+            alg.vertices[i].locked = static_cast<int>(i + 1);
+    }
+
+    alg.triangles.resize(block.facets.size());
+    for (std::size_t i = 0; i < block.facets.size(); i++) {
+        const MeshFacet& face = facets[block.facets[i]];
+        for (int j = 0; j < 3; j++) {
+            alg.triangles[i].v[j] = static_cast<int>(std::lower_bound(blockPoints.begin(),
+                blockPoints.end(), face._aulPoints[j]) - blockPoints.begin());
+        }
+    }
+
+    int target_count = static_cast<int>(static_cast<float>(block.facets.size()) * (1.0f-reduction));
+    alg.simplify_mesh(target_count, tolerance);
+
+    block.points.reserve(alg.vertices.size());
+    block.globalIndex.reserve(alg.vertices.size());
+    for (std::size_t i = 0; i < alg.vertices.size(); i++) {
+        block.points.push_back(alg.vertices[i].p);
+        int locked = alg.vertices[i].locked;
+        block.globalIndex.push_back(locked ? blockPoints[locked - 1] : ULONG_MAX);
+    }
+
+    block.result.resize(alg.triangles.size());
+    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
+        for (int j = 0; j < 3; j++)
+            block.result[i]._aulPoints[j] = alg.triangles[i].v[j];
+    }
+
+    // free memory early
+    std::vector<unsigned long>().swap(block.facets);
+}
+}
+
 MeshSimplify::MeshSimplify(MeshKernel& mesh)
   : myKernel(mesh)
 {
@@ -47,76 +121,149 @@ MeshSimplify::~MeshSimplify()
 
 void MeshSimplify::simplify(float tolerance, float reduction)
 {
-    Simplify alg;
+    std::size_t target_count = static_cast<std::size_t>(static_cast<float>(myKernel.CountFacets()) * (1.0f-reduction));
 
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+    // Large meshes are decimated block-wise in parallel first. As the block borders
+    // are locked a final pass over the whole mesh removes the remaining seams.
+    simplifyBlocks(reduction, tolerance);
+    simplify(target_count, tolerance);
+}
+
+void MeshSimplify::simplify(int targetSize)
+{
+    std::size_t numFacets = myKernel.CountFacets();
+    if (targetSize > 0 && static_cast<std::size_t>(targetSize) < numFacets) {
+        float reduction = 1.0f - static_cast<float>(targetSize) / static_cast<float>(numFacets);
+        simplifyBlocks(reduction, FLT_MAX);
     }
 
+    simplify(static_cast<std::size_t>(std::max<int>(targetSize, 0)), FLT_MAX);
+}
+
+/**
+ * Splits the mesh into slabs of about the same number of facets along the longest
+ * side of the bounding box and decimates them independently of each other. Points
+ * that are shared by several slabs are locked so that the slabs still fit together.
+ * Apart from running on several cores this keeps the memory of the decimation
+ * structures limited to the slabs being processed, instead of a copy of the whole mesh.
+ * Returns false if the mesh is too small to be split.
+ */
+bool MeshSimplify::simplifyBlocks(float reduction, double tolerance)
+{
+    const MeshPointArray& points = myKernel.GetPoints();
     const MeshFacetArray& facets = myKernel.GetFacets();
+
+    std::size_t numThreads = static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1));
+    std::size_t numBlocks = std::min(facets.size() / minFacetsPerBlock, 4 * numThreads);
+    if (numThreads < 2 || numBlocks < 2)
+        return false;
+
+    // sort the facets by the position of their center along the longest axis
+    Base::BoundBox3f bbox = myKernel.GetBoundBox();
+    int axis = 0;
+    if (bbox.LengthY() > bbox.LengthX())
+        axis = 1;
+    if (bbox.LengthZ() > (axis == 0 ? bbox.LengthX() : bbox.LengthY()))
+        axis = 2;
+
+    std::vector<std::pair<float, unsigned long> > order(facets.size());
     for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        for (int j = 0; j < 3; j++)
-            t.v[j] = facets[i]._aulPoints[j];
-        alg.triangles.push_back(t);
+        const MeshFacet& face = facets[i];
+        float center = points[face._aulPoints[0]][axis] +
+                       points[face._aulPoints[1]][axis] +
+                       points[face._aulPoints[2]][axis];
+        order[i] = std::make_pair(center, static_cast<unsigned long>(i));
     }
+    std::sort(order.begin(), order.end());
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0f-reduction));
+    // assign the facets to the blocks and mark the points used by several blocks
+    std::vector<DecimationBlock> blocks(numBlocks);
+    std::vector<unsigned long> owner(points.size(), ULONG_MAX);
+    std::vector<char> shared(points.size(), 0);
+    std::size_t blockSize = (facets.size() + numBlocks - 1) / numBlocks;
+    for (std::size_t i = 0; i < order.size(); i++) {
+        unsigned long index = order[i].second;
+        unsigned long block = static_cast<unsigned long>(i / blockSize);
+        blocks[block].facets.push_back(index);
+        for (int j = 0; j < 3; j++) {
+            unsigned long pointIndex = facets[index]._aulPoints[j];
+            if (owner[pointIndex] == ULONG_MAX)
+                owner[pointIndex] = block;
+            else if (owner[pointIndex] != block)
+                shared[pointIndex] = 1;
+        }
+    }
+    std::vector<std::pair<float, unsigned long> >().swap(order);
+    std::vector<unsigned long>().swap(owner);
 
-    // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
+    const MeshKernel& kernel = myKernel;
+    QtConcurrent::blockingMap(blocks, [&kernel, &shared, reduction, tolerance](DecimationBlock& block) {
+        simplifyBlock(kernel, shared, reduction, tolerance, block);
+    });
 
-    // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (std::size_t i = 0; i < alg.vertices.size(); i++) {
-        new_points.push_back(alg.vertices[i].p);
+    // merge the blocks and join them at the locked points
+    std::size_t numPoints = 0, numFacets = 0;
+    for (std::vector<DecimationBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        numPoints += it->points.size();
+        numFacets += it->result.size();
     }
 
-    std::size_t numFacets = 0;
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted)
-            numFacets++;
-    }
+    MeshPointArray new_points;
+    new_points.reserve(numPoints);
     MeshFacetArray new_facets;
     new_facets.reserve(numFacets);
-    for (std::size_t i = 0; i < alg.triangles.size(); i++) {
-        if (!alg.triangles[i].deleted) {
+    std::vector<unsigned long> globalToNew(points.size(), ULONG_MAX);
+    std::vector<unsigned long> localToNew;
+    for (std::vector<DecimationBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        localToNew.resize(it->points.size());
+        for (std::size_t i = 0; i < it->points.size(); i++) {
+            unsigned long global = it->globalIndex[i];
+            if (global != ULONG_MAX && globalToNew[global] != ULONG_MAX) {
+                localToNew[i] = globalToNew[global];
+            }
+            else {
+                localToNew[i] = static_cast<unsigned long>(new_points.size());
+                new_points.push_back(it->points[i]);
+                if (global != ULONG_MAX)
+                    globalToNew[global] = localToNew[i];
+            }
+        }
+
+        for (MeshFacetArray::iterator jt = it->result.begin(); jt != it->result.end(); ++jt) {
             MeshFacet face;
-            face._aulPoints[0] = alg.triangles[i].v[0];
-            face._aulPoints[1] = alg.triangles[i].v[1];
-            face._aulPoints[2] = alg.triangles[i].v[2];
+            for (int j = 0; j < 3; j++)
+                face._aulPoints[j] = localToNew[jt->_aulPoints[j]];
             new_facets.push_back(face);
         }
+
+        // free memory early
+        MeshPointArray().swap(it->points);
+        MeshFacetArray().swap(it->result);
     }
 
     myKernel.Adopt(new_points, new_facets, true);
+    return true;
 }
 
-void MeshSimplify::simplify(int targetSize)
+void MeshSimplify::simplify(std::size_t targetSize, double tolerance)
 {
     Simplify alg;
 
     const MeshPointArray& points = myKernel.GetPoints();
+    alg.vertices.resize(points.size());
     for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+        alg.vertices[i].p = points[i];
     }
 
     const MeshFacetArray& facets = myKernel.GetFacets();
+    alg.triangles.resize(facets.size());
     for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
         for (int j = 0; j < 3; j++)
-            t.v[j] = facets[i]._aulPoints[j];
-        alg.triangles.push_back(t);
+            alg.triangles[i].v[j] = facets[i]._aulPoints[j];
     }
 
     // Simplification starts
-    alg.simplify_mesh(targetSize, FLT_MAX);
+    alg.simplify_mesh(static_cast<int>(targetSize), tolerance);
 
     // Simplification done
     MeshPointArray new_points;
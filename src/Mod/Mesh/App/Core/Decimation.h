@@ -37,6 +37,10 @@ public:
     void simplify(float tolerance, float reduction);
     void simplify(int targetSize);
 
+private:
+    void simplify(std::size_t targetSize, double tolerance);
+    bool simplifyBlocks(float reduction, double tolerance);
+
 private:
     MeshKernel& myKernel;
 };
@@ -24,6 +24,11 @@
 #ifndef MESH_DEFINITIONS_H
 #define MESH_DEFINITIONS_H
 
+#include <climits>
+#ifdef MESH_32BIT_INDICES
+# include <stdint.h>
+#endif
+
 // default values
 #define MESH_MIN_PT_DIST           1.0e-6f
 #define MESH_MIN_EDGE_LEN          1.0e-3f
@@ -50,6 +55,49 @@
 
 namespace MeshCore {
 
+#ifdef MESH_32BIT_INDICES
+/**
+ * Compact storage of an index referencing a point or facet with 32 bits. It converts
+ * implicitly from and to unsigned long so that it can be used wherever the algorithms expect
+ * an unsigned long index. ULONG_MAX, which marks an undefined index, is kept as ULONG_MAX.
+ * With this the elements of the mesh kernel only need about half of their memory on 64-bit
+ * platforms, but meshes are limited to 2^32-1 points and facets.
+ */
+class ElementIndex
+{
+public:
+  ElementIndex (void) : _value(0) {}
+  ElementIndex (unsigned long ulIndex) : _value(compress(ulIndex)) {}
+  operator unsigned long (void) const
+  { return _value == invalidValue() ? ULONG_MAX : _value; }
+  ElementIndex& operator = (unsigned long ulIndex)
+  { _value = compress(ulIndex); return *this; }
+  ElementIndex& operator += (unsigned long ulOffset)
+  { return *this = static_cast<unsigned long>(*this) + ulOffset; }
+  ElementIndex& operator -= (unsigned long ulOffset)
+  { return *this = static_cast<unsigned long>(*this) - ulOffset; }
+  ElementIndex& operator ++ (void)
+  { return *this += 1; }
+  ElementIndex& operator -- (void)
+  { return *this -= 1; }
+  ElementIndex operator ++ (int)
+  { ElementIndex tmp(*this); ++*this; return tmp; }
+  ElementIndex operator -- (int)
+  { ElementIndex tmp(*this); --*this; return tmp; }
+
+private:
+  static uint32_t invalidValue (void)
+  { return 0xffffffff; }
+  static uint32_t compress (unsigned long ulIndex)
+  { return ulIndex == ULONG_MAX ? invalidValue() : static_cast<uint32_t>(ulIndex); }
+
+  uint32_t _value;
+};
+#else
+/** Storage type of an index referencing a point or facet. */
+typedef unsigned long ElementIndex;
+#endif
+
 template <class Prec>
 class Math
 {
@@ -1087,14 +1087,13 @@ bool MeshEvalBorderFacet::Evaluate()
     const MeshCore::MeshFacetArray& facets = _rclMesh.GetFacets();
     MeshCore::MeshFacetArray::_TConstIterator f_it,
         f_beg = facets.begin(), f_end = facets.end();
-    MeshCore::MeshRefPointToPoints vv_it(_rclMesh);
-    MeshCore::MeshRefPointToFacets vf_it(_rclMesh);
+    MeshCore::MeshAdjacency adjacency(_rclMesh);
 
     for (f_it = facets.begin(); f_it != f_end; ++f_it) {
         bool ok = true;
         for (int i=0; i<3; i++) {
             unsigned long index = f_it->_aulPoints[i];
-            if (vv_it[index].size() == vf_it[index].size()) {
+            if (adjacency.PointPoints(index).size() == adjacency.PointFacets(index).size()) {
                 ok = false;
                 break;
             }
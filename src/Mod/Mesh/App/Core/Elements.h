@@ -146,7 +146,7 @@ public:
 
 public:
   unsigned char _ucFlag; /**< Flag member */
-  unsigned long _ulProp; /**< Free usable property */
+  ElementIndex  _ulProp; /**< Free usable property */
 };
 
 /**
@@ -323,9 +323,9 @@ public:
 
 public:
   unsigned char _ucFlag; /**< Flag member. */
-  unsigned long _ulProp; /**< Free usable property. */
-  unsigned long _aulPoints[3];     /**< Indices of corner points. */
-  unsigned long _aulNeighbours[3]; /**< Indices of neighbour facets. */
+  ElementIndex  _ulProp; /**< Free usable property. */
+  ElementIndex  _aulPoints[3];     /**< Indices of corner points. */
+  ElementIndex  _aulNeighbours[3]; /**< Indices of neighbour facets. */
 };
 
 /**
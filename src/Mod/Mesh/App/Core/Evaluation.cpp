@@ -25,9 +25,15 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <atomic>
+# include <numeric>
 # include <vector>
 #endif
 
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include <Mod/Mesh/App/WildMagic4/Wm4Matrix3.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
 
@@ -42,6 +48,7 @@
 #include "Functional.h"
 #include <Base/Matrix.h>
 
+#include <Base/Exception.h>
 #include <Base/Sequencer.h>
 
 using namespace MeshCore;
@@ -132,6 +139,57 @@ MeshEvalOrientation::~MeshEvalOrientation()
 {
 }
 
+std::size_t MeshEvalBatch::Add (const MeshEvaluationPtr& eval)
+{
+    Entry entry;
+    entry.eval = eval;
+    entry.result = false;
+    _evals.push_back(entry);
+    return _evals.size() - 1;
+}
+
+bool MeshEvalBatch::Evaluate ()
+{
+    // Keep the progress in this thread. Sequencers started by the
+    // evaluations in the worker threads are nested and thus ignored
+    Base::ParallelSequencerLauncher seq("Analysing mesh...", _evals.size());
+    QFuture<void> future = QtConcurrent::map(_evals, [&seq](Entry& entry) {
+        try {
+            entry.result = entry.eval->Evaluate();
+        }
+        catch (...) {
+            entry.result = false;
+        }
+        seq.next();
+    });
+
+    while (!future.isFinished()) {
+        seq.update(false);
+        QThread::msleep(20);
+    }
+    seq.update(false);
+
+    bool ok = true;
+    for (std::vector<Entry>::const_iterator it = _evals.begin(); it != _evals.end(); ++it) {
+        if (!it->result)
+            ok = false;
+    }
+
+    return ok;
+}
+
+bool MeshEvalBatch::GetResult (std::size_t index) const
+{
+    return _evals[index].result;
+}
+
+MeshEvaluationPtr MeshEvalBatch::GetEvaluation (std::size_t index) const
+{
+    return _evals[index].eval;
+}
+
+// ----------------------------------------------------
+
 bool MeshEvalOrientation::Evaluate ()
 {
     const MeshFacetArray& rFAry = _rclMesh.GetFacets();
@@ -470,16 +528,15 @@ bool MeshEvalPointManifolds::Evaluate ()
     this->nonManifoldPoints.clear();
     this->facetsOfNonManifoldPoints.clear();
 
-    MeshCore::MeshRefPointToPoints vv_it(_rclMesh);
-    MeshCore::MeshRefPointToFacets vf_it(_rclMesh);
+    MeshCore::MeshAdjacency adjacency(_rclMesh);
 
     unsigned long ctPoints = _rclMesh.CountPoints();
     for (unsigned long index=0; index < ctPoints; index++) {
         // get the local neighbourhood of the point
-        const std::set<unsigned long>& nf = vf_it[index];
-        const std::set<unsigned long>& np = vv_it[index];
+        MeshAdjacency::IndexRange nf = adjacency.PointFacets(index);
+        MeshAdjacency::IndexRange np = adjacency.PointPoints(index);
 
-        std::set<unsigned long>::size_type sp, sf;
+        std::size_t sp, sf;
         sp = np.size();
         sf = nf.size();
         // for an inner point the number of adjacent points is equal to the number of shared faces
@@ -593,7 +650,24 @@ bool MeshFixSingleFacet::Fixup ()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate ()
+namespace {
+// If the facets share a common vertex we do not check for self-intersections because they
+// could but usually do not intersect each other and the algorithm would detect false-positives,
+// otherwise
+bool shareCommonVertex(const MeshFacet& rface1, const MeshFacet& rface2)
+{
+    for (int i = 0; i < 3; i++) {
+        if (rface1._aulPoints[i] == rface2._aulPoints[0] ||
+            rface1._aulPoints[i] == rface2._aulPoints[1] ||
+            rface1._aulPoints[i] == rface2._aulPoints[2])
+            return true;
+    }
+    return false;
+}
+}
+
+bool MeshEvalSelfIntersection::FindIntersections(std::vector<std::pair<unsigned long, unsigned long> >& intersection,
+                                                 bool onlyFirst, bool canAbort) const
 {
     // Contains bounding boxes for every facet 
     std::vector<Base::BoundBox3f> boxes;
@@ -602,69 +676,89 @@ bool MeshEvalSelfIntersection::Evaluate ()
     MeshFacetGrid cMeshFacetGrid(_rclMesh);
     const MeshFacetArray& rFaces = _rclMesh.GetFacets();
     MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
 
     MeshFacetIterator cMFI(_rclMesh);
+    boxes.reserve(rFaces.size());
     for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
         boxes.push_back((*cMFI).GetBoundBox());
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
+    // Only grid elements with at least two facets need to be checked
+    std::vector<std::vector<unsigned long> > cells;
     for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
         std::vector<unsigned long> aulGridElements;
         clGridIter.GetElements(aulGridElements);
+        if (aulGridElements.size() > 1)
+            cells.push_back(std::move(aulGridElements));
+    }
 
-        seq.next();
-        if (aulGridElements.size()==0)
-            continue;
+    // Every grid element gets its own result buffer so that the workers don't need to synchronize
+    std::vector<std::vector<std::pair<unsigned long, unsigned long> > > results(cells.size());
+    std::vector<std::size_t> indices(cells.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::atomic<bool> found(false);
 
-        MeshGeomFacet facet1, facet2;
+    // Calculates the intersections
+    Base::ParallelSequencerLauncher seq("Checking for self-intersections...", cells.size());
+    QFuture<void> future = QtConcurrent::map(indices, [&](std::size_t index) {
+        if (!seq.next() || (onlyFirst && found.load(std::memory_order_relaxed)))
+            return;
+
+        const std::vector<unsigned long>& aulGridElements = cells[index];
+        std::vector<std::pair<unsigned long, unsigned long> >& result = results[index];
         Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
+        for (std::vector<unsigned long>::const_iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
             const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
+            MeshGeomFacet facet1 = _rclMesh.GetFacet(*it);
             const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
+            for (std::vector<unsigned long>::const_iterator jt = it + 1; jt != aulGridElements.end(); ++jt) {
                 const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
+                if (shareCommonVertex(rface1, rface2))
                     continue; // ignore facets sharing a common vertex
 
                 const Base::BoundBox3f& box2 = boxes[*jt];
                 if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
+                    MeshGeomFacet facet2 = _rclMesh.GetFacet(*jt);
                     int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
                     if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+                        result.emplace_back(*it, *jt);
+                        if (onlyFirst) {
+                            // abort after the first detected self-intersection
+                            found = true;
+                            return;
+                        }
                     }
                 }
             }
+
+            if (onlyFirst && found.load(std::memory_order_relaxed))
+                return;
         }
+    });
+
+    while (!future.isFinished()) {
+        seq.update(canAbort);
+        QThread::msleep(20);
     }
 
+    if (seq.wasCanceled())
+        return false;
+
+    // A pair of facets is found in every grid element that both facets have in common
+    for (std::vector<std::vector<std::pair<unsigned long, unsigned long> > >::iterator it = results.begin(); it != results.end(); ++it)
+        intersection.insert(intersection.end(), it->begin(), it->end());
+    std::sort(intersection.begin(), intersection.end());
+    intersection.erase(std::unique(intersection.begin(), intersection.end()), intersection.end());
     return true;
 }
 
+bool MeshEvalSelfIntersection::Evaluate ()
+{
+    std::vector<std::pair<unsigned long, unsigned long> > intersection;
+    FindIntersections(intersection, true, false);
+    return intersection.empty();
+}
+
 void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsigned long, unsigned long> >& indices,
                                                 std::vector<std::pair<Base::Vector3f, Base::Vector3f> >& intersection) const
 {
@@ -691,72 +785,8 @@ void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsi
 
 void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >& intersection) const
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
-    //intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for(cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.size()==0)
-            continue;
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back (*it,*jt);
-                    }
-                }
-            }
-        }
-    }
+    if (!FindIntersections(intersection, false, true))
+        throw Base::AbortException("Aborting...");
 }
 
 std::vector<unsigned long> MeshFixSelfIntersection::GetFacets() const
@@ -26,6 +26,7 @@
 
 #include <list>
 #include <cmath>
+#include <memory>
 
 #include "MeshKernel.h"
 #include "Visitor.h"
@@ -85,6 +86,46 @@ protected:
 
 // ----------------------------------------------------
 
+typedef std::shared_ptr<MeshEvaluation> MeshEvaluationPtr;
+
+/**
+ * The MeshEvalBatch class runs several evaluations of the same mesh kernel concurrently.
+ * This is possible because Evaluate() only reads the mesh kernel, so each evaluation gets
+ * its own worker thread.
+ * 
+ote Most evaluations expect valid point and facet indices. So, a mesh of unknown
+ * quality should be checked with MeshEvalRangeFacet, MeshEvalRangePoint and
+ * MeshEvalCorruptedFacets in a first batch.
+ */
+class MeshExport MeshEvalBatch
+{
+public:
+  MeshEvalBatch () {}
+  ~MeshEvalBatch () {}
+
+  /** Adds an evaluation to the batch and returns its position. */
+  std::size_t Add (const MeshEvaluationPtr&);
+  /**
+   * Runs all evaluations and returns false if at least one of them has failed, true otherwise.
+   * An evaluation that throws an exception counts as failed.
+   */
+  bool Evaluate ();
+  /** Returns the result of the evaluation at position \a index of the last run. */
+  bool GetResult (std::size_t index) const;
+  /** Returns the evaluation at position \a index, e.g. to query the found defects. */
+  MeshEvaluationPtr GetEvaluation (std::size_t index) const;
+
+private:
+  struct Entry
+  {
+    MeshEvaluationPtr eval;
+    bool result;
+  };
+  std::vector<Entry> _evals;
+};
+
+// ----------------------------------------------------
+
 /**
  * This class searches for nonuniform orientation of neighboured facets.
  * @author Werner Mayer
@@ -297,6 +338,15 @@ public:
         std::vector<std::pair<Base::Vector3f, Base::Vector3f> >&) const;
     /// collect the index of all facets with self intersections
     void GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >&) const;
+
+private:
+    /**
+     * Checks the grid elements of the mesh in parallel and collects the pairs of intersecting
+     * facets. If \a onlyFirst is true the search stops after the first intersection. Returns
+     * false if the user has canceled the operation.
+     */
+    bool FindIntersections(std::vector<std::pair<unsigned long, unsigned long> >&,
+                           bool onlyFirst, bool canAbort) const;
 };
 
 /**
@@ -27,6 +27,9 @@
 # include <algorithm>
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include "Grid.h"
 #include "Iterator.h"
 
@@ -36,6 +39,34 @@
 
 using namespace MeshCore;
 
+namespace {
+/**
+ * Splits the x range of a grid into slabs so that each slab can be filled
+ * by a separate thread. As no two slabs share grid elements the threads
+ * don't need any synchronization.
+ */
+std::vector<std::pair<unsigned long, unsigned long> > gridSlabs(unsigned long ulCtGridsX,
+                                                                unsigned long ulCtElements)
+{
+  // below this size the extra passes over the elements aren't worth it
+  const unsigned long minElements = 50000;
+  unsigned long ulSlabs = 1;
+  if (ulCtElements >= minElements)
+    ulSlabs = static_cast<unsigned long>(std::max<int>(QThread::idealThreadCount(), 1));
+  ulSlabs = std::max<unsigned long>(std::min<unsigned long>(ulSlabs, ulCtGridsX), 1);
+
+  std::vector<std::pair<unsigned long, unsigned long> > slabs;
+  slabs.reserve(ulSlabs);
+  for (unsigned long i = 0; i < ulSlabs; i++) {
+    unsigned long ulMin = (ulCtGridsX * i) / ulSlabs;
+    unsigned long ulMax = (ulCtGridsX * (i + 1)) / ulSlabs;
+    if (ulMin < ulMax)
+      slabs.push_back(std::make_pair(ulMin, ulMax - 1));
+  }
+  return slabs;
+}
+}
+
 MeshGrid::MeshGrid (const MeshKernel &rclM)
 : _pclMesh(&rclM),
   _ulCtElements(0),
@@ -767,15 +798,26 @@ void MeshFacetGrid::RebuildGrid (void)
   InitGrid();
  
   // Daten-Struktur fuellen
+  std::vector<std::pair<unsigned long, unsigned long> > slabs = gridSlabs(_ulCtGridsX, _ulCtElements);
+  if (slabs.size() > 1) {
+    QtConcurrent::blockingMap(slabs, [this](const std::pair<unsigned long, unsigned long>& slab) {
+      AddFacets(slab.first, slab.second);
+    });
+  }
+  else if (!slabs.empty()) {
+    AddFacets(slabs.front().first, slabs.front().second);
+  }
+}
+
+void MeshFacetGrid::AddFacets (unsigned long ulMinX, unsigned long ulMaxX)
+{
   MeshFacetIterator clFIter(*_pclMesh);
 
   unsigned long i = 0;
   for (clFIter.Init(); clFIter.More(); clFIter.Next())
   {
-//    AddFacet(*clFIter, i++, 2.0f);
-    AddFacet(*clFIter, i++);
+    AddFacet(*clFIter, i++, ulMinX, ulMaxX);
   }
-
 }
 
 unsigned long MeshFacetGrid::SearchNearestFromPoint (const Base::Vector3f &rclPt) const
@@ -1109,13 +1151,31 @@ void MeshPointGrid::RebuildGrid (void)
   InitGrid();
  
   // Daten-Struktur fuellen
+  std::vector<std::pair<unsigned long, unsigned long> > slabs = gridSlabs(_ulCtGridsX, _ulCtElements);
+  if (slabs.size() > 1) {
+    QtConcurrent::blockingMap(slabs, [this](const std::pair<unsigned long, unsigned long>& slab) {
+      AddPoints(slab.first, slab.second);
+    });
+  }
+  else if (!slabs.empty()) {
+    AddPoints(slabs.front().first, slabs.front().second);
+  }
+}
 
-  MeshPointIterator cPIter(*_pclMesh);
-
-  unsigned long i = 0;
-  for (cPIter.Init(); cPIter.More(); cPIter.Next())
+void MeshPointGrid::AddPoints (unsigned long ulMinX, unsigned long ulMaxX)
+{
+  const MeshPointArray& rPoints = _pclMesh->GetPoints();
+  unsigned long ulCtPoints = rPoints.size();
+  for (unsigned long i = 0; i < ulCtPoints; i++)
   {
-    AddPoint(*cPIter, i++);
+    const MeshPoint& rclPt = rPoints[i];
+    unsigned long ulX, ulY, ulZ;
+    Pos(Base::Vector3f(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
+    if ( (ulX >= ulMinX) && (ulX <= ulMaxX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ) ) {
+      // the points are added in increasing order so the index always goes to the end
+      std::set<unsigned long>& rclSet = _aulGrid[ulX][ulY][ulZ];
+      rclSet.insert(rclSet.end(), i);
+    }
   }
 }
 
@@ -24,6 +24,7 @@
 #ifndef MESH_GRID_H
 #define MESH_GRID_H
 
+#include <algorithm>
 #include <set>
 
 #include "MeshKernel.h"
@@ -228,6 +229,12 @@ protected:
    * the corresponding index in the mesh kernel. The facet is added to each grid element that intersects 
    * the facet. */
   inline void AddFacet (const MeshGeomFacet &rclFacet, unsigned long ulFacetIndex, float fEpsilon = 0.0f);
+  /** Adds the facet only to the grid elements whose x position lies in the range [\a ulMinX, \a ulMaxX].
+   * Facets must be added in increasing index order. */
+  inline void AddFacet (const MeshGeomFacet &rclFacet, unsigned long ulFacetIndex,
+                        unsigned long ulMinX, unsigned long ulMaxX);
+  /** Adds all facets of the mesh to the grid elements in the x range [\a ulMinX, \a ulMaxX]. */
+  void AddFacets (unsigned long ulMinX, unsigned long ulMaxX);
   /** Returns the number of stored elements. */
   unsigned long HasElements (void) const
   { return _pclMesh->CountFacets(); }
@@ -271,6 +278,8 @@ protected:
   /** Adds a new point element to the grid structure. \a rclPt is the geometric point and \a ulPtIndex 
    * the corresponding index in the mesh kernel. */
   void AddPoint (const MeshPoint &rclPt, unsigned long ulPtIndex, float fEpsilon = 0.0f);
+  /** Adds all points of the mesh to the grid elements in the x range [\a ulMinX, \a ulMaxX]. */
+  void AddPoints (unsigned long ulMinX, unsigned long ulMaxX);
   /** Returns the grid numbers to the given point \a rclPoint. */
   void Pos(const Base::Vector3f &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const;
   /** Returns the number of stored elements. */
@@ -466,6 +475,13 @@ inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, unsigned lon
     }
   }
 #else
+  AddFacet(rclFacet, ulFacetIndex, 0, _ulCtGridsX - 1);
+#endif
+}
+
+inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, unsigned long ulFacetIndex,
+                                     unsigned long ulMinX, unsigned long ulMaxX)
+{
   unsigned long ulX, ulY, ulZ;
 
   unsigned long ulX1, ulY1, ulZ1, ulX2, ulY2, ulZ2;
@@ -493,25 +509,32 @@ inline void MeshFacetGrid::AddFacet (const MeshGeomFacet &rclFacet, unsigned lon
   if (ulZ2 < (_ulCtGridsZ-1)) ulZ2++;
   */
 
+  if (ulX2 < ulMinX || ulX1 > ulMaxX)
+    return;
+
+  // The facets are added in increasing order so the index always goes to the end of the set.
   // falls Facet ueber mehrere BB reicht
   if ((ulX1 < ulX2) || (ulY1 < ulY2) || (ulZ1 < ulZ2))
   {
-    for (ulX = ulX1; ulX <= ulX2; ulX++)
+    for (ulX = std::max<unsigned long>(ulX1, ulMinX); ulX <= std::min<unsigned long>(ulX2, ulMaxX); ulX++)
     {
       for (ulY = ulY1; ulY <= ulY2; ulY++)
       {
         for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++)
         {
-          if ( rclFacet.IntersectBoundingBox( GetBoundBox(ulX, ulY, ulZ) ) )
-            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+          if ( rclFacet.IntersectBoundingBox( GetBoundBox(ulX, ulY, ulZ) ) ) {
+            std::set<unsigned long>& rclSet = _aulGrid[ulX][ulY][ulZ];
+            rclSet.insert(rclSet.end(), ulFacetIndex);
+          }
         }
       }
     }
   }
   else
-    _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
-
-#endif
+  {
+    std::set<unsigned long>& rclSet = _aulGrid[ulX1][ulY1][ulZ1];
+    rclSet.insert(rclSet.end(), ulFacetIndex);
+  }
 }
 
 } // namespace MeshCore
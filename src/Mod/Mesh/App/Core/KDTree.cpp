@@ -22,64 +22,390 @@
 
 
 #include "PreCompiled.h"
-#ifdef _MSC_VER
-# pragma warning(disable : 4396)
-#endif
 #ifndef _PreComp_
+# include <algorithm>
+# include <climits>
+# include <cmath>
+# include <limits>
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include "KDTree.h"
-#include <kdtree++/kdtree.hpp>
+#include <Base/BoundBox.h>
 
 using namespace MeshCore;
 
-struct Point3d 
+namespace {
+// maximum number of points of a leaf
+const std::size_t LeafSize = 16;
+// number of query points handled by one task of the batched searches
+const std::size_t QueryBlockSize = 4096;
+
+struct Entry
+{
+    Base::Vector3f p;
+    unsigned long i;
+};
+
+struct Neighbour
 {
-   typedef float value_type;
+    float dist;
+    std::size_t pos;
+    bool operator < (const Neighbour& other) const
+    { return dist < other.dist; }
+};
 
-   Point3d(const Base::Vector3f& f, unsigned long i) : p(f), i(i)
-   {
-   }
+// a node of the tree together with the range of its points
+struct Range
+{
+    std::size_t node;
+    std::size_t first;
+    std::size_t count;
+};
 
-   Point3d(const Point3d& pnt) : p(pnt.p), i(pnt.i)
-   {
-   }
+std::vector<std::size_t> blockStarts(std::size_t count)
+{
+    std::vector<std::size_t> blocks;
+    for (std::size_t i = 0; i < count; i += QueryBlockSize)
+        blocks.push_back(i);
+    return blocks;
+}
+}
 
-   ~Point3d()
-   {
-   }
+class MeshKDTree::Private
+{
+public:
+    struct Node
+    {
+        /// Position of the split plane
+        float split;
+        /// Axis of the split plane
+        int axis;
+    };
 
-   inline value_type operator[](const int N) const
-   {
-       return p[N];
-   }
+    std::vector<Base::Vector3f> points;   /**< Points in the order of the leaves. */
+    std::vector<unsigned long> indices;   /**< Index of the original point of every stored point. */
+    std::vector<Node> nodes;              /**< Split planes, the children of node i are 2i+1 and 2i+2. */
+    std::vector<Base::Vector3f> pending;  /**< Points added since the tree was built. */
 
-   inline bool operator==(const Point3d& other) const
-   {
-      return (this->p) == (other.p);
-   }
+    std::size_t size() const
+    {
+        return points.size() + pending.size();
+    }
+    // the pending points follow the points of the tree and keep their index
+    const Base::Vector3f& point(std::size_t pos) const
+    {
+        return pos < points.size() ? points[pos] : pending[pos - points.size()];
+    }
+    unsigned long index(std::size_t pos) const
+    {
+        return pos < points.size() ? indices[pos] : static_cast<unsigned long>(pos);
+    }
 
-   inline bool operator!=(const Point3d& other) const
-   {
-      return (this->p) != (other.p);
-   }
+    template <class Points>
+    void add(const Points& pnts)
+    {
+        std::vector<Entry> entries;
+        entries.reserve(size() + pnts.size());
+        collect(entries);
+        for (typename Points::const_iterator it = pnts.begin(); it != pnts.end(); ++it) {
+            Entry e;
+            e.p = *it;
+            e.i = static_cast<unsigned long>(entries.size());
+            entries.push_back(e);
+        }
+        build(entries);
+    }
 
-   inline void operator=(const Point3d& other)
-   {
-       this->p = other.p;
-       this->i = other.i;
-   }
+    // returns all points in their original order
+    void collect(std::vector<Entry>& entries) const
+    {
+        std::size_t count = size();
+        entries.resize(count);
+        for (std::size_t pos = 0; pos < count; pos++) {
+            Entry& e = entries[index(pos)];
+            e.p = point(pos);
+            e.i = index(pos);
+        }
+    }
 
-   Base::Vector3f p;
-   unsigned long i;
-};
+    void build(std::vector<Entry>& entries)
+    {
+        points.clear();
+        indices.clear();
+        nodes.clear();
+        pending.clear();
+        std::size_t count = entries.size();
+        if (count == 0)
+            return;
 
-typedef KDTree::KDTree<3, Point3d> MyKDTree;
+        // a child gets at most half of the points rounded up
+        std::size_t numNodes = 1;
+        for (std::size_t n = count; n > LeafSize; n = (n + 1) / 2)
+            numNodes = 2 * numNodes + 1;
+        nodes.resize(numNodes);
 
-class MeshKDTree::Private
-{
-public:
-    MyKDTree kd_tree;
+        // The upper levels are built serially until there are enough subtrees to keep all cores
+        // busy. As the position of every node is fixed the subtrees can then be built in parallel.
+        int depth = 0;
+        for (int tasks = 1; tasks < 4 * QThread::idealThreadCount(); tasks *= 2)
+            depth++;
+
+        std::vector<Range> subtrees;
+        buildNode(entries, 0, 0, count, depth, &subtrees);
+        QtConcurrent::blockingMap(subtrees, [&](const Range& range) {
+            buildNode(entries, range.node, range.first, range.count, -1, nullptr);
+        });
+
+        points.resize(count);
+        indices.resize(count);
+        for (std::size_t pos = 0; pos < count; pos++) {
+            points[pos] = entries[pos].p;
+            indices[pos] = entries[pos].i;
+        }
+    }
+
+    void buildNode(std::vector<Entry>& entries, std::size_t node, std::size_t first, std::size_t count,
+                   int depth, std::vector<Range>* subtrees)
+    {
+        if (count <= LeafSize)
+            return;
+        if (subtrees && depth == 0) {
+            Range range = {node, first, count};
+            subtrees->push_back(range);
+            return;
+        }
+
+        // split at the median of the longest side
+        std::vector<Entry>::iterator begin = entries.begin() + first;
+        std::vector<Entry>::iterator end = begin + count;
+        Base::BoundBox3f box;
+        for (std::vector<Entry>::iterator it = begin; it != end; ++it)
+            box.Add(it->p);
+        int axis = 0;
+        if (box.LengthY() > box.LengthX())
+            axis = 1;
+        if (box.LengthZ() > std::max(box.LengthX(), box.LengthY()))
+            axis = 2;
+
+        std::size_t half = count / 2;
+        std::nth_element(begin, begin + half, end, [axis](const Entry& a, const Entry& b) {
+            return a.p[axis] < b.p[axis];
+        });
+
+        nodes[node].split = (begin + half)->p[axis];
+        nodes[node].axis = axis;
+        buildNode(entries, 2 * node + 1, first, half, depth - 1, subtrees);
+        buildNode(entries, 2 * node + 2, first + half, count - half, depth - 1, subtrees);
+    }
+
+    /* Searches the k nearest points within the squared distance maxDist. The heap keeps the
+     * best candidates with the farthest one on top and is sorted at the end.
+     */
+    void searchNearest(const Base::Vector3f& p, std::size_t k, float maxDist, std::vector<Neighbour>& heap) const
+    {
+        heap.clear();
+        if (k == 0)
+            return;
+
+        auto test = [&](std::size_t pos) {
+            Neighbour nb;
+            nb.dist = Base::DistanceP2(p, point(pos));
+            nb.pos = pos;
+            if (nb.dist > maxDist)
+                return;
+            if (heap.size() < k) {
+                heap.push_back(nb);
+                std::push_heap(heap.begin(), heap.end());
+            }
+            else if (nb.dist < heap.front().dist) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = nb;
+                std::push_heap(heap.begin(), heap.end());
+            }
+        };
+
+        for (std::size_t pos = points.size(); pos < size(); pos++)
+            test(pos);
+
+        struct Item
+        {
+            Range range;
+            float plane;
+        };
+        std::vector<Item> stack;
+        if (!points.empty()) {
+            Item root = {{0, 0, points.size()}, 0.0f};
+            stack.push_back(root);
+        }
+        while (!stack.empty()) {
+            Item item = stack.back();
+            stack.pop_back();
+            float bound = heap.size() == k ? heap.front().dist : maxDist;
+            if (item.plane > bound)
+                continue;
+
+            const Range& r = item.range;
+            if (r.count <= LeafSize) {
+                for (std::size_t pos = r.first; pos < r.first + r.count; pos++)
+                    test(pos);
+                continue;
+            }
+
+            // visit the near side first, the far side only if the plane is closer than the worst candidate
+            const Node& node = nodes[r.node];
+            std::size_t half = r.count / 2;
+            Item left = {{2 * r.node + 1, r.first, half}, 0.0f};
+            Item right = {{2 * r.node + 2, r.first + half, r.count - half}, 0.0f};
+            float diff = p[node.axis] - node.split;
+            if (diff < 0.0f) {
+                right.plane = diff * diff;
+                stack.push_back(right);
+                stack.push_back(left);
+            }
+            else {
+                left.plane = diff * diff;
+                stack.push_back(left);
+                stack.push_back(right);
+            }
+        }
+
+        std::sort_heap(heap.begin(), heap.end());
+    }
+
+    /* Calls func for the points inside the cube around p with the half side length range until
+     * it returns false.
+     */
+    template <class Func>
+    void searchBox(const Base::Vector3f& p, float range, Func func) const
+    {
+        auto inside = [&](const Base::Vector3f& q) {
+            return std::fabs(q.x - p.x) <= range && std::fabs(q.y - p.y) <= range && std::fabs(q.z - p.z) <= range;
+        };
+
+        for (std::size_t pos = points.size(); pos < size(); pos++) {
+            if (inside(pending[pos - points.size()]) && !func(pos))
+                return;
+        }
+
+        std::vector<Range> stack;
+        if (!points.empty()) {
+            Range root = {0, 0, points.size()};
+            stack.push_back(root);
+        }
+        while (!stack.empty()) {
+            Range r = stack.back();
+            stack.pop_back();
+            if (r.count <= LeafSize) {
+                for (std::size_t pos = r.first; pos < r.first + r.count; pos++) {
+                    if (inside(points[pos]) && !func(pos))
+                        return;
+                }
+                continue;
+            }
+
+            const Node& node = nodes[r.node];
+            std::size_t half = r.count / 2;
+            if (p[node.axis] - range <= node.split) {
+                Range left = {2 * r.node + 1, r.first, half};
+                stack.push_back(left);
+            }
+            if (p[node.axis] + range >= node.split) {
+                Range right = {2 * r.node + 2, r.first + half, r.count - half};
+                stack.push_back(right);
+            }
+        }
+    }
+
+    void searchRadius(const Base::Vector3f& p, float radius, std::vector<Neighbour>& result) const
+    {
+        result.clear();
+        float sqrRadius = radius * radius;
+        searchBox(p, radius, [&](std::size_t pos) {
+            Neighbour nb;
+            nb.dist = Base::DistanceP2(p, point(pos));
+            nb.pos = pos;
+            if (nb.dist <= sqrRadius)
+                result.push_back(nb);
+            return true;
+        });
+        std::sort(result.begin(), result.end());
+    }
+
+    unsigned long searchExact(const Base::Vector3f& p) const
+    {
+        unsigned long index = ULONG_MAX;
+        searchBox(p, std::numeric_limits<float>::epsilon(), [&](std::size_t pos) {
+            index = this->index(pos);
+            return false;
+        });
+        return index;
+    }
+
+    template <class Points>
+    void findNearest(const Points& pnts, float max_dist, std::vector<unsigned long>& result) const
+    {
+        result.assign(pnts.size(), ULONG_MAX);
+        float maxDist = max_dist < 0.0f ? std::numeric_limits<float>::max() : max_dist * max_dist;
+        std::vector<std::size_t> blocks = blockStarts(pnts.size());
+        QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+            std::vector<Neighbour> heap;
+            std::size_t last = std::min(start + QueryBlockSize, pnts.size());
+            for (std::size_t i = start; i < last; i++) {
+                searchNearest(pnts[i], 1, maxDist, heap);
+                if (!heap.empty())
+                    result[i] = index(heap.front().pos);
+            }
+        });
+    }
+
+    template <class Points>
+    void findExact(const Points& pnts, std::vector<unsigned long>& result) const
+    {
+        result.resize(pnts.size());
+        std::vector<std::size_t> blocks = blockStarts(pnts.size());
+        QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+            std::size_t last = std::min(start + QueryBlockSize, pnts.size());
+            for (std::size_t i = start; i < last; i++)
+                result[i] = searchExact(pnts[i]);
+        });
+    }
+
+    template <class Points>
+    void findKNearest(const Points& pnts, unsigned long k, std::vector<unsigned long>& result) const
+    {
+        result.assign(pnts.size() * k, ULONG_MAX);
+        std::vector<std::size_t> blocks = blockStarts(pnts.size());
+        QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+            std::vector<Neighbour> heap;
+            std::size_t last = std::min(start + QueryBlockSize, pnts.size());
+            for (std::size_t i = start; i < last; i++) {
+                searchNearest(pnts[i], k, std::numeric_limits<float>::max(), heap);
+                for (std::size_t j = 0; j < heap.size(); j++)
+                    result[i * k + j] = index(heap[j].pos);
+            }
+        });
+    }
+
+    template <class Points>
+    void findInRadius(const Points& pnts, float radius, std::vector<std::vector<unsigned long> >& result) const
+    {
+        result.clear();
+        result.resize(pnts.size());
+        std::vector<std::size_t> blocks = blockStarts(pnts.size());
+        QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+            std::vector<Neighbour> found;
+            std::size_t last = std::min(start + QueryBlockSize, pnts.size());
+            for (std::size_t i = start; i < last; i++) {
+                searchRadius(pnts[i], radius, found);
+                result[i].resize(found.size());
+                for (std::size_t j = 0; j < found.size(); j++)
+                    result[i][j] = index(found[j].pos);
+            }
+        });
+    }
 };
 
 MeshKDTree::MeshKDTree() : d(new Private)
@@ -88,18 +414,12 @@ MeshKDTree::MeshKDTree() : d(new Private)
 
 MeshKDTree::MeshKDTree(const std::vector<Base::Vector3f>& points) : d(new Private)
 {
-    unsigned long index=0;
-    for (std::vector<Base::Vector3f>::const_iterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
-    }
+    d->add(points);
 }
 
 MeshKDTree::MeshKDTree(const MeshPointArray& points) : d(new Private)
 {
-    unsigned long index=0;
-    for (MeshPointArray::_TConstIterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
-    }
+    d->add(points);
 }
 
 MeshKDTree::~MeshKDTree()
@@ -109,81 +429,128 @@ MeshKDTree::~MeshKDTree()
 
 void MeshKDTree::AddPoint(Base::Vector3f& point)
 {
-    unsigned long index=d->kd_tree.size();
-    d->kd_tree.insert(Point3d(point, index));
+    d->pending.push_back(point);
 }
 
 void MeshKDTree::AddPoints(const std::vector<Base::Vector3f>& points)
 {
-    unsigned long index=d->kd_tree.size();
-    for (std::vector<Base::Vector3f>::const_iterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
-    }
+    d->add(points);
 }
 
 void MeshKDTree::AddPoints(const MeshPointArray& points)
 {
-    unsigned long index=d->kd_tree.size();
-    for (MeshPointArray::_TConstIterator it = points.begin(); it != points.end(); ++it) {
-        d->kd_tree.insert(Point3d(*it, index++));
-    }
+    d->add(points);
 }
 
 bool MeshKDTree::IsEmpty() const
 {
-    return d->kd_tree.empty();
+    return d->size() == 0;
 }
 
 void MeshKDTree::Clear()
 {
-    d->kd_tree.clear();
+    d->points.clear();
+    d->indices.clear();
+    d->nodes.clear();
+    d->pending.clear();
 }
 
 void MeshKDTree::Optimize()
 {
-    d->kd_tree.optimize();
+    if (!d->pending.empty()) {
+        std::vector<Entry> entries;
+        d->collect(entries);
+        d->build(entries);
+    }
 }
 
 unsigned long MeshKDTree::FindNearest(const Base::Vector3f& p, Base::Vector3f& n, float& dist) const
 {
-    std::pair<MyKDTree::const_iterator, MyKDTree::distance_type> it =
-        d->kd_tree.find_nearest(Point3d(p,0));
-    if (it.first == d->kd_tree.end())
-        return ULONG_MAX;
-    unsigned long index = it.first->i;
-    n = it.first->p;
-    dist = it.second;
-    return index;
+    return FindNearest(p, std::numeric_limits<float>::max(), n, dist);
 }
 
 unsigned long MeshKDTree::FindNearest(const Base::Vector3f& p, float max_dist,
                                       Base::Vector3f& n, float& dist) const
 {
-    std::pair<MyKDTree::const_iterator, MyKDTree::distance_type> it =
-        d->kd_tree.find_nearest(Point3d(p,0), max_dist);
-    if (it.first == d->kd_tree.end())
+    // the squared maximum may overflow to infinity which is fine here
+    std::vector<Neighbour> heap;
+    d->searchNearest(p, 1, max_dist * max_dist, heap);
+    if (heap.empty())
         return ULONG_MAX;
-    unsigned long index = it.first->i;
-    n = it.first->p;
-    dist = it.second;
-    return index;
+    n = d->point(heap.front().pos);
+    dist = std::sqrt(heap.front().dist);
+    return d->index(heap.front().pos);
 }
 
 unsigned long MeshKDTree::FindExact(const Base::Vector3f& p) const
 {
-    MyKDTree::const_iterator it = 
-        d->kd_tree.find_exact(Point3d(p,0));
-    if (it == d->kd_tree.end())
-        return ULONG_MAX;
-    unsigned long index = it->i;
-    return index;
+    return d->searchExact(p);
 }
 
 void MeshKDTree::FindInRange(const Base::Vector3f& p, float range, std::vector<unsigned long>& indices) const
 {
-    std::vector<Point3d> v;
-    d->kd_tree.find_within_range(Point3d(p,0), range, std::back_inserter(v));
-    indices.reserve(v.size());
-    for (std::vector<Point3d>::iterator it = v.begin(); it != v.end(); ++it)
-        indices.push_back(it->i);
+    d->searchBox(p, range, [&](std::size_t pos) {
+        indices.push_back(d->index(pos));
+        return true;
+    });
+}
+
+void MeshKDTree::FindKNearest(const Base::Vector3f& p, unsigned long k, std::vector<unsigned long>& indices) const
+{
+    std::vector<Neighbour> heap;
+    d->searchNearest(p, k, std::numeric_limits<float>::max(), heap);
+    indices.resize(heap.size());
+    for (std::size_t i = 0; i < heap.size(); i++)
+        indices[i] = d->index(heap[i].pos);
+}
+
+void MeshKDTree::FindInRadius(const Base::Vector3f& p, float radius, std::vector<unsigned long>& indices) const
+{
+    std::vector<Neighbour> found;
+    d->searchRadius(p, radius, found);
+    indices.resize(found.size());
+    for (std::size_t i = 0; i < found.size(); i++)
+        indices[i] = d->index(found[i].pos);
+}
+
+void MeshKDTree::FindNearest(const std::vector<Base::Vector3f>& pnts, float max_dist, std::vector<unsigned long>& indices) const
+{
+    d->findNearest(pnts, max_dist, indices);
+}
+
+void MeshKDTree::FindNearest(const MeshPointArray& pnts, float max_dist, std::vector<unsigned long>& indices) const
+{
+    d->findNearest(pnts, max_dist, indices);
+}
+
+void MeshKDTree::FindExact(const std::vector<Base::Vector3f>& pnts, std::vector<unsigned long>& indices) const
+{
+    d->findExact(pnts, indices);
+}
+
+void MeshKDTree::FindExact(const MeshPointArray& pnts, std::vector<unsigned long>& indices) const
+{
+    d->findExact(pnts, indices);
+}
+
+void MeshKDTree::FindKNearest(const std::vector<Base::Vector3f>& pnts, unsigned long k, std::vector<unsigned long>& indices) const
+{
+    d->findKNearest(pnts, k, indices);
+}
+
+void MeshKDTree::FindKNearest(const MeshPointArray& pnts, unsigned long k, std::vector<unsigned long>& indices) const
+{
+    d->findKNearest(pnts, k, indices);
+}
+
+void MeshKDTree::FindInRadius(const std::vector<Base::Vector3f>& pnts, float radius,
+                              std::vector<std::vector<unsigned long> >& indices) const
+{
+    d->findInRadius(pnts, radius, indices);
+}
+
+void MeshKDTree::FindInRadius(const MeshPointArray& pnts, float radius,
+                              std::vector<std::vector<unsigned long> >& indices) const
+{
+    d->findInRadius(pnts, radius, indices);
 }
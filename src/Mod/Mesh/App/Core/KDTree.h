@@ -29,6 +29,21 @@
 namespace MeshCore
 {
 
+/**
+ * The MeshKDTree is a static k-d tree to search points.
+ *
+ * The tree has an implicit layout, i.e. the children of node i are the nodes 2i+1 and 2i+2
+ * and each node splits its points at their median. So only the split planes need to be stored
+ * and the points are kept in one flat array in the order of the leaves. The upper levels are
+ * built serially, the subtrees below in parallel.
+ *
+ * Points added with AddPoint() are searched linearly until Optimize() rebuilds the tree. All
+ * search functions are const and can be called from several threads at the same time, the
+ * batched searches distribute their queries over all cores.
+ *
+ * The returned indices refer to the order the points were added in, ULONG_MAX is returned if
+ * no point was found.
+ */
 class MeshExport MeshKDTree
 {
 public:
@@ -43,13 +58,53 @@ public:
 
     bool IsEmpty() const;
     void Clear();
+    /// Rebuilds the tree including the points added with AddPoint()
     void Optimize();
 
-    unsigned long FindNearest(const Base::Vector3f& p, Base::Vector3f& n, float&) const;
+    /** @name Search */
+    //@{
+    /** Returns the index of the point nearest to \a p, the point is written to \a n and its
+     * distance to \a p to \a dist.
+     */
+    unsigned long FindNearest(const Base::Vector3f& p, Base::Vector3f& n, float& dist) const;
+    /** Does the same as above but only considers points within \a max_dist. */
     unsigned long FindNearest(const Base::Vector3f& p, float max_dist,
-                              Base::Vector3f& n, float&) const;
+                              Base::Vector3f& n, float& dist) const;
+    /** Returns the index of a point with the coordinates of \a p. */
     unsigned long FindExact(const Base::Vector3f& p) const;
-    void FindInRange(const Base::Vector3f&, float, std::vector<unsigned long>&) const;
+    /** Returns the indices of the points inside the cube with center \a p and the half
+     * side length \a range.
+     */
+    void FindInRange(const Base::Vector3f& p, float range, std::vector<unsigned long>& indices) const;
+    /** Returns the indices of the \a k nearest points sorted by increasing distance. */
+    void FindKNearest(const Base::Vector3f& p, unsigned long k, std::vector<unsigned long>& indices) const;
+    /** Returns the indices of the points with a distance to \a p not greater than \a radius,
+     * sorted by increasing distance.
+     */
+    void FindInRadius(const Base::Vector3f& p, float radius, std::vector<unsigned long>& indices) const;
+    //@}
+
+    /** @name Batched search
+     * Searches the points for every point of \a pnts in parallel.
+     */
+    //@{
+    /** Writes the index of the nearest point to \a indices, a negative \a max_dist searches
+     * without limit.
+     */
+    void FindNearest(const std::vector<Base::Vector3f>& pnts, float max_dist, std::vector<unsigned long>& indices) const;
+    void FindNearest(const MeshPointArray& pnts, float max_dist, std::vector<unsigned long>& indices) const;
+    /** Writes the index of a point with the same coordinates to \a indices. */
+    void FindExact(const std::vector<Base::Vector3f>& pnts, std::vector<unsigned long>& indices) const;
+    void FindExact(const MeshPointArray& pnts, std::vector<unsigned long>& indices) const;
+    /** Writes one block of \a k indices per point to \a indices, sorted by increasing distance. */
+    void FindKNearest(const std::vector<Base::Vector3f>& pnts, unsigned long k, std::vector<unsigned long>& indices) const;
+    void FindKNearest(const MeshPointArray& pnts, unsigned long k, std::vector<unsigned long>& indices) const;
+    /** Writes the indices of the points within \a radius of each point to \a indices. */
+    void FindInRadius(const std::vector<Base::Vector3f>& pnts, float radius,
+                      std::vector<std::vector<unsigned long> >& indices) const;
+    void FindInRadius(const MeshPointArray& pnts, float radius,
+                      std::vector<std::vector<unsigned long> >& indices) const;
+    //@}
 
 private:
     class Private;
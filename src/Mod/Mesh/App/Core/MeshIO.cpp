@@ -43,6 +43,8 @@
 #include <zipios++/gzipoutputstream.h>
 
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -291,6 +293,64 @@ bool MeshInput::LoadSTL (std::istream &rstrIn)
 }
 
 /** Loads an OBJ file. */
+namespace {
+// Scans the coordinates of a 'v x y z' line after the 'v'. Returns false
+// for any other format, e.g. with colors, which is left to the regular
+// expressions.
+bool scanObjVertex(const char* str, float& x, float& y, float& z)
+{
+    float* coords[3] = {&x, &y, &z};
+    for (int i = 0; i < 3; i++) {
+        while (*str == ' ' || *str == '\t')
+            str++;
+        const char* start = str;
+        while ((*str >= '0' && *str <= '9') || *str == '.' || *str == '-' ||
+               *str == '+' || *str == 'e' || *str == 'E')
+            str++;
+        if (str == start)
+            return false;
+        char* end = nullptr;
+        *coords[i] = static_cast<float>(strtod(start, &end));
+        if (end != str)
+            return false;
+        if (*str && *str != ' ' && *str != '\t' && *str != '\r')
+            return false;
+    }
+    while (*str == ' ' || *str == '\t' || *str == '\r')
+        str++;
+    return *str == '\0';
+}
+
+// Scans the vertex indices 'i', 'i/t', 'i//n' or 'i/t/n' of a face line after
+// the 'f'. Returns the number of vertices or 0 for any other format.
+int scanObjFace(const char* str, int* indices, int maxIndices)
+{
+    int count = 0;
+    for (;;) {
+        while (*str == ' ' || *str == '\t' || *str == '\r')
+            str++;
+        if (*str == '\0')
+            return count;
+        if (count == maxIndices)
+            return 0;
+        char* end = nullptr;
+        long index = strtol(str, &end, 10);
+        if (end == str)
+            return 0;
+        str = end;
+        // skip texture and normal indices
+        for (int i = 0; i < 2 && *str == '/'; i++) {
+            str++;
+            strtol(str, &end, 10);
+            str = end;
+        }
+        if (*str && *str != ' ' && *str != '\t' && *str != '\r')
+            return 0;
+        indices[count++] = static_cast<int>(index);
+    }
+}
+}
+
 bool MeshInput::LoadOBJ (std::istream &rstrIn)
 {
     boost::regex rx_m("^mtllib\\s+([\\x21-\\x7E]+)\\s*$");
@@ -340,7 +400,53 @@ bool MeshInput::LoadOBJ (std::istream &rstrIn)
     std::string materialName;
     unsigned long countMaterialFacets = 0;
 
+    auto startFacets = [&]() {
+        // starts a new segment
+        if (new_segment) {
+            if (!groupName.empty()) {
+                _groupNames.push_back(groupName);
+                groupName.clear();
+            }
+            new_segment = false;
+            segment++;
+        }
+    };
+    auto pointIndex = [&meshPoints](int index) {
+        return index > 0 ? index-1 : index+static_cast<int>(meshPoints.size());
+    };
+    auto addFacet = [&](int p1, int p2, int p3) {
+        item.SetVertices(p1,p2,p3);
+        item.SetProperty(segment);
+        meshFacets.push_back(item);
+        countMaterialFacets++;
+    };
+
     while (std::getline(rstrIn, line)) {
+        // Handle the most common vertex and face lines without the regular
+        // expressions which are rather slow
+        if (line.size() > 1 && (line[1] == ' ' || line[1] == '\t')) {
+            if (line[0] == 'v' && scanObjVertex(line.c_str() + 1, fX, fY, fZ)) {
+                meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
+                continue;
+            }
+            if (line[0] == 'f') {
+                int indices[4];
+                int count = scanObjFace(line.c_str() + 1, indices, 4);
+                if (count == 3 || count == 4) {
+                    startFacets();
+                    i1 = pointIndex(indices[0]);
+                    i2 = pointIndex(indices[1]);
+                    i3 = pointIndex(indices[2]);
+                    addFacet(i1,i2,i3);
+                    if (count == 4) {
+                        i4 = pointIndex(indices[3]);
+                        addFacet(i3,i4,i1);
+                    }
+                    continue;
+                }
+            }
+        }
+
         // when a group name comes don't make it lower case
         if (!line.empty() && line[0] != 'g') {
             for (std::string::iterator it = line.begin(); it != line.end(); ++it)
@@ -396,58 +502,24 @@ bool MeshInput::LoadOBJ (std::istream &rstrIn)
             countMaterialFacets = 0;
         }
         else if (boost::regex_match(line.c_str(), what, rx_f3)) {
-            // starts a new segment
-            if (new_segment) {
-                if (!groupName.empty()) {
-                    _groupNames.push_back(groupName);
-                    groupName.clear();
-                }
-                new_segment = false;
-                segment++;
-            }
+            startFacets();
 
             // 3-vertex face
-            i1 = std::atoi(what[1].first);
-            i1 = i1 > 0 ? i1-1 : i1+static_cast<int>(meshPoints.size());
-            i2 = std::atoi(what[2].first);
-            i2 = i2 > 0 ? i2-1 : i2+static_cast<int>(meshPoints.size());
-            i3 = std::atoi(what[3].first);
-            i3 = i3 > 0 ? i3-1 : i3+static_cast<int>(meshPoints.size());
-            item.SetVertices(i1,i2,i3);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
+            i1 = pointIndex(std::atoi(what[1].first));
+            i2 = pointIndex(std::atoi(what[2].first));
+            i3 = pointIndex(std::atoi(what[3].first));
+            addFacet(i1,i2,i3);
         }
         else if (boost::regex_match(line.c_str(), what, rx_f4)) {
-            // starts a new segment
-            if (new_segment) {
-                if (!groupName.empty()) {
-                    _groupNames.push_back(groupName);
-                    groupName.clear();
-                }
-                new_segment = false;
-                segment++;
-            }
+            startFacets();
 
             // 4-vertex face
-            i1 = std::atoi(what[1].first);
-            i1 = i1 > 0 ? i1-1 : i1+static_cast<int>(meshPoints.size());
-            i2 = std::atoi(what[2].first);
-            i2 = i2 > 0 ? i2-1 : i2+static_cast<int>(meshPoints.size());
-            i3 = std::atoi(what[3].first);
-            i3 = i3 > 0 ? i3-1 : i3+static_cast<int>(meshPoints.size());
-            i4 = std::atoi(what[4].first);
-            i4 = i4 > 0 ? i4-1 : i4+static_cast<int>(meshPoints.size());
-
-            item.SetVertices(i1,i2,i3);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
-
-            item.SetVertices(i3,i4,i1);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
+            i1 = pointIndex(std::atoi(what[1].first));
+            i2 = pointIndex(std::atoi(what[2].first));
+            i3 = pointIndex(std::atoi(what[3].first));
+            i4 = pointIndex(std::atoi(what[4].first));
+            addFacet(i1,i2,i3);
+            addFacet(i3,i4,i1);
         }
     }
 
@@ -797,6 +869,39 @@ namespace MeshCore {
                 return x.first == y;
             }
         };
+
+        // Scans the next number of an ASCII line and advances the pointer.
+        // Returns false if there is no number of the requested kind.
+        bool scanNumber(const char*& str, Number type, float& value)
+        {
+            char* end = nullptr;
+            switch (type) {
+            case int8:
+            case int16:
+            case int32:
+                value = static_cast<float>(strtol(str, &end, 10));
+                break;
+            case uint8:
+            case uint16:
+            case uint32:
+                while (*str == ' ' || *str == '\t')
+                    str++;
+                if (*str == '-' || *str == '+')
+                    return false;
+                value = static_cast<float>(strtoul(str, &end, 10));
+                break;
+            case float32:
+            case float64:
+                value = static_cast<float>(strtod(str, &end));
+                break;
+            default:
+                return false;
+            }
+            if (end == str)
+                return false;
+            str = end;
+            return true;
+        }
     }
     using namespace Ply;
 }
@@ -1037,84 +1142,64 @@ bool MeshInput::LoadPLY (std::istream &inp)
         }
     }
 
-    if (format == ascii) {
-        boost::regex rx_d("(([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?))\\s*");
-        boost::regex rx_s("\\b([-+]?[0-9]+)\\s*");
-        boost::regex rx_u("\\b([0-9]+)\\s*");
-        boost::regex rx_f("^\\s*3\\s+([0-9]+)\\s+([0-9]+)\\s+([0-9]+)\\s*");
-        boost::smatch what;
+    // positions of the used properties in a vertex record
+    auto propertyIndex = [&vertex_props](const char* name) {
+        for (std::size_t i = 0; i < vertex_props.size(); i++) {
+            if (vertex_props[i].first == name)
+                return i;
+        }
+        return vertex_props.size();
+    };
+    const std::size_t index_x = propertyIndex("x");
+    const std::size_t index_y = propertyIndex("y");
+    const std::size_t index_z = propertyIndex("z");
+    const std::size_t index_r = propertyIndex("red");
+    const std::size_t index_g = propertyIndex("green");
+    const std::size_t index_b = propertyIndex("blue");
+    std::vector<float> prop_values(vertex_props.size());
+
+    meshPoints.reserve(v_count);
+    meshFacets.reserve(f_count);
+
+    auto addVertex = [&]() {
+        meshPoints.push_back(MeshPoint(prop_values[index_x], prop_values[index_y], prop_values[index_z]));
+
+        if (_material && (rgb_value == MeshIO::PER_VERTEX)) {
+            float r = (prop_values[index_r]) / 255.0f;
+            float g = (prop_values[index_g]) / 255.0f;
+            float b = (prop_values[index_b]) / 255.0f;
+            _material->diffuseColor.emplace_back(r, g, b);
+        }
+    };
 
+    if (format == ascii) {
         for (std::size_t i = 0; i < v_count && std::getline(inp, line); i++) {
             // go through the vertex properties
-            std::map<std::string, float> prop_values;
-            for (std::vector<std::pair<std::string, Number> >::iterator it = vertex_props.begin(); it != vertex_props.end(); ++it) {
-                switch (it->second) {
-                case int8:
-                case int16:
-                case int32:
-                    {
-                        if (boost::regex_search(line, what, rx_s)) {
-                            int v;
-                            v = boost::lexical_cast<int>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                case uint8:
-                case uint16:
-                case uint32:
-                    {
-                        if (boost::regex_search(line, what, rx_u)) {
-                            int v;
-                            v = boost::lexical_cast<int>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                case float32:
-                case float64:
-                    {
-                        if (boost::regex_search(line, what, rx_d)) {
-                            double v;
-                            v = boost::lexical_cast<double>(what[1]);
-                            prop_values[it->first] = static_cast<float>(v);
-                            line = line.substr(what[0].length());
-                        }
-                        else {
-                            return false;
-                        }
-                    } break;
-                default:
+            const char* str = line.c_str();
+            for (std::size_t j = 0; j < vertex_props.size(); j++) {
+                if (!scanNumber(str, vertex_props[j].second, prop_values[j]))
                     return false;
-                }
             }
 
-            Base::Vector3f pt;
-            pt.x = (prop_values["x"]);
-            pt.y = (prop_values["y"]);
-            pt.z = (prop_values["z"]);
-            meshPoints.push_back(pt);
-
-            if (_material && (rgb_value == MeshIO::PER_VERTEX)) {
-                float r = (prop_values["red"]) / 255.0f;
-                float g = (prop_values["green"]) / 255.0f;
-                float b = (prop_values["blue"]) / 255.0f;
-                _material->diffuseColor.emplace_back(r, g, b);
-            }
+            addVertex();
         }
 
-        int f1, f2, f3;
+        // only triangles are supported
+        auto scanIndex = [](const char*& str, unsigned long& index) {
+            char* end = nullptr;
+            while (*str == ' ' || *str == '\t')
+                str++;
+            if (*str < '0' || *str > '9')
+                return false;
+            index = strtoul(str, &end, 10);
+            str = end;
+            return true;
+        };
         for (std::size_t i = 0; i < f_count && std::getline(inp, line); i++) {
-            if (boost::regex_search(line, what, rx_f)) {
-                f1 = boost::lexical_cast<int>(what[1]);
-                f2 = boost::lexical_cast<int>(what[2]);
-                f3 = boost::lexical_cast<int>(what[3]);
+            const char* str = line.c_str();
+            unsigned long n, f1, f2, f3;
+            if (scanIndex(str, n) && n == 3 &&
+                scanIndex(str, f1) && scanIndex(str, f2) && scanIndex(str, f3)) {
                 meshFacets.push_back(MeshFacet(f1,f2,f3));
             }
         }
@@ -1127,68 +1212,76 @@ bool MeshInput::LoadPLY (std::istream &inp)
         else
             is.setByteOrder(Base::Stream::BigEndian);
 
-        for (std::size_t i = 0; i < v_count; i++) {
+        // If all vertex properties are floats read a block of vertices at once
+        bool allFloats = std::all_of(vertex_props.begin(), vertex_props.end(),
+                    [](const std::pair<std::string, Number>& p) { return p.second == float32; });
+        if (allFloats) {
+            const std::size_t blockSize = 4096;
+            std::vector<float> block(blockSize * vertex_props.size());
+            for (std::size_t i = 0; i < v_count; i += blockSize) {
+                std::size_t count = std::min(blockSize, v_count - i);
+                is.read(&block[0], count * vertex_props.size());
+                if (!inp)
+                    return false;
+                for (std::size_t j = 0; j < count; j++) {
+                    std::copy(block.begin() + j * vertex_props.size(),
+                              block.begin() + (j + 1) * vertex_props.size(), prop_values.begin());
+                    addVertex();
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < v_count && !allFloats; i++) {
             // go through the vertex properties
-            std::map<std::string, float> prop_values;
-            for (std::vector<std::pair<std::string, Number> >::iterator it = vertex_props.begin(); it != vertex_props.end(); ++it) {
+            std::vector<float>::iterator value = prop_values.begin();
+            for (std::vector<std::pair<std::string, Number> >::iterator it = vertex_props.begin(); it != vertex_props.end(); ++it, ++value) {
                 switch (it->second) {
                 case int8:
                     {
                         int8_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        *value = static_cast<float>(v);
                     } break;
                 case uint8:
                     {
                         uint8_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        *value = static_cast<float>(v);
                     } break;
                 case int16:
                     {
                         int16_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        *value = static_cast<float>(v);
                     } break;
                 case uint16:
                     {
                         uint16_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        *value = static_cast<float>(v);
                     } break;
                 case int32:
                     {
                         int32_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        *value = static_cast<float>(v);
                     } break;
                 case uint32:
                     {
                         uint32_t v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        *value = static_cast<float>(v);
                     } break;
                 case float32:
                     {
                         float v; is >> v;
-                        prop_values[it->first] = v;
+                        *value = v;
                     } break;
                 case float64:
                     {
                         double v; is >> v;
-                        prop_values[it->first] = static_cast<float>(v);
+                        *value = static_cast<float>(v);
                     } break;
                 default:
                     return false;
                 }
             }
 
-            Base::Vector3f pt;
-            pt.x = (prop_values["x"]);
-            pt.y = (prop_values["y"]);
-            pt.z = (prop_values["z"]);
-            meshPoints.push_back(pt);
-
-            if (_material && (rgb_value == MeshIO::PER_VERTEX)) {
-                float r = (prop_values["red"]) / 255.0f;
-                float g = (prop_values["green"]) / 255.0f;
-                float b = (prop_values["blue"]) / 255.0f;
-                _material->diffuseColor.emplace_back(r, g, b);
-            }
+            addVertex();
         }
 
         unsigned char n;
@@ -1432,15 +1525,25 @@ bool MeshInput::LoadBinarySTL (std::istream &rstrIn)
 #endif
     builder.Initialize(ulCt);
 
-    for (uint32_t i = 0; i < ulCt; i++) {
-        // read normal, points
-        rstrIn.read((char*)&clVects, sizeof(clVects));
-
-        std::swap(clVects[0], clVects[3]);
-        builder.AddFacet(clVects);
-
-        // overread 2 bytes attribute
-        rstrIn.read((char*)&usAtt, sizeof(usAtt));
+    // Read the facets in blocks instead of doing two stream reads per facet.
+    // Each record consists of the normal, three points and a 2 bytes attribute.
+    const uint32_t recordSize = sizeof(clVects) + sizeof(usAtt);
+    const uint32_t blockSize = 8192;
+    std::vector<char> block(static_cast<size_t>(blockSize) * recordSize);
+    for (uint32_t i = 0; i < ulCt; i += blockSize) {
+        uint32_t ctRecords = std::min(blockSize, ulCt - i);
+        rstrIn.read(&block[0], static_cast<std::streamsize>(ctRecords) * recordSize);
+        if (!rstrIn)
+            return false;
+
+        const char* record = &block[0];
+        for (uint32_t j = 0; j < ctRecords; j++, record += recordSize) {
+            // read normal, points
+            memcpy(clVects, record, sizeof(clVects));
+
+            std::swap(clVects[0], clVects[3]);
+            builder.AddFacet(clVects);
+        }
     }
 
     builder.Finish();
@@ -23,8 +23,11 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <numeric>
 #endif
 
+#include <QtConcurrentMap>
+
 #include "Segmentation.h"
 #include "Algorithm.h"
 #include "Approximation.h"
@@ -44,6 +47,11 @@ void MeshSurfaceSegment::AddFacet(const MeshFacet&)
 {
 }
 
+bool MeshSurfaceSegment::IsStatic() const
+{
+    return false;
+}
+
 void MeshSurfaceSegment::AddSegment(const std::vector<unsigned long>& segm)
 {
     if (segm.size() >= minFacets) {
@@ -556,6 +564,11 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
         resetVisited.clear();
 
+        if ((*it)->IsStatic()) {
+            FindStaticSegments(**it, resetVisited);
+            continue;
+        }
+
         MeshCore::MeshIsNotFlag<MeshCore::MeshFacet> flag;
         iCur = std::find_if(iBeg, iEnd, [flag](const MeshFacet& f) {
             return flag(f, MeshFacet::VISIT);
@@ -592,3 +605,125 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
         }
     }
 }
+
+namespace {
+unsigned long findRoot(std::vector<unsigned long>& parent, unsigned long index)
+{
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+}
+
+/**
+ * Gives the same result as the region growing of FindSegments() but for segments whose
+ * test doesn't depend on the already added facets. All facets are tested in parallel first,
+ * then the connected regions of accepted facets are determined with a union-find over
+ * their common edges. The regions are finally handed out in the order the region growing
+ * would have visited them.
+ */
+void MeshSegmentAlgorithm::FindStaticSegments(MeshSurfaceSegment& segm, std::vector<unsigned long>& resetVisited)
+{
+    const MeshCore::MeshFacetArray& rFAry = myKernel.GetFacets();
+    std::size_t numFacets = rFAry.size();
+
+    // test all facets that haven't been visited yet
+    std::vector<char> accepted(numFacets, 0);
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    const std::size_t blockSize = 4096;
+    for (std::size_t i = 0; i < numFacets; i += blockSize)
+        blocks.push_back(std::make_pair(i, std::min(i + blockSize, numFacets)));
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            const MeshFacet& face = rFAry[i];
+            if (!face.IsFlag(MeshFacet::VISIT) && segm.TestFacet(face))
+                accepted[i] = 1;
+        }
+    });
+
+    // merge adjacent accepted facets into regions
+    std::vector<unsigned long> parent(numFacets);
+    std::iota(parent.begin(), parent.end(), 0);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        if (!accepted[i])
+            continue;
+        for (int j = 0; j < 3; j++) {
+            unsigned long n = rFAry[i]._aulNeighbours[j];
+            if (n != ULONG_MAX && n < i && accepted[n]) {
+                unsigned long r1 = findRoot(parent, static_cast<unsigned long>(i));
+                unsigned long r2 = findRoot(parent, n);
+                if (r1 != r2)
+                    parent[std::max(r1, r2)] = std::min(r1, r2);
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < numFacets; i++)
+        parent[i] = findRoot(parent, static_cast<unsigned long>(i));
+
+    // the facets of each region in ascending order
+    std::vector<unsigned long> regionOffsets(numFacets + 1, 0);
+    for (std::size_t i = 0; i < numFacets; i++) {
+        if (accepted[i])
+            regionOffsets[parent[i] + 1]++;
+    }
+    std::partial_sum(regionOffsets.begin(), regionOffsets.end(), regionOffsets.begin());
+    std::vector<unsigned long> regionFacets(regionOffsets.back());
+    {
+        std::vector<unsigned long> pos(regionOffsets.begin(), regionOffsets.end() - 1);
+        for (std::size_t i = 0; i < numFacets; i++) {
+            if (accepted[i])
+                regionFacets[pos[parent[i]]++] = static_cast<unsigned long>(i);
+        }
+    }
+
+    // the region growing starts at the first not visited facet and takes the regions of
+    // all accepted neighbours
+    for (std::size_t i = 0; i < numFacets; i++) {
+        const MeshFacet& face = rFAry[i];
+        if (face.IsFlag(MeshFacet::VISIT))
+            continue;
+
+        unsigned long startFacet = static_cast<unsigned long>(i);
+        std::vector<unsigned long> indices;
+        segm.Initialize(startFacet);
+        if (segm.TestInitialFacet(startFacet))
+            indices.push_back(startFacet);
+        face.SetFlag(MeshFacet::VISIT);
+
+        std::vector<unsigned long> roots;
+        if (accepted[i]) {
+            roots.push_back(parent[i]);
+        }
+        else {
+            for (int j = 0; j < 3; j++) {
+                unsigned long n = face._aulNeighbours[j];
+                if (n != ULONG_MAX && accepted[n] && !rFAry[n].IsFlag(MeshFacet::VISIT))
+                    roots.push_back(parent[n]);
+            }
+            std::sort(roots.begin(), roots.end());
+            roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+        }
+
+        for (std::vector<unsigned long>::iterator it = roots.begin(); it != roots.end(); ++it) {
+            for (unsigned long k = regionOffsets[*it]; k < regionOffsets[*it + 1]; k++) {
+                unsigned long index = regionFacets[k];
+                if (index == startFacet)
+                    continue;
+                rFAry[index].SetFlag(MeshFacet::VISIT);
+                indices.push_back(index);
+                segm.AddFacet(rFAry[index]);
+            }
+        }
+
+        // add or discard the segment
+        if (indices.size() <= 1) {
+            resetVisited.push_back(startFacet);
+        }
+        else {
+            segm.AddSegment(indices);
+        }
+    }
+}
@@ -48,6 +48,11 @@ public:
     virtual void Initialize(unsigned long);
     virtual bool TestInitialFacet(unsigned long) const;
     virtual void AddFacet(const MeshFacet& rclFacet);
+    /** Returns true if the result of TestFacet() only depends on the facet itself and not
+     * on the facets that have been added to the segment before. The facets of such segments
+     * are tested in parallel.
+     */
+    virtual bool IsStatic() const;
     void AddSegment(const std::vector<unsigned long>&);
     const std::vector<MeshSegment>& GetSegments() const { return segments; }
     MeshSegment FindSegment(unsigned long) const;
@@ -190,6 +195,7 @@ class MeshExport MeshCurvatureSurfaceSegment : public MeshSurfaceSegment
 public:
     MeshCurvatureSurfaceSegment(const std::vector<CurvatureInfo>& ci, unsigned long minFacets)
         : MeshSurfaceSegment(minFacets), info(ci) {}
+    virtual bool IsStatic() const { return true; }
 
 protected:
     const std::vector<CurvatureInfo>& info;
@@ -272,6 +278,9 @@ public:
     MeshSegmentAlgorithm(const MeshKernel& kernel) : myKernel(kernel) {}
     void FindSegments(std::vector<MeshSurfaceSegmentPtr>&);
 
+private:
+    void FindStaticSegments(MeshSurfaceSegment&, std::vector<unsigned long>& resetVisited);
+
 private:
     const MeshKernel& myKernel;
 };
@@ -25,9 +25,12 @@
 
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <ios>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <fstream>
 #include "SetOperations.h"
 #include "Algorithm.h"
@@ -170,171 +173,239 @@ void SetOperations::Do ()
   MeshDefinitions::SetMinPointDistance(saveMinMeshDistance);
 }
 
+namespace {
+// Result of intersecting a facet of the first with a facet of the second mesh
+struct FacetCut
+{
+  unsigned long facet0, facet1;
+  int           isect;
+  MeshPoint     p0, p1;
+};
+
+// Moves the end points of the cut line onto a corner point of the facets if they are too close to it
+void snapCutLine (const MeshGeomFacet& f1, const MeshGeomFacet& f2, float minDistanceToPoint,
+                  MeshPoint& p0, MeshPoint& p1)
+{
+  float minDist1 = minDistanceToPoint, minDist2 = minDistanceToPoint;
+  MeshPoint np0 = p0, np1 = p1;
+  const MeshGeomFacet* facets[2] = {&f1, &f2};
+  for (int k = 0; k < 2; k++)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      const Vector3f& corner = facets[k]->_aclPoints[i];
+      float d1 = (corner - p0).Length();
+      float d2 = (corner - p1).Length();
+      if (d1 < minDist1)
+      {
+        minDist1 = d1;
+        np0 = corner;
+      }
+      if (d2 < minDist2)
+      {
+        minDist2 = d2;
+        np1 = corner;
+      }
+    }
+  }
+
+  p0 = np0;
+  p1 = np1;
+}
+
+template <class Container, class Function>
+void parallelForEach (Container& c, Function func)
+{
+  if (c.size() < 2)
+    std::for_each(c.begin(), c.end(), func);
+  else
+    QtConcurrent::blockingMap(c, func);
+}
+}
+
 void SetOperations::Cut (std::set<unsigned long>& facetsCuttingEdge0, std::set<unsigned long>& facetsCuttingEdge1)
 {
   MeshFacetGrid grid1(_cutMesh0, 20);
   MeshFacetGrid grid2(_cutMesh1, 20);
 
+  // bounding boxes of the facets to quickly reject pairs that cannot intersect
+  std::vector<Base::BoundBox3f> boxes1(_cutMesh1.CountFacets());
+  MeshFacetIterator it(_cutMesh1);
+  for (it.Init(); it.More(); it.Next())
+    boxes1[it.Position()] = it->GetBoundBox();
+
+  struct GridCell
+  {
+    unsigned long x, y, z;
+    std::vector<std::pair<unsigned long, unsigned long> > pairs;
+  };
+
   unsigned long ctGx1, ctGy1, ctGz1;
   grid1.GetCtGrids(ctGx1, ctGy1, ctGz1);
 
-  unsigned long gx1;
-  for (gx1 = 0; gx1 < ctGx1; gx1++)  
+  std::vector<GridCell> cells;
+  for (unsigned long gx1 = 0; gx1 < ctGx1; gx1++)
   {
-    unsigned long gy1;
-    for (gy1 = 0; gy1 < ctGy1; gy1++)
+    for (unsigned long gy1 = 0; gy1 < ctGy1; gy1++)
     {
-      unsigned long gz1;
-      for (gz1 = 0; gz1 < ctGz1; gz1++)
+      for (unsigned long gz1 = 0; gz1 < ctGz1; gz1++)
       {
         if (grid1.GetCtElements(gx1, gy1, gz1) > 0)
         {
-          std::vector<unsigned long> vecFacets2;
-          grid2.Inside(grid1.GetBoundBox(gx1, gy1, gz1), vecFacets2);
-      
-          if (vecFacets2.size() > 0)
-          {
-            std::set<unsigned long> vecFacets1;
-            grid1.GetElements(gx1, gy1, gz1, vecFacets1);
-            
-            std::set<unsigned long>::iterator it1;
-            for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1)
-            {
-              unsigned long fidx1 = *it1;
-              MeshGeomFacet f1 = _cutMesh0.GetFacet(*it1);
-              
-              std::vector<unsigned long>::iterator it2;
-              for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2)
-              {
-                unsigned long fidx2 = *it2;
-                MeshGeomFacet f2 = _cutMesh1.GetFacet(fidx2);
-
-                MeshPoint p0, p1;
-
-                int isect = f1.IntersectWithFacet(f2, p0, p1);
-                if (isect > 0)
-                { 
-                   // optimize cut line if distance to nearest point is too small
-                  float minDist1 = _minDistanceToPoint, minDist2 = _minDistanceToPoint;
-                  MeshPoint np0 = p0, np1 = p1;
-                  int i;
-                  for (i = 0; i < 3; i++)
-                  {
-                    float d1 = (f1._aclPoints[i] - p0).Length();
-                    float d2 = (f1._aclPoints[i] - p1).Length();
-                    if (d1 < minDist1)
-                    {
-                      minDist1 = d1;
-                      np0 = f1._aclPoints[i];
-                    }
-                    if (d2 < minDist2)
-                    {
-                      minDist2 = d2;
-                      p1 = f1._aclPoints[i];
-                    }
-                  } // for (int i = 0; i < 3; i++)
-
-                  // optimize cut line if distance to nearest point is too small
-                  for (i = 0; i < 3; i++)
-                  {
-                    float d1 = (f2._aclPoints[i] - p0).Length();
-                    float d2 = (f2._aclPoints[i] - p1).Length();
-                    if (d1 < minDist1)
-                    {
-                      minDist1 = d1;
-                      np0 = f2._aclPoints[i];
-                    }
-                    if (d2 < minDist2)
-                    {
-                      minDist2 = d2;
-                      np1 = f2._aclPoints[i];
-                    }
-                  } // for (int i = 0; i < 3; i++)
-
-                  MeshPoint mp0 = np0;
-                  MeshPoint mp1 = np1;
-
-                  if (mp0 != mp1)
-                  {
-                    facetsCuttingEdge0.insert(fidx1);
-                    facetsCuttingEdge1.insert(fidx2);
-
-                    _cutPoints.insert(mp0);
-                    _cutPoints.insert(mp1);
-
-                    std::pair<std::set<MeshPoint>::iterator, bool> pit0 = _cutPoints.insert(mp0);
-                    std::pair<std::set<MeshPoint>::iterator, bool> pit1 = _cutPoints.insert(mp1);
-
-                    _edges[Edge(mp0, mp1)] = EdgeInfo();
-
-                    _facet2points[0][fidx1].push_back(pit0.first);
-                    _facet2points[0][fidx1].push_back(pit1.first);
-                    _facet2points[1][fidx2].push_back(pit0.first);
-                    _facet2points[1][fidx2].push_back(pit1.first);
-
-                  }
-                  else
-                  {
-                    std::pair<std::set<MeshPoint>::iterator, bool> pit = _cutPoints.insert(mp0);
-
-                    // do not insert a facet when only one corner point cuts the edge
-                    // if (!((mp0 == f1._aclPoints[0]) || (mp0 == f1._aclPoints[1]) || (mp0 == f1._aclPoints[2])))
-                    {
-                      facetsCuttingEdge0.insert(fidx1);
-                      _facet2points[0][fidx1].push_back(pit.first);
-                    }
-
-                    // if (!((mp0 == f2._aclPoints[0]) || (mp0 == f2._aclPoints[1]) || (mp0 == f2._aclPoints[2])))
-                    {
-                      facetsCuttingEdge1.insert(fidx2);
-                      _facet2points[1][fidx2].push_back(pit.first);
-                    }
-                  }
-
-                 } // if (f1.IntersectWithFacet(f2, p0, p1))
-              } // for (it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2)
-            } // for (it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1)
-          } // if (vecFacets2.size() > 0)
-        } // if (grid1.GetCtElements(gx1, gy1, gz1) > 0)
-      } // for (gz1 = 0; gz1 < ctGz1; gz1++)
-    } // for (gy1 = 0; gy1 < ctGy1; gy1++)
-  } // for (gx1 = 0; gx1 < ctGx1; gx1++)  
+          GridCell cell;
+          cell.x = gx1; cell.y = gy1; cell.z = gz1;
+          cells.push_back(cell);
+        }
+      }
+    }
+  }
+
+  // collect the candidate pairs of facets per grid cell
+  const MeshKernel& cutMesh0 = _cutMesh0;
+  parallelForEach(cells, [&](GridCell& cell) {
+    std::vector<unsigned long> vecFacets2;
+    grid2.Inside(grid1.GetBoundBox(cell.x, cell.y, cell.z), vecFacets2);
+    if (vecFacets2.empty())
+      return;
+
+    std::set<unsigned long> vecFacets1;
+    grid1.GetElements(cell.x, cell.y, cell.z, vecFacets1);
+    for (std::set<unsigned long>::iterator it1 = vecFacets1.begin(); it1 != vecFacets1.end(); ++it1)
+    {
+      Base::BoundBox3f box0 = cutMesh0.GetFacet(*it1).GetBoundBox();
+      for (std::vector<unsigned long>::iterator it2 = vecFacets2.begin(); it2 != vecFacets2.end(); ++it2)
+      {
+        if (box0 && boxes1[*it2])
+          cell.pairs.push_back(std::make_pair(*it1, *it2));
+      }
+    }
+  });
+
+  // a facet can be registered in several grid cells, so remove duplicate pairs
+  std::vector<FacetCut> cuts;
+  {
+    std::size_t numPairs = 0;
+    for (std::vector<GridCell>::iterator jt = cells.begin(); jt != cells.end(); ++jt)
+      numPairs += jt->pairs.size();
+
+    std::vector<std::pair<unsigned long, unsigned long> > pairs;
+    pairs.reserve(numPairs);
+    for (std::vector<GridCell>::iterator jt = cells.begin(); jt != cells.end(); ++jt)
+    {
+      pairs.insert(pairs.end(), jt->pairs.begin(), jt->pairs.end());
+      std::vector<std::pair<unsigned long, unsigned long> >().swap(jt->pairs);
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    cuts.resize(pairs.size());
+    for (std::size_t i = 0; i < pairs.size(); i++)
+    {
+      cuts[i].facet0 = pairs[i].first;
+      cuts[i].facet1 = pairs[i].second;
+    }
+  }
+
+  // intersect the facet pairs
+  const MeshKernel& cutMesh1 = _cutMesh1;
+  float minDistanceToPoint = _minDistanceToPoint;
+  parallelForEach(cuts, [&](FacetCut& cut) {
+    MeshGeomFacet f1 = cutMesh0.GetFacet(cut.facet0);
+    MeshGeomFacet f2 = cutMesh1.GetFacet(cut.facet1);
+    cut.isect = f1.IntersectWithFacet(f2, cut.p0, cut.p1);
+    if (cut.isect > 0)
+    {
+      // optimize cut line if distance to nearest point is too small
+      snapCutLine(f1, f2, minDistanceToPoint, cut.p0, cut.p1);
+    }
+  });
+
+  // The cuts are merged in the order of the facet indices, so the result doesn't
+  // depend on the scheduling of the threads
+  for (std::vector<FacetCut>::iterator jt = cuts.begin(); jt != cuts.end(); ++jt)
+  {
+    if (jt->isect <= 0)
+      continue;
+
+    unsigned long fidx1 = jt->facet0;
+    unsigned long fidx2 = jt->facet1;
+    const MeshPoint& mp0 = jt->p0;
+    const MeshPoint& mp1 = jt->p1;
+
+    if (mp0 != mp1)
+    {
+      facetsCuttingEdge0.insert(fidx1);
+      facetsCuttingEdge1.insert(fidx2);
+
+      std::pair<std::set<MeshPoint>::iterator, bool> pit0 = _cutPoints.insert(mp0);
+      std::pair<std::set<MeshPoint>::iterator, bool> pit1 = _cutPoints.insert(mp1);
+
+      _edges[Edge(mp0, mp1)] = EdgeInfo();
+
+      _facet2points[0][fidx1].push_back(pit0.first);
+      _facet2points[0][fidx1].push_back(pit1.first);
+      _facet2points[1][fidx2].push_back(pit0.first);
+      _facet2points[1][fidx2].push_back(pit1.first);
+    }
+    else
+    {
+      std::pair<std::set<MeshPoint>::iterator, bool> pit = _cutPoints.insert(mp0);
+
+      facetsCuttingEdge0.insert(fidx1);
+      _facet2points[0][fidx1].push_back(pit.first);
+
+      facetsCuttingEdge1.insert(fidx2);
+      _facet2points[1][fidx2].push_back(pit.first);
+    }
+  }
 }
 
 void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
 {
-  // Triangulate Mesh 
+  struct CutFacet
+  {
+    unsigned long fidx;
+    const std::list<std::set<MeshPoint>::iterator>* cutPoints;
+    std::vector<MeshGeomFacet> facets;
+  };
+
+  std::vector<CutFacet> cutFacets;
+  cutFacets.reserve(_facet2points[side].size());
   std::map<unsigned long, std::list<std::set<MeshPoint>::iterator> >::iterator it1;
   for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1)
   {
+    CutFacet cf;
+    cf.fidx = it1->first;
+    cf.cutPoints = &it1->second;
+    cutFacets.push_back(cf);
+  }
+
+  // Triangulate the cut facets independently of each other
+  float minDistanceToPoint = _minDistanceToPoint;
+  parallelForEach(cutFacets, [&cutMesh, minDistanceToPoint](CutFacet& cf) {
     std::vector<Vector3f> points;
     std::set<MeshPoint>   pointsSet;
 
-    unsigned long fidx = it1->first;
-    MeshGeomFacet f = cutMesh.GetFacet(fidx);
-
-    //if (side == 1)
-    //    _builder.addSingleTriangle(f._aclPoints[0], f._aclPoints[1], f._aclPoints[2], 3, 0, 1, 1);
+    MeshGeomFacet f = cutMesh.GetFacet(cf.fidx);
 
-     // facet corner points
-    //const MeshFacet& mf = cutMesh._aclFacetArray[fidx];
+    // facet corner points
     int i;
     for (i = 0; i < 3; i++)
     {
       pointsSet.insert(f._aclPoints[i]);
       points.push_back(f._aclPoints[i]);
     }
-    
+
     // triangulated facets
-    std::list<std::set<MeshPoint>::iterator>::iterator it2;
-    for (it2 = it1->second.begin(); it2 != it1->second.end(); ++it2)
+    std::list<std::set<MeshPoint>::iterator>::const_iterator it2;
+    for (it2 = cf.cutPoints->begin(); it2 != cf.cutPoints->end(); ++it2)
     {
       if (pointsSet.find(*(*it2)) == pointsSet.end())
       {
         pointsSet.insert(*(*it2));
         points.push_back(*(*it2));
       }
-
     }
 
     Vector3f normal = f.GetNormal();
@@ -366,19 +437,11 @@ void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
       { // two same triangle corner points
         continue;
       }
-  
+
       MeshGeomFacet facet(points[it->_aulPoints[0]],
                           points[it->_aulPoints[1]],
                           points[it->_aulPoints[2]]);
 
-      //if (side == 1)
-      // _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1], facet._aclPoints[2], true, 3, 0, 1, 1);
-
-      //if (facet.Area() < 0.0001f)
-      //{ // too small facet
-      //  continue;
-      //}
-
       float dist0 = facet._aclPoints[0].DistanceToLine
           (facet._aclPoints[1],facet._aclPoints[1] - facet._aclPoints[2]);
       float dist1 = facet._aclPoints[1].DistanceToLine
@@ -386,22 +449,13 @@ void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
       float dist2 = facet._aclPoints[2].DistanceToLine
           (facet._aclPoints[0],facet._aclPoints[0] - facet._aclPoints[1]);
 
-      if ((dist0 < _minDistanceToPoint) ||
-          (dist1 < _minDistanceToPoint) ||
-          (dist2 < _minDistanceToPoint))
+      if ((dist0 < minDistanceToPoint) ||
+          (dist1 < minDistanceToPoint) ||
+          (dist2 < minDistanceToPoint))
       {
         continue;
       }
 
-      //dist0 = (facet._aclPoints[0] - facet._aclPoints[1]).Length();
-      //dist1 = (facet._aclPoints[1] - facet._aclPoints[2]).Length();
-      //dist2 = (facet._aclPoints[2] - facet._aclPoints[3]).Length();
-
-      //if ((dist0 < _minDistanceToPoint) || (dist1 < _minDistanceToPoint) || (dist2 < _minDistanceToPoint))
-      //{
-      //  continue;
-      //}
-
       facet.CalcNormal();
       if ((facet.GetNormal() * f.GetNormal()) < 0.0f)
       { // adjust normal
@@ -409,7 +463,16 @@ void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
          facet.CalcNormal();
       }
 
+      cf.facets.push_back(facet);
+    }
+  });
 
+  // register the new facets at the cut edges
+  for (std::vector<CutFacet>::iterator it = cutFacets.begin(); it != cutFacets.end(); ++it)
+  {
+    for (std::vector<MeshGeomFacet>::iterator jt = it->facets.begin(); jt != it->facets.end(); ++jt)
+    {
+      MeshGeomFacet& facet = *jt;
       int j;
       for (j = 0; j < 3; j++)
       {
@@ -417,25 +480,19 @@ void SetOperations::TriangulateMesh (const MeshKernel &cutMesh, int side)
 
         if (eit != _edges.end())
         {
-
           if (eit->second.fcounter[side] < 2)
           {
-            //if (side == 0)
-            //   _builder.addSingleTriangle(facet._aclPoints[0], facet._aclPoints[1], facet._aclPoints[2], true, 3, 0, 1, 1);
-
-            eit->second.facet[side] = fidx;
+            eit->second.facet[side] = it->fidx;
             eit->second.facets[side][eit->second.fcounter[side]] = facet;
             eit->second.fcounter[side]++;
             facet.SetFlag(MeshFacet::MARKED); // set all facets connected to an edge: MARKED
-
           }
         }
       }
 
       _newMeshFacets[side].push_back(facet);
-
-    } // for (i = 0; i < (out->numberoftriangles * 3); i += 3)
-  } // for (it1 = _facet2points[side].begin(); it1 != _facet2points[side].end(); ++it1)
+    }
+  }
 }
 
 void SetOperations::CollectFacets (int side, float mult)
@@ -530,7 +587,7 @@ bool SetOperations::CollectFacetVisitor::AllowVisit (const MeshFacet& rclFacet,
         std::map<Edge, EdgeInfo>::iterator it = _edges.find(edge);
 
         if (it != _edges.end()) {
-            if (_addFacets == -1) {
+            if (_addFacets == -1 && it->second.fcounter[1-_side] > 0) {
                 // determine if the facets should add or not only once
                 MeshGeomFacet facet = _mesh.GetFacet(rclFrom); // triangulated facet
                 MeshGeomFacet facetOther = it->second.facets[1-_side][0]; // triangulated facet from same edge and other mesh
@@ -23,8 +23,11 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 #endif
 
+#include <QtConcurrentMap>
+
 #include "Smoothing.h"
 #include "MeshKernel.h"
 #include "Algorithm.h"
@@ -69,7 +72,7 @@ void PlaneFitSmoothing::Smooth(unsigned int iterations)
     MeshCore::MeshPointArray PointArray = kernel.GetPoints();
 
     MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
+    MeshCore::MeshAdjacency adjacency(kernel);
     MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
 
     for (unsigned int i=0; i<iterations; i++) {
@@ -78,12 +81,11 @@ void PlaneFitSmoothing::Smooth(unsigned int iterations)
             MeshCore::PlaneFit pf;
             pf.AddPoint(*v_it);
             center = *v_it;
-            const std::set<unsigned long>& cv = vv_it[v_it.Position()];
+            MeshAdjacency::IndexRange cv = adjacency.PointPoints(v_it.Position());
             if (cv.size() < 3)
                 continue;
 
-            std::set<unsigned long>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
+            for (const unsigned long* cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
                 pf.AddPoint(v_beg[*cv_it]);
                 center += v_beg[*cv_it];
             }
@@ -122,7 +124,7 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<
     MeshCore::MeshPointArray PointArray = kernel.GetPoints();
 
     MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
+    MeshCore::MeshAdjacency adjacency(kernel);
     MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
 
     for (unsigned int i=0; i<iterations; i++) {
@@ -132,12 +134,11 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<
             MeshCore::PlaneFit pf;
             pf.AddPoint(*v_it);
             center = *v_it;
-            const std::set<unsigned long>& cv = vv_it[v_it.Position()];
+            MeshAdjacency::IndexRange cv = adjacency.PointPoints(v_it.Position());
             if (cv.size() < 3)
                 continue;
 
-            std::set<unsigned long>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
+            for (const unsigned long* cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
                 pf.AddPoint(v_beg[*cv_it]);
                 center += v_beg[*cv_it];
             }
@@ -179,94 +180,104 @@ LaplaceSmoothing::~LaplaceSmoothing()
 {
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize)
+std::vector<unsigned long> LaplaceSmoothing::GetMovablePoints(const MeshAdjacency& adjacency,
+                                                              const std::vector<unsigned long>& indices)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it,
-    v_beg = points.begin(), v_end = points.end();
-
-    unsigned long pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it,++pos) {
-        const std::set<unsigned long>& cv = vv_it[pos];
+    std::vector<unsigned long> movable;
+    movable.reserve(indices.size());
+    for (std::vector<unsigned long>::const_iterator it = indices.begin(); it != indices.end(); ++it) {
+        MeshAdjacency::IndexRange cv = adjacency.PointPoints(*it);
         if (cv.size() < 3)
             continue;
-        if (cv.size() != vf_it[pos].size()) {
+        if (cv.size() != adjacency.PointFacets(*it).size()) {
             // do nothing for border points
             continue;
         }
+        movable.push_back(*it);
+    }
+    return movable;
+}
 
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<unsigned long>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-v_it->x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-v_it->y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-v_it->z);
-        }
+std::vector<unsigned long> LaplaceSmoothing::GetMovablePoints(const MeshAdjacency& adjacency)
+{
+    std::vector<unsigned long> indices(adjacency.CountPoints());
+    for (std::size_t i = 0; i < indices.size(); i++)
+        indices[i] = static_cast<unsigned long>(i);
+    return GetMovablePoints(adjacency, indices);
+}
 
-        float x = static_cast<float>(static_cast<double>(v_it->x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z)+stepsize*delz);
-        kernel.SetPoint(pos,x,y,z);
+namespace {
+template <class Function>
+void forEachBlock(std::size_t count, Function func)
+{
+    // the block size keeps the scheduling overhead low compared to the work per block
+    const std::size_t blockSize = 4096;
+    if (count <= blockSize) {
+        func(std::make_pair(std::size_t(0), count));
+        return;
     }
+
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i = 0; i < count; i += blockSize)
+        blocks.push_back(std::make_pair(i, std::min(i + blockSize, count)));
+    QtConcurrent::blockingMap(blocks, func);
+}
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it, double stepsize,
-                                const std::vector<unsigned long>& point_indices)
+void LaplaceSmoothing::Umbrella(const MeshAdjacency& adjacency, const std::vector<unsigned long>& indices,
+                                double stepsize, std::vector<Base::Vector3f>& buffer)
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
     MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
+    buffer.resize(indices.size());
+
+    forEachBlock(indices.size(), [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            unsigned long pos = indices[i];
+            MeshAdjacency::IndexRange cv = adjacency.PointPoints(pos);
+            const MeshPoint& pnt = v_beg[pos];
+
+            double w = 1.0/double(cv.size());
+            double delx=0.0,dely=0.0,delz=0.0;
+            for (const unsigned long* cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
+                const MeshPoint& adj = v_beg[*cv_it];
+                delx += static_cast<double>(adj.x-pnt.x);
+                dely += static_cast<double>(adj.y-pnt.y);
+                delz += static_cast<double>(adj.z-pnt.z);
+            }
 
-    for (std::vector<unsigned long>::const_iterator pos = point_indices.begin(); pos != point_indices.end(); ++pos) {
-        const std::set<unsigned long>& cv = vv_it[*pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[*pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<unsigned long>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*static_cast<double>((v_beg[*cv_it]).x-(v_beg[*pos]).x);
-            dely += w*static_cast<double>((v_beg[*cv_it]).y-(v_beg[*pos]).y);
-            delz += w*static_cast<double>((v_beg[*cv_it]).z-(v_beg[*pos]).z);
+            buffer[i].x = static_cast<float>(static_cast<double>(pnt.x)+stepsize*w*delx);
+            buffer[i].y = static_cast<float>(static_cast<double>(pnt.y)+stepsize*w*dely);
+            buffer[i].z = static_cast<float>(static_cast<double>(pnt.z)+stepsize*w*delz);
         }
+    });
 
-        float x = static_cast<float>(static_cast<double>((v_beg[*pos]).x)+stepsize*delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[*pos]).y)+stepsize*dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[*pos]).z)+stepsize*delz);
-        kernel.SetPoint(*pos,x,y,z);
-    }
+    MeshKernel& mesh = kernel;
+    forEachBlock(indices.size(), [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++)
+            mesh.SetPoint(indices[i], buffer[i]);
+    });
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshAdjacency adjacency(kernel);
+    std::vector<unsigned long> movable = GetMovablePoints(adjacency);
+    std::vector<Base::Vector3f> buffer;
 
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
+        Umbrella(adjacency, movable, lambda, buffer);
     }
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshAdjacency adjacency(kernel);
+    std::vector<unsigned long> movable = GetMovablePoints(adjacency, point_indices);
+    std::vector<Base::Vector3f> buffer;
 
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
+        Umbrella(adjacency, movable, lambda, buffer);
     }
 }
 
@@ -281,26 +292,28 @@ TaubinSmoothing::~TaubinSmoothing()
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshAdjacency adjacency(kernel);
+    std::vector<unsigned long> movable = GetMovablePoints(adjacency);
+    std::vector<Base::Vector3f> buffer;
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-        Umbrella(vv_it, vf_it, -(lambda+micro));
+        Umbrella(adjacency, movable, lambda, buffer);
+        Umbrella(adjacency, movable, -(lambda+micro), buffer);
     }
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshAdjacency adjacency(kernel);
+    std::vector<unsigned long> movable = GetMovablePoints(adjacency, point_indices);
+    std::vector<Base::Vector3f> buffer;
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-        Umbrella(vv_it, vf_it, -(lambda+micro), point_indices);
+        Umbrella(adjacency, movable, lambda, buffer);
+        Umbrella(adjacency, movable, -(lambda+micro), buffer);
     }
 }
@@ -25,12 +25,12 @@
 #define MESH_SMOOTHING_H
 
 #include <vector>
+#include <Base/Vector3D.h>
 
 namespace MeshCore
 {
 class MeshKernel;
-class MeshRefPointToPoints;
-class MeshRefPointToFacets;
+class MeshAdjacency;
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -83,11 +83,19 @@ public:
     void SetLambda(double l) { lambda = l;}
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&, double,
-                  const std::vector<unsigned long>&);
+    /** Returns the points of \a indices that can be smoothed, i.e. points that are not
+     * on a border and that have at least three neighbours.
+     */
+    static std::vector<unsigned long> GetMovablePoints(const MeshAdjacency&,
+                                                       const std::vector<unsigned long>& indices);
+    /** Returns all points of the mesh that can be smoothed. */
+    static std::vector<unsigned long> GetMovablePoints(const MeshAdjacency&);
+    /** Performs one Jacobi step of the umbrella operator on the points \a indices. All new
+     * positions are computed from the old ones into \a buffer before they are
+     * written back to the mesh. This way the points can be handled in parallel.
+     */
+    void Umbrella(const MeshAdjacency&, const std::vector<unsigned long>& indices,
+                  double stepsize, std::vector<Base::Vector3f>& buffer);
 
 protected:
     double lambda;
@@ -25,10 +25,14 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <memory>
+# include <numeric>
 # include <utility>
 # include <queue>
 #endif
 
+#include <QtConcurrentMap>
+
 #include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
 
@@ -1415,42 +1419,65 @@ void MeshTopoAlgorithm::FillupHoles(int level, AbstractPolygonTriangulator& cTri
     MeshRefPointToFacets cPt2Fac(_rclMesh);
     MeshAlgorithm cAlgo(_rclMesh);
 
+    // The holes are independent of each other and the mesh isn't modified until
+    // all of them are triangulated. So, if the triangulator can be copied each
+    // hole is filled in its own thread and the results are merged in order.
+    std::vector<std::vector<unsigned long> > borders(aBorders.begin(), aBorders.end());
+    std::vector<MeshFacetArray> holeFacets(borders.size());
+    std::vector<MeshPointArray> holePoints(borders.size());
+    std::vector<char> filled(borders.size(), 0);
+    std::unique_ptr<AbstractPolygonTriangulator> copy(borders.size() > 1 ? cTria.Clone() : 0);
+    if (copy) {
+        std::vector<std::size_t> holes(borders.size());
+        std::iota(holes.begin(), holes.end(), 0);
+        QtConcurrent::blockingMap(holes, [&](std::size_t index) {
+            std::unique_ptr<AbstractPolygonTriangulator> tria(cTria.Clone());
+            filled[index] = cAlgo.FillupHole(borders[index], *tria, holeFacets[index],
+                                             holePoints[index], level, &cPt2Fac);
+        });
+    }
+    else {
+        for (std::size_t index = 0; index < borders.size(); index++) {
+            filled[index] = cAlgo.FillupHole(borders[index], cTria, holeFacets[index],
+                                             holePoints[index], level, &cPt2Fac);
+        }
+    }
+
     MeshFacetArray newFacets;
     MeshPointArray newPoints;
     unsigned long numberOfOldPoints = _rclMesh._aclPointArray.size();
-    for (std::list<std::vector<unsigned long> >::const_iterator it = aBorders.begin(); it != aBorders.end(); ++it) {
-        MeshFacetArray cFacets;
-        MeshPointArray cPoints;
-        std::vector<unsigned long> bound = *it;
-        if (cAlgo.FillupHole(bound, cTria, cFacets, cPoints, level, &cPt2Fac)) {
+    for (std::size_t index = 0; index < borders.size(); index++) {
+        const MeshFacetArray& cFacets = holeFacets[index];
+        const MeshPointArray& cPoints = holePoints[index];
+        std::vector<unsigned long> bound = borders[index];
+        if (filled[index]) {
             if (bound.front() == bound.back())
                 bound.pop_back();
             // the triangulation may produce additional points which we must take into account when appending to the mesh
             if (cPoints.size() > bound.size()) {
                 unsigned long countBoundaryPoints = bound.size();
                 unsigned long countDifference = cPoints.size() - countBoundaryPoints;
-                MeshPointArray::_TIterator pt = cPoints.begin() + countBoundaryPoints;
+                MeshPointArray::_TConstIterator pt = cPoints.begin() + countBoundaryPoints;
                 for (unsigned long i=0; i<countDifference; i++, pt++) {
                     bound.push_back(numberOfOldPoints++);
                     newPoints.push_back(*pt);
                 }
             }
             if (cTria.NeedsReindexing()) {
-                for (MeshFacetArray::_TIterator kt = cFacets.begin(); kt != cFacets.end(); ++kt ) {
-                    kt->_aulPoints[0] = bound[kt->_aulPoints[0]];
-                    kt->_aulPoints[1] = bound[kt->_aulPoints[1]];
-                    kt->_aulPoints[2] = bound[kt->_aulPoints[2]];
-                    newFacets.push_back(*kt);
+                for (MeshFacetArray::_TConstIterator kt = cFacets.begin(); kt != cFacets.end(); ++kt ) {
+                    MeshFacet face = *kt;
+                    face._aulPoints[0] = bound[face._aulPoints[0]];
+                    face._aulPoints[1] = bound[face._aulPoints[1]];
+                    face._aulPoints[2] = bound[face._aulPoints[2]];
+                    newFacets.push_back(face);
                 }
             }
             else {
-                for (MeshFacetArray::_TIterator kt = cFacets.begin(); kt != cFacets.end(); ++kt ) {
-                    newFacets.push_back(*kt);
-                }
+                newFacets.insert(newFacets.end(), cFacets.begin(), cFacets.end());
             }
         }
         else {
-            aFailed.push_back(*it);
+            aFailed.push_back(borders[index]);
         }
     }
 
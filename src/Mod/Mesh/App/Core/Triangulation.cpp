@@ -23,7 +23,10 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <cmath>
+# include <map>
 # include <queue>
+# include <set>
 #endif
 
 #include <Base/Console.h>
@@ -34,6 +37,7 @@
 #include "MeshKernel.h"
 
 #include <Mod/Mesh/App/WildMagic4/Wm4Delaunay2.h>
+#include <Mod/Mesh/App/WildMagic4/Wm4Math.h>
 
 
 using namespace MeshCore;
@@ -83,6 +87,19 @@ AbstractPolygonTriangulator::AbstractPolygonTriangulator()
     _verifier = new TriangulationVerifier();
 }
 
+AbstractPolygonTriangulator::AbstractPolygonTriangulator(const AbstractPolygonTriangulator& tria)
+  : _discard(tria._discard)
+  , _inverse(tria._inverse)
+  , _indices(tria._indices)
+  , _points(tria._points)
+  , _newpoints(tria._newpoints)
+  , _triangles(tria._triangles)
+  , _facets(tria._facets)
+  , _info(tria._info)
+  , _verifier(tria._verifier ? tria._verifier->Clone() : 0)
+{
+}
+
 AbstractPolygonTriangulator::~AbstractPolygonTriangulator()
 {
     delete _verifier;
@@ -286,6 +303,11 @@ EarClippingTriangulator::~EarClippingTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* EarClippingTriangulator::Clone() const
+{
+    return new EarClippingTriangulator(*this);
+}
+
 bool EarClippingTriangulator::Triangulate()
 {
     _facets.clear();
@@ -296,6 +318,8 @@ bool EarClippingTriangulator::Triangulate()
 
     //  Invoke the triangulator to triangulate this polygon.
     Triangulate::Process(pts,result);
+    // Process() takes the points in counter-clockwise order
+    bool invert = 0.0f < Triangulate::Area(pts);
 
     // print out the results.
     size_t tcount = result.size()/3;
@@ -307,7 +331,7 @@ bool EarClippingTriangulator::Triangulate()
     MeshGeomFacet clFacet;
     MeshFacet clTopFacet;
     for (unsigned long i=0; i<tcount; i++) {
-        if (Triangulate::_invert) {
+        if (invert) {
             clFacet._aclPoints[0] = _points[result[i*3+0]];
             clFacet._aclPoints[2] = _points[result[i*3+1]];
             clFacet._aclPoints[1] = _points[result[i*3+2]];
@@ -395,8 +419,6 @@ bool EarClippingTriangulator::Triangulate::Snip(const std::vector<Base::Vector3f
     return true;
 }
 
-bool EarClippingTriangulator::Triangulate::_invert = false;
-
 bool EarClippingTriangulator::Triangulate::Process(const std::vector<Base::Vector3f> &contour,
                                                    std::vector<unsigned long> &result)
 {
@@ -411,12 +433,10 @@ bool EarClippingTriangulator::Triangulate::Process(const std::vector<Base::Vecto
 
     if (0.0f < Area(contour)) {
         for (int v=0; v<n; v++) V[v] = v;
-        _invert = true;
     }
 //    for(int v=0; v<n; v++) V[v] = (n-1)-v;
     else {
         for(int v=0; v<n; v++) V[v] = (n-1)-v;
-        _invert = false;
     }
 
     int nv = n;
@@ -476,6 +496,11 @@ QuasiDelaunayTriangulator::~QuasiDelaunayTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* QuasiDelaunayTriangulator::Clone() const
+{
+    return new QuasiDelaunayTriangulator(*this);
+}
+
 bool QuasiDelaunayTriangulator::Triangulate()
 {
     if (EarClippingTriangulator::Triangulate() == false)
@@ -630,6 +655,11 @@ DelaunayTriangulator::~DelaunayTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* DelaunayTriangulator::Clone() const
+{
+    return new DelaunayTriangulator(*this);
+}
+
 bool DelaunayTriangulator::Triangulate()
 {
     // before starting the triangulation we must make sure that all polygon 
@@ -702,6 +732,11 @@ FlatTriangulator::~FlatTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* FlatTriangulator::Clone() const
+{
+    return new FlatTriangulator(*this);
+}
+
 bool FlatTriangulator::Triangulate()
 {
     _newpoints.clear();
@@ -746,6 +781,11 @@ ConstraintDelaunayTriangulator::~ConstraintDelaunayTriangulator()
 {
 }
 
+AbstractPolygonTriangulator* ConstraintDelaunayTriangulator::Clone() const
+{
+    return new ConstraintDelaunayTriangulator(*this);
+}
+
 bool ConstraintDelaunayTriangulator::Triangulate()
 {
     _newpoints.clear();
@@ -775,6 +815,251 @@ bool ConstraintDelaunayTriangulator::Triangulate()
 
 // -------------------------------------------------------------
 
+MinimumAreaTriangulator::MinimumAreaTriangulator(bool fairing)
+  : fairing(fairing)
+{
+}
+
+MinimumAreaTriangulator::~MinimumAreaTriangulator()
+{
+}
+
+AbstractPolygonTriangulator* MinimumAreaTriangulator::Clone() const
+{
+    return new MinimumAreaTriangulator(*this);
+}
+
+bool MinimumAreaTriangulator::Triangulate()
+{
+    _newpoints.clear();
+    _facets.clear();
+    _triangles.clear();
+    _inverse.setToUnity();
+
+    std::size_t n = _points.size();
+    if (n < 3)
+        return false;
+
+    if (n > MaxPoints) {
+        QuasiDelaunayTriangulator tria;
+        tria.SetPolygon(this->GetPolygon());
+        bool succeeded = tria.TriangulatePolygon();
+        this->_facets = tria.GetFacets();
+        this->_triangles = tria.GetTriangles();
+        return succeeded;
+    }
+
+    // weight[i*n+j] is the minimum area of the sub-polygon i,...,j closed by
+    // the edge (j,i) and split[i*n+j] the point that forms a triangle with it
+    std::vector<float> weight(n * n, 0.0f);
+    std::vector<unsigned long> split(n * n, 0);
+    for (std::size_t len = 2; len < n; len++) {
+        for (std::size_t i = 0; i + len < n; i++) {
+            std::size_t j = i + len;
+            float best = FLOAT_MAX;
+            std::size_t bestk = i + 1;
+            for (std::size_t k = i + 1; k < j; k++) {
+                float area = ((_points[k] - _points[i]) % (_points[j] - _points[i])).Length();
+                float w = weight[i * n + k] + weight[k * n + j] + area;
+                if (w < best) {
+                    best = w;
+                    bestk = k;
+                }
+            }
+            weight[i * n + j] = best;
+            split[i * n + j] = bestk;
+        }
+    }
+
+    // collect the triangles, they all keep the orientation of the polygon
+    std::vector<std::pair<unsigned long, unsigned long> > ranges;
+    ranges.push_back(std::make_pair(0, n - 1));
+    while (!ranges.empty()) {
+        std::pair<unsigned long, unsigned long> range = ranges.back();
+        ranges.pop_back();
+        if (range.second - range.first < 2)
+            continue;
+        unsigned long k = split[range.first * n + range.second];
+        _facets.push_back(MeshFacet(range.first, k, range.second));
+        ranges.push_back(std::make_pair(range.first, k));
+        ranges.push_back(std::make_pair(k, range.second));
+    }
+
+    std::vector<Base::Vector3f> points = _points;
+    if (fairing) {
+        Refine(points);
+        Smooth(points);
+    }
+
+    for (std::vector<MeshFacet>::iterator it = _facets.begin(); it != _facets.end(); ++it) {
+        _triangles.push_back(MeshGeomFacet(points[it->_aulPoints[0]],
+                                           points[it->_aulPoints[1]],
+                                           points[it->_aulPoints[2]]));
+    }
+
+    // the added points are kept in the coordinate system of the fit plane
+    // so that PostProcessing() can project them onto the fitted surface
+    if (points.size() > n) {
+        _inverse = GetTransformToFitPlane();
+        Base::Vector3f bs(static_cast<float>(_inverse[0][3]),
+                          static_cast<float>(_inverse[1][3]),
+                          static_cast<float>(_inverse[2][3]));
+        Base::Vector3f ex(static_cast<float>(_inverse[0][0]),
+                          static_cast<float>(_inverse[1][0]),
+                          static_cast<float>(_inverse[2][0]));
+        Base::Vector3f ey(static_cast<float>(_inverse[0][1]),
+                          static_cast<float>(_inverse[1][1]),
+                          static_cast<float>(_inverse[2][1]));
+        for (std::size_t i = n; i < points.size(); i++) {
+            Base::Vector3f pt = points[i];
+            pt.TransformToCoordinateSystem(bs, ex, ey);
+            _newpoints.push_back(pt);
+        }
+    }
+
+    return true;
+}
+
+void MinimumAreaTriangulator::Refine(std::vector<Base::Vector3f>& points)
+{
+    // A triangle is split at its centroid as long as it's large compared to the
+    // scale of its corners, where the scale of a boundary point is the mean
+    // length of its boundary edges (P. Liepa, Filling Holes in Meshes, 2003).
+    const float alpha = std::sqrt(2.0f);
+    std::size_t n = _points.size();
+    std::vector<float> scale(n);
+    for (std::size_t i = 0; i < n; i++) {
+        std::size_t prev = (i + n - 1) % n;
+        std::size_t next = (i + 1) % n;
+        scale[i] = 0.5f * (Base::Distance(points[i], points[prev]) +
+                           Base::Distance(points[i], points[next]));
+    }
+
+    // Each interior edge is shared by two facets in opposite directions
+    typedef std::pair<unsigned long, unsigned long> Edge;
+    std::map<Edge, unsigned long> edges;
+    auto addFacet = [&](unsigned long index) {
+        const MeshFacet& f = _facets[index];
+        for (int i = 0; i < 3; i++)
+            edges[Edge(f._aulPoints[i], f._aulPoints[(i+1)%3])] = index;
+    };
+    auto opposite = [&](const MeshFacet& f, unsigned long a, unsigned long b) {
+        for (int i = 0; i < 3; i++) {
+            if (f._aulPoints[i] != a && f._aulPoints[i] != b)
+                return f._aulPoints[i];
+        }
+        return a;
+    };
+    // swaps the interior edge (a,b) if the opposite angles sum up to more than 180 degrees
+    auto relax = [&](unsigned long a, unsigned long b) {
+        std::map<Edge, unsigned long>::iterator it = edges.find(Edge(a, b));
+        std::map<Edge, unsigned long>::iterator jt = edges.find(Edge(b, a));
+        if (it == edges.end() || jt == edges.end())
+            return false;
+        unsigned long f = it->second;
+        unsigned long g = jt->second;
+        unsigned long c = opposite(_facets[f], a, b);
+        unsigned long d = opposite(_facets[g], a, b);
+        if (c == d || edges.find(Edge(c, d)) != edges.end() || edges.find(Edge(d, c)) != edges.end())
+            return false;
+        float angle = (points[a] - points[c]).GetAngle(points[b] - points[c]) +
+                      (points[a] - points[d]).GetAngle(points[b] - points[d]);
+        if (angle <= Wm4::Math<float>::PI)
+            return false;
+        edges.erase(it);
+        edges.erase(jt);
+        _facets[f] = MeshFacet(a, d, c);
+        _facets[g] = MeshFacet(d, b, c);
+        addFacet(f);
+        addFacet(g);
+        return true;
+    };
+
+    for (std::size_t i = 0; i < _facets.size(); i++)
+        addFacet(i);
+
+    const int maxIterations = 20;
+    for (int iter = 0; iter < maxIterations; iter++) {
+        bool refined = false;
+        std::size_t count = _facets.size();
+        for (std::size_t index = 0; index < count; index++) {
+            MeshFacet f = _facets[index];
+            unsigned long a = f._aulPoints[0];
+            unsigned long b = f._aulPoints[1];
+            unsigned long c = f._aulPoints[2];
+            Base::Vector3f center = (points[a] + points[b] + points[c]) / 3.0f;
+            float s = (scale[a] + scale[b] + scale[c]) / 3.0f;
+            bool large = true;
+            for (int i = 0; i < 3 && large; i++) {
+                float dist = alpha * Base::Distance(center, points[f._aulPoints[i]]);
+                large = dist > s && dist > scale[f._aulPoints[i]];
+            }
+            if (!large)
+                continue;
+
+            unsigned long p = points.size();
+            points.push_back(center);
+            scale.push_back(s);
+            _facets[index] = MeshFacet(a, b, p);
+            _facets.push_back(MeshFacet(b, c, p));
+            _facets.push_back(MeshFacet(c, a, p));
+            addFacet(index);
+            addFacet(_facets.size() - 2);
+            addFacet(_facets.size() - 1);
+            relax(a, b);
+            relax(b, c);
+            relax(c, a);
+            refined = true;
+        }
+
+        if (!refined)
+            break;
+
+        for (int pass = 0; pass < maxIterations; pass++) {
+            bool swapped = false;
+            for (std::size_t index = 0; index < _facets.size(); index++) {
+                MeshFacet f = _facets[index];
+                for (int i = 0; i < 3; i++)
+                    swapped |= relax(f._aulPoints[i], f._aulPoints[(i+1)%3]);
+            }
+            if (!swapped)
+                break;
+        }
+    }
+}
+
+void MinimumAreaTriangulator::Smooth(std::vector<Base::Vector3f>& points) const
+{
+    // move the added points to the centre of their neighbours while the
+    // boundary points are kept fixed
+    std::size_t n = _points.size();
+    if (points.size() <= n)
+        return;
+
+    std::vector<std::set<unsigned long> > neighbours(points.size());
+    for (std::vector<MeshFacet>::const_iterator it = _facets.begin(); it != _facets.end(); ++it) {
+        for (int i = 0; i < 3; i++) {
+            neighbours[it->_aulPoints[i]].insert(it->_aulPoints[(i+1)%3]);
+            neighbours[it->_aulPoints[(i+1)%3]].insert(it->_aulPoints[i]);
+        }
+    }
+
+    const int iterations = 20;
+    for (int iter = 0; iter < iterations; iter++) {
+        for (std::size_t i = n; i < points.size(); i++) {
+            const std::set<unsigned long>& nb = neighbours[i];
+            if (nb.empty())
+                continue;
+            Base::Vector3f center;
+            for (std::set<unsigned long>::const_iterator jt = nb.begin(); jt != nb.end(); ++jt)
+                center += points[*jt];
+            points[i] = center / static_cast<float>(nb.size());
+        }
+    }
+}
+
+// -------------------------------------------------------------
+
 #if 0
 Triangulator::Triangulator(const MeshKernel& k, bool flat) : _kernel(k)
 {
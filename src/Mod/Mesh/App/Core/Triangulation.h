@@ -42,6 +42,8 @@ public:
                         const Base::Vector3f& p3) const;
     virtual bool MustFlip(const Base::Vector3f& n1,
                           const Base::Vector3f& n2) const;
+    virtual TriangulationVerifier* Clone() const
+    { return new TriangulationVerifier(*this); }
 };
 
 class MeshExport TriangulationVerifierV2 : public TriangulationVerifier
@@ -53,14 +55,24 @@ public:
                         const Base::Vector3f& p3) const;
     virtual bool MustFlip(const Base::Vector3f& n1,
                           const Base::Vector3f& n2) const;
+    virtual TriangulationVerifier* Clone() const
+    { return new TriangulationVerifierV2(*this); }
 };
 
 class MeshExport AbstractPolygonTriangulator
 {
 public:
     AbstractPolygonTriangulator();
+    AbstractPolygonTriangulator(const AbstractPolygonTriangulator&);
     virtual ~AbstractPolygonTriangulator();
 
+    /** Returns a new triangulator with the same settings and a copy of the
+     * verifier. This is used to triangulate several polygons at the same time
+     * in different threads. The default implementation returns null which means
+     * that the triangulator cannot be copied.
+     */
+    virtual AbstractPolygonTriangulator* Clone() const { return 0; }
+
     /** Sets the polygon to be triangulated. */
     void SetPolygon(const std::vector<Base::Vector3f>& raclPoints);
     void SetIndices(const std::vector<unsigned long>& d) {_indices = d;}
@@ -139,6 +151,9 @@ protected:
     std::vector<MeshFacet>      _facets;
     std::vector<unsigned long>  _info;
     TriangulationVerifier*      _verifier;
+
+private:
+    AbstractPolygonTriangulator& operator=(const AbstractPolygonTriangulator&);
 };
 
 /**
@@ -150,6 +165,7 @@ class MeshExport EarClippingTriangulator : public AbstractPolygonTriangulator
 public:
     EarClippingTriangulator();
     ~EarClippingTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
 
 protected:
     bool Triangulate();
@@ -180,7 +196,6 @@ private:
         static bool InsideTriangle(float Ax, float Ay, float Bx, float By,
             float Cx, float Cy, float Px, float Py);
 
-        static bool _invert;
     private:
         static bool Snip(const std::vector<Base::Vector3f> &contour,
             int u,int v,int w,int n,int *V);
@@ -192,6 +207,7 @@ class MeshExport QuasiDelaunayTriangulator : public EarClippingTriangulator
 public:
     QuasiDelaunayTriangulator();
     ~QuasiDelaunayTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
 
 protected:
     bool Triangulate();
@@ -202,6 +218,7 @@ class MeshExport DelaunayTriangulator : public AbstractPolygonTriangulator
 public:
     DelaunayTriangulator();
     ~DelaunayTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
 
 protected:
     bool Triangulate();
@@ -212,6 +229,7 @@ class MeshExport FlatTriangulator : public AbstractPolygonTriangulator
 public:
     FlatTriangulator();
     ~FlatTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
 
     void PostProcessing(const std::vector<Base::Vector3f>&);
 
@@ -224,6 +242,7 @@ class MeshExport ConstraintDelaunayTriangulator : public AbstractPolygonTriangul
 public:
     ConstraintDelaunayTriangulator(float area);
     ~ConstraintDelaunayTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
 
 protected:
     bool Triangulate();
@@ -232,6 +251,40 @@ private:
     float fMaxArea;
 };
 
+/**
+ * The MinimumAreaTriangulator computes the triangulation of the polygon with
+ * the smallest area by dynamic programming over the polygon points.
+ * It works directly on the 3D points and thus doesn't need the polygon to be
+ * projectable onto a plane. The costs grow cubically with the number of points,
+ * so for polygons with more than MaxPoints points the QuasiDelaunayTriangulator
+ * is used instead.
+ *
+ * With fairing enabled the triangulation is refined until the size of the
+ * triangles matches the length of the adjacent boundary edges, and the
+ * added points are smoothed afterwards. If the neighbourhood points are passed
+ * to PostProcessing() the added points are finally projected onto the surface
+ * fitting them, as done by the other triangulators.
+ */
+class MeshExport MinimumAreaTriangulator : public AbstractPolygonTriangulator
+{
+public:
+    MinimumAreaTriangulator(bool fairing = false);
+    ~MinimumAreaTriangulator();
+    AbstractPolygonTriangulator* Clone() const;
+
+    enum { MaxPoints = 1000 };
+
+protected:
+    bool Triangulate();
+
+private:
+    void Refine(std::vector<Base::Vector3f>&);
+    void Smooth(std::vector<Base::Vector3f>&) const;
+
+private:
+    bool fairing;
+};
+
 #if 0
 class MeshExport Triangulator : public AbstractPolygonTriangulator
 {
@@ -23,6 +23,10 @@
 #include "PreCompiled.h"
 #include <algorithm>
 
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include "Trim.h"
 #include "Grid.h"
 #include "Iterator.h"
@@ -55,22 +59,23 @@ void MeshTrimming::SetInnerOrOuter(TMode tMode)
 
 void MeshTrimming::CheckFacets(const MeshFacetGrid& rclGrid, std::vector<unsigned long> &raulFacets) const
 {
-    std::vector<unsigned long>::iterator it;
-    MeshFacetIterator clIter(myMesh, 0);
+    // Cache current view projection matrix since calls to Coin's projection are expensive
+    // and can't be done from several threads
+    Base::ViewProjMatrix fixedProj(myProj->getComposedProjectionMatrix());
+    // BBox of polygon
+    Base::BoundBox2d clPolyBBox = myPoly.CalcBoundBox();
+    std::vector<unsigned long> aulAllElements;
 
     // cut inner: use grid to accelerate search
     if (myInner) {
         Base::BoundBox3f clBBox3d;
-        Base::BoundBox2d clViewBBox, clPolyBBox;
-        std::vector<unsigned long> aulAllElements;
+        Base::BoundBox2d clViewBBox;
 
-        // BBox of polygon
-        clPolyBBox = myPoly.CalcBoundBox();
         MeshGridIterator clGridIter(rclGrid);
         // traverse all BBoxes
         for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
             clBBox3d = clGridIter.GetBoundBox();
-            clViewBBox = clBBox3d.ProjectBox(myProj);
+            clViewBBox = clBBox3d.ProjectBox(&fixedProj);
             if (clViewBBox.Intersect(clPolyBBox)) {
                 // save all elements in AllElements 
                 clGridIter.GetElements(aulAllElements);
@@ -80,41 +85,66 @@ void MeshTrimming::CheckFacets(const MeshFacetGrid& rclGrid, std::vector<unsigne
         // remove double elements 
         std::sort(aulAllElements.begin(), aulAllElements.end());
         aulAllElements.erase(std::unique(aulAllElements.begin(), aulAllElements.end()), aulAllElements.end());
-
-        Base::SequencerLauncher seq("Check facets for intersection...", aulAllElements.size());
-
-        for (it = aulAllElements.begin(); it != aulAllElements.end(); ++it) {
-            MeshGeomFacet clFacet = myMesh.GetFacet(*it);
-            if (HasIntersection(clFacet))
-                raulFacets.push_back(*it);
-            seq.next();
-        }
     }
     // cut outer
     else {
-        Base::SequencerLauncher seq("Check facets for intersection...", myMesh.CountFacets());
-        for (clIter.Init(); clIter.More(); clIter.Next()) {
-            if (HasIntersection(*clIter))
-                raulFacets.push_back(clIter.Position());
-            seq.next();
+        aulAllElements.resize(myMesh.CountFacets());
+        for (std::size_t i = 0; i < aulAllElements.size(); i++)
+            aulAllElements[i] = static_cast<unsigned long>(i);
+    }
+
+    // The facets are checked independently of each other
+    const std::size_t blockSize = 4096;
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i = 0; i < aulAllElements.size(); i += blockSize)
+        blocks.push_back(std::make_pair(i, std::min(i + blockSize, aulAllElements.size())));
+
+    std::vector<char> hits(aulAllElements.size(), 0);
+    Base::ParallelSequencerLauncher seq("Check facets for intersection...", aulAllElements.size());
+    QFuture<void> future = QtConcurrent::map(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            MeshGeomFacet clFacet = myMesh.GetFacet(aulAllElements[i]);
+            if (HasIntersection(clFacet, fixedProj, clPolyBBox))
+                hits[i] = 1;
         }
+        seq.next(block.second - block.first);
+    });
+
+    while (!future.isFinished()) {
+        seq.update(false);
+        QThread::msleep(20);
+    }
+    seq.update(false);
+
+    for (std::size_t i = 0; i < aulAllElements.size(); i++) {
+        if (hits[i])
+            raulFacets.push_back(aulAllElements[i]);
     }
 }
 
-bool MeshTrimming::HasIntersection(const MeshGeomFacet& rclFacet) const
+bool MeshTrimming::HasIntersection(const MeshGeomFacet& rclFacet, const Base::ViewProjMethod& rclProj,
+                                   const Base::BoundBox2d& rclPolyBBox) const
 {
     size_t i;
     unsigned long j;
     Base::Polygon2d clPoly;
+    Base::BoundBox2d clFacBBox;
     Base::Line2d clFacLine, clPolyLine;
     Base::Vector2d S;
+    for (i=0; i<3; i++) {
+        Base::Vector3f clPt2d = rclProj(rclFacet._aclPoints[i]);
+        clPoly.Add(Base::Vector2d(clPt2d.x, clPt2d.y));
+        clFacBBox.Add(clPoly[i]);
+    }
+
+    // if the boxes don't overlap the facet is completely outside the polygon
+    if (!clFacBBox.Intersect(rclPolyBBox))
+        return !myInner;
+
     // is corner of facet inside the polygon
     for (i=0; i<3; i++) {
-        Base::Vector3f clPt2d = myProj->operator ()(rclFacet._aclPoints[i]);
-        if (myPoly.Contains(Base::Vector2d(clPt2d.x, clPt2d.y)) == myInner)
+        if (myPoly.Contains(clPoly[i]) == myInner)
             return true;
-        else
-            clPoly.Add(Base::Vector2d(clPt2d.x, clPt2d.y));
     }
 
     // is corner of polygon inside the facet
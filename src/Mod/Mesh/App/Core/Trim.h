@@ -60,9 +60,10 @@ public:
  
 private:
     /**
-     * Checks if the polygon cuts the facet
+     * Checks if the polygon cuts the facet. \a rclPolyBBox is the bounding box of the polygon.
      */
-    bool HasIntersection(const MeshGeomFacet& rclFacet) const;
+    bool HasIntersection(const MeshGeomFacet& rclFacet, const Base::ViewProjMethod& rclProj,
+                         const Base::BoundBox2d& rclPolyBBox) const;
 
     /**
      * Checks if a facet lies totally within a polygon
@@ -23,6 +23,8 @@
 #include "PreCompiled.h"
 #include <algorithm>
 
+#include <QtConcurrentMap>
+
 #include "TrimByPlane.h"
 #include "Grid.h"
 #include "Iterator.h"
@@ -62,15 +64,31 @@ void MeshTrimByPlane::CheckFacets(const MeshFacetGrid& rclGrid, const Base::Vect
     std::sort(checkElements.begin(), checkElements.end());
     checkElements.erase(std::unique(checkElements.begin(), checkElements.end()), checkElements.end());
 
+    // classify the facets of the cut cells independently of each other
+    enum Classification { Keep, Trim, Remove };
+    std::vector<char> classification(checkElements.size(), Keep);
+    const std::size_t blockSize = 4096;
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i = 0; i < checkElements.size(); i += blockSize)
+        blocks.push_back(std::make_pair(i, std::min(i + blockSize, checkElements.size())));
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            MeshGeomFacet clFacet = myMesh.GetFacet(checkElements[i]);
+            if (clFacet.IntersectWithPlane(base, normal))
+                classification[i] = Trim;
+            else if (clFacet._aclPoints[0].DistanceToPlane(base, normal) > 0.0f)
+                classification[i] = Remove;
+        }
+    });
+
     trimFacets.reserve(checkElements.size()/2); // reserve some memory
-    for (auto it = checkElements.begin(); it != checkElements.end(); ++it) {
-        MeshGeomFacet clFacet = myMesh.GetFacet(*it);
-        if (clFacet.IntersectWithPlane(base, normal)) {
-            trimFacets.push_back(*it);
-            removeFacets.push_back(*it);
+    for (std::size_t i = 0; i < checkElements.size(); i++) {
+        if (classification[i] == Trim) {
+            trimFacets.push_back(checkElements[i]);
+            removeFacets.push_back(checkElements[i]);
         }
-        else if (clFacet._aclPoints[0].DistanceToPlane(base, normal) > 0.0f) {
-            removeFacets.push_back(*it);
+        else if (classification[i] == Remove) {
+            removeFacets.push_back(checkElements[i]);
         }
     }
 
@@ -27,6 +27,9 @@
 # include <sstream>
 #endif
 
+#include <QThread>
+#include <QtConcurrentMap>
+
 #include <CXX/Objects.hxx>
 #include <Base/Builder3D.h>
 #include <Base/Console.h>
@@ -331,6 +334,110 @@ void MeshObject::getFaces(std::vector<Base::Vector3d> &Points,std::vector<Facet>
     }
 }
 
+namespace {
+
+// split large arrays into one range per thread
+std::vector<std::pair<std::size_t, std::size_t> > bufferRanges(std::size_t count)
+{
+    const std::size_t minCount = 100000;
+    std::size_t numRanges = 1;
+    if (count >= minCount)
+        numRanges = static_cast<std::size_t>(std::max<int>(QThread::idealThreadCount(), 1));
+
+    std::vector<std::pair<std::size_t, std::size_t> > ranges;
+    for (std::size_t i = 0; i < numRanges; i++) {
+        std::size_t first = (count * i) / numRanges;
+        std::size_t last = (count * (i + 1)) / numRanges;
+        if (first < last)
+            ranges.emplace_back(first, last);
+    }
+    return ranges;
+}
+
+template <typename Func>
+void forRanges(std::size_t count, Func func)
+{
+    std::vector<std::pair<std::size_t, std::size_t> > ranges = bufferRanges(count);
+    if (ranges.size() > 1)
+        QtConcurrent::blockingMap(ranges, func);
+    else if (!ranges.empty())
+        func(ranges.front());
+}
+
+template <typename T>
+void fillBuffer(const MeshCore::MeshKernel& kernel, const Base::Matrix4D& mtrx,
+                Data::ComplexGeoData::GeometryBuffer<T> &buffer, bool withNormals, bool withFacets)
+{
+    const MeshCore::MeshPointArray& points = kernel.GetPoints();
+    buffer.points.resize(points.size() * 3);
+    forRanges(points.size(), [&](const std::pair<std::size_t, std::size_t>& range) {
+        for (std::size_t i = range.first; i < range.second; i++) {
+            Base::Vector3d pnt = mtrx * Base::Vector3d(points[i].x, points[i].y, points[i].z);
+            buffer.points[3*i  ] = static_cast<T>(pnt.x);
+            buffer.points[3*i+1] = static_cast<T>(pnt.y);
+            buffer.points[3*i+2] = static_cast<T>(pnt.z);
+        }
+    });
+
+    buffer.normals.clear();
+    if (withNormals) {
+        // nullify translation part
+        Base::Matrix4D rot = mtrx;
+        rot[0][3] = 0.0;
+        rot[1][3] = 0.0;
+        rot[2][3] = 0.0;
+        MeshCore::MeshRefNormalToPoints ptNormals(kernel);
+        buffer.normals.resize(points.size() * 3);
+        forRanges(points.size(), [&](const std::pair<std::size_t, std::size_t>& range) {
+            for (std::size_t i = range.first; i < range.second; i++) {
+                const Base::Vector3f& nor = ptNormals[i];
+                Base::Vector3d n = rot * Base::Vector3d(nor.x, nor.y, nor.z);
+                buffer.normals[3*i  ] = static_cast<T>(n.x);
+                buffer.normals[3*i+1] = static_cast<T>(n.y);
+                buffer.normals[3*i+2] = static_cast<T>(n.z);
+            }
+        });
+    }
+
+    buffer.facets.clear();
+    if (withFacets) {
+        const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
+        buffer.facets.resize(facets.size() * 3);
+        uint32_t* ptr = buffer.facets.data();
+        for (MeshCore::MeshFacetArray::_TConstIterator it = facets.begin(); it != facets.end(); ++it) {
+            *ptr++ = static_cast<uint32_t>(it->_aulPoints[0]);
+            *ptr++ = static_cast<uint32_t>(it->_aulPoints[1]);
+            *ptr++ = static_cast<uint32_t>(it->_aulPoints[2]);
+        }
+    }
+}
+
+}
+
+void MeshObject::getPointBuffer(GeometryBuffer<float> &buffer,
+                                float /*Accuracy*/, bool withNormals, uint16_t /*flags*/) const
+{
+    fillBuffer(_kernel, _Mtrx, buffer, withNormals, false);
+}
+
+void MeshObject::getPointBuffer(GeometryBuffer<double> &buffer,
+                                float /*Accuracy*/, bool withNormals, uint16_t /*flags*/) const
+{
+    fillBuffer(_kernel, _Mtrx, buffer, withNormals, false);
+}
+
+void MeshObject::getFaceBuffer(GeometryBuffer<float> &buffer,
+                               float /*Accuracy*/, bool withNormals, uint16_t /*flags*/) const
+{
+    fillBuffer(_kernel, _Mtrx, buffer, withNormals, true);
+}
+
+void MeshObject::getFaceBuffer(GeometryBuffer<double> &buffer,
+                               float /*Accuracy*/, bool withNormals, uint16_t /*flags*/) const
+{
+    fillBuffer(_kernel, _Mtrx, buffer, withNormals, true);
+}
+
 unsigned int MeshObject::getMemSize (void) const
 {
     return _kernel.GetMemSize();
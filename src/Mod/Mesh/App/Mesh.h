@@ -133,6 +133,14 @@ public:
         float Accuracy, uint16_t flags=0) const;
     virtual void getFaces(std::vector<Base::Vector3d> &Points,std::vector<Facet> &Topo,
         float Accuracy, uint16_t flags=0) const;
+    virtual void getPointBuffer(GeometryBuffer<float> &buffer,
+        float Accuracy, bool withNormals=false, uint16_t flags=0) const;
+    virtual void getPointBuffer(GeometryBuffer<double> &buffer,
+        float Accuracy, bool withNormals=false, uint16_t flags=0) const;
+    virtual void getFaceBuffer(GeometryBuffer<float> &buffer,
+        float Accuracy, bool withNormals=false, uint16_t flags=0) const;
+    virtual void getFaceBuffer(GeometryBuffer<double> &buffer,
+        float Accuracy, bool withNormals=false, uint16_t flags=0) const;
     std::vector<unsigned long> getPointsFromFacets(const std::vector<unsigned long>& facets) const;
     //@}
 
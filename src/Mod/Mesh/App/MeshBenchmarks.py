@@ -0,0 +1,101 @@
+# -*- coding: utf-8 -*-
+
+#  LGPL
+
+"""Benchmarks for reading and writing meshes in all supported file formats.
+
+Run it from the FreeCAD Python console or with FreeCADCmd:
+
+    import MeshBenchmarks
+    MeshBenchmarks.run()
+
+Besides the synthetic spheres that are created with increasing size, real meshes
+can be passed as a list of file names:
+
+    MeshBenchmarks.run(files=["/path/to/scan.stl"])
+
+For every format the time to write and to read back the mesh is measured and
+printed as throughput in MB/s and facets/s together with the peak memory
+(resident set size) of the process so far.
+"""
+
+import os, sys, tempfile, time
+import FreeCAD, Mesh
+
+try:
+    from BenchmarkApp import record
+except ImportError:
+    def record(*args, **kwargs):
+        pass
+
+try:
+    import resource
+except ImportError:
+    resource = None
+
+# formats that can be written and read
+ROUNDTRIP_FORMATS = ["bms", "stl", "ast", "obj", "off", "ply", "smf", "nas", "iv"]
+# formats that can only be written
+WRITE_ONLY_FORMATS = ["x3d", "x3dz", "xhtml", "wrl", "wrz", "amf", "asy", "idtf", "mgl", "py"]
+# samplings of the synthetic spheres
+SPHERE_SAMPLINGS = [50, 100, 200, 400]
+
+
+def peakMemory():
+    """Returns the peak resident set size of the process in MB or None if unknown."""
+    if resource is None:
+        return None
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # macOS reports bytes, Linux kilobytes
+    if sys.platform == "darwin":
+        return rss / (1024.0 * 1024.0)
+    return rss / 1024.0
+
+
+def report(name, fmt, operation, facets, size, seconds):
+    seconds = max(seconds, 1e-9)
+    record("Mesh", name, seconds, format=fmt, operation=operation, facets=facets, size=size)
+    mbytes = size / (1024.0 * 1024.0)
+    rss = peakMemory()
+    rss = "%.1f MB" % rss if rss is not None else "n/a"
+    FreeCAD.Console.PrintMessage("%-20s %-6s %-5s %10d facets %10.2f MB %8.3f s %10.2f MB/s %12.0f facets/s  peak RSS %s\n"
+                                 % (name, fmt, operation, facets, mbytes, seconds, mbytes / seconds, facets / seconds, rss))
+
+
+def benchmarkMesh(name, mesh, formats=None, directory=None):
+    """Writes the mesh in all given formats and reads it back where the format supports it."""
+    if formats is None:
+        formats = ROUNDTRIP_FORMATS + WRITE_ONLY_FORMATS
+    if directory is None:
+        directory = tempfile.gettempdir()
+
+    facets = mesh.CountFacets
+    for fmt in formats:
+        filename = os.path.join(directory, "mesh_benchmark." + fmt)
+        try:
+            start = time.time()
+            mesh.write(filename)
+            report(name, fmt, "write", facets, os.path.getsize(filename), time.time() - start)
+
+            if fmt in ROUNDTRIP_FORMATS:
+                start = time.time()
+                other = Mesh.Mesh(filename)
+                report(name, fmt, "read", other.CountFacets, os.path.getsize(filename), time.time() - start)
+        except Exception as e:
+            FreeCAD.Console.PrintError("%s: %s failed: %s\n" % (name, fmt, str(e)))
+        finally:
+            if os.path.exists(filename):
+                os.remove(filename)
+
+
+def run(files=None, formats=None, samplings=None):
+    """Runs the benchmarks on synthetic spheres of increasing size and the given mesh files."""
+    if samplings is None:
+        samplings = SPHERE_SAMPLINGS
+    for sampling in samplings:
+        mesh = Mesh.createSphere(10.0, sampling)
+        benchmarkMesh("sphere(%d)" % sampling, mesh, formats)
+
+    for filename in files or []:
+        mesh = Mesh.Mesh(filename)
+        benchmarkMesh(os.path.basename(filename), mesh, formats)
@@ -624,6 +624,26 @@ void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
     hasSetValue();
 }
 
+void PropertyMeshKernel::RestoreDocFileConcurrent(Base::Reader &reader)
+{
+    // runs in a worker thread, see Base::XMLReader::readFiles()
+    Base::Reference<MeshObject> mesh(new MeshObject());
+    mesh->load(reader);
+    _restoredMesh = mesh;
+}
+
+void PropertyMeshKernel::finishRestoreDocFile()
+{
+    if (_restoredMesh.isValid()) {
+        Base::Reference<MeshObject> mesh = _restoredMesh;
+        _restoredMesh = 0;
+        mesh->setTransform(_meshObject->getTransform());
+        aboutToSetValue();
+        _meshObject->swap(*mesh);
+        hasSetValue();
+    }
+}
+
 App::Property *PropertyMeshKernel::Copy(void) const
 {
     // Note: Copy the content, do NOT reference the same mesh object
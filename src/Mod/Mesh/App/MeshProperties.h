@@ -244,6 +244,9 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const;
     void RestoreDocFile(Base::Reader &reader);
+    bool allowConcurrentRestore() const {return true;}
+    void RestoreDocFileConcurrent(Base::Reader &reader);
+    void finishRestoreDocFile();
 
     App::Property *Copy(void) const;
     void Paste(const App::Property &from);
@@ -251,6 +254,7 @@ public:
 
 private:
     Base::Reference<MeshObject> _meshObject;
+    Base::Reference<MeshObject> _restoredMesh;
     MeshPy* meshPyObject;
 };
 
@@ -41,6 +41,7 @@
 #include "Core/Triangulation.h"
 #include "Core/Iterator.h"
 #include "Core/Degeneration.h"
+#include "Core/Evaluation.h"
 #include "Core/Elements.h"
 #include "Core/Grid.h"
 #include "Core/MeshKernel.h"
@@ -746,6 +747,32 @@ PyObject*  MeshPy::addFacets(PyObject *args)
     return NULL;
 }
 
+PyObject*  MeshPy::setFromArrays(PyObject *args)
+{
+    PyObject *pts, *fts;
+    if (!PyArg_ParseTuple(args, "OO", &pts, &fts))
+        return NULL;
+
+    std::vector<Base::Vector3d> points;
+    std::vector<Data::ComplexGeoData::Facet> facets;
+    if (!Data::ComplexGeoDataPy::readPointArray(pts, points) ||
+        !Data::ComplexGeoDataPy::readFacetArray(fts, facets))
+        return NULL;
+
+    for (std::vector<Data::ComplexGeoData::Facet>::const_iterator it = facets.begin(); it != facets.end(); ++it) {
+        if (it->I1 >= points.size() || it->I2 >= points.size() || it->I3 >= points.size()) {
+            PyErr_SetString(PyExc_IndexError, "point index out of range");
+            return NULL;
+        }
+    }
+
+    PY_TRY {
+        getMeshObjectPtr()->setFacets(facets, points);
+    } PY_CATCH;
+
+    Py_Return;
+}
+
 PyObject* MeshPy::removeFacets(PyObject *args)
 {
     PyObject* list;
@@ -1130,6 +1157,57 @@ PyObject*  MeshPy::harmonizeNormals(PyObject *args)
     Py_Return;
 }
 
+PyObject*  MeshPy::analyze(PyObject *args)
+{
+    float fEps = 0.0f;
+    if (!PyArg_ParseTuple(args, "|f", &fEps))
+        return NULL;
+
+    PY_TRY {
+        const MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+        typedef std::pair<std::string, MeshCore::MeshEvaluationPtr> NamedCheck;
+
+        // the other checks rely on valid indices
+        std::vector<NamedCheck> checks;
+        checks.push_back(NamedCheck("FacetIndices", std::make_shared<MeshCore::MeshEvalRangeFacet>(kernel)));
+        checks.push_back(NamedCheck("PointIndices", std::make_shared<MeshCore::MeshEvalRangePoint>(kernel)));
+        checks.push_back(NamedCheck("CorruptedFacets", std::make_shared<MeshCore::MeshEvalCorruptedFacets>(kernel)));
+
+        Py::Dict dict;
+        MeshCore::MeshEvalBatch indices;
+        for (std::vector<NamedCheck>::iterator it = checks.begin(); it != checks.end(); ++it)
+            indices.Add(it->second);
+        bool ok = indices.Evaluate();
+        for (std::size_t i = 0; i < checks.size(); i++)
+            dict.setItem(checks[i].first, Py::Boolean(indices.GetResult(i)));
+        if (!ok)
+            return Py::new_reference_to(dict);
+
+        checks.clear();
+        checks.push_back(NamedCheck("Neighbourhood", std::make_shared<MeshCore::MeshEvalNeighbourhood>(kernel)));
+        checks.push_back(NamedCheck("Orientation", std::make_shared<MeshCore::MeshEvalOrientation>(kernel)));
+        checks.push_back(NamedCheck("DuplicatedFacets", std::make_shared<MeshCore::MeshEvalDuplicateFacets>(kernel)));
+        checks.push_back(NamedCheck("DuplicatedPoints", std::make_shared<MeshCore::MeshEvalDuplicatePoints>(kernel)));
+        checks.push_back(NamedCheck("InvalidPoints", std::make_shared<MeshCore::MeshEvalNaNPoints>(kernel)));
+        checks.push_back(NamedCheck("NonManifolds", std::make_shared<MeshCore::MeshEvalTopology>(kernel)));
+        checks.push_back(NamedCheck("NonManifoldPoints", std::make_shared<MeshCore::MeshEvalPointManifolds>(kernel)));
+        checks.push_back(NamedCheck("DegeneratedFacets", std::make_shared<MeshCore::MeshEvalDegeneratedFacets>(kernel, fEps)));
+        checks.push_back(NamedCheck("SelfIntersections", std::make_shared<MeshCore::MeshEvalSelfIntersection>(kernel)));
+        checks.push_back(NamedCheck("FoldsOnSurface", std::make_shared<MeshCore::MeshEvalFoldsOnSurface>(kernel)));
+        checks.push_back(NamedCheck("FoldsOnBoundary", std::make_shared<MeshCore::MeshEvalFoldsOnBoundary>(kernel)));
+        checks.push_back(NamedCheck("FoldOversOnSurface", std::make_shared<MeshCore::MeshEvalFoldOversOnSurface>(kernel)));
+
+        MeshCore::MeshEvalBatch batch;
+        for (std::vector<NamedCheck>::iterator it = checks.begin(); it != checks.end(); ++it)
+            batch.Add(it->second);
+        batch.Evaluate();
+        for (std::size_t i = 0; i < checks.size(); i++)
+            dict.setItem(checks[i].first, Py::Boolean(batch.GetResult(i)));
+
+        return Py::new_reference_to(dict);
+    } PY_CATCH;
+}
+
 PyObject*  MeshPy::countComponents(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
@@ -1159,11 +1237,18 @@ PyObject*  MeshPy::fillupHoles(PyObject *args)
     unsigned long len;
     int level = 0;
     float max_area = 0.0f;
-    if (!PyArg_ParseTuple(args, "k|if", &len,&level,&max_area))
+    PyObject* min_area = Py_False;
+    PyObject* fairing = Py_False;
+    if (!PyArg_ParseTuple(args, "k|ifO!O!", &len,&level,&max_area,
+                          &PyBool_Type, &min_area, &PyBool_Type, &fairing))
         return NULL;
     try {
         std::unique_ptr<MeshCore::AbstractPolygonTriangulator> tria;
-        if (max_area > 0.0f) {
+        if (PyObject_IsTrue(min_area) || PyObject_IsTrue(fairing)) {
+            tria = std::unique_ptr<MeshCore::AbstractPolygonTriangulator>
+                (new MeshCore::MinimumAreaTriangulator(PyObject_IsTrue(fairing) ? true : false));
+        }
+        else if (max_area > 0.0f) {
             tria = std::unique_ptr<MeshCore::AbstractPolygonTriangulator>
                 (new MeshCore::ConstraintDelaunayTriangulator(max_area));
         }
@@ -81,11 +81,13 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh, bool addDefaultColor, cons
         std::vector<App::Color> diffuseColor;
         const MeshCore::MeshPointArray& points = mesh.getKernel().GetPoints();
         const MeshCore::MeshFacetArray& facets = mesh.getKernel().GetFacets();
+        std::vector<unsigned long> indices;
+        findIndices(points, max_dist, indices);
 
         if (binding == MeshCore::MeshIO::PER_VERTEX) {
             diffuseColor.reserve(points.size());
             for (size_t index=0; index<points.size(); index++) {
-                unsigned long pos = findIndex(points[index], max_dist);
+                unsigned long pos = indices[index];
                 if (pos < countPointsRefMesh) {
                     diffuseColor.push_back(textureColor[pos]);
                 }
@@ -104,7 +106,7 @@ void MeshTexture::apply(const Mesh::MeshObject& mesh, bool addDefaultColor, cons
             std::vector<unsigned long> pointMap;
             pointMap.reserve(points.size());
             for (size_t index=0; index<points.size(); index++) {
-                unsigned long pos = findIndex(points[index], max_dist);
+                unsigned long pos = indices[index];
                 if (pos < countPointsRefMesh) {
                     pointMap.push_back(pos);
                 }
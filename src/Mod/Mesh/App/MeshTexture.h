@@ -74,14 +74,12 @@ public:
 
 private:
     void apply(const Mesh::MeshObject& mesh, bool addDefaultColor, const App::Color& defaultColor, float max_dist, MeshCore::Material &material);
-    unsigned long findIndex(const Base::Vector3f& p, float max_dist) const {
+    void findIndices(const MeshCore::MeshPointArray& p, float max_dist, std::vector<unsigned long>& indices) const {
         if (max_dist < 0.0f) {
-            return kdTree->FindExact(p);
+            kdTree->FindExact(p, indices);
         }
         else {
-            Base::Vector3f n;
-            float dist;
-            return kdTree->FindNearest(p, max_dist, n, dist);
+            kdTree->FindNearest(p, max_dist, indices);
         }
     }
 
@@ -0,0 +1,279 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <numeric>
+#endif
+
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+
+#include "MeshLevelOfDetail.h"
+#include <Base/BoundBox.h>
+#include <Mod/Mesh/App/Mesh.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+using namespace MeshGui;
+
+namespace {
+template <class Function>
+void forEachBlock(std::size_t count, Function func)
+{
+    const std::size_t blockSize = 4096;
+    if (count <= blockSize) {
+        func(std::make_pair(std::size_t(0), count));
+        return;
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i = 0; i < count; i += blockSize)
+        blocks.push_back(std::make_pair(i, std::min(i + blockSize, count)));
+    QtConcurrent::blockingMap(blocks, func);
+}
+
+struct Triangle {
+    uint32_t p[3];
+    bool operator < (const Triangle& t) const {
+        if (p[0] != t.p[0]) return p[0] < t.p[0];
+        if (p[1] != t.p[1]) return p[1] < t.p[1];
+        return p[2] < t.p[2];
+    }
+    bool operator == (const Triangle& t) const {
+        return p[0] == t.p[0] && p[1] == t.p[1] && p[2] == t.p[2];
+    }
+};
+}
+
+MeshLevelOfDetail::MeshLevelOfDetail()
+  : abort(false)
+{
+}
+
+MeshLevelOfDetail::~MeshLevelOfDetail()
+{
+    clear();
+}
+
+void MeshLevelOfDetail::build(const Mesh::MeshObject& mesh)
+{
+    clear();
+
+    // Work on a copy because the mesh may change while the build is running
+    const MeshCore::MeshKernel& kernel = mesh.getKernel();
+    const MeshCore::MeshPointArray& rPoints = kernel.GetPoints();
+    const MeshCore::MeshFacetArray& rFacets = kernel.GetFacets();
+
+    std::shared_ptr<std::vector<Base::Vector3f> > points(new std::vector<Base::Vector3f>(rPoints.begin(), rPoints.end()));
+    std::shared_ptr<std::vector<uint32_t> > facets(new std::vector<uint32_t>(3 * rFacets.size()));
+    std::vector<uint32_t>& indices = *facets;
+    std::size_t index = 0;
+    for (MeshCore::MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
+        indices[index++] = static_cast<uint32_t>(it->_aulPoints[0]);
+        indices[index++] = static_cast<uint32_t>(it->_aulPoints[1]);
+        indices[index++] = static_cast<uint32_t>(it->_aulPoints[2]);
+    }
+
+    future = QtConcurrent::run([this, points, facets]() {
+        run(*points, *facets);
+    });
+}
+
+void MeshLevelOfDetail::clear()
+{
+    abort = true;
+    future.waitForFinished();
+    future = QFuture<void>();
+    levels.clear();
+    abort = false;
+}
+
+bool MeshLevelOfDetail::isReady() const
+{
+    // the levels must not be accessed before the build has finished
+    return future.isFinished() && !levels.empty();
+}
+
+const MeshLevelOfDetail::Level* MeshLevelOfDetail::findLevel(float maxError) const
+{
+    if (!isReady())
+        return 0;
+
+    const Level* level = 0;
+    for (std::vector<Level>::const_iterator it = levels.begin(); it != levels.end(); ++it) {
+        if (it->cellSize > maxError)
+            break;
+        level = &(*it);
+    }
+
+    return level;
+}
+
+void MeshLevelOfDetail::run(std::vector<Base::Vector3f>& points, std::vector<uint32_t>& facets)
+{
+    if (points.empty() || facets.empty())
+        return;
+
+    Base::BoundBox3f box;
+    for (std::vector<Base::Vector3f>::const_iterator it = points.begin(); it != points.end(); ++it)
+        box.Add(*it);
+    float length = std::max<float>(box.LengthX(), std::max<float>(box.LengthY(), box.LengthZ()));
+    if (length <= 0.0f)
+        return;
+
+    // Start with 1024 cells along the longest side and make them four times
+    // larger with each level. As the grids share the same origin the cells of
+    // a coarse level are unions of cells of the finer levels.
+    const int maxLevels = 4;
+    const std::size_t minFacets = 1000;
+    Base::Vector3f origin(box.MinX, box.MinY, box.MinZ);
+    float cellSize = length / 1024.0f;
+    std::size_t lastCount = facets.size() / 3;
+
+    std::vector<Level> result;
+    for (int i = 0; i < maxLevels; i++) {
+        cluster(cellSize, origin, points, facets);
+        if (abort)
+            return;
+
+        std::size_t count = facets.size() / 3;
+        if (count < minFacets)
+            break;
+
+        // skip levels that don't reduce the mesh significantly
+        if (2 * count <= lastCount) {
+            result.push_back(Level());
+            result.back().cellSize = cellSize;
+            createArrays(points, facets, result.back());
+            lastCount = count;
+        }
+
+        cellSize *= 4.0f;
+    }
+
+    if (!abort)
+        levels.swap(result);
+}
+
+void MeshLevelOfDetail::cluster(float cellSize, const Base::Vector3f& origin,
+                                std::vector<Base::Vector3f>& points,
+                                std::vector<uint32_t>& facets) const
+{
+    // Compute the cell of each point
+    std::vector<std::pair<uint64_t, uint32_t> > keys(points.size());
+    forEachBlock(points.size(), [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            const Base::Vector3f& p = points[i];
+            uint64_t x = static_cast<uint64_t>(std::max<float>(0.0f, (p.x - origin.x) / cellSize));
+            uint64_t y = static_cast<uint64_t>(std::max<float>(0.0f, (p.y - origin.y) / cellSize));
+            uint64_t z = static_cast<uint64_t>(std::max<float>(0.0f, (p.z - origin.z) / cellSize));
+            keys[i] = std::make_pair((x << 42) | (y << 21) | z, static_cast<uint32_t>(i));
+        }
+    });
+
+    if (abort)
+        return;
+    std::sort(keys.begin(), keys.end());
+    if (abort)
+        return;
+
+    // Replace the points of a cell by their average
+    std::vector<uint32_t> cells(points.size());
+    std::vector<Base::Vector3f> clusters;
+    for (std::size_t i = 0; i < keys.size();) {
+        std::size_t j = i;
+        Base::Vector3d sum;
+        for (; j < keys.size() && keys[j].first == keys[i].first; j++) {
+            const Base::Vector3f& p = points[keys[j].second];
+            sum += Base::Vector3d(p.x, p.y, p.z);
+            cells[keys[j].second] = static_cast<uint32_t>(clusters.size());
+        }
+        sum /= static_cast<double>(j - i);
+        clusters.push_back(Base::Vector3f(static_cast<float>(sum.x),
+                                          static_cast<float>(sum.y),
+                                          static_cast<float>(sum.z)));
+        i = j;
+    }
+
+    std::vector<std::pair<uint64_t, uint32_t> >().swap(keys);
+    if (abort)
+        return;
+
+    // Remove the facets that collapsed and those that became identical.
+    // The corners are rotated so that the smallest index comes first which
+    // keeps the orientation.
+    std::vector<Triangle> triangles;
+    triangles.reserve(facets.size() / 3);
+    for (std::size_t i = 0; i + 2 < facets.size(); i += 3) {
+        Triangle t;
+        t.p[0] = cells[facets[i]];
+        t.p[1] = cells[facets[i+1]];
+        t.p[2] = cells[facets[i+2]];
+        if (t.p[0] == t.p[1] || t.p[1] == t.p[2] || t.p[2] == t.p[0])
+            continue;
+        std::rotate(t.p, std::min_element(t.p, t.p + 3), t.p + 3);
+        triangles.push_back(t);
+    }
+
+    std::sort(triangles.begin(), triangles.end());
+    triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+    facets.resize(3 * triangles.size());
+    std::size_t index = 0;
+    for (std::vector<Triangle>::const_iterator it = triangles.begin(); it != triangles.end(); ++it) {
+        facets[index++] = it->p[0];
+        facets[index++] = it->p[1];
+        facets[index++] = it->p[2];
+    }
+    points.swap(clusters);
+}
+
+void MeshLevelOfDetail::createArrays(const std::vector<Base::Vector3f>& points,
+                                     const std::vector<uint32_t>& facets, Level& level)
+{
+    // The normal of a point is the area weighted average of its facet normals
+    std::vector<Base::Vector3f> normals(points.size());
+    for (std::size_t i = 0; i + 2 < facets.size(); i += 3) {
+        const Base::Vector3f& v0 = points[facets[i]];
+        const Base::Vector3f& v1 = points[facets[i+1]];
+        const Base::Vector3f& v2 = points[facets[i+2]];
+        Base::Vector3f n = (v1 - v0) % (v2 - v0);
+        normals[facets[i]] += n;
+        normals[facets[i+1]] += n;
+        normals[facets[i+2]] += n;
+    }
+
+    level.vertex_array.resize(6 * points.size());
+    forEachBlock(points.size(), [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            Base::Vector3f n = normals[i];
+            n.Normalize();
+            const Base::Vector3f& v = points[i];
+            float* data = &(level.vertex_array[6 * i]);
+            data[0] = n.x; data[1] = n.y; data[2] = n.z;
+            data[3] = v.x; data[4] = v.y; data[5] = v.z;
+        }
+    });
+
+    level.index_array.assign(facets.begin(), facets.end());
+}
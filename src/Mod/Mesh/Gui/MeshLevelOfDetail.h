@@ -0,0 +1,95 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#ifndef MESHGUI_MESHLEVELOFDETAIL_H
+#define MESHGUI_MESHLEVELOFDETAIL_H
+
+#include <atomic>
+#include <vector>
+#include <QFuture>
+#include <Base/Vector3D.h>
+
+namespace Mesh {
+class MeshObject;
+}
+
+namespace MeshGui {
+
+/**
+ * The MeshLevelOfDetail class builds a hierarchy of simplified versions of a mesh
+ * for rendering.
+ * Each level is created by vertex clustering: the bounding box of the mesh is split
+ * into a regular grid and all points of a grid cell are merged into their average.
+ * Facets whose corners fall into less than three different cells vanish. Each level
+ * is clustered from the previous, finer one with a four times larger cell size.
+ *
+ * The hierarchy is built in a background thread from a copy of the point and facet
+ * data so that the mesh can be modified in the meantime.
+ * A level is chosen by its screen-space error, i.e. by how many pixels its cells
+ * cover in the current view.
+ */
+class MeshLevelOfDetail
+{
+public:
+    struct Level {
+        /// The edge length of a grid cell, i.e. the maximum geometric error
+        float cellSize;
+        /// Interleaved normals and points in GL_N3F_V3F format with smooth shading
+        std::vector<float> vertex_array;
+        std::vector<int32_t> index_array;
+    };
+
+    MeshLevelOfDetail();
+    ~MeshLevelOfDetail();
+
+    /** Starts building the hierarchy of \a mesh in the background. A running build is
+     * cancelled before.
+     */
+    void build(const Mesh::MeshObject&);
+    /// Cancels a running build and drops all levels.
+    void clear();
+    /// Returns true if the build has finished and created at least one level.
+    bool isReady() const;
+    /** Returns the coarsest level whose cell size doesn't exceed \a maxError or null
+     * if the hierarchy isn't ready or even the finest level is too coarse.
+     */
+    const Level* findLevel(float maxError) const;
+
+private:
+    void run(std::vector<Base::Vector3f>& points, std::vector<uint32_t>& facets);
+    void cluster(float cellSize, const Base::Vector3f& origin,
+                 std::vector<Base::Vector3f>& points,
+                 std::vector<uint32_t>& facets) const;
+    static void createArrays(const std::vector<Base::Vector3f>& points,
+                             const std::vector<uint32_t>& facets, Level& level);
+
+    MeshLevelOfDetail(const MeshLevelOfDetail&);
+    MeshLevelOfDetail& operator=(const MeshLevelOfDetail&);
+
+private:
+    QFuture<void> future;
+    std::atomic<bool> abort;
+    std::vector<Level> levels; // from fine to coarse
+};
+
+} // namespace MeshGui
+
+#endif // MESHGUI_MESHLEVELOFDETAIL_H
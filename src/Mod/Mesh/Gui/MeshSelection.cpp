@@ -486,17 +486,23 @@ void MeshSelection::selectGLCallback(void * ud, SoEventCallback * n)
         vp->getFacetsFromPolygon(polygon, proj, true, faces);
 
         if (self->onlyVisibleTriangles) {
-            const SbVec2s& sz = view->getSoRenderManager()->getViewportRegion().getWindowSize();
-            short width,height; sz.getValue(width,height);
+            // read the visible facets inside the polygon from an ID buffer and
+            // fall back to the zoomed bounding box if the mesh is too large for it
             std::vector<SbVec2s> pixelPoly = view->getPolygon();
-            SbBox2s rect;
-            for (std::vector<SbVec2s>::iterator it = pixelPoly.begin(); it != pixelPoly.end(); ++it) {
-                const SbVec2s& p = *it;
-                rect.extendBy(SbVec2s(p[0],height-p[1]));
-            }
             std::vector<unsigned long> rf; rf.swap(faces);
-            std::vector<unsigned long> vf = vp->getVisibleFacetsAfterZoom
-                (rect, view->getSoRenderManager()->getViewportRegion(), view->getSoRenderManager()->getCamera());
+            std::vector<unsigned long> vf;
+            if (!vp->getVisibleFacetsOfPolygon(pixelPoly, view->getSoRenderManager()->getViewportRegion(),
+                                               view->getSoRenderManager()->getCamera(), vf)) {
+                const SbVec2s& sz = view->getSoRenderManager()->getViewportRegion().getWindowSize();
+                short width,height; sz.getValue(width,height);
+                SbBox2s rect;
+                for (std::vector<SbVec2s>::iterator it = pixelPoly.begin(); it != pixelPoly.end(); ++it) {
+                    const SbVec2s& p = *it;
+                    rect.extendBy(SbVec2s(p[0],height-p[1]));
+                }
+                vf = vp->getVisibleFacetsAfterZoom
+                    (rect, view->getSoRenderManager()->getViewportRegion(), view->getSoRenderManager()->getCamera());
+            }
 
             // get common facets of the viewport and the visible one
             std::sort(vf.begin(), vf.end());
@@ -32,6 +32,7 @@
 #ifndef _PreComp_
 # include <algorithm>
 # include <climits>
+# include <map>
 # ifdef FC_OS_MACOSX
 # include <OpenGL/gl.h>
 # include <OpenGL/glu.h>
@@ -55,6 +56,7 @@
 
 #include <Inventor/C/glue/gl.h>
 #include <Inventor/misc/SoContextHandler.h>
+#include <QtConcurrentMap>
 
 #include <Gui/SoFCInteractiveElement.h>
 #include <Gui/SoFCSelectionAction.h>
@@ -68,6 +70,22 @@
 
 using namespace MeshGui;
 
+namespace {
+template <class Function>
+void forEachBlock(std::size_t count, std::size_t blockSize, Function func)
+{
+    if (count <= blockSize) {
+        func(std::make_pair(std::size_t(0), count));
+        return;
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i = 0; i < count; i += blockSize)
+        blocks.push_back(std::make_pair(i, std::min(i + blockSize, count)));
+    QtConcurrent::blockingMap(blocks, func);
+}
+}
+
 #if defined RENDER_GL_VAO
 
 class MeshRenderer::Private {
@@ -78,6 +96,18 @@ public:
     SoMaterialBindingElement::Binding matbinding;
     bool initialized;
 
+    // To upload only what has changed the buffers are split into chunks of a
+    // fixed size and a checksum of each chunk is kept for every GL context.
+    struct Upload {
+        unsigned long generation;
+        std::size_t vertexBytes;
+        std::size_t indexBytes;
+        std::vector<uint64_t> vertexChunks;
+        std::vector<uint64_t> indexChunks;
+    };
+    std::map<uint32_t, Upload> uploads;
+    unsigned long generation;
+
     Private();
     ~Private();
     bool canRenderGLArray(SoGLRenderAction *) const;
@@ -91,6 +121,11 @@ public:
 
 private:
     void renderGLArray(SoGLRenderAction *, GLenum);
+    static void computeChunks(const void* data, std::size_t bytes, std::vector<uint64_t>& chunks);
+    static void uploadChunks(Gui::OpenGLMultiBuffer& buffer, const void* data, std::size_t bytes,
+                             const std::vector<uint64_t>& oldChunks, const std::vector<uint64_t>& newChunks);
+
+    static const std::size_t chunkSize = 65536;
 };
 
 MeshRenderer::Private::Private()
@@ -99,6 +134,7 @@ MeshRenderer::Private::Private()
   , pcolors(0)
   , matbinding(SoMaterialBindingElement::OVERALL)
   , initialized(false)
+  , generation(0)
 {
 }
 
@@ -129,26 +165,95 @@ void MeshRenderer::Private::generateGLArrays(SoGLRenderAction* action,
     if (vertex.empty() || index.empty())
         return;
 
+    uint32_t context = action->getCacheContext();
+    std::size_t vertexBytes = vertex.size() * sizeof(float);
+    std::size_t indexBytes = index.size() * sizeof(int32_t);
+
+    Upload upload;
+    upload.generation = generation;
+    upload.vertexBytes = vertexBytes;
+    upload.indexBytes = indexBytes;
+    computeChunks(&(vertex[0]), vertexBytes, upload.vertexChunks);
+    computeChunks(&(index[0]), indexBytes, upload.indexChunks);
+
+    // If the buffers of this context have the same size only the
+    // modified chunks must be uploaded
+    bool created = vertices.isCreated(context) && indices.isCreated(context);
+    std::map<uint32_t, Upload>::iterator it = uploads.find(context);
+    bool partial = created && it != uploads.end() &&
+                   it->second.vertexBytes == vertexBytes &&
+                   it->second.indexBytes == indexBytes;
+
     // lazy initialization
-    vertices.setCurrentContext(action->getCacheContext());
-    indices.setCurrentContext(action->getCacheContext());
+    vertices.setCurrentContext(context);
+    indices.setCurrentContext(context);
 
     initialized = true;
     vertices.create();
     indices.create();
 
     vertices.bind();
-    vertices.allocate(&(vertex[0]),
-                      vertex.size() * sizeof(float));
+    if (partial)
+        uploadChunks(vertices, &(vertex[0]), vertexBytes, it->second.vertexChunks, upload.vertexChunks);
+    else
+        vertices.allocate(&(vertex[0]), vertexBytes);
     vertices.release();
 
     indices.bind();
-    indices.allocate(&(index[0]),
-                     index.size() * sizeof(int32_t));
+    if (partial)
+        uploadChunks(indices, &(index[0]), indexBytes, it->second.indexChunks, upload.indexChunks);
+    else
+        indices.allocate(&(index[0]), indexBytes);
     indices.release();
+
+    std::swap(uploads[context], upload);
     this->matbinding = matbind;
 }
 
+void MeshRenderer::Private::computeChunks(const void* data, std::size_t bytes, std::vector<uint64_t>& chunks)
+{
+    // FNV-1a checksum over the 32-bit words of each chunk
+    const uint32_t* words = static_cast<const uint32_t*>(data);
+    std::size_t numWords = bytes / sizeof(uint32_t);
+    std::size_t wordsPerChunk = chunkSize / sizeof(uint32_t);
+    chunks.resize((numWords + wordsPerChunk - 1) / wordsPerChunk);
+
+    forEachBlock(chunks.size(), 16, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t i = block.first; i < block.second; i++) {
+            uint64_t hash = 14695981039346656037ULL;
+            std::size_t end = std::min(numWords, (i + 1) * wordsPerChunk);
+            for (std::size_t j = i * wordsPerChunk; j < end; j++) {
+                hash ^= words[j];
+                hash *= 1099511628211ULL;
+            }
+            chunks[i] = hash;
+        }
+    });
+}
+
+void MeshRenderer::Private::uploadChunks(Gui::OpenGLMultiBuffer& buffer, const void* data, std::size_t bytes,
+                                         const std::vector<uint64_t>& oldChunks, const std::vector<uint64_t>& newChunks)
+{
+    // upload consecutive modified chunks with one call
+    const char* ptr = static_cast<const char*>(data);
+    std::size_t numChunks = newChunks.size();
+    for (std::size_t i = 0; i < numChunks;) {
+        if (oldChunks[i] == newChunks[i]) {
+            i++;
+            continue;
+        }
+
+        std::size_t j = i + 1;
+        while (j < numChunks && oldChunks[j] != newChunks[j])
+            j++;
+
+        std::size_t offset = i * chunkSize;
+        std::size_t count = std::min(bytes, j * chunkSize) - offset;
+        buffer.update(offset, ptr + offset, count);
+        i = j;
+    }
+}
+
 void MeshRenderer::Private::renderGLArray(SoGLRenderAction *action, GLenum mode)
 {
     if (!initialized) {
@@ -195,14 +300,18 @@ void MeshRenderer::Private::renderCoordsGLArray(SoGLRenderAction *action)
 
 void MeshRenderer::Private::update()
 {
-    vertices.destroy();
-    indices.destroy();
+    // Keep the buffers so that only the modified parts must be uploaded
+    // the next time generateGLArrays() is called for a context
+    generation++;
 }
 
 bool MeshRenderer::Private::needUpdate(SoGLRenderAction *action)
 {
-    return !vertices.isCreated(action->getCacheContext()) ||
-           !indices.isCreated(action->getCacheContext());
+    uint32_t context = action->getCacheContext();
+    if (!vertices.isCreated(context) || !indices.isCreated(context))
+        return true;
+    std::map<uint32_t, Upload>::const_iterator it = uploads.find(context);
+    return it == uploads.end() || it->second.generation != generation;
 }
 #elif defined RENDER_GLARRAYS
 class MeshRenderer::Private {
@@ -439,12 +548,10 @@ bool MeshRenderer::matchMaterial(SoState* state) const
 
 bool MeshRenderer::shouldRenderDirectly(bool direct)
 {
-#ifdef RENDER_GL_VAO
-    Q_UNUSED(direct);
-    return false;
-#else
+    // SoFCMeshObjectShape renders straight from the mesh kernel and
+    // streams the data into a VBO. So, there is no need to copy huge
+    // meshes into Coin nodes.
     return direct;
-#endif
 }
 
 // ----------------------------------------------------------------------------
@@ -753,10 +860,15 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
         mindices = cindices;
     }
 
+    // Each triangle writes to a fixed range of the arrays so that they can be
+    // filled in parallel. The index arrays have four entries per triangle
+    // because of the terminating -1.
+    const std::size_t blockSize = 4096;
+
     SoNormalBindingElement::Binding normbind = SoNormalBindingElement::get(state);
     if (normbind == SoNormalBindingElement::PER_VERTEX_INDEXED) {
         if (matbind == SoMaterialBindingElement::PER_FACE) {
-            face_vertices.reserve(3 * numTria * 10); // duplicate each vertex (rgba, normal, vertex)
+            face_vertices.resize(3 * numTria * 10); // duplicate each vertex (rgba, normal, vertex)
             face_indices.resize(3 * numTria);
 
             if (numcolors != static_cast<int>(numTria)) {
@@ -765,36 +877,36 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
             }
 
             // the nindices must have the length of numindices
-            int32_t vertex = 0;
-            int index = 0;
             float t = transp ? transp[0] : 0;
-            for (std::size_t i=0; i<numTria; i++) {
-                const SbColor& c = pcolors[i];
-                for (int j=0; j<3; j++) {
-                    face_vertices.push_back(c[0]);
-                    face_vertices.push_back(c[1]);
-                    face_vertices.push_back(c[2]);
-                    face_vertices.push_back(t);
-
-                    const SbVec3f& n = normals[nindices[index]];
-                    face_vertices.push_back(n[0]);
-                    face_vertices.push_back(n[1]);
-                    face_vertices.push_back(n[2]);
-
-                    const SbVec3f& p = points[cindices[index]];
-                    face_vertices.push_back(p[0]);
-                    face_vertices.push_back(p[1]);
-                    face_vertices.push_back(p[2]);
-
-                    face_indices[vertex] = vertex;
-                    vertex++;
-                    index++;
+            forEachBlock(numTria, blockSize, [&](const std::pair<std::size_t, std::size_t>& block) {
+                for (std::size_t i=block.first; i<block.second; i++) {
+                    const SbColor& c = pcolors[i];
+                    for (int j=0; j<3; j++) {
+                        std::size_t index = 4 * i + j;
+                        std::size_t vertex = 3 * i + j;
+                        float* data = &(face_vertices[10 * vertex]);
+                        data[0] = c[0];
+                        data[1] = c[1];
+                        data[2] = c[2];
+                        data[3] = t;
+
+                        const SbVec3f& n = normals[nindices[index]];
+                        data[4] = n[0];
+                        data[5] = n[1];
+                        data[6] = n[2];
+
+                        const SbVec3f& p = points[cindices[index]];
+                        data[7] = p[0];
+                        data[8] = p[1];
+                        data[9] = p[2];
+
+                        face_indices[vertex] = static_cast<int32_t>(vertex);
+                    }
                 }
-                index++;
-            }
+            });
         }
         else if (matbind == SoMaterialBindingElement::PER_VERTEX_INDEXED) {
-            face_vertices.reserve(3 * numTria * 10); // duplicate each vertex (rgba, normal, vertex)
+            face_vertices.resize(3 * numTria * 10); // duplicate each vertex (rgba, normal, vertex)
             face_indices.resize(3 * numTria);
 
             if (numcolors != coords->getNum()) {
@@ -803,62 +915,62 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
             }
 
             // the nindices must have the length of numindices
-            int32_t vertex = 0;
-            int index = 0;
             float t = transp ? transp[0] : 0;
-            for (std::size_t i=0; i<numTria; i++) {
-                for (int j=0; j<3; j++) {
-                    const SbColor& c = pcolors[mindices[index]];
-                    face_vertices.push_back(c[0]);
-                    face_vertices.push_back(c[1]);
-                    face_vertices.push_back(c[2]);
-                    face_vertices.push_back(t);
-
-                    const SbVec3f& n = normals[nindices[index]];
-                    face_vertices.push_back(n[0]);
-                    face_vertices.push_back(n[1]);
-                    face_vertices.push_back(n[2]);
-
-                    const SbVec3f& p = points[cindices[index]];
-                    face_vertices.push_back(p[0]);
-                    face_vertices.push_back(p[1]);
-                    face_vertices.push_back(p[2]);
-
-                    face_indices[vertex] = vertex;
-                    vertex++;
-                    index++;
+            forEachBlock(numTria, blockSize, [&](const std::pair<std::size_t, std::size_t>& block) {
+                for (std::size_t i=block.first; i<block.second; i++) {
+                    for (int j=0; j<3; j++) {
+                        std::size_t index = 4 * i + j;
+                        std::size_t vertex = 3 * i + j;
+                        float* data = &(face_vertices[10 * vertex]);
+                        const SbColor& c = pcolors[mindices[index]];
+                        data[0] = c[0];
+                        data[1] = c[1];
+                        data[2] = c[2];
+                        data[3] = t;
+
+                        const SbVec3f& n = normals[nindices[index]];
+                        data[4] = n[0];
+                        data[5] = n[1];
+                        data[6] = n[2];
+
+                        const SbVec3f& p = points[cindices[index]];
+                        data[7] = p[0];
+                        data[8] = p[1];
+                        data[9] = p[2];
+
+                        face_indices[vertex] = static_cast<int32_t>(vertex);
+                    }
                 }
-                index++;
-            }
+            });
         }
         else {
             // only an overall material
             matbind = SoMaterialBindingElement::OVERALL;
 
-            face_vertices.reserve(3 * numTria * 6); // duplicate each vertex (normal, vertex)
+            face_vertices.resize(3 * numTria * 6); // duplicate each vertex (normal, vertex)
             face_indices.resize(3 * numTria);
 
             // the nindices must have the length of numindices
-            int32_t vertex = 0;
-            int index = 0;
-            for (std::size_t i=0; i<numTria; i++) {
-                for (int j=0; j<3; j++) {
-                    const SbVec3f& n = normals[nindices[index]];
-                    face_vertices.push_back(n[0]);
-                    face_vertices.push_back(n[1]);
-                    face_vertices.push_back(n[2]);
-
-                    const SbVec3f& p = points[cindices[index]];
-                    face_vertices.push_back(p[0]);
-                    face_vertices.push_back(p[1]);
-                    face_vertices.push_back(p[2]);
-
-                    face_indices[vertex] = vertex;
-                    vertex++;
-                    index++;
+            forEachBlock(numTria, blockSize, [&](const std::pair<std::size_t, std::size_t>& block) {
+                for (std::size_t i=block.first; i<block.second; i++) {
+                    for (int j=0; j<3; j++) {
+                        std::size_t index = 4 * i + j;
+                        std::size_t vertex = 3 * i + j;
+                        float* data = &(face_vertices[6 * vertex]);
+                        const SbVec3f& n = normals[nindices[index]];
+                        data[0] = n[0];
+                        data[1] = n[1];
+                        data[2] = n[2];
+
+                        const SbVec3f& p = points[cindices[index]];
+                        data[3] = p[0];
+                        data[4] = p[1];
+                        data[5] = p[2];
+
+                        face_indices[vertex] = static_cast<int32_t>(vertex);
+                    }
                 }
-                index++;
-            }
+            });
         }
     }
     else if (normbind == SoNormalBindingElement::PER_VERTEX) {
@@ -866,30 +978,30 @@ void SoFCIndexedFaceSet::generateGLArrays(SoGLRenderAction * action)
         matbind = SoMaterialBindingElement::OVERALL;
 
         std::size_t numPts = coords->getNum();
-        face_vertices.reserve(6 * numPts);
-        for (std::size_t i=0; i<numPts; i++) {
-            const SbVec3f& n = normals[i];
-            face_vertices.push_back(n[0]);
-            face_vertices.push_back(n[1]);
-            face_vertices.push_back(n[2]);
-
-            const SbVec3f& p = coords->get3(i);
-            face_vertices.push_back(p[0]);
-            face_vertices.push_back(p[1]);
-            face_vertices.push_back(p[2]);
-
-        }
-
-        face_indices.reserve(3 * numTria);
+        face_vertices.resize(6 * numPts);
+        forEachBlock(numPts, blockSize, [&](const std::pair<std::size_t, std::size_t>& block) {
+            for (std::size_t i=block.first; i<block.second; i++) {
+                float* data = &(face_vertices[6 * i]);
+                const SbVec3f& n = normals[i];
+                data[0] = n[0];
+                data[1] = n[1];
+                data[2] = n[2];
+
+                const SbVec3f& p = points[i];
+                data[3] = p[0];
+                data[4] = p[1];
+                data[5] = p[2];
+            }
+        });
 
-        int index = 0;
-        for (std::size_t i=0; i<numTria; i++) {
-            for (int j=0; j<3; j++) {
-                face_indices.push_back(cindices[index]);
-                index++;
+        face_indices.resize(3 * numTria);
+        forEachBlock(numTria, blockSize, [&](const std::pair<std::size_t, std::size_t>& block) {
+            for (std::size_t i=block.first; i<block.second; i++) {
+                for (int j=0; j<3; j++) {
+                    face_indices[3 * i + j] = cindices[4 * i + j];
+                }
             }
-            index++;
-        }
+        });
     }
 
     render.generateGLArrays(action, matbind, face_vertices, face_indices);
@@ -23,6 +23,12 @@
 
 #include "PreCompiled.h"
 
+#ifndef FC_OS_WIN32
+# ifndef GL_GLEXT_PROTOTYPES
+# define GL_GLEXT_PROTOTYPES 1
+# endif
+#endif
+
 #ifndef _PreComp_
 # include <algorithm>
 # include <climits>
@@ -32,9 +38,11 @@
 # ifdef FC_OS_MACOSX
 # include <OpenGL/gl.h>
 # include <OpenGL/glu.h>
+# include <OpenGL/glext.h>
 # else
 # include <GL/gl.h>
 # include <GL/glu.h>
+# include <GL/glext.h>
 # endif
 # include <Inventor/actions/SoCallbackAction.h>
 # include <Inventor/actions/SoGetBoundingBoxAction.h>
@@ -43,16 +51,22 @@
 # include <Inventor/actions/SoPickAction.h>
 # include <Inventor/actions/SoWriteAction.h>
 # include <Inventor/details/SoFaceDetail.h>
+# include <Inventor/elements/SoModelMatrixElement.h>
+# include <Inventor/elements/SoViewportRegionElement.h>
+# include <Inventor/elements/SoViewVolumeElement.h>
 # include <Inventor/errors/SoReadError.h>
 # include <Inventor/misc/SoState.h>
 #endif
 
 #include "SoFCMeshObject.h"
+#include "MeshLevelOfDetail.h"
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Gui/GLBuffer.h>
 #include <Gui/SoFCInteractiveElement.h>
 #include <Gui/SoFCSelectionAction.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/MeshIO.h>
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/Core/Elements.h>
@@ -334,7 +348,7 @@ SO_NODE_SOURCE(SoFCMeshPickNode)
 /*!
   Constructor.
 */
-SoFCMeshPickNode::SoFCMeshPickNode(void) : meshGrid(0)
+SoFCMeshPickNode::SoFCMeshPickNode(void) : meshBVH(0)
 {
     SO_NODE_CONSTRUCTOR(SoFCMeshPickNode);
 
@@ -346,7 +360,7 @@ SoFCMeshPickNode::SoFCMeshPickNode(void) : meshGrid(0)
 */
 SoFCMeshPickNode::~SoFCMeshPickNode()
 {
-    delete meshGrid;
+    delete meshBVH;
 }
 
 // Doc from superclass.
@@ -361,10 +375,9 @@ void SoFCMeshPickNode::notify(SoNotList *list)
     if (f == &mesh) {
         const Mesh::MeshObject* meshObject = mesh.getValue();
         if (meshObject) {
-            MeshCore::MeshAlgorithm alg(meshObject->getKernel());
-            float fAvgLen = alg.GetAverageEdgeLength();
-            delete meshGrid;
-            meshGrid = new MeshCore::MeshFacetGrid(meshObject->getKernel(), 5.0f * fAvgLen);
+            // a BVH doesn't degrade on meshes with a very non-uniform density like a grid
+            delete meshBVH;
+            meshBVH = new MeshCore::MeshFacetBVH(meshObject->getKernel());
         }
     }
 }
@@ -389,7 +402,7 @@ void SoFCMeshPickNode::pick(SoPickAction * action)
     Base::Vector3f pt(pos[0],pos[1],pos[2]);
     Base::Vector3f dr(dir[0],dir[1],dir[2]);
     unsigned long index;
-    if (alg.NearestFacetOnRay(pt, dr, *meshGrid, pt, index)) {
+    if (meshBVH && alg.NearestFacetOnRay(pt, dr, *meshBVH, pt, index)) {
         SoPickedPoint* pp = raypick->addIntersection(SbVec3f(pt.x,pt.y,pt.z));
         if (pp) {
             SoFaceDetail* det = new SoFaceDetail();
@@ -592,8 +605,13 @@ void SoFCMeshObjectShape::initClass()
 
 SoFCMeshObjectShape::SoFCMeshObjectShape()
     : renderTriangleLimit(UINT_MAX)
+    , lodTriangleLimit(1000000)
     , selectBuf(0)
     , updateGLArray(false)
+    , lod(new MeshLevelOfDetail())
+    , updateLOD(true)
+    , vertexBuffer(new Gui::OpenGLMultiBuffer(GL_ARRAY_BUFFER))
+    , vertexCount(0)
 {
     SO_NODE_CONSTRUCTOR(SoFCMeshObjectShape);
     setName(SoFCMeshObjectShape::getClassTypeId().getName());
@@ -601,12 +619,16 @@ SoFCMeshObjectShape::SoFCMeshObjectShape()
 
 SoFCMeshObjectShape::~SoFCMeshObjectShape()
 {
+    delete lod;
+    delete vertexBuffer;
 }
 
 void SoFCMeshObjectShape::notify(SoNotList * node)
 {
     inherited::notify(node);
     updateGLArray = true;
+    updateLOD = true;
+    vertexBuffer->destroy();
 }
 
 #define RENDER_GLARRAYS
@@ -641,10 +663,18 @@ void SoFCMeshObjectShape::GLRender(SoGLRenderAction *action)
         if (SoShapeHintsElement::getVertexOrdering(state) == SoShapeHintsElement::CLOCKWISE) 
             ccw = false;
 
-        if (mode == false || mesh->countFacets() <= this->renderTriangleLimit) {
+        if (mbind == OVERALL && renderLevelOfDetail(action, mesh, mode)) {
+            // a simplified version of the mesh has been rendered
+        }
+        else if (mode == false || mesh->countFacets() <= this->renderTriangleLimit) {
             if (mbind != OVERALL) {
                 drawFaces(mesh, &mb, mbind, needNormals, ccw);
             }
+            else if (canRenderGLBuffer(action) &&
+                     (vertexBuffer->isCreated(action->getCacheContext()) ||
+                      generateGLBuffer(action, mesh))) {
+                renderFacesGLBuffer(action);
+            }
             else {
 #ifdef RENDER_GLARRAYS
                 if (updateGLArray) {
@@ -963,6 +993,149 @@ void SoFCMeshObjectShape::renderCoordsGLArray(SoGLRenderAction *action)
     glDisableClientState(GL_NORMAL_ARRAY);
 }
 
+/**
+ * Renders a simplified version of the mesh if it is large enough and if there is a level
+ * whose error doesn't exceed a few pixels in interactive mode and half a pixel otherwise.
+ * Builds the levels in the background if the mesh has changed. Returns false if nothing
+ * has been rendered.
+ */
+bool SoFCMeshObjectShape::renderLevelOfDetail(SoGLRenderAction *action, const Mesh::MeshObject* mesh,
+                                              SbBool interactive)
+{
+    if (mesh->countFacets() <= this->lodTriangleLimit)
+        return false;
+
+    if (updateLOD) {
+        updateLOD = false;
+        lod->build(*mesh);
+    }
+
+    if (!lod->isReady())
+        return false;
+
+    // The size of a pixel at the center of the mesh
+    SoState* state = action->getState();
+    const SbViewportRegion & vp = SoViewportRegionElement::get(state);
+    const SbViewVolume & vv = SoViewVolumeElement::get(state);
+    Base::Vector3f mid = mesh->getKernel().GetBoundBox().GetCenter();
+    SbVec3f center(mid.x, mid.y, mid.z);
+    SoModelMatrixElement::get(state).multVecMatrix(center, center); // world coords
+    float pixelSize = vv.getWorldToScreenScale(center, 1.0f / float(vp.getViewportSizePixels()[1]));
+
+    float maxError = (interactive ? 4.0f : 0.5f) * pixelSize;
+    const MeshLevelOfDetail::Level* level = lod->findLevel(maxError);
+    if (!level || level->index_array.empty())
+        return false;
+
+    GLsizei cnt = static_cast<GLsizei>(level->index_array.size());
+
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    glInterleavedArrays(GL_N3F_V3F, 0, &(level->vertex_array[0]));
+    glDrawElements(GL_TRIANGLES, cnt, GL_UNSIGNED_INT, &(level->index_array[0]));
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+
+    return true;
+}
+
+bool SoFCMeshObjectShape::canRenderGLBuffer(SoGLRenderAction *action) const
+{
+    // get the VBO status of the viewer
+    SbBool useVBO = true;
+    Gui::SoGLVBOActivatedElement::get(action->getState(), useVBO);
+    if (!useVBO)
+        return false;
+
+    static bool init = false;
+    static bool vboAvailable = false;
+    if (!init) {
+        vboAvailable = Gui::OpenGLBuffer::isVBOSupported(action->getCacheContext());
+        init = true;
+    }
+
+    return vboAvailable;
+}
+
+/**
+ * Fills the vertex buffer with the flat shaded triangles of the mesh. The data is
+ * generated directly from the mesh kernel and uploaded in portions of a fixed size
+ * so that there is never a complete copy of the mesh in memory.
+ * Returns false if the buffer cannot be created or the mesh is too large for it.
+ */
+bool SoFCMeshObjectShape::generateGLBuffer(SoGLRenderAction *action, const Mesh::MeshObject* mesh)
+{
+    const MeshCore::MeshKernel& kernel = mesh->getKernel();
+    const MeshCore::MeshPointArray& cP = kernel.GetPoints();
+    const MeshCore::MeshFacetArray& cF = kernel.GetFacets();
+
+    // normal and point for each of the three corners
+    const std::size_t floatsPerFacet = 18;
+    const std::size_t facetsPerPortion = 65536;
+    std::size_t numFacets = cF.size();
+    if (numFacets == 0 || numFacets > INT_MAX / (floatsPerFacet * sizeof(float)))
+        return false;
+
+    vertexBuffer->setCurrentContext(action->getCacheContext());
+    if (!vertexBuffer->create())
+        return false;
+
+    this->vertexCount = static_cast<int32_t>(3 * numFacets);
+
+    vertexBuffer->bind();
+    vertexBuffer->allocate(0, static_cast<int>(numFacets * floatsPerFacet * sizeof(float)));
+
+    std::vector<float> portion;
+    portion.reserve(facetsPerPortion * floatsPerFacet);
+    for (std::size_t start = 0; start < numFacets; start += facetsPerPortion) {
+        std::size_t end = std::min(start + facetsPerPortion, numFacets);
+        portion.clear();
+        for (std::size_t i = start; i < end; i++) {
+            const MeshCore::MeshFacet& face = cF[i];
+            const Base::Vector3f& v0 = cP[face._aulPoints[0]];
+            const Base::Vector3f& v1 = cP[face._aulPoints[1]];
+            const Base::Vector3f& v2 = cP[face._aulPoints[2]];
+            Base::Vector3f n = (v1 - v0) % (v2 - v0);
+            n.Normalize();
+            const Base::Vector3f* corners[3] = {&v0, &v1, &v2};
+            for (int j = 0; j < 3; j++) {
+                portion.push_back(n.x);
+                portion.push_back(n.y);
+                portion.push_back(n.z);
+                portion.push_back(corners[j]->x);
+                portion.push_back(corners[j]->y);
+                portion.push_back(corners[j]->z);
+            }
+        }
+
+        vertexBuffer->update(static_cast<int>(start * floatsPerFacet * sizeof(float)), &(portion[0]),
+                             static_cast<int>(portion.size() * sizeof(float)));
+    }
+
+    vertexBuffer->release();
+    return true;
+}
+
+void SoFCMeshObjectShape::renderFacesGLBuffer(SoGLRenderAction *action)
+{
+    vertexBuffer->setCurrentContext(action->getCacheContext());
+    if (this->vertexCount == 0 || !vertexBuffer->bind())
+        return;
+
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glEnableClientState(GL_VERTEX_ARRAY);
+
+    glInterleavedArrays(GL_N3F_V3F, 0, 0);
+    glDrawArrays(GL_TRIANGLES, 0, this->vertexCount);
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+
+    vertexBuffer->release();
+}
+
 void SoFCMeshObjectShape::doAction(SoAction * action)
 {
     if (action->getTypeId() == Gui::SoGLSelectAction::getClassTypeId()) {
@@ -38,10 +38,13 @@ typedef unsigned int GLuint;
 typedef int GLint;
 typedef float GLfloat;
 
-namespace MeshCore { class MeshFacetGrid; }
+namespace MeshCore { class MeshFacetGrid; class MeshFacetBVH; }
+namespace Gui { class OpenGLMultiBuffer; }
 
 namespace MeshGui {
 
+class MeshLevelOfDetail;
+
 class MeshGuiExport SoSFMeshObject : public SoSField {
     typedef SoSField inherited;
 
@@ -96,7 +99,7 @@ protected:
     virtual ~SoFCMeshPickNode();
 
 private:
-    MeshCore::MeshFacetGrid* meshGrid;
+    MeshCore::MeshFacetBVH* meshBVH;
 };
 
 // -------------------------------------------------------
@@ -155,6 +158,15 @@ protected:
  * The limit of maximum allowed triangles can be specified in \a renderTriangleLimit, the
  * default value is set to 100.000.
  *
+ * For meshes with more than \a lodTriangleLimit triangles a hierarchy of simplified meshes
+ * is built in the background (see MeshLevelOfDetail). Once it is available the coarsest
+ * level whose error is below a few pixels is rendered during user interaction and below
+ * half a pixel otherwise. This replaces the point rendering from above.
+ *
+ * The node doesn't keep a copy of the mesh data. If vertex buffer objects are supported
+ * the facets are streamed from the MeshKernel arrays into a buffer in small portions so
+ * that the mesh costs no extra memory on the CPU side.
+ *
  * The GLRender() method checks the status of the SoFCInteractiveElement to decide to be in
  * interactive mode or not.
  * To take advantage of this facility the client programmer must set the status of the
@@ -173,6 +185,7 @@ public:
     SoFCMeshObjectShape();
 
     unsigned int renderTriangleLimit;
+    unsigned int lodTriangleLimit;
 
 protected:
     virtual void doAction(SoAction * action);
@@ -213,6 +226,10 @@ private:
     void generateGLArrays(SoState * state);
     void renderFacesGLArray(SoGLRenderAction *action);
     void renderCoordsGLArray(SoGLRenderAction *action);
+    bool renderLevelOfDetail(SoGLRenderAction *action, const Mesh::MeshObject*, SbBool interactive);
+    bool canRenderGLBuffer(SoGLRenderAction *action) const;
+    bool generateGLBuffer(SoGLRenderAction *action, const Mesh::MeshObject*);
+    void renderFacesGLBuffer(SoGLRenderAction *action);
 
 private:
     GLuint *selectBuf;
@@ -222,6 +239,12 @@ private:
     std::vector<int32_t> index_array;
     std::vector<float> vertex_array;
     SbBool updateGLArray;
+    // Levels of detail
+    MeshLevelOfDetail* lod;
+    SbBool updateLOD;
+    // Vertex buffer object
+    Gui::OpenGLMultiBuffer* vertexBuffer;
+    int32_t vertexCount;
 };
 
 class MeshGuiExport SoFCMeshSegmentShape : public SoShape {
@@ -1400,8 +1400,99 @@ std::vector<unsigned long> ViewProviderMesh::getVisibleFacets(const SbViewportRe
 
     return faces;
 #else
+    QImage img;
+    if (!renderFacetIds(vp, camera, img))
+        return std::vector<unsigned long>();
+
+    int width = img.width();
+    int height = img.height();
+    QRgb color=0;
+    std::vector<unsigned long> faces;
+    for (int y = 0; y < height; y++) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+        for (int x = 0; x < width; x++) {
+            QRgb rgb = line[x] & 0xffffff;
+            if (rgb != 0 && rgb != color) {
+                color = rgb;
+                faces.push_back((unsigned long)rgb - 1);
+            }
+        }
+    }
+
+    std::sort(faces.begin(), faces.end());
+    faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
+
+    return faces;
+#endif
+}
+
+/*!
+ * \brief ViewProviderMesh::getVisibleFacetsOfPolygon returns the facets that are visible
+ * inside the given polygon. The polygon is given in pixel coordinates of the viewport with
+ * the origin at the upper left corner as returned by View3DInventorViewer::getPolygon().
+ * The facets are read back from an ID buffer so that the costs depend on the number of pixels
+ * and not on the number of facets. Returns false if the mesh has too many facets to be
+ * encoded in the ID buffer.
+ */
+bool ViewProviderMesh::getVisibleFacetsOfPolygon(const std::vector<SbVec2s>& picked,
+                                                 const SbViewportRegion& vp,
+                                                 SoCamera* camera,
+                                                 std::vector<unsigned long>& faces) const
+{
+    QImage img;
+    if (!renderFacetIds(vp, camera, img))
+        return false;
+    if (picked.size() < 3)
+        return true;
+
+    Base::Polygon2d polygon;
+    for (std::vector<SbVec2s>::const_iterator it = picked.begin(); it != picked.end(); ++it)
+        polygon.Add(Base::Vector2d((*it)[0],(*it)[1]));
+
+    // only read back the pixels inside the bounding box of the polygon
+    Base::BoundBox2d box = polygon.CalcBoundBox();
+    int xmin = std::max<int>(0, (int)box.MinX);
+    int ymin = std::max<int>(0, (int)box.MinY);
+    int xmax = std::min<int>(img.width() - 1, (int)box.MaxX);
+    int ymax = std::min<int>(img.height() - 1, (int)box.MaxY);
+    bool isRect = (picked.size() == 4 && picked[0][1] == picked[1][1] && picked[1][0] == picked[2][0] &&
+                   picked[2][1] == picked[3][1] && picked[3][0] == picked[0][0]);
+
+    QRgb color=0;
+    for (int y = ymin; y <= ymax; y++) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+        for (int x = xmin; x <= xmax; x++) {
+            QRgb rgb = line[x] & 0xffffff;
+            if (rgb != 0 && rgb != color) {
+                if (!isRect && !polygon.Contains(Base::Vector2d(x + 0.5, y + 0.5)))
+                    continue;
+                color = rgb;
+                faces.push_back((unsigned long)rgb - 1);
+            }
+        }
+    }
+
+    std::sort(faces.begin(), faces.end());
+    faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
+
+    return true;
+}
+
+/*!
+ * \brief ViewProviderMesh::renderFacetIds renders the mesh into an offscreen buffer where the
+ * color of each pixel encodes the index of the visible facet plus one. Black means no facet.
+ * Returns false if the number of facets exceeds the 24 bits of the color.
+ */
+bool ViewProviderMesh::renderFacetIds(const SbViewportRegion& vp, SoCamera* camera, QImage& img) const
+{
     const Mesh::PropertyMeshKernel& meshProp = static_cast<Mesh::Feature*>(pcObject)->Mesh;
     const Mesh::MeshObject& mesh = meshProp.getValue();
+    if (mesh.countFacets() >= 0xffffff) {
+        // a copied camera must be destroyed as if it had been added to the scene
+        camera->ref();
+        camera->unref();
+        return false;
+    }
     uint32_t count = (uint32_t)mesh.countFacets();
 
     SoSeparator* root = new SoSeparator;
@@ -1421,7 +1512,7 @@ std::vector<unsigned long> ViewProviderMesh::getVisibleFacets(const SbViewportRe
     SbColor* diffcol = mat->diffuseColor.startEditing();
     for (uint32_t i=0; i<count; i++) {
         float t;
-        diffcol[i].setPackedValue(i<<8,t);
+        diffcol[i].setPackedValue((i+1)<<8,t);
     }
 
     mat->diffuseColor.finishEditing();
@@ -1450,31 +1541,14 @@ std::vector<unsigned long> ViewProviderMesh::getVisibleFacets(const SbViewportRe
     renderer.setBackgroundColor(SbColor4f(0.0f, 0.0f, 0.0f));
 #endif
 
-    QImage img;
     renderer.render(root);
     renderer.writeToImage(img);
     root->unref();
 
-    int width = img.width();
-    int height = img.height();
-    QRgb color=0;
-    std::vector<unsigned long> faces;
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            QRgb rgb = img.pixel(x,y);
-            rgb = rgb-(0xff << 24);
-            if (rgb != 0 && rgb != color) {
-                color = rgb;
-                faces.push_back((unsigned long)rgb);
-            }
-        }
-    }
-
-    std::sort(faces.begin(), faces.end());
-    faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
-
-    return faces;
-#endif
+    // make sure the pixels can be accessed as 32-bit values
+    if (img.format() != QImage::Format_RGB32 && img.format() != QImage::Format_ARGB32)
+        img = img.convertToFormat(QImage::Format_RGB32);
+    return !img.isNull();
 }
 
 void ViewProviderMesh::cutMesh(const std::vector<SbVec2f>& picked, 
@@ -2094,9 +2168,24 @@ void ViewProviderMesh::selectArea(short x, short y, short w, short h,
                                   const SbViewportRegion& region,
                                   SoCamera* camera)
 {
-    SbViewportRegion vp;
-    vp.setViewportPixels (x, y, w, h);
-    std::vector<unsigned long> faces = getFacetsOfRegion(vp, region, camera);
+    // The rectangle in image coordinates, i.e. with the origin at the upper left corner
+    short height = region.getViewportSizePixels()[1];
+    short left = x - w/2;
+    short top = height - 1 - (y + h/2);
+    std::vector<SbVec2s> rect;
+    rect.push_back(SbVec2s(left, top));
+    rect.push_back(SbVec2s(left + w, top));
+    rect.push_back(SbVec2s(left + w, top + h));
+    rect.push_back(SbVec2s(left, top + h));
+
+    // Prefer the ID buffer to only select the visible facets. If the mesh is too
+    // large for it fall back to the OpenGL selection mode.
+    std::vector<unsigned long> faces;
+    if (!getVisibleFacetsOfPolygon(rect, region, camera, faces)) {
+        SbViewportRegion vp;
+        vp.setViewportPixels (x, y, w, h);
+        faces = getFacetsOfRegion(vp, region, camera);
+    }
 
     const Mesh::MeshObject& rMesh = static_cast<Mesh::Feature*>(pcObject)->Mesh.getValue();
     rMesh.addFacetsToSelection(faces);
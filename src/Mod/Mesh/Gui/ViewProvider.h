@@ -46,8 +46,10 @@ class SoCamera;
 class SoAction;
 class SbViewportRegion;
 class SbVec2f;
+class SbVec2s;
 class SbBox2s;
 class SbPlane;
+class QImage;
 
 namespace App {
   class Color;
@@ -160,6 +162,8 @@ public:
     std::vector<unsigned long> getFacetsOfRegion(const SbViewportRegion&, const SbViewportRegion&, SoCamera*) const;
     std::vector<unsigned long> getVisibleFacetsAfterZoom(const SbBox2s&, const SbViewportRegion&, SoCamera*) const;
     std::vector<unsigned long> getVisibleFacets(const SbViewportRegion&, SoCamera*) const;
+    bool getVisibleFacetsOfPolygon(const std::vector<SbVec2s>& picked, const SbViewportRegion&, SoCamera*,
+                                   std::vector<unsigned long>& indices) const;
     virtual void cutMesh(const std::vector<SbVec2f>& picked, const Base::ViewProjMethod& proj, SbBool inner);
     virtual void trimMesh(const std::vector<SbVec2f>& picked, const Base::ViewProjMethod& proj, SbBool inner);
     virtual void removeFacets(const std::vector<unsigned long>&);
@@ -197,6 +201,9 @@ protected:
     virtual SoShape* getShapeNode() const;
     virtual SoNode* getCoordNode() const;
 
+private:
+    bool renderFacetIds(const SbViewportRegion&, SoCamera*, QImage&) const;
+
 public:
     static void faceInfoCallback(void * ud, SoEventCallback * n);
     static void fillHoleCallback(void * ud, SoEventCallback * n);
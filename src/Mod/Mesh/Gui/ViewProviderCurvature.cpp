@@ -49,6 +49,8 @@
 # include <iomanip>
 # include <ios>
 
+#include <QtConcurrentMap>
+
 // Here the FreeCAD includes sorted by Base,App,Gui......
 #include <Base/Console.h>
 #include <Base/Parameter.h>
@@ -340,16 +342,31 @@ void ViewProviderMeshCurvature::setVertexCurvatureMode(int mode)
 
     // curvature values
     std::vector<float> fValues = pCurvInfo->getCurvature( mode ); 
-    unsigned long j=0;
-    for ( std::vector<float>::const_iterator jt = fValues.begin(); jt != fValues.end(); ++jt, j++ ) {
-        App::Color col = pcColorBar->getColor( *jt );
-        pcColorMat->diffuseColor.set1Value(j, SbColor(col.r, col.g, col.b));
-        if ( pcColorBar->isVisible( *jt ) ) {
-            pcColorMat->transparency.set1Value(j, 0.0f);
-        } else {
-            pcColorMat->transparency.set1Value(j, 0.8f);
+
+    // Map the values to colors in parallel and write them directly into the
+    // field arrays so that the nodes are notified only once
+    int numValues = static_cast<int>(fValues.size());
+    pcColorMat->diffuseColor.setNum(numValues);
+    pcColorMat->transparency.setNum(numValues);
+    SbColor* colors = pcColorMat->diffuseColor.startEditing();
+    float* transp = pcColorMat->transparency.startEditing();
+
+    const std::size_t blockSize = 4096;
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i = 0; i < fValues.size(); i += blockSize)
+        blocks.push_back(std::make_pair(i, std::min(i + blockSize, fValues.size())));
+
+    const Gui::SoFCColorBar* colorBar = pcColorBar;
+    QtConcurrent::blockingMap(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        for (std::size_t j = block.first; j < block.second; j++) {
+            App::Color col = colorBar->getColor( fValues[j] );
+            colors[j].setValue(col.r, col.g, col.b);
+            transp[j] = colorBar->isVisible( fValues[j] ) ? 0.0f : 0.8f;
         }
-    }
+    });
+
+    pcColorMat->transparency.finishEditing();
+    pcColorMat->diffuseColor.finishEditing();
 }
 
 QIcon ViewProviderMeshCurvature::getIcon() const
@@ -156,6 +156,9 @@ void ViewProviderMeshOrientation::showDefects(const std::vector<unsigned long>&
 
     pcCoords->point.deleteValues(0);
     pcCoords->point.setNum(3*inds.size());
+    SbVec3f* pts = pcCoords->point.startEditing();
+    pcFaces->numVertices.setNum(inds.size());
+    int32_t* vertices = pcFaces->numVertices.startEditing();
     MeshCore::MeshFacetIterator cF(rMesh);
     unsigned long i=0;
     unsigned long j=0;
@@ -165,11 +168,14 @@ void ViewProviderMeshOrientation::showDefects(const std::vector<unsigned long>&
             Base::Vector3f cP = cF->_aclPoints[k];
             // move a bit in opposite normal direction to overlay the original faces
             cP -= 0.001f * cF->GetNormal();
-            pcCoords->point.set1Value(i++,cP.x,cP.y,cP.z);
+            pts[i++].setValue(cP.x,cP.y,cP.z);
         }
-        pcFaces->numVertices.set1Value(j++, 3);
+        vertices[j++] = 3;
     }
 
+    pcCoords->point.finishEditing();
+    pcFaces->numVertices.finishEditing();
+
     setDisplayMaskMode("Face");
 }
 
@@ -223,18 +229,24 @@ void ViewProviderMeshNonManifolds::showDefects(const std::vector<unsigned long>&
 
     pcCoords->point.deleteValues(0);
     pcCoords->point.setNum(inds.size());
+    SbVec3f* pts = pcCoords->point.startEditing();
+    pcLines->numVertices.setNum(inds.size()/2);
+    int32_t* vertices = pcLines->numVertices.startEditing();
     MeshCore::MeshPointIterator cP(rMesh);
     unsigned long i=0;
     unsigned long j=0;
     for (std::vector<unsigned long>::const_iterator it = inds.begin(); it != inds.end(); ++it) {
         cP.Set(*it);
-        pcCoords->point.set1Value(i++,cP->x,cP->y,cP->z);
+        pts[i++].setValue(cP->x,cP->y,cP->z);
         ++it; // go to end point
         cP.Set(*it);
-        pcCoords->point.set1Value(i++,cP->x,cP->y,cP->z);
-        pcLines->numVertices.set1Value(j++, 2);
+        pts[i++].setValue(cP->x,cP->y,cP->z);
+        vertices[j++] = 2;
     }
 
+    pcCoords->point.finishEditing();
+    pcLines->numVertices.finishEditing();
+
     setDisplayMaskMode("Line");
 }
 
@@ -285,13 +297,16 @@ void ViewProviderMeshNonManifoldPoints::showDefects(const std::vector<unsigned l
     const MeshCore::MeshKernel & rMesh = f->Mesh.getValue().getKernel();
     pcCoords->point.deleteValues(0);
     pcCoords->point.setNum(inds.size());
+    SbVec3f* pts = pcCoords->point.startEditing();
     MeshCore::MeshPointIterator cP(rMesh);
     unsigned long i = 0;
     for ( std::vector<unsigned long>::const_iterator it = inds.begin(); it != inds.end(); ++it ) {
         cP.Set(*it);
-        pcCoords->point.set1Value(i++,cP->x,cP->y,cP->z);
+        pts[i++].setValue(cP->x,cP->y,cP->z);
     }
 
+    pcCoords->point.finishEditing();
+
     setDisplayMaskMode("Point");
 }
 
@@ -350,6 +365,9 @@ void ViewProviderMeshDuplicatedFaces::showDefects(const std::vector<unsigned lon
 
     pcCoords->point.deleteValues(0);
     pcCoords->point.setNum(3*inds.size());
+    SbVec3f* pts = pcCoords->point.startEditing();
+    pcFaces->numVertices.setNum(inds.size());
+    int32_t* vertices = pcFaces->numVertices.startEditing();
     MeshCore::MeshFacetIterator cF(rMesh);
     unsigned long i=0;
     unsigned long j=0;
@@ -359,11 +377,14 @@ void ViewProviderMeshDuplicatedFaces::showDefects(const std::vector<unsigned lon
             Base::Vector3f cP = cF->_aclPoints[k];
             // move a bit in normal direction to overlay the original faces
             cP += 0.001f * cF->GetNormal();
-            pcCoords->point.set1Value(i++,cP.x,cP.y,cP.z);
+            pts[i++].setValue(cP.x,cP.y,cP.z);
         }
-        pcFaces->numVertices.set1Value(j++, 3);
+        vertices[j++] = 3;
     }
 
+    pcCoords->point.finishEditing();
+    pcFaces->numVertices.finishEditing();
+
     setDisplayMaskMode("Face");
 }
 
@@ -414,13 +435,16 @@ void ViewProviderMeshDuplicatedPoints::showDefects(const std::vector<unsigned lo
     const MeshCore::MeshKernel & rMesh = f->Mesh.getValue().getKernel();
     pcCoords->point.deleteValues(0);
     pcCoords->point.setNum(inds.size());
+    SbVec3f* pts = pcCoords->point.startEditing();
     MeshCore::MeshPointIterator cP(rMesh);
     unsigned long i = 0;
     for ( std::vector<unsigned long>::const_iterator it = inds.begin(); it != inds.end(); ++it ) {
         cP.Set(*it);
-        pcCoords->point.set1Value(i++,cP->x,cP->y,cP->z);
+        pts[i++].setValue(cP->x,cP->y,cP->z);
     }
 
+    pcCoords->point.finishEditing();
+
     setDisplayMaskMode("Point");
 }
 
@@ -472,6 +496,9 @@ void ViewProviderMeshDegenerations::showDefects(const std::vector<unsigned long>
 
     pcCoords->point.deleteValues(0);
     pcCoords->point.setNum(2*inds.size());
+    SbVec3f* pts = pcCoords->point.startEditing();
+    pcLines->numVertices.setNum(inds.size());
+    int32_t* vertices = pcLines->numVertices.startEditing();
     MeshCore::MeshFacetIterator cF(rMesh);
     unsigned long i=0;
     unsigned long j=0;
@@ -488,20 +515,20 @@ void ViewProviderMeshDegenerations::showDefects(const std::vector<unsigned long>
             Base::Vector3f cP1, cP2;
             cP1.Set(rE1.x+eps,rE1.y+eps,rE1.z+eps);
             cP2.Set(rE2.x-eps,rE2.y-eps,rE2.z-eps);
-            pcCoords->point.set1Value(i++,cP1.x,cP1.y,cP1.z);
-            pcCoords->point.set1Value(i++,cP2.x,cP2.y,cP2.z);
+            pts[i++].setValue(cP1.x,cP1.y,cP1.z);
+            pts[i++].setValue(cP2.x,cP2.y,cP2.z);
         }
         else if (rE0 == rE1) {
-            pcCoords->point.set1Value(i++,rE1.x,rE1.y,rE1.z);
-            pcCoords->point.set1Value(i++,rE2.x,rE2.y,rE2.z);
+            pts[i++].setValue(rE1.x,rE1.y,rE1.z);
+            pts[i++].setValue(rE2.x,rE2.y,rE2.z);
         }
         else if (rE1 == rE2) {
-            pcCoords->point.set1Value(i++,rE2.x,rE2.y,rE2.z);
-            pcCoords->point.set1Value(i++,rE0.x,rE0.y,rE0.z);
+            pts[i++].setValue(rE2.x,rE2.y,rE2.z);
+            pts[i++].setValue(rE0.x,rE0.y,rE0.z);
         }
         else if (rE2 == rE0) {
-            pcCoords->point.set1Value(i++,rE0.x,rE0.y,rE0.z);
-            pcCoords->point.set1Value(i++,rE1.x,rE1.y,rE1.z);
+            pts[i++].setValue(rE0.x,rE0.y,rE0.z);
+            pts[i++].setValue(rE1.x,rE1.y,rE1.z);
         }
         else {
             for (int j=0; j<3; j++) {
@@ -510,16 +537,19 @@ void ViewProviderMeshDegenerations::showDefects(const std::vector<unsigned long>
 
                 // adjust the neighbourhoods and point indices
                 if (cVec1 * cVec2 < 0.0f) {
-                    pcCoords->point.set1Value(i++,cF->_aclPoints[(j+1)%3].x,cF->_aclPoints[(j+1)%3].y,cF->_aclPoints[(j+1)%3].z);
-                    pcCoords->point.set1Value(i++,cF->_aclPoints[(j+2)%3].x,cF->_aclPoints[(j+2)%3].y,cF->_aclPoints[(j+2)%3].z);
+                    pts[i++].setValue(cF->_aclPoints[(j+1)%3].x,cF->_aclPoints[(j+1)%3].y,cF->_aclPoints[(j+1)%3].z);
+                    pts[i++].setValue(cF->_aclPoints[(j+2)%3].x,cF->_aclPoints[(j+2)%3].y,cF->_aclPoints[(j+2)%3].z);
                     break;
                 }
             }
         }
 
-        pcLines->numVertices.set1Value(j++, 2);
+        vertices[j++] = 2;
     }
 
+    pcCoords->point.finishEditing();
+    pcLines->numVertices.finishEditing();
+
     setDisplayMaskMode("Line");
 }
 
@@ -579,6 +609,9 @@ void ViewProviderMeshIndices::showDefects(const std::vector<unsigned long>& inds
     if (!inds.empty()) {
         pcCoords->point.deleteValues(0);
         pcCoords->point.setNum(3*inds.size());
+        SbVec3f* pts = pcCoords->point.startEditing();
+        pcFaces->numVertices.setNum(inds.size());
+        int32_t* vertices = pcFaces->numVertices.startEditing();
         MeshCore::MeshFacetIterator cF(rMesh);
         unsigned long i=0;
         unsigned long j=0;
@@ -588,11 +621,14 @@ void ViewProviderMeshIndices::showDefects(const std::vector<unsigned long>& inds
                 Base::Vector3f cP = cF->_aclPoints[k];
                 // move a bit in opposite normal direction to overlay the original faces
                 cP -= 0.001f * cF->GetNormal();
-                pcCoords->point.set1Value(i++,cP.x,cP.y,cP.z);
+                pts[i++].setValue(cP.x,cP.y,cP.z);
             }
-            pcFaces->numVertices.set1Value(j++, 3);
+            vertices[j++] = 3;
         }
 
+        pcCoords->point.finishEditing();
+        pcFaces->numVertices.finishEditing();
+
         setDisplayMaskMode("Face");
     }
 }
@@ -659,14 +695,20 @@ void ViewProviderMeshSelfIntersections::showDefects(const std::vector<unsigned l
 
     pcCoords->point.deleteValues(0);
     pcCoords->point.setNum(2*lines.size());
+    SbVec3f* pts = pcCoords->point.startEditing();
+    pcLines->numVertices.setNum(lines.size());
+    int32_t* vertices = pcLines->numVertices.startEditing();
     unsigned long i=0;
     unsigned long j=0;
     for (std::vector<std::pair<Base::Vector3f, Base::Vector3f> >::const_iterator it = lines.begin(); it != lines.end(); ++it) {
-        pcCoords->point.set1Value(i++,it->first.x,it->first.y,it->first.z);
-        pcCoords->point.set1Value(i++,it->second.x,it->second.y,it->second.z);
-        pcLines->numVertices.set1Value(j++, 2);
+        pts[i++].setValue(it->first.x,it->first.y,it->first.z);
+        pts[i++].setValue(it->second.x,it->second.y,it->second.z);
+        vertices[j++] = 2;
     }
 
+    pcCoords->point.finishEditing();
+    pcLines->numVertices.finishEditing();
+
     setDisplayMaskMode("Line");
 }
 
@@ -725,6 +767,9 @@ void ViewProviderMeshFolds::showDefects(const std::vector<unsigned long>& inds)
 
     pcCoords->point.deleteValues(0);
     pcCoords->point.setNum(3*inds.size());
+    SbVec3f* pts = pcCoords->point.startEditing();
+    pcFaces->numVertices.setNum(inds.size());
+    int32_t* vertices = pcFaces->numVertices.startEditing();
     MeshCore::MeshFacetIterator cF(rMesh);
     unsigned long i=0;
     unsigned long j=0;
@@ -734,10 +779,13 @@ void ViewProviderMeshFolds::showDefects(const std::vector<unsigned long>& inds)
             Base::Vector3f cP = cF->_aclPoints[k];
             // move a bit in normal direction to overlay the original faces
             cP += 0.001f * cF->GetNormal();
-            pcCoords->point.set1Value(i++,cP.x,cP.y,cP.z);
+            pts[i++].setValue(cP.x,cP.y,cP.z);
         }
-        pcFaces->numVertices.set1Value(j++, 3);
+        vertices[j++] = 3;
     }
 
+    pcCoords->point.finishEditing();
+    pcFaces->numVertices.finishEditing();
+
     setDisplayMaskMode("Face");
 }
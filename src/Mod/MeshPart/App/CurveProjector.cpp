@@ -43,8 +43,13 @@
 # include <BRep_Tool.hxx>
 # include <GeomAPI_IntCS.hxx>
 # include <Standard_Failure.hxx>
+# include <numeric>
 #endif
 
+#include <QFuture>
+#include <QThread>
+#include <QtConcurrentMap>
+
 
 #include "MeshAlgos.h"
 #include "CurveProjector.h"
@@ -53,6 +58,7 @@
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
 #include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
 #include <Mod/Mesh/App/Core/Projection.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Mesh.h>
@@ -849,10 +855,7 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
                                    float tolerance,
                                    std::vector<Base::Vector3f>& pointsOut) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
+    MeshCore::MeshFacetBVH cBVH(_rcMesh);
 
     // get all boundary points and edges of the mesh
     std::vector<Base::Vector3f> boundaryPoints;
@@ -860,7 +863,7 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
 
     const MeshCore::MeshFacetArray& facets = _rcMesh.GetFacets();
     const MeshCore::MeshPointArray& points = _rcMesh.GetPoints();
-    for (auto it : facets) {
+    for (const auto& it : facets) {
         for (int i=0; i<3; i++) {
             if (!it.HasNeighbour(i)) {
                 boundaryPoints.push_back(points[it._aulPoints[i]]);
@@ -874,151 +877,179 @@ void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
         }
     }
 
-    Base::SequencerLauncher seq( "Project points on mesh", pointsIn.size() );
-
-    for (auto it : pointsIn) {
-        Base::Vector3f result;
+    // projects a single point, returns false if it can't be projected
+    auto projectPoint = [&](const Base::Vector3f& it, Base::Vector3f& result) -> bool {
         unsigned long index;
-        if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
+        if (cBVH.NearestFacetOnRay(it, dir, result, index)) {
             MeshCore::MeshGeomFacet geomFacet = _rcMesh.GetFacet(index);
             if (tolerance > 0 && geomFacet.IntersectPlaneWithLine(it, dir, result)) {
-                if (geomFacet.IsPointOfFace(result, tolerance))
-                    pointsOut.push_back(result);
-            }
-            else {
-                pointsOut.push_back(result);
+                return geomFacet.IsPointOfFace(result, tolerance);
             }
+            return true;
         }
-        else {
-            // go through the boundary points and check if the point can be directly projected
-            // onto one of them
-            auto boundaryPnt = std::find_if(boundaryPoints.begin(), boundaryPoints.end(),
-                                            [&it, &dir](const Base::Vector3f& pnt)->bool {
-                Base::Vector3f vec = pnt - it;
-                float angle = vec.GetAngle(dir);
-                return angle < 1e-6f;
-            });
-
-            if (boundaryPnt != boundaryPoints.end()) {
-                pointsOut.push_back(*boundaryPnt);
-            }
-            else {
-                // go through the boundary edges and check if the point can be directly projected
-                // onto one of them
-                Base::Vector3f result1, result2;
-                for (auto jt : boundaryEdges) {
-                    jt.ClosestPointsToLine(it, dir, result1, result2);
-                    float dot = (result1-jt._aclPoints[0]).Dot(result1-jt._aclPoints[1]);
-                    //float distance = Base::Distance(result1, result2);
-                    Base::Vector3f vec = result1 - it;
-                    float angle = vec.GetAngle(dir);
-                    if (dot <= 0 && angle < 1e-6f) {
-                        pointsOut.push_back(result1);
-                        break;
-                    }
-                }
+
+        // go through the boundary points and check if the point can be directly projected
+        // onto one of them
+        auto boundaryPnt = std::find_if(boundaryPoints.begin(), boundaryPoints.end(),
+                                        [&it, &dir](const Base::Vector3f& pnt)->bool {
+            Base::Vector3f vec = pnt - it;
+            float angle = vec.GetAngle(dir);
+            return angle < 1e-6f;
+        });
+
+        if (boundaryPnt != boundaryPoints.end()) {
+            result = *boundaryPnt;
+            return true;
+        }
+
+        // go through the boundary edges and check if the point can be directly projected
+        // onto one of them
+        Base::Vector3f result1, result2;
+        for (const auto& jt : boundaryEdges) {
+            jt.ClosestPointsToLine(it, dir, result1, result2);
+            float dot = (result1-jt._aclPoints[0]).Dot(result1-jt._aclPoints[1]);
+            //float distance = Base::Distance(result1, result2);
+            Base::Vector3f vec = result1 - it;
+            float angle = vec.GetAngle(dir);
+            if (dot <= 0 && angle < 1e-6f) {
+                result = result1;
+                return true;
             }
         }
 
-        seq.next();
+        return false;
+    };
+
+    // The points are projected in parallel, each one into its own slot to keep the order
+    std::vector<Base::Vector3f> results(pointsIn.size());
+    std::vector<char> projected(pointsIn.size(), 0);
+    std::vector<std::size_t> indices(pointsIn.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    Base::ParallelSequencerLauncher seq( "Project points on mesh", pointsIn.size() );
+    QFuture<void> future = QtConcurrent::map(indices, [&](std::size_t index) {
+        if (seq.next())
+            projected[index] = projectPoint(pointsIn[index], results[index]);
+    });
+
+    while (!future.isFinished()) {
+        seq.update();
+        QThread::msleep(20);
+    }
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        if (projected[i])
+            pointsOut.push_back(results[i]);
     }
 }
 
-void MeshProjection::projectParallelToMesh (const TopoDS_Shape &aShape, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const
+void MeshProjection::projectPointsToMesh(const std::vector<PolyLine>& aPolyLines,
+                                         const Base::Vector3f& dir,
+                                         std::vector< std::vector<HitPoint> >& rHitPoints) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
-    TopExp_Explorer Ex;
-
-    int iCnt=0;
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next())
-        iCnt++;
+    MeshCore::MeshFacetBVH cBVH(_rcMesh);
+
+    // All points are cast in blocks of fixed size so that the threads get an even share
+    // of work, no matter how the points are distributed over the polylines
+    std::vector<std::size_t> offsets;
+    offsets.reserve(aPolyLines.size() + 1);
+    offsets.push_back(0);
+    for (const auto& it : aPolyLines)
+        offsets.push_back(offsets.back() + it.points.size());
+
+    std::size_t numPoints = offsets.back();
+    std::vector<HitPoint> hits(numPoints);
+    std::vector<char> hit(numPoints, 0);
+
+    const std::size_t blockSize = 256;
+    std::vector<std::pair<std::size_t, std::size_t> > blocks;
+    for (std::size_t i = 0; i < numPoints; i += blockSize)
+        blocks.emplace_back(i, std::min<std::size_t>(i + blockSize, numPoints));
+
+    Base::ParallelSequencerLauncher seq( "Project curve on mesh", blocks.size() );
+    QFuture<void> future = QtConcurrent::map(blocks, [&](const std::pair<std::size_t, std::size_t>& block) {
+        if (!seq.next())
+            return;
+        // the polyline of the first point of the block
+        std::size_t poly = std::upper_bound(offsets.begin(), offsets.end(), block.first) - offsets.begin() - 1;
+        for (std::size_t i = block.first; i < block.second; i++) {
+            while (i >= offsets[poly+1])
+                poly++;
+            const Base::Vector3f& pnt = aPolyLines[poly].points[i - offsets[poly]];
+            hit[i] = cBVH.NearestFacetOnRay(pnt, dir, hits[i].cPt, hits[i].uFacet);
+        }
+    });
 
-    Base::SequencerLauncher seq( "Project curve on mesh", iCnt );
+    while (!future.isFinished()) {
+        seq.update();
+        QThread::msleep(20);
+    }
 
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        std::vector<Base::Vector3f> points;
-        discretize(aEdge, points, 5);
-
-        typedef std::pair<Base::Vector3f, unsigned long> HitPoint;
-        std::vector<HitPoint> hitPoints;
-        typedef std::pair<HitPoint, HitPoint> HitPoints;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            unsigned long index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size()-2];
-                    HitPoint p2 = hitPoints[hitPoints.size()-1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
-            }
+    rHitPoints.resize(aPolyLines.size());
+    for (std::size_t i = 0; i < aPolyLines.size(); i++) {
+        std::vector<HitPoint>& polyHits = rHitPoints[i];
+        polyHits.clear();
+        for (std::size_t j = offsets[i]; j < offsets[i+1]; j++) {
+            if (hit[j])
+                polyHits.push_back(hits[j]);
         }
+    }
+}
 
-        MeshCore::MeshProjection meshProjection(_rcMesh);
+void MeshProjection::projectParallelToMesh (const TopoDS_Shape &aShape, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const
+{
+    std::vector<PolyLine> polylines;
+    for (TopExp_Explorer Ex(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
+        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
         PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid, it.first.first, it.first.second,
-                                                 it.second.first, it.second.second, dir, points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
-            }
-        }
-        rPolyLines.push_back(polyline);
-
-        seq.next();
+        discretize(aEdge, polyline.points, 5);
+        polylines.push_back(std::move(polyline));
     }
+
+    projectParallelToMesh(polylines, dir, rPolyLines);
 }
 
 void MeshProjection::projectParallelToMesh (const std::vector<PolyLine> &aEdges, const Base::Vector3f& dir, std::vector<PolyLine>& rPolyLines) const
 {
+    // the hit points of all edges are searched at once
+    std::vector< std::vector<HitPoint> > hitPoints;
+    projectPointsToMesh(aEdges, dir, hitPoints);
+
     // calculate the average edge length and create a grid
     MeshAlgorithm clAlg(_rcMesh);
     float fAvgLen = clAlg.GetAverageEdgeLength();
     MeshFacetGrid cGrid(_rcMesh, 5.0f*fAvgLen);
 
-    Base::SequencerLauncher seq( "Project curve on mesh", aEdges.size() );
-
-    for (auto it : aEdges) {
-        std::vector<Base::Vector3f> points = it.points;
-
-        typedef std::pair<Base::Vector3f, unsigned long> HitPoint;
-        std::vector<HitPoint> hitPoints;
-        typedef std::pair<HitPoint, HitPoint> HitPoints;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            unsigned long index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size()-2];
-                    HitPoint p2 = hitPoints[hitPoints.size()-1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
-            }
-        }
+    // connect two consecutive hit points of an edge by the section curve with the mesh
+    std::vector<PolyLine> results(aEdges.size());
+    std::vector<std::size_t> indices(aEdges.size());
+    std::iota(indices.begin(), indices.end(), 0);
 
+    Base::ParallelSequencerLauncher seq( "Project curve on mesh", aEdges.size() );
+    QFuture<void> future = QtConcurrent::map(indices, [&](std::size_t index) {
+        if (!seq.next())
+            return;
+
+        const std::vector<HitPoint>& hits = hitPoints[index];
         MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
+        PolyLine& polyline = results[index];
+        std::vector<Base::Vector3f> points;
+        for (std::size_t i = 1; i < hits.size(); i++) {
             points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid, it.first.first, it.first.second,
-                                                 it.second.first, it.second.second, dir, points)) {
+            if (meshProjection.projectLineOnMesh(cGrid, hits[i-1].cPt, hits[i-1].uFacet,
+                                                 hits[i].cPt, hits[i].uFacet, dir, points)) {
                 polyline.points.insert(polyline.points.end(), points.begin(), points.end());
             }
         }
-        rPolyLines.push_back(polyline);
+    });
 
-        seq.next();
+    while (!future.isFinished()) {
+        seq.update();
+        QThread::msleep(20);
     }
+
+    rPolyLines.insert(rPolyLines.end(), std::make_move_iterator(results.begin()),
+                      std::make_move_iterator(results.end()));
 }
 
 void MeshProjection::projectEdgeToEdge( const TopoDS_Edge &aEdge, float fMaxDist, const MeshFacetGrid& rGrid,
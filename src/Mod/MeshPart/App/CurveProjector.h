@@ -174,6 +174,11 @@ public:
     {
         std::vector<Base::Vector3f> points;
     };
+    struct HitPoint
+    {
+        Base::Vector3f cPt; /**< Projected point on the mesh */
+        unsigned long uFacet; /**< Index of the facet the point lies on */
+    };
 
     /// Construction
     MeshProjection(const MeshKernel& rMesh);
@@ -208,6 +213,14 @@ public:
      */
     void projectOnMesh(const std::vector<Base::Vector3f>& pointsIn, const Base::Vector3f& dir,
                        float tolerance, std::vector<Base::Vector3f>& pointsOut) const;
+    /**
+     * Projects the points of all polylines \a aPolyLines along \a dir onto the mesh in one go.
+     * The rays are cast against a bounding volume hierarchy of the mesh and the points are
+     * processed in parallel. The hit points of a polyline are saved to the element of
+     * \a rHitPoints with the same index, points that miss the mesh are skipped.
+     */
+    void projectPointsToMesh(const std::vector<PolyLine>& aPolyLines, const Base::Vector3f& dir,
+                             std::vector< std::vector<HitPoint> >& rHitPoints) const;
     /**
      * Project all edges of the shape onto the mesh using parallel projection.
      */
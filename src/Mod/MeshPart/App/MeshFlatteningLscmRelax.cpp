@@ -35,6 +35,8 @@
 #include <vector>
 #include <tuple>
 #include <array>
+#include <thread>
+#include <functional>
 
 #ifndef M_PI
 #define M_PI    3.14159265358979323846f
@@ -50,6 +52,25 @@ namespace lscmrelax
 typedef Eigen::Triplet<double> trip;
 typedef Eigen::SparseMatrix<double> spMat;
 
+// calls func(begin, end) for consecutive ranges of [0, count) on all cores
+static void parallel_for(long count, const std::function<void(long, long)>& func)
+{
+    long num_threads = std::max<long>(1, std::thread::hardware_concurrency());
+    num_threads = std::min(num_threads, count / 1000 + 1);
+    if (num_threads < 2)
+    {
+        func(0, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    long chunk = (count + num_threads - 1) / num_threads;
+    for (long begin = 0; begin < count; begin += chunk)
+        threads.emplace_back(func, begin, std::min(begin + chunk, count));
+    for (auto& thread: threads)
+        thread.join();
+}
+
 
 
 ColMat<double, 2> map_to_2D(ColMat<double, 3> points)
@@ -148,64 +169,83 @@ LscmRelax::LscmRelax(
 void LscmRelax::relax(double weight)
 {
     ColMat<double, 3> d_q_l_g = this->q_l_m - this->q_l_g;
-    // for every triangle
-    Eigen::Matrix<double, 3, 6> B;
-    Eigen::Matrix<double, 2, 2> T;
-    Eigen::Matrix<double, 6, 6> K_m;
-    Eigen::Matrix<double, 6, 1> u_m, rhs_m;
     Eigen::VectorXd rhs(this->vertices.cols() * 2 + 3);
     if (this->sol.size() == 0)
         this->sol.Zero(this->vertices.cols() * 2 + 3);
     spMat K_g(this->vertices.cols() * 2 + 3, this->vertices.cols() * 2 + 3);
-    std::vector<trip> K_g_triplets;
-    Vector2 v1, v2, v3, v12, v23, v31;
-    long row_pos, col_pos;
-    double A;
+
+    // every triangle writes its 36 triplets and its part of the rhs to its own slots,
+    // so the element matrices can be computed in parallel
+    const long trip_per_triangle = 36;
+    std::vector<trip> K_g_triplets(this->triangles.cols() * trip_per_triangle);
+    ColMat<double, 6> rhs_elements(this->triangles.cols(), 6);
 
     rhs.setZero();
 
-    for (long i=0; i<this->triangles.cols(); i++)
+    // for every triangle
+    parallel_for(this->triangles.cols(), [&](long begin, long end)
     {
-        // 1: construct B-mat in m-system
-        v1 = this->flat_vertices.col(this->triangles(0, i));
-        v2 = this->flat_vertices.col(this->triangles(1, i));
-        v3 = this->flat_vertices.col(this->triangles(2, i));
-        v12 = v2 - v1;
-        v23 = v3 - v2;
-        v31 = v1 - v3;
-        B << -v23.y(),   0,        -v31.y(),   0,        -v12.y(),   0,
-              0,         v23.x(),   0,         v31.x(),   0,         v12.x(),
-             -v23.x(),   v23.y(),  -v31.x(),   v31.y(),  -v12.x(),   v12.y();
-        T << v12.x(), -v12.y(),
-             v12.y(), v12.x();
-        T /= v12.norm();
-        A = std::abs(this->q_l_m(i, 0) * this->q_l_m(i, 2) / 2);
-        B /= A * 2; // (2*area)
-
-        // 2: sigma due dqlg in m-system
-        u_m << Vector2(0, 0), T * Vector2(d_q_l_g(i, 0), 0), T * Vector2(d_q_l_g(i, 1), d_q_l_g(i, 2));
-
-        // 3: rhs_m = B.T * C * B * dqlg_m
-        //    K_m = B.T * C * B
-        rhs_m = B.transpose() * this->C * B * u_m * A;
-        K_m = B.transpose() * this->C * B * A;
-
-        // 5: add to rhs_g, K_g
-        for (int j=0; j < 3; j++)
+        Eigen::Matrix<double, 3, 6> B;
+        Eigen::Matrix<double, 2, 2> T;
+        Eigen::Matrix<double, 6, 6> K_m;
+        Eigen::Matrix<double, 6, 1> u_m, rhs_m;
+        Vector2 v1, v2, v3, v12, v23, v31;
+        long row_pos, col_pos;
+        double A;
+        for (long i=begin; i<end; i++)
         {
-            row_pos = this->triangles(j, i);
-            rhs[row_pos * 2]     += rhs_m[j * 2];
-            rhs[row_pos * 2 + 1] += rhs_m[j * 2 +1];
-            for (int k=0; k < 3; k++)
+            // 1: construct B-mat in m-system
+            v1 = this->flat_vertices.col(this->triangles(0, i));
+            v2 = this->flat_vertices.col(this->triangles(1, i));
+            v3 = this->flat_vertices.col(this->triangles(2, i));
+            v12 = v2 - v1;
+            v23 = v3 - v2;
+            v31 = v1 - v3;
+            B << -v23.y(),   0,        -v31.y(),   0,        -v12.y(),   0,
+                  0,         v23.x(),   0,         v31.x(),   0,         v12.x(),
+                 -v23.x(),   v23.y(),  -v31.x(),   v31.y(),  -v12.x(),   v12.y();
+            T << v12.x(), -v12.y(),
+                 v12.y(), v12.x();
+            T /= v12.norm();
+            A = std::abs(this->q_l_m(i, 0) * this->q_l_m(i, 2) / 2);
+            B /= A * 2; // (2*area)
+
+            // 2: sigma due dqlg in m-system
+            u_m << Vector2(0, 0), T * Vector2(d_q_l_g(i, 0), 0), T * Vector2(d_q_l_g(i, 1), d_q_l_g(i, 2));
+
+            // 3: rhs_m = B.T * C * B * dqlg_m
+            //    K_m = B.T * C * B
+            rhs_m = B.transpose() * this->C * B * u_m * A;
+            K_m = B.transpose() * this->C * B * A;
+
+            // 5: add to rhs_g, K_g
+            rhs_elements.row(i) = rhs_m.transpose();
+            trip* triplet = &K_g_triplets[i * trip_per_triangle];
+            for (int j=0; j < 3; j++)
             {
-                col_pos = this->triangles(k, i);
-                K_g_triplets.push_back(trip(row_pos * 2,     col_pos * 2,        K_m(j * 2,      k * 2)));
-                K_g_triplets.push_back(trip(row_pos * 2 + 1, col_pos * 2,        K_m(j * 2 + 1,  k * 2)));
-                K_g_triplets.push_back(trip(row_pos * 2 + 1, col_pos * 2 + 1,    K_m(j * 2 + 1,  k * 2 + 1)));
-                K_g_triplets.push_back(trip(row_pos * 2,     col_pos * 2 + 1,    K_m(j * 2,      k * 2 + 1)));
-                // we don't have to fill all because the matrix is symmetric.
+                row_pos = this->triangles(j, i);
+                for (int k=0; k < 3; k++)
+                {
+                    col_pos = this->triangles(k, i);
+                    *triplet++ = trip(row_pos * 2,     col_pos * 2,        K_m(j * 2,      k * 2));
+                    *triplet++ = trip(row_pos * 2 + 1, col_pos * 2,        K_m(j * 2 + 1,  k * 2));
+                    *triplet++ = trip(row_pos * 2 + 1, col_pos * 2 + 1,    K_m(j * 2 + 1,  k * 2 + 1));
+                    *triplet++ = trip(row_pos * 2,     col_pos * 2 + 1,    K_m(j * 2,      k * 2 + 1));
+                    // we don't have to fill all because the matrix is symmetric.
+                }
             }
         }
+    });
+
+    // the rhs is summed up in a fixed order to keep the result independent of the threads
+    for (long i=0; i<this->triangles.cols(); i++)
+    {
+        for (int j=0; j < 3; j++)
+        {
+            long row_pos = this->triangles(j, i);
+            rhs[row_pos * 2]     += rhs_elements(i, j * 2);
+            rhs[row_pos * 2 + 1] += rhs_elements(i, j * 2 + 1);
+        }
     }
     // FIXING SOME PINS:
     // - if there are no pins (or only one pin) selected solve the system without the nullspace solution.
@@ -251,6 +291,7 @@ void LscmRelax::relax(double weight)
     //     K_g_triplets.push_back(trip(i, i, 0.01));
 
     // lagrange multiplier
+    K_g_triplets.reserve(K_g_triplets.size() + this->flat_vertices.cols() * 8);
     for (long i=0; i < this->flat_vertices.cols() ; i++)
     {
         // fixing total ux
@@ -286,9 +327,15 @@ void LscmRelax::relax(double weight)
     // rhs +=  K_g * Eigen::VectorXd::Ones(K_g.rows());
     
     // solve linear system (privately store the value for guess in next step)
-    Eigen::SimplicialLDLT<spMat, Eigen::Lower> solver;
-    solver.compute(K_g);
-    this->sol = solver.solve(-rhs);
+    // the pattern of K_g only depends on the triangles, so reuse the symbolic factorization
+    // and the fill-reducing ordering of the previous steps and only redo the numerical part
+    if (!this->relax_solver || this->relax_solver->rows() != K_g.rows())
+    {
+        this->relax_solver = std::make_shared<relax_solver_type>();
+        this->relax_solver->analyzePattern(K_g);
+    }
+    this->relax_solver->factorize(K_g);
+    this->sol = this->relax_solver->solve(-rhs);
     this->set_shift(this->sol.head(this->vertices.cols() * 2) * weight);
     this->set_q_l_m();
 }
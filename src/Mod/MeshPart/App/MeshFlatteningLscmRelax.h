@@ -43,6 +43,7 @@
 
 #include <Eigen/Geometry>
 #include <Eigen/IterativeLinearSolvers>
+#include <Eigen/SparseCholesky>
 
 typedef Eigen::SparseMatrix<double> spMat;
 
@@ -87,6 +88,11 @@ private:
     Eigen::Matrix<double, 3, 3> C;
     Eigen::VectorXd sol;
 
+    // the stiffness matrix of relax() has the same sparsity pattern in every step,
+    // so the symbolic factorization is only done once
+    typedef Eigen::SimplicialLDLT<spMat, Eigen::Lower> relax_solver_type;
+    std::shared_ptr<relax_solver_type> relax_solver;
+
     std::vector<long> get_fem_fixed_pins();
     Eigen::MatrixXd get_nullspace();
 
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #include <algorithm>
+#include <unordered_map>
 #include "Mesher.h"
 
 #include <Base/Console.h>
@@ -189,7 +190,10 @@ Mesh::MeshObject* Mesher::createMesh() const
     if (method == Standard) {
         if (!shape.IsNull()) {
             BRepTools::Clean(shape);
-            BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+            // the faces are meshed in parallel after the shared edges are discretized,
+            // so the triangulations of neighbouring faces have the same boundary nodes
+            BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection,
+                                           /*isInParallel*/ true);
         }
 
         std::vector<Part::TopoShape::Domain> domains;
@@ -204,72 +208,44 @@ Mesh::MeshObject* Mesher::createMesh() const
 
         MeshCore::MeshFacetArray faces;
         std::size_t numTriangles = 0;
-        for (auto it : domains)
+        for (const auto& it : domains)
             numTriangles += it.facets.size();
         faces.reserve(numTriangles);
 
         std::set<Vertex> vertices;
-        Standard_Real x1, y1, z1;
-        Standard_Real x2, y2, z2;
-        Standard_Real x3, y3, z3;
+
+        // welds a point of a face triangulation with the points of the other faces
+        auto weldPoint = [&vertices](const Base::Vector3d& pnt) {
+            Vertex v(pnt.x, pnt.y, pnt.z);
+            std::set<Vertex>::iterator it = vertices.find(v);
+            if (it != vertices.end())
+                return it->i;
+            v.i = vertices.size();
+            vertices.insert(v);
+            return v.i;
+        };
 
         std::vector< std::vector<unsigned long> > meshSegments;
         std::size_t numMeshFaces = 0;
 
+        // the points of a face triangulation are unique, so each of them only has to be
+        // welded once and not for every triangle it belongs to
+        std::vector<Standard_Integer> pointIndex;
+
         for (std::size_t i = 0; i < domains.size(); ++i) {
             std::size_t numDomainFaces = 0;
             const Part::TopoShape::Domain& domain = domains[i];
+            pointIndex.assign(domain.points.size(), -1);
             for (std::size_t j = 0; j < domain.facets.size(); ++j) {
                 const Part::TopoShape::Facet& tria = domain.facets[j];
-                x1 = domain.points[tria.I1].x;
-                y1 = domain.points[tria.I1].y;
-                z1 = domain.points[tria.I1].z;
-
-                x2 = domain.points[tria.I2].x;
-                y2 = domain.points[tria.I2].y;
-                z2 = domain.points[tria.I2].z;
+                const uint32_t corners[3] = {tria.I1, tria.I2, tria.I3};
 
-                x3 = domain.points[tria.I3].x;
-                y3 = domain.points[tria.I3].y;
-                z3 = domain.points[tria.I3].z;
-
-                std::set<Vertex>::iterator it;
                 MeshCore::MeshFacet face;
-
-                // 1st vertex
-                Vertex v1(x1,y1,z1);
-                it = vertices.find(v1);
-                if (it == vertices.end()) {
-                    v1.i = vertices.size();
-                    face._aulPoints[0] = v1.i;
-                    vertices.insert(v1);
-                }
-                else {
-                    face._aulPoints[0] = it->i;
-                }
-
-                // 2nd vertex
-                Vertex v2(x2,y2,z2);
-                it = vertices.find(v2);
-                if (it == vertices.end()) {
-                    v2.i = vertices.size();
-                    face._aulPoints[1] = v2.i;
-                    vertices.insert(v2);
-                }
-                else {
-                    face._aulPoints[1] = it->i;
-                }
-
-                // 3rd vertex
-                Vertex v3(x3,y3,z3);
-                it = vertices.find(v3);
-                if (it == vertices.end()) {
-                    v3.i = vertices.size();
-                    face._aulPoints[2] = v3.i;
-                    vertices.insert(v3);
-                }
-                else {
-                    face._aulPoints[2] = it->i;
+                for (int k = 0; k < 3; ++k) {
+                    Standard_Integer& index = pointIndex[corners[k]];
+                    if (index < 0)
+                        index = weldPoint(domain.points[corners[k]]);
+                    face._aulPoints[k] = index;
                 }
 
                 // make sure that we don't insert invalid facets
@@ -292,7 +268,7 @@ Mesh::MeshObject* Mesher::createMesh() const
 
         MeshCore::MeshPointArray verts;
         verts.resize(vertices.size());
-        for (auto it : vertices)
+        for (const auto& it : vertices)
             verts[it.i] = it.toPoint();
 
         MeshCore::MeshKernel kernel;
@@ -302,7 +278,7 @@ Mesh::MeshObject* Mesher::createMesh() const
         meshdata->swap(kernel);
         if (createSegm) {
             int index = 0;
-            for (auto it : colorMap) {
+            for (const auto& it : colorMap) {
                 Mesh::Segment segm(meshdata, false);
                 for (auto jt : it.second) {
                     segm.addIndices(meshSegments[jt]);
@@ -318,7 +294,7 @@ Mesh::MeshObject* Mesher::createMesh() const
             }
         }
         else {
-            for (auto it : meshSegments) {
+            for (const auto& it : meshSegments) {
                 meshdata->addSegment(it);
             }
         }
@@ -497,7 +473,8 @@ Mesh::MeshObject* Mesher::createMesh() const
     faces.reserve(mesh->NbFaces());
 
     int index=0;
-    std::map<const SMDS_MeshNode*, int> mapNodeIndex;
+    std::unordered_map<const SMDS_MeshNode*, int> mapNodeIndex;
+    mapNodeIndex.reserve(mesh->NbNodes());
     for (;aNodeIter->more();) {
         const SMDS_MeshNode* aNode = aNodeIter->next();
         MeshCore::MeshPoint p;
@@ -88,10 +88,13 @@
 # include <GeomFill_SectionGenerator.hxx>
 # include <NCollection_List.hxx>
 # include <BRepFill_Filling.hxx>
+# include <BRepTools.hxx>
+# include <BRepBuilderAPI_Transform.hxx>
 #endif
 
 #include <cstdio>
 #include <fstream>
+#include <sstream>
 
 #include <CXX/Extensions.hxx>
 #include <CXX/Objects.hxx>
@@ -133,6 +136,7 @@
 #include "PartFeature.h"
 #include "PartPyCXX.h"
 #include "modelRefine.h"
+#include "Tools.h"
 
 #ifdef FCUseFreeType
 #  include "FT2FC.h"
@@ -348,6 +352,11 @@ public:
         add_varargs_method("read",&Module::read,
             "read(string) -- Load the file and return the shape."
         );
+        add_varargs_method("readBreps",&Module::readBreps,
+            "readBreps(list,[scale=1.0]) -- Create the shapes of a list of BREP strings.\n"
+            "The strings are read in parallel and the shapes scaled by the given factor,\n"
+            "strings that can't be read give a null shape."
+        );
         add_varargs_method("show",&Module::show,
             "show(shape,[string]) -- Add the shape to the active document or create one if no document exists."
         );
@@ -772,6 +781,58 @@ private:
         shape->read(EncodedName.c_str());
         return Py::asObject(new TopoShapePy(shape));
     }
+    Py::Object readBreps(const Py::Tuple& args)
+    {
+        PyObject *pcObj;
+        double factor = 1.0;
+        if (!PyArg_ParseTuple(args.ptr(), "O|d", &pcObj, &factor))
+            throw Py::Exception();
+
+        if (fabs(factor) < Precision::Confusion())
+            throw Py::ValueError("scale factor too small");
+
+        std::vector<std::string> breps;
+        Py::Sequence list(pcObj);
+        breps.reserve(list.size());
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+            Py::Object item(*it);
+            if (PyBytes_Check(item.ptr()))
+                breps.emplace_back(PyBytes_AsString(item.ptr()), PyBytes_Size(item.ptr()));
+            else
+                breps.push_back(Py::String(item).as_std_string("utf-8"));
+        }
+
+        gp_Trsf scl;
+        if (factor != 1.0)
+            scl.SetScale(gp_Pnt(0,0,0), factor);
+
+        // the shapes don't share any data, so they can be built at the same time
+        std::vector<TopoDS_Shape> shapes(breps.size());
+        Tools::parallelFor(breps.size(), [&](std::size_t i) {
+            try {
+                std::istringstream str(breps[i]);
+                BRep_Builder builder;
+                TopoDS_Shape shape;
+                BRepTools::Read(shape, str, builder);
+                if (!shape.IsNull() && factor != 1.0) {
+                    BRepBuilderAPI_Transform mkScale(scl);
+                    mkScale.Perform(shape, Standard_True);
+                    shape = mkScale.Shape();
+                }
+                shapes[i] = shape;
+            }
+            catch (Standard_Failure&) {
+                shapes[i].Nullify();
+            }
+            // free the string as soon as it is read
+            std::string().swap(breps[i]);
+        });
+
+        Py::List res;
+        for (auto &shape : shapes)
+            res.append(shape2pyshape(shape));
+        return res;
+    }
     Py::Object show(const Py::Tuple& args)
     {
         PyObject *pcObj = 0;
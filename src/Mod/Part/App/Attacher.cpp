@@ -58,6 +58,9 @@
 # include <GeomLib_IsPlanarSurface.hxx>
 # include <BRepLProp_SLProps.hxx>
 # include <GeomAPI_ProjectPointOnCurve.hxx>
+# include <climits>
+# include <mutex>
+# include <unordered_map>
 #endif
 
 #include "Attacher.h"
@@ -678,6 +681,86 @@ eRefType AttachEngine::getRefTypeByName(const std::string& typeName)
     throw AttachEngineException(errmsg.str());
 }
 
+namespace {
+/*!
+ * \brief The ShapePropsCache class keeps the inertial properties of the
+ * reference shapes, so that attachers sharing the same supports compute them
+ * only once. The entries are keyed by the shapes themselves, so a changed
+ * support shape never matches its old entries. The cache is cleared after the
+ * recompute of a document and when it grows too large.
+ */
+class ShapePropsCache
+{
+public:
+    enum Kind {
+        Linear = 0,
+        Surface,
+        Volume,
+        NumKinds
+    };
+
+    static ShapePropsCache& instance()
+    {
+        static ShapePropsCache cache;
+        return cache;
+    }
+
+    GProp_GProps get(const TopoDS_Shape& sh, Kind kind)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = props[kind].find(sh);
+            if (it != props[kind].end())
+                return it->second;
+        }
+
+        GProp_GProps gpr;
+        switch (kind) {
+        case Linear:
+            BRepGProp::LinearProperties(sh,gpr);
+            break;
+        case Surface:
+            BRepGProp::SurfaceProperties(sh,gpr);
+            break;
+        default:
+            BRepGProp::VolumeProperties(sh,gpr);
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (props[kind].size() >= maxEntries)
+            props[kind].clear();
+        props[kind].emplace(sh, gpr);
+        return gpr;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& map : props)
+            map.clear();
+    }
+
+private:
+    ShapePropsCache()
+    {
+        connRecomputed = App::GetApplication().signalRecomputed.connect(
+            [this](const App::Document&) { clear(); });
+    }
+
+    struct ShapeHasher {
+        std::size_t operator()(const TopoDS_Shape& sh) const {
+            return sh.HashCode(INT_MAX);
+        }
+    };
+
+    static const std::size_t maxEntries = 10000;
+    std::mutex mutex;
+    std::unordered_map<TopoDS_Shape, GProp_GProps, ShapeHasher> props[NumKinds];
+    boost::signals2::scoped_connection connRecomputed;
+};
+}
+
 GProp_GProps AttachEngine::getInertialPropsOfShape(const std::vector<const TopoDS_Shape*> &shapes)
 {
     //explode compounds
@@ -710,7 +793,7 @@ GProp_GProps AttachEngine::getInertialPropsOfShape(const std::vector<const TopoD
                 throw AttachEngineException("AttachEngine::getInertialPropsOfShape: provided shapes are incompatible (not only edges/wires)");
             if (sh.Infinite())
                 throw AttachEngineException("AttachEngine::getInertialPropsOfShape: infinite shape provided");
-            BRepGProp::LinearProperties(sh,gpr);
+            gpr = ShapePropsCache::instance().get(sh, ShapePropsCache::Linear);
             gpr_acc.Add(gpr);
         }
         return gpr_acc;
@@ -725,7 +808,7 @@ GProp_GProps AttachEngine::getInertialPropsOfShape(const std::vector<const TopoD
                 throw AttachEngineException("AttachEngine::getInertialPropsOfShape: provided shapes are incompatible (not only faces/shells)");
             if (sh.Infinite())
                 throw AttachEngineException("AttachEngine::getInertialPropsOfShape: infinite shape provided");
-            BRepGProp::SurfaceProperties(sh,gpr);
+            gpr = ShapePropsCache::instance().get(sh, ShapePropsCache::Surface);
             gpr_acc.Add(gpr);
         }
         return gpr_acc;
@@ -740,7 +823,7 @@ GProp_GProps AttachEngine::getInertialPropsOfShape(const std::vector<const TopoD
                 throw AttachEngineException("AttachEngine::getInertialPropsOfShape: provided shapes are incompatible (not only solids/compsolids)");
             if (sh.Infinite())
                 throw AttachEngineException("AttachEngine::getInertialPropsOfShape: infinite shape provided");
-            BRepGProp::VolumeProperties(sh,gpr);
+            gpr = ShapePropsCache::instance().get(sh, ShapePropsCache::Volume);
             gpr_acc.Add(gpr);
         }
         return gpr_acc;
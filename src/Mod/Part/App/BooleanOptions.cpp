@@ -0,0 +1,367 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cfloat>
+# include <thread>
+# include <vector>
+# include <Bnd_Box.hxx>
+# include <BRep_Builder.hxx>
+# include <BRepBndLib.hxx>
+# include <gp_Pnt.hxx>
+# include <gp_Vec.hxx>
+# include <Precision.hxx>
+# include <Standard_Failure.hxx>
+# include <TopExp.hxx>
+# include <TopoDS_Compound.hxx>
+# include <TopoDS_Iterator.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
+# include <TopTools_ListIteratorOfListOfShape.hxx>
+#endif
+
+#include <App/Application.h>
+#include <Base/Parameter.h>
+
+#include "BooleanOptions.h"
+#include "PropertyTopoShape.h"
+#include "Tools.h"
+
+using namespace Part;
+
+BooleanOptions::BooleanOptions()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
+    RunParallel = hGrp->GetBool("RunParallel", true);
+    UseOBB = hGrp->GetBool("UseOBB", false);
+    NonDestructive = hGrp->GetBool("NonDestructive", false);
+    long glue = hGrp->GetInt("Glue", GlueAuto);
+    Glue = (glue >= GlueOff && glue <= GlueFull) ? static_cast<GlueMode>(glue) : GlueAuto;
+    TreeFusionThreshold = static_cast<int>(hGrp->GetInt("TreeFusionThreshold", 8));
+}
+
+namespace {
+template <class BooleanOp>
+std::unique_ptr<BooleanOp> makeOperation(const BooleanOptions& options, const TopoDS_Shape& base, const TopoDS_Shape& tool)
+{
+#if OCC_VERSION_HEX >= 0x060900
+    std::unique_ptr<BooleanOp> mk(new BooleanOp());
+    TopTools_ListOfShape arguments, tools;
+    arguments.Append(base);
+    tools.Append(tool);
+    options.build(*mk, arguments, tools);
+#else
+    (void)options;
+    std::unique_ptr<BooleanOp> mk(new BooleanOp(base, tool));
+#endif
+    return mk;
+}
+}
+
+std::unique_ptr<BRepAlgoAPI_Fuse> BooleanOptions::fuse(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
+{
+    return makeOperation<BRepAlgoAPI_Fuse>(*this, base, tool);
+}
+
+std::unique_ptr<BRepAlgoAPI_Cut> BooleanOptions::cut(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
+{
+    return makeOperation<BRepAlgoAPI_Cut>(*this, base, tool);
+}
+
+std::unique_ptr<BRepAlgoAPI_Common> BooleanOptions::common(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
+{
+    return makeOperation<BRepAlgoAPI_Common>(*this, base, tool);
+}
+
+#if OCC_VERSION_HEX >= 0x060900
+void BooleanOptions::apply(BRepAlgoAPI_BuilderAlgo& mk, const TopTools_ListOfShape& shapes, Standard_Real fuzzy) const
+{
+    mk.SetRunParallel(RunParallel);
+#if OCC_VERSION_HEX >= 0x070000
+    mk.SetNonDestructive(NonDestructive);
+    switch (Glue) {
+    case GlueShift:
+        mk.SetGlue(BOPAlgo_GlueShift);
+        break;
+    case GlueFull:
+        mk.SetGlue(BOPAlgo_GlueFull);
+        break;
+    case GlueAuto:
+        if (canGlue(shapes, fuzzy))
+            mk.SetGlue(BOPAlgo_GlueShift);
+        break;
+    default:
+        break;
+    }
+#else
+    (void)shapes;
+    (void)fuzzy;
+#endif
+#if OCC_VERSION_HEX >= 0x070300
+    mk.SetUseOBB(UseOBB);
+#endif
+}
+
+void BooleanOptions::build(BRepAlgoAPI_BooleanOperation& mk, const TopTools_ListOfShape& arguments,
+                           const TopTools_ListOfShape& tools, Standard_Real fuzzy) const
+{
+    mk.SetArguments(arguments);
+    mk.SetTools(tools);
+    if (fuzzy > 0.0)
+        mk.SetFuzzyValue(fuzzy);
+
+    TopTools_ListOfShape shapes;
+    for (TopTools_ListIteratorOfListOfShape it(arguments); it.More(); it.Next())
+        shapes.Append(it.Value());
+    for (TopTools_ListIteratorOfListOfShape it(tools); it.More(); it.Next())
+        shapes.Append(it.Value());
+    apply(mk, shapes, fuzzy);
+    mk.Build();
+}
+#endif
+
+bool BooleanOptions::canGlue(const TopTools_ListOfShape& shapes, Standard_Real fuzzy)
+{
+    struct Box {
+        Standard_Real min[3], max[3], gap;
+    };
+
+    std::vector<Box> boxes;
+    for (TopTools_ListIteratorOfListOfShape it(shapes); it.More(); it.Next()) {
+        Bnd_Box bounds;
+        BRepBndLib::Add(it.Value(), bounds);
+        if (bounds.IsVoid())
+            continue;
+        Box box;
+        bounds.Get(box.min[0], box.min[1], box.min[2], box.max[0], box.max[1], box.max[2]);
+        box.gap = bounds.GetGap();
+        boxes.push_back(box);
+    }
+
+    if (boxes.size() < 2)
+        return false;
+
+    // sweep along the x axis so that only boxes overlapping in x are compared
+    std::sort(boxes.begin(), boxes.end(), [](const Box& a, const Box& b) {
+        return a.min[0] < b.min[0];
+    });
+
+    bool touching = false;
+    for (std::size_t i = 0; i < boxes.size(); i++) {
+        const Box& a = boxes[i];
+        for (std::size_t j = i + 1; j < boxes.size() && boxes[j].min[0] <= a.max[0]; j++) {
+            const Box& b = boxes[j];
+            // the boxes are enlarged by the tolerance of the shapes
+            Standard_Real tol = a.gap + b.gap + fuzzy + Precision::Confusion();
+            Standard_Real minOverlap = DBL_MAX;
+            for (int k = 0; k < 3; k++) {
+                Standard_Real overlap = std::min(a.max[k], b.max[k]) - std::max(a.min[k], b.min[k]);
+                minOverlap = std::min(minOverlap, overlap);
+            }
+            if (minOverlap < -tol)
+                continue; // disjoint
+            if (minOverlap > tol)
+                return false; // the shapes may interfere
+            touching = true;
+        }
+    }
+
+    return touching;
+}
+
+bool BooleanOptions::useFuseTree(std::size_t count) const
+{
+    return TreeFusionThreshold > 0 && count >= static_cast<std::size_t>(std::max(TreeFusionThreshold, 3));
+}
+
+namespace {
+struct FuseNode {
+    TopoDS_Shape shape;
+    Bnd_Box box;
+    gp_Pnt center;
+    /// the indices of the input shapes and the history of their faces in shape
+    std::vector<std::pair<std::size_t, ShapeHistory> > inputs;
+};
+
+/// Sorts the nodes like a k-d tree so that neighbours in the list are close in space
+void sortSpatially(std::vector<FuseNode>::iterator first, std::vector<FuseNode>::iterator last)
+{
+    if (last - first < 3)
+        return;
+
+    Bnd_Box centers;
+    for (auto it = first; it != last; ++it)
+        centers.Add(it->center);
+    Standard_Real xmin, ymin, zmin, xmax, ymax, zmax;
+    centers.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+    int axis = 1;
+    if (ymax - ymin > xmax - xmin)
+        axis = 2;
+    if (zmax - zmin > std::max(xmax - xmin, ymax - ymin))
+        axis = 3;
+
+    auto mid = first + (last - first) / 2;
+    std::nth_element(first, mid, last, [axis](const FuseNode& a, const FuseNode& b) {
+        return a.center.Coord(axis) < b.center.Coord(axis);
+    });
+    sortSpatially(first, mid);
+    sortSpatially(mid, last);
+}
+
+/// Maps the faces of \a oldS to the faces of \a newS, \a mk is null if they are unchanged
+ShapeHistory faceHistory(BRepBuilderAPI_MakeShape* mk, const TopoDS_Shape& newS, const TopoDS_Shape& oldS)
+{
+    ShapeHistory history;
+    history.type = TopAbs_FACE;
+
+    TopTools_IndexedMapOfShape newM, oldM;
+    TopExp::MapShapes(newS, TopAbs_FACE, newM);
+    TopExp::MapShapes(oldS, TopAbs_FACE, oldM);
+    for (int i=1; i<=oldM.Extent(); i++) {
+        ShapeHistory::List& list = history.shapeMap[i-1];
+        if (mk) {
+            for (TopTools_ListIteratorOfListOfShape it(mk->Modified(oldM(i))); it.More(); it.Next()) {
+                int index = newM.FindIndex(it.Value());
+                if (index > 0)
+                    list.push_back(index-1);
+            }
+            if (!list.empty() || mk->IsDeleted(oldM(i)))
+                continue;
+        }
+        int index = newM.FindIndex(oldM(i));
+        if (index > 0)
+            list.push_back(index-1);
+    }
+
+    return history;
+}
+
+ShapeHistory joinFaceHistory(const ShapeHistory& oldH, const ShapeHistory& newH)
+{
+    ShapeHistory join;
+    join.type = oldH.type;
+    for (const auto& it : oldH.shapeMap) {
+        ShapeHistory::List& list = join.shapeMap[it.first];
+        for (int index : it.second) {
+            auto jt = newH.shapeMap.find(index);
+            if (jt != newH.shapeMap.end())
+                list.insert(list.end(), jt->second.begin(), jt->second.end());
+        }
+    }
+    return join;
+}
+
+void addToCompound(BRep_Builder& builder, TopoDS_Compound& comp, const TopoDS_Shape& shape)
+{
+    // flatten the compounds of earlier levels to avoid a deep nesting
+    if (shape.ShapeType() == TopAbs_COMPOUND) {
+        for (TopoDS_Iterator it(shape); it.More(); it.Next())
+            builder.Add(comp, it.Value());
+    }
+    else {
+        builder.Add(comp, shape);
+    }
+}
+}
+
+TopoDS_Shape BooleanOptions::fuseTree(const std::vector<TopoDS_Shape>& shapes,
+                                      std::vector<ShapeHistory>* history) const
+{
+    if (shapes.empty())
+        return TopoDS_Shape();
+
+    std::vector<FuseNode> nodes(shapes.size());
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        FuseNode& node = nodes[i];
+        node.shape = shapes[i];
+        BRepBndLib::Add(node.shape, node.box);
+        if (!node.box.IsVoid()) {
+            Standard_Real xmin, ymin, zmin, xmax, ymax, zmax;
+            node.box.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+            node.center.SetCoord((xmin + xmax) / 2, (ymin + ymax) / 2, (zmin + zmax) / 2);
+        }
+        if (history)
+            node.inputs.emplace_back(i, faceHistory(nullptr, node.shape, node.shape));
+    }
+
+    sortSpatially(nodes.begin(), nodes.end());
+
+    // the single operations only run in parallel if there is nothing else to do
+    BooleanOptions options(*this);
+    options.NonDestructive = true;
+    unsigned int numThreads = RunParallel ? std::max(std::thread::hardware_concurrency(), 1u) : 1u;
+
+    while (nodes.size() > 1) {
+        std::size_t numPairs = nodes.size() / 2;
+        std::vector<FuseNode> level(numPairs);
+        options.RunParallel = RunParallel && numPairs < numThreads;
+
+        auto combine = [&](std::size_t i) {
+            FuseNode& a = nodes[2*i];
+            FuseNode& b = nodes[2*i+1];
+            FuseNode& node = level[i];
+            std::unique_ptr<BRepAlgoAPI_Fuse> mk;
+            if (a.box.IsOut(b.box)) {
+                BRep_Builder builder;
+                TopoDS_Compound comp;
+                builder.MakeCompound(comp);
+                addToCompound(builder, comp, a.shape);
+                addToCompound(builder, comp, b.shape);
+                node.shape = comp;
+            }
+            else {
+                mk = options.fuse(a.shape, b.shape);
+                if (!mk->IsDone())
+                    Standard_Failure::Raise("Fusion failed");
+                node.shape = mk->Shape();
+            }
+
+            node.box = a.box;
+            node.box.Add(b.box);
+            node.center = a.center.Translated(gp_Vec(a.center, b.center) / 2);
+            if (history) {
+                for (FuseNode* child : {&a, &b}) {
+                    ShapeHistory hist = faceHistory(mk.get(), node.shape, child->shape);
+                    for (auto& it : child->inputs)
+                        node.inputs.emplace_back(it.first, joinFaceHistory(it.second, hist));
+                }
+            }
+        };
+
+        Tools::parallelFor(numPairs, combine, numThreads);
+
+        // an odd node is moved to the next level
+        if (nodes.size() % 2)
+            level.push_back(std::move(nodes.back()));
+        nodes.swap(level);
+    }
+
+    if (history) {
+        history->resize(shapes.size());
+        for (auto& it : nodes.front().inputs)
+            (*history)[it.first] = std::move(it.second);
+    }
+
+    return nodes.front().shape;
+}
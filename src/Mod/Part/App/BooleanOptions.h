@@ -0,0 +1,115 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#ifndef PART_BOOLEANOPTIONS_H
+#define PART_BOOLEANOPTIONS_H
+
+#include <memory>
+#include <vector>
+#include <Standard_Version.hxx>
+#include <BRepAlgoAPI_Common.hxx>
+#include <BRepAlgoAPI_Cut.hxx>
+#include <BRepAlgoAPI_Fuse.hxx>
+#include <TopTools_ListOfShape.hxx>
+
+namespace Part
+{
+
+struct ShapeHistory;
+
+/** The options for the boolean operations of OCC.
+ * They are read from the parameter group Mod/Part/Boolean so that all boolean
+ * features of Part and PartDesign behave the same:
+ * \li RunParallel: run the operation in parallel mode (default: true)
+ * \li UseOBB: use oriented bounding boxes to filter the interferences (default: false)
+ * \li NonDestructive: never modify the arguments (default: false)
+ * \li Glue: 0 = off, 1 = automatic, 2 = shift, 3 = full (default: automatic)
+ *
+ * With automatic gluing the shift mode is used if the bounding boxes of the arguments
+ * at most touch each other, e.g. for an array of adjacent blocks. Then the shapes can
+ * only meet in coinciding faces and the expensive face/face intersection is skipped.
+ *
+ * \li TreeFusionThreshold: number of shapes from which fuseTree() is used to fuse
+ * many shapes, 0 disables it (default: 8)
+ */
+class PartExport BooleanOptions
+{
+public:
+    enum GlueMode {
+        GlueOff = 0,
+        GlueAuto = 1,
+        GlueShift = 2,
+        GlueFull = 3
+    };
+
+    /// Reads the options from the user parameters
+    BooleanOptions();
+
+    /** Creates and performs the operation of \a base and \a tool */
+    //@{
+    std::unique_ptr<BRepAlgoAPI_Fuse> fuse(const TopoDS_Shape& base, const TopoDS_Shape& tool) const;
+    std::unique_ptr<BRepAlgoAPI_Cut> cut(const TopoDS_Shape& base, const TopoDS_Shape& tool) const;
+    std::unique_ptr<BRepAlgoAPI_Common> common(const TopoDS_Shape& base, const TopoDS_Shape& tool) const;
+    //@}
+
+#if OCC_VERSION_HEX >= 0x060900
+    /** Sets the options to \a mk.
+     * The arguments and tools must already be set because they are needed to
+     * detect whether the shapes can be glued. \a fuzzy is the fuzzy value of the
+     * operation.
+     */
+    void apply(BRepAlgoAPI_BuilderAlgo& mk, const TopTools_ListOfShape& shapes, Standard_Real fuzzy = 0.0) const;
+    /// Sets the arguments, the tools and the options to \a mk and builds it
+    void build(BRepAlgoAPI_BooleanOperation& mk, const TopTools_ListOfShape& arguments,
+               const TopTools_ListOfShape& tools, Standard_Real fuzzy = 0.0) const;
+#endif
+
+    /** Returns true if the bounding boxes of the shapes overlap at most by their
+     * tolerance and at least two of them touch.
+     */
+    static bool canGlue(const TopTools_ListOfShape& shapes, Standard_Real fuzzy = 0.0);
+
+    /// Returns true if fuseTree() should be used to fuse \a count shapes
+    bool useFuseTree(std::size_t count) const;
+    /** Fuses \a shapes by a tree reduction.
+     * The shapes are sorted spatially and neighbours are combined pairwise until one
+     * shape is left. Pairs with disjoint bounding boxes are only put into a compound
+     * and the fusions of a level run in parallel. Compared to one operation with all
+     * shapes this keeps every single operation small, e.g. for a pattern of hundreds
+     * of holes that mostly don't touch each other.
+     * If \a history is not null it receives the history of the faces of every input
+     * shape in the result.
+     */
+    TopoDS_Shape fuseTree(const std::vector<TopoDS_Shape>& shapes,
+                          std::vector<ShapeHistory>* history = nullptr) const;
+
+public:
+    bool RunParallel;
+    bool UseOBB;
+    bool NonDestructive;
+    GlueMode Glue;
+    int TreeFusionThreshold;
+};
+
+} //namespace Part
+
+
+#endif // PART_BOOLEANOPTIONS_H
@@ -27,10 +27,12 @@
 # include <BRepAlgoAPI_Common.hxx>
 # include <BRepAlgoAPI_Cut.hxx>
 # include <BRepAlgoAPI_Section.hxx>
+# include <BRepBndLib.hxx>
 # include <BRepBuilderAPI_MakeFace.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
 # include <BRepGProp_Face.hxx>
 # include <BRepPrimAPI_MakeHalfSpace.hxx>
+# include <Bnd_Box.hxx>
 # include <gp_Pln.hxx>
 # include <Precision.hxx>
 # include <ShapeFix_Wire.hxx>
@@ -39,12 +41,16 @@
 # include <TopExp_Explorer.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
+# include <TopTools_ListOfShape.hxx>
 # include <TopoDS.hxx>
 # include <TopoDS_Edge.hxx>
 # include <TopoDS_Wire.hxx>
+# include <algorithm>
+# include <Standard_Version.hxx>
 #endif
 
 #include "CrossSection.h"
+#include "Tools.h"
 
 using namespace Part;
 
@@ -73,9 +79,100 @@ std::list<TopoDS_Wire> CrossSection::slice(double d) const
     return wires;
 }
 
-void CrossSection::sliceNonSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires) const
+namespace {
+struct SlicedShape {
+    TopoDS_Shape shape;
+    bool solid;
+    // range of the shape along the slicing direction
+    double first, last;
+};
+}
+
+std::vector< std::list<TopoDS_Wire> > CrossSection::slices(const std::vector<double>& d) const
 {
+    // Collect the sub-shapes in the same order as slice() and sort them along
+    // the slicing direction, so that every plane only visits the sub-shapes
+    // that start before it.
+    std::vector<SlicedShape> shapes;
+    auto addShape = [&](const TopoDS_Shape& shape, bool solid) {
+        Bnd_Box box;
+        BRepBndLib::Add(shape, box);
+        if (box.IsVoid())
+            return;
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        // the plane is a*x + b*y + c*z = d, so project the extremal corners
+        SlicedShape item;
+        item.shape = shape;
+        item.solid = solid;
+        item.first = (a < 0 ? a*xMax : a*xMin) + (b < 0 ? b*yMax : b*yMin) + (c < 0 ? c*zMax : c*zMin);
+        item.last = (a < 0 ? a*xMin : a*xMax) + (b < 0 ? b*yMin : b*yMax) + (c < 0 ? c*zMin : c*zMax);
+        shapes.push_back(item);
+    };
+
+    TopExp_Explorer xp;
+    for (xp.Init(s, TopAbs_SOLID); xp.More(); xp.Next())
+        addShape(xp.Current(), true);
+    for (xp.Init(s, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next())
+        addShape(xp.Current(), false);
+    for (xp.Init(s, TopAbs_FACE, TopAbs_SHELL); xp.More(); xp.Next())
+        addShape(xp.Current(), false);
+
+    std::vector<std::size_t> order(shapes.size());
+    for (std::size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](std::size_t i, std::size_t j) {
+        return shapes[i].first < shapes[j].first;
+    });
+    std::vector<double> firsts;
+    firsts.reserve(order.size());
+    for (auto i : order)
+        firsts.push_back(shapes[i].first);
+
+    // The booleans must not touch the shared input shapes if they run in
+    // parallel, which requires the non-destructive mode.
+#if OCC_VERSION_HEX >= 0x070000
+    unsigned int numThreads = 0;
+#else
+    unsigned int numThreads = 1;
+#endif
+
+    std::vector< std::list<TopoDS_Wire> > result(d.size());
+    Tools::parallelFor(d.size(), [&](std::size_t index) {
+        double dist = d[index];
+        auto end = std::upper_bound(firsts.begin(), firsts.end(), dist + Precision::Confusion());
+        std::vector<std::size_t> candidates;
+        for (auto it = firsts.begin(); it != end; ++it) {
+            std::size_t i = order[it - firsts.begin()];
+            if (shapes[i].last >= dist - Precision::Confusion())
+                candidates.push_back(i);
+        }
+        // keep the wires in the order of slice()
+        std::sort(candidates.begin(), candidates.end());
+        for (auto i : candidates) {
+            if (shapes[i].solid)
+                sliceSolid(dist, shapes[i].shape, result[index], true);
+            else
+                sliceNonSolid(dist, shapes[i].shape, result[index], true);
+        }
+    }, numThreads);
+
+    return result;
+}
+
+void CrossSection::sliceNonSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires,
+                                 bool nonDestructive) const
+{
+#if OCC_VERSION_HEX >= 0x070000
+    BRepAlgoAPI_Section cs;
+    cs.Init1(shape);
+    cs.Init2(gp_Pln(a,b,c,-d));
+    cs.SetNonDestructive(nonDestructive);
+    cs.Build();
+#else
+    (void)nonDestructive;
     BRepAlgoAPI_Section cs(shape, gp_Pln(a,b,c,-d));
+#endif
     if (cs.IsDone()) {
         std::list<TopoDS_Edge> edges;
         TopExp_Explorer xp;
@@ -85,7 +182,8 @@ void CrossSection::sliceNonSolid(double d, const TopoDS_Shape& shape, std::list<
     }
 }
 
-void CrossSection::sliceSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires) const
+void CrossSection::sliceSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires,
+                              bool nonDestructive) const
 {
 #if 0
     gp_Pln slicePlane(a,b,c,-d);
@@ -113,7 +211,19 @@ void CrossSection::sliceSolid(double d, const TopoDS_Shape& shape, std::list<Top
 
     BRepPrimAPI_MakeHalfSpace mkSolid(face, refPoint);
     TopoDS_Solid solid = mkSolid.Solid();
+#if OCC_VERSION_HEX >= 0x070000
+    TopTools_ListOfShape shapeArguments, shapeTools;
+    shapeArguments.Append(shape);
+    shapeTools.Append(solid);
+    BRepAlgoAPI_Cut mkCut;
+    mkCut.SetArguments(shapeArguments);
+    mkCut.SetTools(shapeTools);
+    mkCut.SetNonDestructive(nonDestructive);
+    mkCut.Build();
+#else
+    (void)nonDestructive;
     BRepAlgoAPI_Cut mkCut(shape, solid);
+#endif
 
     if (mkCut.IsDone()) {
         TopTools_IndexedMapOfShape mapOfFaces;
@@ -25,6 +25,7 @@
 #define PART_CROSSSECTION_H
 
 #include <list>
+#include <vector>
 #include <TopTools_IndexedMapOfShape.hxx>
 
 class TopoDS_Shape;
@@ -37,10 +38,16 @@ class PartExport CrossSection
 public:
     CrossSection(double a, double b, double c, const TopoDS_Shape& s);
     std::list<TopoDS_Wire> slice(double d) const;
+    /** Computes the sections at all the distances \a d in parallel.
+     * Only the sub-shapes whose bounding box reaches a plane are sliced by it.
+     */
+    std::vector< std::list<TopoDS_Wire> > slices(const std::vector<double>& d) const;
 
 private:
-    void sliceNonSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
-    void sliceSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
+    void sliceNonSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires,
+                       bool nonDestructive = false) const;
+    void sliceSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires,
+                    bool nonDestructive = false) const;
     void connectEdges (const std::list<TopoDS_Edge>& edges, std::list<TopoDS_Wire>& wires) const;
     void connectWires (const TopTools_IndexedMapOfShape& wireMap, std::list<TopoDS_Wire>& wires) const;
 
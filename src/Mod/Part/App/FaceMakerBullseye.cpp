@@ -23,7 +23,10 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <map>
 # include <Bnd_Box.hxx>
+# include <Bnd_BoundSortBox.hxx>
+# include <Bnd_HArray1OfBox.hxx>
 # include <BRepBndLib.hxx>
 # include <BRep_Builder.hxx>
 # include <BRep_Tool.hxx>
@@ -42,6 +45,8 @@
 # include <ShapeFix_Shape.hxx>
 # include <ShapeFix_Wire.hxx>
 # include <Standard_Failure.hxx>
+# include <TColStd_ListOfInteger.hxx>
+# include <TColStd_ListIteratorOfListOfInteger.hxx>
 # include <TopoDS.hxx>
 # include <TopExp_Explorer.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
@@ -54,6 +59,7 @@
 #include "FaceMakerCheese.h"
 
 #include "TopoShape.h"
+#include "Tools.h"
 
 
 
@@ -106,35 +112,86 @@ void FaceMakerBullseye::Build_Essence()
         plane = GeomAdaptor_Surface(planeFinder.Surface()).Plane();
     }
 
+    //bounding boxes and directions of the wires don't depend on each other
+    const std::vector<TopoDS_Wire> &wires = this->myWires;
+    std::vector<Bnd_Box> boxes(wires.size());
+    std::vector<int> directions(wires.size());
+    Part::Tools::parallelFor(wires.size(), [&](std::size_t i) {
+        BRepBndLib::Add(wires[i], boxes[i]);
+        boxes[i].SetGap(0.0);
+        directions[i] = FaceDriller::getWireDirection(plane, wires[i]);
+    });
+
     //sort wires by length of diagonal of bounding box.
-    std::vector<TopoDS_Wire> wires = this->myWires;
-    std::stable_sort(wires.begin(), wires.end(), FaceMakerCheese::Wire_Compare());
+    std::vector<int> order(wires.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = static_cast<int>(i);
+    std::stable_sort(order.begin(), order.end(), [&boxes](int a, int b) {
+        return boxes[a].SquareExtent() < boxes[b].SquareExtent();
+    });
+
+    //spatial index of the wires, so that a wire is only tested against the
+    //faces and holes whose bounding box contains it
+    Handle(Bnd_HArray1OfBox) indexBoxes = new Bnd_HArray1OfBox(1, static_cast<int>(wires.size()));
+    Bnd_Box completeBox;
+    for (std::size_t i = 0; i < wires.size(); ++i) {
+        Bnd_Box box = boxes[i];
+        box.SetGap(Precision::Confusion());
+        indexBoxes->SetValue(static_cast<int>(i) + 1, box);
+        completeBox.Add(box);
+    }
+    Bnd_BoundSortBox index;
+    index.Initialize(completeBox, indexBoxes);
+
+    //face and hole index of the wires added so far, -1 if not added (yet)
+    // resp. if the wire is an outer wire
+    std::vector<int> faceOfWire(wires.size(), -1);
+    std::vector<int> holeOfWire(wires.size(), -1);
 
     //add wires one by one to current set of faces.
     //We go from last to first, to make it so that outer wires come before inner wires.
     std::vector< std::unique_ptr<FaceDriller> > faces;
-    for (int i = static_cast<int>(wires.size())-1; i >= 0; --i) {
-        TopoDS_Wire &w = wires[i];
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int i = *it;
+        const TopoDS_Wire &w = wires[i];
 
         //test if this wire is on any of existing faces (if yes, it's a hole;
         // if no, it's a beginning of a new face).
         //Since we are assuming the wires do not intersect, testing if one vertex of wire is in a face is enough.
         gp_Pnt p = BRep_Tool::Pnt(TopoDS::Vertex(TopExp_Explorer(w, TopAbs_VERTEX).Current()));
-        FaceDriller* foundFace = nullptr;
-        for(std::unique_ptr<FaceDriller> &ff : faces){
-            if(ff->hitTest(p)){
-                foundFace = &(*ff);
+
+        //collect the candidate faces with the holes that may contain the point.
+        //The map keeps the order in which the faces were made, i.e. outer ones first.
+        std::map<int, std::vector<int> > candidates;
+        Bnd_Box pointBox;
+        pointBox.Set(p);
+        const TColStd_ListOfInteger& hits = index.Compare(pointBox);
+        for (TColStd_ListIteratorOfListOfInteger hit(hits); hit.More(); hit.Next()) {
+            int j = hit.Value() - 1;
+            if (faceOfWire[j] < 0)
+                continue;
+            std::vector<int> &holes = candidates[faceOfWire[j]];
+            if (holeOfWire[j] >= 0)
+                holes.push_back(holeOfWire[j]);
+        }
+
+        int foundFace = -1;
+        for (const auto &candidate : candidates) {
+            if (faces[candidate.first]->hitTest(p, candidate.second)) {
+                foundFace = candidate.first;
                 break;
             }
         }
 
-        if(foundFace){
+        if(foundFace >= 0){
             //wire is on a face.
-            foundFace->addHole(w);
+            holeOfWire[i] = faces[foundFace]->addHole(w, directions[i]);
+            faceOfWire[i] = foundFace;
         } else {
             //wire is not on a face. Start a new face.
+            faceOfWire[i] = static_cast<int>(faces.size());
             faces.push_back(std::unique_ptr<FaceDriller>(
-                                new FaceDriller(plane, w)
+                                new FaceDriller(plane, w, directions[i])
                            ));
         }
     }
@@ -146,45 +203,80 @@ void FaceMakerBullseye::Build_Essence()
 }
 
 
-FaceMakerBullseye::FaceDriller::FaceDriller(const gp_Pln& plane, TopoDS_Wire outerWire)
+FaceMakerBullseye::FaceDriller::FaceDriller(const gp_Pln& plane, TopoDS_Wire outerWire, int direction)
 {
     this->myPlane = plane;
     this->myFace = TopoDS_Face();
 
     //Ensure correct orientation of the wire.
-    if (getWireDirection(myPlane, outerWire) < 0)
+    if (direction == 0)
+        direction = getWireDirection(myPlane, outerWire);
+    if (direction < 0)
         outerWire.Reverse();
 
     myHPlane = new Geom_Plane(this->myPlane);
     BRep_Builder builder;
     builder.MakeFace(this->myFace, myHPlane, Precision::Confusion());
     builder.Add(this->myFace, outerWire);
+    builder.MakeFace(this->myOuterFace, myHPlane, Precision::Confusion());
+    builder.Add(this->myOuterFace, outerWire);
+}
+
+TopAbs_State FaceMakerBullseye::FaceDriller::classify(const TopoDS_Face& face, const gp_Pnt2d& uv) const
+{
+    BRepClass_FaceClassifier cl(face, uv, Precision::Confusion());
+    TopAbs_State ret = cl.State();
+    if (ret == TopAbs_UNKNOWN)
+        throw Base::ValueError("FaceMakerBullseye::FaceDriller::hitTest: result unknown.");
+    return ret;
 }
 
 bool FaceMakerBullseye::FaceDriller::hitTest(const gp_Pnt& point) const
 {
     double u,v;
     GeomAPI_ProjectPointOnSurf(point, myHPlane).LowerDistanceParameters(u,v);
-    BRepClass_FaceClassifier cl(myFace, gp_Pnt2d(u,v), Precision::Confusion());
-    TopAbs_State ret = cl.State();
-    switch(ret){
-        case TopAbs_UNKNOWN:
-            throw Base::ValueError("FaceMakerBullseye::FaceDriller::hitTest: result unknown.");
-        break;
-        default:
-            return ret == TopAbs_IN || ret == TopAbs_ON;
-    }
+    TopAbs_State ret = classify(myFace, gp_Pnt2d(u,v));
+    return ret == TopAbs_IN || ret == TopAbs_ON;
+}
 
+bool FaceMakerBullseye::FaceDriller::hitTest(const gp_Pnt& point, const std::vector<int>& holes) const
+{
+    double u,v;
+    GeomAPI_ProjectPointOnSurf(point, myHPlane).LowerDistanceParameters(u,v);
+    gp_Pnt2d uv(u,v);
+    TopAbs_State ret = classify(myOuterFace, uv);
+    if (ret != TopAbs_IN)
+        return ret == TopAbs_ON;
+
+    //inside of the outer wire, so on the face unless it is inside of a hole
+    for (int hole : holes) {
+        ret = classify(myHoleFaces[hole], uv);
+        if (ret == TopAbs_IN)
+            return false;
+        if (ret == TopAbs_ON)
+            return true;
+    }
+    return true;
 }
 
-void FaceMakerBullseye::FaceDriller::addHole(TopoDS_Wire w)
+int FaceMakerBullseye::FaceDriller::addHole(TopoDS_Wire w, int direction)
 {
+    if (direction == 0)
+        direction = getWireDirection(myPlane, w);
+
+    //the hole on its own, oriented CCW, for hit tests
+    BRep_Builder builder;
+    TopoDS_Face holeFace;
+    builder.MakeFace(holeFace, myHPlane, Precision::Confusion());
+    builder.Add(holeFace, direction > 0 ? w : TopoDS::Wire(w.Reversed()));
+    myHoleFaces.push_back(holeFace);
+
     //Ensure correct orientation of the wire.
-    if (getWireDirection(myPlane, w) > 0) //if wire is CCW..
+    if (direction > 0) //if wire is CCW..
         w.Reverse();   //.. we want CW!
 
-    BRep_Builder builder;
     builder.Add(this->myFace, w);
+    return static_cast<int>(myHoleFaces.size()) - 1;
 }
 
 int FaceMakerBullseye::FaceDriller::getWireDirection(const gp_Pln& plane, const TopoDS_Wire& wire)
@@ -25,6 +25,7 @@
 
 #include "FaceMaker.h"
 #include <list>
+#include <vector>
 
 #include <Geom_Surface.hxx>
 #include <gp_Pln.hxx>
@@ -74,7 +75,11 @@ protected:
     class FaceDriller
     {
     public:
-        FaceDriller(const gp_Pln& plane, TopoDS_Wire outerWire);
+        /**
+         * @param direction: direction of the wire as returned by
+         * getWireDirection, or 0 to determine it here.
+         */
+        FaceDriller(const gp_Pln& plane, TopoDS_Wire outerWire, int direction = 0);
 
         /**
          * @brief hitTest: returns True if point is on the face
@@ -82,7 +87,21 @@ protected:
          */
         bool hitTest(const gp_Pnt& point) const;
 
-        void addHole(TopoDS_Wire w);
+        /**
+         * @brief hitTest: same as above, but only the listed holes are tested.
+         * The caller must know that the point is not inside any other hole,
+         * e.g. from their bounding boxes.
+         * @param point
+         * @param holes: indices of holes as returned by addHole
+         */
+        bool hitTest(const gp_Pnt& point, const std::vector<int>& holes) const;
+
+        /**
+         * @brief addHole: drills the wire into the face.
+         * @param direction: see constructor
+         * @return index of the hole
+         */
+        int addHole(TopoDS_Wire w, int direction = 0);
 
         const TopoDS_Face& Face() const {return myFace;}
     public:
@@ -93,10 +112,16 @@ protected:
          * @return  1 = CCW (suits as outer wire), -1 = CW (suits as hole)
          */
         static int getWireDirection(const gp_Pln &plane, const TopoDS_Wire &w);
+    private:
+        TopAbs_State classify(const TopoDS_Face& face, const gp_Pnt2d& uv) const;
+
     private:
         gp_Pln myPlane;
         TopoDS_Face myFace;
         Handle(Geom_Surface) myHPlane;
+        //the outer wire and the holes as faces on their own, for hit tests
+        TopoDS_Face myOuterFace;
+        std::vector<TopoDS_Face> myHoleFaces;
     };
 };
 
@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <memory>
 # include <Bnd_Box.hxx>
 # include <BRepBndLib.hxx>
 # include <BRep_Builder.hxx>
@@ -47,6 +48,7 @@
 #endif
 
 #include "FaceMakerCheese.h"
+#include "Tools.h"
 
 
 
@@ -188,30 +190,88 @@ TopoDS_Shape FaceMakerCheese::makeFace(std::list<TopoDS_Wire>& wires)
     return validateFace(mkFace.Face());
 }
 
+namespace {
+/**
+ * Does the same test as FaceMakerCheese::isInside for a wire and several others,
+ * with the bounding boxes computed once. The face of the wire is only made if
+ * a bounding box test passes.
+ */
+class WireClassifier
+{
+public:
+    WireClassifier(const TopoDS_Wire& wire, const Bnd_Box& box)
+        : wire(wire), box(box)
+    {
+    }
+
+    bool isInside(const TopoDS_Wire& other, const Bnd_Box& otherBox)
+    {
+        if (box.IsOut(otherBox))
+            return false;
+
+        double prec = Precision::Confusion();
+        if (!class2d) {
+            BRepBuilderAPI_MakeFace mkFace(wire);
+            if (!mkFace.IsDone())
+                Standard_Failure::Raise("Failed to create a face from wire in sketch");
+            TopoDS_Face face = FaceMakerCheese::validateFace(mkFace.Face());
+            BRepAdaptor_Surface adapt(face);
+            class2d.reset(new IntTools_FClass2d(face, prec));
+            surface = new ShapeAnalysis_Surface(new Geom_Plane(adapt.Plane()));
+        }
+
+        TopExp_Explorer xp(other, TopAbs_VERTEX);
+        if (!xp.More())
+            return false;
+        gp_Pnt p = BRep_Tool::Pnt(TopoDS::Vertex(xp.Current()));
+        gp_Pnt2d uv = surface->ValueOfUV(p, prec);
+        return class2d->Perform(uv) == TopAbs_IN;
+    }
+
+private:
+    TopoDS_Wire wire;
+    Bnd_Box box;
+    std::unique_ptr<IntTools_FClass2d> class2d;
+    Handle(ShapeAnalysis_Surface) surface;
+};
+}
+
 TopoDS_Shape FaceMakerCheese::makeFace(const std::vector<TopoDS_Wire>& w)
 {
     if (w.empty())
         return TopoDS_Shape();
 
+    std::vector<Bnd_Box> boxes(w.size());
+    for (std::size_t i = 0; i < w.size(); i++) {
+        if (!w[i].IsNull()) {
+            BRepBndLib::Add(w[i], boxes[i]);
+            boxes[i].SetGap(0.0);
+        }
+    }
+
     //FIXME: Need a safe method to sort wire that the outermost one comes last
     // Currently it's done with the diagonal lengths of the bounding boxes
-    std::vector<TopoDS_Wire> wires = w;
-    std::sort(wires.begin(), wires.end(), Wire_Compare());
-    std::list<TopoDS_Wire> wire_list;
-    wire_list.insert(wire_list.begin(), wires.rbegin(), wires.rend());
+    std::vector<std::size_t> order(w.size());
+    for (std::size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&boxes](std::size_t a, std::size_t b) {
+        return boxes[a].SquareExtent() < boxes[b].SquareExtent();
+    });
+    std::list<std::size_t> wire_list(order.rbegin(), order.rend());
 
     // separate the wires into several independent faces
-    std::list< std::list<TopoDS_Wire> > sep_wire_list;
+    std::vector< std::list<TopoDS_Wire> > sep_wire_list;
     while (!wire_list.empty()) {
         std::list<TopoDS_Wire> sep_list;
-        TopoDS_Wire wire = wire_list.front();
+        std::size_t outer = wire_list.front();
         wire_list.pop_front();
-        sep_list.push_back(wire);
+        sep_list.push_back(w[outer]);
 
-        std::list<TopoDS_Wire>::iterator it = wire_list.begin();
+        WireClassifier classifier(w[outer], boxes[outer]);
+        std::list<std::size_t>::iterator it = wire_list.begin();
         while (it != wire_list.end()) {
-            if (isInside(wire, *it)) {
-                sep_list.push_back(*it);
+            if (classifier.isInside(w[*it], boxes[*it])) {
+                sep_list.push_back(w[*it]);
                 it = wire_list.erase(it);
             }
             else {
@@ -227,11 +287,16 @@ TopoDS_Shape FaceMakerCheese::makeFace(const std::vector<TopoDS_Wire>& w)
         return makeFace(wires);
     }
     else if (sep_wire_list.size() > 1) {
+        // the faces don't share any wires, so they can be made in parallel
+        std::vector<TopoDS_Shape> faces(sep_wire_list.size());
+        Part::Tools::parallelFor(sep_wire_list.size(), [&](std::size_t i) {
+            faces[i] = makeFace(sep_wire_list[i]);
+        });
+
         TopoDS_Compound comp;
         BRep_Builder builder;
         builder.MakeCompound(comp);
-        for (std::list< std::list<TopoDS_Wire> >::iterator it = sep_wire_list.begin(); it != sep_wire_list.end(); ++it) {
-            TopoDS_Shape aFace = makeFace(*it);
+        for (const TopoDS_Shape& aFace : faces) {
             if (!aFace.IsNull())
                 builder.Add(comp, aFace);
         }
@@ -34,6 +34,7 @@
 
 
 #include "FeaturePartCommon.h"
+#include "BooleanOptions.h"
 #include "modelRefine.h"
 #include <App/Application.h>
 #include <Base/Parameter.h>
@@ -51,7 +52,7 @@ Common::Common(void)
 BRepAlgoAPI_BooleanOperation* Common::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a section operation:
-    return new BRepAlgoAPI_Common(base, tool);
+    return BooleanOptions().common(base, tool).release();
 }
 
 // ----------------------------------------------------
@@ -112,6 +113,7 @@ App::DocumentObjectExecReturn *MultiCommon::execute(void)
     if (s.size() >= 2) {
         try {
             std::vector<ShapeHistory> history;
+            BooleanOptions options;
             TopoDS_Shape resShape = s.front();
             if (resShape.IsNull())
                 throw NullShapeException("Input shape is null");
@@ -121,14 +123,14 @@ App::DocumentObjectExecReturn *MultiCommon::execute(void)
                     throw Base::RuntimeError("Input shape is null");
 
                 // Let's call algorithm computing a fuse operation:
-                BRepAlgoAPI_Common mkCommon(resShape, *it);
+                std::unique_ptr<BRepAlgoAPI_Common> mkCommon(options.common(resShape, *it));
                 // Let's check if the fusion has been successful
-                if (!mkCommon.IsDone()) 
+                if (!mkCommon->IsDone()) 
                     throw BooleanException("Intersection failed");
-                resShape = mkCommon.Shape();
+                resShape = mkCommon->Shape();
 
-                ShapeHistory hist1 = buildHistory(mkCommon, TopAbs_FACE, resShape, mkCommon.Shape1());
-                ShapeHistory hist2 = buildHistory(mkCommon, TopAbs_FACE, resShape, mkCommon.Shape2());
+                ShapeHistory hist1 = buildHistory(*mkCommon, TopAbs_FACE, resShape, mkCommon->Shape1());
+                ShapeHistory hist2 = buildHistory(*mkCommon, TopAbs_FACE, resShape, mkCommon->Shape2());
                 if (history.empty()) {
                     history.push_back(hist1);
                     history.push_back(hist2);
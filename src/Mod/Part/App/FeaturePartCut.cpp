@@ -28,6 +28,7 @@
 
 
 #include "FeaturePartCut.h"
+#include "BooleanOptions.h"
 
 #include <Base/Exception.h>
 
@@ -43,5 +44,5 @@ Cut::Cut(void)
 BRepAlgoAPI_BooleanOperation* Cut::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a cut operation:
-    return new BRepAlgoAPI_Cut(base, tool);
+    return BooleanOptions().cut(base, tool).release();
 }
@@ -33,6 +33,7 @@
 
 
 #include "FeaturePartFuse.h"
+#include "BooleanOptions.h"
 #include "modelRefine.h"
 #include <App/Application.h>
 #include <Base/Parameter.h>
@@ -50,7 +51,7 @@ Fuse::Fuse(void)
 BRepAlgoAPI_BooleanOperation* Fuse::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a fuse operation:
-    return new BRepAlgoAPI_Fuse(base, tool);
+    return BooleanOptions().fuse(base, tool).release();
 }
 
 // ----------------------------------------------------
@@ -140,28 +141,38 @@ App::DocumentObjectExecReturn *MultiFuse::execute(void)
                 }
             }
 #else
-            BRepAlgoAPI_Fuse mkFuse;
-            TopTools_ListOfShape shapeArguments,shapeTools;
-            const TopoDS_Shape& shape = s.front();
-            if (shape.IsNull())
-                throw Base::RuntimeError("Input shape is null");
-            shapeArguments.Append(shape);
-
-            for (std::vector<TopoDS_Shape>::iterator it = s.begin()+1; it != s.end(); ++it) {
-                if (it->IsNull())
-                    throw Base::RuntimeError("Input shape is null");
-                shapeTools.Append(*it);
+            TopoDS_Shape resShape;
+            BooleanOptions options;
+            if (options.useFuseTree(s.size())) {
+                // many shapes are fused pairwise to keep every single operation small
+                for (std::vector<TopoDS_Shape>::iterator it = s.begin(); it != s.end(); ++it) {
+                    if (it->IsNull())
+                        throw Base::RuntimeError("Input shape is null");
+                }
+                resShape = options.fuseTree(s, &history);
             }
+            else {
+                BRepAlgoAPI_Fuse mkFuse;
+                TopTools_ListOfShape shapeArguments,shapeTools;
+                const TopoDS_Shape& shape = s.front();
+                if (shape.IsNull())
+                    throw Base::RuntimeError("Input shape is null");
+                shapeArguments.Append(shape);
+
+                for (std::vector<TopoDS_Shape>::iterator it = s.begin()+1; it != s.end(); ++it) {
+                    if (it->IsNull())
+                        throw Base::RuntimeError("Input shape is null");
+                    shapeTools.Append(*it);
+                }
 
-            mkFuse.SetArguments(shapeArguments);
-            mkFuse.SetTools(shapeTools);
-            mkFuse.Build();
-            if (!mkFuse.IsDone())
-                throw Base::RuntimeError("MultiFusion failed");
+                options.build(mkFuse, shapeArguments, shapeTools);
+                if (!mkFuse.IsDone())
+                    throw Base::RuntimeError("MultiFusion failed");
 
-            TopoDS_Shape resShape = mkFuse.Shape();
-            for (std::vector<TopoDS_Shape>::iterator it = s.begin(); it != s.end(); ++it) {
-                history.push_back(buildHistory(mkFuse, TopAbs_FACE, resShape, *it));
+                resShape = mkFuse.Shape();
+                for (std::vector<TopoDS_Shape>::iterator it = s.begin(); it != s.end(); ++it) {
+                    history.push_back(buildHistory(mkFuse, TopAbs_FACE, resShape, *it));
+                }
             }
 #endif
             if (resShape.IsNull())
@@ -25,6 +25,8 @@
 
 #ifndef _PreComp_
 # include <sstream>
+# include <mutex>
+# include <tuple>
 # include <gp_Trsf.hxx>
 # include <gp_Ax1.hxx>
 # include <BRepBuilderAPI_MakeShape.hxx>
@@ -217,6 +219,20 @@ struct ShapeCache {
     std::unordered_map<const App::Document*,
         std::map<std::pair<const App::DocumentObject*, std::string> ,TopoShape> > cache;
 
+    // Results of the top level resolution in Feature::getTopoShape(), keyed by
+    // object, subname, needSubElement and resolveLink. They depend on the whole
+    // link chain, so they are dropped on any change of any object.
+    struct Resolved {
+        TopoShape shape;
+        Base::Matrix4D mat;
+        App::DocumentObject *owner;
+    };
+    typedef std::tuple<const App::DocumentObject*, std::string, bool, bool> ResolvedKey;
+    std::map<ResolvedKey, Resolved> resolved;
+
+    // guards the cache against concurrent access from parallel recompute
+    std::mutex mutex;
+
     bool inited = false;
     void init() {
         if(inited)
@@ -231,10 +247,16 @@ struct ShapeCache {
     }
 
     void slotDeleteDocument(const App::Document &doc) {
+        std::lock_guard<std::mutex> lock(mutex);
         cache.erase(&doc);
+        resolved.clear();
     }
 
     void slotChanged(const App::DocumentObject &obj, const App::Property &prop) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            resolved.clear();
+        }
         const char *propName = prop.getName();
         if(!propName)
             return;
@@ -245,6 +267,8 @@ struct ShapeCache {
     }
 
     void slotClear(const App::DocumentObject &obj) {
+        std::lock_guard<std::mutex> lock(mutex);
+        resolved.clear();
         auto it = cache.find(obj.getDocument());
         if(it==cache.end())
             return;
@@ -257,6 +281,7 @@ struct ShapeCache {
     }
 
     bool getShape(const App::DocumentObject *obj, TopoShape &shape, const char *subname=0) {
+        std::lock_guard<std::mutex> lock(mutex);
         init();
         auto &entry = cache[obj->getDocument()];
         if(!subname) subname = "";
@@ -269,15 +294,43 @@ struct ShapeCache {
     }
 
     void setShape(const App::DocumentObject *obj, const TopoShape &shape, const char *subname=0) {
+        std::lock_guard<std::mutex> lock(mutex);
         init();
         if(!subname) subname = "";
         cache[obj->getDocument()][std::make_pair(obj,std::string(subname))] = shape;
     }
+
+    bool getResolved(const App::DocumentObject *obj, const char *subname, bool needSubElement,
+            bool resolveLink, TopoShape &shape, Base::Matrix4D &mat, App::DocumentObject *&owner)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        init();
+        auto it = resolved.find(ResolvedKey(obj, subname?subname:"", needSubElement, resolveLink));
+        if(it == resolved.end())
+            return false;
+        shape = it->second.shape;
+        mat = it->second.mat;
+        owner = it->second.owner;
+        return true;
+    }
+
+    void setResolved(const App::DocumentObject *obj, const char *subname, bool needSubElement,
+            bool resolveLink, const TopoShape &shape, const Base::Matrix4D &mat, App::DocumentObject *owner)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        init();
+        auto &entry = resolved[ResolvedKey(obj, subname?subname:"", needSubElement, resolveLink)];
+        entry.shape = shape;
+        entry.mat = mat;
+        entry.owner = owner;
+    }
 };
 static ShapeCache _ShapeCache;
 
 void Feature::clearShapeCache() {
+    std::lock_guard<std::mutex> lock(_ShapeCache.mutex);
     _ShapeCache.cache.clear();
+    _ShapeCache.resolved.clear();
 }
 
 static TopoShape _getTopoShape(const App::DocumentObject *obj, const char *subname, 
@@ -500,9 +553,19 @@ TopoShape Feature::getTopoShape(const App::DocumentObject *obj, const char *subn
     // transformation for easy shape caching, i.e.  with `transform` set
     // to false. So we manually apply the top level transform if asked.
 
+    // The same shape is often resolved many times between two changes of the
+    // documents, e.g. by the features of a recompute, so reuse the result.
     Base::Matrix4D mat;
-    auto shape = _getTopoShape(obj, subname, needSubElement, &mat, 
-            powner, resolveLink, noElementMap, linkStack);
+    App::DocumentObject *owner = 0;
+    TopoShape shape;
+    if(!_ShapeCache.getResolved(obj, subname, needSubElement, resolveLink, shape, mat, owner)) {
+        shape = _getTopoShape(obj, subname, needSubElement, &mat,
+                &owner, resolveLink, noElementMap, linkStack);
+        if(!shape.isNull())
+            _ShapeCache.setResolved(obj, subname, needSubElement, resolveLink, shape, mat, owner);
+    }
+    if(powner)
+        *powner = owner;
 
     Base::Matrix4D topMat;
     if(pmat || transform) {
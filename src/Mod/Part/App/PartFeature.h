@@ -58,6 +58,8 @@ public:
     /** @name methods override feature */
     //@{
     virtual short mustExecute() const override;
+    /// Shape features only do OCC work in execute() and can run in a worker thread
+    virtual bool allowConcurrentRecompute() const override {return true;}
     //@}
 
     /// returns the type name of the ViewProvider
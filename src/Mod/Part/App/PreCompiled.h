@@ -62,11 +62,18 @@
 #include <list>
 #include <set>
 #include <map>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
 
 #include <fstream>
 #include <string>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 
 #include <cmath>
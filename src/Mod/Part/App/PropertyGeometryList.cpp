@@ -25,6 +25,7 @@
 
 #ifndef _PreComp_
 #   include <assert.h>
+#   include <algorithm>
 #endif
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
@@ -242,6 +243,68 @@ void PropertyGeometryList::Paste(const Property &from)
     setValues(FromList._lValueList);
 }
 
+// The geometries are compared by their persistent content, because in-place
+// changes, e.g. of the extensions, keep the pointer, while the solver replaces
+// unchanged geometries by new ones.
+static bool isSameGeometry(const Geometry *g1, const Geometry *g2)
+{
+    if (g1 == g2)
+        return true;
+    if (!g1 || !g2 || g1->getTypeId() != g2->getTypeId())
+        return false;
+    Base::StringWriter w1, w2;
+    g1->Save(w1);
+    g2->Save(w2);
+    return w1.getString() == w2.getString();
+}
+
+bool PropertyGeometryList::trimCopy(Property &copy, int &start, int &count) const
+{
+    if (copy.getTypeId() != getTypeId())
+        return false;
+    std::vector<Geometry*> &values = static_cast<PropertyGeometryList&>(copy)._lValueList;
+    std::size_t oldSize = values.size();
+    std::size_t newSize = _lValueList.size();
+    std::size_t common = std::min(oldSize, newSize);
+    std::size_t prefix = 0;
+    while (prefix < common && isSameGeometry(values[prefix], _lValueList[prefix]))
+        ++prefix;
+    std::size_t suffix = 0;
+    while (suffix < common - prefix
+            && isSameGeometry(values[oldSize-suffix-1], _lValueList[newSize-suffix-1]))
+        ++suffix;
+    if (prefix + suffix == 0)
+        return false;
+
+    // the copy owns its geometries, so free the ones that are dropped
+    for (std::size_t i=0; i<prefix; ++i)
+        delete values[i];
+    for (std::size_t i=oldSize-suffix; i<oldSize; ++i)
+        delete values[i];
+    std::vector<Geometry*> range(values.begin()+prefix, values.begin()+(oldSize-suffix));
+    values.swap(range);
+    start = static_cast<int>(prefix);
+    count = static_cast<int>(newSize - prefix - suffix);
+    return true;
+}
+
+void PropertyGeometryList::expandCopy(Property &copy, int start, int count) const
+{
+    if (copy.getTypeId() != getTypeId())
+        return;
+    std::vector<Geometry*> &range = static_cast<PropertyGeometryList&>(copy)._lValueList;
+    std::size_t first = static_cast<std::size_t>(start);
+    std::size_t last = first + static_cast<std::size_t>(count);
+    std::vector<Geometry*> values;
+    values.reserve(first + range.size() + _lValueList.size() - last);
+    for (std::size_t i=0; i<first; ++i)
+        values.push_back(_lValueList[i]->clone());
+    values.insert(values.end(), range.begin(), range.end());
+    for (std::size_t i=last; i<_lValueList.size(); ++i)
+        values.push_back(_lValueList[i]->clone());
+    range.swap(values);
+}
+
 unsigned int PropertyGeometryList::getMemSize(void) const
 {
     int size = sizeof(PropertyGeometryList);
@@ -86,6 +86,10 @@ public:
     virtual App::Property *Copy(void) const;
     virtual void Paste(const App::Property &from);
 
+    /// Reduces an undo copy to the geometries that differ from the current ones
+    virtual bool trimCopy(App::Property &copy, int &start, int &count) const;
+    virtual void expandCopy(App::Property &copy, int start, int count) const;
+
     virtual unsigned int getMemSize(void) const;
 
 private:
@@ -58,6 +58,9 @@
 #include <App/Application.h>
 #include <App/DocumentObject.h>
 #include <App/ObjectIdentifier.h>
+#include <App/Document.h>
+#include <zipios++/zipfile.h>
+#include <mutex>
 
 #include "PropertyTopoShape.h"
 #include "TopoShapePy.h"
@@ -72,18 +75,39 @@
 
 using namespace Part;
 
+namespace {
+// Shapes that are still waiting to be read from their project file
+std::mutex DeferredMutex;
+std::set<PropertyPartShape*> DeferredShapes;
+boost::signals2::connection DeferredConnection;
+
+void onStartSaveDocument(const App::Document& doc, const std::string& filename)
+{
+    // The project file may be overwritten, so read in everything that still
+    // refers to it. The paths are compared the way Base::XMLReader stores them.
+    std::string current = Base::FileInfo(doc.FileName.getValue()).filePath();
+    std::string target = Base::FileInfo(filename).filePath();
+    PropertyPartShape::loadDeferred(current);
+    if (target != current)
+        PropertyPartShape::loadDeferred(target);
+}
+}
+
 TYPESYSTEM_SOURCE(Part::PropertyPartShape , App::PropertyComplexGeoData)
 
 PropertyPartShape::PropertyPartShape()
+  : _SharedSource(nullptr), _HasDeferred(false)
 {
 }
 
 PropertyPartShape::~PropertyPartShape()
 {
+    clearDeferred();
 }
 
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
+    clearDeferred();
     aboutToSetValue();
     _Shape = sh;
     hasSetValue();
@@ -91,6 +115,7 @@ void PropertyPartShape::setValue(const TopoShape& sh)
 
 void PropertyPartShape::setValue(const TopoDS_Shape& sh)
 {
+    clearDeferred();
     aboutToSetValue();
     _Shape.setShape(sh);
     hasSetValue();
@@ -98,47 +123,31 @@ void PropertyPartShape::setValue(const TopoDS_Shape& sh)
 
 const TopoDS_Shape& PropertyPartShape::getValue(void)const
 {
+    loadDeferred();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    loadDeferred();
     return this->_Shape;
 }
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    loadDeferred();
     return &(this->_Shape);
 }
 
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
-    Base::BoundBox3d box;
-    if (_Shape.getShape().IsNull())
-        return box;
-    try {
-        // If the shape is empty an exception may be thrown
-        Bnd_Box bounds;
-        BRepBndLib::Add(_Shape.getShape(), bounds);
-        bounds.SetGap(0.0);
-        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
-        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
-
-        box.MinX = xMin;
-        box.MaxX = xMax;
-        box.MinY = yMin;
-        box.MaxY = yMax;
-        box.MinZ = zMin;
-        box.MaxZ = zMax;
-    }
-    catch (Standard_Failure&) {
-    }
-
-    return box;
+    loadDeferred();
+    return _Shape.getBoundBox();
 }
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    loadDeferred();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
@@ -146,6 +155,7 @@ void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 
 PyObject *PropertyPartShape::getPyObject(void)
 {
+    loadDeferred();
     Base::PyObjectBase* prop = static_cast<Base::PyObjectBase*>(_Shape.getPyObject());
     if (prop)
         prop->setConst();
@@ -167,6 +177,7 @@ void PropertyPartShape::setPyObject(PyObject *value)
 
 App::Property *PropertyPartShape::Copy(void) const
 {
+    loadDeferred();
     PropertyPartShape *prop = new PropertyPartShape();
     prop->_Shape = this->_Shape;
     if (!_Shape.getShape().IsNull()) {
@@ -179,8 +190,11 @@ App::Property *PropertyPartShape::Copy(void) const
 
 void PropertyPartShape::Paste(const App::Property &from)
 {
+    const PropertyPartShape& prop = dynamic_cast<const PropertyPartShape&>(from);
+    prop.loadDeferred();
+    clearDeferred();
     aboutToSetValue();
-    _Shape = dynamic_cast<const PropertyPartShape&>(from)._Shape;
+    _Shape = prop._Shape;
     hasSetValue();
 }
 
@@ -207,16 +221,32 @@ void PropertyPartShape::Save (Base::Writer &writer) const
 {
     if(!writer.isForceXML()) {
         //See SaveDocFile(), RestoreDocFile()
-        if (writer.getMode("BinaryBrep")) {
-            writer.Stream() << writer.ind() << "<Part file=\""
-                            << writer.addFile("PartShape.bin", this)
-                            << "\"/>" << std::endl;
+        bool binary = writer.getMode("BinaryBrep");
+        const char* name = binary ? "PartShape.bin" : "PartShape.brp";
+        std::string file;
+        const TopoDS_Shape& shape = getValue();
+        if (writer.getMode("SharedShapes") && !shape.IsNull()) {
+            // Shapes referring to the same topology at the same location,
+            // e.g. of links or shape binders, are written only once
+            std::ostringstream key;
+            key.precision(17);
+            key << name << ':' << static_cast<const void*>(shape.TShape().operator->())
+                << ':' << static_cast<int>(shape.Orientation());
+            gp_Trsf trsf = shape.Location().Transformation();
+            for (int row = 1; row <= 3; row++) {
+                for (int col = 1; col <= 4; col++)
+                    key << ':' << trsf.Value(row, col);
+            }
+            file = writer.addSharedFile(name, this, key.str());
         }
         else {
-            writer.Stream() << writer.ind() << "<Part file=\""
-                            << writer.addFile("PartShape.brp", this)
-                            << "\"/>" << std::endl;
+            file = writer.addFile(name, this);
         }
+
+        writer.Stream() << writer.ind() << "<Part file=\"" << file << "\"";
+        if (binary)
+            writer.Stream() << " version=\"" << BinaryFormatVersion << "\"";
+        writer.Stream() << "/>" << std::endl;
     }
 }
 
@@ -225,24 +255,63 @@ void PropertyPartShape::Restore(Base::XMLReader &reader)
     reader.readElement("Part");
     std::string file (reader.getAttribute("file") );
 
+    // A binary shape written in a newer layout cannot be read by this version
+    if (reader.hasAttribute("version") && reader.getAttributeAsInteger("version") > BinaryFormatVersion) {
+        App::PropertyContainer* father = this->getContainer();
+        if (father && father->isDerivedFrom(App::DocumentObject::getClassTypeId())) {
+            App::DocumentObject* obj = static_cast<App::DocumentObject*>(father);
+            Base::Console().Error("Shape of '%s' uses an unsupported binary format version %ld\n",
+                obj->Label.getValue(), reader.getAttributeAsInteger("version"));
+        }
+        else {
+            Base::Console().Error("Shape uses an unsupported binary format version %ld\n",
+                reader.getAttributeAsInteger("version"));
+        }
+        reader.setPartialRestore(true);
+        return;
+    }
+
     if (!file.empty()) {
+        // A file shared with another shape is read only once, the shape is
+        // then taken over in afterRestore()
+        for (const auto& entry : reader.FileList) {
+            if (entry.FileName == file) {
+                _SharedSource = dynamic_cast<PropertyPartShape*>(entry.Object);
+                if (_SharedSource)
+                    return;
+                break;
+            }
+        }
+
         // initiate a file read
         reader.addFile(file.c_str(),this);
     }
 }
 
+void PropertyPartShape::afterRestore()
+{
+    if (_SharedSource) {
+        PropertyPartShape* source = _SharedSource;
+        _SharedSource = nullptr;
+        // share the underlying topology instead of copying it
+        setValue(source->getShape());
+    }
+    App::PropertyComplexGeoData::afterRestore();
+}
+
 // The following two functions are copied from OCCT BRepTools.cxx and modified
-// to disable saving of triangulation
+// to make saving of triangulation optional
 //
-static void BRepTools_Write(const TopoDS_Shape& Sh, Standard_OStream& S) {
-  BRepTools_ShapeSet SS(Standard_False);
+static void BRepTools_Write(const TopoDS_Shape& Sh, Standard_OStream& S, Standard_Boolean withTriangles) {
+  BRepTools_ShapeSet SS(withTriangles);
   // SS.SetProgress(PR);
   SS.Add(Sh);
   SS.Write(S);
   SS.Write(Sh,S);
 }
 
-static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_CString File)
+static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_CString File,
+                                         Standard_Boolean withTriangles)
 {
   std::ofstream os;
 #if OCC_VERSION_HEX >= 0x060800
@@ -256,7 +325,7 @@ static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_
   if(!isGood)
     return isGood;
 
-  BRepTools_ShapeSet SS(Standard_False);
+  BRepTools_ShapeSet SS(withTriangles);
   // SS.SetProgress(PR);
   SS.Add(Sh);
 
@@ -277,15 +346,20 @@ static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_
 
 void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
+    loadDeferred();
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
     if (_Shape.getShape().IsNull())
         return;
     TopoDS_Shape myShape = _Shape.getShape();
+    // The triangulation is kept with the faces it belongs to. When reading the file
+    // back BRepMesh only re-tessellates the faces whose stored triangulation is
+    // coarser than the requested deflection.
+    bool withTriangles = writer.getMode("SaveTriangulation");
     if (writer.getMode("BinaryBrep")) {
         TopoShape shape;
         shape.setShape(myShape);
-        shape.exportBinary(writer.Stream());
+        shape.exportBinary(writer.Stream(), withTriangles);
     }
     else {
         bool direct = App::GetApplication().GetParameterGroupByPath
@@ -296,7 +370,7 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
             // we may run into some problems on the Linux platform
             static Base::FileInfo fi(App::Application::getTempFileName());
 
-            if (!BRepTools_Write(myShape,(Standard_CString)fi.filePath().c_str())) {
+            if (!BRepTools_Write(myShape,(Standard_CString)fi.filePath().c_str(),withTriangles)) {
                 // Note: Do NOT throw an exception here because if the tmp. file could
                 // not be created we should not abort.
                 // We only print an error message but continue writing the next files to the
@@ -339,18 +413,121 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
             fi.deleteFile();
         }
         else {
-            BRepTools_Write(myShape, writer.Stream());
+            BRepTools_Write(myShape, writer.Stream(), withTriangles);
         }
     }
 }
 
 void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
 {
-    Base::FileInfo brep(reader.getFileName());
-    if (brep.hasExtension("bin")) {
-        TopoShape shape;
-        shape.importBinary(reader);
-        setValue(shape);
+    TopoShape shape;
+    readShape(reader, shape);
+    setValue(shape);
+}
+
+void PropertyPartShape::RestoreDocFileConcurrent(Base::Reader &reader)
+{
+    // runs in a worker thread, see Base::XMLReader::readFiles()
+    std::unique_ptr<TopoShape> shape(new TopoShape());
+    readShape(reader, *shape);
+    _Restored = std::move(shape);
+}
+
+void PropertyPartShape::finishRestoreDocFile()
+{
+    if (_Restored) {
+        std::unique_ptr<TopoShape> shape(std::move(_Restored));
+        setValue(*shape);
+    }
+}
+
+bool PropertyPartShape::RestoreDocFileDeferred(const std::string &archive,
+                                               const std::string &fileName,
+                                               int fileVersion)
+{
+    std::lock_guard<std::mutex> lock(DeferredMutex);
+    if (!DeferredConnection.connected()) {
+        DeferredConnection = App::GetApplication().signalStartSaveDocument.connect(&onStartSaveDocument);
+    }
+
+    _Deferred.reset(new DeferredFile{archive, fileName, fileVersion});
+    DeferredShapes.insert(this);
+    _HasDeferred = true;
+    return true;
+}
+
+bool PropertyPartShape::isDeferred() const
+{
+    return _HasDeferred;
+}
+
+void PropertyPartShape::loadDeferred() const
+{
+    if (!_HasDeferred)
+        return;
+
+    std::lock_guard<std::mutex> lock(DeferredMutex);
+    // another thread may have been faster
+    if (!_Deferred)
+        return;
+
+    std::unique_ptr<DeferredFile> file(std::move(_Deferred));
+    DeferredShapes.erase(const_cast<PropertyPartShape*>(this));
+
+    // The shape is read in silently because from the user's point of view it
+    // has been there since the document was opened.
+    try {
+        zipios::ZipFile zip(file->archive);
+        std::unique_ptr<std::istream> str(zip.getInputStream(file->fileName));
+        if (!str)
+            throw Base::FileException("Missing file in project", file->archive);
+        Base::Reader reader(*str, file->fileName, file->fileVersion);
+        readShape(reader, const_cast<PropertyPartShape*>(this)->_Shape);
+    }
+    catch (...) {
+        Base::Console().Error("Reading failed from embedded file: %s\n", file->fileName.c_str());
+    }
+
+    _HasDeferred = false;
+}
+
+void PropertyPartShape::loadDeferred(const std::string &archive)
+{
+    std::vector<PropertyPartShape*> props;
+    {
+        std::lock_guard<std::mutex> lock(DeferredMutex);
+        for (auto prop : DeferredShapes) {
+            if (prop->_Deferred && prop->_Deferred->archive == archive)
+                props.push_back(prop);
+        }
+    }
+
+    for (auto prop : props)
+        prop->loadDeferred();
+}
+
+void PropertyPartShape::clearDeferred()
+{
+    if (!_HasDeferred)
+        return;
+
+    std::lock_guard<std::mutex> lock(DeferredMutex);
+    _Deferred.reset();
+    DeferredShapes.erase(this);
+    _HasDeferred = false;
+}
+
+void PropertyPartShape::readShape(Base::Reader &reader, TopoShape &result) const
+{
+    // Detect the format from the content instead of relying on the file
+    // name. The header of a binary BRep is "Open CASCADE Topology V..."
+    // while a text BRep starts with "DBRep_DrawableShape" or "CASCADE Topology".
+    // An empty file means that the stored shape was empty.
+    int first = reader.peek();
+    if (first == std::char_traits<char>::eof())
+        return;
+    if (first == 'O') {
+        result.importBinary(reader);
     }
     else {
         bool direct = App::GetApplication().GetParameterGroupByPath
@@ -394,13 +571,13 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
 
             // delete the temp file
             fi.deleteFile();
-            setValue(shape);
+            result.setShape(shape);
         }
         else {
             BRep_Builder builder;
             TopoDS_Shape shape;
             BRepTools::Read(shape, reader, builder);
-            setValue(shape);
+            result.setShape(shape);
         }
     }
 }
@@ -28,7 +28,9 @@
 #include <TopAbs_ShapeEnum.hxx>
 #include <App/DocumentObject.h>
 #include <App/PropertyGeo.h>
+#include <atomic>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace Part
@@ -45,6 +47,9 @@ public:
     PropertyPartShape();
     ~PropertyPartShape();
 
+    /// Layout version of the binary shape files written by SaveDocFile()
+    static const int BinaryFormatVersion = 1;
+
     /** @name Getter/setter */
     //@{
     /// set the part shape
@@ -79,20 +84,50 @@ public:
     //@{
     void Save (Base::Writer &writer) const;
     void Restore(Base::XMLReader &reader);
+    void afterRestore();
 
     void SaveDocFile (Base::Writer &writer) const;
     void RestoreDocFile(Base::Reader &reader);
+    bool RestoreDocFileDeferred(const std::string &archive,
+                                const std::string &fileName,
+                                int fileVersion);
+    bool allowConcurrentRestore() const {return true;}
+    void RestoreDocFileConcurrent(Base::Reader &reader);
+    void finishRestoreDocFile();
 
     App::Property *Copy(void) const;
     void Paste(const App::Property &from);
     unsigned int getMemSize (void) const;
     //@}
 
+    /** @name Deferred loading */
+    //@{
+    /// Check whether the shape is still waiting to be read from the project file
+    bool isDeferred() const;
+    /// Read the shape now if its loading has been deferred
+    void loadDeferred() const;
+    /// Read all deferred shapes that refer to the given project file
+    static void loadDeferred(const std::string &archive);
+    //@}
+
     /// Get valid paths for this property; used by auto completer
     virtual void getPaths(std::vector<App::ObjectIdentifier> & paths) const;
 
 private:
+    void readShape(Base::Reader &reader, TopoShape &result) const;
+    void clearDeferred();
+
+private:
+    struct DeferredFile {
+        std::string archive;
+        std::string fileName;
+        int fileVersion;
+    };
     TopoShape _Shape;
+    std::unique_ptr<TopoShape> _Restored;
+    PropertyPartShape* _SharedSource;
+    mutable std::unique_ptr<DeferredFile> _Deferred;
+    mutable std::atomic<bool> _HasDeferred;
 };
 
 struct PartExport ShapeHistory {
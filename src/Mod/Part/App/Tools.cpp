@@ -22,9 +22,24 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <atomic>
 # include <cassert>
+# include <exception>
+# include <future>
+# include <map>
+# include <thread>
+# include <vector>
+# include <gp_Ax2.hxx>
 # include <gp_Pln.hxx>
 # include <gp_Lin.hxx>
+# include <gp_Pnt2d.hxx>
+# include <Bnd_Box.hxx>
+# include <Bnd_Box2d.hxx>
+# include <BRep_Builder.hxx>
+# include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
+# include <BRepBuilderAPI_Sewing.hxx>
 # include <Adaptor3d_HCurveOnSurface.hxx>
 # include <Geom_BSplineSurface.hxx>
 # include <Geom_Plane.hxx>
@@ -44,6 +59,8 @@
 # include <TColStd_ListIteratorOfListOfTransient.hxx>
 # include <TColgp_SequenceOfXY.hxx>
 # include <TColgp_SequenceOfXYZ.hxx>
+# include <TopExp_Explorer.hxx>
+# include <TopoDS_Compound.hxx>
 #endif
 
 #include <Base/Vector3D.h>
@@ -190,3 +207,215 @@ Part::Tools::makeSurface(const TColStd_ListOfTransient &theBoundaries,
 
     return aRes;
 }
+
+void Part::Tools::parallelFor(std::size_t count, const std::function<void(std::size_t)>& func,
+                              unsigned int numThreads)
+{
+    if (numThreads == 0)
+        numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    if (numThreads == 1 || count < 2) {
+        for (std::size_t i = 0; i < count; i++)
+            func(i);
+        return;
+    }
+
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < count; i = next++)
+            func(i);
+    };
+    std::vector<std::future<void> > workers;
+    for (unsigned int i = 0; i < std::min<std::size_t>(numThreads, count); i++)
+        workers.push_back(std::async(std::launch::async, worker));
+    // wait for all workers before an exception is passed on
+    std::exception_ptr error;
+    for (auto& it : workers) {
+        try {
+            it.get();
+        }
+        catch (...) {
+            if (!error)
+                error = std::current_exception();
+            next = count;
+        }
+    }
+    if (error)
+        std::rethrow_exception(error);
+}
+
+std::vector<TopoDS_Shape> Part::Tools::splitByProjection(const TopoDS_Shape& input, const gp_Ax2& viewAxis)
+{
+    std::vector<TopoDS_Shape> items;
+    for (TopExp_Explorer exp(input, TopAbs_SOLID); exp.More(); exp.Next()) {
+        items.push_back(exp.Current());
+    }
+    for (TopExp_Explorer exp(input, TopAbs_FACE, TopAbs_SOLID); exp.More(); exp.Next()) {
+        items.push_back(exp.Current());
+    }
+    for (TopExp_Explorer exp(input, TopAbs_EDGE, TopAbs_FACE); exp.More(); exp.Next()) {
+        items.push_back(exp.Current());
+    }
+    std::vector<TopoDS_Shape> groups;
+    if (items.size() < 2) {
+        return groups;
+    }
+
+    //extent of each item in the projection plane
+    const gp_Pnt& loc = viewAxis.Location();
+    const gp_Dir& xDir = viewAxis.XDirection();
+    const gp_Dir& yDir = viewAxis.YDirection();
+    std::vector<Bnd_Box2d> extents(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+        Bnd_Box box;
+        BRepBndLib::Add(items[i], box, false);
+        if (box.IsVoid()) {
+            continue;
+        }
+        double x[2], y[2], z[2];
+        box.Get(x[0], y[0], z[0], x[1], y[1], z[1]);
+        for (int c = 0; c < 8; c++) {
+            gp_Vec corner(loc, gp_Pnt(x[c & 1], y[(c >> 1) & 1], z[(c >> 2) & 1]));
+            extents[i].Add(gp_Pnt2d(corner.Dot(gp_Vec(xDir)), corner.Dot(gp_Vec(yDir))));
+        }
+        extents[i].Enlarge(Precision::Confusion());
+    }
+
+    //union find over the overlapping extents
+    std::vector<size_t> parent(items.size());
+    for (size_t i = 0; i < parent.size(); i++) {
+        parent[i] = i;
+    }
+    auto root = [&parent](size_t i) {
+        while (parent[i] != i) {
+            i = parent[i] = parent[parent[i]];
+        }
+        return i;
+    };
+    for (size_t i = 0; i < items.size(); i++) {
+        for (size_t j = i + 1; j < items.size(); j++) {
+            if (!extents[i].IsOut(extents[j])) {
+                parent[root(j)] = root(i);
+            }
+        }
+    }
+
+    BRep_Builder builder;
+    std::map<size_t, size_t> groupOfRoot;
+    for (size_t i = 0; i < items.size(); i++) {
+        size_t r = root(i);
+        auto it = groupOfRoot.find(r);
+        if (it == groupOfRoot.end()) {
+            it = groupOfRoot.insert(std::make_pair(r, groups.size())).first;
+            TopoDS_Compound comp;
+            builder.MakeCompound(comp);
+            groups.push_back(comp);
+        }
+        builder.Add(groups[it->second], items[i]);
+    }
+    if (groups.size() < 2) {
+        groups.clear();
+    }
+    return groups;
+}
+
+TopoDS_Shape Part::Tools::sewShapes(const std::vector<TopoDS_Shape>& shapes, double tolerance,
+                                    bool sewing, bool degenerate, bool cutFree, bool nonmanifold,
+                                    std::size_t clusterSize)
+{
+    std::vector<TopoDS_Shape> faces;
+    for (const auto& it : shapes) {
+        if (it.IsNull()) {
+            continue;
+        }
+        for (TopExp_Explorer exp(it, TopAbs_FACE); exp.More(); exp.Next()) {
+            faces.push_back(exp.Current());
+        }
+    }
+
+    //small inputs, analysis only and non-manifold sewing are done in one pass
+    clusterSize = std::max<std::size_t>(clusterSize, 1);
+    if (faces.size() <= 2 * clusterSize || !sewing || nonmanifold) {
+        BRepBuilderAPI_Sewing sew(tolerance, sewing, degenerate, cutFree, nonmanifold);
+        for (const auto& it : shapes) {
+            if (!it.IsNull()) {
+                sew.Add(it);
+            }
+        }
+        sew.Perform();
+        return sew.SewedShape();
+    }
+
+    //split the faces at the median of the longest side of their centers' box
+    //until the clusters are small enough
+    std::vector<gp_Pnt> centers(faces.size());
+    for (size_t i = 0; i < faces.size(); i++) {
+        Bnd_Box box;
+        BRepBndLib::Add(faces[i], box, false);
+        if (!box.IsVoid()) {
+            double x1, y1, z1, x2, y2, z2;
+            box.Get(x1, y1, z1, x2, y2, z2);
+            centers[i].SetCoord(0.5 * (x1 + x2), 0.5 * (y1 + y2), 0.5 * (z1 + z2));
+        }
+    }
+    std::vector<size_t> order(faces.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::vector<std::pair<size_t, size_t> > ranges;
+    std::vector<std::pair<size_t, size_t> > pending;
+    pending.emplace_back(0, order.size());
+    while (!pending.empty()) {
+        std::pair<size_t, size_t> range = pending.back();
+        pending.pop_back();
+        if (range.second - range.first <= clusterSize) {
+            ranges.push_back(range);
+            continue;
+        }
+        Bnd_Box box;
+        for (size_t i = range.first; i < range.second; i++) {
+            box.Add(centers[order[i]]);
+        }
+        double x1, y1, z1, x2, y2, z2;
+        box.Get(x1, y1, z1, x2, y2, z2);
+        int axis = 1;
+        if (y2 - y1 > x2 - x1)
+            axis = 2;
+        if (z2 - z1 > std::max(x2 - x1, y2 - y1))
+            axis = 3;
+        size_t mid = (range.first + range.second) / 2;
+        std::nth_element(order.begin() + range.first, order.begin() + mid, order.begin() + range.second,
+            [&centers, axis](size_t a, size_t b) {
+                return centers[a].Coord(axis) < centers[b].Coord(axis);
+            });
+        pending.emplace_back(range.first, mid);
+        pending.emplace_back(mid, range.second);
+    }
+
+    //each cluster is copied first because the clusters may share edges and
+    //sewing updates the tolerances of its sub-shapes
+    std::vector<TopoDS_Shape> sewed(ranges.size());
+    parallelFor(ranges.size(), [&](std::size_t index) {
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (size_t i = ranges[index].first; i < ranges[index].second; i++) {
+            builder.Add(comp, faces[order[i]]);
+        }
+        BRepBuilderAPI_Copy copy(comp);
+        BRepBuilderAPI_Sewing sew(tolerance, sewing, degenerate, cutFree, nonmanifold);
+        sew.Load(copy.Shape());
+        sew.Perform();
+        sewed[index] = sew.SewedShape();
+    });
+
+    //the edges inside the clusters are shared now, only the free edges
+    //along the cluster boundaries are left to the last pass
+    BRepBuilderAPI_Sewing sew(tolerance, sewing, degenerate, cutFree, nonmanifold);
+    for (const auto& it : sewed) {
+        if (!it.IsNull()) {
+            sew.Add(it);
+        }
+    }
+    sew.Perform();
+    return sew.SewedShape();
+}
@@ -24,6 +24,8 @@
 #ifndef PART_TOOLS_H
 #define PART_TOOLS_H
 
+#include <functional>
+#include <vector>
 #include <Base/Converter.h>
 #include <gp_Pnt.hxx>
 #include <gp_Vec.hxx>
@@ -32,8 +34,10 @@
 #include <Geom_Surface.hxx>
 #include <TColStd_ListOfTransient.hxx>
 
+class gp_Ax2;
 class gp_Lin;
 class gp_Pln;
+class TopoDS_Shape;
 
 namespace Base {
 // Specialization for gp_Pnt
@@ -105,6 +109,29 @@ public:
                                      const Standard_Integer theNbIter,
                                      const Standard_Integer theMaxDeg);
 
+    /** Calls \a func for the indices 0 to \a count-1 on \a numThreads threads.
+     * If \a numThreads is 0 the number of cores is used. The first exception
+     * thrown by \a func is passed on after all threads have finished.
+     */
+    static void parallelFor(std::size_t count, const std::function<void(std::size_t)>& func,
+                            unsigned int numThreads = 0);
+
+    /** Splits the solids, free faces and free edges of \a input into groups whose
+     * projections along \a viewAxis don't overlap. The groups can't hide each other,
+     * so each one can be passed to a hidden line removal on its own. If there are
+     * less than two groups an empty list is returned.
+     */
+    static std::vector<TopoDS_Shape> splitByProjection(const TopoDS_Shape& input, const gp_Ax2& viewAxis);
+
+    /** Sews the faces of \a shapes with BRepBuilderAPI_Sewing and the given options.
+     * If there are more than twice \a clusterSize faces they are grouped by
+     * proximity into clusters of at most \a clusterSize faces. The clusters are
+     * sewn in parallel and then their remaining free edges are sewn together.
+     */
+    static TopoDS_Shape sewShapes(const std::vector<TopoDS_Shape>& shapes, double tolerance,
+                                  bool sewing = true, bool degenerate = true,
+                                  bool cutFree = true, bool nonmanifold = false,
+                                  std::size_t clusterSize = 500);
 };
 
 } //namespace Part
@@ -28,6 +28,10 @@
 # include <array>
 # include <cmath>
 # include <cstdlib>
+# include <cstring>
+# include <limits>
+# include <map>
+# include <mutex>
 # include <sstream>
 # include <QString>
 
@@ -150,6 +154,8 @@
 # include <gp_Pln.hxx>
 # include <ShapeAnalysis_Shell.hxx>
 # include <ShapeBuild_ReShape.hxx>
+# include <Precision.hxx>
+# include <TopLoc_Location.hxx>
 # include <ShapeExtend_Explorer.hxx>
 # include <ShapeFix_Edge.hxx>
 # include <ShapeFix_Face.hxx>
@@ -195,10 +201,15 @@
 #include <Base/Exception.h>
 #include <Base/Tools.h>
 #include <Base/Console.h>
+#include <Base/Stream.h>
+#include <Base/Swap.h>
+#include <App/Application.h>
 #include <App/Material.h>
+#include <Base/Parameter.h>
 
 #include "PartPyCXX.h"
 #include "TopoShape.h"
+#include "BooleanOptions.h"
 #include "CrossSection.h"
 #include "TopoShapeFacePy.h"
 #include "TopoShapeEdgePy.h"
@@ -304,6 +315,77 @@ std::string ShapeSegment::getName() const
 
 // ------------------------------------------------
 
+struct TopoShape::Cache
+{
+    Cache(const TopoDS_Shape& shape)
+        : shape(shape)
+    {
+        for (int i = 0; i < TopAbs_SHAPE; i++)
+            built[i] = false;
+    }
+
+    /// The map of all sub-shapes of the given type. Once built, the map isn't
+    /// modified any more and thus can be read without locking.
+    const TopTools_IndexedMapOfShape& getMap(TopAbs_ShapeEnum type)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!built[type]) {
+            TopExp::MapShapes(shape, type, maps[type]);
+            built[type] = true;
+        }
+        return maps[type];
+    }
+
+    const TopTools_IndexedDataMapOfShapeListOfShape& getAncestors(TopAbs_ShapeEnum type,
+                                                                   TopAbs_ShapeEnum ancestor)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto key = std::make_pair(type, ancestor);
+        auto it = ancestors.find(key);
+        if (it == ancestors.end()) {
+            it = ancestors.insert(std::make_pair(key, TopTools_IndexedDataMapOfShapeListOfShape())).first;
+            TopExp::MapShapesAndAncestors(shape, type, ancestor, it->second);
+        }
+        return it->second;
+    }
+
+    /// The bounding box is asked for by view fitting, selection, links and
+    /// TechDraw layout, and BRepBndLib has to visit the whole shape for it.
+    Base::BoundBox3d getBoundBox()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!boxBuilt) {
+            try {
+                // If the shape is empty an exception may be thrown
+                Bnd_Box bounds;
+                BRepBndLib::Add(shape, bounds);
+                bounds.SetGap(0.0);
+                Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+                bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+
+                box.MinX = xMin;
+                box.MaxX = xMax;
+                box.MinY = yMin;
+                box.MaxY = yMax;
+                box.MinZ = zMin;
+                box.MaxZ = zMax;
+            }
+            catch (Standard_Failure&) {
+            }
+            boxBuilt = true;
+        }
+        return box;
+    }
+
+    TopoDS_Shape shape;
+    std::mutex mutex;
+    TopTools_IndexedMapOfShape maps[TopAbs_SHAPE];
+    bool built[TopAbs_SHAPE];
+    bool boxBuilt = false;
+    Base::BoundBox3d box;
+    std::map<std::pair<TopAbs_ShapeEnum, TopAbs_ShapeEnum>, TopTools_IndexedDataMapOfShapeListOfShape> ancestors;
+};
+
 TYPESYSTEM_SOURCE(Part::TopoShape , Data::ComplexGeoData)
 
 TopoShape::TopoShape()
@@ -321,10 +403,22 @@ TopoShape::TopoShape(const TopoDS_Shape& shape)
 
 TopoShape::TopoShape(const TopoShape& shape)
   : _Shape(shape._Shape)
+  , _Cache(std::atomic_load(&shape._Cache))
 {
     Tag = shape.Tag;
 }
 
+std::shared_ptr<TopoShape::Cache> TopoShape::getCache() const
+{
+    // The shape can be assigned directly, so check that the cache still belongs to it
+    std::shared_ptr<Cache> cache = std::atomic_load(&_Cache);
+    if (!cache || !cache->shape.IsEqual(_Shape)) {
+        cache = std::make_shared<Cache>(_Shape);
+        std::atomic_store(&_Cache, cache);
+    }
+    return cache;
+}
+
 std::vector<const char*> TopoShape::getElementTypes(void) const
 {
     static const std::vector<const char*> temp = {"Face","Edge","Vertex"};
@@ -372,8 +466,8 @@ TopoDS_Shape TopoShape::getSubShape(TopAbs_ShapeEnum type, int index, bool silen
                     return it.Value();
             }
         } else {
-            TopTools_IndexedMapOfShape anIndices;
-            TopExp::MapShapes(this->_Shape, type, anIndices);
+            auto cache = getCache();
+            const TopTools_IndexedMapOfShape& anIndices = cache->getMap(type);
             if(index <= anIndices.Extent())
                 return anIndices.FindKey(index);
         }
@@ -406,9 +500,7 @@ unsigned long TopoShape::countSubShapes(TopAbs_ShapeEnum Type) const
             ++count;
         return count;
     }
-    TopTools_IndexedMapOfShape anIndices;
-    TopExp::MapShapes(this->_Shape, Type, anIndices);
-    return anIndices.Extent();
+    return getCache()->getMap(Type).Extent();
 }
 
 bool TopoShape::hasSubShape(TopAbs_ShapeEnum type) const {
@@ -425,8 +517,32 @@ bool TopoShape::hasSubShape(const char *Type) const {
     return idx.second>0 && idx.second<=(int)countSubShapes(idx.first);
 }
 
+int TopoShape::findSubShapeIndex(const TopoDS_Shape& subshape) const
+{
+    if (_Shape.IsNull() || subshape.IsNull() || subshape.ShapeType() == TopAbs_SHAPE)
+        return 0;
+    return getCache()->getMap(subshape.ShapeType()).FindIndex(subshape);
+}
+
+std::vector<TopoDS_Shape> TopoShape::getAncestorShapes(const TopoDS_Shape& subshape, TopAbs_ShapeEnum type) const
+{
+    std::vector<TopoDS_Shape> shapes;
+    if (_Shape.IsNull() || subshape.IsNull() || type == TopAbs_SHAPE || subshape.ShapeType() == TopAbs_SHAPE)
+        return shapes;
+
+    auto cache = getCache();
+    const TopTools_IndexedDataMapOfShapeListOfShape& ancestors = cache->getAncestors(subshape.ShapeType(), type);
+    int index = ancestors.FindIndex(subshape);
+    if (index > 0) {
+        for (TopTools_ListIteratorOfListOfShape it(ancestors.FindFromIndex(index)); it.More(); it.Next())
+            shapes.push_back(it.Value());
+    }
+    return shapes;
+}
+
 template<class T>
-static inline std::vector<T> _getSubShapes(const TopoDS_Shape &s, TopAbs_ShapeEnum type) {
+static inline std::vector<T> _getSubShapes(const TopoDS_Shape &s, const TopTools_IndexedMapOfShape &anIndices,
+                                           TopAbs_ShapeEnum type) {
     std::vector<T> shapes;
     if(s.IsNull())
         return shapes;
@@ -437,8 +553,6 @@ static inline std::vector<T> _getSubShapes(const TopoDS_Shape &s, TopAbs_ShapeEn
         return shapes;
     }
 
-    TopTools_IndexedMapOfShape anIndices;
-    TopExp::MapShapes(s, type, anIndices);
     int count = anIndices.Extent();
     shapes.reserve(count);
     for(int i=1;i<=count;++i)
@@ -447,11 +561,17 @@ static inline std::vector<T> _getSubShapes(const TopoDS_Shape &s, TopAbs_ShapeEn
 }
 
 std::vector<TopoShape> TopoShape::getSubTopoShapes(TopAbs_ShapeEnum type) const {
-    return _getSubShapes<TopoShape>(_Shape,type);
+    if(_Shape.IsNull() || type == TopAbs_SHAPE)
+        return _getSubShapes<TopoShape>(_Shape,TopTools_IndexedMapOfShape(),type);
+    auto cache = getCache();
+    return _getSubShapes<TopoShape>(_Shape,cache->getMap(type),type);
 }
 
 std::vector<TopoDS_Shape> TopoShape::getSubShapes(TopAbs_ShapeEnum type) const {
-    return _getSubShapes<TopoDS_Shape>(_Shape,type);
+    if(_Shape.IsNull() || type == TopAbs_SHAPE)
+        return _getSubShapes<TopoDS_Shape>(_Shape,TopTools_IndexedMapOfShape(),type);
+    auto cache = getCache();
+    return _getSubShapes<TopoDS_Shape>(_Shape,cache->getMap(type),type);
 }
 
 static std::array<std::string,TopAbs_SHAPE> _ShapeNames;
@@ -612,6 +732,7 @@ void TopoShape::operator = (const TopoShape& sh)
     if (this != &sh) {
         this->Tag = sh.Tag;
         this->_Shape = sh._Shape;
+        std::atomic_store(&this->_Cache, std::atomic_load(&sh._Cache));
     }
 }
 
@@ -798,6 +919,15 @@ for (ex.Init(this->_Shape, TopAbs_FACE); ex.More(); ex.Next())
 }
 \endcode
 */
+/// The transfer of a reader cannot run in parallel, but the healing afterwards can
+static void fixImportedShape(TopoShape& shape)
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Import");
+    if (hGrp->GetBool("FixImportedShapes", false))
+        shape.fixSolids(Precision::Confusion(), Precision::Confusion(), hGrp->GetFloat("FixMaxTolerance", 1.0));
+}
+
 void TopoShape::importIges(const char *FileName)
 {
     try {
@@ -825,6 +955,7 @@ void TopoShape::importIges(const char *FileName)
 #if OCC_VERSION_HEX < 0x070500
         pi->EndScope();
 #endif
+        fixImportedShape(*this);
     }
     catch (Standard_Failure& e) {
         throw Base::CADKernelError(e.GetMessageString());
@@ -852,6 +983,7 @@ void TopoShape::importStep(const char *FileName)
 #if OCC_VERSION_HEX < 0x070500
         pi->EndScope();
 #endif
+        fixImportedShape(*this);
     }
     catch (Standard_Failure& e) {
         throw Base::CADKernelError(e.GetMessageString());
@@ -1028,10 +1160,16 @@ void TopoShape::exportBrep(std::ostream& out) const
     BRepTools::Write(this->_Shape, out);
 }
 
-void TopoShape::exportBinary(std::ostream& out)
+void TopoShape::exportBinary(std::ostream& out, bool withTriangles)
 {
     // An example how to use BinTools_ShapeSet can be found in BinMNaming_NamedShapeDriver.cxx
     BinTools_ShapeSet theShapeSet;
+#if OCC_VERSION_HEX >= 0x070600
+    theShapeSet.SetWithTriangles(withTriangles);
+#else
+    // older versions always write the triangulations
+    (void)withTriangles;
+#endif
     if (this->_Shape.IsNull()) {
         theShapeSet.Add(this->_Shape);
         theShapeSet.Write(out);
@@ -1056,8 +1194,19 @@ void TopoShape::dump(std::ostream& out) const
     BRepTools::Dump(this->_Shape, out);
 }
 
-void TopoShape::exportStl(const char *filename, double deflection) const
+void TopoShape::exportStl(const char *filename, double deflection, bool binary) const
 {
+    if (binary) {
+        Base::FileInfo fi(filename);
+        Base::ofstream str(fi, std::ios::out | std::ios::binary);
+        if (!str)
+            throw Base::FileException("Cannot open file for writing", fi);
+        exportBinaryStl(str, deflection);
+        if (!str)
+            throw Base::FileException("Writing of STL failed", fi);
+        return;
+    }
+
     StlAPI_Writer writer;
 #if OCC_VERSION_HEX < 0x060801
     if (deflection > 0) {
@@ -1074,6 +1223,102 @@ void TopoShape::exportStl(const char *filename, double deflection) const
     writer.Write(this->_Shape,encodeFilename(filename).c_str());
 }
 
+void TopoShape::exportBinaryStl(std::ostream& out, double deflection) const
+{
+    BRepMesh_IncrementalMesh aMesh(this->_Shape, deflection,
+                                   /*isRelative*/ Standard_False,
+                                   /*theAngDeflection*/
+                                   defaultAngularDeflection(deflection),
+                                   /*isInParallel*/ true);
+
+    // the facets of a face start at offsets[i] in the file
+    std::vector<TopoDS_Face> faces;
+    std::vector<std::size_t> offsets(1, 0);
+    for (TopExp_Explorer xp(this->_Shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        TopoDS_Face face = TopoDS::Face(xp.Current());
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, loc);
+        if (triangulation.IsNull())
+            continue;
+        faces.push_back(face);
+        offsets.push_back(offsets.back() + triangulation->NbTriangles());
+    }
+
+    if (offsets.back() > std::numeric_limits<uint32_t>::max())
+        throw Base::ValueError("Too many triangles for a binary STL file");
+
+    // binary STL is little endian
+    bool swap = (Base::SwapOrder() == HIGH_ENDIAN);
+    auto putFloat = [swap](char*& ptr, double value) {
+        float f = static_cast<float>(value);
+        if (swap)
+            Base::SwapEndian(f);
+        std::memcpy(ptr, &f, sizeof(f));
+        ptr += sizeof(f);
+    };
+
+    // the header must not start with 'solid' or the file is taken as ASCII STL
+    char header[80];
+    std::memset(header, ' ', sizeof(header));
+    const char* title = "MESH-BINARY-STL FreeCAD";
+    std::memcpy(header, title, std::strlen(title));
+    out.write(header, sizeof(header));
+
+    uint32_t count = static_cast<uint32_t>(offsets.back());
+    if (swap)
+        Base::SwapEndian(count);
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    // the faces are split into chunks of about chunkSize facets which are converted
+    // in parallel and then written, so that only one chunk is kept in memory
+    const std::size_t facetSize = 50;
+    const std::size_t chunkSize = 65536;
+    std::vector<char> buffer;
+    for (std::size_t first = 0; first < faces.size() && out; ) {
+        std::size_t last = first + 1;
+        while (last < faces.size() && offsets[last + 1] - offsets[first] <= chunkSize)
+            ++last;
+
+        buffer.resize((offsets[last] - offsets[first]) * facetSize);
+        Tools::parallelFor(last - first, [&](std::size_t index) {
+            const TopoDS_Face& face = faces[first + index];
+            TopLoc_Location loc;
+            Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(face, loc);
+            gp_Trsf trsf = loc.Transformation();
+            bool flip = (face.Orientation() == TopAbs_REVERSED);
+
+            const TColgp_Array1OfPnt& nodes = triangulation->Nodes();
+            const Poly_Array1OfTriangle& triangles = triangulation->Triangles();
+            char* ptr = buffer.data() + (offsets[first + index] - offsets[first]) * facetSize;
+            for (int i = triangles.Lower(); i <= triangles.Upper(); i++) {
+                Standard_Integer N1, N2, N3;
+                triangles(i).Get(N1, N2, N3);
+                if (flip)
+                    std::swap(N1, N2);
+
+                gp_Pnt p1 = nodes(N1).Transformed(trsf);
+                gp_Pnt p2 = nodes(N2).Transformed(trsf);
+                gp_Pnt p3 = nodes(N3).Transformed(trsf);
+                gp_Vec normal = gp_Vec(p1, p2).Crossed(gp_Vec(p1, p3));
+                Standard_Real length = normal.Magnitude();
+                if (length > gp::Resolution())
+                    normal /= length;
+
+                putFloat(ptr, normal.X()); putFloat(ptr, normal.Y()); putFloat(ptr, normal.Z());
+                putFloat(ptr, p1.X()); putFloat(ptr, p1.Y()); putFloat(ptr, p1.Z());
+                putFloat(ptr, p2.X()); putFloat(ptr, p2.Y()); putFloat(ptr, p2.Z());
+                putFloat(ptr, p3.X()); putFloat(ptr, p3.Y()); putFloat(ptr, p3.Z());
+                // attribute byte count
+                *ptr++ = 0;
+                *ptr++ = 0;
+            }
+        });
+
+        out.write(buffer.data(), buffer.size());
+        first = last;
+    }
+}
+
 void TopoShape::exportFaceSet(double dev, double ca,
                               const std::vector<App::Color>& colors,
                               std::ostream& str) const
@@ -1176,12 +1421,11 @@ void TopoShape::exportLineSet(std::ostream& str) const
 {
     Base::InventorBuilder builder(str);
     // get a indexed map of edges
-    TopTools_IndexedMapOfShape M;
-    TopExp::MapShapes(this->_Shape, TopAbs_EDGE, M);
+    auto cache = getCache();
+    const TopTools_IndexedMapOfShape& M = cache->getMap(TopAbs_EDGE);
 
     // build up map edge->face
-    TopTools_IndexedDataMapOfShapeListOfShape edge2Face;
-    TopExp::MapShapesAndAncestors(this->_Shape, TopAbs_EDGE, TopAbs_FACE, edge2Face);
+    const TopTools_IndexedDataMapOfShapeListOfShape& edge2Face = cache->getAncestors(TopAbs_EDGE, TopAbs_FACE);
     for (int i=0; i<M.Extent(); i++)
     {
         const TopoDS_Edge& aEdge = TopoDS::Edge(M(i+1));
@@ -1254,26 +1498,10 @@ void TopoShape::exportLineSet(std::ostream& str) const
 
 Base::BoundBox3d TopoShape::getBoundBox(void) const
 {
-    Base::BoundBox3d box;
-    try {
-        // If the shape is empty an exception may be thrown
-        Bnd_Box bounds;
-        BRepBndLib::Add(_Shape, bounds);
-        bounds.SetGap(0.0);
-        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
-        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
-
-        box.MinX = xMin;
-        box.MaxX = xMax;
-        box.MinY = yMin;
-        box.MaxY = yMax;
-        box.MinZ = zMin;
-        box.MaxZ = zMax;
-    }
-    catch (Standard_Failure&) {
-    }
-
-    return box;
+    if (_Shape.IsNull())
+        return Base::BoundBox3d();
+    // computed once per shape and shared by all copies
+    return getCache()->getBoundBox();
 }
 
 bool TopoShape::getCenterOfGravity(Base::Vector3d& center) const
@@ -1359,6 +1587,18 @@ unsigned int TopoShape::getMemSize (void) const
                     // first, last, tolerance
                     memsize += 5*sizeof(Standard_Real);
                     const TopoDS_Face& face = TopoDS::Face(shape);
+                    // the tessellation, which is often bigger than the geometry
+                    TopLoc_Location loc;
+                    Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(face, loc);
+                    if (!mesh.IsNull()) {
+                        memsize += sizeof(Poly_Triangulation);
+                        memsize += mesh->NbNodes() * sizeof(gp_Pnt);
+                        memsize += mesh->NbTriangles() * sizeof(Poly_Triangle);
+                        if (mesh->HasUVNodes())
+                            memsize += mesh->NbNodes() * sizeof(gp_Pnt2d);
+                        if (mesh->HasNormals())
+                            memsize += mesh->NbNodes() * 3 * sizeof(Standard_ShortReal);
+                    }
                     // if no geometry is attached to a face an exception is raised
                     BRepAdaptor_Surface surface;
                     try {
@@ -1415,6 +1655,14 @@ unsigned int TopoShape::getMemSize (void) const
                     // first, last, tolerance
                     memsize += 3*sizeof(Standard_Real);
                     const TopoDS_Edge& edge = TopoDS::Edge(shape);
+                    TopLoc_Location loc;
+                    Handle(Poly_Polygon3D) polygon = BRep_Tool::Polygon3D(edge, loc);
+                    if (!polygon.IsNull()) {
+                        memsize += sizeof(Poly_Polygon3D);
+                        memsize += polygon->NbNodes() * sizeof(gp_Pnt);
+                        if (polygon->HasParameters())
+                            memsize += polygon->NbNodes() * sizeof(Standard_Real);
+                    }
                     // if no geometry is attached to an edge an exception is raised
                     BRepAdaptor_Curve curve;
                     try {
@@ -1828,7 +2076,6 @@ TopoDS_Shape TopoShape::cut(const std::vector<TopoDS_Shape>& shapes, Standard_Re
     throw Base::RuntimeError("Multi cut is available only in OCC 6.9.0 and up.");
 #else
     BRepAlgoAPI_Cut mkCut;
-    mkCut.SetRunParallel(true);
     TopTools_ListOfShape shapeArguments,shapeTools;
     shapeArguments.Append(this->_Shape);
     for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
@@ -1841,11 +2088,7 @@ TopoDS_Shape TopoShape::cut(const std::vector<TopoDS_Shape>& shapes, Standard_Re
             shapeTools.Append(*it);
     }
 
-    mkCut.SetArguments(shapeArguments);
-    mkCut.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkCut.SetFuzzyValue(tolerance);
-    mkCut.Build();
+    BooleanOptions().build(mkCut, shapeArguments, shapeTools, tolerance);
     if (!mkCut.IsDone())
         throw Base::RuntimeError("Multi cut failed");
 
@@ -1874,7 +2117,6 @@ TopoDS_Shape TopoShape::common(const std::vector<TopoDS_Shape>& shapes, Standard
     throw Base::RuntimeError("Multi common is available only in OCC 6.9.0 and up.");
 #else
     BRepAlgoAPI_Common mkCommon;
-    mkCommon.SetRunParallel(true);
     TopTools_ListOfShape shapeArguments,shapeTools;
     shapeArguments.Append(this->_Shape);
     for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
@@ -1887,11 +2129,7 @@ TopoDS_Shape TopoShape::common(const std::vector<TopoDS_Shape>& shapes, Standard
             shapeTools.Append(*it);
     }
 
-    mkCommon.SetArguments(shapeArguments);
-    mkCommon.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkCommon.SetFuzzyValue(tolerance);
-    mkCommon.Build();
+    BooleanOptions().build(mkCommon, shapeArguments, shapeTools, tolerance);
     if (!mkCommon.IsDone())
         throw Base::RuntimeError("Multi common failed");
 
@@ -1932,9 +2170,6 @@ TopoDS_Shape TopoShape::fuse(const std::vector<TopoDS_Shape>& shapes, Standard_R
     }
 #else
     BRepAlgoAPI_Fuse mkFuse;
-# if OCC_VERSION_HEX >= 0x060900
-    mkFuse.SetRunParallel(true);
-# endif
     TopTools_ListOfShape shapeArguments,shapeTools;
     shapeArguments.Append(this->_Shape);
     for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
@@ -1946,11 +2181,7 @@ TopoDS_Shape TopoShape::fuse(const std::vector<TopoDS_Shape>& shapes, Standard_R
         else
             shapeTools.Append(*it);
     }
-    mkFuse.SetArguments(shapeArguments);
-    mkFuse.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkFuse.SetFuzzyValue(tolerance);
-    mkFuse.Build();
+    BooleanOptions().build(mkFuse, shapeArguments, shapeTools, tolerance);
     if (!mkFuse.IsDone())
         throw Base::RuntimeError("Multi fuse failed");
 
@@ -2042,11 +2273,8 @@ std::list<TopoDS_Wire> TopoShape::slice(const Base::Vector3d& dir, double d) con
 
 TopoDS_Compound TopoShape::slices(const Base::Vector3d& dir, const std::vector<double>& d) const
 {
-    std::vector< std::list<TopoDS_Wire> > wire_list;
     CrossSection cs(dir.x, dir.y, dir.z, this->_Shape);
-    for (std::vector<double>::const_iterator jt = d.begin(); jt != d.end(); ++jt) {
-        wire_list.push_back(cs.slice(*jt));
-    }
+    std::vector< std::list<TopoDS_Wire> > wire_list = cs.slices(d);
 
     std::vector< std::list<TopoDS_Wire> >::const_iterator ft;
     TopoDS_Compound comp;
@@ -2076,7 +2304,6 @@ TopoDS_Shape TopoShape::generalFuse(const std::vector<TopoDS_Shape> &sOthers, St
     throw Base::AttributeError("GFA is available only in OCC 6.9.0 and up.");
 #else
     BRepAlgoAPI_BuilderAlgo mkGFA;
-    mkGFA.SetRunParallel(true);
     TopTools_ListOfShape GFAArguments;
     GFAArguments.Append(this->_Shape);
     for (const TopoDS_Shape &it: sOthers) {
@@ -2091,9 +2318,10 @@ TopoDS_Shape TopoShape::generalFuse(const std::vector<TopoDS_Shape> &sOthers, St
     mkGFA.SetArguments(GFAArguments);
     if (tolerance > 0.0)
         mkGFA.SetFuzzyValue(tolerance);
-#if OCC_VERSION_HEX >= 0x070000
-    mkGFA.SetNonDestructive(Standard_True);
-#endif
+    // the arguments must stay unchanged to get their modifications
+    BooleanOptions options;
+    options.NonDestructive = true;
+    options.apply(mkGFA, GFAArguments, tolerance);
     mkGFA.Build();
     if (!mkGFA.IsDone())
         throw BooleanException("MultiFusion failed");
@@ -3226,11 +3454,8 @@ TopoDS_Shape TopoShape::removeShape(const std::vector<TopoDS_Shape>& s) const
 
 void TopoShape::sewShape()
 {
-    BRepBuilderAPI_Sewing sew;
-    sew.Load(this->_Shape);
-    sew.Perform();
-
-    this->_Shape = sew.SewedShape();
+    // default tolerance and options of BRepBuilderAPI_Sewing
+    this->_Shape = Tools::sewShapes(std::vector<TopoDS_Shape>(1, this->_Shape), 1.0e-06);
 }
 
 bool TopoShape::fix(double precision, double mintol, double maxtol)
@@ -3277,6 +3502,68 @@ bool TopoShape::fix(double precision, double mintol, double maxtol)
     return isValid();
 }
 
+bool TopoShape::fixSolids(double precision, double mintol, double maxtol)
+{
+    if (this->_Shape.IsNull())
+        return false;
+
+    TopTools_IndexedMapOfShape solids;
+    for (TopExp_Explorer xp(this->_Shape, TopAbs_SOLID); xp.More(); xp.Next())
+        solids.Add(xp.Current().Located(TopLoc_Location()));
+    if (solids.Extent() < 2)
+        return fix(precision, mintol, maxtol);
+
+    // Fixing a solid may change its sub-shapes in place, e.g. the tolerances of
+    // vertices. So solids that share a vertex are fixed one after the other.
+    std::vector<std::vector<int> > batches;
+    std::vector<TopTools_MapOfShape> batchVertices;
+    for (int i = 1; i <= solids.Extent(); i++) {
+        TopTools_IndexedMapOfShape vertices;
+        TopExp::MapShapes(solids(i), TopAbs_VERTEX, vertices);
+        std::size_t batch = 0;
+        for (; batch < batches.size(); batch++) {
+            bool shared = false;
+            for (int j = 1; j <= vertices.Extent() && !shared; j++)
+                shared = batchVertices[batch].Contains(vertices(j));
+            if (!shared)
+                break;
+        }
+        if (batch == batches.size()) {
+            batches.emplace_back();
+            batchVertices.emplace_back();
+        }
+        batches[batch].push_back(i);
+        for (int j = 1; j <= vertices.Extent(); j++)
+            batchVertices[batch].Add(vertices(j));
+    }
+
+    std::vector<TopoDS_Shape> fixed(solids.Extent() + 1);
+    for (const auto& batch : batches) {
+        Tools::parallelFor(batch.size(), [&](std::size_t i) {
+            ShapeFix_Shape fix(solids(batch[i]));
+            fix.SetPrecision(precision);
+            fix.SetMinTolerance(mintol);
+            fix.SetMaxTolerance(maxtol);
+            fix.Perform();
+            fixed[batch[i]] = fix.Shape();
+        });
+    }
+
+    // all placed instances of a solid are replaced
+    Handle(ShapeBuild_ReShape) reshape = new ShapeBuild_ReShape();
+    bool modified = false;
+    for (int i = 1; i <= solids.Extent(); i++) {
+        if (!fixed[i].IsNull() && !fixed[i].IsSame(solids(i))) {
+            reshape->Replace(solids(i), fixed[i]);
+            modified = true;
+        }
+    }
+    if (modified)
+        this->_Shape = reshape->Apply(this->_Shape);
+
+    return isValid();
+}
+
 bool TopoShape::removeInternalWires(double minArea)
 {
     ShapeUpgrade_RemoveInternalWires fix(this->_Shape);
@@ -3381,27 +3668,27 @@ TopoDS_Shape TopoShape::removeSplitter() const
 
 void TopoShape::getDomains(std::vector<Domain>& domains) const
 {
-    std::size_t countFaces = 0;
+    std::vector<TopoDS_Face> shapeFaces;
     for (TopExp_Explorer xp(this->_Shape, TopAbs_FACE); xp.More(); xp.Next()) {
-        ++countFaces;
+        shapeFaces.push_back(TopoDS::Face(xp.Current()));
     }
-    domains.reserve(countFaces);
 
-    for (TopExp_Explorer xp(this->_Shape, TopAbs_FACE); xp.More(); xp.Next()) {
-        TopoDS_Face face = TopoDS::Face(xp.Current());
+    // For a face that cannot be meshed an empty domain is appended.
+    // It's important for some algorithms (e.g. color mapping) that the numbers of
+    // faces and domains match
+    std::size_t offset = domains.size();
+    domains.resize(offset + shapeFaces.size());
+
+    // the triangulations are only read, so the domains can be filled in parallel
+    Tools::parallelFor(shapeFaces.size(), [&](std::size_t index) {
+        const TopoDS_Face& face = shapeFaces[index];
 
         TopLoc_Location loc;
         Handle(Poly_Triangulation) theTriangulation = BRep_Tool::Triangulation(face, loc);
-        if (theTriangulation.IsNull()) {
-            // For a face that cannot be meshed append an empty domain.
-            // It's important for some algorithms (e.g. color mapping) that the numbers of
-            // faces and domains match
-            Domain domain;
-            domains.push_back(domain);
-            continue;
-        }
+        if (theTriangulation.IsNull())
+            return;
 
-        Domain domain;
+        Domain& domain = domains[offset + index];
         // copy the points
         const TColgp_Array1OfPnt& points = theTriangulation->Nodes();
         domain.points.reserve(points.Length());
@@ -3428,9 +3715,7 @@ void TopoShape::getDomains(std::vector<Domain>& domains) const
                 std::swap(tria.I1, tria.I2);
             domain.facets.push_back(tria);
         }
-
-        domains.push_back(domain);
-    }
+    });
 }
 
 namespace Part {
@@ -3471,6 +3756,170 @@ private:
 //const double Vertex::MESH_MIN_PT_DIST = 1.0e-6;
 const double MeshVertex::MESH_MIN_PT_DIST = gp::Resolution();
 
+namespace {
+struct FaceTriangulation
+{
+    TopoDS_Face face;
+    TopLoc_Location loc;
+    Handle(Poly_Triangulation) triangulation;
+    // global point index of each node, npos for the inner nodes
+    std::vector<std::size_t> nodes;
+    std::size_t firstPoint = 0;
+    std::size_t firstFacet = 0;
+};
+}
+
+// Merges the triangulations of all faces into one mesh. The nodes on the edges
+// and vertices are shared with the adjacent faces, so they are welded by the
+// topology instead of searching for coincident points. The inner nodes and the
+// triangles of the faces are copied in parallel. Returns false if a face lacks
+// the polygon of one of its edges or two faces disagree about an edge, in
+// which case the caller has to weld the points by their coordinates.
+static bool mergeTriangulations(const TopoDS_Shape &shape,
+                                std::vector<Base::Vector3d> &points,
+                                std::vector<TopoShape::Facet> &facets)
+{
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    TopTools_IndexedMapOfShape vertexMap, edgeMap;
+    TopExp::MapShapes(shape, TopAbs_VERTEX, vertexMap);
+    TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+
+    points.resize(vertexMap.Extent());
+    std::vector<bool> vertexDone(vertexMap.Extent(), false);
+    // first point index of the inner nodes of an edge and its number of nodes
+    std::vector<std::size_t> edgeFirst(edgeMap.Extent(), 0);
+    std::vector<int> edgeNodes(edgeMap.Extent(), -1);
+
+    std::vector<FaceTriangulation> faces;
+    std::size_t numFacets = 0;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        FaceTriangulation data;
+        data.face = TopoDS::Face(xp.Current());
+        data.triangulation = BRep_Tool::Triangulation(data.face, data.loc);
+        if (data.triangulation.IsNull())
+            continue;
+
+        const TColgp_Array1OfPnt& nodes = data.triangulation->Nodes();
+        gp_Trsf trsf = data.loc.Transformation();
+        data.nodes.assign(nodes.Length(), npos);
+
+        auto setNode = [&](int node, std::size_t index) {
+            if (node < 1 || node > nodes.Length())
+                return false;
+            data.nodes[node-1] = index;
+            return true;
+        };
+        auto setVertex = [&](int node, const TopoDS_Vertex& vertex) {
+            std::size_t index = vertexMap.FindIndex(vertex) - 1;
+            if (!setNode(node, index))
+                return false;
+            if (!vertexDone[index]) {
+                vertexDone[index] = true;
+                points[index] = Base::convertTo<Base::Vector3d>(nodes(node).Transformed(trsf));
+            }
+            return true;
+        };
+
+        for (TopExp_Explorer xe(data.face, TopAbs_EDGE); xe.More(); xe.Next()) {
+            const TopoDS_Edge& edge = TopoDS::Edge(xe.Current());
+            Handle(Poly_PolygonOnTriangulation) polygon =
+                BRep_Tool::PolygonOnTriangulation(edge, data.triangulation, data.loc);
+            if (polygon.IsNull())
+                return false;
+
+            const TColStd_Array1OfInteger& indices = polygon->Nodes();
+            int count = indices.Length();
+            if (count < 2)
+                return false;
+
+            TopoDS_Vertex v1, v2;
+            TopExp::Vertices(edge, v1, v2);
+            if (v1.IsNull() || v2.IsNull())
+                return false;
+
+            if (BRep_Tool::Degenerated(edge)) {
+                for (int i = indices.Lower(); i <= indices.Upper(); i++) {
+                    if (!setVertex(indices(i), v1))
+                        return false;
+                }
+                continue;
+            }
+
+            int edgeIndex = edgeMap.FindIndex(edge) - 1;
+            if (edgeNodes[edgeIndex] < 0) {
+                edgeNodes[edgeIndex] = count;
+                edgeFirst[edgeIndex] = points.size();
+                for (int i = indices.Lower() + 1; i < indices.Upper(); i++)
+                    points.push_back(Base::convertTo<Base::Vector3d>(nodes(indices(i)).Transformed(trsf)));
+            }
+            else if (edgeNodes[edgeIndex] != count) {
+                return false;
+            }
+            else if (count > 2) {
+                // the nodes of both faces must run in the same direction
+                gp_Pnt p = nodes(indices(indices.Lower() + 1)).Transformed(trsf);
+                double tol = BRep_Tool::Tolerance(edge) + Precision::Confusion();
+                if (Base::convertTo<gp_Pnt>(points[edgeFirst[edgeIndex]]).Distance(p) > tol)
+                    return false;
+            }
+
+            if (!setVertex(indices(indices.Lower()), v1) ||
+                !setVertex(indices(indices.Upper()), v2))
+                return false;
+            for (int i = 1; i < count - 1; i++) {
+                if (!setNode(indices(indices.Lower() + i), edgeFirst[edgeIndex] + i - 1))
+                    return false;
+            }
+        }
+
+        data.firstFacet = numFacets;
+        numFacets += data.triangulation->NbTriangles();
+        faces.push_back(data);
+    }
+
+    // the inner nodes of the faces follow the nodes of the edges
+    std::size_t numPoints = points.size();
+    for (auto& data : faces) {
+        data.firstPoint = numPoints;
+        numPoints += std::count(data.nodes.begin(), data.nodes.end(), npos);
+    }
+    points.resize(numPoints);
+    facets.resize(numFacets);
+
+    Tools::parallelFor(faces.size(), [&](std::size_t index) {
+        FaceTriangulation& data = faces[index];
+        const TColgp_Array1OfPnt& nodes = data.triangulation->Nodes();
+        gp_Trsf trsf = data.loc.Transformation();
+        std::size_t next = data.firstPoint;
+        for (std::size_t i = 0; i < data.nodes.size(); i++) {
+            if (data.nodes[i] == npos) {
+                points[next] = Base::convertTo<Base::Vector3d>(nodes(i + 1).Transformed(trsf));
+                data.nodes[i] = next++;
+            }
+        }
+
+        bool flip = (data.face.Orientation() == TopAbs_REVERSED);
+        const Poly_Array1OfTriangle& triangles = data.triangulation->Triangles();
+        TopoShape::Facet* facet = &facets[data.firstFacet];
+        for (int i = triangles.Lower(); i <= triangles.Upper(); i++, facet++) {
+            Standard_Integer N1, N2, N3;
+            triangles(i).Get(N1, N2, N3);
+            facet->I1 = static_cast<uint32_t>(data.nodes[N1-1]);
+            facet->I2 = static_cast<uint32_t>(data.nodes[N2-1]);
+            facet->I3 = static_cast<uint32_t>(data.nodes[N3-1]);
+            if (flip)
+                std::swap(facet->I1, facet->I2);
+        }
+    });
+
+    // make sure that we don't keep invalid facets, e.g. at degenerated edges
+    facets.erase(std::remove_if(facets.begin(), facets.end(), [](const TopoShape::Facet& f) {
+        return f.I1 == f.I2 || f.I2 == f.I3 || f.I3 == f.I1;
+    }), facets.end());
+    return true;
+}
+
 void TopoShape::getFaces(std::vector<Base::Vector3d> &aPoints,
                          std::vector<Facet> &aTopo,
                          float accuracy, uint16_t /*flags*/) const
@@ -3478,12 +3927,33 @@ void TopoShape::getFaces(std::vector<Base::Vector3d> &aPoints,
     if (this->_Shape.IsNull())
         return;
 
+    // reuse the triangulation of the faces if it's accurate enough
+    bool meshed = true;
+    for (TopExp_Explorer xp(this->_Shape, TopAbs_FACE); xp.More() && meshed; xp.Next()) {
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) triangulation = BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc);
+        meshed = !triangulation.IsNull() && triangulation->Deflection() <= accuracy;
+    }
+
     // get the meshes of all faces and then merge them
-    BRepMesh_IncrementalMesh aMesh(this->_Shape, accuracy,
-                                   /*isRelative*/ Standard_False,
-                                   /*theAngDeflection*/
-                                   defaultAngularDeflection(accuracy),
-                                   /*isInParallel*/ true);
+    if (!meshed) {
+        BRepMesh_IncrementalMesh aMesh(this->_Shape, accuracy,
+                                       /*isRelative*/ Standard_False,
+                                       /*theAngDeflection*/
+                                       defaultAngularDeflection(accuracy),
+                                       /*isInParallel*/ true);
+    }
+
+    {
+        std::vector<Base::Vector3d> points;
+        std::vector<Facet> facets;
+        if (mergeTriangulations(this->_Shape, points, facets)) {
+            aPoints.swap(points);
+            aTopo.insert(aTopo.end(), facets.begin(), facets.end());
+            return;
+        }
+    }
+
     std::vector<Domain> domains;
     getDomains(domains);
 
@@ -3752,8 +4222,8 @@ void TopoShape::getLinesFromSubelement(const Data::Segment* element,
         }
 
         // build up map edge->face
-        TopTools_IndexedDataMapOfShapeListOfShape edge2Face;
-        TopExp::MapShapesAndAncestors(this->_Shape, TopAbs_EDGE, TopAbs_FACE, edge2Face);
+        auto cache = getCache();
+        const TopTools_IndexedDataMapOfShapeListOfShape& edge2Face = cache->getAncestors(TopAbs_EDGE, TopAbs_FACE);
 
         for(TopExp_Explorer exp(shape,TopAbs_EDGE);exp.More();exp.Next()) {
 
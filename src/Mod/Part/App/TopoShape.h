@@ -25,6 +25,7 @@
 #define PART_TOPOSHAPE_H
 
 #include <iosfwd>
+#include <memory>
 #include <TopoDS_Compound.hxx>
 #include <TopoDS_Wire.hxx>
 #include <TopTools_ListOfShape.hxx>
@@ -97,6 +98,7 @@ public:
 
     inline void setShape(const TopoDS_Shape& shape) {
         this->_Shape = shape;
+        std::atomic_store(&this->_Cache, std::shared_ptr<Cache>());
     }
 
     inline const TopoDS_Shape& getShape() const {
@@ -155,6 +157,10 @@ public:
     unsigned long countSubShapes(TopAbs_ShapeEnum type) const;
     bool hasSubShape(const char *Type) const;
     bool hasSubShape(TopAbs_ShapeEnum type) const;
+    /// Returns the index of the sub-shape within its type, e.g. n of "Face<n>", or 0 if it isn't one
+    int findSubShapeIndex(const TopoDS_Shape& subshape) const;
+    /// Returns the ancestors of the given type of a sub-shape, e.g. the faces of an edge
+    std::vector<TopoDS_Shape> getAncestorShapes(const TopoDS_Shape& subshape, TopAbs_ShapeEnum type) const;
     /// get the Topo"sub"Shape with the given name
     PyObject * getPySubShape(const char* Type, bool silent=false) const;
     PyObject * getPyObject();
@@ -184,8 +190,16 @@ public:
     void exportStep(const char *FileName) const;
     void exportBrep(const char *FileName) const;
     void exportBrep(std::ostream&) const;
-    void exportBinary(std::ostream&);
-    void exportStl (const char *FileName, double deflection) const;
+    /// If \a withTriangles is true the triangulations of the faces are written, too
+    void exportBinary(std::ostream&, bool withTriangles=false);
+    /** Writes the shape as STL file. If \a binary is true the faces are tessellated in
+     * parallel and their facets are streamed into the file, see exportBinaryStl().
+     */
+    void exportStl (const char *FileName, double deflection, bool binary=false) const;
+    /** Writes the triangulation of the faces as binary STL to \a out. The facets are
+     * converted in parallel chunk by chunk, so no mesh of the whole shape is built.
+     */
+    void exportBinaryStl(std::ostream& out, double deflection) const;
     void exportFaceSet(double, double, const std::vector<App::Color>&, std::ostream&) const;
     void exportLineSet(std::ostream&) const;
     //@}
@@ -284,6 +298,12 @@ public:
     TopoDS_Shape removeShape(const std::vector<TopoDS_Shape>& s) const;
     void sewShape();
     bool fix(double, double, double);
+    /** Fixes every solid of the shape with ShapeFix_Shape.
+     * Solids that occur several times are only fixed once and independent
+     * solids are fixed in parallel. This is much faster than fix() for a large
+     * assembly.
+     */
+    bool fixSolids(double precision, double mintol, double maxtol);
     bool removeInternalWires(double);
     TopoDS_Shape removeSplitter() const;
     TopoDS_Shape defeaturing(const std::vector<TopoDS_Shape>& s) const;
@@ -365,8 +385,16 @@ public:
     static const std::string &shapeName(TopAbs_ShapeEnum type,bool silent=false);
     const std::string &shapeName(bool silent=false) const;
     static std::pair<TopAbs_ShapeEnum,int> shapeTypeAndIndex(const char *name);
+private:
+    /** Index maps of the sub-shapes that are built on demand. The cache is shared
+     * between copies and is rebuilt once the shape has been replaced.
+     */
+    struct Cache;
+    std::shared_ptr<Cache> getCache() const;
+
 private:
     TopoDS_Shape _Shape;
+    mutable std::shared_ptr<Cache> _Cache;
 };
 
 } //namespace Part
@@ -581,15 +581,17 @@ PyObject*  TopoShapePy::__setstate__(PyObject *args) {
 PyObject*  TopoShapePy::exportStl(PyObject *args)
 {
     double deflection = 0.01;
+    PyObject* binary = Py_False;
     char* Name;
-    if (!PyArg_ParseTuple(args, "et|d","utf-8",&Name,&deflection))
+    if (!PyArg_ParseTuple(args, "et|dO!","utf-8",&Name,&deflection,&PyBool_Type,&binary))
         return NULL;
     std::string EncodedName = std::string(Name);
     PyMem_Free(Name);
 
     try {
         // write stl file
-        getTopoShapePtr()->exportStl(EncodedName.c_str(), deflection);
+        getTopoShapePtr()->exportStl(EncodedName.c_str(), deflection,
+                                     PyObject_IsTrue(binary) ? true : false);
     }
     catch (const Base::Exception& e) {
         PyErr_SetString(PartExceptionOCCError,e.what());
@@ -26,6 +26,7 @@
 #ifndef _PreComp_
 # include <algorithm>
 # include <iterator>
+# include <thread>
 # include <Geom_Surface.hxx>
 # include <Geom_RectangularTrimmedSurface.hxx>
 # include <GeomAdaptor_Surface.hxx>
@@ -53,6 +54,8 @@
 # include <ShapeFix_Face.hxx>
 # include <TopTools_ListOfShape.hxx>
 # include <TopTools_ListIteratorOfListOfShape.hxx>
+# include <TopTools_DataMapOfShapeInteger.hxx>
+# include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfShapeShape.hxx>
 # include <TopTools_DataMapIteratorOfDataMapOfIntegerListOfShape.hxx>
 # include <BRep_Builder.hxx>
@@ -74,6 +77,7 @@
 #include <Base/Tools.h>
 
 #include "modelRefine.h"
+#include "Tools.h"
 
 
 using namespace ModelRefine;
@@ -90,7 +94,11 @@ void ModelRefine::getFaceEdges(const TopoDS_Face &face, EdgeVectorType &edges)
 void ModelRefine::boundaryEdges(const FaceVectorType &faces, EdgeVectorType &edgesOut)
 {
     //this finds all the boundary edges. Maybe more than one boundary.
-    std::list<TopoDS_Edge> edges;
+    //An edge that is found twice is shared by two faces and removed again. The map
+    //holds the position of the edges that are currently in the list.
+    EdgeVectorType edges;
+    std::vector<bool> removed;
+    TopTools_DataMapOfShapeInteger positions;
     FaceVectorType::const_iterator faceIt;
     for (faceIt = faces.begin(); faceIt != faces.end(); ++faceIt)
     {
@@ -99,24 +107,24 @@ void ModelRefine::boundaryEdges(const FaceVectorType &faces, EdgeVectorType &edg
         getFaceEdges(*faceIt, faceEdges);
         for (faceEdgesIt = faceEdges.begin(); faceEdgesIt != faceEdges.end(); ++faceEdgesIt)
         {
-            bool foundSignal(false);
-            std::list<TopoDS_Edge>::iterator edgesIt;
-            for (edgesIt = edges.begin(); edgesIt != edges.end(); ++edgesIt)
+            if (positions.IsBound(*faceEdgesIt))
             {
-                if ((*edgesIt).IsSame(*faceEdgesIt))
-                {
-                    edgesIt = edges.erase(edgesIt);
-                    foundSignal = true;
-                    break;
-                }
+                removed[positions.Find(*faceEdgesIt)] = true;
+                positions.UnBind(*faceEdgesIt);
+                continue;
             }
-            if (!foundSignal)
-                edges.push_back(*faceEdgesIt);
+            positions.Bind(*faceEdgesIt, static_cast<Standard_Integer>(edges.size()));
+            edges.push_back(*faceEdgesIt);
+            removed.push_back(false);
         }
     }
 
-    edgesOut.reserve(edges.size());
-    std::copy(edges.begin(), edges.end(), back_inserter(edgesOut));
+    edgesOut.reserve(positions.Extent());
+    for (std::size_t index = 0; index < edges.size(); ++index)
+    {
+        if (!removed[index])
+            edgesOut.push_back(edges[index]);
+    }
 }
 
 TopoDS_Shell ModelRefine::removeFaces(const TopoDS_Shell &shell, const FaceVectorType &faces)
@@ -130,6 +138,71 @@ TopoDS_Shell ModelRefine::removeFaces(const TopoDS_Shell &shell, const FaceVecto
 
 namespace ModelRefine
 {
+    /// Indexes the edges by their first vertex to chain them to boundaries without
+    /// searching all remaining edges for every link
+    class EdgeChainer
+    {
+    public:
+        EdgeChainer(const EdgeVectorType &edgesIn) : edges(edgesIn), used(edgesIn.size(), false),
+            remaining(edgesIn.size()), front(0), back(edgesIn.size())
+        {
+            for (std::size_t index = 0; index < edges.size(); ++index)
+            {
+                TopoDS_Vertex vertex = TopExp::FirstVertex(edges[index], Standard_True);
+                if (vertex.IsNull())
+                    continue;
+                int vertexIndex = vertices.Add(vertex);
+                if (vertexIndex > static_cast<int>(starting.size()))
+                    starting.resize(vertexIndex);
+                starting[vertexIndex - 1].push_back(index);
+            }
+        }
+        bool empty() const {return remaining == 0;}
+        /// the first and last edge in the input order that is not used yet
+        std::size_t first()
+        {
+            while (used[front])
+                ++front;
+            return front;
+        }
+        std::size_t last()
+        {
+            while (used[back - 1])
+                --back;
+            return back - 1;
+        }
+        /// the first unused edge that starts at \a vertex and is not the same as \a skip
+        bool next(const TopoDS_Vertex &vertex, std::size_t &index, const TopoDS_Edge *skip = nullptr) const
+        {
+            int vertexIndex = vertex.IsNull() ? 0 : vertices.FindIndex(vertex);
+            if (vertexIndex == 0)
+                return false;
+            for (std::size_t candidate : starting[vertexIndex - 1])
+            {
+                if (used[candidate] || (skip && edges[candidate].IsSame(*skip)))
+                    continue;
+                index = candidate;
+                return true;
+            }
+            return false;
+        }
+        const TopoDS_Edge& take(std::size_t index)
+        {
+            used[index] = true;
+            --remaining;
+            return edges[index];
+        }
+
+    private:
+        const EdgeVectorType &edges;
+        std::vector<bool> used;
+        std::size_t remaining;
+        std::size_t front;
+        std::size_t back;
+        TopTools_IndexedMapOfShape vertices;
+        std::vector<std::vector<std::size_t> > starting;
+    };
+
     class WireSort
     {
     public:
@@ -307,15 +380,14 @@ void FaceTypedBase::boundarySplit(const FaceVectorType &facesIn, std::vector<Edg
     EdgeVectorType bEdges;
     boundaryEdges(facesIn, bEdges);
 
-    std::list<TopoDS_Edge> edges;
-    std::copy(bEdges.begin(), bEdges.end(), back_inserter(edges));
+    EdgeChainer edges(bEdges);
     while(!edges.empty())
     {
-        TopoDS_Vertex destination = TopExp::FirstVertex(edges.front(), Standard_True);
-        TopoDS_Vertex lastVertex = TopExp::LastVertex(edges.front(), Standard_True);
+        const TopoDS_Edge &start = edges.take(edges.first());
+        TopoDS_Vertex destination = TopExp::FirstVertex(start, Standard_True);
+        TopoDS_Vertex lastVertex = TopExp::LastVertex(start, Standard_True);
         EdgeVectorType boundary;
-        boundary.push_back(edges.front());
-        edges.pop_front();
+        boundary.push_back(start);
         //single edge closed check.
         if (destination.IsSame(lastVertex))
         {
@@ -324,24 +396,17 @@ void FaceTypedBase::boundarySplit(const FaceVectorType &facesIn, std::vector<Edg
         }
 
         bool closedSignal(false);
-        std::list<TopoDS_Edge>::iterator it;
-        for (it = edges.begin(); it != edges.end();)
+        std::size_t index;
+        while (edges.next(lastVertex, index))
         {
-            TopoDS_Vertex currentVertex = TopExp::FirstVertex(*it, Standard_True);
-            if (lastVertex.IsSame(currentVertex))
+            const TopoDS_Edge &current = edges.take(index);
+            boundary.push_back(current);
+            lastVertex = TopExp::LastVertex(current, Standard_True);
+            if (lastVertex.IsSame(destination))
             {
-                boundary.push_back(*it);
-                lastVertex = TopExp::LastVertex(*it, Standard_True);
-                edges.erase(it);
-                it = edges.begin();
-                if (lastVertex.IsSame(destination))
-                {
-                    closedSignal = true;
-                    break;
-                }
-                continue;
+                closedSignal = true;
+                break;
             }
-            ++it;
         }
         if (closedSignal)
             boundariesOut.push_back(boundary);
@@ -727,57 +792,37 @@ void FaceTypedCylinder::boundarySplit(const FaceVectorType &facesIn, std::vector
     EdgeVectorType normalEdges;
     ModelRefine::boundaryEdges(facesIn, normalEdges);
 
-    std::list<TopoDS_Edge> sortedEdges;
-    std::copy(normalEdges.begin(), normalEdges.end(), back_inserter(sortedEdges));
-
+    EdgeChainer sortedEdges(normalEdges);
     while (!sortedEdges.empty())
     {
-        TopoDS_Vertex destination = TopExp::FirstVertex(sortedEdges.back(), Standard_True);
-        TopoDS_Vertex lastVertex = TopExp::LastVertex(sortedEdges.back(), Standard_True);
+        const TopoDS_Edge &start = sortedEdges.take(sortedEdges.last());
+        TopoDS_Vertex destination = TopExp::FirstVertex(start, Standard_True);
+        TopoDS_Vertex lastVertex = TopExp::LastVertex(start, Standard_True);
         bool closedSignal(false);
-        std::list<TopoDS_Edge> boundary;
-        boundary.push_back(sortedEdges.back());
-        sortedEdges.pop_back();
+        EdgeVectorType boundary;
+        boundary.push_back(start);
 
         if (destination.IsSame(lastVertex)) {
             // Single circular edge
             closedSignal = true;
         } else {
-            std::list<TopoDS_Edge>::iterator sortedIt;
-            for (sortedIt = sortedEdges.begin(); sortedIt != sortedEdges.end();)
+            //Seam edges lie on top of each other. i.e. same. and we remove every match from the list
+            //so we don't actually ever compare the same edge.
+            std::size_t index;
+            while (sortedEdges.next(lastVertex, index, &boundary.back()))
             {
-                TopoDS_Vertex currentVertex = TopExp::FirstVertex(*sortedIt, Standard_True);
-
-                //Seam edges lie on top of each other. i.e. same. and we remove every match from the list
-                //so we don't actually ever compare the same edge.
-                if ((*sortedIt).IsSame(boundary.back()))
-                {
-                    ++sortedIt;
-                    continue;
-                }
-                if (lastVertex.IsSame(currentVertex))
+                const TopoDS_Edge &current = sortedEdges.take(index);
+                boundary.push_back(current);
+                lastVertex = TopExp::LastVertex(current, Standard_True);
+                if (lastVertex.IsSame(destination))
                 {
-                    boundary.push_back(*sortedIt);
-                    lastVertex = TopExp::LastVertex(*sortedIt, Standard_True);
-                    if (lastVertex.IsSame(destination))
-                    {
-                        closedSignal = true;
-                        sortedEdges.erase(sortedIt);
-                        break;
-                    }
-                    sortedEdges.erase(sortedIt);
-                    sortedIt = sortedEdges.begin();
-                    continue;
+                    closedSignal = true;
+                    break;
                 }
-                ++sortedIt;
             }
         }
         if (closedSignal)
-        {
-            EdgeVectorType temp;
-            std::copy(boundary.begin(), boundary.end(), std::back_inserter(temp));
-            boundariesOut.push_back(temp);
-        }
+            boundariesOut.push_back(boundary);
     }
 }
 
@@ -1018,6 +1063,67 @@ FaceTypedBSpline& ModelRefine::getBSplineObject()
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace ModelRefine
+{
+    struct FaceGroup
+    {
+        FaceTypedBase *typeObject;
+        FaceVectorType faces;
+        TopoDS_Face newFace;
+    };
+
+    /// Builds the united faces of the groups.
+    /// Building a face may update the edges and vertices of its boundary, e.g. their pcurves
+    /// or tolerances. So only groups that don't share a vertex are built at the same time.
+    void buildFaces(std::vector<FaceGroup> &groups)
+    {
+        unsigned int numThreads = std::thread::hardware_concurrency();
+        if (numThreads < 2 || groups.size() < 4)
+        {
+            for (std::vector<FaceGroup>::iterator it = groups.begin(); it != groups.end(); ++it)
+                it->newFace = it->typeObject->buildFace(it->faces);
+            return;
+        }
+
+        std::vector<std::vector<std::size_t> > batches;
+        std::vector<TopTools_MapOfShape> batchVertices;
+        for (std::size_t index = 0; index < groups.size(); ++index)
+        {
+            TopTools_IndexedMapOfShape vertices;
+            FaceVectorType::const_iterator faceIt;
+            for (faceIt = groups[index].faces.begin(); faceIt != groups[index].faces.end(); ++faceIt)
+                TopExp::MapShapes(*faceIt, TopAbs_VERTEX, vertices);
+
+            std::size_t batch = 0;
+            for (; batch < batches.size(); ++batch)
+            {
+                bool shared = false;
+                for (int i = 1; i <= vertices.Extent() && !shared; ++i)
+                    shared = batchVertices[batch].Contains(vertices(i));
+                if (!shared)
+                    break;
+            }
+            if (batch == batches.size())
+            {
+                batches.emplace_back();
+                batchVertices.emplace_back();
+            }
+            batches[batch].push_back(index);
+            for (int i = 1; i <= vertices.Extent(); ++i)
+                batchVertices[batch].Add(vertices(i));
+        }
+
+        for (std::vector<std::vector<std::size_t> >::iterator it = batches.begin(); it != batches.end(); ++it)
+        {
+            const std::vector<std::size_t> &batch = *it;
+            Part::Tools::parallelFor(batch.size(), [&](std::size_t index) {
+                FaceGroup &group = groups[batch[index]];
+                group.newFace = group.typeObject->buildFace(group.faces);
+            }, numThreads);
+        }
+    }
+}
+
 FaceUniter::FaceUniter(const TopoDS_Shell &shellIn) : modifiedSignal(false)
 {
     workShell = shellIn;
@@ -1046,6 +1152,8 @@ bool FaceUniter::process()
 
     ModelRefine::FaceAdjacencySplitter adjacencySplitter(workShell);
 
+    // first collect the groups of faces to unite, they are independent of each other
+    std::vector<ModelRefine::FaceGroup> groups;
     for(typeIt = typeObjects.begin(); typeIt != typeObjects.end(); ++typeIt)
     {
         ModelRefine::FaceVectorType typedFaces = splitter.getTypedFaceVector((*typeIt)->getType());
@@ -1058,25 +1166,34 @@ bool FaceUniter::process()
             for (std::size_t adjacentIndex(0); adjacentIndex < adjacencySplitter.getGroupCount(); ++adjacentIndex)
             {
 //                    std::cout << "         face count is: " << adjacencySplitter.getGroup(adjacentIndex).size() << std::endl;
-                TopoDS_Face newFace = (*typeIt)->buildFace(adjacencySplitter.getGroup(adjacentIndex));
-                if (!newFace.IsNull())
-                {
-                    facesToSew.push_back(newFace);
-                    if (facesToRemove.capacity() <= facesToRemove.size() + adjacencySplitter.getGroup(adjacentIndex).size())
-                        facesToRemove.reserve(facesToRemove.size() + adjacencySplitter.getGroup(adjacentIndex).size());
-                    FaceVectorType temp = adjacencySplitter.getGroup(adjacentIndex);
-                    facesToRemove.insert(facesToRemove.end(), temp.begin(), temp.end());
-                    // the first shape will be marked as modified, i.e. replaced by newFace, all others are marked as deleted
-                    // jrheinlaender: IMHO this is not correct because references to the deleted faces will be broken, whereas they should
-                    // be replaced by references to the new face. To achieve this all shapes should be marked as
-                    // modified, producing one single new face. This is the inverse behaviour to faces that are split e.g.
-                    // by a boolean cut, where one old shape is marked as modified, producing multiple new shapes
-                    if (!temp.empty())
-                    {
-                        for (FaceVectorType::iterator f = temp.begin(); f != temp.end(); ++f)
-                              modifiedShapes.emplace_back(*f, newFace);
-                    }
-                }
+                ModelRefine::FaceGroup group;
+                group.typeObject = *typeIt;
+                group.faces = adjacencySplitter.getGroup(adjacentIndex);
+                groups.push_back(group);
+            }
+        }
+    }
+
+    ModelRefine::buildFaces(groups);
+    for (std::vector<ModelRefine::FaceGroup>::iterator groupIt = groups.begin(); groupIt != groups.end(); ++groupIt)
+    {
+        const TopoDS_Face &newFace = groupIt->newFace;
+        if (!newFace.IsNull())
+        {
+            facesToSew.push_back(newFace);
+            if (facesToRemove.capacity() <= facesToRemove.size() + groupIt->faces.size())
+                facesToRemove.reserve(facesToRemove.size() + groupIt->faces.size());
+            const FaceVectorType &temp = groupIt->faces;
+            facesToRemove.insert(facesToRemove.end(), temp.begin(), temp.end());
+            // the first shape will be marked as modified, i.e. replaced by newFace, all others are marked as deleted
+            // jrheinlaender: IMHO this is not correct because references to the deleted faces will be broken, whereas they should
+            // be replaced by references to the new face. To achieve this all shapes should be marked as
+            // modified, producing one single new face. This is the inverse behaviour to faces that are split e.g.
+            // by a boolean cut, where one old shape is marked as modified, producing multiple new shapes
+            if (!temp.empty())
+            {
+                for (FaceVectorType::const_iterator f = temp.begin(); f != temp.end(); ++f)
+                      modifiedShapes.emplace_back(*f, newFace);
             }
         }
     }
@@ -243,7 +243,12 @@ void CrossSections::apply()
         section->purgeTouched();
     }
 #else
-    Base::SequencerLauncher seq("Cross-sections...", obj.size() * (d.size() +1));
+    // slices() computes all sections of a shape at once and in parallel
+    QStringList distances;
+    for (std::vector<double>::iterator jt = d.begin(); jt != d.end(); ++jt)
+        distances << QString::number(*jt, 'g', 12);
+
+    Base::SequencerLauncher seq("Cross-sections...", obj.size());
     Gui::Command::runCommand(Gui::Command::App, "import Part\n");
     Gui::Command::runCommand(Gui::Command::App, "from FreeCAD import Base\n");
     for (std::vector<App::DocumentObject*>::iterator it = obj.begin(); it != obj.end(); ++it) {
@@ -251,26 +256,15 @@ void CrossSections::apply()
         std::string s = (*it)->getNameInDocument();
         s += "_cs";
         Gui::Command::runCommand(Gui::Command::App, QString::fromLatin1(
-            "wires=list()\n"
-            "shape=FreeCAD.getDocument(\"%1\").%2.Shape\n")
-            .arg(QLatin1String(doc->getName()))
-            .arg(QLatin1String((*it)->getNameInDocument())).toLatin1());
-
-        for (std::vector<double>::iterator jt = d.begin(); jt != d.end(); ++jt) {
-            Gui::Command::runCommand(Gui::Command::App, QString::fromLatin1(
-                "for i in shape.slice(Base.Vector(%1,%2,%3),%4):\n"
-                "    wires.append(i)\n"
-                ).arg(a).arg(b).arg(c).arg(*jt).toLatin1());
-            seq.next();
-        }
-
-        Gui::Command::runCommand(Gui::Command::App, QString::fromLatin1(
-            "comp=Part.Compound(wires)\n"
-            "slice=FreeCAD.getDocument(\"%1\").addObject(\"Part::Feature\",\"%2\")\n"
+            "comp=FreeCAD.getDocument(\"%1\").%2.Shape.slices(Base.Vector(%3,%4,%5),[%6])\n"
+            "slice=FreeCAD.getDocument(\"%1\").addObject(\"Part::Feature\",\"%7\")\n"
             "slice.Shape=comp\n"
             "slice.purgeTouched()\n"
-            "del slice,comp,wires,shape")
+            "del slice,comp")
             .arg(QLatin1String(doc->getName()))
+            .arg(QLatin1String((*it)->getNameInDocument()))
+            .arg(a).arg(b).arg(c)
+            .arg(distances.join(QLatin1String(",")))
             .arg(QLatin1String(s.c_str())).toLatin1());
 
         seq.next();
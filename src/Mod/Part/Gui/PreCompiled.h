@@ -76,6 +76,7 @@
 #include <stack>
 #include <queue>
 #include <bitset>
+#include <mutex>
 
 // OpenCasCade Base
 #include <Standard_Failure.hxx>
@@ -184,6 +185,8 @@
 #ifndef __Qt4All__
 # include <Gui/Qt4All.h>
 #endif
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 
 // GL
 // Include glext before InventorAll
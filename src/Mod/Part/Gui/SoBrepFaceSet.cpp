@@ -92,10 +92,11 @@ SO_NODE_SOURCE(SoBrepFaceSet)
 class SoBrepFaceSet::VBO {
 public:
     struct Buffer {
-        uint32_t myvbo[2];
+        uint32_t myvbo[3]; // vertices and normals, indices, colors
         std::size_t vertex_array_size;
         std::size_t index_array_size;
         bool updateVbo;
+        bool updateColor;
         bool vboLoaded;
     };
 
@@ -119,6 +120,8 @@ public:
             SoGLCacheContextElement::scheduleDeleteCallback(it->first, VBO::vbo_delete, ptr0);
             void * ptr1 = (void*) ((uintptr_t) it->second.myvbo[1]);
             SoGLCacheContextElement::scheduleDeleteCallback(it->first, VBO::vbo_delete, ptr1);
+            void * ptr2 = (void*) ((uintptr_t) it->second.myvbo[2]);
+            SoGLCacheContextElement::scheduleDeleteCallback(it->first, VBO::vbo_delete, ptr2);
         }
     }
 
@@ -150,7 +153,7 @@ public:
 #endif
             //cc_glglue_glDeleteBuffers(glue, buffer.size(), buffer.data());
             auto &buffer = it->second;
-            glDeleteBuffersARB(2, buffer.myvbo);
+            glDeleteBuffersARB(3, buffer.myvbo);
             self->vbomap.erase(it);
         }
     }
@@ -342,9 +345,14 @@ void SoBrepFaceSet::doAction(SoAction* action)
     // but the base class made this method private so that we can't override it.
     // So, the alternative way is to write a custom SoAction class.
     else if (action->getTypeId() == Gui::SoUpdateVBOAction::getClassTypeId()) {
+        auto type = static_cast<Gui::SoUpdateVBOAction*>(action)->getUpdateType();
         for(auto &v : PRIVATE(this)->vbomap) {
-            v.second.updateVbo = true;
-            v.second.vboLoaded = false;
+            if(type == Gui::SoUpdateVBOAction::Color)
+                v.second.updateColor = true;
+            else {
+                v.second.updateVbo = true;
+                v.second.vboLoaded = false;
+            }
         }
     }
 
@@ -1431,12 +1439,14 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
     int trinr = 0;
 
     float * vertex_array = NULL;
+    float * color_array = NULL;
     GLuint * index_array = NULL;
     SbColor  mycolor1,mycolor2,mycolor3;
     SbVec3f *mynormal1 = (SbVec3f *)currnormal;
     SbVec3f *mynormal2 = (SbVec3f *)currnormal;
     SbVec3f *mynormal3 = (SbVec3f *)currnormal;
     int indice=0;
+    int cindice=0;
     uint32_t RGBA,R,G,B,A;
     float Rf,Gf,Bf,Af;
 
@@ -1448,13 +1458,15 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
         const cc_glglue * glue = cc_glglue_instance(action->getCacheContext());
         PFNGLGENBUFFERSPROC glGenBuffersARB = (PFNGLGENBUFFERSPROC)cc_glglue_getprocaddress(glue, "glGenBuffersARB");
 #endif
-        glGenBuffersARB(2, buf.myvbo);
+        glGenBuffersARB(3, buf.myvbo);
         buf.vertex_array_size = 0;
         buf.index_array_size = 0;
+        buf.updateVbo = false;
+        buf.updateColor = false;
         buf.vboLoaded = false;
     }
 
-    if ((buf.vertex_array_size != (sizeof(float) * num_indices * 10)) ||
+    if ((buf.vertex_array_size != (sizeof(float) * num_indices * 6)) ||
         (buf.index_array_size != (sizeof(GLuint) * num_indices))) {
         if ((buf.vertex_array_size != 0 ) && ( buf.index_array_size != 0))
             buf.updateVbo = true;
@@ -1464,9 +1476,12 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
     // it means that the VBO has not been initialized
     // updateVbo is tracking the need to update the content of the VBO which act as a buffer within
     // the graphic card
+    // updateColor is set if only the colors have changed. The colors are kept in a separate
+    // buffer, so that the vertex and index buffers need not be uploaded again.
     // TODO FINISHING THE COLOR SUPPORT !
 
-    if (!buf.vboLoaded || buf.updateVbo) {
+    bool updateGeometry = !buf.vboLoaded || buf.updateVbo;
+    if (updateGeometry || buf.updateColor) {
 #ifdef FC_OS_WIN32
         const cc_glglue * glue = cc_glglue_instance(action->getCacheContext());
 
@@ -1475,17 +1490,20 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
         PFNGLGENBUFFERSPROC glGenBuffersARB = (PFNGLGENBUFFERSPROC)cc_glglue_getprocaddress(glue, "glGenBuffersARB");
         PFNGLDELETEBUFFERSARBPROC glDeleteBuffersARB = (PFNGLDELETEBUFFERSARBPROC)cc_glglue_getprocaddress(glue, "glDeleteBuffersARB");
         PFNGLBUFFERDATAARBPROC glBufferDataARB = (PFNGLBUFFERDATAARBPROC)cc_glglue_getprocaddress(glue, "glBufferDataARB");
+        PFNGLBUFFERSUBDATAARBPROC glBufferSubDataARB = (PFNGLBUFFERSUBDATAARBPROC)cc_glglue_getprocaddress(glue, "glBufferSubDataARB");
 #endif
-        // We must manage buffer size increase let's clear everything and re-init to test the
-        // clearing process
-        glDeleteBuffersARB(2, buf.myvbo);
-        glGenBuffersARB(2, buf.myvbo);
-        vertex_array = ( float * ) malloc ( sizeof(float) * num_indices * 10 );
-        index_array = ( GLuint *) malloc ( sizeof(GLuint) * num_indices );
-        buf.vertex_array_size = sizeof(float) * num_indices * 10;
-        buf.index_array_size = sizeof(GLuint) * num_indices;
-        this->vbomap[contextId] = buf;
-        this->indice_array = 0;
+        if (updateGeometry) {
+            // We must manage buffer size increase let's clear everything and re-init to test the
+            // clearing process
+            glDeleteBuffersARB(3, buf.myvbo);
+            glGenBuffersARB(3, buf.myvbo);
+            vertex_array = ( float * ) malloc ( sizeof(float) * num_indices * 6 );
+            index_array = ( GLuint *) malloc ( sizeof(GLuint) * num_indices );
+            buf.vertex_array_size = sizeof(float) * num_indices * 6;
+            buf.index_array_size = sizeof(GLuint) * num_indices;
+            this->indice_array = 0;
+        }
+        color_array = ( float * ) malloc ( sizeof(float) * num_indices * 4 );
 
         // Get the initial colors
         SoState * state = action->getState();
@@ -1579,21 +1597,38 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
 
             /* We building the Vertex dataset there and push it to a VBO */
             /* The Vertex array shall contain per element vertex_coordinates[3],
-            normal_coordinates[3], color_value[3] (RGBA format) */
-
-            index_array[this->indice_array] =   this->indice_array;
-            index_array[this->indice_array+1] = this->indice_array + 1;
-            index_array[this->indice_array+2] = this->indice_array + 2;
-            this->indice_array += 3;
-
-
-            ((SbVec3f *)(cur_coords3d+v1 ))->getValue(vertex_array[indice+0],
-                                                      vertex_array[indice+1],
-                                                      vertex_array[indice+2]);
-
-            ((SbVec3f *)(mynormal1))->getValue(vertex_array[indice+3],
-                                               vertex_array[indice+4],
-                                               vertex_array[indice+5]);
+            normal_coordinates[3], the colors (RGBA format) go to their own array */
+
+            if (updateGeometry) {
+                index_array[this->indice_array] =   this->indice_array;
+                index_array[this->indice_array+1] = this->indice_array + 1;
+                index_array[this->indice_array+2] = this->indice_array + 2;
+                this->indice_array += 3;
+
+                ((SbVec3f *)(cur_coords3d+v1))->getValue(vertex_array[indice+0],
+                                                         vertex_array[indice+1],
+                                                         vertex_array[indice+2]);
+                ((SbVec3f *)(mynormal1))->getValue(vertex_array[indice+3],
+                                                   vertex_array[indice+4],
+                                                   vertex_array[indice+5]);
+                indice+=6;
+
+                ((SbVec3f *)(cur_coords3d+v2))->getValue(vertex_array[indice+0],
+                                                         vertex_array[indice+1],
+                                                         vertex_array[indice+2]);
+                ((SbVec3f *)(mynormal2))->getValue(vertex_array[indice+3],
+                                                   vertex_array[indice+4],
+                                                   vertex_array[indice+5]);
+                indice+=6;
+
+                ((SbVec3f *)(cur_coords3d+v3))->getValue(vertex_array[indice+0],
+                                                         vertex_array[indice+1],
+                                                         vertex_array[indice+2]);
+                ((SbVec3f *)(mynormal3))->getValue(vertex_array[indice+3],
+                                                   vertex_array[indice+4],
+                                                   vertex_array[indice+5]);
+                indice+=6;
+            }
 
             /* We decode the Vertex1 color */
             RGBA = mycolor1.getPackedValue();
@@ -1607,19 +1642,13 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
             Bf = (((float )B) / 255.0);
             Af = (((float )A) / 255.0);
 
-            vertex_array[indice+6] = Rf;
-            vertex_array[indice+7] = Gf;
-            vertex_array[indice+8] = Bf;
-            vertex_array[indice+9] = Af;
-            indice+=10;
-
-            ((SbVec3f *)(cur_coords3d+v2))->getValue(vertex_array[indice+0],
-                                                     vertex_array[indice+1],
-                                                     vertex_array[indice+2]);
-            ((SbVec3f *)(mynormal2))->getValue(vertex_array[indice+3],
-                                               vertex_array[indice+4],
-                                               vertex_array[indice+5]);
+            color_array[cindice+0] = Rf;
+            color_array[cindice+1] = Gf;
+            color_array[cindice+2] = Bf;
+            color_array[cindice+3] = Af;
+            cindice+=4;
 
+            /* We decode the Vertex2 color */
             RGBA = mycolor2.getPackedValue();
             R = ( RGBA & 0xFF000000 ) >> 24 ;
             G = ( RGBA & 0xFF0000 ) >> 16;
@@ -1631,19 +1660,13 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
             Bf = (((float )B) / 255.0);
             Af = (((float )A) / 255.0);
 
-            vertex_array[indice+6] = Rf;
-            vertex_array[indice+7] = Gf;
-            vertex_array[indice+8] = Bf;
-            vertex_array[indice+9] = Af;
-            indice+=10;
-
-            ((SbVec3f *)(cur_coords3d+v3))->getValue(vertex_array[indice+0],
-                                                     vertex_array[indice+1],
-                                                     vertex_array[indice+2]);
-            ((SbVec3f *)(mynormal3))->getValue(vertex_array[indice+3],
-                                               vertex_array[indice+4],
-                                               vertex_array[indice+5]);
+            color_array[cindice+0] = Rf;
+            color_array[cindice+1] = Gf;
+            color_array[cindice+2] = Bf;
+            color_array[cindice+3] = Af;
+            cindice+=4;
 
+            /* We decode the Vertex3 color */
             RGBA = mycolor3.getPackedValue();
             R = ( RGBA & 0xFF000000 ) >> 24 ;
             G = ( RGBA & 0xFF0000 ) >> 16;
@@ -1655,11 +1678,11 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
             Bf = (((float )B) / 255.0);
             Af = (((float )A) / 255.0);
 
-            vertex_array[indice+6] = Rf;
-            vertex_array[indice+7] = Gf;
-            vertex_array[indice+8] = Bf;
-            vertex_array[indice+9] = Af;
-            indice+=10;
+            color_array[cindice+0] = Rf;
+            color_array[cindice+1] = Gf;
+            color_array[cindice+2] = Bf;
+            color_array[cindice+3] = Af;
+            cindice+=4;
 
             /* ============================================================ */
             trinr++;
@@ -1677,19 +1700,31 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
             }
         }
 
-        glBindBufferARB(GL_ARRAY_BUFFER_ARB, buf.myvbo[0]);
-        glBufferDataARB(GL_ARRAY_BUFFER_ARB, sizeof(float) * indice , vertex_array, GL_DYNAMIC_DRAW_ARB);
+        if (updateGeometry) {
+            glBindBufferARB(GL_ARRAY_BUFFER_ARB, buf.myvbo[0]);
+            glBufferDataARB(GL_ARRAY_BUFFER_ARB, sizeof(float) * indice , vertex_array, GL_STATIC_DRAW_ARB);
 
-        glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, buf.myvbo[1]);
-        glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, sizeof(GLuint) * this->indice_array , &index_array[0], GL_DYNAMIC_DRAW_ARB);
+            glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, buf.myvbo[1]);
+            glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, sizeof(GLuint) * this->indice_array , &index_array[0], GL_STATIC_DRAW_ARB);
+
+            glBindBufferARB(GL_ARRAY_BUFFER_ARB, buf.myvbo[2]);
+            glBufferDataARB(GL_ARRAY_BUFFER_ARB, sizeof(float) * cindice , color_array, GL_DYNAMIC_DRAW_ARB);
+        }
+        else {
+            // same triangles as before, so the color buffer keeps its size
+            glBindBufferARB(GL_ARRAY_BUFFER_ARB, buf.myvbo[2]);
+            glBufferSubDataARB(GL_ARRAY_BUFFER_ARB, 0, sizeof(float) * cindice , color_array);
+        }
 
         glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0);
         glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
 
         buf.vboLoaded = true;
         buf.updateVbo = false;
+        buf.updateColor = false;
         free(vertex_array);
         free(index_array);
+        free(color_array);
     }
 
     // This is the VBO rendering code
@@ -1698,18 +1733,16 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
     PFNGLBINDBUFFERARBPROC glBindBufferARB = (PFNGLBINDBUFFERARBPROC)cc_glglue_getprocaddress(glue, "glBindBufferARB");
 #endif
 
-    if (!buf.updateVbo) {
-        glBindBufferARB(GL_ARRAY_BUFFER_ARB, buf.myvbo[0]);
-        glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, buf.myvbo[1]);
-    }
-
     glEnableClientState(GL_VERTEX_ARRAY);
     glEnableClientState(GL_NORMAL_ARRAY);
     glEnableClientState(GL_COLOR_ARRAY);
 
-    glVertexPointer(3,GL_FLOAT,10*sizeof(GLfloat),0);
-    glNormalPointer(GL_FLOAT,10*sizeof(GLfloat),(GLvoid *)(3*sizeof(GLfloat)));
-    glColorPointer(4,GL_FLOAT,10*sizeof(GLfloat),(GLvoid *)(6*sizeof(GLfloat)));
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, buf.myvbo[0]);
+    glVertexPointer(3,GL_FLOAT,6*sizeof(GLfloat),0);
+    glNormalPointer(GL_FLOAT,6*sizeof(GLfloat),(GLvoid *)(3*sizeof(GLfloat)));
+    glBindBufferARB(GL_ARRAY_BUFFER_ARB, buf.myvbo[2]);
+    glColorPointer(4,GL_FLOAT,0,0);
+    glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, buf.myvbo[1]);
 
     glDrawElements(GL_TRIANGLES, this->indice_array, GL_UNSIGNED_INT, (void *)0);
 
@@ -1718,7 +1751,6 @@ void SoBrepFaceSet::VBO::render(SoGLRenderAction * action,
     glDisableClientState(GL_VERTEX_ARRAY);
     glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0);
     glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
-    buf.updateVbo = false;
     // The data is within the VBO we can clear it at application level
 }
 
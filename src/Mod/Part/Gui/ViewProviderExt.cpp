@@ -95,6 +95,10 @@
 # include <Inventor/nodes/SoLightModel.h>
 # include <QAction>
 # include <QMenu>
+# include <QFutureWatcher>
+# include <QtConcurrentRun>
+# include <cmath>
+# include <mutex>
 #endif
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -235,6 +239,11 @@ ViewProviderPartExt::ViewProviderPartExt()
     VisualTouched = true;
     forceUpdateCount = 0;
     NormalsFromUV = true;
+    tessellationPending = false;
+    tessellation = new QFutureWatcher<void>();
+    QObject::connect(tessellation, &QFutureWatcher<void>::finished, [this]() {
+        onTessellationFinished();
+    });
 
     unsigned long lcol = Gui::ViewParams::instance()->getDefaultShapeLineColor(); // dark grey (25,25,25)
     float r,g,b;
@@ -340,6 +349,10 @@ ViewProviderPartExt::ViewProviderPartExt()
 
 ViewProviderPartExt::~ViewProviderPartExt()
 {
+    // the shape must not be touched after this view provider is gone
+    tessellation->waitForFinished();
+    delete tessellation;
+
     pcFaceBind->unref();
     pcLineBind->unref();
     pcPointBind->unref();
@@ -693,7 +706,7 @@ std::vector<Base::Vector3d> ViewProviderPartExt::getSelectionShape(const char* /
 
 void ViewProviderPartExt::setHighlightedFaces(const std::vector<App::Color>& colors)
 {
-    Gui::SoUpdateVBOAction action;
+    Gui::SoUpdateVBOAction action(Gui::SoUpdateVBOAction::Color);
     action.apply(this->faceset);
 
     int size = static_cast<int>(colors.size());
@@ -998,8 +1011,136 @@ void ViewProviderPartExt::unsetEdit(int ModNum)
     }
 }
 
+namespace {
+// BRepMesh attaches the triangulation to the TShape of each face and these are shared
+// between shapes, so never tessellate two shapes at the same time
+std::mutex tessellationMutex;
+
+/**
+ * The deflection depends on the bounding box and thus changes slightly with every
+ * modification of a part. Since BRepMesh re-tessellates all faces whose triangulation
+ * is coarser than requested, even the unchanged faces would be tessellated again.
+ * Rounding the deflection down to steps of about 19% gives the same value for small
+ * changes, so that the triangulation kept with the TShape of a face is reused.
+ */
+Standard_Real quantizeDeflection(Standard_Real deflection)
+{
+    if (deflection <= 0.0)
+        return deflection;
+    return std::pow(2.0, std::floor(std::log2(deflection) * 4.0) / 4.0);
+}
+
+void tessellateShape(const TopoDS_Shape& shape, Standard_Real deflection, Standard_Real angularDeflection)
+{
+    std::lock_guard<std::mutex> lock(tessellationMutex);
+#if OCC_VERSION_HEX >= 0x060600
+    BRepMesh_IncrementalMesh(shape,deflection,Standard_False,
+            angularDeflection,Standard_True);
+#else
+    (void)angularDeflection;
+    BRepMesh_IncrementalMesh(shape,deflection);
+#endif
+}
+}
+
+bool ViewProviderPartExt::tessellateInBackground(const TopoDS_Shape& shape) const
+{
+    // when forced the representation is expected to be up-to-date afterwards
+    if (isUpdateForced())
+        return false;
+
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part");
+    if (!hGrp->GetBool("TessellateInBackground", true))
+        return false;
+
+    // for small shapes the overhead isn't worth it
+    int minFaces = hGrp->GetInt("BackgroundTessellationFaces", 500);
+    int numFaces = 0;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More() && numFaces < minFaces; xp.Next())
+        numFaces++;
+    return numFaces >= minFaces;
+}
+
 void ViewProviderPartExt::updateVisual()
 {
+    TopoDS_Shape cShape = Part::Feature::getShape(getObject());
+    if (cShape.IsNull()) {
+        buildVisual(cShape);
+        return;
+    }
+
+    // the running tessellation picks up the latest shape once it has finished
+    if (tessellation->isRunning()) {
+        tessellationPending = true;
+        VisualTouched = false;
+        return;
+    }
+
+    Standard_Real deflection = 0.0;
+    Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
+    try {
+        // calculating the deflection value
+        Bnd_Box bounds;
+        BRepBndLib::Add(cShape, bounds);
+        bounds.SetGap(0.0);
+        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        deflection = quantizeDeflection(((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 *
+            Deviation.getValue());
+
+        // Tessellating large shapes takes a while, so do it in the background and keep
+        // showing the previous representation in the meantime
+        if (tessellateInBackground(cShape)) {
+            tessellatedShape = cShape;
+            tessellation->setFuture(QtConcurrent::run([cShape, deflection, AngDeflectionRads]() {
+                try {
+                    tessellateShape(cShape, deflection, AngDeflectionRads);
+                }
+                catch (...) {
+                }
+            }));
+            VisualTouched = false;
+            return;
+        }
+
+        // create or use the mesh on the data structure
+        tessellateShape(cShape, deflection, AngDeflectionRads);
+    }
+    catch (...) {
+        FC_ERR("Cannot compute Inventor representation for the shape of " << pcObject->getFullName());
+        VisualTouched = false;
+        return;
+    }
+
+    buildVisual(cShape);
+}
+
+void ViewProviderPartExt::onTessellationFinished()
+{
+    TopoDS_Shape shape = tessellatedShape;
+    tessellatedShape.Nullify();
+
+    // the shape or the deflection has changed in the meantime
+    if (tessellationPending) {
+        tessellationPending = false;
+        updateVisual();
+        return;
+    }
+
+    buildVisual(shape);
+
+    // The colors may have been set while the tessellation was running
+    onChanged(&DiffuseColor);
+    if (this->faceset->partIndex.getNum() >
+        this->pcShapeMaterial->diffuseColor.getNum()) {
+        this->pcFaceBind->value = SoMaterialBinding::OVERALL;
+    }
+}
+
+void ViewProviderPartExt::buildVisual(const TopoDS_Shape& shape)
+{
+    TopoDS_Shape cShape = shape;
     Gui::SoUpdateVBOAction action;
     action.apply(this->faceset);
 
@@ -1015,7 +1156,6 @@ void ViewProviderPartExt::updateVisual()
     haction.apply(this->lineset);
     haction.apply(this->nodeset);
 
-    TopoDS_Shape cShape = Part::Feature::getShape(getObject());
     if (cShape.IsNull()) {
         coords  ->point      .setNum(0);
         norm    ->vector     .setNum(0);
@@ -1033,23 +1173,6 @@ void ViewProviderPartExt::updateVisual()
     std::set<int> faceEdges;
 
     try {
-        // calculating the deflection value
-        Bnd_Box bounds;
-        BRepBndLib::Add(cShape, bounds);
-        bounds.SetGap(0.0);
-        Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
-        bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
-        Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 *
-            Deviation.getValue();
-
-        // create or use the mesh on the data structure
-#if OCC_VERSION_HEX >= 0x060600
-        Standard_Real AngDeflectionRads = AngularDeflection.getValue() / 180.0 * M_PI;
-        BRepMesh_IncrementalMesh(cShape,deflection,Standard_False,
-                AngDeflectionRads,Standard_True);
-#else
-        BRepMesh_IncrementalMesh(cShape,deflection);
-#endif
         // We must reset the location here because the transformation data
         // are set in the placement property
         TopLoc_Location aLoc;
@@ -55,6 +55,7 @@ class SoNormal;
 class SoNormalBinding;
 class SoMaterialBinding;
 class SoIndexedLineSet;
+template <typename T> class QFutureWatcher;
 
 namespace PartGui {
 
@@ -158,6 +159,8 @@ protected:
     virtual void onChanged(const App::Property* prop) override;
     bool loadParameter();
     void updateVisual();
+    /// Fills the Inventor nodes from the triangulation of the shape
+    void buildVisual(const TopoDS_Shape&);
     void getNormals(const TopoDS_Face&  theFace, const Handle(Poly_Triangulation)& aPolyTri,
                     TColgp_Array1OfDir& theNormals);
 
@@ -181,9 +184,16 @@ protected:
     bool VisualTouched;
     bool NormalsFromUV;
 
+private:
+    bool tessellateInBackground(const TopoDS_Shape&) const;
+    void onTessellationFinished();
+
 private:
     // settings stuff
     int forceUpdateCount;
+    QFutureWatcher<void>* tessellation;
+    TopoDS_Shape tessellatedShape;
+    bool tessellationPending;
     static App::PropertyFloatConstraint::Constraints sizeRange;
     static App::PropertyFloatConstraint::Constraints tessRange;
     static App::PropertyQuantityConstraint::Constraints angDeflectionRange;
@@ -0,0 +1,100 @@
+# -*- coding: utf-8 -*-
+
+#  LGPL
+
+"""Benchmarks for the refinement of shapes (removal of splitter faces).
+
+Run it from the FreeCAD Python console or with FreeCADCmd:
+
+    import PartBenchmarks
+    PartBenchmarks.run()
+
+The test shapes are grids of adjacent boxes with a cylindrical boss on top of
+each box, fused into one solid. The fusion leaves coplanar and cocylindrical
+faces which removeSplitter() has to unite again. Besides the synthetic shapes,
+real models can be passed as a list of BREP or STEP file names:
+
+    PartBenchmarks.run(files=["/path/to/model.brep"])
+
+For every shape the number of faces before and after the refinement and the
+time of the fusion and of the refinement are printed.
+
+runTessellation() times the tessellation of the same shapes with decreasing
+deflections.
+"""
+
+import os, time
+import FreeCAD, Part
+
+try:
+    from BenchmarkApp import record
+except ImportError:
+    def record(*args, **kwargs):
+        pass
+
+# number of boxes along each side of the grids
+GRID_SIZES = [4, 8, 16, 24]
+# deflections of the tessellation relative to the size of the shape
+DEFLECTIONS = [0.01, 0.001, 0.0001]
+
+
+def makeGrid(count, size=10.0):
+    """Returns the fused grid of count x count boxes and the time of the fusion."""
+    shapes = []
+    for i in range(count):
+        for j in range(count):
+            pos = FreeCAD.Vector(i * size, j * size, 0)
+            shapes.append(Part.makeBox(size, size, size, pos))
+            center = pos + FreeCAD.Vector(size / 2, size / 2, size)
+            shapes.append(Part.makeCylinder(size / 4, size / 2, center))
+    start = time.time()
+    shape = shapes[0].multiFuse(shapes[1:])
+    return shape, time.time() - start
+
+
+def report(name, shape, fuseTime):
+    start = time.time()
+    refined = shape.removeSplitter()
+    seconds = time.time() - start
+    timing = "%8.3f s" % fuseTime if fuseTime is not None else "     n/a"
+    if fuseTime is not None:
+        record("Part", name, fuseTime, operation="fuse", faces=len(shape.Faces))
+    record("Part", name, seconds, operation="refine", faces=len(refined.Faces))
+    FreeCAD.Console.PrintMessage("%-20s fuse %s  refine %8.3f s  faces %8d -> %8d\n"
+                                 % (name, timing, seconds, len(shape.Faces), len(refined.Faces)))
+
+
+def run(files=None, sizes=None):
+    """Runs the benchmarks on the synthetic grids and the given files."""
+    if sizes is None:
+        sizes = GRID_SIZES
+    for count in sizes:
+        shape, fuseTime = makeGrid(count)
+        report("grid(%d)" % count, shape, fuseTime)
+
+    for filename in files or []:
+        shape = Part.read(filename)
+        report(os.path.basename(filename), shape, None)
+
+
+def reportTessellation(name, shape):
+    size = shape.BoundBox.DiagonalLength
+    for deflection in DEFLECTIONS:
+        # work on a copy, the triangulation is kept in the shape
+        copy = shape.copy()
+        start = time.time()
+        points, triangles = copy.tessellate(size * deflection)
+        seconds = time.time() - start
+        record("Tessellation", name, seconds, deflection=deflection, triangles=len(triangles))
+        FreeCAD.Console.PrintMessage("%-20s deflection %8.4f  %10d triangles %8.3f s\n"
+                                     % (name, deflection, len(triangles), seconds))
+
+
+def runTessellation(files=None, sizes=None):
+    """Times the tessellation of the synthetic grids and the given files."""
+    for count in sizes or GRID_SIZES:
+        shape, fuseTime = makeGrid(count)
+        reportTessellation("grid(%d)" % count, shape)
+
+    for filename in files or []:
+        reportTessellation(os.path.basename(filename), Part.read(filename))
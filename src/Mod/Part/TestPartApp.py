@@ -54,6 +54,79 @@ class PartTestCases(unittest.TestCase):
         #self.Doc.addObject("Part::Feature","Face").Shape = result
         #self.assertTrue(isinstance(result.Surface, Part.BSplineSurface))
 
+    def testLazyLoading(self):
+        import os, tempfile
+        box = self.Doc.addObject("Part::Box","Box")
+        self.Doc.recompute()
+        fileName = tempfile.gettempdir() + os.sep + "PartLazyLoading.FCStd"
+        self.Doc.saveAs(fileName)
+        FreeCAD.closeDocument(self.Doc.Name)
+
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        lazy = param.GetBool("LazyLoading", False)
+        param.SetBool("LazyLoading", True)
+        try:
+            self.Doc = FreeCAD.openDocument(fileName)
+        finally:
+            param.SetBool("LazyLoading", lazy)
+        # saving over the project file must not lose the deferred shape
+        self.Doc.save()
+        self.assertEqual(len(self.Doc.getObject("Box").Shape.Faces), 6)
+        FreeCAD.closeDocument(self.Doc.Name)
+        self.Doc = FreeCAD.openDocument(fileName)
+        self.assertEqual(len(self.Doc.getObject("Box").Shape.Faces), 6)
+        FreeCAD.closeDocument(self.Doc.Name)
+        os.remove(fileName)
+        self.Doc = FreeCAD.newDocument("PartTest")
+
+    def testShapeStorageFormats(self):
+        import os, tempfile
+        self.Doc.addObject("Part::Box","Box")
+        self.Doc.recompute()
+        fileName = tempfile.gettempdir() + os.sep + "PartStorageFormats.FCStd"
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        binary = param.GetBool("SaveBinaryBrep", True)
+        try:
+            for mode in (True, False):
+                param.SetBool("SaveBinaryBrep", mode)
+                self.Doc.saveAs(fileName)
+                FreeCAD.closeDocument(self.Doc.Name)
+                self.Doc = FreeCAD.openDocument(fileName)
+                self.assertEqual(len(self.Doc.getObject("Box").Shape.Faces), 6)
+        finally:
+            param.SetBool("SaveBinaryBrep", binary)
+        FreeCAD.closeDocument(self.Doc.Name)
+        os.remove(fileName)
+        self.Doc = FreeCAD.newDocument("PartTest")
+
+    def testSharedShapes(self):
+        import os, tempfile, zipfile
+        shape = Part.makeBox(1,1,1)
+        for i in range(3):
+            self.Doc.addObject("Part::Feature","Feature").Shape = shape
+        fileName = tempfile.gettempdir() + os.sep + "PartSharedShapes.FCStd"
+        param = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Document")
+        shared = param.GetBool("SaveSharedShapes", False)
+        param.SetBool("SaveSharedShapes", True)
+        try:
+            self.Doc.saveAs(fileName)
+        finally:
+            param.SetBool("SaveSharedShapes", shared)
+        with zipfile.ZipFile(fileName) as archive:
+            names = [n for n in archive.namelist() if n.startswith("PartShape")]
+        self.assertEqual(len(names), 1)
+
+        FreeCAD.closeDocument(self.Doc.Name)
+        self.Doc = FreeCAD.openDocument(fileName)
+        shapes = [obj.Shape for obj in self.Doc.Objects]
+        self.assertEqual(len(shapes), 3)
+        for s in shapes:
+            self.assertEqual(len(s.Faces), 6)
+            self.assertTrue(s.isSame(shapes[0]))
+        FreeCAD.closeDocument(self.Doc.Name)
+        os.remove(fileName)
+        self.Doc = FreeCAD.newDocument("PartTest")
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartTest")
@@ -23,6 +23,10 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <iomanip>
+# include <list>
+# include <memory>
+# include <sstream>
 # include <Standard_Failure.hxx>
 # include <TopoDS_Solid.hxx>
 # include <TopExp_Explorer.hxx>
@@ -35,6 +39,7 @@
 
 // TODO Cleanup headers (2015-09-04, Fat-Zer)
 #include <Base/Exception.h>
+#include "App/Application.h"
 #include "App/Document.h"
 #include <App/FeaturePythonPyImp.h>
 #include "App/OriginFeature.h"
@@ -45,6 +50,8 @@
 #include "Mod/Part/App/DatumFeature.h"
 
 #include <Base/Console.h>
+#include <Base/Parameter.h>
+#include <Base/Writer.h>
 
 FC_LOG_LEVEL_INIT("PartDesign",true,true)
 
@@ -70,6 +77,121 @@ short Feature::mustExecute() const
     return Part::Feature::mustExecute();
 }
 
+struct Feature::ResultCache {
+    struct Entry {
+        /// the serialized parameters of the feature and placements of the inputs
+        std::string parameters;
+        /// the shapes of the linked objects, they are kept to compare the identity
+        std::vector<TopoDS_Shape> inputs;
+        /// copies of the output properties
+        std::vector<std::pair<std::string, std::unique_ptr<App::Property> > > outputs;
+
+        bool operator == (const Entry& other) const {
+            if (parameters != other.parameters || inputs.size() != other.inputs.size())
+                return false;
+            for (std::size_t i = 0; i < inputs.size(); i++) {
+                if (!inputs[i].IsEqual(other.inputs[i]))
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    /// most recently used first
+    std::list<Entry> entries;
+};
+
+static bool isResultProperty(const Feature* feature, const App::Property* prop)
+{
+    return prop == &feature->Placement || prop->isDerivedFrom(Part::PropertyPartShape::getClassTypeId());
+}
+
+bool Feature::canCacheResult() const
+{
+    // the execute() of a Python feature may do anything
+    return getPropertyByName("Proxy") == nullptr;
+}
+
+App::DocumentObjectExecReturn *Feature::recompute()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/PartDesign");
+    long size = hGrp->GetInt("ResultCacheSize", 3);
+    if (size <= 0 || !canCacheResult()) {
+        resultCache.reset();
+        return Part::Feature::recompute();
+    }
+
+    ResultCache::Entry key;
+    try {
+        Base::StringWriter writer;
+        std::map<std::string, App::Property*> props;
+        getPropertyMap(props);
+        for (auto& it : props) {
+            App::Property* prop = it.second;
+            if (prop == &Label || prop == &Label2
+                || (getPropertyType(prop) & (App::Prop_Output | App::Prop_Transient))
+                || (prop != &Placement && isResultProperty(this, prop)))
+                continue;
+            writer.Stream() << it.first << ':';
+            prop->Save(writer);
+        }
+
+        std::ostringstream placements;
+        placements << std::setprecision(17);
+        for (auto obj : getOutList()) {
+            if (obj->getTypeId().isDerivedFrom(Part::Feature::getClassTypeId()))
+                key.inputs.push_back(static_cast<Part::Feature*>(obj)->Shape.getValue());
+            if (obj->getTypeId().isDerivedFrom(App::GeoFeature::getClassTypeId())) {
+                Base::Matrix4D mat = static_cast<App::GeoFeature*>(obj)->Placement.getValue().toMatrix();
+                placements << obj->getNameInDocument();
+                for (int i = 0; i < 3; i++) {
+                    for (int j = 0; j < 4; j++)
+                        placements << ' ' << mat[i][j];
+                }
+                placements << '\n';
+            }
+        }
+        key.parameters = writer.getString() + placements.str();
+    }
+    catch (const Base::Exception&) {
+        // a parameter that cannot be serialized, do without cache
+        resultCache.reset();
+        return Part::Feature::recompute();
+    }
+
+    if (!resultCache)
+        resultCache = std::make_shared<ResultCache>();
+    std::list<ResultCache::Entry>& entries = resultCache->entries;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (*it == key) {
+            FC_LOG("restore cached result of " << getFullName());
+            for (auto& output : it->outputs) {
+                App::Property* prop = getPropertyByName(output.first.c_str());
+                if (prop)
+                    prop->Paste(*output.second);
+            }
+            entries.splice(entries.begin(), entries, it);
+            return App::DocumentObject::StdReturn;
+        }
+    }
+
+    App::DocumentObjectExecReturn* ret = Part::Feature::recompute();
+    if (ret != App::DocumentObject::StdReturn)
+        return ret;
+
+    std::vector<App::Property*> props;
+    getPropertyList(props);
+    for (auto prop : props) {
+        if (isResultProperty(this, prop))
+            key.outputs.emplace_back(getPropertyName(prop), std::unique_ptr<App::Property>(prop->Copy()));
+    }
+    entries.push_front(std::move(key));
+    if (static_cast<long>(entries.size()) > size)
+        entries.resize(size);
+    return ret;
+}
+
 TopoDS_Shape Feature::getSolid(const TopoDS_Shape& shape)
 {
     if (shape.IsNull())
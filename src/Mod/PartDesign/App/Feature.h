@@ -24,6 +24,7 @@
 #ifndef PARTDESIGN_Feature_H
 #define PARTDESIGN_Feature_H
 
+#include <memory>
 #include <App/PropertyStandard.h>
 #include <Mod/Part/App/PartFeature.h>
 
@@ -55,6 +56,15 @@ public:
     App::PropertyLinkHidden _Body;
 
     short mustExecute() const;
+    /** Recomputes the feature unless the result is in the cache.
+     * The last results are kept together with the parameters of the feature and
+     * the shapes of the linked objects. If they are identical to one of them, e.g.
+     * after a change of an upstream feature was undone, the cached result is restored
+     * instead of running execute() again.
+     * The number of cached results is set by the parameter ResultCacheSize of
+     * Mod/PartDesign, 0 disables the cache.
+     */
+    virtual App::DocumentObjectExecReturn *recompute() override;
 
     /// Check whether the given feature is a datum feature
     static bool isDatum(const App::DocumentObject* feature);
@@ -81,6 +91,8 @@ public:
     }
 
 protected:
+    /// Returns false if execute() has side effects that cannot be reproduced from the cache
+    virtual bool canCacheResult() const;
 
     /**
      * Get a solid of the given shape. If no solid is found an exception is raised.
@@ -93,6 +105,10 @@ protected:
     /// Make a shape from a base plane (convenience method)
     static gp_Pln makePlnFromPlane(const App::DocumentObject* obj);
     static TopoDS_Shape makeShapeFromPlane(const App::DocumentObject* obj);
+
+private:
+    struct ResultCache;
+    std::shared_ptr<ResultCache> resultCache;
 };
 
 typedef App::FeaturePythonT<Feature> FeaturePython;
@@ -43,6 +43,7 @@
 #include <App/Application.h>
 #include <App/Document.h>
 #include <Mod/Part/App/modelRefine.h>
+#include <Mod/Part/App/BooleanOptions.h>
 
 using namespace PartDesign;
 
@@ -128,24 +129,24 @@ App::DocumentObjectExecReturn *Boolean::execute(void)
             return new App::DocumentObjectExecReturn("Tool shape is null");
 
         if (type == "Fuse") {
-            BRepAlgoAPI_Fuse mkFuse(result, shape);
-            if (!mkFuse.IsDone())
+            std::unique_ptr<BRepAlgoAPI_Fuse> mkFuse(Part::BooleanOptions().fuse(result, shape));
+            if (!mkFuse->IsDone())
                 return new App::DocumentObjectExecReturn("Fusion of tools failed");
             // we have to get the solids (fuse sometimes creates compounds)
-            boolOp = this->getSolid(mkFuse.Shape());
+            boolOp = this->getSolid(mkFuse->Shape());
             // lets check if the result is a solid
             if (boolOp.IsNull())
                 return new App::DocumentObjectExecReturn("Resulting shape is not a solid");
         } else if (type == "Cut") {
-            BRepAlgoAPI_Cut mkCut(result, shape);
-            if (!mkCut.IsDone())
+            std::unique_ptr<BRepAlgoAPI_Cut> mkCut(Part::BooleanOptions().cut(result, shape));
+            if (!mkCut->IsDone())
                 return new App::DocumentObjectExecReturn("Cut out failed");
-            boolOp = mkCut.Shape();
+            boolOp = mkCut->Shape();
         } else if (type == "Common") {
-            BRepAlgoAPI_Common mkCommon(result, shape);
-            if (!mkCommon.IsDone())
+            std::unique_ptr<BRepAlgoAPI_Common> mkCommon(Part::BooleanOptions().common(result, shape));
+            if (!mkCommon->IsDone())
                 return new App::DocumentObjectExecReturn("Common operation failed");
-            boolOp = mkCommon.Shape();
+            boolOp = mkCommon->Shape();
         }
 
         result = boolOp; // Use result of this operation for fuse/cut of next body
@@ -44,6 +44,7 @@
 #include <Base/Tools.h>
 
 #include "FeatureGroove.h"
+#include <Mod/Part/App/BooleanOptions.h>
 
 
 using namespace PartDesign;
@@ -155,13 +156,13 @@ App::DocumentObjectExecReturn *Groove::execute(void)
             this->AddSubShape.setValue(result);
 
             // cut out groove to get one result object
-            BRepAlgoAPI_Cut mkCut(base, result);
+            std::unique_ptr<BRepAlgoAPI_Cut> mkCut(Part::BooleanOptions().cut(base, result));
             // Let's check if the fusion has been successful
-            if (!mkCut.IsDone())
+            if (!mkCut->IsDone())
                 throw Base::CADKernelError("Cut out of base feature failed");
 
             // we have to get the solids (fuse sometimes creates compounds)
-            TopoDS_Shape solRes = this->getSolid(mkCut.Shape());
+            TopoDS_Shape solRes = this->getSolid(mkCut->Shape());
             if (solRes.IsNull())
                 return new App::DocumentObjectExecReturn("Resulting shape is not a solid");
 
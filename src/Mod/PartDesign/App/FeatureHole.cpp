@@ -61,6 +61,7 @@
 #include <App/Application.h>
 #include <Base/Reader.h>
 #include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/BooleanOptions.h>
 
 #include "json.hpp"
 #include "FeatureHole.h"
@@ -1717,11 +1718,11 @@ App::DocumentObjectExecReturn *Hole::execute(void)
             BRepBuilderAPI_Transform transformer(copy, localSketchTransformation );
 
             copy = transformer.Shape();
-            BRepAlgoAPI_Cut mkCut( base, copy );
-            if (!mkCut.IsDone())
+            std::unique_ptr<BRepAlgoAPI_Cut> mkCut(Part::BooleanOptions().cut(base, copy));
+            if (!mkCut->IsDone())
                 return new App::DocumentObjectExecReturn("Hole: Cut out of base feature failed");
 
-            TopoDS_Shape result = mkCut.Shape();
+            TopoDS_Shape result = mkCut->Shape();
 
             // We have to get the solids (fuse sometimes creates compounds)
             base = getSolid(result);
@@ -53,6 +53,7 @@
 #include <Base/Reader.h>
 
 #include "FeaturePad.h"
+#include <Mod/Part/App/BooleanOptions.h>
 
 using namespace PartDesign;
 
@@ -319,11 +320,11 @@ App::DocumentObjectExecReturn *Pad::execute(void)
 //             auto obj = getDocument()->addObject("Part::Feature", "prism");
 //             static_cast<Part::Feature*>(obj)->Shape.setValue(getSolid(prism));
             // Let's call algorithm computing a fuse operation:
-            BRepAlgoAPI_Fuse mkFuse(base, prism);
+            std::unique_ptr<BRepAlgoAPI_Fuse> mkFuse(Part::BooleanOptions().fuse(base, prism));
             // Let's check if the fusion has been successful
-            if (!mkFuse.IsDone())
+            if (!mkFuse->IsDone())
                 return new App::DocumentObjectExecReturn("Pad: Fusion with base feature failed");
-            TopoDS_Shape result = mkFuse.Shape();
+            TopoDS_Shape result = mkFuse->Shape();
             // we have to get the solids (fuse sometimes creates compounds)
             TopoDS_Shape solRes = this->getSolid(result);
             // lets check if the result is a solid
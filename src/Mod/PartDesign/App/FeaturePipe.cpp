@@ -64,6 +64,7 @@
 #include <Base/Reader.h>
 #include <App/Document.h>
 #include <Mod/Part/App/FaceMakerCheese.h>
+#include <Mod/Part/App/BooleanOptions.h>
 
 //#include "Body.h"
 #include "FeaturePipe.h"
@@ -313,11 +314,11 @@ App::DocumentObjectExecReturn *Pipe::execute(void)
 
         if(getAddSubType() == FeatureAddSub::Additive) {
 
-            BRepAlgoAPI_Fuse mkFuse(base, result);
-            if (!mkFuse.IsDone())
+            std::unique_ptr<BRepAlgoAPI_Fuse> mkFuse(Part::BooleanOptions().fuse(base, result));
+            if (!mkFuse->IsDone())
                 return new App::DocumentObjectExecReturn("Adding the pipe failed");
             // we have to get the solids (fuse sometimes creates compounds)
-            TopoDS_Shape boolOp = this->getSolid(mkFuse.Shape());
+            TopoDS_Shape boolOp = this->getSolid(mkFuse->Shape());
             // lets check if the result is a solid
             if (boolOp.IsNull())
                 return new App::DocumentObjectExecReturn("Resulting shape is not a solid");
@@ -332,11 +333,11 @@ App::DocumentObjectExecReturn *Pipe::execute(void)
         }
         else if(getAddSubType() == FeatureAddSub::Subtractive) {
 
-            BRepAlgoAPI_Cut mkCut(base, result);
-            if (!mkCut.IsDone())
+            std::unique_ptr<BRepAlgoAPI_Cut> mkCut(Part::BooleanOptions().cut(base, result));
+            if (!mkCut->IsDone())
                 return new App::DocumentObjectExecReturn("Subtracting the pipe failed");
             // we have to get the solids (fuse sometimes creates compounds)
-            TopoDS_Shape boolOp = this->getSolid(mkCut.Shape());
+            TopoDS_Shape boolOp = this->getSolid(mkCut->Shape());
             // lets check if the result is a solid
             if (boolOp.IsNull())
                 return new App::DocumentObjectExecReturn("Resulting shape is not a solid");
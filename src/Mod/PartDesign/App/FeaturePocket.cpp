@@ -49,6 +49,7 @@
 #include <App/Document.h>
 
 #include "FeaturePocket.h"
+#include <Mod/Part/App/BooleanOptions.h>
 
 
 using namespace PartDesign;
@@ -192,11 +193,11 @@ App::DocumentObjectExecReturn *Pocket::execute(void)
 #endif
 
             // And the really expensive way to get the SubShape...
-            BRepAlgoAPI_Cut mkCut(base, prism);
-            if (!mkCut.IsDone())
+            std::unique_ptr<BRepAlgoAPI_Cut> mkCut(Part::BooleanOptions().cut(base, prism));
+            if (!mkCut->IsDone())
                 return new App::DocumentObjectExecReturn("Pocket: Up to face: Could not get SubShape!");
             // FIXME: In some cases this affects the Shape property: It is set to the same shape as the SubShape!!!!
-            TopoDS_Shape result = refineShapeIfActive(mkCut.Shape());
+            TopoDS_Shape result = refineShapeIfActive(mkCut->Shape());
             this->AddSubShape.setValue(result);
 
             int prismCount = countSolids(prism);
@@ -218,10 +219,10 @@ App::DocumentObjectExecReturn *Pocket::execute(void)
             this->AddSubShape.setValue(prism);
 
             // Cut the SubShape out of the base feature
-            BRepAlgoAPI_Cut mkCut(base, prism);
-            if (!mkCut.IsDone())
+            std::unique_ptr<BRepAlgoAPI_Cut> mkCut(Part::BooleanOptions().cut(base, prism));
+            if (!mkCut->IsDone())
                 return new App::DocumentObjectExecReturn("Pocket: Cut out of base feature failed");
-            TopoDS_Shape result = mkCut.Shape();
+            TopoDS_Shape result = mkCut->Shape();
             // we have to get the solids (fuse sometimes creates compounds)
             TopoDS_Shape solRes = this->getSolid(result);
             if (solRes.IsNull())
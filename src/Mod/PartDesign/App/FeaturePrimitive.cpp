@@ -45,6 +45,7 @@
 #include "DatumPoint.h"
 #include "DatumCS.h"
 #include "FeaturePy.h"
+#include <Mod/Part/App/BooleanOptions.h>
 #include <Base/Exception.h>
 #include <Base/Tools.h>
 #include <App/Document.h>
@@ -96,11 +97,11 @@ App::DocumentObjectExecReturn* FeaturePrimitive::execute(const TopoDS_Shape& pri
 
         if(getAddSubType() == FeatureAddSub::Additive) {
 
-            BRepAlgoAPI_Fuse mkFuse(base, primitiveShape);
-            if (!mkFuse.IsDone())
+            std::unique_ptr<BRepAlgoAPI_Fuse> mkFuse(Part::BooleanOptions().fuse(base, primitiveShape));
+            if (!mkFuse->IsDone())
                 return new App::DocumentObjectExecReturn("Adding the primitive failed");
             // we have to get the solids (fuse sometimes creates compounds)
-            TopoDS_Shape boolOp = this->getSolid(mkFuse.Shape());
+            TopoDS_Shape boolOp = this->getSolid(mkFuse->Shape());
             // lets check if the result is a solid
             if (boolOp.IsNull())
                 return new App::DocumentObjectExecReturn("Resulting shape is not a solid");
@@ -116,11 +117,11 @@ App::DocumentObjectExecReturn* FeaturePrimitive::execute(const TopoDS_Shape& pri
         }
         else if(getAddSubType() == FeatureAddSub::Subtractive) {
 
-            BRepAlgoAPI_Cut mkCut(base, primitiveShape);
-            if (!mkCut.IsDone())
+            std::unique_ptr<BRepAlgoAPI_Cut> mkCut(Part::BooleanOptions().cut(base, primitiveShape));
+            if (!mkCut->IsDone())
                 return new App::DocumentObjectExecReturn("Subtracting the primitive failed");
             // we have to get the solids (fuse sometimes creates compounds)
-            TopoDS_Shape boolOp = this->getSolid(mkCut.Shape());
+            TopoDS_Shape boolOp = this->getSolid(mkCut->Shape());
             // lets check if the result is a solid
             if (boolOp.IsNull())
                 return new App::DocumentObjectExecReturn("Resulting shape is not a solid");
@@ -43,6 +43,7 @@
 #include <Base/Tools.h>
 
 #include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/BooleanOptions.h>
 #include "FeatureRevolution.h"
 
 
@@ -155,11 +156,11 @@ App::DocumentObjectExecReturn *Revolution::execute(void)
 
             if (!base.IsNull()) {
                 // Let's call algorithm computing a fuse operation:
-                BRepAlgoAPI_Fuse mkFuse(base, result);
+                std::unique_ptr<BRepAlgoAPI_Fuse> mkFuse(Part::BooleanOptions().fuse(base, result));
                 // Let's check if the fusion has been successful
-                if (!mkFuse.IsDone())
+                if (!mkFuse->IsDone())
                     throw Part::BooleanException("Fusion with base feature failed");
-                result = mkFuse.Shape();
+                result = mkFuse->Shape();
                 result = refineShapeIfActive(result);
             }
 
@@ -34,6 +34,8 @@
 # include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBndLib.hxx>
 # include <Bnd_Box.hxx>
+# include <TopoDS_Iterator.hxx>
+# include <algorithm>
 #endif
 
 
@@ -52,6 +54,7 @@
 #include <Base/Reader.h>
 #include <App/Application.h>
 #include <Mod/Part/App/modelRefine.h>
+#include <Mod/Part/App/BooleanOptions.h>
 
 using namespace PartDesign;
 
@@ -250,6 +253,12 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
     typedef std::map<App::DocumentObject*,  trsf_it> rej_it_map;
     rej_it_map nointersect_trsfms;
 
+    // An instance whose bounding box is out of the one of the support cannot intersect it.
+    // The box grows with every fused instance so that it always encloses the support.
+    Bnd_Box supportBox;
+    BRepBndLib::Add(support, supportBox);
+    supportBox.Enlarge(Precision::Confusion());
+
     // NOTE: It would be possible to build a compound from all original addShapes/subShapes and then
     // transform the compounds as a whole. But we choose to apply the transformations to each
     // Original separately. This way it is easier to discover what feature causes a fuse/cut
@@ -277,6 +286,82 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
             return new App::DocumentObjectExecReturn("Only additive and subtractive features can be transformed");
         }
 
+        // Many instances of a purely additive or subtractive feature are combined by a tree
+        // reduction and applied to the support with a single operation
+        Part::BooleanOptions options;
+        if (fuseShape.isNull() != cutShape.isNull() && options.useFuseTree(transformations.size())) {
+            const TopoDS_Shape& addSubShape = fuseShape.isNull() ? cutShape.getShape() : fuseShape.getShape();
+            std::vector<TopoDS_Shape> instances;
+            Bnd_Box instancesBox;
+            bool allIntersect = true;
+            for (std::vector<gp_Trsf>::const_iterator t = transformations.begin() + 1; t != transformations.end(); ++t) {
+                BRepBuilderAPI_Copy copy(addSubShape);
+                BRepBuilderAPI_Transform mkTrf(copy.Shape(), *t, false);
+                if (!mkTrf.IsDone())
+                    return new App::DocumentObjectExecReturn("Transformation failed", (*o));
+                Bnd_Box box;
+                BRepBndLib::Add(mkTrf.Shape(), box);
+                if (supportBox.IsOut(box)) {
+                    // a cut with it does nothing and an added instance is rejected
+                    allIntersect = false;
+                    if (!cutShape.isNull())
+                        continue;
+                }
+                instancesBox.Add(box);
+                instances.push_back(mkTrf.Shape());
+            }
+
+            // Only the tools that overlap each other have to be fused, all others are
+            // applied as one compound
+            std::vector<TopoDS_Shape> tools;
+            TopoDS_Compound compound;
+            divideTools(instances, tools, compound);
+            if (TopoDS_Iterator(compound).More())
+                tools.push_back(compound);
+
+            try {
+                if (!cutShape.isNull()) {
+                    if (tools.empty())
+                        continue;
+                    TopoDS_Shape tool = tools.size() == 1 ? tools.front() : options.fuseTree(tools);
+                    std::unique_ptr<BRepAlgoAPI_Cut> mkCut(options.cut(support, tool));
+                    if (!mkCut->IsDone())
+                        return new App::DocumentObjectExecReturn("Cut out of support failed", *o);
+                    support = mkCut->Shape();
+                    continue;
+                }
+
+                // If an instance doesn't intersect the support the number of solids changes.
+                // Then fall back to the fusion one by one to find out the instances to reject.
+                if (allIntersect) {
+                    TopoDS_Shape result;
+                    if (tools.size() == 1) {
+                        std::unique_ptr<BRepAlgoAPI_Fuse> mkFuse(options.fuse(support, tools.front()));
+                        if (!mkFuse->IsDone())
+                            return new App::DocumentObjectExecReturn("Fusion with support failed", *o);
+                        result = mkFuse->Shape();
+                    }
+                    else {
+                        tools.insert(tools.begin(), support);
+                        result = options.fuseTree(tools);
+                    }
+                    if (countSolids(result) == countSolids(support)) {
+                        support = this->getSolid(result);
+                        if (support.IsNull())
+                            return new App::DocumentObjectExecReturn("Resulting shape is not a solid", *o);
+                        supportBox.Add(instancesBox);
+                        continue;
+                    }
+                }
+            }
+            catch (Standard_Failure& e) {
+                std::string msg("Transformation failed");
+                if (e.GetMessageString() != NULL)
+                    msg += std::string(": '") + e.GetMessageString() + "'";
+                return new App::DocumentObjectExecReturn(msg.c_str(), *o);
+            }
+        }
+
         // Transform the add/subshape and collect the resulting shapes for overlap testing
         /*typedef std::vector<std::vector<gp_Trsf>::const_iterator> trsf_it_vec;
         trsf_it_vec v_transformations;
@@ -337,12 +422,19 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
                     // Fuse/Cut the compounded transformed shapes with the support
                     //TopoDS_Shape result;
 
-                    BRepAlgoAPI_Fuse mkFuse(current, shape);
-                    if (!mkFuse.IsDone())
+                    Bnd_Box box;
+                    BRepBndLib::Add(shape, box);
+                    if (supportBox.IsOut(box)) {
+                        nointersect_trsfms[*o].insert(t);
+                        continue;
+                    }
+
+                    std::unique_ptr<BRepAlgoAPI_Fuse> mkFuse(Part::BooleanOptions().fuse(current, shape));
+                    if (!mkFuse->IsDone())
                         return new App::DocumentObjectExecReturn("Fusion with support failed", *o);
 
                     if(Part::TopoShape(current).countSubShapes(TopAbs_SOLID)
-                            != Part::TopoShape(mkFuse.Shape()).countSubShapes(TopAbs_SOLID))
+                            != Part::TopoShape(mkFuse->Shape()).countSubShapes(TopAbs_SOLID))
                     {
 #ifdef FC_DEBUG // do not write this in release mode because a message appears already in the task view
                         Base::Console().Warning("Transformed shape does not intersect support %s: Removed\n", (*o)->getNameInDocument());
@@ -350,8 +442,9 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
                         nointersect_trsfms[*o].insert(t);
                         continue;
                     }
+                    supportBox.Add(box);
                     // we have to get the solids (fuse sometimes creates compounds)
-                    current = this->getSolid(mkFuse.Shape());
+                    current = this->getSolid(mkFuse->Shape());
                     // lets check if the result is a solid
                     if (current.IsNull())
                         return new App::DocumentObjectExecReturn("Resulting shape is not a solid", *o);
@@ -369,10 +462,17 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
                     }
                 }
                 if (!cutShape.isNull()) {
-                    BRepAlgoAPI_Cut mkCut(current, shape);
-                    if (!mkCut.IsDone())
+                    Bnd_Box box;
+                    BRepBndLib::Add(shape, box);
+                    if (supportBox.IsOut(box)) {
+                        support = current;
+                        continue;
+                    }
+
+                    std::unique_ptr<BRepAlgoAPI_Cut> mkCut(Part::BooleanOptions().cut(current, shape));
+                    if (!mkCut->IsDone())
                         return new App::DocumentObjectExecReturn("Cut out of support failed", *o);
-                    current = mkCut.Shape();
+                    current = mkCut->Shape();
                 }
                 support = current; // Use result of this operation for fuse/cut of next original
             } catch (Standard_Failure& e) {
@@ -425,55 +525,63 @@ TopoDS_Shape Transformed::refineShapeIfActive(const TopoDS_Shape& oldShape) cons
 void Transformed::divideTools(const std::vector<TopoDS_Shape> &toolsIn, std::vector<TopoDS_Shape> &individualsOut,
                               TopoDS_Compound &compoundOut) const
 {
-    typedef std::pair<TopoDS_Shape, Bnd_Box> ShapeBoundPair;
-    typedef std::list<ShapeBoundPair> PairList;
-    typedef std::vector<ShapeBoundPair> PairVector;
-
-    PairList pairList;
+    struct ShapeBound {
+        TopoDS_Shape shape;
+        Bnd_Box bound;
+        Standard_Real xmin;
+        bool isolated;
+    };
 
+    std::vector<ShapeBound> tools;
+    tools.reserve(toolsIn.size());
     std::vector<TopoDS_Shape>::const_iterator it;
     for (it = toolsIn.begin(); it != toolsIn.end(); ++it) {
-        Bnd_Box bound;
-        BRepBndLib::Add(*it, bound);
-        bound.SetGap(0.0);
-        ShapeBoundPair temp = std::make_pair(*it, bound);
-        pairList.push_back(temp);
+        ShapeBound tool;
+        tool.shape = *it;
+        BRepBndLib::Add(*it, tool.bound);
+        tool.bound.SetGap(0.0);
+        tool.xmin = 0.0;
+        if (!tool.bound.IsVoid()) {
+            Standard_Real ymin, zmin, xmax, ymax, zmax;
+            tool.bound.Get(tool.xmin, ymin, zmin, xmax, ymax, zmax);
+        }
+        tool.isolated = true;
+        tools.push_back(tool);
     }
 
-    BRep_Builder builder;
-    builder.MakeCompound(compoundOut);
-
-    while(!pairList.empty()) {
-        PairVector currentGroup;
-        currentGroup.push_back(pairList.front());
-        pairList.pop_front();
-        PairList::iterator it = pairList.begin();
-        while(it != pairList.end()) {
-            PairVector::const_iterator groupIt;
-            bool found(false);
-            for (groupIt = currentGroup.begin(); groupIt != currentGroup.end(); ++groupIt) {
-                if (!(*it).second.IsOut((*groupIt).second)) {//touching means is out.
-                    found = true;
-                    break;
-                }
+    // sweep along the x axis so that only the boxes that overlap in x are compared
+    std::vector<std::size_t> order(tools.size());
+    for (std::size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&tools](std::size_t a, std::size_t b) {
+        return tools[a].xmin < tools[b].xmin;
+    });
+
+    for (std::size_t i = 0; i < order.size(); i++) {
+        ShapeBound& tool = tools[order[i]];
+        if (tool.bound.IsVoid())
+            continue;
+        Standard_Real xmin, ymin, zmin, xmax, ymax, zmax;
+        tool.bound.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+        for (std::size_t j = i + 1; j < order.size() && tools[order[j]].xmin <= xmax; j++) {
+            ShapeBound& other = tools[order[j]];
+            if (!other.bound.IsOut(tool.bound)) {//touching means is out.
+                tool.isolated = false;
+                other.isolated = false;
             }
-            if (found) {
-                currentGroup.push_back(*it);
-                pairList.erase(it);
-                it=pairList.begin();
-                continue;
-            }
-            ++it;
         }
+    }
 
-        if (currentGroup.size() == 1) {
-            builder.Add(compoundOut, currentGroup.front().first);
-        }
-        else {
-            PairVector::const_iterator groupIt;
-            for (groupIt = currentGroup.begin(); groupIt != currentGroup.end(); ++groupIt)
-                individualsOut.push_back((*groupIt).first);
-        }
+    BRep_Builder builder;
+    builder.MakeCompound(compoundOut);
+
+    // keep the order of the input
+    std::vector<ShapeBound>::const_iterator jt;
+    for (jt = tools.begin(); jt != tools.end(); ++jt) {
+        if (jt->isolated)
+            builder.Add(compoundOut, jt->shape);
+        else
+            individualsOut.push_back(jt->shape);
     }
 }
 
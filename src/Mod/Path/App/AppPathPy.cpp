@@ -156,10 +156,7 @@ private:
             App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(pObj)->getDocumentObjectPtr();
             if (obj->getTypeId().isDerivedFrom(Base::Type::fromName("Path::Feature"))) {
                 const Toolpath& path = static_cast<Path::Feature*>(obj)->Path.getValue();
-                std::string gcode = path.toGCode();
-                std::ofstream ofile(EncodedName.c_str());
-                ofile << gcode;
-                ofile.close();
+                path.writeGCodeFile(EncodedName);
             }
             else {
                 throw Py::RuntimeError("The given file is not a path");
@@ -193,12 +190,8 @@ private:
 
         try {
             // read the gcode file
-            std::ifstream filestr(file.filePath().c_str());
-            std::stringstream buffer;
-            buffer << filestr.rdbuf();
-            std::string gcode = buffer.str();
             Toolpath path;
-            path.setFromGCode(gcode);
+            path.setFromGCodeFile(file.filePath());
             Path::Feature *object = static_cast<Path::Feature *>(pcDoc->addObject("Path::Feature",file.fileNamePure().c_str()));
             object->Path.setValue(path);
             pcDoc->recompute();
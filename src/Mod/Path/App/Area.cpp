@@ -28,6 +28,8 @@
 
 #ifndef _PreComp_
 # include <cfloat>
+# include <chrono>
+# include <thread>
 # include <boost/version.hpp>
 # include <boost/config.hpp>
 # if defined(BOOST_MSVC) && (BOOST_VERSION == 105500)
@@ -97,6 +99,7 @@
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Part/App/FaceMakerBullseye.h>
 #include <Mod/Part/App/CrossSection.h>
+#include <Mod/Part/App/Tools.h>
 #include "Area.h"
 #include "../libarea/Area.h"
 
@@ -180,7 +183,7 @@ CAreaConfig::~CAreaConfig() {
 
 TYPESYSTEM_SOURCE(Path::Area, Base::BaseClass)
 
-bool Area::s_aborting;
+std::atomic<bool> Area::s_aborting(false);
 
 Area::Area(const AreaParams *params)
 :myParams(s_params)
@@ -1316,6 +1319,38 @@ int Area::project(TopoDS_Shape &shape_out,
     return skips;
 }
 
+// set in the workers of parallelAreas(), nested calls run serially
+static thread_local bool s_inParallelAreas = false;
+
+/** Runs func for the indices of independent pieces of work (sections, offset rings) in parallel
+ *
+ * libarea keeps its settings per thread, so the workers are handed the ones of
+ * the calling thread. Remaining work is skipped once Area::abort() is called.
+ */
+static void parallelAreas(std::size_t count, const std::function<void(std::size_t)> &func)
+{
+    CAreaParams params;
+#define AREA_CONF_GET(_param) \
+    params.PARAM_FNAME(_param) = BOOST_PP_CAT(CArea::get_,PARAM_FARG(_param))();
+    PARAM_FOREACH(AREA_CONF_GET,AREA_PARAMS_CAREA)
+
+    // showShape() adds objects to the active document, which must not happen concurrently
+    unsigned int numThreads = 0;
+    if(s_inParallelAreas || FC_LOG_INSTANCE.level()>FC_LOGLEVEL_TRACE)
+        numThreads = 1;
+
+    Part::Tools::parallelFor(count, [&](std::size_t i) {
+        if(Area::aborting())
+            throw Base::AbortException("Area operation aborted");
+        CAreaConfig conf(params,false);
+        Base::StateLocker lock(s_inParallelAreas);
+        func(i);
+        // libarea returns incomplete results when aborted
+        if(Area::aborting())
+            throw Base::AbortException("Area operation aborted");
+    }, numThreads);
+}
+
 std::vector<shared_ptr<Area> > Area::makeSections(
         PARAM_ARGS(PARAM_FARG,AREA_PARAMS_SECTION_EXTRA),
         const std::vector<double> &_heights,
@@ -1332,7 +1367,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
     if(plane.IsNull())
         throw Base::ValueError("failed to obtain section plane");
 
-    FC_TIME_INIT2(t,t1);
+    FC_TIME_INIT(t);
 
     TopLoc_Location loc(trsf);
 
@@ -1445,7 +1480,6 @@ std::vector<shared_ptr<Area> > Area::makeSections(
         throw Base::ValueError("no sections");
 
     std::vector<shared_ptr<Area> > sections;
-    sections.reserve(heights.size());
 
     std::list<Shape> projectedShapes;
     if(project) {
@@ -1460,7 +1494,10 @@ std::vector<shared_ptr<Area> > Area::makeSections(
     bool can_retry = fabs(tolerance)>Precision::Confusion();
     TopLoc_Location locInverse(loc.Inverted());
 
-    for(size_t i=0;i<heights.size();++i) {
+    // the sections are independent, empty ones are discarded afterwards
+    std::vector<shared_ptr<Area> > results(heights.size());
+    parallelAreas(heights.size(),[&](std::size_t i) {
+        FC_TIME_INIT(t1);
         double z = heights[i];
         bool retried = !can_retry;
         while(true) {
@@ -1481,7 +1518,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                     TopLoc_Location wloc(t);
                     area->add(s.shape.Moved(wloc).Moved(locInverse),s.op);
                 }
-                sections.push_back(area);
+                results[i] = area;
                 break;
             }
 
@@ -1550,7 +1587,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                 }
             }
             if(area->myShapes.size()){
-                sections.push_back(area);
+                results[i] = area;
                 FC_TIME_LOG(t1,"makeSection " << z);
                 showShape(area->getShape(),0,"section_%u_final",i);
                 break;
@@ -1564,6 +1601,12 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                 retried = true;
             }
         }
+    });
+
+    sections.reserve(results.size());
+    for(auto &area : results) {
+        if(area)
+            sections.push_back(area);
     }
     FC_TIME_LOG(t,"makeSection count: " << sections.size()<<", total");
     return sections;
@@ -1753,11 +1796,14 @@ TopoDS_Shape Area::toShape(CArea &area, short fill, int reorient) {
         if(_index>=(int)mySections.size())\
             return TopoDS_Shape();\
         if(_index<0) {\
+            std::vector<TopoDS_Shape> shapes(mySections.size());\
+            parallelAreas(mySections.size(),[&](std::size_t i) {\
+                shapes[i] = mySections[i]->_op(_index, ## __VA_ARGS__);\
+            });\
             BRep_Builder builder;\
             TopoDS_Compound compound;\
             builder.MakeCompound(compound);\
-            for(shared_ptr<Area> area : mySections){\
-                const TopoDS_Shape &s = area->_op(_index, ## __VA_ARGS__);\
+            for(const TopoDS_Shape &s : shapes){\
                 if(s.IsNull()) continue;\
                 builder.Add(compound,s);\
             }\
@@ -1942,12 +1988,8 @@ void Area::makeOffset(list<shared_ptr<CArea> > &areas,
         }else
             last_stepover = 0;
     }
-    for(int i=0;count<0||i<count;++i,offset+=stepover) {
-        if(from_center)
-            areas.push_front(make_shared<CArea>());
-        else
-            areas.push_back(make_shared<CArea>());
-        CArea &area = from_center?(*areas.front()):(*areas.back());
+    // every ring is an offset of the original area
+    auto makeRing = [&](double value, CArea &area) {
         CArea areaOpen;
 #ifdef AREA_OFFSET_ALGO
         if(myParams.Algo == Area::Algolibarea) {
@@ -1967,20 +2009,63 @@ void Area::makeOffset(list<shared_ptr<CArea> > &areas,
             // libarea somehow fails offset without Reorder, but ClipperOffset
             // works okay. Don't know why
             area.Reorder();
-            area.Offset(-offset);
+            area.Offset(-value);
             if(areaOpen.m_curves.size()) {
-                areaOpen.Thicken(offset);
+                areaOpen.Thicken(value);
                 area.Clip(ClipperLib::ctUnion,&areaOpen,SubjectFill,ClipFill);
             }
             break;
         case Area::AlgoClipperOffset:
 #endif
-            area.OffsetWithClipper(offset,JoinType,EndType,
+            area.OffsetWithClipper(value,JoinType,EndType,
                     myParams.MiterLimit,myParams.RoundPrecision);
 #ifdef AREA_OFFSET_ALGO
             break;
         }
 #endif
+    };
+
+    auto addRing = [&]() -> CArea& {
+        if(from_center)
+            areas.push_front(make_shared<CArea>());
+        else
+            areas.push_back(make_shared<CArea>());
+        return from_center?(*areas.front()):(*areas.back());
+    };
+
+    // The rings are independent, so they are made in parallel batches (all at
+    // once for a known count) and taken in order up to the first empty one. The
+    // serial loop below then redoes that one and handles the last stepover.
+    int i = 0;
+    unsigned int numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    if(count!=1 && numThreads>1 && !s_inParallelAreas) {
+        bool hitEmpty = false;
+        while(!hitEmpty && (count<0 || i<count)) {
+            std::size_t batch = count<0?numThreads:count-i;
+            std::vector<double> values(batch);
+            for(double &value : values) {
+                value = offset;
+                offset += stepover;
+            }
+            offset = values.front();
+            std::vector<CArea> rings(batch);
+            parallelAreas(batch,[&](std::size_t k) {
+                makeRing(values[k],rings[k]);
+            });
+            for(std::size_t k=0;k<batch;++k,++i,offset+=stepover) {
+                if(rings[k].m_curves.empty()) {
+                    hitEmpty = true;
+                    break;
+                }
+                addRing() = std::move(rings[k]);
+            }
+            FC_TIME_LOG(t1,"makeOffset " << i << '/' << count);
+        }
+    }
+
+    for(;count<0||i<count;++i,offset+=stepover) {
+        CArea &area = addRing();
+        makeRing(offset,area);
         if(count>1)
             FC_TIME_LOG(t1,"makeOffset " << i << '/' << count);
         if(area.m_curves.empty()) {
@@ -2314,20 +2399,27 @@ struct RGetter
     result_type operator()(const RValue &v) const { return v.first->points[v.second]; }
 };
 typedef bgi::rtree<RValue,RParameters,RGetter> RTree;
+typedef bg::model::box<gp_Pnt> RBox;
 
 struct ShapeParams {
     double abscissa;
     int k;
     short orientation;
     short direction;
+    std::chrono::steady_clock::time_point deadline; // end of the time budget of optimizeWires()
+    bool optimize;
     FC_DURATION_DECLARE(qd); //rtree query duration
     FC_DURATION_DECLARE(bd); //rtree build duration
     FC_DURATION_DECLARE(rd); //rtree remove duration
     FC_DURATION_DECLARE(xd); //BRepExtrema_DistShapeShape duration
 
-    ShapeParams(double _a, int _k, short o, short d)
-        :abscissa(_a),k(_k),orientation(o),direction(d)
+    ShapeParams(double _a, int _k, short o, short d, double opt_time)
+        :abscissa(_a),k(_k),orientation(o),direction(d),optimize(opt_time>0.0)
     {
+        if(optimize)
+            deadline = std::chrono::steady_clock::now() +
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double>(opt_time));
         FC_DURATION_INIT3(qd,bd,rd);
         FC_DURATION_INIT(xd);
     }
@@ -2430,10 +2522,81 @@ struct GetWires {
     }
 };
 
+// Improves the order of sorted wires with 2-opt moves, i.e. by reversing a
+// part of the sequence wherever this shortens the travel, until no move helps
+// any more or the time budget is used up. The first wire stays in place.
+// Closed wires start and end at the same point, so only open wires need to be
+// reversed, which is not allowed if a direction is enforced.
+static void optimizeWires(std::list<TopoDS_Shape> &wires, std::vector<gp_Pnt> &entries,
+        std::vector<gp_Pnt> &exits, std::vector<bool> &closed, gp_Pnt &pend,
+        const ShapeParams &params)
+{
+    int count = (int)wires.size();
+    if(count < 3)
+        return;
+
+    // next[i] is the first wire at or after i that can't be reversed
+    std::vector<int> next(count+1,count);
+    for(int i=count-1;i>=0;--i)
+        next[i] = (closed[i] || params.direction==Area::DirectionNone)?next[i+1]:i;
+
+    std::vector<int> order(count);
+    for(int i=0;i<count;++i)
+        order[i] = i;
+    std::vector<bool> reversed(count,false);
+
+    int moves = 0;
+    bool improved = true;
+    while(improved) {
+        improved = false;
+        for(int i=1;i<count;++i) {
+            if(std::chrono::steady_clock::now() > params.deadline) {
+                improved = false;
+                break;
+            }
+            const gp_Pnt &prev = reversed[order[i-1]]?entries[order[i-1]]:exits[order[i-1]];
+            for(int j=i;j<next[i];++j) {
+                // the wires i..j are traversed backwards, so their entry and exit swap
+                const gp_Pnt &first = reversed[order[i]]?exits[order[i]]:entries[order[i]];
+                const gp_Pnt &last = reversed[order[j]]?entries[order[j]]:exits[order[j]];
+                double d = prev.Distance(last) - prev.Distance(first);
+                if(j+1<count) {
+                    const gp_Pnt &after = reversed[order[j+1]]?exits[order[j+1]]:entries[order[j+1]];
+                    d += first.Distance(after) - last.Distance(after);
+                }
+                if(d < -Precision::Confusion()) {
+                    std::reverse(order.begin()+i,order.begin()+j+1);
+                    for(int k=i;k<=j;++k)
+                        reversed[order[k]] = !reversed[order[k]];
+                    improved = true;
+                    ++moves;
+                    break;
+                }
+            }
+        }
+    }
+    if(!moves)
+        return;
+
+    // exits and entries are indexed by the original position
+    std::vector<TopoDS_Shape> shapes(wires.begin(),wires.end());
+    wires.clear();
+    for(int i : order) {
+        if(reversed[i] && !closed[i])
+            wires.push_back(shapes[i].Reversed());
+        else
+            wires.push_back(shapes[i]);
+    }
+    int last = order.back();
+    pend = reversed[last]?entries[last]:exits[last];
+    AREA_TRACE("2-opt moves " << moves);
+}
+
 struct ShapeInfo{
     gp_Pln myPln;
     Wires myWires;
     RTree myRTree;
+    RBox myBox;
     TopoDS_Shape myShape;
     gp_Pnt myBestPt;
     gp_Pnt myStartPt;
@@ -2698,7 +2861,15 @@ struct ShapeInfo{
 
         if(min_dist < 0.01)
             min_dist = 0.01;
+
+        // entry and exit point of each wire for optimizeWires()
+        std::vector<gp_Pnt> entries, exits;
+        std::vector<bool> closed;
         while(true) {
+            if(myParams.optimize) {
+                entries.push_back(myBestPt);
+                closed.push_back(myRebase || myBestWire->isClosed);
+            }
             if(myRebase) {
                 pend = myBestPt;
                 wires.push_back(rebaseWire(pend,min_dist));
@@ -2709,6 +2880,8 @@ struct ShapeInfo{
                 wires.push_back(myBestWire->wire);
                 pend = myBestWire->pend();
             }
+            if(myParams.optimize)
+                exits.push_back(pend);
             FC_TIME_INIT(t);
             for(size_t i=0,count=myBestWire->points.size();i<count;++i)
                 myRTree.remove(RValue(myBestWire,i));
@@ -2719,6 +2892,8 @@ struct ShapeInfo{
             if(max_dist>0 && d>max_dist)
                 break;
         }
+        if(myParams.optimize)
+            optimizeWires(wires,entries,exits,closed,pend,myParams);
         return wires;
     }
 };
@@ -2923,7 +3098,7 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
         return wires;
     }
 
-    ShapeParams rparams(abscissa,nearest_k>0?nearest_k:1,orientation,direction);
+    ShapeParams rparams(abscissa,nearest_k>0?nearest_k:1,orientation,direction,sort_opt_time);
     std::list<ShapeInfo> shape_list;
 
     FC_TIME_INIT2(t,t1);
@@ -3034,6 +3209,27 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
     }
 
 
+    // Spatial index of the shapes. The distance to the bounding box of a shape
+    // is a lower bound of the distance returned by ShapeInfo::nearest(), so the
+    // search for the nearest shape can stop at the first box farther away than
+    // the best shape found so far, instead of asking every shape.
+    typedef std::pair<RBox,std::list<ShapeInfo>::iterator> ShapeValue;
+    bgi::rtree<ShapeValue,RParameters> shape_index;
+    std::vector<std::list<ShapeInfo>::iterator> planars;
+    for(auto it=shape_list.begin();it!=shape_list.end();++it) {
+        Bnd_Box bound;
+        BRepBndLib::Add(it->myShape, bound, Standard_False);
+        if(!bound.IsVoid()) {
+            bound.SetGap(0.0);
+            Standard_Real x0, y0, z0, x1, y1, z1;
+            bound.Get(x0, y0, z0, x1, y1, z1);
+            it->myBox = RBox(gp_Pnt(x0,y0,z0),gp_Pnt(x1,y1,z1));
+        }
+        shape_index.insert(ShapeValue(it->myBox,it));
+        if(it->myPlanar)
+            planars.push_back(it);
+    }
+
     gp_Pln pln;
     double hint = 0.0;
     bool hint_first = true;
@@ -3044,13 +3240,25 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
         AREA_TRACE("sorting " << shape_list.size() << ' ' << AREA_XYZ(pstart));
         double best_d = DBL_MAX;
         auto best_it = shape_list.begin();
-        for(auto it=best_it;it!=shape_list.end();++it) {
-            double d;
-            gp_Pnt pt;
-            if(it->myPlanar && current_it==shape_list.end())
-                d = it->myPln.SquareDistance(pstart);
-            else
-                d = it->nearest(pstart);
+        // planar shapes are chosen by the distance to their plane when not
+        // in a layer, which the boxes don't bound
+        bool by_plane = current_it==shape_list.end();
+        if(by_plane) {
+            for(auto it : planars) {
+                double d = it->myPln.SquareDistance(pstart);
+                if(d < best_d) {
+                    best_it = it;
+                    best_d = d;
+                }
+            }
+        }
+        for(auto qit=shape_index.qbegin(bgi::nearest(pstart,INT_MAX));qit!=shape_index.qend();++qit) {
+            auto it = qit->second;
+            if(by_plane && it->myPlanar)
+                continue;
+            if(bg::comparable_distance(pstart,qit->first) >= best_d)
+                break;
+            double d = it->nearest(pstart);
             if(d < best_d) {
                 best_it = it;
                 best_d = d;
@@ -3110,6 +3318,9 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
         if(best_it->myWires.empty()) {
             if(current_it == best_it)
                 current_it = shape_list.end();
+            shape_index.remove(ShapeValue(best_it->myBox,best_it));
+            if(best_it->myPlanar)
+                planars.erase(std::find(planars.begin(),planars.end(),best_it));
             shape_list.erase(best_it);
         }
     }
@@ -3449,6 +3660,7 @@ void Area::toPath(Toolpath &path, const std::list<TopoDS_Shape> &shapes,
 
 void Area::abort(bool aborting) {
     s_aborting = aborting;
+    CArea::set_please_abort(aborting);
 }
 
 bool Area::aborting() {
@@ -225,7 +225,11 @@
         "If two wire's end points are separated within this threshold, they are consider\n"\
         "as connected. You may want to set this to the tool diameter to keep the tool down.",\
         App::PropertyLength))\
-    ((enum, retract_axis, RetractAxis, 2,"Tool retraction axis",(X)(Y)(Z)))
+    ((enum, retract_axis, RetractAxis, 2,"Tool retraction axis",(X)(Y)(Z)))\
+    ((double, sort_opt_time, SortOptimizeTime, 0.0,\
+        "Time budget in seconds to improve the wire order after sorting by reversing parts\n"\
+        "of it where this shortens the travel (2-opt). The order of the layers is kept.\n"\
+        "0 disables the improvement.", App::PropertyFloat))
 
 /** Area path generation parameters */
 #define AREA_PARAMS_PATH \
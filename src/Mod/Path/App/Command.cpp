@@ -36,10 +36,92 @@
 #include <Base/Reader.h>
 #include <Base/Exception.h>
 #include "Command.h"
+#include "GCode.h"
 
 using namespace Base;
 using namespace Path;
 
+// CommandParameters
+
+const std::string &CommandParameters::slotName(int slot)
+{
+    static const std::string names[SlotCount] = {"A","B","C","F","I","J","K","X","Y","Z"};
+    return names[slot];
+}
+
+CommandParameters::CommandParameters(const std::map<std::string,double> &parameters)
+    :mask(0)
+{
+    for(auto &v : parameters)
+        (*this)[v.first] = v.second;
+}
+
+std::size_t CommandParameters::erase(const std::string &name)
+{
+    int slot = slotIndex(name);
+    if(slot<0)
+        return others.erase(name);
+    if(!has(slot))
+        return 0;
+    mask &= ~(1u<<slot);
+    return 1;
+}
+
+std::size_t CommandParameters::size() const
+{
+    std::size_t count = others.size();
+    for(int slot=0; slot<SlotCount; ++slot) {
+        if(has(slot))
+            ++count;
+    }
+    return count;
+}
+
+CommandParameters::const_iterator CommandParameters::begin() const
+{
+    return const_iterator(this,0,others.begin());
+}
+
+CommandParameters::const_iterator CommandParameters::end() const
+{
+    return const_iterator(this,SlotCount,others.end());
+}
+
+CommandParameters::const_iterator::const_iterator(const CommandParameters *params,
+        int slot, std::map<std::string,double>::const_iterator it)
+    :params(params),slot(slot),it(it)
+{
+    while(this->slot<SlotCount && !params->has(this->slot))
+        ++this->slot;
+}
+
+bool CommandParameters::const_iterator::inSlot() const
+{
+    if(slot>=SlotCount)
+        return false;
+    return it==params->others.end() || slotName(slot) < it->first;
+}
+
+CommandParameters::const_iterator::value_type CommandParameters::const_iterator::operator*() const
+{
+    if(inSlot())
+        return value_type(slotName(slot),params->values[slot]);
+    return value_type(it->first,it->second);
+}
+
+CommandParameters::const_iterator &CommandParameters::const_iterator::operator++()
+{
+    if(inSlot()) {
+        do {
+            ++slot;
+        } while(slot<SlotCount && !params->has(slot));
+    } else
+        ++it;
+    return *this;
+}
+
+// Command
+
 TYPESYSTEM_SOURCE(Path::Command , Base::Persistence)
 
 // Constructors & destructors
@@ -60,27 +142,73 @@ Command::~Command()
 
 // New methods
 
+Command::OpCode Command::getOpCode() const
+{
+    // G followed by a number with at most one decimal, the code is ten times the number
+    if(Name.size()<2 || Name[0]!='G')
+        return OpOther;
+    int code = 0;
+    std::size_t i = 1;
+    for(; i<Name.size() && isdigit(Name[i]); ++i) {
+        code = code*10 + (Name[i]-'0');
+        if(code>1000)
+            return OpOther;
+    }
+    if(i==1)
+        return OpOther;
+    code *= 10;
+    if(i<Name.size()) {
+        if(Name[i]!='.' || i+2!=Name.size() || !isdigit(Name[i+1]))
+            return OpOther;
+        code += Name[i+1]-'0';
+    }
+    switch(code) {
+    case 0: return OpRapid;
+    case 10: return OpLinear;
+    case 20: return OpArcCW;
+    case 30: return OpArcCCW;
+    case 170: return OpPlaneXY;
+    case 180: return OpPlaneXZ;
+    case 190: return OpPlaneYZ;
+    case 200: return OpInches;
+    case 210: return OpMillimeters;
+    case 382:
+    case 383:
+    case 384:
+    case 385: return OpProbe;
+    case 810:
+    case 820:
+    case 830:
+    case 840:
+    case 850:
+    case 860:
+    case 890: return OpCycle;
+    case 900: return OpAbsolute;
+    case 910: return OpRelative;
+    case 901: return OpAbsoluteCenter;
+    case 911: return OpRelativeCenter;
+    }
+    return OpOther;
+}
+
 Placement Command::getPlacement (const Base::Vector3d pos) const
 {
-    static const std::string x = "X";
-    static const std::string y = "Y";
-    static const std::string z = "Z";
-    static const std::string a = "A";
-    static const std::string b = "B";
-    static const std::string c = "C";
-    Vector3d vec(getParam(x, pos.x),getParam(y, pos.y),getParam(z, pos.z));
+    Vector3d vec(Parameters.get(CommandParameters::SlotX, pos.x),
+                 Parameters.get(CommandParameters::SlotY, pos.y),
+                 Parameters.get(CommandParameters::SlotZ, pos.z));
     Rotation rot;
-    rot.setYawPitchRoll(getParam(a),getParam(b),getParam(c));
+    rot.setYawPitchRoll(Parameters.get(CommandParameters::SlotA),
+                        Parameters.get(CommandParameters::SlotB),
+                        Parameters.get(CommandParameters::SlotC));
     Placement plac(vec,rot);
     return plac;
 }
 
 Vector3d Command::getCenter (void) const
 {
-    static const std::string i = "I";
-    static const std::string j = "J";
-    static const std::string k = "K";
-    Vector3d vec(getParam(i),getParam(j),getParam(k));
+    Vector3d vec(Parameters.get(CommandParameters::SlotI),
+                 Parameters.get(CommandParameters::SlotJ),
+                 Parameters.get(CommandParameters::SlotK));
     return vec;
 }
 
@@ -100,106 +228,16 @@ bool Command::has(const std::string& attr) const
 
 std::string Command::toGCode (int precision, bool padzero) const
 {
-    std::stringstream str;
-    str.fill('0');
-    str << Name;
-    if(precision<0)
-        precision = 0;
-    double scale = std::pow(10.0,precision+1);
-    std::int64_t iscale = static_cast<std::int64_t>(scale)/10;
-    for(std::map<std::string,double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
-        if(i->first == "N") continue;
-
-        str << " " << i->first;
-
-        std::int64_t v = static_cast<std::int64_t>(i->second*scale);
-        if(v<0) {
-            v = -v;
-            str << '-'; //shall we allow -0 ?
-        }
-        v+=5;
-        v /= 10;
-        str << (v/iscale);
-        if(!precision) continue;
-
-        int width = precision;
-        std::int64_t digits = v%iscale;
-        if(!padzero) {
-            if(!digits) continue;
-            while(digits%10 == 0) {
-                digits/=10;
-                --width;
-            }
-        }
-        str << '.' << std::setw(width) << std::right << digits;
-    }
-    return str.str();
+    std::string str;
+    GCodeWriter writer(str, precision, padzero);
+    writer.write(*this);
+    return str;
 }
 
 void Command::setFromGCode (const std::string& str)
 {
-    Parameters.clear();
-    std::string mode = "none";
-    std::string key;
-    std::string value;
-    for (unsigned int i=0; i < str.size(); i++) {
-        if ( (isdigit(str[i])) || (str[i] == '-') || (str[i] == '.') ) {
-            value += str[i];
-        } else if (isalpha(str[i])) {
-            if (mode == "command") {
-                if (!key.empty() && !value.empty()) {
-                    std::string cmd = key + value;
-                    boost::to_upper(cmd);
-                    Name = cmd;
-                    key = "";
-                    value = "";
-                    mode = "argument";
-                } else {
-                    throw Base::BadFormatError("Badly formatted GCode command");
-                }
-                mode = "argument";
-            } else if (mode == "none") {
-                mode = "command";
-            } else if (mode == "argument") {
-                if (!key.empty() && !value.empty()) {
-                    double val = std::atof(value.c_str());
-                    boost::to_upper(key);
-                    Parameters[key] = val;
-                    key = "";
-                    value = "";
-                } else {
-                    throw Base::BadFormatError("Badly formatted GCode argument");
-                }
-            } else if (mode == "comment") {
-                value += str[i];
-            }
-            key = str[i];
-        } else if (str[i] == '(') {
-            mode = "comment";
-        } else if (str[i] == ')') {
-            key = "(";
-            value += ")";
-        } else {
-            // add non-ascii characters only if this is a comment
-            if (mode == "comment") {
-                value += str[i];
-            }
-        }
-    }
-    if (!key.empty() && !value.empty()) {
-        if ( (mode == "command") || (mode == "comment") ) {
-            std::string cmd = key + value;
-            if (mode == "command")
-                boost::to_upper(cmd);
-            Name = cmd;
-        } else {
-            double val = std::atof(value.c_str());
-            boost::to_upper(key);
-            Parameters[key] = val;
-        }
-    } else {
-        throw Base::BadFormatError("Badly formatted GCode argument");
-    }
+    GCodeReader reader;
+    reader.parseCommand(str.data(), str.data()+str.size(), *this);
 }
 
 void Command::setFromPlacement (const Base::Placement &plac)
@@ -261,9 +299,9 @@ Command Command::transform(const Base::Placement& other)
     plac.getRotation().getYawPitchRoll(aval,bval,cval);
     Command c = Command();
     c.Name = Name;
-    for(std::map<std::string,double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
-        std::string k = i->first;
-        double v = i->second;
+    for(auto param : Parameters) {
+        const std::string &k = param.first;
+        double v = param.second;
         if (k == "X")
             v = xval;
         if (k == "Y")
@@ -283,8 +321,10 @@ Command Command::transform(const Base::Placement& other)
 
 void Command::scaleBy(double factor)
 {
-    for(std::map<std::string, double>::const_iterator i = Parameters.begin(); i != Parameters.end(); ++i) {
-        switch (i->first[0]) {
+    CommandParameters scaled;
+    for(auto param : Parameters) {
+        double v = param.second;
+        switch (param.first[0]) {
             case 'X':
             case 'Y':
             case 'Z':
@@ -293,10 +333,12 @@ void Command::scaleBy(double factor)
             case 'R':
             case 'Q':
             case 'F':
-                Parameters[i->first] = i->second * factor;
+                v *= factor;
                 break;
         }
+        scaled[param.first] = v;
     }
+    Parameters = scaled;
 }
 
 // Reimplemented from base class
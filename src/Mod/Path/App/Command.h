@@ -24,14 +24,134 @@
 #ifndef PATH_COMMAND_H
 #define PATH_COMMAND_H
 
+#include <cstdint>
 #include <map>
 #include <string>
+#include <utility>
 #include <Base/Persistence.h>
 #include <Base/Placement.h>
 #include <Base/Vector3D.h>
 
 namespace Path
 {
+    /** The parameters (words) of a cnc command
+     *
+     * The words of the common moves (A, B, C, F, I, J, K, X, Y, Z) are kept in
+     * fixed slots, all other words in an overflow map, so that a typical move
+     * needs no allocation and the lookup of a word is a simple switch. The
+     * interface follows std::map<std::string,double>, iteration visits the
+     * words in alphabetical order.
+     */
+    class PathExport CommandParameters
+    {
+    public:
+        enum Slot {
+            SlotA, SlotB, SlotC, SlotF, SlotI, SlotJ, SlotK, SlotX, SlotY, SlotZ,
+            SlotCount
+        };
+
+        // the slot of a word or -1 if it is kept in the overflow map
+        static inline int slotIndex(const std::string &name) {
+            return name.size()==1 ? slotIndex(name[0]) : -1;
+        }
+        static inline int slotIndex(char name) {
+            switch(name) {
+            case 'A': return SlotA;
+            case 'B': return SlotB;
+            case 'C': return SlotC;
+            case 'F': return SlotF;
+            case 'I': return SlotI;
+            case 'J': return SlotJ;
+            case 'K': return SlotK;
+            case 'X': return SlotX;
+            case 'Y': return SlotY;
+            case 'Z': return SlotZ;
+            }
+            return -1;
+        }
+        static const std::string &slotName(int slot);
+
+        class PathExport const_iterator
+        {
+        public:
+            typedef std::pair<const std::string&, double> value_type;
+
+            value_type operator*() const;
+            const_iterator &operator++();
+            bool operator==(const const_iterator &other) const {
+                return slot==other.slot && it==other.it;
+            }
+            bool operator!=(const const_iterator &other) const {
+                return !(*this == other);
+            }
+
+        private:
+            friend class CommandParameters;
+            const_iterator(const CommandParameters *params, int slot,
+                    std::map<std::string,double>::const_iterator it);
+            // true if the current word is the one of the slot
+            bool inSlot() const;
+
+            const CommandParameters *params;
+            int slot;
+            std::map<std::string,double>::const_iterator it;
+        };
+
+        CommandParameters() : mask(0) {}
+        CommandParameters(const std::map<std::string,double> &parameters);
+
+        bool has(int slot) const {
+            return (mask & (1u<<slot)) != 0;
+        }
+        double get(int slot, double fallback = 0.0) const {
+            return has(slot) ? values[slot] : fallback;
+        }
+        void set(int slot, double value) {
+            values[slot] = value;
+            mask |= (1u<<slot);
+        }
+
+        double get(const std::string &name, double fallback = 0.0) const {
+            int slot = slotIndex(name);
+            if(slot>=0)
+                return get(slot,fallback);
+            auto it = others.find(name);
+            return it==others.end() ? fallback : it->second;
+        }
+
+        // std::map like interface
+        double &operator[](const std::string &name) {
+            int slot = slotIndex(name);
+            if(slot<0)
+                return others[name];
+            if(!has(slot))
+                set(slot,0.0);
+            return values[slot];
+        }
+        std::size_t count(const std::string &name) const {
+            int slot = slotIndex(name);
+            if(slot>=0)
+                return has(slot) ? 1 : 0;
+            return others.count(name);
+        }
+        std::size_t erase(const std::string &name);
+        std::size_t size() const;
+        bool empty() const {
+            return !mask && others.empty();
+        }
+        void clear() {
+            mask = 0;
+            others.clear();
+        }
+        const_iterator begin() const;
+        const_iterator end() const;
+
+    private:
+        double values[SlotCount];
+        std::uint16_t mask;
+        std::map<std::string,double> others;
+    };
+
     /** The representation of a cnc command in a path */
     class PathExport Command : public Base::Persistence
     {
@@ -43,6 +163,26 @@ namespace Path
         Command(const char* name,
                 const std::map<std::string,double>& parameters);
         ~Command();
+
+        /// the commands which get a special treatment when walking a path
+        enum OpCode {
+            OpOther,
+            OpRapid,            // G0
+            OpLinear,           // G1
+            OpArcCW,            // G2
+            OpArcCCW,           // G3
+            OpPlaneXY,          // G17
+            OpPlaneXZ,          // G18
+            OpPlaneYZ,          // G19
+            OpInches,           // G20
+            OpMillimeters,      // G21
+            OpProbe,            // G38.2 - G38.5
+            OpCycle,            // G81 - G86, G89
+            OpAbsolute,         // G90
+            OpRelative,         // G91
+            OpAbsoluteCenter,   // G90.1
+            OpRelativeCenter,   // G91.1
+        };
         // from base class
         virtual unsigned int getMemSize (void) const;
         virtual void Save (Base::Writer &/*writer*/) const;
@@ -60,15 +200,16 @@ namespace Path
         double getValue(const std::string &name) const; // returns the value of a given parameter
         void scaleBy(double factor); // scales the receiver - use for imperial/metric conversions
 
+        OpCode getOpCode() const; // returns the op code of the command name, with or without leading zero
+
         // this assumes the name is upper case
         inline double getParam(const std::string &name, double fallback = 0.0) const {
-            auto it = Parameters.find(name);
-            return it==Parameters.end() ? fallback : it->second;
+            return Parameters.get(name, fallback);
         }
 
         // attributes
         std::string Name;
-        std::map<std::string,double> Parameters;
+        CommandParameters Parameters;
     };
     
 } //namespace Path
@@ -47,11 +47,8 @@ std::string CommandPy::representation(void) const
     str << "Command ";
     str << getCommandPtr()->Name;
     str << " [";
-    for(std::map<std::string,double>::iterator i = getCommandPtr()->Parameters.begin(); i != getCommandPtr()->Parameters.end(); ++i) {
-        std::string k = i->first;
-        double v = i->second;
-        str << " " << k << ":" << v;
-    }
+    for(auto param : getCommandPtr()->Parameters)
+        str << " " << param.first << ":" << param.second;
     str << " ]";
     return str.str();
 }
@@ -165,8 +162,8 @@ Py::Dict CommandPy::getParameters(void) const
 {
     // dict now a class member , https://forum.freecadweb.org/viewtopic.php?f=15&t=50583
     if (parameters_copy_dict.length()==0) {    
-      for(std::map<std::string,double>::iterator i = getCommandPtr()->Parameters.begin(); i != getCommandPtr()->Parameters.end(); ++i) {
-          parameters_copy_dict.setItem(i->first, Py::Float(i->second));
+      for(auto param : getCommandPtr()->Parameters) {
+          parameters_copy_dict.setItem(param.first, Py::Float(param.second));
       }
     }
     return parameters_copy_dict;
@@ -285,7 +282,7 @@ PyObject *CommandPy::getCustomAttributes(const char* attr) const
         if (isalpha(satt[0])) {
             boost::to_upper(satt);
             if (getCommandPtr()->Parameters.count(satt)) {
-                return PyFloat_FromDouble(getCommandPtr()->Parameters[satt]);
+                return PyFloat_FromDouble(getCommandPtr()->getParam(satt));
             }
             Py_INCREF(Py_None);
             return Py_None;
@@ -0,0 +1,331 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cctype>
+# include <cmath>
+# include <cstdlib>
+# include <cstring>
+# include <iostream>
+# include <iterator>
+#endif
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include "Command.h"
+#include "GCode.h"
+
+using namespace Path;
+
+// GCodeReader
+
+// same result as std::atof() for the word values, which only contain digits, '-' and '.'
+static double toDouble(const std::string &str)
+{
+    static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8,
+        1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+    const char *s = str.c_str();
+    bool negative = (*s == '-');
+    if (negative)
+        ++s;
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int decimals = 0;
+    bool dot = false;
+    for (;; ++s) {
+        if (isdigit(*s)) {
+            // an exact integer mantissa divided by an exact power of ten is correctly rounded
+            if (++digits > 15)
+                return std::atof(str.c_str());
+            mantissa = mantissa*10 + (*s-'0');
+            if (dot)
+                ++decimals;
+        } else if (*s == '.' && !dot) {
+            dot = true;
+        } else
+            break;
+    }
+    if (!digits)
+        return 0.0;
+    double v = static_cast<double>(mantissa) / powers[decimals];
+    return negative ? -v : v;
+}
+
+void GCodeReader::setParameter(Command &cmd, char key)
+{
+    key = static_cast<char>(toupper(key));
+    double v = toDouble(value);
+    int slot = CommandParameters::slotIndex(key);
+    if (slot >= 0)
+        cmd.Parameters.set(slot, v);
+    else
+        cmd.Parameters[std::string(1,key)] = v;
+}
+
+void GCodeReader::parseCommand(const char *begin, const char *end, Command &cmd)
+{
+    // the key is a single letter or '(' for the end of a comment, 0 if unset
+    enum { ModeNone, ModeCommand, ModeArgument, ModeComment } mode = ModeNone;
+    char key = 0;
+    value.clear();
+    cmd.Parameters.clear();
+    for (const char *s = begin; s != end; ++s) {
+        char c = *s;
+        if (isdigit(c) || (c == '-') || (c == '.')) {
+            value += c;
+        } else if (isalpha(c)) {
+            if (mode == ModeCommand) {
+                if (!key || value.empty())
+                    throw Base::BadFormatError("Badly formatted GCode command");
+                cmd.Name.assign(1, key);
+                cmd.Name += value;
+                for (auto &ch : cmd.Name)
+                    ch = static_cast<char>(toupper(ch));
+                value.clear();
+                mode = ModeArgument;
+            } else if (mode == ModeNone) {
+                mode = ModeCommand;
+            } else if (mode == ModeArgument) {
+                if (!key || value.empty())
+                    throw Base::BadFormatError("Badly formatted GCode argument");
+                setParameter(cmd, key);
+                value.clear();
+            } else if (mode == ModeComment) {
+                value += c;
+            }
+            key = c;
+        } else if (c == '(') {
+            mode = ModeComment;
+        } else if (c == ')') {
+            key = '(';
+            value += ')';
+        } else if (mode == ModeComment) {
+            // add non-ascii characters only if this is a comment
+            value += c;
+        }
+    }
+    if (!key || value.empty())
+        throw Base::BadFormatError("Badly formatted GCode argument");
+    if ((mode == ModeCommand) || (mode == ModeComment)) {
+        cmd.Name.assign(1, key);
+        cmd.Name += value;
+        if (mode == ModeCommand) {
+            for (auto &ch : cmd.Name)
+                ch = static_cast<char>(toupper(ch));
+        }
+    } else {
+        setParameter(cmd, key);
+    }
+}
+
+void GCodeReader::addCommand(const char *begin, const char *end, std::vector<Command*> &commands)
+{
+    Command *cmd = new Command();
+    try {
+        parseCommand(begin, end, *cmd);
+    } catch (...) {
+        delete cmd;
+        throw;
+    }
+    Command::OpCode code = cmd->getOpCode();
+    if (code == Command::OpInches) {
+        inches = true;
+        delete cmd;
+    } else if (code == Command::OpMillimeters) {
+        inches = false;
+        delete cmd;
+    } else {
+        if (inches)
+            cmd->scaleBy(25.4);
+        commands.push_back(cmd);
+    }
+}
+
+static inline bool isCommandStart(char c)
+{
+    return c == '(' || c == 'g' || c == 'G' || c == 'm' || c == 'M';
+}
+
+void GCodeReader::parseProgram(const char *begin, const char *end, std::vector<Command*> &commands)
+{
+    // split the input by () or G or M commands, the text before the first
+    // command and after a comment up to the next command is ignored
+    inches = false;
+    const char *last = nullptr;
+    const char *s = std::find_if(begin, end, isCommandStart);
+    while (s != end) {
+        if (*s == '(') {
+            // start of comment, before opening it add the last found command
+            if (last)
+                addCommand(last, s, commands);
+            last = s;
+            s = std::find(s+1, end, ')');
+            if (s == end) {
+                // unterminated comment
+                last = nullptr;
+                break;
+            }
+            // end of comment
+            addCommand(last, s+1, commands);
+            last = nullptr;
+        } else {
+            // command
+            if (last)
+                addCommand(last, s, commands);
+            last = s;
+        }
+        s = std::find_if(s+1, end, isCommandStart);
+    }
+    // add the last command found, if any
+    if (last)
+        addCommand(last, end, commands);
+}
+
+void GCodeReader::parseFile(const std::string &filename, std::vector<Command*> &commands)
+{
+    Base::FileInfo fi(filename);
+    if (!fi.isReadable())
+        throw Base::FileException("File not readable", fi);
+    if (fi.size() == 0)
+        return;
+
+    bool parsed = false;
+    try {
+        boost::interprocess::file_mapping file(fi.filePath().c_str(), boost::interprocess::read_only);
+        boost::interprocess::mapped_region region(file, boost::interprocess::read_only);
+        region.advise(boost::interprocess::mapped_region::advice_sequential);
+        const char *data = static_cast<const char*>(region.get_address());
+        parsed = true;
+        parseProgram(data, data + region.get_size(), commands);
+    }
+    catch (const boost::interprocess::interprocess_exception&) {
+        if (parsed)
+            throw;
+    }
+
+    if (!parsed) {
+        // e.g. a file name which can't be mapped, read it the usual way
+        Base::ifstream str(fi, std::ios::in | std::ios::binary);
+        std::string gcode((std::istreambuf_iterator<char>(str)), std::istreambuf_iterator<char>());
+        parseProgram(gcode.data(), gcode.data() + gcode.size(), commands);
+    }
+}
+
+// GCodeWriter
+
+// size of the buffer before it is passed to the stream
+static const std::size_t StreamBufferSize = 1 << 16;
+
+GCodeWriter::GCodeWriter(std::ostream &out, int precision, bool padzero)
+    :stream(&out),buffer(&streamBuffer),padzero(padzero)
+{
+    streamBuffer.reserve(StreamBufferSize + 256);
+    init(precision);
+}
+
+GCodeWriter::GCodeWriter(std::string &out, int precision, bool padzero)
+    :stream(nullptr),buffer(&out),padzero(padzero)
+{
+    init(precision);
+}
+
+GCodeWriter::~GCodeWriter()
+{
+    flush();
+}
+
+void GCodeWriter::init(int prec)
+{
+    precision = prec < 0 ? 0 : prec;
+    scale = std::pow(10.0, precision+1);
+    iscale = static_cast<std::int64_t>(scale)/10;
+}
+
+void GCodeWriter::flush()
+{
+    if (stream && !streamBuffer.empty()) {
+        stream->write(streamBuffer.data(), streamBuffer.size());
+        streamBuffer.clear();
+    }
+}
+
+// writes the digits of a non negative integer, zero padded to the given width
+static inline void putInteger(std::string &buffer, std::int64_t v, int width = 1)
+{
+    char digits[32];
+    int i = sizeof(digits);
+    do {
+        digits[--i] = static_cast<char>('0' + v%10);
+        v /= 10;
+    } while (v && i > 0);
+    while (static_cast<int>(sizeof(digits)) - i < width && i > 0)
+        digits[--i] = '0';
+    buffer.append(digits + i, sizeof(digits) - i);
+}
+
+void GCodeWriter::putNumber(double value)
+{
+    std::int64_t v = static_cast<std::int64_t>(value*scale);
+    if (v < 0) {
+        v = -v;
+        put('-'); //shall we allow -0 ?
+    }
+    v += 5;
+    v /= 10;
+    putInteger(*buffer, v/iscale);
+    if (!precision)
+        return;
+
+    int width = precision;
+    std::int64_t digits = v%iscale;
+    if (!padzero) {
+        if (!digits)
+            return;
+        while (digits%10 == 0) {
+            digits /= 10;
+            --width;
+        }
+    }
+    put('.');
+    putInteger(*buffer, digits, width);
+}
+
+void GCodeWriter::write(const Command &cmd)
+{
+    put(cmd.Name);
+    for (auto param : cmd.Parameters) {
+        if (param.first == "N")
+            continue;
+        put(' ');
+        put(param.first);
+        putNumber(param.second);
+    }
+    if (stream && streamBuffer.size() >= StreamBufferSize)
+        flush();
+}
@@ -0,0 +1,115 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef PATH_GCODE_H
+#define PATH_GCODE_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Path
+{
+    class Command;
+
+    /** Single pass G-code parser
+     *
+     * The parser works on a character range, e.g. a memory mapped file, and
+     * splits it into commands at the G and M words and at the comments, the
+     * same way as Toolpath::setFromGCode() always did. The words of a command
+     * are parsed as Command::setFromGCode() does. The parser keeps its scratch
+     * buffers between the commands, so parsing a long program does not
+     * allocate anything besides the commands themselves.
+     */
+    class PathExport GCodeReader
+    {
+    public:
+        /// parses a single command, throws Base::BadFormatError
+        void parseCommand(const char *begin, const char *end, Command &cmd);
+        /** parses a program and appends the commands
+         *
+         * G20 and G21 are consumed, the commands following G20 are scaled
+         * to millimeters.
+         */
+        void parseProgram(const char *begin, const char *end, std::vector<Command*> &commands);
+        /// parses a G-code file, which is memory mapped if possible
+        void parseFile(const std::string &filename, std::vector<Command*> &commands);
+
+    private:
+        void addCommand(const char *begin, const char *end, std::vector<Command*> &commands);
+        void setParameter(Command &cmd, char key);
+
+        std::string value;
+        bool inches = false;
+    };
+
+    /** Buffered G-code emitter
+     *
+     * The output is the same as of Command::toGCode(), the numbers are written
+     * as fixed point integers without going through a stream.
+     */
+    class PathExport GCodeWriter
+    {
+    public:
+        /// writes buffered into the stream
+        GCodeWriter(std::ostream &out, int precision=6, bool padzero=true);
+        /// appends to the string
+        GCodeWriter(std::string &out, int precision=6, bool padzero=true);
+        ~GCodeWriter();
+
+        /// writes the command without a line break
+        void write(const Command &cmd);
+        /// writes the command followed by a line break
+        void writeLine(const Command &cmd) {
+            write(cmd);
+            put('\n');
+        }
+        void put(char c) {
+            buffer->push_back(c);
+        }
+        void put(const char *s, std::size_t size) {
+            buffer->append(s,size);
+        }
+        void put(const std::string &s) {
+            buffer->append(s);
+        }
+        /// writes a number with the precision of the writer
+        void putNumber(double value);
+        /// passes the buffered output to the stream
+        void flush();
+
+    private:
+        void init(int precision);
+
+        std::ostream *stream;
+        std::string streamBuffer;
+        std::string *buffer;
+        int precision;
+        bool padzero;
+        double scale;
+        std::int64_t iscale;
+    };
+
+} //namespace Path
+
+#endif // PATH_GCODE_H
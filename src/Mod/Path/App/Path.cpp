@@ -24,12 +24,17 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <cstring>
+# include <iterator>
+# include <unordered_map>
 # include <boost/regex.hpp>
 #endif
 
 #include <App/Application.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Base/FileInfo.h>
 #include <Base/Parameter.h>
 #include <Base/Reader.h>
 #include <Base/Stream.h>
@@ -41,6 +46,7 @@
 //#include "Mod/Robot/App/kdl_cp/rotational_interpolation_sa.hpp"
 //#include "Mod/Robot/App/kdl_cp/utilities/error.h"
 
+#include "GCode.h"
 #include "Path.h"
 #include <Mod/Path/App/PathSegmentWalker.h>
 
@@ -94,7 +100,7 @@ void Toolpath::addCommand(const Command &Cmd)
 {
     Command *tmp = new Command(Cmd);
     vpcCommands.push_back(tmp);
-    recalculate();
+    invalidate(vpcCommands.size()-1);
 }
 
 void Toolpath::insertCommand(const Command &Cmd, int pos)
@@ -104,10 +110,10 @@ void Toolpath::insertCommand(const Command &Cmd, int pos)
     } else if (pos <= static_cast<int>(vpcCommands.size())) {
         Command *tmp = new Command(Cmd);
         vpcCommands.insert(vpcCommands.begin()+pos,tmp);
+        invalidate(pos);
     } else {
         throw Base::IndexError("Index not in range");
     }
-    recalculate();
 }
 
 void Toolpath::deleteCommand(int pos)
@@ -115,38 +121,85 @@ void Toolpath::deleteCommand(int pos)
     if (pos == -1) {
         //delete(*vpcCommands.rbegin()); // causes crash
         vpcCommands.pop_back();
+        invalidate(vpcCommands.size());
     } else if (pos <= static_cast<int>(vpcCommands.size())) {
         vpcCommands.erase (vpcCommands.begin()+pos);
+        invalidate(pos);
     } else {
         throw Base::IndexError("Index not in range");
     }
-    recalculate();
 }
 
-double Toolpath::getLength()
+void Toolpath::invalidate(std::size_t from)
 {
-    if(vpcCommands.size()==0)
-        return 0;
-    double l = 0;
-    Vector3d last(0,0,0);
-    Vector3d next;
-    for(std::vector<Command*>::const_iterator it = vpcCommands.begin();it!=vpcCommands.end();++it) {
-        std::string name = (*it)->Name;
-        next = (*it)->getPlacement(last).getPosition();
-        if ( (name == "G0") || (name == "G00") || (name == "G1") || (name == "G01") ) {
+    if (segments.size() > from)
+        segments.resize(from);
+    boundBoxValid = false;
+}
+
+void Toolpath::updateSegments() const
+{
+    // the segments before the first modified command are still valid
+    std::size_t i = segments.size();
+    if (i == vpcCommands.size())
+        return;
+    segments.reserve(vpcCommands.size());
+
+    Segment seg;
+    if (i > 0) {
+        seg = segments[i-1];
+    } else {
+        seg.total = 0;
+        seg.lengthEnd = Vector3d(0,0,0);
+        seg.timeEnd = Vector3d(0,0,0);
+    }
+
+    for (; i < vpcCommands.size(); i++) {
+        const Command &cmd = *vpcCommands[i];
+        Command::OpCode code = cmd.getOpCode();
+        seg.rapid = (code == Command::OpRapid);
+
+        // the length of the path only follows the moves
+        Vector3d last = seg.lengthEnd;
+        Vector3d next = cmd.getPlacement(last).getPosition();
+        if ( (code == Command::OpRapid) || (code == Command::OpLinear) ) {
             // straight line
-            l += (next - last).Length();
-            last = next;
-        } else if ( (name == "G2") || (name == "G02") || (name == "G3") || (name == "G03") ) {
+            seg.total += (next - last).Length();
+            seg.lengthEnd = next;
+        } else if ( (code == Command::OpArcCW) || (code == Command::OpArcCCW) ) {
             // arc
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = cmd.getCenter();
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
-            l += angle * radius;
-            last = next;
+            seg.total += angle * radius;
+            seg.lengthEnd = next;
         }
+
+        // the cycle time follows all commands
+        last = seg.timeEnd;
+        next = cmd.getPlacement(last).getPosition();
+        seg.vertical = (last.z != next.z);
+        seg.length = 0;
+        if ( (code == Command::OpRapid) || (code == Command::OpLinear) ) {
+            seg.length = (next - last).Length();
+        } else if ( (code == Command::OpArcCW) || (code == Command::OpArcCCW) ) {
+            Vector3d center = cmd.getCenter();
+            double radius = (last - center).Length();
+            double angle = (next - center).GetAngle(last - center);
+            seg.length = angle * radius;
+        }
+        seg.timeEnd = next;
+
+        segments.push_back(seg);
     }
-    return l;
+}
+
+double Toolpath::getLength()
+{
+    if(vpcCommands.size()==0)
+        return 0;
+    updateSegments();
+    return segments.back().total;
 }
 
 double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double vRapid)
@@ -171,45 +224,16 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
     if (vpcCommands.size() == 0) {
         return 0;
     }
-    double l = 0;
-    double time = 0;
-    bool verticalMove = false;
-    Vector3d last(0,0,0);
-    Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin();it!=vpcCommands.end();++it) {
-        std::string name = (*it)->Name;
-        float feedrate = (*it)->getParam("F");
-
-        l = 0;
-        verticalMove = false;
-        feedrate = hFeed;
-        next = (*it)->getPlacement(last).getPosition();
-
-        if (last.z != next.z){
-            verticalMove = true;
-            feedrate = vFeed;
-        }
+    updateSegments();
 
-        if ((name == "G0") || (name == "G00")){
-            // Rapid Move
-            l += (next - last).Length();
-            feedrate = hRapid;
-            if(verticalMove){
-                feedrate = vRapid;
-            }
-        }else if ((name == "G1") || (name == "G01")) {
-            // Feed Move
-            l += (next - last).Length();
-        }else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03") ) {
-            // Arc Move
-            Vector3d center = (*it)->getCenter();
-            double radius = (last - center).Length();
-            double angle = (next - center).GetAngle(last - center);
-            l += angle * radius;
-        }
-
-        time += l / feedrate;
-        last = next;
+    double time = 0;
+    for (const Segment &seg : segments) {
+        float feedrate;
+        if (seg.rapid)
+            feedrate = seg.vertical ? vRapid : hRapid;
+        else
+            feedrate = seg.vertical ? vFeed : hFeed;
+        time += seg.length / feedrate;
     }
     return time;
 }
@@ -279,96 +303,60 @@ private:
 
 Base::BoundBox3d Toolpath::getBoundBox() const
 {
-    BoundBoxSegmentVisitor visitor;
-    PathSegmentWalker walker(*this);
-    walker.walk(visitor, Vector3d(0, 0, 0));
-    
-    return visitor.bb;
-}
-
-static void bulkAddCommand(const std::string &gcodestr, std::vector<Command*> &commands, bool &inches)
-{
-    Command *cmd = new Command();
-    cmd->setFromGCode(gcodestr);
-    if ("G20" == cmd->Name) {
-        inches = true;
-        delete cmd;
-    } else if ("G21" == cmd->Name) {
-        inches = false;
-        delete cmd;
-    } else {
-        if (inches) {
-            cmd->scaleBy(25.4);
-        }
-        commands.push_back(cmd);
+    if (!boundBoxValid) {
+        BoundBoxSegmentVisitor visitor;
+        PathSegmentWalker walker(*this);
+        walker.walk(visitor, Vector3d(0, 0, 0));
+        boundBox = visitor.bb;
+        boundBoxValid = true;
     }
+    return boundBox;
 }
 
 void Toolpath::setFromGCode(const std::string instr)
 {
     clear();
+    GCodeReader reader;
+    reader.parseProgram(instr.data(), instr.data()+instr.size(), vpcCommands);
+    recalculate();
+}
 
-    // remove comments
-    //boost::regex e("\\(.*?\\)");
-    //std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
-
-    // split input string by () or G or M commands
-    std::string mode = "command";
-    std::size_t found = str.find_first_of("(gGmM");
-    int last = -1;
-    bool inches = false;
-    while (found != std::string::npos)
-    {
-        if (str[found] == '(') {
-            // start of comment
-            if ( (last > -1) && (mode == "command") ) {
-                // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
-            }
-            mode = "comment";
-            last = found;
-            found = str.find_first_of(')', found+1);
-        } else if (str[found] == ')') {
-            // end of comment
-            std::string gcodestr = str.substr(last, found-last+1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-            last = -1;
-            found = str.find_first_of("(gGmM", found+1);
-            mode = "command";
-        } else if (mode == "command") {
-            // command
-            if (last > -1) {
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
-            }
-            last = found;
-            found = str.find_first_of("(gGmM", found+1);
-        }
-    }
-    // add the last command found, if any
-    if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last,std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-        }
-    }
+void Toolpath::setFromGCodeFile(const std::string &filename)
+{
+    clear();
+    GCodeReader reader;
+    reader.parseFile(filename, vpcCommands);
     recalculate();
 }
 
+void Toolpath::writeGCode(std::ostream &out, int precision, bool padzero) const
+{
+    GCodeWriter writer(out, precision, padzero);
+    for (const Command *cmd : vpcCommands)
+        writer.writeLine(*cmd);
+}
+
+void Toolpath::writeGCodeFile(const std::string &filename, int precision, bool padzero) const
+{
+    Base::FileInfo fi(filename);
+    Base::ofstream str(fi);
+    if (!str)
+        throw Base::FileException("Cannot open file for writing", fi);
+    writeGCode(str, precision, padzero);
+}
+
 std::string Toolpath::toGCode(void) const
 {
     std::string result;
-    for (std::vector<Command*>::const_iterator it=vpcCommands.begin();it!=vpcCommands.end();++it) {
-        result += (*it)->toGCode();
-        result += "\n";
-    }
+    GCodeWriter writer(result);
+    for (const Command *cmd : vpcCommands)
+        writer.writeLine(*cmd);
     return result;
 }
 
 void Toolpath::recalculate(void) // recalculates the path cache
 {
+    invalidate(0);
 
     if(vpcCommands.size()==0)
         return;
@@ -396,15 +384,15 @@ void Toolpath::recalculate(void) // recalculates the path cache
             }else{
                 Base::Placement p = (*it)->getPlacement();
                 KDL::Frame Next = toFrame(p);
-                std::string name = (*it)->Name;
+                Command::OpCode code = (*it)->getOpCode();
                 Vector3d zaxis(0,0,1);
 
-                if ( (name == "G0") || (name == "G1") || (name == "G01") ) {
+                if ( (code == Command::OpRapid) || (code == Command::OpLinear) ) {
                     // line segment
                     tempPath = new KDL::Path_Line(Last, Next, new KDL::RotationalInterpolation_SingleAxis(), 1.0, true);
                     pcPath->Add(tempPath);
                     Last = Next;
-                } else if ( (name == "G2") || (name == "G02") ) {
+                } else if (code == Command::OpArcCW) {
                     // clockwise arc
                     Vector3d fcenter = (*it)->getCenter();
                     KDL::Vector center(fcenter.x,fcenter.y,fcenter.z);
@@ -448,6 +436,221 @@ static void saveCenter(Writer &writer, const Base::Vector3d &center)
     writer.Stream() << writer.ind() << "<Center x=\"" << center.x << "\" y=\"" << center.y << "\" z=\"" << center.z << "\"/>" << std::endl;
 }
 
+// Binary doc file of a toolpath
+//
+// All numbers are little endian, unsigned integers are written as varints.
+//   magic "FCTP", format version, string table (count, then length and
+//   characters of each), command count, then per command:
+//   name index, 16 bit mask of the slot words, per set slot the bits of the
+//   value xor-ed with the bits of the previous value of that slot as varint,
+//   count of the other words, per word the key index and the value as 8 bytes.
+// Moves mostly repeat or slightly change their words, so most of the slot
+// values take only one or a few bytes and compress well in the archive.
+
+static const char BinaryMagic[4] = {'F','C','T','P'};
+static const std::uint32_t BinaryFormat = 1;
+
+namespace {
+
+class BinaryEncoder
+{
+public:
+    explicit BinaryEncoder(std::ostream &out) : out(out) {
+        buffer.reserve(BufferSize + 64);
+    }
+    ~BinaryEncoder() {
+        flush();
+    }
+    void putBytes(const char *s, std::size_t size) {
+        buffer.append(s, size);
+        if (buffer.size() >= BufferSize)
+            flush();
+    }
+    void putVarint(std::uint64_t v) {
+        while (v >= 0x80) {
+            buffer.push_back(static_cast<char>((v & 0x7f) | 0x80));
+            v >>= 7;
+        }
+        buffer.push_back(static_cast<char>(v));
+        if (buffer.size() >= BufferSize)
+            flush();
+    }
+    void putFixed(std::uint64_t v, int bytes) {
+        for (int i = 0; i < bytes; i++, v >>= 8)
+            buffer.push_back(static_cast<char>(v & 0xff));
+        if (buffer.size() >= BufferSize)
+            flush();
+    }
+    void flush() {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+private:
+    static const std::size_t BufferSize = 1 << 16;
+    std::ostream &out;
+    std::string buffer;
+};
+
+class BinaryDecoder
+{
+public:
+    BinaryDecoder(const char *begin, const char *end) : s(begin), end(end) {}
+
+    const char *getBytes(std::size_t size) {
+        if (static_cast<std::size_t>(end - s) < size)
+            throw Base::BadFormatError("Truncated binary toolpath");
+        const char *p = s;
+        s += size;
+        return p;
+    }
+    std::uint64_t getVarint() {
+        std::uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (s == end)
+                throw Base::BadFormatError("Truncated binary toolpath");
+            std::uint8_t c = static_cast<std::uint8_t>(*s++);
+            v |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+            if (!(c & 0x80))
+                return v;
+        }
+        throw Base::BadFormatError("Invalid binary toolpath");
+    }
+    std::uint64_t getFixed(int bytes) {
+        const char *p = getBytes(bytes);
+        std::uint64_t v = 0;
+        for (int i = bytes-1; i >= 0; i--)
+            v = (v << 8) | static_cast<std::uint8_t>(p[i]);
+        return v;
+    }
+
+private:
+    const char *s;
+    const char *end;
+};
+
+inline std::uint64_t toBits(double v)
+{
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+inline double fromBits(std::uint64_t bits)
+{
+    double v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+} // namespace
+
+void Toolpath::saveBinary(std::ostream &out) const
+{
+    // the string table of the command names and the other words
+    std::vector<const std::string*> strings;
+    std::unordered_map<std::string, std::uint32_t> indices;
+    auto addString = [&](const std::string &s) {
+        auto res = indices.insert(std::make_pair(s, static_cast<std::uint32_t>(strings.size())));
+        if (res.second)
+            strings.push_back(&res.first->first);
+        return res.first->second;
+    };
+    std::vector<std::uint32_t> names;
+    names.reserve(vpcCommands.size());
+    for (const Command *cmd : vpcCommands) {
+        names.push_back(addString(cmd->Name));
+        for (auto param : cmd->Parameters) {
+            if (CommandParameters::slotIndex(param.first) < 0)
+                addString(param.first);
+        }
+    }
+
+    BinaryEncoder enc(out);
+    enc.putBytes(BinaryMagic, sizeof(BinaryMagic));
+    enc.putVarint(BinaryFormat);
+    enc.putVarint(strings.size());
+    for (const std::string *s : strings) {
+        enc.putVarint(s->size());
+        enc.putBytes(s->data(), s->size());
+    }
+
+    enc.putVarint(vpcCommands.size());
+    std::uint64_t last[CommandParameters::SlotCount] = {};
+    for (std::size_t i = 0; i < vpcCommands.size(); i++) {
+        const CommandParameters &params = vpcCommands[i]->Parameters;
+        enc.putVarint(names[i]);
+        std::uint16_t mask = 0;
+        for (int slot = 0; slot < CommandParameters::SlotCount; slot++) {
+            if (params.has(slot))
+                mask |= (1u << slot);
+        }
+        enc.putFixed(mask, 2);
+        for (int slot = 0; slot < CommandParameters::SlotCount; slot++) {
+            if (!params.has(slot))
+                continue;
+            std::uint64_t bits = toBits(params.get(slot));
+            enc.putVarint(bits ^ last[slot]);
+            last[slot] = bits;
+        }
+        std::size_t others = 0;
+        for (auto param : params) {
+            if (CommandParameters::slotIndex(param.first) < 0)
+                ++others;
+        }
+        enc.putVarint(others);
+        if (!others)
+            continue;
+        for (auto param : params) {
+            if (CommandParameters::slotIndex(param.first) >= 0)
+                continue;
+            enc.putVarint(indices[param.first]);
+            enc.putFixed(toBits(param.second), 8);
+        }
+    }
+}
+
+void Toolpath::restoreBinary(const char *begin, const char *end)
+{
+    BinaryDecoder dec(begin, end);
+    if (std::memcmp(dec.getBytes(sizeof(BinaryMagic)), BinaryMagic, sizeof(BinaryMagic)) != 0)
+        throw Base::BadFormatError("Not a binary toolpath");
+    if (dec.getVarint() > BinaryFormat)
+        throw Base::BadFormatError("Binary toolpath of a newer version");
+
+    std::vector<std::string> strings(dec.getVarint());
+    for (auto &s : strings) {
+        std::size_t size = dec.getVarint();
+        s.assign(dec.getBytes(size), size);
+    }
+    auto getString = [&]() -> const std::string& {
+        std::uint64_t index = dec.getVarint();
+        if (index >= strings.size())
+            throw Base::BadFormatError("Invalid binary toolpath");
+        return strings[index];
+    };
+
+    std::uint64_t count = dec.getVarint();
+    vpcCommands.reserve(std::min<std::uint64_t>(count, end - begin));
+    std::uint64_t last[CommandParameters::SlotCount] = {};
+    for (std::uint64_t i = 0; i < count; i++) {
+        Command *cmd = new Command();
+        vpcCommands.push_back(cmd);
+        cmd->Name = getString();
+        std::uint64_t mask = dec.getFixed(2);
+        for (int slot = 0; slot < CommandParameters::SlotCount; slot++) {
+            if (!(mask & (1u << slot)))
+                continue;
+            last[slot] ^= dec.getVarint();
+            cmd->Parameters.set(slot, fromBits(last[slot]));
+        }
+        for (std::uint64_t others = dec.getVarint(); others > 0; others--) {
+            const std::string &key = getString();
+            cmd->Parameters[key] = fromBits(dec.getFixed(8));
+        }
+    }
+}
+
 void Toolpath::Save (Writer &writer) const
 {
     if (writer.isForceXML()) {
@@ -459,8 +662,12 @@ void Toolpath::Save (Writer &writer) const
         }
         writer.decInd();
     } else {
+        // older versions only read the G-code doc file
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Path");
+        saveAsGCode = hGrp->GetBool("SaveToolpathAsGCode", false);
+        std::string file = writer.ObjectName + (saveAsGCode ? ".nc" : ".bpath");
         writer.Stream() << writer.ind()
-            << "<Path file=\"" << writer.addFile((writer.ObjectName+".nc").c_str(), this) << "\" version=\"" << SchemaVersion << "\">" << std::endl;
+            << "<Path file=\"" << writer.addFile(file.c_str(), this) << "\" version=\"" << SchemaVersion << "\">" << std::endl;
         writer.incInd();
         saveCenter(writer, center);
         writer.decInd();
@@ -470,9 +677,12 @@ void Toolpath::Save (Writer &writer) const
 
 void Toolpath::SaveDocFile (Base::Writer &writer) const
 {
-    if (toGCode().empty())
+    if (vpcCommands.empty())
         return;
-    writer.Stream() << toGCode();
+    if (saveAsGCode)
+        writeGCode(writer.Stream());
+    else
+        saveBinary(writer.Stream());
 }
 
 void Toolpath::Restore(XMLReader &reader)
@@ -488,14 +698,16 @@ void Toolpath::Restore(XMLReader &reader)
 
 void Toolpath::RestoreDocFile(Base::Reader &reader)
 {
-    std::string gcode;
-    std::string line;
-    while (reader >> line) {
-        gcode += line;
-        gcode += " ";
+    // the doc file is either binary or, of older documents, G-code
+    std::string data((std::istreambuf_iterator<char>(reader)), std::istreambuf_iterator<char>());
+    if (data.size() >= sizeof(BinaryMagic) && std::memcmp(data.data(), BinaryMagic, sizeof(BinaryMagic)) == 0) {
+        clear();
+        restoreBinary(data.data(), data.data() + data.size());
+        recalculate();
+    }
+    else {
+        setFromGCode(data);
     }
-    setFromGCode(gcode);
-
 }
 
 
@@ -24,6 +24,7 @@
 #ifndef PATH_Path_H
 #define PATH_Path_H
 
+#include <iosfwd>
 #include "Command.h"
 //#include "Mod/Robot/App/kdl_cp/path_composite.hpp"
 //#include "Mod/Robot/App/kdl_cp/frames_io.hpp"
@@ -63,7 +64,10 @@ namespace Path
             double getCycleTime(double, double, double, double); // return the Cycle Time (s) of the Path
             void recalculate(void); // recalculates the points
             void setFromGCode(const std::string); // sets the path from the contents of the given GCode string
+            void setFromGCodeFile(const std::string &filename); // sets the path from the contents of the given GCode file
             std::string toGCode(void) const; // gets a gcode string representation from the Path
+            void writeGCode(std::ostream &out, int precision=6, bool padzero=true) const; // writes the gcode of the Path into the stream
+            void writeGCodeFile(const std::string &filename, int precision=6, bool padzero=true) const; // writes the gcode of the Path into the file
             Base::BoundBox3d getBoundBox(void) const;
             
             // shortcut functions
@@ -78,8 +82,28 @@ namespace Path
             static const int SchemaVersion = 2;
 
         protected:
+            void saveBinary(std::ostream &out) const;
+            void restoreBinary(const char *begin, const char *end);
+            // drops the cached geometry of the commands starting at the given index
+            void invalidate(std::size_t from);
+            void updateSegments() const;
+
             std::vector<Command*> vpcCommands;
             Base::Vector3d center;
+            mutable bool saveAsGCode = false;
+
+            // cached geometry of the commands, see getLength() and getCycleTime()
+            struct Segment {
+                double total;               // length of all moves up to here
+                Base::Vector3d lengthEnd;   // position after the last move
+                double length;              // length of this command for the cycle time
+                Base::Vector3d timeEnd;     // position after this command
+                bool rapid;
+                bool vertical;
+            };
+            mutable std::vector<Segment> segments;
+            mutable Base::BoundBox3d boundBox;
+            mutable bool boundBoxValid = false;
             //KDL::Path_Composite *pcPath;
             
         /*
@@ -225,6 +225,34 @@ PyObject* PathPy::setFromGCode(PyObject * args)
     throw Py::TypeError("Argument must be a string");
 }
 
+PyObject* PathPy::setFromGCodeFile(PyObject * args)
+{
+    char *name;
+    if (!PyArg_ParseTuple(args, "et", "utf-8", &name))
+        return 0;
+    std::string filename(name);
+    PyMem_Free(name);
+    PY_TRY {
+        getToolpathPtr()->setFromGCodeFile(filename);
+    } PY_CATCH
+    Py_Return;
+}
+
+PyObject* PathPy::writeGCodeFile(PyObject * args)
+{
+    char *name;
+    int precision = 6;
+    PyObject *padzero = Py_True;
+    if (!PyArg_ParseTuple(args, "et|iO!", "utf-8", &name, &precision, &PyBool_Type, &padzero))
+        return 0;
+    std::string filename(name);
+    PyMem_Free(name);
+    PY_TRY {
+        getToolpathPtr()->writeGCodeFile(filename, precision, PyObject_IsTrue(padzero) ? true : false);
+    } PY_CATCH
+    Py_Return;
+}
+
 // custom attributes get/set
 
 PyObject *PathPy::getCustomAttributes(const char* /*attr*/) const
@@ -142,7 +142,7 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
         std::deque<Base::Vector3d> points;
 
         const Path::Command &cmd = tp.getCommand(i);
-        const std::string &name = cmd.Name;
+        Path::Command::OpCode code = cmd.getOpCode();
         Base::Vector3d next = cmd.getPlacement().getPosition();
         double a = A;
         double b = B;
@@ -150,18 +150,19 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
 
         if (!absolute)
             next = last + next;
-        if (!cmd.has("X")) next.x = last.x;
-        if (!cmd.has("Y")) next.y = last.y;
-        if (!cmd.has("Z")) next.z = last.z;
-        if ( cmd.has("A")) a = cmd.getValue("A");
-        if ( cmd.has("B")) b = cmd.getValue("B");
-        if ( cmd.has("C")) c = cmd.getValue("C");
+        const Path::CommandParameters &params = cmd.Parameters;
+        if (!params.has(Path::CommandParameters::SlotX)) next.x = last.x;
+        if (!params.has(Path::CommandParameters::SlotY)) next.y = last.y;
+        if (!params.has(Path::CommandParameters::SlotZ)) next.z = last.z;
+        a = params.get(Path::CommandParameters::SlotA, a);
+        b = params.get(Path::CommandParameters::SlotB, b);
+        c = params.get(Path::CommandParameters::SlotC, c);
 
         Base::Rotation nrot = yawPitchRoll(a, b, c);
 
         Base::Vector3d rnext = compensateRotation(next, nrot, rotCenter);
 
-        if ( (name == "G0") || (name == "G00") || (name == "G1") || (name == "G01") ) {
+        if ( (code == Path::Command::OpRapid) || (code == Path::Command::OpLinear) ) {
             // straight line
             if (nrot != lrot) {
                 double amax = std::max(fmod(fabs(a - A), 360), std::max(fmod(fabs(b - B), 360), fmod(fabs(c - C), 360)));
@@ -184,7 +185,7 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
                 }
             }
 
-            if ("G0" == name || "G00" == name) {
+            if (code == Path::Command::OpRapid) {
                 cb.g0(i, last, rnext, points);
             } else {
                 cb.g1(i, last, rnext, points);
@@ -196,12 +197,12 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             C = c;
             lrot = nrot;
 
-        } else if ( (name == "G2") || (name == "G02") || (name == "G3") || (name == "G03") ) {
+        } else if ( (code == Path::Command::OpArcCW) || (code == Path::Command::OpArcCCW) ) {
             // arc
             Base::Vector3d norm;
             Base::Vector3d center;
 
-            if ( (name == "G2") || (name == "G02") )
+            if (code == Path::Command::OpArcCW)
                 norm.*pz = -1.0;
             else
                 norm.*pz = 1.0;
@@ -221,10 +222,10 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             // GetAngle will always return the minor angle. Switch if needed
             Base::Vector3d anorm = (last0 - center0) % (next0 - center0);
             if (anorm.*pz < 0) {
-                if(name == "G3" || name == "G03")
+                if(code == Path::Command::OpArcCCW)
                     angle = M_PI * 2 - angle;
             } else if(anorm.*pz > 0) {
-                if(name == "G2" || name == "G02")
+                if(code == Path::Command::OpArcCW)
                     angle = M_PI * 2 - angle;
             } else if (angle == 0)
                 angle = M_PI * 2;
@@ -259,23 +260,23 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             C = c;
             lrot = nrot;
 
-        } else if (name == "G90") {
+        } else if (code == Path::Command::OpAbsolute) {
             // absolute mode
             absolute = true;
 
-        } else if (name == "G91") {
+        } else if (code == Path::Command::OpRelative) {
             // relative mode
             absolute = false;
 
-        } else if (name == "G90.1") {
+        } else if (code == Path::Command::OpAbsoluteCenter) {
             // absolute mode
             absolutecenter = true;
 
-        } else if (name == "G91.1") {
+        } else if (code == Path::Command::OpRelativeCenter) {
             // relative mode
             absolutecenter = false;
 
-        } else if ((name=="G81")||(name=="G82")||(name=="G83")||(name=="G84")||(name=="G85")||(name=="G86")||(name=="G89")){
+        } else if (code == Path::Command::OpCycle) {
             // drill,tap,bore
             double r = 0;
             if (cmd.has("R"))
@@ -342,14 +343,14 @@ void PathSegmentWalker::walk(PathSegmentVisitor &cb, const Base::Vector3d &start
             lrot = nrot;
 
 
-        } else if ((name=="G38.2")||(name=="38.3")||(name=="G38.4")||(name=="G38.5")){
+        } else if (code == Path::Command::OpProbe) {
             // Straight probe
             cb.g38(i, last, next);
-        } else if(name=="G17") {
+        } else if(code == Path::Command::OpPlaneXY) {
             pz = &Base::Vector3d::z;
-        } else if(name=="G18") {
+        } else if(code == Path::Command::OpPlaneXZ) {
             pz = &Base::Vector3d::y;
-        } else if(name=="G19") {
+        } else if(code == Path::Command::OpPlaneYZ) {
             pz = &Base::Vector3d::x;
         }
     }
@@ -51,6 +51,8 @@
 #include <vector>
 #include <set>
 #include <bitset>
+#include <thread>
+#include <chrono>
 #include <cctype>
 
 #include <cinttypes>
@@ -35,6 +35,7 @@
 #include <Base/Writer.h>
 #include <Base/Reader.h>
 #include <Base/Exception.h>
+#include <Mod/Part/App/Tools.h>
 #include "Voronoi.h"
 
 using namespace Base;
@@ -44,6 +45,35 @@ TYPESYSTEM_SOURCE(Path::Voronoi , Base::BaseClass)
 
 // Helpers
 
+static Voronoi::point_type orthogonalProjection(const Voronoi::point_type &point, const Voronoi::segment_type &segment) {
+  double sx = high(segment).x() - low(segment).x();
+  double sy = high(segment).y() - low(segment).y();
+  double px = point.x() - low(segment).x();
+  double py = point.y() - low(segment).y();
+  double proj = (px * sx + py * sy) / (sx * sx + sy * sy);
+  return Voronoi::point_type(low(segment).x() + proj * sx, low(segment).y() + proj * sy);
+}
+
+static bool isColinear(const Voronoi::diagram_type &vd, const Voronoi::diagram_type::edge_type &edge, double rad,
+                       Voronoi::diagram_type::angle_map_t &angle) {
+  if (!edge.cell()->contains_segment() || !edge.twin()->cell()->contains_segment()) {
+    return false;
+  }
+  int psize = vd.points.size();
+  int i0 = edge.cell()->source_index() - psize;
+  int i1 = edge.twin()->cell()->source_index() - psize;
+  if (!vd.segmentsAreConnected(i0, i1)) {
+    return false;
+  }
+  double a = vd.angleOfSegment(i0, &angle) - vd.angleOfSegment(i1, &angle);
+  if (a > M_PI_2) {
+    a -= M_PI;
+  } else if (a < -M_PI_2) {
+    a += M_PI;
+  }
+  return fabs(a) < rad;
+}
+
 // Voronoi::diagram_type
 
 Voronoi::diagram_type::diagram_type()
@@ -72,46 +102,23 @@ Base::Vector3d Voronoi::diagram_type::scaledVector(const vertex_type &v, double
 }
 
 
-int Voronoi::diagram_type::index(const Voronoi::diagram_type::cell_type   *cell)   const {
-  auto it = cell_index.find(intptr_t(cell));
-  if (it == cell_index.end()) {
+// the diagram stores its elements in vectors, so the index is the offset from the first one
+template<typename element_type>
+static int indexOf(const std::vector<element_type> &elements, const element_type *element) {
+  if (elements.empty() || element < &elements.front() || element > &elements.back()) {
     return Voronoi::InvalidIndex;
   }
-  return it->second;
+  return int(element - &elements.front());
+}
+
+int Voronoi::diagram_type::index(const Voronoi::diagram_type::cell_type   *cell)   const {
+  return indexOf(cells(), cell);
 }
 int Voronoi::diagram_type::index(const Voronoi::diagram_type::edge_type   *edge)   const {
-  auto it = edge_index.find(intptr_t(edge));
-  if (it == edge_index.end()) {
-    return Voronoi::InvalidIndex;
-  }
-  return it->second;
+  return indexOf(edges(), edge);
 }
 int Voronoi::diagram_type::index(const Voronoi::diagram_type::vertex_type *vertex) const {
-  auto it = vertex_index.find(intptr_t(vertex));
-  if (it == vertex_index.end()) {
-    return Voronoi::InvalidIndex;
-  }
-  return it->second;
-}
-
-void Voronoi::diagram_type::reIndex() {
-  int idx = 0;
-  cell_index.clear();
-  edge_index.clear();
-  vertex_index.clear();
-
-  idx = 0;
-  for (auto it = cells().begin(); it != cells().end(); ++it, ++idx) {
-    cell_index[intptr_t(&(*it))] = idx;
-  }
-  idx = 0;
-  for (auto it = edges().begin(); it != edges().end(); ++it, ++idx) {
-    edge_index[intptr_t(&(*it))] = idx;
-  }
-  idx = 0;
-  for (auto it = vertices().begin(); it != vertices().end(); ++it, ++idx) {
-    vertex_index[intptr_t(&(*it))] = idx;
-  }
+  return indexOf(vertices(), vertex);
 }
 
 Voronoi::point_type Voronoi::diagram_type::retrievePoint(const Voronoi::diagram_type::cell_type *cell) const {
@@ -133,6 +140,22 @@ Voronoi::segment_type Voronoi::diagram_type::retrieveSegment(const Voronoi::diag
   return segments[index];
 }
 
+double Voronoi::diagram_type::distanceToSource(const Voronoi::diagram_type::edge_type *edge, const Voronoi::diagram_type::vertex_type *vertex) const {
+  Voronoi::point_type v(vertex->x(), vertex->y());
+  Voronoi::point_type p;
+  if (edge->cell()->contains_point()) {
+    p = retrievePoint(edge->cell());
+  } else if (edge->twin()->cell()->contains_point()) {
+    p = retrievePoint(edge->twin()->cell());
+  } else {
+    // both cells are sourced from segments and it does not matter which one we use
+    p = orthogonalProjection(v, retrieveSegment(edge->cell()));
+  }
+  double dx = v.x() - p.x();
+  double dy = v.y() - p.y();
+  return sqrt(dx * dx + dy * dy);
+}
+
 
 // Voronoi
 
@@ -187,7 +210,14 @@ void Voronoi::construct()
 {
   vd->clear();
   construct_voronoi(vd->points.begin(), vd->points.end(), vd->segments.begin(), vd->segments.end(), (voronoi_diagram_type*)vd);
-  vd->reIndex();
+}
+
+void Voronoi::constructAll(const std::vector<Voronoi*> &diagrams)
+{
+  // the diagrams don't share any data
+  Part::Tools::parallelFor(diagrams.size(), [&](std::size_t i) {
+    diagrams[i]->construct();
+  });
 }
 
 void Voronoi::colorExterior(const Voronoi::diagram_type::edge_type *edge, std::size_t colorValue) {
@@ -267,28 +297,40 @@ void Voronoi::colorColinear(Voronoi::color_type color, double degree) {
   double rad = degree * M_PI / 180;
 
   Voronoi::diagram_type::angle_map_t angle;
-  int psize = vd->points.size();
 
   for (diagram_type::const_edge_iterator it = vd->edges().begin(); it != vd->edges().end(); ++it) {
-    int i0 = it->cell()->source_index() - psize;
-    int i1 = it->twin()->cell()->source_index() - psize;
-    if (it->color() == 0
-        && it->cell()->contains_segment()
-        && it->twin()->cell()->contains_segment()
-        && vd->segmentsAreConnected(i0, i1)) {
-      double a0 = vd->angleOfSegment(i0, &angle);
-      double a1 = vd->angleOfSegment(i1, &angle);
-      double a = a0 - a1;
-      if (a > M_PI_2) {
-        a -= M_PI;
-      } else if (a < -M_PI_2) {
-        a += M_PI;
-      }
-      if (fabs(a) < rad) {
-        it->color(color);
-        it->twin()->color(color);
-      }
+    if (it->color() == 0 && isColinear(*vd, *it, rad, angle)) {
+      it->color(color);
+      it->twin()->color(color);
+    }
+  }
+}
+
+void Voronoi::medialAxis(std::vector<Voronoi::MedialAxisEdge> &edges, Voronoi::color_type color, double degree, double minDistance) const {
+  double rad = degree * M_PI / 180;
+  double minDist = minDistance * vd->getScale();
+
+  Voronoi::diagram_type::angle_map_t angle;
+
+  edges.clear();
+  for (diagram_type::const_edge_iterator it = vd->edges().begin(); it != vd->edges().end(); ++it) {
+    // of each pair of twins the one stored first is used
+    if (it->color() != color || !it->is_primary() || !it->is_finite() || it->twin() < &(*it)) {
+      continue;
+    }
+    if (rad > 0 && isColinear(*vd, *it, rad, angle)) {
+      continue;
+    }
+    double d0 = vd->distanceToSource(&(*it), it->vertex0());
+    double d1 = vd->distanceToSource(&(*it), it->vertex1());
+    if (d0 < minDist && d1 < minDist) {
+      continue;
     }
+    MedialAxisEdge edge;
+    edge.index     = vd->index(&(*it));
+    edge.distance0 = d0 / vd->getScale();
+    edge.distance1 = d1 / vd->getScale();
+    edges.push_back(edge);
   }
 }
 
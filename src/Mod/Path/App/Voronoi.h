@@ -77,16 +77,10 @@ namespace Path
       Base::Vector3d scaledVector(const point_type &p, double z) const;
       Base::Vector3d scaledVector(const vertex_type &v, double z) const;
 
-      typedef std::map<intptr_t, int> cell_map_type;
-      typedef std::map<intptr_t, int> edge_map_type;
-      typedef std::map<intptr_t, int> vertex_map_type;
-
       int index(const cell_type   *cell)   const;
       int index(const edge_type   *edge)   const;
       int index(const vertex_type *vertex) const;
 
-      void reIndex();
-
       std::vector<point_type>       points;
       std::vector<segment_type>     segments;
 
@@ -97,11 +91,18 @@ namespace Path
       double angleOfSegment(int i, angle_map_t *angle = 0) const;
       bool segmentsAreConnected(int i, int j) const;
 
+      // distance of one end point of the edge to the input geometry, unscaled
+      double distanceToSource(const edge_type *edge, const vertex_type *vertex) const;
+
     private:
       double          scale;
-      cell_map_type   cell_index;
-      edge_map_type   edge_index;
-      vertex_map_type vertex_index;
+    };
+
+    // a primary edge of the medial axis with the distances of its end points
+    struct MedialAxisEdge {
+      int    index;
+      double distance0;
+      double distance1;
     };
 
     void addPoint(const point_type &p);
@@ -110,6 +111,8 @@ namespace Path
     long numSegments() const;
 
     void construct();
+    // constructs independent diagrams in parallel
+    static void constructAll(const std::vector<Voronoi*> &diagrams);
     long numCells() const;
     long numEdges() const;
     long numVertices() const;
@@ -119,6 +122,10 @@ namespace Path
     void colorTwins(color_type color);
     void colorColinear(color_type color, double degree);
 
+    // collects the finite primary edges with the given color, one of each pair of twins, skipping
+    // edges between almost colinear segments and edges closer than minDistance to the input
+    void medialAxis(std::vector<MedialAxisEdge> &edges, color_type color, double degree, double minDistance = 0) const;
+
     template<typename T>
     T* create(int index) {
       return new T(vd, index);
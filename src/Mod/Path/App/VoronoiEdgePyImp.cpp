@@ -124,50 +124,18 @@ namespace {
   }
 
 
-  void addDistanceBetween(const Voronoi::diagram_type::vertex_type *v0, const Voronoi::point_type &p1, Py::List *list, double scale) {
-    if (v0) {
-      list->append(Py::Float(distanceBetween(*v0, p1, scale)));
-    } else {
-      Py_INCREF(Py_None);
-      list->append(Py::asObject(Py_None));
-    }
-  }
-
-  void addProjectedDistanceBetween(const Voronoi::diagram_type::vertex_type *v0, const Voronoi::segment_type &segment, Py::List *list, double scale) {
-    if (v0) {
-      Voronoi::point_type p0;
-      {
-        p0.x(v0->x());
-        p0.y(v0->y());
-      }
-      Voronoi::point_type p1 = orthognalProjection(p0, segment);
-      list->append(Py::Float(distanceBetween(*v0, p1, scale)));
+  void addDistanceToSource(const VoronoiEdge *edge, const Voronoi::diagram_type::vertex_type *v, Py::List *list) {
+    if (v) {
+      list->append(Py::Float(edge->dia->distanceToSource(edge->ptr, v) / edge->dia->getScale()));
     } else {
       Py_INCREF(Py_None);
       list->append(Py::asObject(Py_None));
     }
   }
 
-  bool addDistancesToPoint(const VoronoiEdge *edge, Voronoi::point_type p, Py::List *list, double scale) {
-    addDistanceBetween(edge->ptr->vertex0(), p, list, scale);
-    addDistanceBetween(edge->ptr->vertex1(), p, list, scale);
-    return true;
-  }
-
-  bool retrieveDistances(const VoronoiEdge *edge, Py::List *list) {
-    const Voronoi::diagram_type::cell_type *c0 = edge->ptr->cell();
-    if (c0->contains_point()) {
-      return addDistancesToPoint(edge, edge->dia->retrievePoint(c0), list, edge->dia->getScale());
-    }
-    const Voronoi::diagram_type::cell_type *c1 = edge->ptr->twin()->cell();
-    if (c1->contains_point()) {
-      return addDistancesToPoint(edge, edge->dia->retrievePoint(c1), list, edge->dia->getScale());
-    }
-    // at this point both cells are sourced from segments and it does not matter which one we use
-    Voronoi::segment_type segment = edge->dia->retrieveSegment(c0);
-    addProjectedDistanceBetween(edge->ptr->vertex0(), segment, list, edge->dia->getScale());
-    addProjectedDistanceBetween(edge->ptr->vertex1(), segment, list, edge->dia->getScale());
-    return false;
+  void retrieveDistances(const VoronoiEdge *edge, Py::List *list) {
+    addDistanceToSource(edge, edge->ptr->vertex0(), list);
+    addDistanceToSource(edge, edge->ptr->vertex1(), list);
   }
 
 }
@@ -29,6 +29,7 @@
 
 #include "Base/Exception.h"
 #include "Base/GeometryPyCXX.h"
+#include "Base/Interpreter.h"
 #include "Base/Vector3D.h"
 #include "Base/VectorPy.h"
 #include "Mod/Path/App/Voronoi.h"
@@ -123,6 +124,31 @@ PyObject* VoronoiPy::construct(PyObject *args) {
   return Py_None;
 }
 
+PyObject* VoronoiPy::constructAll(PyObject *args) {
+  PyObject *list = 0;
+  if (!PyArg_ParseTuple(args, "O", &list) || !PySequence_Check(list)) {
+    throw  Py::TypeError("constructAll requires a list of voronoi diagrams");
+  }
+  std::vector<Voronoi*> diagrams;
+  Py::Sequence seq(list);
+  for (Py::Sequence::iterator it = seq.begin(); it != seq.end(); ++it) {
+    PyObject *item = (*it).ptr();
+    if (!PyObject_TypeCheck(item, &(VoronoiPy::Type))) {
+      throw  Py::TypeError("constructAll requires a list of voronoi diagrams");
+    }
+    diagrams.push_back(static_cast<VoronoiPy*>(item)->getVoronoiPtr());
+  }
+
+  {
+    // the construction doesn't touch any python objects
+    Base::PyGILStateRelease unlock;
+    Voronoi::constructAll(diagrams);
+  }
+
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
 PyObject* VoronoiPy::numCells(PyObject *args)
 {
   if (!PyArg_ParseTuple(args, "")) {
@@ -274,6 +300,28 @@ PyObject* VoronoiPy::colorColinear(PyObject *args) {
   return Py_None;
 }
 
+PyObject* VoronoiPy::getMedialAxis(PyObject *args) {
+  Voronoi::color_type color = 0;
+  double degree = 10.;
+  double minDistance = 0.;
+  if (!PyArg_ParseTuple(args, "k|dd", &color, &degree, &minDistance)) {
+    throw  Py::RuntimeError("getMedialAxis requires an integer (color) and optionally an angle in degrees (default 10) and a minimum distance");
+  }
+  Voronoi *vo = getVoronoiPtr();
+  std::vector<Voronoi::MedialAxisEdge> edges;
+  vo->medialAxis(edges, color, degree, minDistance);
+
+  Py::List list(edges.size());
+  for (std::size_t i = 0; i < edges.size(); ++i) {
+    Py::Tuple tuple(3);
+    tuple.setItem(0, Py::asObject(new VoronoiEdgePy(vo->create<VoronoiEdge>(edges[i].index))));
+    tuple.setItem(1, Py::Float(edges[i].distance0));
+    tuple.setItem(2, Py::Float(edges[i].distance1));
+    list.setItem(i, tuple);
+  }
+  return Py::new_reference_to(list);
+}
+
 PyObject* VoronoiPy::resetColor(PyObject *args) {
   Voronoi::color_type color = 0;
   if (!PyArg_ParseTuple(args, "k", &color)) {
@@ -241,6 +241,10 @@ ViewProviderPath::ViewProviderPath()
 
 ViewProviderPath::~ViewProviderPath()
 {
+    // the fields may point into the arrays of this view provider
+    pcLines->coordIndex.setNum(0);
+    pcLineColor->diffuseColor.setNum(0);
+
     pcLineCoords->unref();
     pcMarkerCoords->unref();
     pcMarkerSwitch->unref();
@@ -345,38 +349,8 @@ void ViewProviderPath::onChanged(const App::Property* prop)
     if (prop == &LineWidth) {
         pcDrawStyle->lineWidth = LineWidth.getValue();
     } else if (prop == &NormalColor) {
-        if (colorindex.size() > 0 && coordStart>=0 && coordStart<(int)colorindex.size()) {
-            const App::Color& c = NormalColor.getValue();
-            ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Path");
-            unsigned long rcol = hGrp->GetUnsigned("DefaultRapidPathColor",2852126975UL); // dark red (170,0,0)
-            float rr,rg,rb;
-            rr = ((rcol >> 24) & 0xff) / 255.0; rg = ((rcol >> 16) & 0xff) / 255.0; rb = ((rcol >> 8) & 0xff) / 255.0;
-
-            unsigned long pcol = hGrp->GetUnsigned("DefaultProbePathColor",4293591295UL); // yellow (255,255,5)
-            float pr,pg,pb;
-            pr = ((pcol >> 24) & 0xff) / 255.0; pg = ((pcol >> 16) & 0xff) / 255.0; pb = ((pcol >> 8) & 0xff) / 255.0;
-
-            pcMatBind->value = SoMaterialBinding::PER_PART;
-            // resizing and writing the color vector:
-
-            int count = coordEnd-coordStart;
-            if(count > (int)colorindex.size()-coordStart) count = colorindex.size()-coordStart;
-            pcLineColor->diffuseColor.setNum(count);
-            SbColor* colors = pcLineColor->diffuseColor.startEditing();
-            for(int i=0;i<count;i++) {
-                switch(colorindex[i+coordStart]){
-                case 0:
-                    colors[i] = SbColor(rr,rg,rb);
-                    break;
-                case 1:
-                    colors[i] = SbColor(c.r,c.g,c.b);
-                    break;
-                default:
-                    colors[i] = SbColor(pr,pg,pb);
-                }
-            }
-            pcLineColor->diffuseColor.finishEditing();
-        }
+        updateColors();
+        updateColorRange();
     } else if (prop == &MarkerColor) {
         const App::Color& c = MarkerColor.getValue();
         pcMarkerColor->rgb.setValue(c.r,c.g,c.b);
@@ -416,6 +390,42 @@ unsigned long ViewProviderPath::getBoundColor() const {
         return hGrp->GetUnsigned("DefaultBBoxSelectionColor",0xc8ffff00UL); // rgb(0,85,255)
 }
 
+void ViewProviderPath::updateColors()
+{
+    // the colors of all segments, the shown range is set by updateColorRange()
+    pcMatBind->value = SoMaterialBinding::OVERALL;
+    pcLineColor->diffuseColor.setNum(0);
+    lineColors.clear();
+    if (colorindex.empty())
+        return;
+
+    const App::Color& c = NormalColor.getValue();
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Path");
+    unsigned long rcol = hGrp->GetUnsigned("DefaultRapidPathColor",2852126975UL); // dark red (170,0,0)
+    float rr,rg,rb;
+    rr = ((rcol >> 24) & 0xff) / 255.0; rg = ((rcol >> 16) & 0xff) / 255.0; rb = ((rcol >> 8) & 0xff) / 255.0;
+
+    unsigned long pcol = hGrp->GetUnsigned("DefaultProbePathColor",4293591295UL); // yellow (255,255,5)
+    float pr,pg,pb;
+    pr = ((pcol >> 24) & 0xff) / 255.0; pg = ((pcol >> 16) & 0xff) / 255.0; pb = ((pcol >> 8) & 0xff) / 255.0;
+
+    SbColor colors[3] = {SbColor(rr,rg,rb), SbColor(c.r,c.g,c.b), SbColor(pr,pg,pb)};
+    lineColors.resize(colorindex.size());
+    for (std::size_t i=0; i<colorindex.size(); i++)
+        lineColors[i] = colors[colorindex[i] < 0 || colorindex[i] > 2 ? 2 : colorindex[i]];
+}
+
+void ViewProviderPath::updateColorRange()
+{
+    if (lineColors.empty() || coordStart<0 || coordStart>=(int)lineColors.size())
+        return;
+
+    pcMatBind->value = SoMaterialBinding::PER_PART;
+    int count = coordEnd-coordStart;
+    if(count > (int)lineColors.size()-coordStart) count = lineColors.size()-coordStart;
+    pcLineColor->diffuseColor.setValuesPointer(count, &lineColors[coordStart]);
+}
+
 void ViewProviderPath::updateShowConstraints() {
     Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
     const Toolpath &tp = pcPathObj->Path.getValue();
@@ -605,7 +615,7 @@ void ViewProviderPath::updateVisual(bool rebuild) {
 
     updateShowConstraints();
 
-    pcLines->coordIndex.deleteValues(0);
+    pcLines->coordIndex.setNum(0);
 
     if(rebuild) {
         Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
@@ -637,11 +647,30 @@ void ViewProviderPath::updateVisual(bool rebuild) {
             pcLineCoords->point.finishEditing();
 
             pcMarkerCoords->point.setNum(markers.size());
-            for(unsigned int i=0;i<markers.size();i++)
-                pcMarkerCoords->point.set1Value(i,markers[i].x,markers[i].y,markers[i].z);
+            verts = pcMarkerCoords->point.startEditing();
+            i=0;
+            for(const auto &pt : markers)
+                verts[i++].setValue(pt.x,pt.y,pt.z);
+            pcMarkerCoords->point.finishEditing();
 
             recomputeBoundingBox();
         }
+
+        // the line indices of all edges, consecutive edges share their end point
+        lineIndices.clear();
+        edgeOffsets.clear();
+        edgeOffsets.reserve(edgeIndices.size()+1);
+        int start = 0;
+        for(int end : edgeIndices) {
+            edgeOffsets.push_back(lineIndices.size());
+            for(;start<end;++start)
+                lineIndices.push_back(start);
+            lineIndices.push_back(-1);
+            --start;
+        }
+        edgeOffsets.push_back(lineIndices.size());
+
+        updateColors();
     }
 
     // count = index + separators
@@ -669,21 +698,10 @@ void ViewProviderPath::updateVisual(bool rebuild) {
 
     // count = coord indices + index separators
     int count = coordEnd-coordStart+2*(edgeEnd-edgeStart-1)+1;
+    assert(count == edgeOffsets[edgeEnd]-edgeOffsets[edgeStart]);
+    pcLines->coordIndex.setValuesPointer(count, &lineIndices[edgeOffsets[edgeStart]]);
 
-    pcLines->coordIndex.setNum(count);
-    int32_t *idx = pcLines->coordIndex.startEditing();
-    i=0;
-    int start = coordStart;
-    for(int e=edgeStart;e!=edgeEnd;++e) {
-        for(int end=edgeIndices[e];start<end;++start)
-            idx[i++] = start;
-        idx[i++]=-1;
-        --start;
-    }
-    pcLines->coordIndex.finishEditing();
-    assert(i==count);
-
-    NormalColor.touch();
+    updateColorRange();
 }
 
 void ViewProviderPath::recomputeBoundingBox()
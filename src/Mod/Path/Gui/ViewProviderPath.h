@@ -24,6 +24,7 @@
 #ifndef PATH_ViewProviderPath_H
 #define PATH_ViewProviderPath_H
 
+#include <Inventor/SbColor.h>
 #include <App/PropertyGeo.h>
 #include <Gui/Selection.h>
 #include <Gui/ViewProviderGeometryObject.h>
@@ -92,6 +93,9 @@ protected:
     virtual void onChanged(const App::Property* prop);
     virtual unsigned long getBoundColor() const;
 
+    void updateColors();
+    void updateColorRange();
+
     SoCoordinate3         * pcLineCoords;
     SoCoordinate3         * pcMarkerCoords;
     SoDrawStyle           * pcDrawStyle;
@@ -109,6 +113,12 @@ protected:
     std::deque<int>   edge2Command;
     std::deque<int>   edgeIndices;
 
+    // The line indices and colors of the whole path. The shown range only
+    // points into them, so changing StartIndex or ShowCount copies nothing.
+    std::vector<int32_t> lineIndices;
+    std::vector<int>     edgeOffsets;
+    std::vector<SbColor> lineColors;
+
     mutable int pt0Index;
     bool blockPropertyChange;
     int edgeStart;
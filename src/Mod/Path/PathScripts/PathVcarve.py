@@ -61,8 +61,8 @@ Vertex = {}
 _sorting = 'global'
 
 
-def _collectVoronoiWires(vd):
-    edges = [e for e in vd.Edges if e.Color == PRIMARY]
+def _collectVoronoiWires(vd, colinear):
+    edges = [e for e, d0, d1 in vd.getMedialAxis(PRIMARY, colinear)]
     vertex = {}
     for e in edges:
         for v in e.Vertices:
@@ -266,22 +266,22 @@ class ObjectVcarve(PathEngraveBase.ObjectOp):
 
         VD.clear()
         voronoiWires = []
+        diagrams = []
         for f in faces:
             vd = Path.Voronoi()
             insert_many_wires(vd, f.Wires)
+            diagrams.append(vd)
 
-            vd.construct()
+        Path.Voronoi.constructAll(diagrams)
 
-            for e in vd.Edges:
-                e.Color = PRIMARY if e.isPrimary() else SECONDARY
+        for f, vd in zip(faces, diagrams):
             vd.colorExterior(EXTERIOR1)
             vd.colorExterior(EXTERIOR2,
                 lambda v: not f.isInside(v.toPoint(f.BoundBox.ZMin),
                 obj.Tolerance, True))
-            vd.colorColinear(COLINEAR, obj.Colinear)
-            vd.colorTwins(TWIN)
 
-            wires = _collectVoronoiWires(vd)
+            # the medial axis skips secondary, colinear and twin edges itself
+            wires = _collectVoronoiWires(vd, obj.Colinear)
             if _sorting != 'global':
                 wires = _sortVoronoiWires(wires)
             voronoiWires.extend(wires)
@@ -94,6 +94,45 @@ Base::Placement * PathSim::ApplyCommand(Base::Placement * pos, Command * cmd)
 	return plc;
 }
 
+Base::Placement * PathSim::ApplyCommands(Base::Placement * pos, const std::vector<Command*> & cmds)
+{
+	Point3D fromPos(*pos);
+	Point3D toPos(*pos);
+	std::vector<cSimMove> moves;
+	moves.reserve(cmds.size());
+	for (Command *cmd : cmds)
+	{
+		toPos.UpdateCmd(*cmd);
+		switch (cmd->getOpCode())
+		{
+		case Command::OpRapid:
+		case Command::OpLinear:
+			moves.emplace_back(cSimMove::Linear, fromPos, toPos);
+			break;
+		case Command::OpArcCW:
+		case Command::OpArcCCW:
+		{
+			Vector3d vcent = cmd->getCenter();
+			Point3D cent(vcent);
+			moves.emplace_back(cmd->getOpCode() == Command::OpArcCW ? cSimMove::ArcCW : cSimMove::ArcCCW,
+				fromPos, toPos, cent);
+			break;
+		}
+		default:
+			break;
+		}
+		fromPos = toPos;
+	}
+
+	if (m_tool != NULL)
+		m_stock->ApplyMoves(moves, *m_tool);
+
+	Base::Placement *plc = new Base::Placement();
+	Vector3d vec(toPos.x, toPos.y, toPos.z);
+	plc->setPosition(vec);
+	return plc;
+}
+
 
 
 
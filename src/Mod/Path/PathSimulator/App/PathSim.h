@@ -52,6 +52,7 @@ namespace PathSimulator
 			void BeginSimulation(Part::TopoShape * stock, float resolution);
 			void SetToolShape(const TopoDS_Shape& toolShape, float resolution);
 			Base::Placement * ApplyCommand(Base::Placement * pos, Command * cmd);
+			Base::Placement * ApplyCommands(Base::Placement * pos, const std::vector<Command*> & cmds);
 
 		public:
 			cStock * m_stock;
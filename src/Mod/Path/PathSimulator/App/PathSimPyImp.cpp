@@ -122,6 +122,35 @@ PyObject* PathSimPy::ApplyCommand(PyObject * args, PyObject * kwds)
 	return newposPy;
 }
 
+PyObject* PathSimPy::ApplyCommands(PyObject * args, PyObject * kwds)
+{
+	static char *kwlist[] = { "position", "commands", NULL };
+	PyObject *pObjPlace;
+	PyObject *pObjCmds;
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O", kwlist, &(Base::PlacementPy::Type), &pObjPlace, &pObjCmds))
+		return 0;
+	if (!PySequence_Check(pObjCmds)) {
+		PyErr_SetString(PyExc_TypeError, "commands must be a sequence of Path.Command");
+		return 0;
+	}
+
+	std::vector<Path::Command*> cmds;
+	Py::Sequence seq(pObjCmds);
+	for (Py::Sequence::iterator it = seq.begin(); it != seq.end(); ++it) {
+		PyObject *pObjCmd = (*it).ptr();
+		if (!PyObject_TypeCheck(pObjCmd, &(Path::CommandPy::Type))) {
+			PyErr_SetString(PyExc_TypeError, "commands must be a sequence of Path.Command");
+			return 0;
+		}
+		cmds.push_back(static_cast<Path::CommandPy*>(pObjCmd)->getCommandPtr());
+	}
+
+	PathSim *sim = getPathSimPtr();
+	Base::Placement *pos = static_cast<Base::PlacementPy*>(pObjPlace)->getPlacementPtr();
+	Base::Placement *newpos = sim->ApplyCommands(pos, cmds);
+	return new Base::PlacementPy(newpos);
+}
+
 Py::Object PathSimPy::getTool(void) const
 {
     //return Py::Object();
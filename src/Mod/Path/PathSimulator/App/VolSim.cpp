@@ -29,8 +29,11 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <thread>
 #endif
 
+#include <Mod/Part/App/Tools.h>
+
 #include "VolSim.h"
 
 //************************************************************************************************************
@@ -50,6 +53,21 @@ cStock::cStock(float px, float py, float pz, float lx, float ly, float lz, float
 			m_stock[x][y] = m_plane;
 			m_attr[x][y] = 0;
 		}
+
+	// tiles are stored column by column, so a band of columns owns a contiguous range
+	m_tx = (m_x + SIM_TILE_SIZE - 1) / SIM_TILE_SIZE;
+	m_ty = (m_y + SIM_TILE_SIZE - 1) / SIM_TILE_SIZE;
+	m_tiles.resize(m_tx * m_ty);
+	for (int tx = 0; tx < m_tx; tx++)
+		for (int ty = 0; ty < m_ty; ty++)
+		{
+			cStockTile &tile = m_tiles[tx * m_ty + ty];
+			tile.x0 = tx * SIM_TILE_SIZE;
+			tile.y0 = ty * SIM_TILE_SIZE;
+			tile.x1 = std::min(m_x, tile.x0 + SIM_TILE_SIZE);
+			tile.y1 = std::min(m_y, tile.y0 + SIM_TILE_SIZE);
+			tile.dirty = true;
+		}
 }
 
 cStock::~cStock()
@@ -57,7 +75,7 @@ cStock::~cStock()
 }
 
 
-float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz)
+float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz, const cStockTile & tile)
 {
 	float z = m_stock[xp][yp];
 	bool xr_ok = true;
@@ -71,7 +89,7 @@ float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool s
 		if (xr_ok)
 		{
 			int tx = xp + x_size;
-			if (tx >= m_x)
+			if (tx >= tile.x1)
 				xr_ok = false;
 			else
 			{
@@ -92,7 +110,7 @@ float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool s
 		if (xl_ok)
 		{
 			int tx = xp - 1;
-			if (tx < 0)
+			if (tx < tile.x0)
 				xl_ok = false;
 			else
 			{
@@ -116,7 +134,7 @@ float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool s
 		if (yu_ok)
 		{
 			int ty = yp + y_size;
-			if (ty >= m_y)
+			if (ty >= tile.y1)
 				yu_ok = false;
 			else
 			{
@@ -137,7 +155,7 @@ float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool s
 		if (yd_ok)
 		{
 			int ty = yp - 1;
-			if (ty < 0)
+			if (ty < tile.y0)
 				yd_ok = false;
 			else
 			{
@@ -160,23 +178,23 @@ float cStock::FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool s
 	return z;
 }
 
-int cStock::TesselTop(int xp, int yp)
+int cStock::TesselTop(int xp, int yp, cStockTile & tile)
 {
 	int x_size, y_size;
-	float z = FindRectTop(xp, yp, x_size, y_size, true);
+	float z = FindRectTop(xp, yp, x_size, y_size, true, tile);
 	bool farRect = false;
 	while (y_size / x_size > 5)
 	{
 		farRect = true;
 		yp += x_size * 5;
-		z = FindRectTop(xp, yp, x_size, y_size, true);
+		z = FindRectTop(xp, yp, x_size, y_size, true, tile);
 	}
 
 	while (x_size / y_size > 5)
 	{
 		farRect = true;
 		xp += y_size * 5;
-		z = FindRectTop(xp, yp, x_size, y_size, false);
+		z = FindRectTop(xp, yp, x_size, y_size, false, tile);
 	}
 
 	// mark all points inside
@@ -192,9 +210,9 @@ int cStock::TesselTop(int xp, int yp)
 		Point3D ptl(xp, yp + y_size, z);
 		Point3D ptr(xp + x_size, yp + y_size, z);
 		if (fabs(m_pz + m_lz - z) < SIM_EPSILON)
-			AddQuad(pbl, pbr, ptr, ptl, facetsOuter);
+			AddQuad(pbl, pbr, ptr, ptl, tile.facetsOuter);
 		else
-			AddQuad(pbl, pbr, ptr, ptl, facetsInner);
+			AddQuad(pbl, pbr, ptr, ptl, tile.facetsInner);
 	}
 
 	if (farRect)
@@ -204,7 +222,7 @@ int cStock::TesselTop(int xp, int yp)
 }
 
 
-void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz)
+void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz, const cStockTile & tile)
 {
 	bool xr_ok = true;
 	bool xl_ok = scanHoriz;
@@ -217,7 +235,7 @@ void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool sc
 		if (xr_ok)
 		{
 			int tx = xp + x_size;
-			if (tx >= m_x)
+			if (tx >= tile.x1)
 				xr_ok = false;
 			else
 			{
@@ -238,7 +256,7 @@ void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool sc
 		if (xl_ok)
 		{
 			int tx = xp - 1;
-			if (tx < 0)
+			if (tx < tile.x0)
 				xl_ok = false;
 			else
 			{
@@ -262,7 +280,7 @@ void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool sc
 		if (yu_ok)
 		{
 			int ty = yp + y_size;
-			if (ty >= m_y)
+			if (ty >= tile.y1)
 				yu_ok = false;
 			else
 			{
@@ -283,7 +301,7 @@ void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool sc
 		if (yd_ok)
 		{
 			int ty = yp - 1;
-			if (ty < 0)
+			if (ty < tile.y0)
 				yd_ok = false;
 			else
 			{
@@ -306,23 +324,23 @@ void cStock::FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool sc
 }
 
 
-int cStock::TesselBot(int xp, int yp)
+int cStock::TesselBot(int xp, int yp, cStockTile & tile)
 {
 	int x_size, y_size;
-	FindRectBot(xp, yp, x_size, y_size, true);
+	FindRectBot(xp, yp, x_size, y_size, true, tile);
 	bool farRect = false;
 	while (y_size / x_size > 5)
 	{
 		farRect = true;
 		yp += x_size * 5;
-		FindRectTop(xp, yp, x_size, y_size, true);
+		FindRectTop(xp, yp, x_size, y_size, true, tile);
 	}
 
 	while (x_size / y_size > 5)
 	{
 		farRect = true;
 		xp += y_size * 5;
-		FindRectTop(xp, yp, x_size, y_size, false);
+		FindRectTop(xp, yp, x_size, y_size, false, tile);
 	}
 
 	// mark all points inside
@@ -335,7 +353,7 @@ int cStock::TesselBot(int xp, int yp)
 	Point3D pbr(xp + x_size, yp, m_pz);
 	Point3D ptl(xp, yp + y_size, m_pz);
 	Point3D ptr(xp + x_size, yp + y_size, m_pz);
-	AddQuad(pbl, ptl, ptr, pbr, facetsOuter);
+	AddQuad(pbl, ptl, ptr, pbr, tile.facetsOuter);
 
 	if (farRect)
 		return -1;
@@ -344,22 +362,22 @@ int cStock::TesselBot(int xp, int yp)
 }
 
 
-int cStock::TesselSidesX(int yp)
+int cStock::TesselSidesX(int yp, cStockTile & tile)
 {
 	float lastz1 = m_pz;
 	if (yp < m_y)
-		lastz1 = std::max(m_stock[0][yp], m_pz);
+		lastz1 = std::max(m_stock[tile.x0][yp], m_pz);
 	float lastz2 = m_pz;
 	if (yp > 0)
-		lastz2 = std::max(m_stock[0][yp - 1], m_pz);
+		lastz2 = std::max(m_stock[tile.x0][yp - 1], m_pz);
 
-	std::vector<MeshCore::MeshGeomFacet> *facets = &facetsInner;
+	std::vector<MeshCore::MeshGeomFacet> *facets = &tile.facetsInner;
 	if (yp == 0 || yp == m_y)
-		facets = &facetsOuter;
+		facets = &tile.facetsOuter;
 
 	//bool lastzclip = (lastz - m_pz) < m_res;
-	int lastpoint = 0;
-	for (int x = 1; x <= m_x; x++)
+	int lastpoint = tile.x0;
+	for (int x = tile.x0 + 1; x <= tile.x1; x++)
 	{
 		float newz1 = m_pz;
 		if (yp < m_y && x < m_x)
@@ -370,7 +388,8 @@ int cStock::TesselSidesX(int yp)
 
 		if (fabs(lastz1 - lastz2) > m_res)
 		{
-			if (fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res)
+			// the side always ends at the tile border
+			if (x < tile.x1 && fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res)
 				continue;
 			Point3D pbl(lastpoint, yp, lastz1);
 			Point3D pbr(x, yp, lastz1);
@@ -385,22 +404,22 @@ int cStock::TesselSidesX(int yp)
 	return 0;
 }
 
-int cStock::TesselSidesY(int xp)
+int cStock::TesselSidesY(int xp, cStockTile & tile)
 {
 	float lastz1 = m_pz;
 	if (xp < m_x)
-		lastz1 = std::max(m_stock[xp][0], m_pz);
+		lastz1 = std::max(m_stock[xp][tile.y0], m_pz);
 	float lastz2 = m_pz;
 	if (xp > 0)
-		lastz2 = std::max(m_stock[xp - 1][0], m_pz);
+		lastz2 = std::max(m_stock[xp - 1][tile.y0], m_pz);
 
-	std::vector<MeshCore::MeshGeomFacet> *facets = &facetsInner;
+	std::vector<MeshCore::MeshGeomFacet> *facets = &tile.facetsInner;
 	if (xp == 0 || xp == m_x)
-		facets = &facetsOuter;
+		facets = &tile.facetsOuter;
 
 	//bool lastzclip = (lastz - m_pz) < m_res;
-	int lastpoint = 0;
-	for (int y = 1; y <= m_y; y++)
+	int lastpoint = tile.y0;
+	for (int y = tile.y0 + 1; y <= tile.y1; y++)
 	{
 		float newz1 = m_pz;
 		if (xp < m_x && y < m_y)
@@ -411,7 +430,7 @@ int cStock::TesselSidesY(int xp)
 
 		if (fabs(lastz1 - lastz2) > m_res)
 		{
-			if (fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res)
+			if (y < tile.y1 && fabs(newz1 - lastz1) < m_res && fabs(newz2 - lastz2) < m_res)
 				continue;
 			Point3D pbr(xp, lastpoint, lastz1);
 			Point3D pbl(xp, y, lastz1);
@@ -449,43 +468,84 @@ void cStock::AddQuad(Point3D & p1, Point3D & p2, Point3D & p3, Point3D & p4, std
 	facets.push_back(facet);
 }
 
-void cStock::Tessellate(Mesh::MeshObject & meshOuter, Mesh::MeshObject & meshInner)
+void cStock::TessellateTile(cStockTile & tile)
 {
 	// reset attribs
-	for (int y = 0; y < m_y; y++)
-	for (int x = 0; x < m_x; x++)
+	for (int y = tile.y0; y < tile.y1; y++)
+	for (int x = tile.x0; x < tile.x1; x++)
 		m_attr[x][y] = 0;
 
-	facetsOuter.clear();
-	facetsInner.clear();
+	tile.facetsOuter.clear();
+	tile.facetsInner.clear();
 
-	for (int y = 0; y < m_y; y++)
+	for (int y = tile.y0; y < tile.y1; y++)
 	{
-		for (int x = 0; x < m_x; x++)
+		for (int x = tile.x0; x < tile.x1; x++)
 		{
 			int attr = m_attr[x][y];
 			if ((attr & SIM_TESSEL_TOP) == 0)
-				x += TesselTop(x, y);
+				x += TesselTop(x, y, tile);
 		}
 	}
-	for (int y = 0; y < m_y; y++)
+	for (int y = tile.y0; y < tile.y1; y++)
 	{
-		for (int x = 0; x < m_x; x++)
+		for (int x = tile.x0; x < tile.x1; x++)
 		{
 			if ((m_stock[x][y] - m_pz) < m_res)
 				m_attr[x][y] |= SIM_TESSEL_BOT;
 			if ((m_attr[x][y] & SIM_TESSEL_BOT) == 0)
-				x += TesselBot(x, y);
+				x += TesselBot(x, y, tile);
 		}
 	}
-	for (int y = 0; y <= m_y; y++)
-		TesselSidesX(y);
-	for (int x = 0; x <= m_x; x++)
-		TesselSidesY(x);
+
+	// a tile owns the sides along its lower borders, the last tiles also the outer ones
+	int ye = tile.y1 == m_y ? m_y : tile.y1 - 1;
+	int xe = tile.x1 == m_x ? m_x : tile.x1 - 1;
+	for (int y = tile.y0; y <= ye; y++)
+		TesselSidesX(y, tile);
+	for (int x = tile.x0; x <= xe; x++)
+		TesselSidesY(x, tile);
+}
+
+void cStock::Tessellate(Mesh::MeshObject & meshOuter, Mesh::MeshObject & meshInner)
+{
+	// the sides along the lower borders of a tile depend on the cells of the
+	// neighbour tiles, so these have to be tessellated again, too
+	std::vector<int> changed;
+	for (int tx = 0; tx < m_tx; tx++)
+		for (int ty = 0; ty < m_ty; ty++)
+		{
+			int index = tx * m_ty + ty;
+			if (m_tiles[index].dirty ||
+				(tx > 0 && m_tiles[index - m_ty].dirty) ||
+				(ty > 0 && m_tiles[index - 1].dirty))
+				changed.push_back(index);
+		}
+
+	// every tile only touches its own cells of the attribute array
+	Part::Tools::parallelFor(changed.size(), [&](std::size_t i) {
+		TessellateTile(m_tiles[changed[i]]);
+	});
+
+	std::size_t numOuter = 0, numInner = 0;
+	for (cStockTile &tile : m_tiles)
+	{
+		tile.dirty = false;
+		numOuter += tile.facetsOuter.size();
+		numInner += tile.facetsInner.size();
+	}
+
+	std::vector<MeshCore::MeshGeomFacet> facetsOuter;
+	std::vector<MeshCore::MeshGeomFacet> facetsInner;
+	facetsOuter.reserve(numOuter);
+	facetsInner.reserve(numInner);
+	for (const cStockTile &tile : m_tiles)
+	{
+		facetsOuter.insert(facetsOuter.end(), tile.facetsOuter.begin(), tile.facetsOuter.end());
+		facetsInner.insert(facetsInner.end(), tile.facetsInner.begin(), tile.facetsInner.end());
+	}
 	meshOuter.addFacets(facetsOuter);
 	meshInner.addFacets(facetsInner);
-	facetsOuter.clear();
-	facetsInner.clear();
 }
 
 
@@ -504,13 +564,15 @@ void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
 		for (int x = xs; x < xe; x++)
 		{
 			if (((x - cx)*(x - cx) + (y - cy) * (y - cy)) < drad)
-				if (m_stock[x][y] > height) m_stock[x][y] = height;
+				CutAt(x, y, height, 0, m_x);
 		}
 	}
 }
 
-void cStock::ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool & tool)
+void cStock::ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool & tool, int xmin, int xmax)
 {
+	xmax = std::min(xmax, m_x);
+
 	// translate coordinates
 	Point3D pi1 = ToInner(p1);
 	Point3D pi2 = ToInner(p2);
@@ -542,11 +604,7 @@ void cStock::ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool & tool)
 			{
 				int x = (int)p.x;
 				int y = (int)p.y;
-				if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-				{
-					if (m_stock[x][y] > z)
-						m_stock[x][y] = z;
-				}
+				CutAt(x, y, z, xmin, xmax);
 				p.Add(mainWay);
 				z += zstep;
 			}
@@ -568,18 +626,16 @@ void cStock::ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool & tool)
 		{
 			int x = (int)(pi2.x + cupCirc.x);
 			int y = (int)(pi2.y + cupCirc.y);
-			if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-			{
-				if (m_stock[x][y] > z)
-					m_stock[x][y] = z;
-			}
+			CutAt(x, y, z, xmin, xmax);
 			cupCirc.Rotate();
 		}
 	}
 }
 
-void cStock::ApplyCircularTool(Point3D & p1, Point3D & p2, Point3D & cent, cSimTool & tool, bool isCCW)
+void cStock::ApplyCircularTool(Point3D & p1, Point3D & p2, Point3D & cent, cSimTool & tool, bool isCCW, int xmin, int xmax)
 {
+	xmax = std::min(xmax, m_x);
+
 	// translate coordinates
 	Point3D pi1 = ToInner(p1);
 	Point3D pi2 = ToInner(p2);
@@ -629,11 +685,7 @@ void cStock::ApplyCircularTool(Point3D & p1, Point3D & p2, Point3D & cent, cSimT
 		{
 			int x = (int)(cpx + cupCirc.x);
 			int y = (int)(cpy + cupCirc.y);
-			if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-			{
-				if (m_stock[x][y] > z)
-					m_stock[x][y] = z;
-			}
+			CutAt(x, y, z, xmin, xmax);
 			z += zstep;
 			cupCirc.Rotate();
 		}
@@ -656,16 +708,58 @@ void cStock::ApplyCircularTool(Point3D & p1, Point3D & p2, Point3D & cent, cSimT
 		{
 			int x = (int)(pi2.x + cupCirc.x);
 			int y = (int)(pi2.y + cupCirc.y);
-			if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-			{
-				if (m_stock[x][y] > z)
-					m_stock[x][y] = z;
-			}
+			CutAt(x, y, z, xmin, xmax);
 			cupCirc.Rotate();
 		}
 	}
 }
 
+void cStock::ApplyMoves(std::vector<cSimMove> & moves, cSimTool & tool)
+{
+	if (moves.empty())
+		return;
+
+	// x extent of every move in stock cells to skip the moves outside of a band
+	float rad = tool.radius / m_res + 1;
+	std::vector<std::pair<float, float> > extents;
+	extents.reserve(moves.size());
+	for (cSimMove &move : moves)
+	{
+		Point3D pi1 = ToInner(move.p1);
+		Point3D pi2 = ToInner(move.p2);
+		if (move.type == cSimMove::Linear)
+		{
+			extents.emplace_back(std::min(pi1.x, pi2.x) - rad, std::max(pi1.x, pi2.x) + rad);
+		}
+		else
+		{
+			// the end cup is centered at the end point even if it is off the arc
+			float cx = pi1.x + move.cent.x / m_res;
+			float crad = sqrt(move.cent.x * move.cent.x + move.cent.y * move.cent.y) / m_res;
+			extents.emplace_back(std::min(cx - crad, pi2.x) - rad, std::max(cx + crad, pi2.x) + rad);
+		}
+	}
+
+	// every band covers whole tile columns, so no two threads write to the same cell or tile
+	int numBands = std::min(m_tx, (int)std::max(1u, std::thread::hardware_concurrency()) * 4);
+	int bandTiles = (m_tx + numBands - 1) / numBands;
+	numBands = (m_tx + bandTiles - 1) / bandTiles;
+	Part::Tools::parallelFor(numBands, [&](std::size_t band) {
+		int xmin = (int)band * bandTiles * SIM_TILE_SIZE;
+		int xmax = std::min(m_x, xmin + bandTiles * SIM_TILE_SIZE);
+		for (std::size_t i = 0; i < moves.size(); i++)
+		{
+			if (extents[i].second < xmin || extents[i].first > xmax)
+				continue;
+			cSimMove &move = moves[i];
+			if (move.type == cSimMove::Linear)
+				ApplyLinearTool(move.p1, move.p2, tool, xmin, xmax);
+			else
+				ApplyCircularTool(move.p1, move.p2, move.cent, tool, move.type == cSimMove::ArcCCW, xmin, xmax);
+		}
+	});
+}
+
 
 //************************************************************************************************************
 // Line Segment
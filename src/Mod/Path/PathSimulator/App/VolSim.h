@@ -26,6 +26,7 @@
 #ifndef PATHSIMULATOR_VolSim_H
 #define PATHSIMULATOR_VolSim_H
 
+#include <climits>
 #include <vector>
 #include <Mod/Mesh/App/Mesh.h>
 #include <Mod/Path/App/Command.h>
@@ -34,6 +35,7 @@
 #define SIM_TESSEL_TOP		1
 #define SIM_TESSEL_BOT		2
 #define SIM_WALK_RES		0.6   // step size in pixel units (to make sure all pixels in the path are visited)
+#define SIM_TILE_SIZE		64    // size of the stock tiles in pixel units
 
 struct toolShapePoint {
   float radiusPos;
@@ -62,6 +64,15 @@ struct Point3D
 	float sina, cosa;
 };
 
+struct cSimMove
+{
+	enum Type { Linear, ArcCW, ArcCCW };
+	cSimMove(Type type, Point3D & p1, Point3D & p2) : type(type), p1(p1), p2(p2) {}
+	cSimMove(Type type, Point3D & p1, Point3D & p2, Point3D & cent) : type(type), p1(p1), p2(p2), cent(cent) {}
+	Type type;
+	Point3D p1, p2, cent;
+};
+
 // some vector manipulations
 inline static Point3D operator + (const Point3D & a, const Point3D & b) { return Point3D(a.x + b.x, a.y + b.y, a.z + b.z); }
 inline static Point3D operator - (const Point3D & a, const Point3D & b) { return Point3D(a.x - b.x, a.y - b.y, a.z - b.z); }
@@ -130,12 +141,25 @@ public:
 	}
 
 	T *operator [] (int i) { return data + i * height; }
+	const T *operator [] (int i) const { return data + i * height; }
 
 private:
 	T *data;
 	int height;
 };
 
+/** A rectangular part of the stock that is tessellated on its own.
+ * Only the tiles that were cut since the last tessellation are tessellated
+ * again, the others keep their facets.
+ */
+struct cStockTile
+{
+	int x0, y0, x1, y1;		// covered cells, x1 and y1 exclusive
+	bool dirty;
+	std::vector<MeshCore::MeshGeomFacet> facetsOuter;
+	std::vector<MeshCore::MeshGeomFacet> facetsInner;
+};
+
 class cStock
 {
 public:
@@ -143,21 +167,31 @@ public:
 	~cStock();
 	void Tessellate(Mesh::MeshObject & meshOuter, Mesh::MeshObject & meshInner);
     void CreatePocket(float x, float y, float rad, float height);
-    void ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool &tool);
-    void ApplyCircularTool(Point3D & p1, Point3D & p2, Point3D & cent, cSimTool &tool, bool isCCW);
+    // xmin and xmax restrict the cut to a band of stock columns
+    void ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool &tool, int xmin = 0, int xmax = INT_MAX);
+    void ApplyCircularTool(Point3D & p1, Point3D & p2, Point3D & cent, cSimTool &tool, bool isCCW, int xmin = 0, int xmax = INT_MAX);
+    // apply a sequence of moves in parallel on bands of tile columns
+    void ApplyMoves(std::vector<cSimMove> & moves, cSimTool &tool);
     inline Point3D ToInner(Point3D & p) {
 		return Point3D((p.x - m_px) / m_res, (p.y - m_py) / m_res, p.z);
 	}
 
 private:
-	float FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz);
-	void FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz);
+	inline void CutAt(int x, int y, float z, int xmin, int xmax) {
+		if (x >= xmin && y >= 0 && x < xmax && y < m_y && m_stock[x][y] > z) {
+			m_stock[x][y] = z;
+			m_tiles[(x / SIM_TILE_SIZE) * m_ty + y / SIM_TILE_SIZE].dirty = true;
+		}
+	}
+	float FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz, const cStockTile & tile);
+	void FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz, const cStockTile & tile);
 	void SetFacetPoints(MeshCore::MeshGeomFacet & facet, Point3D & p1, Point3D & p2, Point3D & p3);
 	void AddQuad(Point3D & p1, Point3D & p2, Point3D & p3, Point3D & p4, std::vector<MeshCore::MeshGeomFacet> & facets);
-	int TesselTop(int x, int y);
-	int TesselBot(int x, int y);
-	int TesselSidesX(int yp);
-	int TesselSidesY(int xp);
+	void TessellateTile(cStockTile & tile);
+	int TesselTop(int x, int y, cStockTile & tile);
+	int TesselBot(int x, int y, cStockTile & tile);
+	int TesselSidesX(int yp, cStockTile & tile);
+	int TesselSidesY(int xp, cStockTile & tile);
 	Array2D<float>  m_stock;
 	Array2D<char> m_attr;
 	float m_px, m_py, m_pz;  // stock zero position
@@ -165,8 +199,8 @@ private:
 	float m_res;        // resoulution
 	float m_plane;		// stock plane height
 	int m_x, m_y;            // stock array size
-	std::vector<MeshCore::MeshGeomFacet> facetsOuter;
-	std::vector<MeshCore::MeshGeomFacet> facetsInner;
+	int m_tx, m_ty;          // number of tiles
+	std::vector<cStockTile> m_tiles;
 };
 
 class cVolSim
@@ -26,6 +26,7 @@
 #include <cstring>
 #include <ctime>
 #include <algorithm>
+#include <future>
 
 namespace ClipperLib
 {
@@ -1697,6 +1698,8 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 	progressCallback = &progressCallbackFn;
 	lastProgressTime = clock();
 	stopProcessing = false;
+	executeThread = std::this_thread::get_id();
+	pendingProgress.clear();
 
 	if(helixRampDiameter<NTOL)
 		helixRampDiameter=0.75*toolDiameter;
@@ -1778,6 +1781,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 	//	Resolve hierarchy and run processing
 	//***************************************
 	double cornerRoundingOffset = 0.15 * toolRadiusScaled / 2;
+	std::vector<std::pair<Paths, Paths>> regions; // bound paths and tool bound paths of the separate regions
 	if (opType == OperationType::otClearingInside || opType == OperationType::otClearingOutside)
 	{
 
@@ -1830,7 +1834,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 				clipof.Clear();
 				clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
 				clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
-				ProcessPolyNode(boundPaths, toolBoundPaths);
+				regions.emplace_back(boundPaths, toolBoundPaths);
 			}
 		}
 	}
@@ -1889,14 +1893,76 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths &stockPaths, const DP
 					clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
 					clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
 
-					ProcessPolyNode(boundPaths, toolBoundPaths);
+					regions.emplace_back(boundPaths, toolBoundPaths);
 				}
 			}
 		}
 	}
+	ProcessRegions(regions);
 	return results;
 }
 
+void Adaptive2d::ProcessRegions(const std::vector<std::pair<Paths, Paths>> &regions)
+{
+	size_t threadCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), regions.size());
+#ifdef DEV_MODE
+	threadCount = 1; // perf counters and debug drawing are not thread safe
+#endif
+	if (threadCount < 2)
+	{
+		for (const auto &region : regions)
+			ProcessPolyNode(region.first, region.second, results);
+		return;
+	}
+
+	// the regions are independent, the results are merged in the order of the regions
+	std::vector<std::list<AdaptiveOutput>> regionResults(regions.size());
+	std::atomic<size_t> next(0);
+	auto worker = [&]() {
+		for (size_t i = next++; i < regions.size(); i = next++)
+			ProcessPolyNode(regions[i].first, regions[i].second, regionResults[i]);
+	};
+	std::vector<std::future<void>> workers;
+	for (size_t i = 0; i < threadCount; i++)
+		workers.push_back(std::async(std::launch::async, worker));
+
+	// report the progress of the workers from this thread while waiting for them
+	std::exception_ptr error;
+	for (auto &w : workers)
+	{
+		while (w.wait_for(std::chrono::milliseconds(1000 * PROGRESS_TICKS / CLOCKS_PER_SEC)) != std::future_status::ready)
+			ReportPendingProgress();
+		try
+		{
+			w.get();
+		}
+		catch (...)
+		{
+			if (!error)
+				error = std::current_exception();
+			stopProcessing = true;
+			next = regions.size();
+		}
+	}
+	ReportPendingProgress();
+	if (error)
+		std::rethrow_exception(error);
+
+	for (auto &regionResult : regionResults)
+		results.splice(results.end(), regionResult);
+}
+
+void Adaptive2d::ReportPendingProgress()
+{
+	TPaths progress;
+	{
+		std::lock_guard<std::mutex> lock(progressMutex);
+		progress.swap(pendingProgress);
+	}
+	if (progress.size() > 0 && progressCallback && (*progressCallback)(progress))
+		stopProcessing = true;
+}
+
 bool Adaptive2d::FindEntryPoint(TPaths &progressPaths, const Paths &toolBoundPaths, const Paths &boundPaths,
 								ClearedArea &clearedArea /*output-initial cleared area by helix*/,
 								IntPoint &entryPoint /*output*/,
@@ -2551,12 +2617,21 @@ void Adaptive2d::AppendToolPath(TPaths &progressPaths, AdaptiveOutput &output,
 
 void Adaptive2d::CheckReportProgress(TPaths &progressPaths, bool force)
 {
-	if (!force && (clock() - lastProgressTime < PROGRESS_TICKS))
+	bool worker = std::this_thread::get_id() != executeThread;
+	thread_local clock_t lastWorkerProgressTime = 0;
+	clock_t &lastTime = worker ? lastWorkerProgressTime : lastProgressTime;
+	if (!force && (clock() - lastTime < PROGRESS_TICKS))
 		return; // not yet
-	lastProgressTime = clock();
+	lastTime = clock();
 	if (progressPaths.size() == 0)
 		return;
-	if (progressCallback)
+	if (worker)
+	{
+		// reported by the thread running Execute
+		std::lock_guard<std::mutex> lock(progressMutex);
+		pendingProgress.insert(pendingProgress.end(), progressPaths.begin(), progressPaths.end());
+	}
+	else if (progressCallback)
 		if ((*progressCallback)(progressPaths))
 			stopProcessing = true; // call python function, if returns true signal stop processing
 	// clean the paths - keep the last point
@@ -2599,11 +2674,11 @@ void Adaptive2d::AddPathToProgress(TPaths &progressPaths, const Path pth, Motion
 	}
 }
 
-void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
+void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths, std::list<AdaptiveOutput> &regionResults)
 {
 	Perf_ProcessPolyNode.Start();
-	current_region++;
-	cout << "** Processing region: " << current_region << endl;
+	int region = ++current_region;
+	cout << "** Processing region: " << region << endl;
 
 	// node paths are already constrained to tool boundary path for adaptive path before finishing pass
 	Clipper clip;
@@ -3131,7 +3206,7 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 				<< "Hint: try to modify accuracy and/or step-over." << endl;
 		}
 	}
-	results.push_back(output);
+	regionResults.push_back(output);
 }
 
 } // namespace AdaptivePath
@@ -23,6 +23,10 @@
 #include "clipper.hpp"
 #include <vector>
 #include <list>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
 #include <time.h>
 
 #ifndef ADAPTIVE_HPP
@@ -118,14 +122,22 @@ class Adaptive2d
 	long helixRampRadiusScaled = 0;
 	double referenceCutArea = 0;
 	double optimalCutAreaPD = 0;
-	bool stopProcessing = false;
-	int current_region=0;
+	std::atomic<bool> stopProcessing{false};
+	std::atomic<int> current_region{0};
 	clock_t lastProgressTime = 0;
 
 	std::function<bool(TPaths)> *progressCallback = NULL;
 	Path toolGeometry; // tool geometry at coord 0,0, should not be modified
 
-	void ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths);
+	// regions are processed by worker threads, the progress callback (python) is
+	// only called from the thread running Execute, workers queue their progress
+	std::thread::id executeThread;
+	std::mutex progressMutex;
+	TPaths pendingProgress;
+
+	void ProcessRegions(const std::vector<std::pair<Paths, Paths>> &regions);
+	void ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths, std::list<AdaptiveOutput> &regionResults);
+	void ReportPendingProgress();
 	bool FindEntryPoint(TPaths &progressPaths, const Paths &toolBoundPaths, const Paths &bound, ClearedArea &cleared /*output*/,
 						IntPoint &entryPoint /*output*/, IntPoint &toolPos, DoublePoint &toolDir);
 	bool FindEntryPointOutside(TPaths &progressPaths, const Paths &toolBoundPaths, const Paths &bound, ClearedArea &cleared /*output*/,
@@ -42,7 +42,7 @@ public:
 	Point(const double* p):x(p[0]), y(p[1]){}
 	Point(const Point& p0, const Point& p1):x(p1.x - p0.x), y(p1.y - p0.y){} // vector from p0 to p1
 
-	static double tolerance;
+	static thread_local double tolerance;
 
 	const Point operator+(const Point& p)const{return Point(x + p.x, y + p.y);}
 	const Point operator-(const Point& p)const{return Point(x - p.x, y - p.y);}
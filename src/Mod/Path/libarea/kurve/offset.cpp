@@ -281,7 +281,7 @@ namespace geoff_geometry {
 }
 
 
-static struct iso {
+static thread_local struct iso {
 		 Span sp;
 		 Span off;
 	} isodata;
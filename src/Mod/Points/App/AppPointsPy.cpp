@@ -52,9 +52,15 @@ class Module : public Py::ExtensionModule<Module>
 public:
     Module() : Py::ExtensionModule<Module>("Points")
     {
-        add_varargs_method("open",&Module::open
+        add_varargs_method("open",&Module::open,
+            "open(string,[stride,cellSize]) -- Open a point cloud in a new document.\n"
+            "Only every stride-th point is read and of these only one per cube of the size cellSize\n"
+            "is kept. Subsampling is supported for LAS files."
         );
-        add_varargs_method("insert",&Module::importer
+        add_varargs_method("insert",&Module::importer,
+            "insert(string,string,[stride,cellSize]) -- Insert a point cloud into a document.\n"
+            "Only every stride-th point is read and of these only one per cube of the size cellSize\n"
+            "is kept. Subsampling is supported for LAS files."
         );
         add_varargs_method("export",&Module::exporter
         );
@@ -70,7 +76,9 @@ private:
     Py::Object open(const Py::Tuple& args)
     {
         char* Name;
-        if (!PyArg_ParseTuple(args.ptr(), "et","utf-8",&Name))
+        unsigned int stride = 1;
+        double cellSize = 0.0;
+        if (!PyArg_ParseTuple(args.ptr(), "et|Id","utf-8",&Name,&stride,&cellSize))
             throw Py::Exception();
         std::string EncodedName = std::string(Name);
         PyMem_Free(Name);
@@ -93,10 +101,14 @@ private:
             else if (file.hasExtension("pcd")) {
                 reader.reset(new PcdReader);
             }
+            else if (file.hasExtension("las") || file.hasExtension("laz")) {
+                reader.reset(new LasReader);
+            }
             else {
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
+            reader->setSubsampling(stride, cellSize);
             reader->read(EncodedName);
 
             App::Document *pcDoc = App::GetApplication().newDocument("Unnamed");
@@ -122,13 +134,13 @@ private:
                     pcFeature = new Points::FeatureCustom();
                 }
 
-                pcFeature->Points.setValue(reader->getPoints());
+                pcFeature->Points.swapPoints(reader->getPoints());
                 // add gray values
                 if (reader->hasIntensities()) {
                     Points::PropertyGreyValueList* prop = static_cast<Points::PropertyGreyValueList*>
                         (pcFeature->addDynamicProperty("Points::PropertyGreyValueList", "Intensity"));
                     if (prop) {
-                        prop->setValues(reader->getIntensities());
+                        prop->setValues(std::move(reader->getIntensities()));
                     }
                 }
                 // add colors
@@ -136,7 +148,7 @@ private:
                     App::PropertyColorList* prop = static_cast<App::PropertyColorList*>
                         (pcFeature->addDynamicProperty("App::PropertyColorList", "Color"));
                     if (prop) {
-                        prop->setValues(reader->getColors());
+                        prop->setValues(std::move(reader->getColors()));
                     }
                 }
                 // add normals
@@ -144,7 +156,7 @@ private:
                     Points::PropertyNormalList* prop = static_cast<Points::PropertyNormalList*>
                         (pcFeature->addDynamicProperty("Points::PropertyNormalList", "Normal"));
                     if (prop) {
-                        prop->setValues(reader->getNormals());
+                        prop->setValues(std::move(reader->getNormals()));
                     }
                 }
 
@@ -165,7 +177,7 @@ private:
                 }
 
                 // delayed adding of the points feature
-                pcFeature->Points.setValue(reader->getPoints());
+                pcFeature->Points.swapPoints(reader->getPoints());
                 pcDoc->addObject(pcFeature, file.fileNamePure().c_str());
                 pcDoc->recomputeFeature(pcFeature);
                 pcFeature->purgeTouched();
@@ -182,7 +194,9 @@ private:
     {
         char* Name;
         const char* DocName;
-        if (!PyArg_ParseTuple(args.ptr(), "ets","utf-8",&Name,&DocName))
+        unsigned int stride = 1;
+        double cellSize = 0.0;
+        if (!PyArg_ParseTuple(args.ptr(), "ets|Id","utf-8",&Name,&DocName,&stride,&cellSize))
             throw Py::Exception();
         std::string EncodedName = std::string(Name);
         PyMem_Free(Name);
@@ -205,10 +219,14 @@ private:
             else if (file.hasExtension("pcd")) {
                 reader.reset(new PcdReader);
             }
+            else if (file.hasExtension("las") || file.hasExtension("laz")) {
+                reader.reset(new LasReader);
+            }
             else {
                 throw Py::RuntimeError("Unsupported file extension");
             }
 
+            reader->setSubsampling(stride, cellSize);
             reader->read(EncodedName);
 
             App::Document *pcDoc = App::GetApplication().getDocument(DocName);
@@ -237,13 +255,13 @@ private:
                     pcFeature = new Points::FeatureCustom();
                 }
 
-                pcFeature->Points.setValue(reader->getPoints());
+                pcFeature->Points.swapPoints(reader->getPoints());
                 // add gray values
                 if (reader->hasIntensities()) {
                     Points::PropertyGreyValueList* prop = static_cast<Points::PropertyGreyValueList*>
                         (pcFeature->addDynamicProperty("Points::PropertyGreyValueList", "Intensity"));
                     if (prop) {
-                        prop->setValues(reader->getIntensities());
+                        prop->setValues(std::move(reader->getIntensities()));
                     }
                 }
                 // add colors
@@ -251,7 +269,7 @@ private:
                     App::PropertyColorList* prop = static_cast<App::PropertyColorList*>
                         (pcFeature->addDynamicProperty("App::PropertyColorList", "Color"));
                     if (prop) {
-                        prop->setValues(reader->getColors());
+                        prop->setValues(std::move(reader->getColors()));
                     }
                 }
                 // add normals
@@ -259,7 +277,7 @@ private:
                     Points::PropertyNormalList* prop = static_cast<Points::PropertyNormalList*>
                         (pcFeature->addDynamicProperty("Points::PropertyNormalList", "Normal"));
                     if (prop) {
-                        prop->setValues(reader->getNormals());
+                        prop->setValues(std::move(reader->getNormals()));
                     }
                 }
 
@@ -271,7 +289,7 @@ private:
             else {
                 Points::Feature *pcFeature = static_cast<Points::Feature*>
                     (pcDoc->addObject("Points::Feature", file.fileNamePure().c_str()));
-                pcFeature->Points.setValue(reader->getPoints());
+                pcFeature->Points.swapPoints(reader->getPoints());
                 pcDoc->recomputeFeature(pcFeature);
                 pcFeature->purgeTouched();
             }
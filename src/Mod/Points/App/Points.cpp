@@ -23,6 +23,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 # include <cmath>
 # include <iostream>
 #endif
@@ -85,18 +86,19 @@ Data::Segment* PointKernel::getSubElement(const char* /*Type*/, unsigned long /*
 void PointKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     std::vector<value_type>& kernel = getBasicPoints();
-#ifdef _WIN32
-    // Win32-only at the moment since ppl.h is a Microsoft library. Points is not using Qt so we cannot use QtConcurrent
-    // We could also rewrite Points to leverage SIMD instructions
-    // Other option: openMP. But with VC2013 results in high CPU usage even after computation (busy-waits for >100ms)
-    Concurrency::parallel_for_each(kernel.begin(), kernel.end(), [rclMat](value_type& value) {
-        value = rclMat * value;
-    });
-#else
-    QtConcurrent::blockingMap(kernel, [rclMat](value_type& value) {
-        rclMat.multVec(value, value);
+
+    // Transform blocks of points in the worker threads. Mapping every single
+    // point costs more for the scheduling than for the transformation.
+    const std::size_t blockSize = 65536;
+    std::vector<std::size_t> blocks;
+    for (std::size_t index = 0; index < kernel.size(); index += blockSize)
+        blocks.push_back(index);
+
+    value_type* points = kernel.data();
+    std::size_t count = kernel.size();
+    QtConcurrent::blockingMap(blocks, [rclMat, points, count, blockSize](std::size_t index) {
+        rclMat.transformPoints(points + index, std::min(blockSize, count - index));
     });
-#endif
 }
 
 Base::BoundBox3d PointKernel::getBoundBox(void)const
@@ -244,6 +246,38 @@ void PointKernel::getPoints(std::vector<Base::Vector3d> &Points,
     }
 }
 
+namespace {
+
+template <typename T>
+void fillBuffer(const std::vector<PointKernel::value_type>& points, const Base::Matrix4D& mtrx,
+                Data::ComplexGeoData::GeometryBuffer<T> &buffer)
+{
+    buffer.points.resize(points.size() * 3);
+    T* ptr = buffer.points.data();
+    for (std::vector<PointKernel::value_type>::const_iterator it = points.begin(); it != points.end(); ++it) {
+        Base::Vector3d pnt = mtrx * Base::Vector3d(it->x, it->y, it->z);
+        *ptr++ = static_cast<T>(pnt.x);
+        *ptr++ = static_cast<T>(pnt.y);
+        *ptr++ = static_cast<T>(pnt.z);
+    }
+    buffer.normals.clear();
+    buffer.facets.clear();
+}
+
+}
+
+void PointKernel::getPointBuffer(GeometryBuffer<float> &buffer,
+                                 float /*Accuracy*/, bool /*withNormals*/, uint16_t /*flags*/) const
+{
+    fillBuffer(_Points, _Mtrx, buffer);
+}
+
+void PointKernel::getPointBuffer(GeometryBuffer<double> &buffer,
+                                 float /*Accuracy*/, bool /*withNormals*/, uint16_t /*flags*/) const
+{
+    fillBuffer(_Points, _Mtrx, buffer);
+}
+
 // ----------------------------------------------------------------------------
 
 PointKernel::const_point_iterator::const_point_iterator
@@ -87,10 +87,16 @@ public:
     { this->_Points = pts; }
     void swap(std::vector<value_type>& pts)
     { this->_Points.swap(pts); }
+    void swap(PointKernel& kernel)
+    { this->_Points.swap(kernel._Points); std::swap(this->_Mtrx, kernel._Mtrx); }
 
     virtual void getPoints(std::vector<Base::Vector3d> &Points,
         std::vector<Base::Vector3d> &Normals,
         float Accuracy, uint16_t flags=0) const;
+    virtual void getPointBuffer(GeometryBuffer<float> &buffer,
+        float Accuracy, bool withNormals=false, uint16_t flags=0) const;
+    virtual void getPointBuffer(GeometryBuffer<double> &buffer,
+        float Accuracy, bool withNormals=false, uint16_t flags=0) const;
     virtual void transformGeometry(const Base::Matrix4D &rclMat);
     virtual Base::BoundBox3d getBoundBox(void)const;
 
@@ -26,9 +26,20 @@
 #ifdef FC_OS_LINUX
 # include <unistd.h>
 #endif
+# include <cstdlib>
+# include <cstring>
 # include <sstream>
+# include <unordered_set>
 #endif
 
+#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+# include <charconv>
+#endif
+
+#include <QFile>
+#include <QThread>
+#include <QtConcurrentMap>
+
 
 #include "PointsAlgos.h"
 #include "Points.h"
@@ -36,18 +47,264 @@
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/Matrix.h>
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
 
 #include <boost/shared_ptr.hpp>
-#include <boost/regex.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 
 using namespace Points;
 
+namespace Points {
+/**
+ * The AsciiData class maps the text part of a point cloud file into memory and parses it in
+ * the worker threads. The text is split into blocks of complete lines. In a first pass the
+ * data lines of every block are counted so that each block knows the index of its first row
+ * and in a second pass the rows are parsed and handed to a function that writes them to
+ * their final place.
+ */
+class AsciiData
+{
+public:
+    typedef std::vector<std::size_t> IndexList;
+
+    AsciiData(const std::string& filename, std::size_t offset)
+      : file(QString::fromUtf8(filename.c_str())), begin(nullptr), end(nullptr)
+    {
+        if (!file.open(QIODevice::ReadOnly))
+            throw Base::FileException("File to load not existing or not readable", filename.c_str());
+
+        qint64 size = file.size() - static_cast<qint64>(offset);
+        if (size <= 0)
+            return;
+
+        uchar* data = file.map(static_cast<qint64>(offset), size);
+        if (data) {
+            begin = reinterpret_cast<const char*>(data);
+        }
+        else {
+            // the file cannot be mapped, so read it at once
+            buffer.resize(static_cast<std::size_t>(size));
+            file.seek(static_cast<qint64>(offset));
+            if (file.read(&buffer[0], size) != size)
+                throw Base::FileException("Failed to read file", filename.c_str());
+            begin = buffer.data();
+        }
+        end = begin + size;
+    }
+
+    /// Skips \a count lines that are not empty
+    void skipLines(std::size_t count)
+    {
+        while (count > 0 && begin < end) {
+            const char* next = nextLine(begin, end);
+            if (!isEmptyLine(begin, next))
+                count--;
+            begin = next;
+        }
+    }
+
+    /// Splits the data into blocks and returns the number of data lines
+    std::size_t countRows()
+    {
+        const std::size_t blockSize = 4 * 1024 * 1024;
+        blocks.clear();
+        for (const char* pos = begin; pos < end; ) {
+            const char* last = pos + std::min<std::size_t>(blockSize, end - pos);
+            // the block ends after a complete line
+            if (last < end)
+                last = nextLine(last, end);
+            Block block;
+            block.begin = pos;
+            block.end = last;
+            block.first = 0;
+            block.rows = 0;
+            blocks.push_back(block);
+            pos = last;
+        }
+
+        QtConcurrent::blockingMap(blocks, [](Block& block) {
+            for (const char* pos = block.begin; pos < block.end; ) {
+                const char* next = nextLine(pos, block.end);
+                if (isDataLine(pos, next))
+                    block.rows++;
+                pos = next;
+            }
+        });
+
+        std::size_t rows = 0;
+        for (std::vector<Block>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+            it->first = rows;
+            rows += it->rows;
+        }
+        return rows;
+    }
+
+    /**
+     * Parses the first \a numFields values of every data line and passes them to \a func
+     * together with the number of values found and whether the line contains nothing else.
+     * Lines behind \a maxRows are ignored. \a func is called from several threads with
+     * different rows and must return false if it rejects the row. The rejected rows are
+     * returned in ascending order.
+     * @note countRows() must be called before.
+     */
+    template <typename Func>
+    IndexList parse(const char* text, std::size_t numFields, std::size_t maxRows, Func func)
+    {
+        std::vector<IndexList> rejected(blocks.size());
+        std::vector<std::size_t> indices(blocks.size());
+        for (std::size_t i = 0; i < indices.size(); i++)
+            indices[i] = i;
+
+        Base::ParallelSequencerLauncher seq(text, blocks.size());
+        QFuture<void> future = QtConcurrent::map(indices, [&](std::size_t index) {
+            const Block& block = blocks[index];
+            std::vector<double> values(numFields);
+            std::size_t row = block.first;
+            for (const char* pos = block.begin; pos < block.end && row < maxRows; ) {
+                const char* next = nextLine(pos, block.end);
+                if (isDataLine(pos, next)) {
+                    std::fill(values.begin(), values.end(), 0.0);
+                    bool complete = false;
+                    std::size_t count = parseLine(pos, next, values, complete);
+                    if (!func(row, values.data(), count, complete))
+                        rejected[index].push_back(row);
+                    row++;
+                }
+                pos = next;
+            }
+            seq.next();
+        });
+
+        while (!future.isFinished()) {
+            seq.update(false);
+            QThread::msleep(20);
+        }
+        seq.update(false);
+
+        IndexList result;
+        for (std::vector<IndexList>::iterator it = rejected.begin(); it != rejected.end(); ++it)
+            result.insert(result.end(), it->begin(), it->end());
+        return result;
+    }
+
+private:
+    static const char* nextLine(const char* pos, const char* last)
+    {
+        const char* next = static_cast<const char*>(std::memchr(pos, '\n', last - pos));
+        return next ? next + 1 : last;
+    }
+
+    static bool isBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    static bool isEmptyLine(const char* pos, const char* last)
+    {
+        while (pos < last && isBlank(*pos))
+            ++pos;
+        return pos == last;
+    }
+
+    /// A data line starts with a number, anything else like a comment is skipped
+    static bool isDataLine(const char* pos, const char* last)
+    {
+        while (pos < last && isBlank(*pos))
+            ++pos;
+        if (pos == last)
+            return false;
+        char c = *pos;
+        return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
+    }
+
+    static bool parseValue(const char*& pos, const char* last, double& value)
+    {
+#if defined(__cpp_lib_to_chars)
+        // from_chars doesn't accept a leading plus sign
+        if (*pos == '+')
+            ++pos;
+        std::from_chars_result result = std::from_chars(pos, last, value);
+        if (result.ec != std::errc())
+            return false;
+        pos = result.ptr;
+        return true;
+#else
+        // the mapped data is not null-terminated, so copy the token
+        char token[64];
+        std::size_t length = 0;
+        while (pos + length < last && length < sizeof(token) - 1 && !isBlank(pos[length]))
+            length++;
+        std::memcpy(token, pos, length);
+        token[length] = '\0';
+        char* next = nullptr;
+        value = std::strtod(token, &next);
+        if (next == token)
+            return false;
+        pos += next - token;
+        return true;
+#endif
+    }
+
+    static std::size_t parseLine(const char* pos, const char* last, std::vector<double>& values, bool& complete)
+    {
+        std::size_t count = 0;
+        while (count < values.size()) {
+            while (pos < last && isBlank(*pos))
+                ++pos;
+            if (pos == last || !parseValue(pos, last, values[count]))
+                break;
+            count++;
+        }
+
+        complete = isEmptyLine(pos, last);
+        return count;
+    }
+
+private:
+    struct Block {
+        const char* begin;
+        const char* end;
+        std::size_t first;
+        std::size_t rows;
+    };
+
+    QFile file;
+    std::vector<char> buffer;
+    std::vector<Block> blocks;
+    const char* begin;
+    const char* end;
+};
+
+/**
+ * Passes the rows of \a data to \a func in the worker threads.
+ */
+template <typename Func>
+void transferRows(const Eigen::MatrixXd& data, Func func)
+{
+    const std::size_t blockSize = 4096;
+    std::size_t numRows = static_cast<std::size_t>(data.rows());
+    std::size_t numCols = static_cast<std::size_t>(data.cols());
+    std::vector<std::size_t> blocks;
+    for (std::size_t i = 0; i < numRows; i += blockSize)
+        blocks.push_back(i);
+
+    QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+        std::vector<double> row(numCols);
+        std::size_t last = std::min(start + blockSize, numRows);
+        for (std::size_t i = start; i < last; i++) {
+            for (std::size_t j = 0; j < numCols; j++)
+                row[j] = data(i, j);
+            func(i, row.data());
+        }
+    });
+}
+}
+
 void PointsAlgos::Load(PointKernel &points, const char *FileName)
 {
     Base::FileInfo File(FileName);
@@ -64,57 +321,42 @@ void PointsAlgos::Load(PointKernel &points, const char *FileName)
 
 void PointsAlgos::LoadAscii(PointKernel &points, const char *FileName)
 {
-    boost::regex rx("^\\s*([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                     "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                     "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    //boost::regex rx("(\\b[0-9]+\\.([0-9]+\\b)?|\\.[0-9]+\\b)");
-    //boost::regex rx("^\\s*(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s+(-?[0-9]*)\\.([0-9]+)\\s*$");
-    boost::cmatch what;
-
-    Base::Vector3d pt;
-    int LineCnt=0;
-    std::string line;
-    Base::FileInfo fi(FileName);
-
-    Base::ifstream tmp_str(fi, std::ios::in);
-
-    // estimating size
-    while (std::getline(tmp_str,line))
-        LineCnt++;
-
-    // resize the PointKernel
-    points.resize(LineCnt);
-
-    Base::SequencerLauncher seq( "Loading points...", LineCnt );
-
-    // again to the beginning
-    Base::ifstream file(fi, std::ios::in);
-    LineCnt = 0;
-
-    try {
-        // read file
-        while (std::getline(file, line)) {
-            if (boost::regex_match(line.c_str(), what, rx)) {
-                pt.x = std::atof(what[1].first);
-                pt.y = std::atof(what[4].first);
-                pt.z = std::atof(what[7].first);
-
-                points.setPoint(LineCnt,pt);
-                seq.next();
-                LineCnt++;
+    AsciiData text(FileName, 0);
+    std::size_t rows = text.countRows();
+    points.resize(rows);
+
+    // a valid line consists of exactly three numbers
+    Base::Vector3f* pts = points.getBasicPoints().data();
+    AsciiData::IndexList rejected = text.parse("Loading points...", 3, rows,
+        [pts](std::size_t row, const double* values, std::size_t count, bool complete) {
+        if (count != 3 || !complete)
+            return false;
+        pts[row].Set(static_cast<float>(values[0]),
+                     static_cast<float>(values[1]),
+                     static_cast<float>(values[2]));
+        return true;
+    });
+
+    // now remove the lines that only looked like points
+    if (!rejected.empty()) {
+        std::vector<Base::Vector3f>& kernel = points.getBasicPoints();
+        std::size_t next = 0, index = 0;
+        for (std::size_t i = 0; i < kernel.size(); i++) {
+            if (next < rejected.size() && rejected[next] == i) {
+                next++;
+                continue;
             }
+            kernel[index++] = kernel[i];
         }
-    }
-    catch (...) {
-        points.clear();
-        throw Base::BadFormatError("Reading in points failed.");
+        kernel.resize(index);
     }
 
-    // now remove the last points from the kernel
-    // Note: first we allocate memory corresponding to the number of lines (points and comments)
-    //       and read in the file twice. But then the size of the kernel is too high
-    if (LineCnt < (int)points.size())
-        points.erase(LineCnt, points.size());
+    // the file contains the transformed points
+    Base::Matrix4D mat = points.getTransform();
+    if (mat != Base::Matrix4D()) {
+        mat.inverseGauss();
+        mat.transformPoints(points.getBasicPoints().data(), points.size());
+    }
 }
 
 // ----------------------------------------------------------------------------
@@ -123,6 +365,8 @@ Reader::Reader()
 {
     width = 0;
     height = 0;
+    stride = 1;
+    cellSize = 0.0;
 }
 
 Reader::~Reader()
@@ -136,11 +380,22 @@ void Reader::clear()
     normals.clear();
 }
 
+void Reader::setSubsampling(unsigned long stride, double cellSize)
+{
+    this->stride = std::max<unsigned long>(stride, 1);
+    this->cellSize = cellSize;
+}
+
 const PointKernel& Reader::getPoints() const
 {
     return points;
 }
 
+PointKernel& Reader::getPoints()
+{
+    return points;
+}
+
 bool Reader::hasProperties() const
 {
     return (hasIntensities() || hasColors() || hasNormals());
@@ -151,6 +406,11 @@ const std::vector<float>& Reader::getIntensities() const
     return intensity;
 }
 
+std::vector<float>& Reader::getIntensities()
+{
+    return intensity;
+}
+
 bool Reader::hasIntensities() const
 {
     return (!intensity.empty());
@@ -161,6 +421,11 @@ const std::vector<App::Color>& Reader::getColors() const
     return colors;
 }
 
+std::vector<App::Color>& Reader::getColors()
+{
+    return colors;
+}
+
 bool Reader::hasColors() const
 {
     return (!colors.empty());
@@ -171,6 +436,11 @@ const std::vector<Base::Vector3f>& Reader::getNormals() const
     return normals;
 }
 
+std::vector<Base::Vector3f>& Reader::getNormals()
+{
+    return normals;
+}
+
 bool Reader::hasNormals() const
 {
     return (!normals.empty());
@@ -517,17 +787,6 @@ void PlyReader::read(const std::string& filename)
     std::size_t offset = 0;
     std::size_t numPoints = readHeader(inp, format, offset, fields, types, sizes);
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
-    }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
-    }
-
     std::vector<std::string>::iterator it;
     std::size_t max_size = std::numeric_limits<std::size_t>::max();
 
@@ -601,55 +860,59 @@ void PlyReader::read(const std::string& filename)
     bool hasData = (x != max_size && y != max_size && z != max_size);
     bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
     bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (red != max_size && green != max_size && blue != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i,x),data(i,y),data(i,z)));
+    bool hasColor = (red != max_size && green != max_size && blue != max_size &&
+                     (types[red] == "uchar" || types[red] == "float"));
+    if (!hasData)
+        return;
+
+    // the rows are written directly to their place in the points and property arrays
+    points.resize(numPoints);
+    if (hasNormal)
+        normals.resize(numPoints);
+    if (hasIntensity)
+        intensity.resize(numPoints);
+    if (hasColor)
+        colors.resize(numPoints);
+
+    Base::Vector3f* pts = points.getBasicPoints().data();
+    Base::Vector3f* nor = hasNormal ? normals.data() : nullptr;
+    float* grey = hasIntensity ? intensity.data() : nullptr;
+    App::Color* col = hasColor ? colors.data() : nullptr;
+    float colorScale = (hasColor && types[red] == "uchar") ? 1.0f/255.0f : 1.0f;
+    auto transfer = [=](std::size_t i, const double* row) {
+        pts[i].Set(static_cast<float>(row[x]), static_cast<float>(row[y]), static_cast<float>(row[z]));
+        if (nor)
+            nor[i].Set(static_cast<float>(row[normal_x]), static_cast<float>(row[normal_y]), static_cast<float>(row[normal_z]));
+        if (grey)
+            grey[i] = static_cast<float>(row[greyvalue]);
+        if (col) {
+            float a = alpha != max_size ? static_cast<float>(row[alpha]) : 1.0f;
+            col[i].set(static_cast<float>(row[red]) * colorScale,
+                       static_cast<float>(row[green]) * colorScale,
+                       static_cast<float>(row[blue]) * colorScale,
+                       a * colorScale);
         }
-    }
+    };
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            normals.emplace_back(data(i,normal_x),data(i,normal_y),data(i,normal_z));
-        }
+    if (format == "ascii") {
+        AsciiData text(filename, static_cast<std::size_t>(inp.tellg()));
+        text.skipLines(offset);
+        text.countRows();
+        text.parse("Loading points...", fields.size(), numPoints,
+                   [&transfer](std::size_t row, const double* values, std::size_t, bool) {
+            transfer(row, values);
+            return true;
+        });
     }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            intensity.push_back(data(i,greyvalue));
-        }
+    else if (format == "binary_little_endian") {
+        Eigen::MatrixXd data(numPoints, fields.size());
+        readBinary(false, inp, offset, types, sizes, data);
+        transferRows(data, transfer);
     }
-
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (std::size_t i=0; i<numPoints; i++) {
-                float r = data(i, red);
-                float g = data(i, green);
-                float b = data(i, blue);
-                if (alpha != max_size)
-                    a = data(i, alpha);
-                colors.emplace_back(static_cast<float>(r)/255.0f,
-                                            static_cast<float>(g)/255.0f,
-                                            static_cast<float>(b)/255.0f,
-                                            static_cast<float>(a)/255.0f);
-            }
-        }
-        else if (types[red] == "float") {
-            for (std::size_t i=0; i<numPoints; i++) {
-                float r = data(i, red);
-                float g = data(i, green);
-                float b = data(i, blue);
-                if (alpha != max_size)
-                    a = data(i, alpha);
-                colors.emplace_back(r, g, b, a);
-            }
-        }
+    else if (format == "binary_big_endian") {
+        Eigen::MatrixXd data(numPoints, fields.size());
+        readBinary(true, inp, offset, types, sizes, data);
+        transferRows(data, transfer);
     }
 }
 
@@ -821,37 +1084,6 @@ std::size_t PlyReader::readHeader(std::istream& in,
     return numPoints;
 }
 
-void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd& data)
-{
-    std::string line;
-    std::size_t row = 0;
-    std::size_t numPoints = data.rows();
-    std::size_t numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty())
-            continue;
-
-        if (offset > 0) {
-            offset--;
-            continue;
-        }
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        for (std::size_t col = 0; col < list.size() && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
 void PlyReader::readBinary(bool swapByteOrder,
                            std::istream& inp,
                            std::size_t offset,
@@ -961,32 +1193,6 @@ void PcdReader::read(const std::string& filename)
     std::vector<int> sizes;
     std::size_t numPoints = readHeader(inp, format, fields, types, sizes);
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, data);
-    }
-    else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
-    }
-    else if (format == "binary_compressed") {
-        unsigned int c, u;
-        Base::InputStream str(inp);
-        str >> c >> u;
-
-        std::vector<char> compressed(c);
-        inp.read(&compressed[0], c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(&compressed[0], c, &uncompressed[0], u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(0);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
-        }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
-        }
-    }
-
     std::vector<std::string>::iterator it;
     std::size_t max_size = std::numeric_limits<std::size_t>::max();
 
@@ -1050,63 +1256,83 @@ void PcdReader::read(const std::string& filename)
     bool hasData = (x != max_size && y != max_size && z != max_size);
     bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
     bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (rgba != max_size);
-
-    if (hasData) {
-        points.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i,x),data(i,y),data(i,z)));
+    bool hasColor = (rgba != max_size && (types[rgba] == "U" || types[rgba] == "F"));
+    if (!hasData)
+        return;
+
+    // the rows are written directly to their place in the points and property arrays
+    points.resize(numPoints);
+    if (hasNormal)
+        normals.resize(numPoints);
+    if (hasIntensity)
+        intensity.resize(numPoints);
+    if (hasColor)
+        colors.resize(numPoints);
+
+    Base::Vector3f* pts = points.getBasicPoints().data();
+    Base::Vector3f* nor = hasNormal ? normals.data() : nullptr;
+    float* grey = hasIntensity ? intensity.data() : nullptr;
+    App::Color* col = hasColor ? colors.data() : nullptr;
+    bool packedFloat = hasColor && types[rgba] == "F";
+    auto transfer = [=](std::size_t i, const double* row) {
+        pts[i].Set(static_cast<float>(row[x]), static_cast<float>(row[y]), static_cast<float>(row[z]));
+        if (nor)
+            nor[i].Set(static_cast<float>(row[normal_x]), static_cast<float>(row[normal_y]), static_cast<float>(row[normal_z]));
+        if (grey)
+            grey[i] = static_cast<float>(row[greyvalue]);
+        if (col) {
+            uint32_t packed;
+            if (packedFloat) {
+                // the bits of the float are the packed color
+                float value = static_cast<float>(row[rgba]);
+                std::memcpy(&packed, &value, sizeof(packed));
+            }
+            else {
+                packed = static_cast<uint32_t>(row[rgba]);
+            }
+            uint32_t a = (packed >> 24) & 0xff;
+            uint32_t r = (packed >> 16) & 0xff;
+            uint32_t g = (packed >> 8) & 0xff;
+            uint32_t b = packed & 0xff;
+            col[i].set(static_cast<float>(r)/255.0f,
+                       static_cast<float>(g)/255.0f,
+                       static_cast<float>(b)/255.0f,
+                       static_cast<float>(a)/255.0f);
         }
-    }
+    };
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            normals.emplace_back(data(i,normal_x),data(i,normal_y),data(i,normal_z));
-        }
+    if (format == "ascii") {
+        AsciiData text(filename, static_cast<std::size_t>(inp.tellg()));
+        text.countRows();
+        text.parse("Loading points...", fields.size(), numPoints,
+                   [&transfer](std::size_t row, const double* values, std::size_t, bool) {
+            transfer(row, values);
+            return true;
+        });
     }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (std::size_t i=0; i<numPoints; i++) {
-            intensity.push_back(data(i,greyvalue));
-        }
+    else if (format == "binary") {
+        Eigen::MatrixXd data(numPoints, fields.size());
+        readBinary(false, inp, types, sizes, data);
+        transferRows(data, transfer);
     }
+    else if (format == "binary_compressed") {
+        unsigned int c, u;
+        Base::InputStream str(inp);
+        str >> c >> u;
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (std::size_t i=0; i<numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i,rgba));
-                uint32_t a = (packed >> 24) & 0xff;
-                uint32_t r = (packed >> 16) & 0xff;
-                uint32_t g = (packed >> 8) & 0xff;
-                uint32_t b = packed & 0xff;
-                colors.emplace_back(static_cast<float>(r)/255.0f,
-                                            static_cast<float>(g)/255.0f,
-                                            static_cast<float>(b)/255.0f,
-                                            static_cast<float>(a)/255.0f);
-            }
+        std::vector<char> compressed(c);
+        inp.read(&compressed[0], c);
+        std::vector<char> uncompressed(u);
+        if (lzfDecompress(&compressed[0], c, &uncompressed[0], u) == u) {
+            DataStreambuf ibuf(uncompressed);
+            std::istream istr(0);
+            istr.rdbuf(&ibuf);
+            Eigen::MatrixXd data(numPoints, fields.size());
+            readBinary(true, istr, types, sizes, data);
+            transferRows(data, transfer);
         }
-        else if (types[rgba] == "F") {
-            union RGBA {
-                uint32_t u;
-                float f;
-            };
-
-            union RGBA v;
-            for (std::size_t i=0; i<numPoints; i++) {
-                v.f = static_cast<float>(data(i,rgba));
-                uint32_t packed = v.u;
-                uint32_t a = (packed >> 24) & 0xff;
-                uint32_t r = (packed >> 16) & 0xff;
-                uint32_t g = (packed >> 8) & 0xff;
-                uint32_t b = packed & 0xff;
-                colors.emplace_back(static_cast<float>(r)/255.0f,
-                                            static_cast<float>(g)/255.0f,
-                                            static_cast<float>(b)/255.0f,
-                                            static_cast<float>(a)/255.0f);
-            }
+        else {
+            throw Base::BadFormatError("Failed to decompress binary data");
         }
     }
 }
@@ -1183,32 +1409,6 @@ std::size_t PcdReader::readHeader(std::istream& in,
     return points;
 }
 
-void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
-{
-    std::string line;
-    std::size_t row = 0;
-    std::size_t numPoints = data.rows();
-    std::size_t numFields = data.cols();
-    std::vector<std::string> list;
-    while (std::getline(inp, line) && row < numPoints) {
-        if (line.empty())
-            continue;
-
-        // since the file is loaded in binary mode we may get the CR at the end
-        boost::trim(line);
-        boost::split(list, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-        std::istringstream str(line);
-
-        for (std::size_t col = 0; col < list.size() && col < numFields; col++) {
-            double value = boost::lexical_cast<double>(list[col]);
-            data(row, col) = value;
-        }
-
-        ++row;
-    }
-}
-
 void PcdReader::readBinary(bool transpose,
                            std::istream& inp,
                            const std::vector<std::string>& types,
@@ -1303,6 +1503,227 @@ void PcdReader::readBinary(bool transpose,
 
 // ----------------------------------------------------------------------------
 
+namespace Points {
+/**
+ * Decodes the point records of a LAS file. All values are stored in little endian order.
+ */
+class LasRecord
+{
+public:
+    LasRecord(int format)
+      : rgbOffset(0)
+    {
+        // the offset of the RGB values depends on the point data format
+        switch (format) {
+        case 2:
+            rgbOffset = 20;
+            break;
+        case 3:
+        case 5:
+            rgbOffset = 28;
+            break;
+        case 7:
+        case 8:
+        case 10:
+            rgbOffset = 30;
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool hasColor() const
+    {
+        return rgbOffset > 0;
+    }
+    int32_t x(const char* record) const
+    {
+        return value<int32_t>(record);
+    }
+    int32_t y(const char* record) const
+    {
+        return value<int32_t>(record + 4);
+    }
+    int32_t z(const char* record) const
+    {
+        return value<int32_t>(record + 8);
+    }
+    uint16_t intensity(const char* record) const
+    {
+        return value<uint16_t>(record + 12);
+    }
+    App::Color color(const char* record) const
+    {
+        const float scale = 1.0f / 65535.0f;
+        return App::Color(static_cast<float>(value<uint16_t>(record + rgbOffset)) * scale,
+                          static_cast<float>(value<uint16_t>(record + rgbOffset + 2)) * scale,
+                          static_cast<float>(value<uint16_t>(record + rgbOffset + 4)) * scale);
+    }
+
+private:
+    template <typename T>
+    static T value(const char* data)
+    {
+        T v;
+        std::memcpy(&v, data, sizeof(T));
+        return v;
+    }
+
+private:
+    int rgbOffset;
+};
+}
+
+LasReader::LasReader()
+{
+}
+
+LasReader::~LasReader()
+{
+}
+
+void LasReader::read(const std::string& filename)
+{
+    clear();
+    this->width = 1;
+    this->height = 0;
+
+    Base::FileInfo fi(filename);
+    if (fi.hasExtension("laz"))
+        throw Base::BadFormatError("Compressed LAZ files are not supported, decompress them to LAS first");
+
+    Base::ifstream inp(fi, std::ios::in | std::ios::binary);
+    char signature[4];
+    inp.read(signature, 4);
+    if (!inp || std::strncmp(signature, "LASF", 4) != 0)
+        throw Base::BadFormatError("Not a LAS file");
+
+    // public header block
+    Base::InputStream str(inp);
+    str.setByteOrder(Base::Stream::LittleEndian);
+    uint8_t versionMajor, versionMinor, format;
+    uint16_t headerSize, recordLength;
+    uint32_t dataOffset, legacyCount;
+    double scale[3], offset[3], bounds[6];
+    inp.ignore(20);     // file source id, global encoding, GUID
+    str >> versionMajor >> versionMinor;
+    inp.ignore(68);     // system identifier, generating software, creation date
+    str >> headerSize >> dataOffset;
+    inp.ignore(4);      // number of variable length records
+    str >> format >> recordLength >> legacyCount;
+    inp.ignore(20);     // number of points by return
+    str >> scale[0] >> scale[1] >> scale[2];
+    str >> offset[0] >> offset[1] >> offset[2];
+    // max x, min x, max y, min y, max z, min z
+    for (int i = 0; i < 6; i++)
+        str >> bounds[i];
+
+    uint64_t numPoints = legacyCount;
+    if (versionMajor == 1 && versionMinor >= 4 && headerSize >= 255) {
+        inp.ignore(20); // start of waveform data and of the extended records
+        str >> numPoints;
+    }
+
+    if (!inp || versionMajor != 1)
+        throw Base::BadFormatError("Not a valid LAS file");
+    // LASzip marks compressed point data in the upper bits of the format
+    if (format & 0xc0)
+        throw Base::BadFormatError("Compressed LAZ point data is not supported, decompress it to LAS first");
+    if (format > 10 || recordLength < 20)
+        throw Base::BadFormatError("Unsupported point data format");
+
+    // The coordinates are stored relative to the lower corner of the cloud so that
+    // they keep their precision in single precision, the corner becomes the placement.
+    Base::Vector3d origin(bounds[1], bounds[3], bounds[5]);
+    Base::Matrix4D mat;
+    mat.move(origin);
+    points.setTransform(mat);
+
+    LasRecord record(format);
+    std::size_t step = std::max<unsigned long>(stride, 1);
+    std::size_t numKept = static_cast<std::size_t>((numPoints + step - 1) / step);
+    std::vector<Base::Vector3f>& kernel = points.getBasicPoints();
+    kernel.reserve(numKept);
+    intensity.reserve(numKept);
+    if (record.hasColor())
+        colors.reserve(numKept);
+
+    // cells of the spatial subsampling that already have a point
+    std::unordered_set<uint64_t> cells;
+    bool spatial = cellSize > 0.0;
+
+    inp.seekg(static_cast<std::streamoff>(dataOffset), std::ios::beg);
+
+    // the records are read in chunks that are decoded in the worker threads
+    const std::size_t chunkSize = 1048576;
+    const std::size_t blockSize = 16384;
+    std::vector<char> buffer;
+    std::vector<Base::Vector3f> chunkPoints;
+    std::vector<float> chunkIntensity;
+    std::vector<App::Color> chunkColors;
+    bool hasIntensity = false;
+
+    uint64_t numChunks = (numPoints + chunkSize - 1) / chunkSize;
+    Base::SequencerLauncher seq("Loading points...", static_cast<std::size_t>(numChunks));
+    for (uint64_t start = 0; start < numPoints; start += chunkSize) {
+        std::size_t count = static_cast<std::size_t>(std::min<uint64_t>(chunkSize, numPoints - start));
+        buffer.resize(count * recordLength);
+        inp.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+        if (!inp)
+            throw Base::BadFormatError("File expects too many elements");
+
+        // the stride is counted over the whole file
+        std::size_t first = static_cast<std::size_t>((step - start % step) % step);
+        std::size_t kept = first < count ? (count - first + step - 1) / step : 0;
+        chunkPoints.resize(kept);
+        chunkIntensity.resize(kept);
+        chunkColors.resize(record.hasColor() ? kept : 0);
+
+        std::vector<std::size_t> blocks;
+        for (std::size_t i = 0; i < kept; i += blockSize)
+            blocks.push_back(i);
+
+        QtConcurrent::blockingMap(blocks, [&](std::size_t begin) {
+            std::size_t end = std::min(begin + blockSize, kept);
+            for (std::size_t i = begin; i < end; i++) {
+                const char* data = &buffer[(first + i * step) * recordLength];
+                chunkPoints[i].Set(static_cast<float>(record.x(data) * scale[0] + offset[0] - origin.x),
+                                   static_cast<float>(record.y(data) * scale[1] + offset[1] - origin.y),
+                                   static_cast<float>(record.z(data) * scale[2] + offset[2] - origin.z));
+                chunkIntensity[i] = static_cast<float>(record.intensity(data));
+                if (!chunkColors.empty())
+                    chunkColors[i] = record.color(data);
+            }
+        });
+
+        for (std::size_t i = 0; i < kept; i++) {
+            if (spatial) {
+                const Base::Vector3f& p = chunkPoints[i];
+                uint64_t cx = static_cast<uint64_t>(std::max(0.0, std::floor(p.x / cellSize))) & 0x1fffff;
+                uint64_t cy = static_cast<uint64_t>(std::max(0.0, std::floor(p.y / cellSize))) & 0x1fffff;
+                uint64_t cz = static_cast<uint64_t>(std::max(0.0, std::floor(p.z / cellSize))) & 0x1fffff;
+                if (!cells.insert((cx << 42) | (cy << 21) | cz).second)
+                    continue;
+            }
+
+            kernel.push_back(chunkPoints[i]);
+            intensity.push_back(chunkIntensity[i]);
+            if (chunkIntensity[i] != 0.0f)
+                hasIntensity = true;
+            if (!chunkColors.empty())
+                colors.push_back(chunkColors[i]);
+        }
+
+        seq.next(true);
+    }
+
+    // the intensity is optional in LAS files
+    if (!hasIntensity)
+        intensity.clear();
+}
+
+// ----------------------------------------------------------------------------
+
 Writer::Writer(const PointKernel& p) : points(p)
 {
     width = p.size();
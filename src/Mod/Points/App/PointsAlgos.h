@@ -52,6 +52,11 @@ public:
     virtual void read(const std::string& filename) = 0;
 
     void clear();
+    /** Only every \a stride-th point is read and of these only one point per cube with
+     * the edge length \a cellSize is kept if \a cellSize is positive. Readers that cannot
+     * subsample while reading the file ignore it.
+     */
+    void setSubsampling(unsigned long stride, double cellSize);
     const PointKernel& getPoints() const;
     bool hasProperties() const;
     const std::vector<float>& getIntensities() const;
@@ -60,6 +65,14 @@ public:
     bool hasColors() const;
     const std::vector<Base::Vector3f>& getNormals() const;
     bool hasNormals() const;
+
+    /** @name Access to the data to move it to the properties without copying */
+    //@{
+    PointKernel& getPoints();
+    std::vector<float>& getIntensities();
+    std::vector<App::Color>& getColors();
+    std::vector<Base::Vector3f>& getNormals();
+    //@}
     bool isStructured() const;
     int getWidth() const;
     int getHeight() const;
@@ -70,6 +83,8 @@ protected:
     std::vector<App::Color> colors;
     std::vector<Base::Vector3f> normals;
     int width, height;
+    unsigned long stride;
+    double cellSize;
 };
 
 class AscReader : public Reader
@@ -91,7 +106,6 @@ private:
     std::size_t readHeader(std::istream&, std::string& format, std::size_t& offset,
         std::vector<std::string>& fields, std::vector<std::string>& types,
         std::vector<int>& sizes);
-    void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
     void readBinary(bool swapByteOrder, std::istream&, std::size_t offset,
         const std::vector<std::string>& types,
         const std::vector<int>& sizes,
@@ -108,13 +122,20 @@ public:
 private:
     std::size_t readHeader(std::istream&, std::string& format, std::vector<std::string>& fields,
         std::vector<std::string>& types, std::vector<int>& sizes);
-    void readAscii(std::istream&, Eigen::MatrixXd& data);
     void readBinary(bool transpose, std::istream&,
         const std::vector<std::string>& types,
         const std::vector<int>& sizes,
         Eigen::MatrixXd& data);
 };
 
+class LasReader : public Reader
+{
+public:
+    LasReader();
+    ~LasReader();
+    void read(const std::string& filename);
+};
+
 class Writer
 {
 public:
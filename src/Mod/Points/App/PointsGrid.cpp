@@ -25,8 +25,10 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <climits>
 #endif
 
+#include <QtConcurrentMap>
 
 
 #include "PointsGrid.h"
@@ -684,12 +686,56 @@ void PointsGrid::RebuildGrid (void)
   InitGrid();
  
   // Daten-Struktur fuellen
+  //
+  // The grid positions of the points are computed in parallel. Afterwards the points are
+  // grouped by their x position so that every grid slab can be filled by one thread. Inside
+  // a slab the indices are added in increasing order, that is the cheapest way to fill a set.
+  std::size_t numPoints = _pclPoints->size();
+  const std::size_t blockSize = 65536;
+  std::vector<std::size_t> blocks;
+  for (std::size_t i = 0; i < numPoints; i += blockSize)
+    blocks.push_back(i);
+
+  const unsigned long ulSlab = _ulCtGridsY * _ulCtGridsZ;
+  std::vector<unsigned long> cells(numPoints);
+  QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+    std::size_t last = std::min(start + blockSize, numPoints);
+    for (std::size_t i = start; i < last; i++) {
+      unsigned long ulX, ulY, ulZ;
+      Pos(_pclPoints->getPoint(i), ulX, ulY, ulZ);
+      if ( (ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ) )
+        cells[i] = ulX * ulSlab + ulY * _ulCtGridsZ + ulZ;
+      else
+        cells[i] = ULONG_MAX;
+    }
+  });
 
-  unsigned long i = 0;
-  for (PointKernel::const_iterator it = _pclPoints->begin(); it != _pclPoints->end(); ++it )
-  {
-    AddPoint(*it, i++);
+  std::vector<std::size_t> slabStart(_ulCtGridsX + 1, 0);
+  for (std::size_t i = 0; i < numPoints; i++) {
+    if (cells[i] != ULONG_MAX)
+      slabStart[cells[i] / ulSlab + 1]++;
+  }
+  for (unsigned long x = 0; x < _ulCtGridsX; x++)
+    slabStart[x + 1] += slabStart[x];
+
+  std::vector<unsigned long> order(slabStart.back());
+  std::vector<std::size_t> slabPos(slabStart.begin(), slabStart.end() - 1);
+  for (std::size_t i = 0; i < numPoints; i++) {
+    if (cells[i] != ULONG_MAX)
+      order[slabPos[cells[i] / ulSlab]++] = i;
   }
+
+  std::vector<unsigned long> slabs(_ulCtGridsX);
+  for (unsigned long x = 0; x < _ulCtGridsX; x++)
+    slabs[x] = x;
+  QtConcurrent::blockingMap(slabs, [&](unsigned long ulX) {
+    for (std::size_t j = slabStart[ulX]; j < slabStart[ulX + 1]; j++) {
+      unsigned long ulIndex = order[j];
+      unsigned long ulCell = cells[ulIndex] - ulX * ulSlab;
+      std::set<unsigned long>& rclSet = _aulGrid[ulX][ulCell / _ulCtGridsZ][ulCell % _ulCtGridsZ];
+      rclSet.insert(rclSet.end(), ulIndex);
+    }
+  });
 }
 
 void PointsGrid::Pos (const Base::Vector3d &rclPoint, unsigned long &rulX, unsigned long &rulY, unsigned long &rulZ) const
@@ -0,0 +1,436 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <numeric>
+#endif
+
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include "PointsKdTree.h"
+
+using namespace Points;
+
+namespace {
+// number of query points handled by one task of the batched searches
+const std::size_t QueryBlockSize = 4096;
+
+std::vector<std::size_t> blockStarts(std::size_t count, std::size_t blockSize)
+{
+    std::vector<std::size_t> blocks;
+    for (std::size_t i = 0; i < count; i += blockSize)
+        blocks.push_back(i);
+    return blocks;
+}
+}
+
+struct PointsKdTree::Neighbour {
+    float dist;
+    uint64_t pos;
+    bool operator < (const Neighbour& other) const
+    { return dist < other.dist; }
+};
+
+struct PointsKdTree::Subtree {
+    uint64_t first;
+    uint64_t count;
+    std::vector<Node> nodes;
+};
+
+PointsKdTree::PointsKdTree()
+  : leafSize(POINTS_KDTREE_LEAF_SIZE)
+{
+}
+
+PointsKdTree::PointsKdTree(const PointKernel& kernel)
+  : leafSize(POINTS_KDTREE_LEAF_SIZE)
+{
+    build(kernel);
+}
+
+PointsKdTree::PointsKdTree(const std::vector<Base::Vector3d>& pnts)
+  : leafSize(POINTS_KDTREE_LEAF_SIZE)
+{
+    build(pnts);
+}
+
+PointsKdTree::~PointsKdTree()
+{
+}
+
+void PointsKdTree::clear()
+{
+    points.clear();
+    indices.clear();
+    nodes.clear();
+}
+
+void PointsKdTree::build(const PointKernel& kernel, unsigned long leafSize)
+{
+    // store the points relative to the center to keep the precision of floats
+    origin = kernel.getBoundBox().GetCenter();
+    std::vector<Base::Vector3f> pnts;
+    pnts.reserve(kernel.size());
+    for (PointKernel::const_iterator it = kernel.begin(); it != kernel.end(); ++it)
+        pnts.push_back(toLocal(*it));
+    buildTree(pnts, leafSize);
+}
+
+void PointsKdTree::build(const std::vector<Base::Vector3d>& pnts, unsigned long leafSize)
+{
+    Base::BoundBox3d box;
+    for (std::vector<Base::Vector3d>::const_iterator it = pnts.begin(); it != pnts.end(); ++it)
+        box.Add(*it);
+    origin = box.IsValid() ? box.GetCenter() : Base::Vector3d();
+    std::vector<Base::Vector3f> local;
+    local.reserve(pnts.size());
+    for (std::vector<Base::Vector3d>::const_iterator it = pnts.begin(); it != pnts.end(); ++it)
+        local.push_back(toLocal(*it));
+    buildTree(local, leafSize);
+}
+
+Base::Vector3f PointsKdTree::toLocal(const Base::Vector3d& pnt) const
+{
+    return Base::Vector3f(static_cast<float>(pnt.x - origin.x),
+                          static_cast<float>(pnt.y - origin.y),
+                          static_cast<float>(pnt.z - origin.z));
+}
+
+void PointsKdTree::buildTree(std::vector<Base::Vector3f>& pnts, unsigned long leaf)
+{
+    clear();
+    leafSize = std::max<unsigned long>(leaf, 1);
+    if (pnts.empty())
+        return;
+
+    std::vector<unsigned long> order(pnts.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    // The upper levels are built serially until there are enough subtrees to keep all cores
+    // busy, then the subtrees are built in parallel and appended to the node array.
+    int depth = 0;
+    for (int tasks = 1; tasks < 4 * QThread::idealThreadCount(); tasks *= 2)
+        depth++;
+
+    std::vector<Subtree> subtrees;
+    buildNode(pnts, order, nodes, 0, pnts.size(), depth, &subtrees);
+
+    QtConcurrent::blockingMap(subtrees, [&](Subtree& sub) {
+        buildNode(pnts, order, sub.nodes, sub.first, sub.count, 0, 0);
+    });
+
+    // A subtree is referenced by its encoded number until its nodes get their final position
+    for (std::vector<Node>::iterator it = nodes.begin(); it != nodes.end(); ++it) {
+        int32_t* child[2] = {&it->left, &it->right};
+        for (int i = 0; i < 2; i++) {
+            if (*child[i] <= -2) {
+                Subtree& sub = subtrees[-2 - *child[i]];
+                int32_t offset = static_cast<int32_t>(nodes.size());
+                *child[i] = offset;
+                for (std::vector<Node>::iterator jt = sub.nodes.begin(); jt != sub.nodes.end(); ++jt) {
+                    if (jt->left >= 0) {
+                        jt->left += offset;
+                        jt->right += offset;
+                    }
+                }
+                // this may reallocate the nodes, so don't use the iterator afterwards
+                std::size_t pos = it - nodes.begin();
+                nodes.insert(nodes.end(), sub.nodes.begin(), sub.nodes.end());
+                it = nodes.begin() + pos;
+                child[0] = &it->left;
+                child[1] = &it->right;
+            }
+        }
+    }
+
+    // copy the points in the order of the leaves
+    points.resize(pnts.size());
+    std::vector<std::size_t> blocks = blockStarts(pnts.size(), 65536);
+    QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+        std::size_t last = std::min<std::size_t>(start + 65536, pnts.size());
+        for (std::size_t i = start; i < last; i++)
+            points[i] = pnts[order[i]];
+    });
+    indices.swap(order);
+}
+
+int32_t PointsKdTree::buildNode(const std::vector<Base::Vector3f>& pnts, std::vector<unsigned long>& order,
+                                std::vector<Node>& tree, uint64_t first, uint64_t count,
+                                int depth, std::vector<Subtree>* subtrees) const
+{
+    if (subtrees && depth == 0 && count > leafSize) {
+        Subtree sub;
+        sub.first = first;
+        sub.count = count;
+        subtrees->push_back(sub);
+        return -1 - static_cast<int32_t>(subtrees->size());
+    }
+
+    Node node;
+    node.split = 0.0f;
+    node.axis = 0;
+    node.left = node.right = -1;
+    node.first = first;
+    node.count = count;
+    int32_t index = static_cast<int32_t>(tree.size());
+    tree.push_back(node);
+    if (count <= leafSize)
+        return index;
+
+    // split at the median of the longest side
+    std::vector<unsigned long>::iterator begin = order.begin() + first;
+    std::vector<unsigned long>::iterator end = begin + count;
+    Base::BoundBox3f box;
+    for (std::vector<unsigned long>::iterator it = begin; it != end; ++it)
+        box.Add(pnts[*it]);
+    int axis = 0;
+    if (box.LengthY() > box.LengthX())
+        axis = 1;
+    if (box.LengthZ() > std::max(box.LengthX(), box.LengthY()))
+        axis = 2;
+
+    uint64_t half = count / 2;
+    std::nth_element(begin, begin + half, end, [&](unsigned long a, unsigned long b) {
+        return pnts[a][axis] < pnts[b][axis];
+    });
+
+    float split = pnts[*(begin + half)][axis];
+    int32_t left = buildNode(pnts, order, tree, first, half, depth - 1, subtrees);
+    int32_t right = buildNode(pnts, order, tree, first + half, count - half, depth - 1, subtrees);
+
+    Node& self = tree[index];
+    self.split = split;
+    self.axis = axis;
+    self.left = left;
+    self.right = right;
+    return index;
+}
+
+Base::BoundBox3d PointsKdTree::getBoundBox() const
+{
+    Base::BoundBox3d box;
+    for (std::vector<Base::Vector3f>::const_iterator it = points.begin(); it != points.end(); ++it)
+        box.Add(Base::Vector3d(it->x + origin.x, it->y + origin.y, it->z + origin.z));
+    return box;
+}
+
+void PointsKdTree::searchNearest(const Base::Vector3f& pnt, unsigned long k, std::vector<Neighbour>& heap) const
+{
+    // the heap keeps the k best candidates with the farthest one on top
+    heap.clear();
+    if (nodes.empty() || k == 0)
+        return;
+
+    std::vector<int32_t> stack;
+    std::vector<float> planes;
+    stack.push_back(0);
+    planes.push_back(0.0f);
+    while (!stack.empty()) {
+        int32_t index = stack.back();
+        float plane = planes.back();
+        stack.pop_back();
+        planes.pop_back();
+        if (heap.size() == k && plane >= heap.front().dist)
+            continue;
+
+        const Node& node = nodes[index];
+        if (node.left < 0) {
+            for (uint64_t i = node.first; i < node.first + node.count; i++) {
+                Neighbour nb;
+                nb.dist = Base::DistanceP2(pnt, points[i]);
+                nb.pos = i;
+                if (heap.size() < k) {
+                    heap.push_back(nb);
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (nb.dist < heap.front().dist) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = nb;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+            continue;
+        }
+
+        // visit the near side first, the far side only if the plane is closer than the worst candidate
+        float diff = pnt[node.axis] - node.split;
+        stack.push_back(diff < 0.0f ? node.right : node.left);
+        planes.push_back(diff * diff);
+        stack.push_back(diff < 0.0f ? node.left : node.right);
+        planes.push_back(0.0f);
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+}
+
+void PointsKdTree::searchRadius(const Base::Vector3f& pnt, float sqrRadius, std::vector<Neighbour>& result) const
+{
+    result.clear();
+    if (nodes.empty())
+        return;
+
+    std::vector<int32_t> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        stack.pop_back();
+        if (node.left < 0) {
+            for (uint64_t i = node.first; i < node.first + node.count; i++) {
+                Neighbour nb;
+                nb.dist = Base::DistanceP2(pnt, points[i]);
+                nb.pos = i;
+                if (nb.dist <= sqrRadius)
+                    result.push_back(nb);
+            }
+            continue;
+        }
+
+        float diff = pnt[node.axis] - node.split;
+        if (diff < 0.0f) {
+            stack.push_back(node.left);
+            if (diff * diff <= sqrRadius)
+                stack.push_back(node.right);
+        }
+        else {
+            stack.push_back(node.right);
+            if (diff * diff <= sqrRadius)
+                stack.push_back(node.left);
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+}
+
+unsigned long PointsKdTree::nearest(const Base::Vector3d& pnt, double& sqrDist) const
+{
+    std::vector<Neighbour> result;
+    searchNearest(toLocal(pnt), 1, result);
+    if (result.empty())
+        return POINTS_KDTREE_INVALID_INDEX;
+    sqrDist = result.front().dist;
+    return indices[result.front().pos];
+}
+
+unsigned long PointsKdTree::kNearest(const Base::Vector3d& pnt, unsigned long k, std::vector<unsigned long>& ind,
+                                     std::vector<double>* sqrDists) const
+{
+    std::vector<Neighbour> result;
+    searchNearest(toLocal(pnt), k, result);
+    ind.resize(result.size());
+    for (std::size_t i = 0; i < result.size(); i++)
+        ind[i] = indices[result[i].pos];
+    if (sqrDists) {
+        sqrDists->resize(result.size());
+        for (std::size_t i = 0; i < result.size(); i++)
+            (*sqrDists)[i] = result[i].dist;
+    }
+    return static_cast<unsigned long>(result.size());
+}
+
+unsigned long PointsKdTree::radiusSearch(const Base::Vector3d& pnt, double radius, std::vector<unsigned long>& ind,
+                                         std::vector<double>* sqrDists) const
+{
+    std::vector<Neighbour> result;
+    searchRadius(toLocal(pnt), static_cast<float>(radius * radius), result);
+    ind.resize(result.size());
+    for (std::size_t i = 0; i < result.size(); i++)
+        ind[i] = indices[result[i].pos];
+    if (sqrDists) {
+        sqrDists->resize(result.size());
+        for (std::size_t i = 0; i < result.size(); i++)
+            (*sqrDists)[i] = result[i].dist;
+    }
+    return static_cast<unsigned long>(result.size());
+}
+
+void PointsKdTree::kNearest(const std::vector<Base::Vector3d>& pnts, unsigned long k, std::vector<unsigned long>& ind) const
+{
+    ind.assign(pnts.size() * k, POINTS_KDTREE_INVALID_INDEX);
+    std::vector<std::size_t> blocks = blockStarts(pnts.size(), QueryBlockSize);
+    QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+        std::vector<Neighbour> result;
+        std::size_t last = std::min(start + QueryBlockSize, pnts.size());
+        for (std::size_t i = start; i < last; i++) {
+            searchNearest(toLocal(pnts[i]), k, result);
+            for (std::size_t j = 0; j < result.size(); j++)
+                ind[i * k + j] = indices[result[j].pos];
+        }
+    });
+}
+
+void PointsKdTree::radiusSearch(const std::vector<Base::Vector3d>& pnts, double radius,
+                                std::vector<std::vector<unsigned long> >& ind) const
+{
+    ind.clear();
+    ind.resize(pnts.size());
+    float sqrRadius = static_cast<float>(radius * radius);
+    std::vector<std::size_t> blocks = blockStarts(pnts.size(), QueryBlockSize);
+    QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+        std::vector<Neighbour> result;
+        std::size_t last = std::min(start + QueryBlockSize, pnts.size());
+        for (std::size_t i = start; i < last; i++) {
+            searchRadius(toLocal(pnts[i]), sqrRadius, result);
+            ind[i].resize(result.size());
+            for (std::size_t j = 0; j < result.size(); j++)
+                ind[i][j] = indices[result[j].pos];
+        }
+    });
+}
+
+void PointsKdTree::kNearestNeighbours(unsigned long k, std::vector<unsigned long>& ind) const
+{
+    // the stored order is used for the queries because consecutive points are close to each other
+    ind.assign(points.size() * k, POINTS_KDTREE_INVALID_INDEX);
+    std::vector<std::size_t> blocks = blockStarts(points.size(), QueryBlockSize);
+    QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+        std::vector<Neighbour> result;
+        std::size_t last = std::min(start + QueryBlockSize, points.size());
+        for (std::size_t i = start; i < last; i++) {
+            searchNearest(points[i], k, result);
+            std::size_t offset = indices[i] * k;
+            for (std::size_t j = 0; j < result.size(); j++)
+                ind[offset + j] = indices[result[j].pos];
+        }
+    });
+}
+
+void PointsKdTree::radiusNeighbours(double radius, std::vector<std::vector<unsigned long> >& ind) const
+{
+    ind.clear();
+    ind.resize(points.size());
+    float sqrRadius = static_cast<float>(radius * radius);
+    std::vector<std::size_t> blocks = blockStarts(points.size(), QueryBlockSize);
+    QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+        std::vector<Neighbour> result;
+        std::size_t last = std::min(start + QueryBlockSize, points.size());
+        for (std::size_t i = start; i < last; i++) {
+            searchRadius(points[i], sqrRadius, result);
+            std::vector<unsigned long>& list = ind[indices[i]];
+            list.resize(result.size());
+            for (std::size_t j = 0; j < result.size(); j++)
+                list[j] = indices[result[j].pos];
+        }
+    });
+}
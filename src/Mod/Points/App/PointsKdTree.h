@@ -0,0 +1,157 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#ifndef POINTS_KDTREE_H
+#define POINTS_KDTREE_H
+
+#include <climits>
+#include <vector>
+
+#include "Points.h"
+#include <Base/Vector3D.h>
+#include <Base/BoundBox.h>
+
+#define  POINTS_KDTREE_LEAF_SIZE     16        // Default value for the maximum number of points per leaf
+#define  POINTS_KDTREE_INVALID_INDEX ULONG_MAX // Index of a missing neighbour
+
+namespace Points {
+
+/**
+ * The PointsKdTree is a k-d tree to search the neighbours of points in a point cloud.
+ *
+ * The points are copied into one flat array that is sorted in the order of the leaves, so
+ * that points close to each other are also close in memory. The tree is built in parallel
+ * and the batched queries are distributed over all cores. All search functions are const
+ * and thus can be called from several threads at the same time.
+ *
+ * The returned indices refer to the points the tree was built from.
+ */
+class PointsExport PointsKdTree
+{
+public:
+    /** @name Construction */
+    //@{
+    PointsKdTree();
+    explicit PointsKdTree(const PointKernel&);
+    explicit PointsKdTree(const std::vector<Base::Vector3d>&);
+    ~PointsKdTree();
+    //@}
+
+    /** @name Building */
+    //@{
+    /** Builds the tree from the transformed points of the kernel. */
+    void build(const PointKernel&, unsigned long leafSize = POINTS_KDTREE_LEAF_SIZE);
+    /** Builds the tree from the given points. */
+    void build(const std::vector<Base::Vector3d>&, unsigned long leafSize = POINTS_KDTREE_LEAF_SIZE);
+    /** Removes all points. */
+    void clear();
+    //@}
+
+    /** @name Information */
+    //@{
+    bool isEmpty() const
+    { return points.empty(); }
+    /** Returns the number of points of the tree. */
+    unsigned long size() const
+    { return static_cast<unsigned long>(points.size()); }
+    /** Returns the number of nodes of the tree. */
+    unsigned long countNodes() const
+    { return static_cast<unsigned long>(nodes.size()); }
+    /** Returns the bounding box of all points. */
+    Base::BoundBox3d getBoundBox() const;
+    //@}
+
+    /** @name Search */
+    //@{
+    /** Returns the index of the point nearest to \a pnt or POINTS_KDTREE_INVALID_INDEX if the
+     * tree is empty. The squared distance is written to \a sqrDist.
+     */
+    unsigned long nearest(const Base::Vector3d& pnt, double& sqrDist) const;
+    /** Searches the \a k nearest points of \a pnt. The indices are sorted by increasing distance,
+     * if \a sqrDists is set the squared distances are written to it. Returns the number of
+     * found points which is only less than \a k if the tree has less points.
+     */
+    unsigned long kNearest(const Base::Vector3d& pnt, unsigned long k, std::vector<unsigned long>& indices,
+                           std::vector<double>* sqrDists = 0) const;
+    /** Searches all points with a distance to \a pnt less than or equal to \a radius, the indices
+     * are sorted by increasing distance. Returns the number of found points.
+     */
+    unsigned long radiusSearch(const Base::Vector3d& pnt, double radius, std::vector<unsigned long>& indices,
+                               std::vector<double>* sqrDists = 0) const;
+    //@}
+
+    /** @name Batched search
+     * The queries are distributed over all cores.
+     */
+    //@{
+    /** Searches the \a k nearest points of every point of \a pnts. The result is stored as one
+     * block of \a k indices per query point, missing neighbours are set to POINTS_KDTREE_INVALID_INDEX.
+     */
+    void kNearest(const std::vector<Base::Vector3d>& pnts, unsigned long k, std::vector<unsigned long>& indices) const;
+    /** Searches the points within \a radius of every point of \a pnts. */
+    void radiusSearch(const std::vector<Base::Vector3d>& pnts, double radius,
+                      std::vector<std::vector<unsigned long> >& indices) const;
+    /** Searches the \a k nearest points of every point of the tree including the point itself.
+     * The result is stored as one block of \a k indices per point in the order of the points
+     * the tree was built from.
+     */
+    void kNearestNeighbours(unsigned long k, std::vector<unsigned long>& indices) const;
+    /** Searches the points within \a radius of every point of the tree including the point itself,
+     * in the order of the points the tree was built from.
+     */
+    void radiusNeighbours(double radius, std::vector<std::vector<unsigned long> >& indices) const;
+    //@}
+
+private:
+    struct Node {
+        /// Position of the split plane
+        float split;
+        /// Axis of the split plane
+        int32_t axis;
+        /// Index of the children or -1 for a leaf
+        int32_t left, right;
+        /// First point of the node in the sorted points
+        uint64_t first;
+        /// Number of points below the node
+        uint64_t count;
+    };
+    struct Neighbour;
+    struct Subtree;
+
+    void buildTree(std::vector<Base::Vector3f>&, unsigned long leafSize);
+    int32_t buildNode(const std::vector<Base::Vector3f>&, std::vector<unsigned long>& order,
+                      std::vector<Node>& tree, uint64_t first, uint64_t count,
+                      int depth, std::vector<Subtree>* subtrees) const;
+    void searchNearest(const Base::Vector3f&, unsigned long k, std::vector<Neighbour>&) const;
+    void searchRadius(const Base::Vector3f&, float sqrRadius, std::vector<Neighbour>&) const;
+    Base::Vector3f toLocal(const Base::Vector3d&) const;
+
+private:
+    Base::Vector3d origin;               /**< Origin of the stored points. */
+    std::vector<Base::Vector3f> points;  /**< Points relative to the origin in the order of the leaves. */
+    std::vector<unsigned long> indices;  /**< Index of the original point of every stored point. */
+    std::vector<Node> nodes;             /**< The nodes, the root is the first. */
+    unsigned long leafSize;
+};
+
+} // namespace Points
+
+#endif // POINTS_KDTREE_H
@@ -0,0 +1,227 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <climits>
+# include <cmath>
+# include <limits>
+# include <queue>
+#endif
+
+#include <Eigen/Eigenvalues>
+#include <QtConcurrentMap>
+
+#include <Base/Exception.h>
+
+#include "PointsNormals.h"
+#include "PointsKdTree.h"
+
+using namespace Points;
+
+NormalEstimation::NormalEstimation(const PointKernel& pts)
+  : kernel(pts)
+  , kSearch(0)
+  , searchRadius(0)
+  , orientation(Viewpoint)
+{
+}
+
+NormalEstimation::~NormalEstimation()
+{
+}
+
+void NormalEstimation::perform(std::vector<Base::Vector3d>& normals) const
+{
+    if (kSearch <= 0 && searchRadius <= 0)
+        throw Base::ValueError("Either the number of neighbours or the search radius must be set");
+
+    std::vector<Base::Vector3d> points;
+    points.reserve(kernel.size());
+    for (PointKernel::const_iterator it = kernel.begin(); it != kernel.end(); ++it)
+        points.push_back(*it);
+    std::size_t numPoints = points.size();
+
+    // The neighbours of all points are searched in parallel and stored as one array with
+    // the offset of the first neighbour of every point
+    PointsKdTree tree(points);
+    std::vector<std::size_t> offsets(numPoints + 1, 0);
+    std::vector<unsigned long> neighbours;
+    if (kSearch > 0) {
+        std::size_t k = static_cast<std::size_t>(kSearch);
+        tree.kNearestNeighbours(k, neighbours);
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < numPoints; i++) {
+            offsets[i] = pos;
+            for (std::size_t j = i * k; j < (i + 1) * k; j++) {
+                if (neighbours[j] != POINTS_KDTREE_INVALID_INDEX)
+                    neighbours[pos++] = neighbours[j];
+            }
+        }
+        offsets[numPoints] = pos;
+        neighbours.resize(pos);
+    }
+    else {
+        std::vector<std::vector<unsigned long> > lists;
+        tree.radiusNeighbours(searchRadius, lists);
+        for (std::size_t i = 0; i < numPoints; i++)
+            offsets[i + 1] = offsets[i] + lists[i].size();
+        neighbours.reserve(offsets[numPoints]);
+        for (std::size_t i = 0; i < numPoints; i++)
+            neighbours.insert(neighbours.end(), lists[i].begin(), lists[i].end());
+    }
+
+    normals.resize(numPoints);
+    const std::size_t blockSize = 16384;
+    std::vector<std::size_t> blocks;
+    for (std::size_t i = 0; i < numPoints; i += blockSize)
+        blocks.push_back(i);
+
+    QtConcurrent::blockingMap(blocks, [&](std::size_t start) {
+        std::size_t last = std::min(start + blockSize, numPoints);
+        for (std::size_t i = start; i < last; i++) {
+            std::size_t first = offsets[i];
+            std::size_t count = offsets[i + 1] - first;
+            if (count < 3) {
+                double nan = std::numeric_limits<double>::quiet_NaN();
+                normals[i].Set(nan, nan, nan);
+                continue;
+            }
+
+            // the covariance is computed relative to the point itself to keep the precision
+            const Base::Vector3d& base = points[i];
+            Eigen::Vector3d center(0, 0, 0);
+            for (std::size_t j = first; j < first + count; j++) {
+                Base::Vector3d d = points[neighbours[j]] - base;
+                center += Eigen::Vector3d(d.x, d.y, d.z);
+            }
+            center /= static_cast<double>(count);
+
+            Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+            for (std::size_t j = first; j < first + count; j++) {
+                Base::Vector3d d = points[neighbours[j]] - base;
+                Eigen::Vector3d v = Eigen::Vector3d(d.x, d.y, d.z) - center;
+                covariance += v * v.transpose();
+            }
+
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+            Eigen::Vector3d n = solver.eigenvectors().col(0);
+            Base::Vector3d normal(n.x(), n.y(), n.z());
+            if (orientation == Viewpoint && normal * (viewpoint - base) < 0)
+                normal = -normal;
+            normals[i] = normal;
+        }
+    });
+
+    if (orientation == Propagate)
+        propagate(points, offsets, neighbours, normals);
+}
+
+void NormalEstimation::propagate(const std::vector<Base::Vector3d>& points,
+                                 const std::vector<std::size_t>& offsets,
+                                 const std::vector<unsigned long>& neighbours,
+                                 std::vector<Base::Vector3d>& normals) const
+{
+    std::size_t numPoints = points.size();
+
+    // The k nearest neighbours are not symmetric, so add the reverse edges to get an
+    // undirected graph
+    std::vector<std::size_t> degree(numPoints + 1, 0);
+    for (std::size_t i = 0; i < numPoints; i++) {
+        for (std::size_t j = offsets[i]; j < offsets[i + 1]; j++) {
+            if (neighbours[j] != i) {
+                degree[i + 1]++;
+                degree[neighbours[j] + 1]++;
+            }
+        }
+    }
+    for (std::size_t i = 0; i < numPoints; i++)
+        degree[i + 1] += degree[i];
+
+    std::vector<unsigned long> graph(degree[numPoints]);
+    std::vector<std::size_t> fill(degree.begin(), degree.end() - 1);
+    for (std::size_t i = 0; i < numPoints; i++) {
+        for (std::size_t j = offsets[i]; j < offsets[i + 1]; j++) {
+            unsigned long other = neighbours[j];
+            if (other != i) {
+                graph[fill[i]++] = other;
+                graph[fill[other]++] = static_cast<unsigned long>(i);
+            }
+        }
+    }
+
+    // Points without a valid normal don't take part
+    std::vector<bool> visited(numPoints, false);
+    for (std::size_t i = 0; i < numPoints; i++) {
+        if (!(normals[i] * normals[i] > 0))
+            visited[i] = true;
+    }
+
+    // Every connected region starts at its highest point
+    std::vector<unsigned long> seeds(numPoints);
+    for (std::size_t i = 0; i < numPoints; i++)
+        seeds[i] = static_cast<unsigned long>(i);
+    std::sort(seeds.begin(), seeds.end(), [&](unsigned long a, unsigned long b) {
+        return points[a].z > points[b].z;
+    });
+
+    // Prim's algorithm with the weight 1 - |cos| so that nearly parallel normals are preferred
+    typedef std::pair<double, std::pair<unsigned long, unsigned long> > Edge;
+    std::priority_queue<Edge, std::vector<Edge>, std::greater<Edge> > queue;
+    for (std::vector<unsigned long>::iterator it = seeds.begin(); it != seeds.end(); ++it) {
+        if (visited[*it])
+            continue;
+        visited[*it] = true;
+        if (normals[*it].z < 0)
+            normals[*it] = -normals[*it];
+
+        unsigned long current = *it;
+        for (;;) {
+            for (std::size_t j = degree[current]; j < degree[current + 1]; j++) {
+                unsigned long other = graph[j];
+                if (!visited[other]) {
+                    double weight = 1.0 - std::fabs(normals[current] * normals[other]);
+                    queue.push(std::make_pair(weight, std::make_pair(current, other)));
+                }
+            }
+
+            current = ULONG_MAX;
+            while (!queue.empty()) {
+                Edge edge = queue.top();
+                queue.pop();
+                unsigned long parent = edge.second.first;
+                unsigned long child = edge.second.second;
+                if (visited[child])
+                    continue;
+                visited[child] = true;
+                if (normals[parent] * normals[child] < 0)
+                    normals[child] = -normals[child];
+                current = child;
+                break;
+            }
+
+            if (current == ULONG_MAX)
+                break;
+        }
+    }
+}
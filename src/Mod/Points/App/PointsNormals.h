@@ -0,0 +1,95 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#ifndef POINTS_NORMALS_H
+#define POINTS_NORMALS_H
+
+#include <vector>
+
+#include "Points.h"
+#include <Base/Vector3D.h>
+
+namespace Points {
+
+/**
+ * The NormalEstimation class estimates the normals of a point cloud. The normal of a point is
+ * the direction of the least variance of its neighbours, i.e. the eigenvector of the smallest
+ * eigenvalue of their covariance matrix. The neighbours are either the k nearest points or all
+ * points within a radius, they are searched with a PointsKdTree and the normals of all points
+ * are computed in parallel.
+ *
+ * The sign of a normal computed this way is arbitrary. With the orientation \a Viewpoint the
+ * normals are flipped towards a view point which is suitable for scans from a single position.
+ * With \a Propagate the orientation of a seed point is propagated along the minimum spanning
+ * tree of the neighbourhood graph where the edges are weighted by the angle between the normals
+ * (Hoppe et al.). This gives consistently oriented normals for closed or multi-view scans. The
+ * seed of every connected region is its highest point whose normal is oriented upwards.
+ *
+ * Points with less than three neighbours get a normal with NaN coordinates.
+ */
+class PointsExport NormalEstimation
+{
+public:
+    enum Orientation {
+        None,      /**< Keep the arbitrary sign of the eigenvectors. */
+        Viewpoint, /**< Flip the normals towards the view point. */
+        Propagate  /**< Propagate the orientation over the neighbourhood graph. */
+    };
+
+    NormalEstimation(const PointKernel&);
+    ~NormalEstimation();
+
+    /** Sets the number of nearest neighbours used for a point. */
+    void setKSearch(int k)
+    { kSearch = k; }
+    /** Sets the radius of the sphere around a point that contains its neighbours. It's only used
+     * if the number of nearest neighbours is not set.
+     */
+    void setSearchRadius(double radius)
+    { searchRadius = radius; }
+    /** Sets how the normals are oriented, the default is \a Viewpoint. */
+    void setOrientation(Orientation o)
+    { orientation = o; }
+    /** Sets the view point, the default is the origin. */
+    void setViewpoint(const Base::Vector3d& pnt)
+    { viewpoint = pnt; }
+    /** Computes the normals of all points. Throws a Base::ValueError if neither the number of
+     * neighbours nor the search radius is set.
+     */
+    void perform(std::vector<Base::Vector3d>& normals) const;
+
+private:
+    void propagate(const std::vector<Base::Vector3d>& points,
+                   const std::vector<std::size_t>& offsets,
+                   const std::vector<unsigned long>& neighbours,
+                   std::vector<Base::Vector3d>& normals) const;
+
+private:
+    const PointKernel& kernel;
+    int kSearch;
+    double searchRadius;
+    Orientation orientation;
+    Base::Vector3d viewpoint;
+};
+
+} // namespace Points
+
+#endif // POINTS_NORMALS_H
@@ -0,0 +1,422 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <queue>
+# include <random>
+#endif
+
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <QMutexLocker>
+
+#include <Base/FileInfo.h>
+#include <Base/Matrix.h>
+#include <Base/Stream.h>
+
+#include "PointsOctree.h"
+
+using namespace Points;
+
+namespace {
+// 'OCTR' and the version of the file layout
+const uint32_t OctreeMagic = 0x5254434f;
+const uint32_t OctreeVersion = 1;
+
+int octantOf(const Base::Vector3f& pnt, const Base::Vector3f& center)
+{
+    return (pnt.x >= center.x ? 1 : 0) |
+           (pnt.y >= center.y ? 2 : 0) |
+           (pnt.z >= center.z ? 4 : 0);
+}
+
+Base::BoundBox3f octantBox(const Base::BoundBox3f& cube, int octant)
+{
+    Base::Vector3f center = cube.GetCenter();
+    Base::BoundBox3f box;
+    box.MinX = (octant & 1) ? center.x : cube.MinX;
+    box.MaxX = (octant & 1) ? cube.MaxX : center.x;
+    box.MinY = (octant & 2) ? center.y : cube.MinY;
+    box.MaxY = (octant & 2) ? cube.MaxY : center.y;
+    box.MinZ = (octant & 4) ? center.z : cube.MinZ;
+    box.MaxZ = (octant & 4) ? cube.MaxZ : center.z;
+    return box;
+}
+}
+
+PointsOctree::PointsOctree()
+  : numPoints(0)
+  , dataOffset(0)
+  , cacheSize(POINTS_OCTREE_CACHE_SIZE)
+  , cachedPoints(0)
+{
+}
+
+PointsOctree::~PointsOctree()
+{
+}
+
+void PointsOctree::clear()
+{
+    QMutexLocker locker(&mutex);
+    nodes.clear();
+    points.clear();
+    pointIndices.clear();
+    numPoints = 0;
+    file.reset();
+    fileName.clear();
+    dataOffset = 0;
+    tiles.clear();
+    cachedPoints = 0;
+}
+
+void PointsOctree::setCacheSize(unsigned long points)
+{
+    QMutexLocker locker(&mutex);
+    cacheSize = points;
+}
+
+Base::BoundBox3f PointsOctree::getBoundBox() const
+{
+    if (nodes.empty())
+        return Base::BoundBox3f();
+    return nodes.front().box;
+}
+
+void PointsOctree::build(const PointKernel& kernel, unsigned long maxPointsPerNode)
+{
+    // the tree is built of the transformed points
+    std::vector<Base::Vector3f> source = kernel.getBasicPoints();
+    kernel.getTransform().transformPoints(source.data(), source.size());
+    build(source, maxPointsPerNode);
+}
+
+void PointsOctree::build(const std::vector<Base::Vector3f>& source, unsigned long maxPointsPerNode)
+{
+    clear();
+    maxPointsPerNode = std::max<unsigned long>(maxPointsPerNode, 1);
+
+    std::vector<std::size_t> indices;
+    indices.reserve(source.size());
+    Base::BoundBox3f box;
+    for (std::size_t i = 0; i < source.size(); i++) {
+        const Base::Vector3f& p = source[i];
+        if (boost::math::isnan(p.x) || boost::math::isnan(p.y) || boost::math::isnan(p.z))
+            continue;
+        indices.push_back(i);
+        box.Add(p);
+    }
+
+    if (indices.empty())
+        return;
+
+    // Shuffle the points once so that the beginning of every range that is kept in
+    // order by the stable bucketing below is a random sample of the range.
+    std::mt19937 generator(12345);
+    std::shuffle(indices.begin(), indices.end(), generator);
+
+    // split cubes so that the spacing is comparable between the axes
+    Base::Vector3f center = box.GetCenter();
+    float half = 0.5f * std::max(box.LengthX(), std::max(box.LengthY(), box.LengthZ()));
+    half = std::max(half, 1.0e-6f);
+    Base::BoundBox3f cube(center.x - half, center.y - half, center.z - half,
+                          center.x + half, center.y + half, center.z + half);
+
+    std::vector<std::size_t> buffer(indices.size());
+    buildNode(source, indices, buffer, 0, indices.size(), cube, 0, maxPointsPerNode);
+
+    // the tiles are stored in the order of the index array
+    points.reserve(indices.size());
+    for (std::size_t i : indices)
+        points.push_back(source[i]);
+    numPoints = points.size();
+    pointIndices.swap(indices);
+}
+
+int32_t PointsOctree::buildNode(const std::vector<Base::Vector3f>& source, std::vector<std::size_t>& indices,
+                                std::vector<std::size_t>& buffer, std::size_t begin, std::size_t end,
+                                const Base::BoundBox3f& cube, uint32_t level, unsigned long maxPointsPerNode)
+{
+    int32_t index = static_cast<int32_t>(nodes.size());
+    nodes.emplace_back();
+
+    Base::BoundBox3f box;
+    for (std::size_t i = begin; i < end; i++)
+        box.Add(source[indices[i]]);
+
+    std::size_t count = end - begin;
+    std::size_t owned = count;
+    if (count > maxPointsPerNode && level < POINTS_OCTREE_MAX_DEPTH)
+        owned = maxPointsPerNode;
+
+    Node& node = nodes[index];
+    node.box = box;
+    node.first = begin;
+    node.count = static_cast<uint32_t>(owned);
+    node.level = level;
+    node.spacing = cube.LengthX() / std::sqrt(static_cast<float>(owned));
+    std::fill(node.children, node.children + 8, -1);
+
+    if (owned == count)
+        return index;
+
+    // distribute the remaining points to the octants and keep their order
+    std::size_t start = begin + owned;
+    std::size_t offsets[9] = {0};
+    Base::Vector3f center = cube.GetCenter();
+    for (std::size_t i = start; i < end; i++)
+        offsets[octantOf(source[indices[i]], center) + 1]++;
+    for (int i = 0; i < 8; i++)
+        offsets[i + 1] += offsets[i];
+
+    std::size_t positions[8];
+    std::copy(offsets, offsets + 8, positions);
+    for (std::size_t i = start; i < end; i++)
+        buffer[start + positions[octantOf(source[indices[i]], center)]++] = indices[i];
+    std::copy(buffer.begin() + start, buffer.begin() + end, indices.begin() + start);
+
+    for (int i = 0; i < 8; i++) {
+        if (offsets[i] == offsets[i + 1])
+            continue;
+        int32_t child = buildNode(source, indices, buffer, start + offsets[i], start + offsets[i + 1],
+                                  octantBox(cube, i), level + 1, maxPointsPerNode);
+        // the node vector may have been re-allocated
+        nodes[index].children[i] = child;
+    }
+
+    return index;
+}
+
+bool PointsOctree::save(const char* filename) const
+{
+    Base::FileInfo fi(filename);
+    Base::ofstream out(fi, std::ios::out | std::ios::binary);
+    if (!out)
+        return false;
+
+    Base::OutputStream str(out);
+    str << OctreeMagic << OctreeVersion
+        << static_cast<uint32_t>(nodes.size()) << numPoints;
+    for (std::vector<Node>::const_iterator it = nodes.begin(); it != nodes.end(); ++it) {
+        str << it->box.MinX << it->box.MinY << it->box.MinZ
+            << it->box.MaxX << it->box.MaxY << it->box.MaxZ
+            << it->spacing << it->first << it->count << it->level;
+        for (int i = 0; i < 8; i++)
+            str << it->children[i];
+    }
+
+    // the tiles are written in the order of the nodes
+    for (unsigned long i = 0; i < nodes.size(); i++) {
+        const Node& node = nodes[i];
+        if (node.count == 0)
+            continue;
+        if (isFileBased()) {
+            std::vector<Base::Vector3f> tile = getNodePoints(i);
+            str.write(&tile[0].x, 3 * tile.size());
+        }
+        else {
+            str.write(&points[node.first].x, 3 * node.count);
+        }
+    }
+
+    return out.good();
+}
+
+bool PointsOctree::open(const char* filename)
+{
+    clear();
+
+    Base::FileInfo fi(filename);
+    std::unique_ptr<Base::ifstream> in(new Base::ifstream(fi, std::ios::in | std::ios::binary));
+    if (!*in)
+        return false;
+
+    Base::InputStream str(*in);
+    uint32_t magic = 0, version = 0, numNodes = 0;
+    uint64_t count = 0;
+    str >> magic >> version >> numNodes >> count;
+    if (magic != OctreeMagic || version != OctreeVersion)
+        return false;
+
+    std::vector<Node> table(numNodes);
+    for (std::vector<Node>::iterator it = table.begin(); it != table.end(); ++it) {
+        str >> it->box.MinX >> it->box.MinY >> it->box.MinZ
+            >> it->box.MaxX >> it->box.MaxY >> it->box.MaxZ
+            >> it->spacing >> it->first >> it->count >> it->level;
+        for (int i = 0; i < 8; i++)
+            str >> it->children[i];
+        if (it->first + it->count > count)
+            return false;
+    }
+
+    if (!*in)
+        return false;
+
+    QMutexLocker locker(&mutex);
+    nodes.swap(table);
+    numPoints = count;
+    dataOffset = static_cast<uint64_t>(in->tellg());
+    fileName = filename;
+    file = std::move(in);
+    return true;
+}
+
+const std::vector<Base::Vector3f>& PointsOctree::loadTile(unsigned long index) const
+{
+    std::map<unsigned long, std::vector<Base::Vector3f> >::iterator it = tiles.find(index);
+    if (it != tiles.end())
+        return it->second;
+
+    const Node& node = nodes[index];
+
+    // a simple cache policy: drop everything when the limit is reached
+    if (cachedPoints + node.count > cacheSize) {
+        tiles.clear();
+        cachedPoints = 0;
+    }
+
+    std::vector<Base::Vector3f>& tile = tiles[index];
+    tile.resize(node.count);
+    if (node.count > 0) {
+        file->clear();
+        file->seekg(static_cast<std::streamoff>(dataOffset + node.first * 3 * sizeof(float)));
+        Base::InputStream str(*file);
+        str.read(&tile[0].x, 3 * tile.size());
+    }
+
+    cachedPoints += node.count;
+    return tile;
+}
+
+std::vector<Base::Vector3f> PointsOctree::getNodePoints(unsigned long index) const
+{
+    const Node& node = nodes[index];
+    if (!isFileBased()) {
+        return std::vector<Base::Vector3f>(points.begin() + node.first,
+                                           points.begin() + node.first + node.count);
+    }
+
+    QMutexLocker locker(&mutex);
+    return loadTile(index);
+}
+
+void PointsOctree::getPoints(const Base::BoundBox3f& box, float spacing, std::vector<Base::Vector3f>& result) const
+{
+    if (nodes.empty())
+        return;
+
+    QMutexLocker locker(&mutex);
+    std::vector<int32_t> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = nodes[stack.back()];
+        unsigned long index = stack.back();
+        stack.pop_back();
+        if (!node.box.Intersect(box))
+            continue;
+
+        const Base::Vector3f* begin;
+        if (isFileBased())
+            begin = loadTile(index).data();
+        else
+            begin = points.data() + node.first;
+
+        // the whole node is inside so the points needn't to be checked
+        if (box.IsInBox(node.box)) {
+            result.insert(result.end(), begin, begin + node.count);
+        }
+        else {
+            for (uint32_t i = 0; i < node.count; i++) {
+                if (box.IsInBox(begin[i]))
+                    result.push_back(begin[i]);
+            }
+        }
+
+        // the children are only needed if the node is not dense enough
+        if (node.spacing > spacing) {
+            for (int i = 7; i >= 0; i--) {
+                if (node.children[i] >= 0)
+                    stack.push_back(node.children[i]);
+            }
+        }
+    }
+}
+
+float PointsOctree::getPointsByBudget(const Base::BoundBox3f& box, unsigned long maxPoints,
+                                      std::vector<Base::Vector3f>& result) const
+{
+    if (nodes.empty())
+        return 0.0f;
+
+    // take the nodes with the coarsest spacing first
+    typedef std::pair<float, int32_t> Entry;
+    std::priority_queue<Entry> queue;
+    queue.push(Entry(nodes.front().spacing, 0));
+
+    float spacing = nodes.front().spacing;
+    unsigned long count = 0;
+    std::vector<unsigned long> selected;
+    while (!queue.empty()) {
+        const Node& node = nodes[queue.top().second];
+        unsigned long index = queue.top().second;
+        queue.pop();
+        if (!node.box.Intersect(box))
+            continue;
+        if (count + node.count > maxPoints)
+            break;
+
+        count += node.count;
+        spacing = node.spacing;
+        selected.push_back(index);
+        for (int i = 0; i < 8; i++) {
+            if (node.children[i] >= 0)
+                queue.push(Entry(nodes[node.children[i]].spacing, node.children[i]));
+        }
+    }
+
+    QMutexLocker locker(&mutex);
+    result.reserve(result.size() + count);
+    for (unsigned long index : selected) {
+        const Node& node = nodes[index];
+        const Base::Vector3f* begin;
+        if (isFileBased())
+            begin = loadTile(index).data();
+        else
+            begin = points.data() + node.first;
+        for (uint32_t i = 0; i < node.count; i++) {
+            if (box.IsInBox(begin[i]))
+                result.push_back(begin[i]);
+        }
+    }
+
+    return spacing;
+}
+
+void PointsOctree::getPoints(const Base::BoundBox3f& box, float spacing, PointKernel& kernel) const
+{
+    std::vector<Base::Vector3f> result;
+    getPoints(box, spacing, result);
+    kernel.setTransform(Base::Matrix4D());
+    kernel.getBasicPoints().swap(result);
+}
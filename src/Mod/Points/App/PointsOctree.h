@@ -0,0 +1,160 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#ifndef POINTS_OCTREE_H
+#define POINTS_OCTREE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QMutex>
+
+#include "Points.h"
+#include <Base/Vector3D.h>
+#include <Base/BoundBox.h>
+
+#define  POINTS_OCTREE_NODE_SIZE  16384   // Default value for the number of points per node
+#define  POINTS_OCTREE_MAX_DEPTH  20      // Default value for the maximum depth of the tree
+#define  POINTS_OCTREE_CACHE_SIZE 8388608 // Default value for the number of points kept in memory
+
+namespace Base {
+class ifstream;
+}
+
+namespace Points {
+
+/**
+ * The PointsOctree stores a point cloud as tiles of an octree. Every node owns a random sample
+ * of the points of its region, its children refine the sample. So the coarse nodes near the root
+ * give a uniform overview of the whole cloud and the detail is in the deeper nodes.
+ *
+ * The tree can be saved to a file and opened again. An opened tree only reads the node table,
+ * the points of a node are read the first time they are needed and are kept in a cache of
+ * limited size. This way clouds that don't fit into memory can be displayed and processed
+ * region by region.
+ *
+ * Existing algorithms work on a PointKernel, so the query results can be copied into one.
+ */
+class PointsExport PointsOctree
+{
+public:
+    struct Node {
+        /// Bounding box of all points of the node and its children
+        Base::BoundBox3f box;
+        /// Average distance of the points owned by the node
+        float spacing;
+        /// First point of the node in the tile storage
+        uint64_t first;
+        /// Number of points owned by the node
+        uint32_t count;
+        /// Index of the children or -1
+        int32_t children[8];
+        /// Depth of the node, the root has level 0
+        uint32_t level;
+    };
+
+    /** @name Construction */
+    //@{
+    PointsOctree();
+    ~PointsOctree();
+    //@}
+
+    /** Builds the tree of the transformed points of the kernel. Invalid points are skipped.
+     * Each node owns at most \a maxPointsPerNode points.
+     */
+    void build(const PointKernel& kernel, unsigned long maxPointsPerNode = POINTS_OCTREE_NODE_SIZE);
+    /** Builds the tree of the points as they are. Invalid points are skipped. */
+    void build(const std::vector<Base::Vector3f>& points, unsigned long maxPointsPerNode = POINTS_OCTREE_NODE_SIZE);
+    /** Writes the tree to \a file. If the tree itself is file-based all tiles are read once. */
+    bool save(const char* file) const;
+    /** Reads the node table of \a file. The points are read on demand. */
+    bool open(const char* file);
+    /** Removes all nodes and points and closes an opened file. */
+    void clear();
+    /** Sets the maximum number of points of a file-based tree that are kept in memory. */
+    void setCacheSize(unsigned long points);
+
+    /** @name Information */
+    //@{
+    bool isEmpty() const
+    { return nodes.empty(); }
+    /** Returns true if the points are read on demand from a file. */
+    bool isFileBased() const
+    { return file.get() != nullptr; }
+    uint64_t countPoints() const
+    { return numPoints; }
+    unsigned long countNodes() const
+    { return static_cast<unsigned long>(nodes.size()); }
+    const Node& getNode(unsigned long index) const
+    { return nodes[index]; }
+    Base::BoundBox3f getBoundBox() const;
+    /** Returns the index of the source point of every stored point. The points of a node
+     * start at Node::first. The list is empty for a file-based tree.
+     */
+    const std::vector<std::size_t>& getPointIndices() const
+    { return pointIndices; }
+    //@}
+
+    /** @name Level of detail */
+    //@{
+    /** Returns the points owned by the node \a index. */
+    std::vector<Base::Vector3f> getNodePoints(unsigned long index) const;
+    /** Returns the points inside \a box with an average distance of about \a spacing.
+     * A spacing of zero returns all points inside the box.
+     */
+    void getPoints(const Base::BoundBox3f& box, float spacing, std::vector<Base::Vector3f>& points) const;
+    /** Returns at most \a maxPoints points inside \a box. The coarse nodes are taken first so that
+     * the result is spread evenly over the box. The reached spacing is returned.
+     */
+    float getPointsByBudget(const Base::BoundBox3f& box, unsigned long maxPoints, std::vector<Base::Vector3f>& points) const;
+    /** Same as above but copies the points into \a kernel to pass them to the existing algorithms. */
+    void getPoints(const Base::BoundBox3f& box, float spacing, PointKernel& kernel) const;
+    //@}
+
+private:
+    int32_t buildNode(const std::vector<Base::Vector3f>& source, std::vector<std::size_t>& indices,
+                      std::vector<std::size_t>& buffer, std::size_t begin, std::size_t end,
+                      const Base::BoundBox3f& cube, uint32_t level, unsigned long maxPointsPerNode);
+    const std::vector<Base::Vector3f>& loadTile(unsigned long index) const;
+
+private:
+    std::vector<Node> nodes;
+    /// Points of all nodes if the tree is kept in memory
+    std::vector<Base::Vector3f> points;
+    /// Indices of the source points if the tree is built in memory
+    std::vector<std::size_t> pointIndices;
+    uint64_t numPoints;
+
+    /// Tile cache of a file-based tree
+    std::unique_ptr<Base::ifstream> file;
+    std::string fileName;
+    uint64_t dataOffset;
+    unsigned long cacheSize;
+    mutable unsigned long cachedPoints;
+    mutable std::map<unsigned long, std::vector<Base::Vector3f> > tiles;
+    mutable QMutex mutex;
+};
+
+} // namespace Points
+
+#endif // POINTS_OCTREE_H
@@ -24,6 +24,7 @@
 #include "PreCompiled.h"
 
 #include "Mod/Points/App/Points.h"
+#include "Mod/Points/App/PointsNormals.h"
 #include <Base/Builder3D.h>
 #include <Base/VectorPy.h>
 #include <Base/GeometryPyCXX.h>
@@ -145,6 +146,18 @@ PyObject* PointsPy::addPoints(PyObject * args)
     if (!PyArg_ParseTuple(args, "O", &obj))
         return 0;
 
+    // arrays of shape (n,3) are read in bulk through the buffer protocol
+    if (PyObject_CheckBuffer(obj)) {
+        std::vector<Base::Vector3d> points;
+        if (!Data::ComplexGeoDataPy::readPointArray(obj, points))
+            return 0;
+        PointKernel* kernel = getPointKernelPtr();
+        kernel->reserve(kernel->size() + points.size());
+        for (std::vector<Base::Vector3d>::const_iterator it = points.begin(); it != points.end(); ++it)
+            kernel->push_back(*it);
+        Py_Return;
+    }
+
     try {
         Py::Sequence list(obj);
         union PyType_Object pyType = {&(Base::VectorPy::Type)};
@@ -227,6 +240,48 @@ PyObject* PointsPy::fromValid(PyObject * args)
     }
 }
 
+PyObject* PointsPy::estimateNormals(PyObject *args, PyObject *kwds)
+{
+    int ksearch = 0;
+    double radius = 0;
+    char* orientation = "Viewpoint";
+    PyObject* viewpoint = 0;
+    static char* keywords_normals[] = {"KSearch","SearchRadius","Orientation","Viewpoint",NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|idsO!", keywords_normals,
+                                     &ksearch, &radius, &orientation,
+                                     &(Base::VectorPy::Type), &viewpoint))
+        return 0;
+
+    NormalEstimation::Orientation mode;
+    if (strcmp(orientation, "None") == 0)
+        mode = NormalEstimation::None;
+    else if (strcmp(orientation, "Viewpoint") == 0)
+        mode = NormalEstimation::Viewpoint;
+    else if (strcmp(orientation, "Propagate") == 0)
+        mode = NormalEstimation::Propagate;
+    else {
+        PyErr_SetString(PyExc_ValueError, "Orientation must be 'None', 'Viewpoint' or 'Propagate'");
+        return 0;
+    }
+
+    PY_TRY {
+        NormalEstimation estimate(*getPointKernelPtr());
+        estimate.setKSearch(ksearch);
+        estimate.setSearchRadius(radius);
+        estimate.setOrientation(mode);
+        if (viewpoint)
+            estimate.setViewpoint(*static_cast<Base::VectorPy*>(viewpoint)->getVectorPtr());
+
+        std::vector<Base::Vector3d> normals;
+        estimate.perform(normals);
+
+        Py::List list;
+        for (std::vector<Base::Vector3d>::iterator it = normals.begin(); it != normals.end(); ++it)
+            list.append(Py::Vector(*it));
+        return Py::new_reference_to(list);
+    } PY_CATCH;
+}
+
 Py::Long PointsPy::getCountPoints(void) const
 {
     return Py::Long((long)getPointKernelPtr()->size());
@@ -88,6 +88,13 @@ void PropertyGreyValueList::setValues(const std::vector<float>& values)
     hasSetValue();
 }
 
+void PropertyGreyValueList::setValues(std::vector<float>&& values)
+{
+    aboutToSetValue();
+    _lValueList = std::move(values);
+    hasSetValue();
+}
+
 PyObject *PropertyGreyValueList::getPyObject(void)
 {
     PyObject* list = PyList_New(getSize());
@@ -266,6 +273,13 @@ void PropertyNormalList::setValues(const std::vector<Base::Vector3f>& values)
     hasSetValue();
 }
 
+void PropertyNormalList::setValues(std::vector<Base::Vector3f>&& values)
+{
+    aboutToSetValue();
+    _lValueList = std::move(values);
+    hasSetValue();
+}
+
 PyObject *PropertyNormalList::getPyObject(void)
 {
     PyObject* list = PyList_New(getSize());
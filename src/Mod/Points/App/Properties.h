@@ -79,6 +79,8 @@ public:
         _lValueList[idx] = value;
     }
     void setValues (const std::vector<float>& values);
+    /// Takes over the values without copying them
+    void setValues (std::vector<float>&& values);
     
     const std::vector<float> &getValues(void) const {
         return _lValueList;
@@ -129,6 +131,8 @@ public:
     }
 
     void setValues (const std::vector<Base::Vector3f>& values);
+    /// Takes over the values without copying them
+    void setValues (std::vector<Base::Vector3f>&& values);
 
     const std::vector<Base::Vector3f> &getValues(void) const {
         return _lValueList;
@@ -58,6 +58,13 @@ void PropertyPointKernel::setValue(const PointKernel& m)
     hasSetValue();
 }
 
+void PropertyPointKernel::swapPoints(PointKernel& m)
+{
+    aboutToSetValue();
+    _cPoints->swap(m);
+    hasSetValue();
+}
+
 const PointKernel& PropertyPointKernel::getValue(void) const 
 {
     return *_cPoints;
@@ -149,7 +156,7 @@ void PropertyPointKernel::Paste(const App::Property &from)
 
 unsigned int PropertyPointKernel::getMemSize (void) const
 {
-    return sizeof(Base::Vector3f) * this->_cPoints->size();
+    return _cPoints->getMemSize();
 }
 
 PointKernel* PropertyPointKernel::startEditing()
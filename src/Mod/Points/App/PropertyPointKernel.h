@@ -43,6 +43,8 @@ public:
     //@{
     /// Sets the points to the property
     void setValue( const PointKernel& m);
+    /// Swaps the points with the property to avoid a copy
+    void swapPoints(PointKernel& m);
     /// get the points (only const possible!)
     const PointKernel &getValue(void) const;
     const Data::ComplexGeoData* getComplexData() const;
@@ -28,6 +28,7 @@
 #include <CXX/Extensions.hxx>
 #include <CXX/Objects.hxx>
 
+#include "SoFCPointSet.h"
 #include "ViewProvider.h"
 #include "Workbench.h"
 
@@ -92,6 +93,8 @@ PyMOD_INIT_FUNC(PointsGui)
     // instantiating the commands
     CreatePointsCommands();
 
+    PointsGui::SoFCPointSet             ::initClass();
+    PointsGui::SoFCIndexedPointSet      ::initClass();
     PointsGui::ViewProviderPoints       ::init();
     PointsGui::ViewProviderScattered    ::init();
     PointsGui::ViewProviderStructured   ::init();
@@ -77,7 +77,7 @@ void CmdPointsImport::activated(int iMsg)
     Q_UNUSED(iMsg);
 
     QString fn = Gui::FileDialog::getOpenFileName(Gui::getMainWindow(),
-      QString(), QString(), QString::fromLatin1("%1 (*.asc *.pcd *.ply);;%2 (*.*)")
+      QString(), QString(), QString::fromLatin1("%1 (*.asc *.pcd *.ply *.las);;%2 (*.*)")
       .arg(QObject::tr("Point formats"), QObject::tr("All Files")));
     if (fn.isEmpty())
         return;
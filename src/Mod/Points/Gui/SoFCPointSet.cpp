@@ -0,0 +1,325 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <queue>
+# ifdef FC_OS_WIN32
+# include <windows.h>
+# endif
+# ifdef FC_OS_MACOSX
+# include <OpenGL/gl.h>
+# else
+# include <GL/gl.h>
+# endif
+# include <Inventor/SbBox3f.h>
+# include <Inventor/SbViewVolume.h>
+# include <Inventor/actions/SoGLRenderAction.h>
+# include <Inventor/bundles/SoMaterialBundle.h>
+# include <Inventor/elements/SoCacheElement.h>
+# include <Inventor/elements/SoCoordinateElement.h>
+# include <Inventor/elements/SoGLLazyElement.h>
+# include <Inventor/elements/SoMaterialBindingElement.h>
+# include <Inventor/elements/SoModelMatrixElement.h>
+# include <Inventor/elements/SoNormalElement.h>
+# include <Inventor/elements/SoViewportRegionElement.h>
+# include <Inventor/elements/SoViewVolumeElement.h>
+# include <Inventor/misc/SoState.h>
+# include <Inventor/sensors/SoAlarmSensor.h>
+#endif
+
+#include <QtConcurrentRun>
+
+#include "SoFCPointSet.h"
+#include <Gui/SoFCInteractiveElement.h>
+#include <Mod/Points/App/PointsOctree.h>
+
+using namespace PointsGui;
+
+namespace {
+// the budget is doubled at most this often while the camera doesn't move
+const int maxRefineLevel = 4;
+}
+
+PointCloudLevelOfDetail::PointCloudLevelOfDetail(SoNode* owner)
+  : pointLimit(2000000)
+  , pointBudget(1000000)
+  , owner(owner)
+  , sensor(new SoAlarmSensor(redrawCB, this))
+  , nodeId(0)
+  , numPoints(0)
+  , lastBudget(0)
+  , truncated(false)
+  , refineLevel(0)
+{
+}
+
+PointCloudLevelOfDetail::~PointCloudLevelOfDetail()
+{
+    delete sensor;
+    future.waitForFinished();
+}
+
+void PointCloudLevelOfDetail::redrawCB(void* data, SoSensor*)
+{
+    PointCloudLevelOfDetail* self = static_cast<PointCloudLevelOfDetail*>(data);
+    self->owner->touch();
+}
+
+void PointCloudLevelOfDetail::scheduleRedraw(double seconds)
+{
+    if (!sensor->isScheduled()) {
+        sensor->setTimeFromNow(SbTime(seconds));
+        sensor->schedule();
+    }
+}
+
+bool PointCloudLevelOfDetail::prepare(SoState* state)
+{
+    const SoCoordinateElement* coords = SoCoordinateElement::getInstance(state);
+    int num = coords->getNum();
+    if (num <= static_cast<int>(pointLimit) || !coords->is3D())
+        return false;
+
+    // the coordinates have changed, so build a new octree in the background
+    if (coords->getNodeId() != nodeId || num != numPoints) {
+        nodeId = coords->getNodeId();
+        numPoints = num;
+        future.waitForFinished();
+        octree.reset();
+        indices.clear();
+        lastBudget = 0;
+
+        const SbVec3f* pts = coords->getArrayPtr3();
+        std::shared_ptr<std::vector<Base::Vector3f> > points(new std::vector<Base::Vector3f>(num));
+        std::vector<Base::Vector3f>& data = *points;
+        for (int i = 0; i < num; i++)
+            data[i].Set(pts[i][0], pts[i][1], pts[i][2]);
+
+        std::shared_ptr<Points::PointsOctree> tree(new Points::PointsOctree());
+        pending = tree;
+        future = QtConcurrent::run([tree, points]() {
+            tree->build(*points);
+        });
+    }
+
+    if (pending) {
+        if (!future.isFinished()) {
+            // check again later and render the complete cloud meanwhile
+            scheduleRedraw(0.25);
+            return false;
+        }
+        octree = pending;
+        pending.reset();
+    }
+
+    return octree && !octree->isEmpty() &&
+           octree->getPointIndices().size() <= static_cast<std::size_t>(num);
+}
+
+/**
+ * Takes the visible nodes with the coarsest spacing on the screen first until \a budget points
+ * are selected. Nodes whose points are denser than a pixel are not refined any further.
+ */
+void PointCloudLevelOfDetail::select(SoState* state, unsigned long budget)
+{
+    const SbViewportRegion& vp = SoViewportRegionElement::get(state);
+    const SbViewVolume& vv = SoViewVolumeElement::get(state);
+    const SbMatrix& model = SoModelMatrixElement::get(state);
+    float height = std::max<float>(vp.getViewportSizePixels()[1], 1.0f);
+
+    auto screenSpacing = [&](const Points::PointsOctree::Node& node) {
+        Base::Vector3f c = node.box.GetCenter();
+        SbVec3f center(c.x, c.y, c.z);
+        model.multVecMatrix(center, center);
+        float pixelSize = vv.getWorldToScreenScale(center, 1.0f / height);
+        return pixelSize > 0.0f ? node.spacing / pixelSize : 0.0f;
+    };
+    auto isVisible = [&](const Points::PointsOctree::Node& node) {
+        SbBox3f box(node.box.MinX, node.box.MinY, node.box.MinZ,
+                    node.box.MaxX, node.box.MaxY, node.box.MaxZ);
+        box.transform(model);
+        return vv.intersect(box) ? true : false;
+    };
+
+    indices.clear();
+    truncated = false;
+
+    typedef std::pair<float, int32_t> Entry;
+    std::priority_queue<Entry> queue;
+    const Points::PointsOctree::Node& root = octree->getNode(0);
+    if (isVisible(root))
+        queue.push(Entry(screenSpacing(root), 0));
+
+    const std::vector<std::size_t>& order = octree->getPointIndices();
+    while (!queue.empty()) {
+        Entry entry = queue.top();
+        queue.pop();
+        const Points::PointsOctree::Node& node = octree->getNode(entry.second);
+        if (indices.size() + node.count > budget) {
+            truncated = true;
+            break;
+        }
+
+        for (uint64_t i = node.first; i < node.first + node.count; i++)
+            indices.push_back(static_cast<uint32_t>(order[i]));
+
+        // dense enough on the screen
+        if (entry.first <= 1.0f)
+            continue;
+
+        for (int i = 0; i < 8; i++) {
+            if (node.children[i] >= 0) {
+                const Points::PointsOctree::Node& child = octree->getNode(node.children[i]);
+                if (isVisible(child))
+                    queue.push(Entry(screenSpacing(child), node.children[i]));
+            }
+        }
+    }
+}
+
+void PointCloudLevelOfDetail::render(SoGLRenderAction* action)
+{
+    SoState* state = action->getState();
+    // the selection depends on the camera, so it must not end up in a render cache
+    SoCacheElement::invalidate(state);
+
+    // every camera change starts again with the plain budget
+    SbMatrix matrix = SoModelMatrixElement::get(state);
+    matrix.multRight(SoViewVolumeElement::get(state).getMatrix());
+    SbBool interactive = Gui::SoFCInteractiveElement::get(state);
+    if (interactive || matrix != lastMatrix)
+        refineLevel = 0;
+
+    unsigned long budget = pointBudget << refineLevel;
+    if (budget != lastBudget || matrix != lastMatrix) {
+        select(state, budget);
+        lastBudget = budget;
+        lastMatrix = matrix;
+    }
+
+    // refine while the camera doesn't move
+    if (!interactive && truncated && refineLevel < maxRefineLevel) {
+        refineLevel++;
+        scheduleRedraw(0.05);
+    }
+
+    if (indices.empty())
+        return;
+
+    const SoCoordinateElement* coords = SoCoordinateElement::getInstance(state);
+    int num = coords->getNum();
+
+    SoMaterialBindingElement::Binding mbind = SoMaterialBindingElement::get(state);
+    const SoLazyElement* lazy = SoLazyElement::getInstance(state);
+    bool perVertex = (mbind == SoMaterialBindingElement::PER_VERTEX ||
+                      mbind == SoMaterialBindingElement::PER_VERTEX_INDEXED) &&
+                      lazy->getNumDiffuse() >= num;
+
+    SoMaterialBundle mb(action);
+    const SoNormalElement* normal = SoNormalElement::getInstance(state);
+    bool needNormals = !mb.isColorOnly() && normal->getNum() >= num;
+
+    // like SoPointSet the points are not lit without normals
+    state->push();
+    if (!needNormals)
+        SoLazyElement::setLightModel(state, SoLazyElement::BASE_COLOR);
+    mb.sendFirst();
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, coords->getArrayPtr3());
+    if (perVertex) {
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(3, GL_FLOAT, 0, lazy->getDiffusePointer());
+    }
+    if (needNormals) {
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glNormalPointer(GL_FLOAT, 0, normal->getArrayPtr());
+    }
+
+    glDrawElements(GL_POINTS, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, &indices[0]);
+
+    if (needNormals)
+        glDisableClientState(GL_NORMAL_ARRAY);
+    if (perVertex) {
+        glDisableClientState(GL_COLOR_ARRAY);
+        // the current color has been changed behind the back of Coin
+        SoGLLazyElement::getInstance(state)->reset(state, SoLazyElement::DIFFUSE_MASK);
+    }
+    glDisableClientState(GL_VERTEX_ARRAY);
+    state->pop();
+}
+
+// ----------------------------------------------------------------------------
+
+SO_NODE_SOURCE(SoFCPointSet)
+
+void SoFCPointSet::initClass()
+{
+    SO_NODE_INIT_CLASS(SoFCPointSet, SoPointSet, "PointSet");
+}
+
+SoFCPointSet::SoFCPointSet()
+  : lod(this)
+{
+    SO_NODE_CONSTRUCTOR(SoFCPointSet);
+}
+
+SoFCPointSet::~SoFCPointSet()
+{
+}
+
+void SoFCPointSet::GLRender(SoGLRenderAction *action)
+{
+    if (!lod.prepare(action->getState()))
+        inherited::GLRender(action);
+    else if (shouldGLRender(action))
+        lod.render(action);
+}
+
+// ----------------------------------------------------------------------------
+
+SO_NODE_SOURCE(SoFCIndexedPointSet)
+
+void SoFCIndexedPointSet::initClass()
+{
+    SO_NODE_INIT_CLASS(SoFCIndexedPointSet, SoIndexedPointSet, "IndexedPointSet");
+}
+
+SoFCIndexedPointSet::SoFCIndexedPointSet()
+  : lod(this)
+{
+    SO_NODE_CONSTRUCTOR(SoFCIndexedPointSet);
+}
+
+SoFCIndexedPointSet::~SoFCIndexedPointSet()
+{
+}
+
+void SoFCIndexedPointSet::GLRender(SoGLRenderAction *action)
+{
+    if (!lod.prepare(action->getState()))
+        inherited::GLRender(action);
+    else if (shouldGLRender(action))
+        lod.render(action);
+}
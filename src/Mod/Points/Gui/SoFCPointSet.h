@@ -0,0 +1,129 @@
+/****************************************************************************
+ *   This file is part of the FreeCAD CAx development system.               *
+ *                                                                          *
+ *   This library is free software; you can redistribute it and/or          *
+ *   modify it under the terms of the GNU Library General Public            *
+ *   License as published by the Free Software Foundation; either           *
+ *   version 2 of the License, or (at your option) any later version.       *
+ *                                                                          *
+ *   This library  is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of         *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ *   GNU Library General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU Library General Public      *
+ *   License along with this library; see the file COPYING.LIB. If not,     *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,          *
+ *   Suite 330, Boston, MA  02111-1307, USA                                 *
+ *                                                                          *
+ ****************************************************************************/
+
+
+#ifndef POINTSGUI_SOFCPOINTSET_H
+#define POINTSGUI_SOFCPOINTSET_H
+
+#include <memory>
+#include <vector>
+#include <QFuture>
+#include <Inventor/SbMatrix.h>
+#include <Inventor/nodes/SoPointSet.h>
+#include <Inventor/nodes/SoIndexedPointSet.h>
+
+class SoAlarmSensor;
+class SoSensor;
+class SoState;
+
+namespace Points {
+class PointsOctree;
+}
+
+namespace PointsGui {
+
+/**
+ * The PointCloudLevelOfDetail class renders a subset of a large point cloud. An octree of the
+ * points of the current coordinate element is built in the background. Each frame the visible
+ * nodes are taken in the order of their point spacing on the screen until the point budget or
+ * a spacing of one pixel is reached. While the camera doesn't move the budget is raised step
+ * by step so that the detail fills in over the next frames.
+ */
+class PointsGuiExport PointCloudLevelOfDetail
+{
+public:
+    PointCloudLevelOfDetail(SoNode* owner);
+    ~PointCloudLevelOfDetail();
+
+    /** Returns true if the points of the current coordinate element are rendered by this class.
+     * If needed it starts building the octree.
+     */
+    bool prepare(SoState* state);
+    /** Renders the selected points. */
+    void render(SoGLRenderAction* action);
+
+    /// Clouds with up to this number of points are rendered completely by the shape
+    unsigned long pointLimit;
+    /// Number of points drawn per frame while interacting
+    unsigned long pointBudget;
+
+private:
+    void select(SoState* state, unsigned long budget);
+    void scheduleRedraw(double seconds);
+    static void redrawCB(void* data, SoSensor*);
+
+private:
+    SoNode* owner;
+    SoAlarmSensor* sensor;
+    QFuture<void> future;
+    std::shared_ptr<Points::PointsOctree> pending;
+    std::shared_ptr<Points::PointsOctree> octree;
+    SbUniqueId nodeId;
+    int numPoints;
+    /// Points selected from the last frame
+    std::vector<uint32_t> indices;
+    SbMatrix lastMatrix;
+    unsigned long lastBudget;
+    bool truncated;
+    int refineLevel;
+};
+
+/**
+ * A point set that renders large clouds with a level of detail.
+ */
+class PointsGuiExport SoFCPointSet : public SoPointSet {
+    typedef SoPointSet inherited;
+
+    SO_NODE_HEADER(SoFCPointSet);
+
+public:
+    static void initClass();
+    SoFCPointSet();
+
+    PointCloudLevelOfDetail lod;
+
+protected:
+    virtual ~SoFCPointSet();
+    virtual void GLRender(SoGLRenderAction *action);
+};
+
+/**
+ * An indexed point set that renders large clouds with a level of detail. The octree
+ * skips invalid points like the coordinate indices do.
+ */
+class PointsGuiExport SoFCIndexedPointSet : public SoIndexedPointSet {
+    typedef SoIndexedPointSet inherited;
+
+    SO_NODE_HEADER(SoFCIndexedPointSet);
+
+public:
+    static void initClass();
+    SoFCIndexedPointSet();
+
+    PointCloudLevelOfDetail lod;
+
+protected:
+    virtual ~SoFCIndexedPointSet();
+    virtual void GLRender(SoGLRenderAction *action);
+};
+
+} // namespace PointsGui
+
+#endif // POINTSGUI_SOFCPOINTSET_H
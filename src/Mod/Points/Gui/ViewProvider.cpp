@@ -57,6 +57,7 @@
 #include <Gui/View3DInventorViewer.h>
 #include <Mod/Points/App/PointsFeature.h>
 
+#include "SoFCPointSet.h"
 #include "ViewProvider.h"
 #include "../App/Properties.h"
 
@@ -356,7 +357,8 @@ PROPERTY_SOURCE(PointsGui::ViewProviderScattered, PointsGui::ViewProviderPoints)
 
 ViewProviderScattered::ViewProviderScattered()
 {
-    pcPoints = new SoPointSet();
+    // large clouds are rendered with a level of detail
+    pcPoints = new SoFCPointSet();
     pcPoints->ref();
 }
 
@@ -517,7 +519,8 @@ PROPERTY_SOURCE(PointsGui::ViewProviderStructured, PointsGui::ViewProviderPoints
 
 ViewProviderStructured::ViewProviderStructured()
 {
-    pcPoints = new SoIndexedPointSet();
+    // large clouds are rendered with a level of detail
+    pcPoints = new SoFCIndexedPointSet();
     pcPoints->ref();
 }
 
@@ -29,4 +29,5 @@
 
 # Append the open handler
 FreeCAD.addImportType("Point formats (*.asc *.pcd *.ply)","Points")
+FreeCAD.addImportType("LAS point clouds (*.las)","Points")
 FreeCAD.addExportType("Point formats (*.asc *.pcd *.ply)","Points")
@@ -32,6 +32,7 @@
 # include <TopoDS.hxx>
 # include <TopoDS_Face.hxx>
 # include <sstream>
+# include <vector>
 #endif
 
 #include <Base/Console.h>
@@ -39,6 +40,7 @@
 #include <Base/Sequencer.h>
 #include <Base/Matrix.h>
 #include <App/ComplexGeoData.h>
+#include <Mod/Part/App/Tools.h>
 #include <boost/regex.hpp>
 
 
@@ -71,12 +73,27 @@ void LuxTools::writeShape(std::ostream &out, const char *PartName, const TopoDS_
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
     TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation,/*isRelative*/ Standard_False,
+                                  /*theAngDeflection*/ 0.5,/*isInParallel*/ true);
 
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
+    // the output stops at the first face without a triangulation, the vertex
+    // offsets of the other faces are known in advance
+    std::vector<TopoDS_Face> faces;
+    std::vector<int> offsets;
+    int vi = 0;
+    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next()) {
+        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
+        TopLoc_Location aLoc;
+        Handle(Poly_Triangulation) aPoly = BRep_Tool::Triangulation(aFace,aLoc);
+        if (aPoly.IsNull())
+            break;
+        faces.push_back(aFace);
+        offsets.push_back(vi);
+        vi = vi + aPoly->NbNodes();
+    }
+
+    // start sequencer
+    Base::SequencerLauncher seq("Writing file", faces.size() + 1);
     
     // write object
     out << "AttributeBegin #  \"" << PartName << "\"" << endl;
@@ -84,26 +101,27 @@ void LuxTools::writeShape(std::ostream &out, const char *PartName, const TopoDS_
     out << "NamedMaterial \"FreeCADMaterial_" << PartName << "\"" << endl;
     out << "Shape \"mesh\"" << endl;
     
-    // gather vertices, normals and face indices
-    std::stringstream triindices;
-    std::stringstream N;
-    std::stringstream P;
-    l = 1;
-    int vi = 0;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
-
+    // gather vertices, normals and face indices of all faces in parallel
+    struct FaceData {
+        std::string triindices;
+        std::string N;
+        std::string P;
+    };
+    std::vector<FaceData> data(faces.size());
+    Part::Tools::parallelFor(faces.size(), [&](std::size_t index) {
         // this block mesh the face and transfers it in a C array of vertices and face indexes
         Standard_Integer nbNodesInFace,nbTriInFace;
         gp_Vec* vertices=0;
         gp_Vec* vertexnormals=0;
         long* cons=0;
 
-        PovTools::transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
+        PovTools::transferToArray(faces[index],&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
 
-        if (!vertices) break;
+        if (!vertices) return;
+        int vi = offsets[index];
+        std::stringstream triindices;
+        std::stringstream N;
+        std::stringstream P;
         // writing vertices
         for (int i=0; i < nbNodesInFace; i++) {
             P << vertices[i].X() << " " << vertices[i].Y() << " " << vertices[i].Z() << " ";
@@ -118,21 +136,32 @@ void LuxTools::writeShape(std::ostream &out, const char *PartName, const TopoDS_
         for (int k=0; k < nbTriInFace; k++) {
             triindices << cons[3*k]+vi << " " << cons[3*k+2]+vi << " " << cons[3*k+1]+vi << " ";
         }
-        
-        vi = vi + nbNodesInFace;
-        
+
         delete [] vertexnormals;
         delete [] vertices;
         delete [] cons;
 
-        seq.next();
-
-    } // end of face loop
+        data[index].triindices = triindices.str();
+        data[index].N = N.str();
+        data[index].P = P.str();
+    });
+    seq.next();
 
     // write mesh data
-    out << "    \"integer triindices\" [" << triindices.str() << "]" << endl;
-    out << "    \"point P\" [" << P.str() << "]" << endl;
-    out << "    \"normal N\" [" << N.str() << "]" << endl;
+    out << "    \"integer triindices\" [";
+    for (const auto& it : data)
+        out << it.triindices;
+    out << "]" << endl;
+    out << "    \"point P\" [";
+    for (const auto& it : data)
+        out << it.P;
+    out << "]" << endl;
+    out << "    \"normal N\" [";
+    for (const auto& it : data) {
+        out << it.N;
+        seq.next();
+    }
+    out << "]" << endl;
     out << "    \"bool generatetangents\" [\"false\"]" << endl;
     out << "    \"string name\" [\"" << PartName << "\"]" << endl;
     out << "AttributeEnd # \"\"" << endl;
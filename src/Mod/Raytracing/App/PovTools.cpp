@@ -32,12 +32,14 @@
 # include <TopoDS.hxx>
 # include <TopoDS_Face.hxx>
 # include <sstream>
+# include <vector>
 #endif
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Sequencer.h>
 #include <App/ComplexGeoData.h>
+#include <Mod/Part/App/Tools.h>
 
 
 #include "PovTools.h"
@@ -226,77 +228,92 @@ void PovTools::writeShape(std::ostream &out, const char *PartName,
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
     TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation,/*isRelative*/ Standard_False,
+                                  /*theAngDeflection*/ 0.5,/*isInParallel*/ true);
 
+    std::vector<TopoDS_Face> faces;
+    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next())
+        faces.push_back(TopoDS::Face(ex.Current()));
 
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
-
-    // write the file
-    out <<  "// Written by FreeCAD http://www.freecadweb.org/" << endl;
-    l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
+    // The faces are formatted in parallel into buffers that use the format of the output stream
+    std::ostringstream format;
+    format.copyfmt(out);
+    std::vector<std::string> buffers(faces.size());
+    std::vector<char> meshed(faces.size(), 0);
 
+    Part::Tools::parallelFor(faces.size(), [&](std::size_t index) {
         // this block mesh the face and transfers it in a C array of vertices and face indexes
         Standard_Integer nbNodesInFace,nbTriInFace;
         gp_Vec* vertices=0;
         gp_Vec* vertexnormals=0;
         long* cons=0;
 
-        transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
+        transferToArray(faces[index],&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
 
-        if (!vertices) break;
+        if (!vertices) return;
+        std::size_t l = index + 1;
+        std::ostringstream str;
+        str.copyfmt(format);
         // writing per face header
-        out << "// face number" << l << " +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
-        << "#declare " << PartName << l << " = mesh2{" << endl
-        << "  vertex_vectors {" << endl
-        << "    " << nbNodesInFace << "," << endl;
+        str << "// face number" << l << " +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << '\n'
+        << "#declare " << PartName << l << " = mesh2{" << '\n'
+        << "  vertex_vectors {" << '\n'
+        << "    " << nbNodesInFace << "," << '\n';
         // writing vertices
         for (int i=0; i < nbNodesInFace; i++) {
-            out << "    <" << vertices[i].X() << ","
+            str << "    <" << vertices[i].X() << ","
             << vertices[i].Z() << ","
             << vertices[i].Y() << ">,"
-            << endl;
+            << '\n';
         }
-        out << "  }" << endl
+        str << "  }" << '\n'
         // writing per vertex normals
-        << "  normal_vectors {" << endl
-        << "    " << nbNodesInFace << "," << endl;
+        << "  normal_vectors {" << '\n'
+        << "    " << nbNodesInFace << "," << '\n';
         for (int j=0; j < nbNodesInFace; j++) {
-            out << "    <" << vertexnormals[j].X() << ","
+            str << "    <" << vertexnormals[j].X() << ","
             << vertexnormals[j].Z() << ","
             << vertexnormals[j].Y() << ">,"
-            << endl;
+            << '\n';
         }
 
-        out << "  }" << endl
+        str << "  }" << '\n'
         // writing triangle indices
-        << "  face_indices {" << endl
-        << "    " << nbTriInFace << "," << endl;
+        << "  face_indices {" << '\n'
+        << "    " << nbTriInFace << "," << '\n';
         for (int k=0; k < nbTriInFace; k++) {
-            out << "    <" << cons[3*k] << ","<< cons[3*k+2] << ","<< cons[3*k+1] << ">," << endl;
+            str << "    <" << cons[3*k] << ","<< cons[3*k+2] << ","<< cons[3*k+1] << ">," << '\n';
         }
         // end of face
-        out << "  }" << endl
-        << "} // end of Face"<< l << endl << endl;
+        str << "  }" << '\n'
+        << "} // end of Face"<< l << '\n' << '\n';
 
         delete [] vertexnormals;
         delete [] vertices;
         delete [] cons;
 
-        seq.next();
+        buffers[index] = str.str();
+        meshed[index] = 1;
+    });
+
+    // start sequencer
+    Base::SequencerLauncher seq("Writing file", faces.size() + 1);
 
+    // write the file
+    out <<  "// Written by FreeCAD http://www.freecadweb.org/" << endl;
+    std::size_t l = 1;
+    for (; l <= faces.size(); l++) {
+        // the output stops at the first face without a triangulation
+        if (!meshed[l-1]) break;
+        out << buffers[l-1];
+        buffers[l-1].clear();
+        seq.next();
     } // end of face loop
 
 
     out << endl << endl << "// Declare all together +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
     << "#declare " << PartName << " = union {" << endl;
-    for (int i=1; i < l; i++) {
+    for (std::size_t i=1; i < l; i++) {
         out << "mesh2{ " << PartName << i << "}" << endl;
     }
     out << "}" << endl;
@@ -312,7 +329,8 @@ void PovTools::writeShapeCSV(const char *FileName,
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
     TopExp_Explorer ex;
-    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation,/*isRelative*/ Standard_False,
+                                  /*theAngDeflection*/ 0.5,/*isInParallel*/ true);
 
     // open the file and write
     std::ofstream fout(FileName);
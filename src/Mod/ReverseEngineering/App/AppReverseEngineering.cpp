@@ -26,6 +26,7 @@
 # include <Python.h>
 # include <TColgp_Array1OfPnt.hxx>
 # include <Geom_BSplineSurface.hxx>
+# include <memory>
 #endif
 
 #include <Base/Console.h>
@@ -33,6 +34,7 @@
 #include <Base/Interpreter.h>
 #include <Base/PyObjectBase.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/VectorPy.h>
 
 #include <CXX/Extensions.hxx>
 #include <CXX/Objects.hxx>
@@ -45,6 +47,7 @@
 #include "ApproxSurface.h"
 #include "BSplineFitting.h"
 #include "SurfaceTriangulation.h"
+#include "StructuredTriangulation.h"
 #include "RegionGrowing.h"
 #include "Segmentation.h"
 #include "SampleConsensus.h"
@@ -114,6 +117,7 @@ public:
         add_keyword_method("filterVoxelGrid",&Module::filterVoxelGrid,
             "filterVoxelGrid(dim)."
         );
+#endif
         add_keyword_method("normalEstimation",&Module::normalEstimation,
             "normalEstimation(Points,[KSearch=0, SearchRadius=0]) -> Normals\n"
             "KSearch is an int and used to search the k-nearest neighbours in\n"
@@ -132,7 +136,19 @@ public:
             "f.ViewObject.Proxy=0\n"
             "f.ViewObject.DisplayMode=1\n"
         );
-#endif
+        add_keyword_method("structuredTriangulation",&Module::structuredTriangulation,
+            "structuredTriangulation(Points, Width, Height, [MaxEdgeLength=0, MaxDepthRatio=0, Viewpoint=Vector()]) -> Mesh\n"
+            "Triangulates the points of a structured point cloud, stored row by row\n"
+            "with the given width and height, by connecting neighbouring samples.\n"
+            "Triangles with an edge longer than MaxEdgeLength, or whose points differ in\n"
+            "their distance to the Viewpoint by more than MaxDepthRatio times the smaller\n"
+            "distance, are skipped. A value of 0 disables the check.\n"
+            "Example:\n"
+            "\n"
+            "import ReverseEngineering as Reen\n"
+            "obj=App.ActiveDocument.ActiveObject\n"
+            "mesh=Reen.structuredTriangulation(obj.Points,obj.Width,obj.Height,MaxDepthRatio=0.05)\n"
+        );
 #if defined(HAVE_PCL_SEGMENTATION)
         add_keyword_method("regionGrowingSegmentation",&Module::regionGrowingSegmentation,
             "regionGrowingSegmentation()."
@@ -630,7 +646,6 @@ Mesh.show(m)
         return Py::asObject(new Points::PointsPy(points_sample));
     }
 #endif
-#if defined(HAVE_PCL_FILTERS)
     Py::Object normalEstimation(const Py::Tuple& args, const Py::Dict& kwds)
     {
         PyObject *pts;
@@ -649,7 +664,12 @@ Mesh.show(m)
         NormalEstimation estimate(*points);
         estimate.setKSearch(ksearch);
         estimate.setSearchRadius(searchRadius);
-        estimate.perform(normals);
+        try {
+            estimate.perform(normals);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
 
         Py::List list;
         for (std::vector<Base::Vector3d>::iterator it = normals.begin(); it != normals.end(); ++it) {
@@ -658,7 +678,40 @@ Mesh.show(m)
 
         return list;
     }
-#endif
+    Py::Object structuredTriangulation(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *pts;
+        int width;
+        int height;
+        double maxEdgeLength = 0;
+        double maxDepthRatio = 0;
+        PyObject *vec = 0;
+
+        static char* kwds_structured[] = {"Points", "Width", "Height", "MaxEdgeLength",
+                                          "MaxDepthRatio", "Viewpoint", NULL};
+        if (!PyArg_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!ii|ddO!", kwds_structured,
+                                        &(Points::PointsPy::Type), &pts,
+                                        &width, &height, &maxEdgeLength, &maxDepthRatio,
+                                        &(Base::VectorPy::Type), &vec))
+            throw Py::Exception();
+
+        Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
+
+        try {
+            std::unique_ptr<Mesh::MeshObject> mesh(new Mesh::MeshObject());
+            StructuredTriangulation tria(width, height, *points, *mesh);
+            tria.setMaxEdgeLength(maxEdgeLength);
+            tria.setMaxDepthRatio(maxDepthRatio);
+            if (vec)
+                tria.setViewpoint(Py::Vector(vec, false).toVector());
+            tria.perform();
+
+            return Py::asObject(new Mesh::MeshPy(mesh.release()));
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+    }
 #if defined(HAVE_PCL_SEGMENTATION)
     Py::Object regionGrowingSegmentation(const Py::Tuple& args, const Py::Dict& kwds)
     {
@@ -22,15 +22,13 @@
 
 
 #include "PreCompiled.h"
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
 
-#include <QFuture>
-#include <QFutureWatcher>
+#include <QThread>
 #include <QtConcurrentMap>
-#include <boost_bind_bind.hpp>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
 
 #include <Mod/Mesh/App/Core/Approximation.h>
 #include <Base/Sequencer.h>
@@ -40,7 +38,6 @@
 #include "ApproxSurface.h"
 
 using namespace Reen;
-namespace bp = boost::placeholders;
 
 // SplineBasisfunction
 
@@ -183,6 +180,15 @@ void BSplineBasis::AllBasisFunctions(double fParam, TColStd_Array1OfReal& vFuncV
     }
 }
 
+int BSplineBasis::NonZeroBasisFunctions(double fParam, TColStd_Array1OfReal& vFuncVals)
+{
+    int n = _vKnotVector.Length()-_iOrder-1;
+    fParam = std::max<double>(fParam, _vKnotVector(_iOrder-1));
+    fParam = std::min<double>(fParam, _vKnotVector(n+1));
+    AllBasisFunctions(fParam, vFuncVals);
+    return FindSpan(fParam) - (_iOrder-1);
+}
+
 BSplineBasis::ValueT BSplineBasis::LocalSupport(int iIndex, double fParam)
 {
     int m = _vKnotVector.Length()-1;
@@ -931,214 +937,153 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
 
 bool BSplineParameterCorrection::SolveWithoutSmoothing()
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim  = _usUCtrlpoints*_usVCtrlpoints;
-    math_Matrix M  (0, ulSize-1, 0, ulDim-1);
-    math_Matrix Xx (0, ulDim-1, 0, 0);
-    math_Matrix Xy (0, ulDim-1, 0, 0);
-    math_Matrix Xz (0, ulDim-1, 0, 0);
-    math_Vector bx (0, ulSize-1);
-    math_Vector by (0, ulSize-1);
-    math_Vector bz (0, ulSize-1);
-
-    //Bestimmung der Koeffizientenmatrix des ueberbestimmten LGS
-    for (unsigned i=0; i<ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx=0;
-
-        // Vorberechnung der Werte der Basis-Funktionen
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j,fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k=0; k<_usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k,fV);
-        }
-
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = valueU * basisV[k];
-                    ulIdx++;
-                }
-            }
-        }
-    }
-
-    //Bestimmen der rechten Seite
-    for (int ii=_pvcPoints->Lower(); ii<=_pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X(); by(ii) = pnt.Y(); bz(ii) = pnt.Z();
-    }
-
-    // Loese das ueberbest. LGS mit der Householder-Transformation
-    math_Householder hhX(M,bx);
-    math_Householder hhY(M,by);
-    math_Householder hhZ(M,bz);
-
-    if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone()))
-        //LGS konnte nicht geloest werden
-        return false;
-    Xx = hhX.AllValues();
-    Xy = hhY.AllValues();
-    Xz = hhZ.AllValues();
-
-    unsigned ulIdx=0;
-    for (unsigned j=0;j<_usUCtrlpoints;j++) {
-        for (unsigned k=0;k<_usVCtrlpoints;k++) {
-            _vCtrlPntsOfSurf(j,k) = gp_Pnt(Xx(ulIdx,0),Xy(ulIdx,0),Xz(ulIdx,0));
-            ulIdx++;
-        }
-    }
+    return SolveNormalEquations(0.0);
+}
 
-    return true;
+bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+{
+    return SolveNormalEquations(fWeight);
 }
 
 namespace Reen {
-class ScalarProduct
+/**
+ * Partial sums of the normal equations for a range of points. The rows of the system
+ * matrix are stored as band: the entry of the control points (j,k) and (j+dj,k+dk) is
+ * at offset (dj+degU)*(2*degV+1)+(dk+degV) of row (j,k).
+ */
+struct NormalEquationBlock
 {
-public:
-    ScalarProduct(const math_Matrix& mat) : mat(mat)
-    {
-    }
-    std::vector<double> multiply(int col) const
-    {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n=mat.LowerCol(); n<=mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
-        }
-        return out;
-    }
-
-private:
-    const math_Matrix& mat;
+    int first;
+    int last;
+    std::vector<double> band;
+    std::vector<double> rhs;
 };
 }
 
-bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+bool BSplineParameterCorrection::SolveNormalEquations(double fWeight)
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim  = _usUCtrlpoints*_usVCtrlpoints;
-    math_Matrix M  (0, ulSize-1, 0, ulDim-1);
-    math_Vector Xx (0, ulDim-1);
-    math_Vector Xy (0, ulDim-1);
-    math_Vector Xz (0, ulDim-1);
-    math_Vector bx (0, ulSize-1);
-    math_Vector by (0, ulSize-1);
-    math_Vector bz (0, ulSize-1);
-    math_Vector Mbx(0, ulDim-1);
-    math_Vector Mby(0, ulDim-1);
-    math_Vector Mbz(0, ulDim-1);
-
-    //Bestimmung der Koeffizientenmatrix des ueberbestimmten LGS
-    for (unsigned i=0; i<ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        int ulIdx=0;
-
-        // Vorberechnung der Werte der Basis-Funktionen
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j,fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k=0; k<_usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k,fV);
-        }
-
-        for (unsigned j=0; j<_usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = 0.0;
-                    ulIdx++;
+    const int ulSize = _pvcPoints->Length();
+    const int numU = static_cast<int>(_usUCtrlpoints);
+    const int numV = static_cast<int>(_usVCtrlpoints);
+    const int ulDim = numU * numV;
+    const int degU = static_cast<int>(_usUOrder) - 1;
+    const int degV = static_cast<int>(_usVOrder) - 1;
+    const int bandV = 2 * degV + 1;
+    const int bandWidth = (2 * degU + 1) * bandV;
+
+    // every task sums up the contributions of its points, afterwards the sums are added
+    int numBlocks = std::max(1, std::min(4 * QThread::idealThreadCount(), ulSize / 1024));
+    int blockSize = (ulSize + numBlocks - 1) / numBlocks;
+    std::vector<NormalEquationBlock> blocks;
+    for (int i = 0; i < ulSize; i += blockSize) {
+        NormalEquationBlock block;
+        block.first = i;
+        block.last = std::min(i + blockSize, ulSize);
+        blocks.push_back(block);
+    }
+
+    QtConcurrent::blockingMap(blocks, [&](NormalEquationBlock& block) {
+        block.band.assign(static_cast<std::size_t>(ulDim) * bandWidth, 0.0);
+        block.rhs.assign(static_cast<std::size_t>(ulDim) * 3, 0.0);
+        TColStd_Array1OfReal basisU(0, degU);
+        TColStd_Array1OfReal basisV(0, degV);
+        std::vector<int> index((degU + 1) * (degV + 1));
+        std::vector<double> value((degU + 1) * (degV + 1));
+
+        for (int i = block.first; i < block.last; i++) {
+            const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
+            int spanU = _clUSpline.NonZeroBasisFunctions(uvValue.X(), basisU);
+            int spanV = _clVSpline.NonZeroBasisFunctions(uvValue.Y(), basisV);
+            const gp_Pnt& pnt = (*_pvcPoints)(i);
+
+            int n = 0;
+            for (int r = 0; r <= degU; r++) {
+                for (int s = 0; s <= degV; s++, n++) {
+                    index[n] = (spanU + r) * numV + spanV + s;
+                    value[n] = basisU(r) * basisV(s);
                 }
             }
-            else {
-                for (unsigned k=0; k<_usVCtrlpoints; k++) {
-                    M(i,ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+
+            n = 0;
+            for (int r = 0; r <= degU; r++) {
+                for (int s = 0; s <= degV; s++, n++) {
+                    double wa = value[n];
+                    if (wa == 0.0)
+                        continue;
+                    double* row = &block.band[static_cast<std::size_t>(index[n]) * bandWidth];
+                    int m = 0;
+                    for (int r2 = 0; r2 <= degU; r2++) {
+                        for (int s2 = 0; s2 <= degV; s2++, m++) {
+                            row[(r2 - r + degU) * bandV + (s2 - s + degV)] += wa * value[m];
+                        }
+                    }
+                    double* rhs = &block.rhs[static_cast<std::size_t>(index[n]) * 3];
+                    rhs[0] += wa * pnt.X();
+                    rhs[1] += wa * pnt.Y();
+                    rhs[2] += wa * pnt.Z();
                 }
             }
         }
+    });
+
+    std::vector<double> band(static_cast<std::size_t>(ulDim) * bandWidth, 0.0);
+    Eigen::MatrixXd rhs = Eigen::MatrixXd::Zero(ulDim, 3);
+    for (std::vector<NormalEquationBlock>::iterator it = blocks.begin(); it != blocks.end(); ++it) {
+        for (std::size_t i = 0; i < band.size(); i++)
+            band[i] += it->band[i];
+        for (int i = 0; i < ulDim; i++) {
+            rhs(i, 0) += it->rhs[3 * i];
+            rhs(i, 1) += it->rhs[3 * i + 1];
+            rhs(i, 2) += it->rhs[3 * i + 2];
+        }
     }
 
-    //Das Produkt aus ihrer Transformierten und ihr selbst ergibt die quadratische Systemmatrix (langsam)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim-1, 0, ulDim-1);
-    for (unsigned m=0; m<ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n=m; n<ulDim; n++) {
-            MTM(m,n) = MTM(n,m) = Mm * M.Col(n);
+    std::vector< Eigen::Triplet<double> > triplets;
+    triplets.reserve(static_cast<std::size_t>(ulDim) * bandWidth);
+    for (int a = 0; a < ulDim; a++) {
+        int ja = a / numV;
+        int ka = a % numV;
+        for (int dj = -degU; dj <= degU; dj++) {
+            int jb = ja + dj;
+            if (jb < 0 || jb >= numU)
+                continue;
+            for (int dk = -degV; dk <= degV; dk++) {
+                int kb = ka + dk;
+                if (kb < 0 || kb >= numV)
+                    continue;
+                double val = band[static_cast<std::size_t>(a) * bandWidth + (dj + degU) * bandV + (dk + degV)];
+                if (val != 0.0)
+                    triplets.push_back(Eigen::Triplet<double>(a, jb * numV + kb, val));
+            }
         }
     }
-#else // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    QFuture< std::vector<double> > future = QtConcurrent::mapped
-        (columns, boost::bind(&ScalarProduct::multiply, &scalar, bp::_1));
-    QFutureWatcher< std::vector<double> > watcher;
-    watcher.setFuture(future);
-    watcher.waitForFinished();
-
-    math_Matrix MTM(0, ulDim-1, 0, ulDim-1);
-    int rowIndex=0;
-    for (QFuture< std::vector<double> >::const_iterator it = future.begin(); it != future.end(); ++it) {
-        int colIndex=0;
-        for (std::vector<double>::const_iterator jt = it->begin(); jt != it->end(); ++jt, colIndex++)
-            MTM(rowIndex, colIndex) = *jt;
-        rowIndex++;
-    }
-#endif
 
-    //Bestimmen der rechten Seite
-    for (int ii=_pvcPoints->Lower(); ii<=_pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X(); by(ii) = pnt.Y(); bz(ii) = pnt.Z();
-    }
-    for (unsigned i=0; i<ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
+    // Glaettungsterme
+    if (fWeight != 0.0) {
+        for (int a = 0; a < ulDim; a++) {
+            for (int b = 0; b < ulDim; b++) {
+                double val = _clSmoothMatrix(a, b);
+                if (val != 0.0)
+                    triplets.push_back(Eigen::Triplet<double>(a, b, fWeight * val));
+            }
+        }
     }
 
-    // Loese das LGS mit der LU-Zerlegung
-    math_Gauss mgGaussX(MTM+fWeight*_clSmoothMatrix);
-    math_Gauss mgGaussY(MTM+fWeight*_clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM+fWeight*_clSmoothMatrix);
+    Eigen::SparseMatrix<double> MTM(ulDim, ulDim);
+    MTM.setFromTriplets(triplets.begin(), triplets.end());
 
-    mgGaussX.Solve(Mbx,Xx);
-    if (!mgGaussX.IsDone())
+    // Loese das LGS mit der Cholesky-Zerlegung
+    Eigen::SimplicialLDLT< Eigen::SparseMatrix<double> > solver(MTM);
+    if (solver.info() != Eigen::Success)
         return false;
-
-    mgGaussY.Solve(Mby,Xy);
-    if (!mgGaussY.IsDone())
-        return false;
-
-    mgGaussZ.Solve(Mbz,Xz);
-    if (!mgGaussZ.IsDone())
+    Eigen::MatrixXd X = solver.solve(rhs);
+    if (solver.info() != Eigen::Success)
         return false;
 
     unsigned ulIdx=0;
     for (unsigned j=0;j<_usUCtrlpoints;j++) {
         for (unsigned k=0;k<_usVCtrlpoints;k++) {
-            _vCtrlPntsOfSurf(j,k) = gp_Pnt(Xx(ulIdx),Xy(ulIdx),Xz(ulIdx));
+            _vCtrlPntsOfSurf(j,k) = gp_Pnt(X(ulIdx,0),X(ulIdx,1),X(ulIdx,2));
             ulIdx++;
         }
     }
@@ -182,6 +182,16 @@ public:
      */
     virtual void AllBasisFunctions(double fParam, TColStd_Array1OfReal& vFuncVals);
 
+    /**
+     * Berechnet wie AllBasisFunctions die Funktionswerte der an der Stelle fParam nicht
+     * verschwindenden Basisfunktionen. Der Parameter wird dabei auf den Definitionsbereich
+     * beschraenkt.
+     * @param fParam Parameter
+     * @param vFuncVals Liste der Funktionswerte
+     * @return Index der ersten nicht verschwindenden Basisfunktion
+     */
+    int NonZeroBasisFunctions(double fParam, TColStd_Array1OfReal& vFuncVals);
+
     /**
      * Gibt an, ob der Funktionswert Nik(t) an der Stelle fParam
      * 0, 1 oder ein Wert dazwischen ergibt.
@@ -390,16 +400,22 @@ protected:
     virtual void DoParameterCorrection(int iIter);
 
     /**
-     * Loest ein ueberbestimmtes LGS mit Hilfe der Householder-Transformation
+     * Loest das ueberbestimmte LGS ueber die Normalengleichungen
      */
     virtual bool SolveWithoutSmoothing();
 
     /**
-     * Loest ein regulaeres Gleichungssystem durch LU-Zerlegung. Es fliessen je nach Gewichtung
-     * Glaettungsterme mit ein
+     * Loest die Normalengleichungen. Es fliessen je nach Gewichtung Glaettungsterme mit ein
      */
     virtual bool SolveWithSmoothing(double fWeight);
 
+    /**
+     * Stellt die duennbesetzten Normalengleichungen parallel auf und loest sie mit einer
+     * Cholesky-Zerlegung. Ein Punkt beeinflusst nur die Kontrollpunkte seines Knotenintervalls,
+     * so dass die Systemmatrix eine Bandstruktur hat.
+     */
+    bool SolveNormalEquations(double fWeight);
+
 public:
     /**
      * Setzen des Knotenvektors
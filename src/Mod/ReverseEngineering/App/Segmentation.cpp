@@ -25,6 +25,7 @@
 
 #include "Segmentation.h"
 #include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsNormals.h>
 #include <Base/Exception.h>
 
 #if defined(HAVE_PCL_FILTERS)
@@ -159,7 +160,6 @@ void Segmentation::perform(int ksearch)
 
 // ----------------------------------------------------------------------------
 
-#if defined (HAVE_PCL_FILTERS)
 NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
   : myPoints(pts)
   , kSearch(0)
@@ -167,6 +167,8 @@ NormalEstimation::NormalEstimation(const Points::PointKernel& pts)
 {
 }
 
+#if defined (HAVE_PCL_FILTERS)
+
 void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
 {
     // Copy the points
@@ -208,4 +210,16 @@ void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
     }
 }
 
+#else // HAVE_PCL_FILTERS
+
+void NormalEstimation::perform(std::vector<Base::Vector3d>& normals)
+{
+    // use the built-in estimation which orients the normals like PCL towards the origin
+    Points::NormalEstimation estimate(myPoints);
+    estimate.setKSearch(kSearch);
+    estimate.setSearchRadius(searchRadius);
+    estimate.setOrientation(Points::NormalEstimation::Viewpoint);
+    estimate.perform(normals);
+}
+
 #endif // HAVE_PCL_FILTERS
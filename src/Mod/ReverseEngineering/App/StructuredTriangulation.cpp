@@ -0,0 +1,179 @@
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <climits>
+# include <cmath>
+# include <vector>
+#endif
+
+#include "StructuredTriangulation.h"
+#include <Mod/Points/App/Points.h>
+#include <Mod/Mesh/App/Mesh.h>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Part/App/Tools.h>
+#include <Base/Exception.h>
+
+using namespace Reen;
+
+StructuredTriangulation::StructuredTriangulation(int w, int h, const Points::PointKernel& pts, Mesh::MeshObject& mesh)
+  : width(w)
+  , height(h)
+  , maxEdgeLength(0)
+  , maxDepthRatio(0)
+  , viewpoint(0, 0, 0)
+  , myPoints(pts)
+  , myMesh(mesh)
+{
+}
+
+void StructuredTriangulation::perform()
+{
+    if (width < 0 || height < 0 ||
+        myPoints.size() != static_cast<std::size_t>(width) * static_cast<std::size_t>(height))
+        throw Base::RuntimeError("Number of points doesn't match with given width and height");
+
+    const std::size_t w = static_cast<std::size_t>(width);
+    const std::size_t h = static_cast<std::size_t>(height);
+    if (w < 2 || h < 2) {
+        myMesh.clear();
+        return;
+    }
+
+    // transform the points once, invalid samples keep their NaN coordinates
+    std::vector<Base::Vector3f> points(w * h);
+    std::vector<double> depth(maxDepthRatio > 0 ? w * h : 0);
+    std::vector<char> valid(w * h);
+    Part::Tools::parallelFor(h, [&](std::size_t row) {
+        for (std::size_t i = row * w; i < (row + 1) * w; i++) {
+            Base::Vector3d p = myPoints.getPoint(static_cast<int>(i));
+            valid[i] = !std::isnan(p.x) && !std::isnan(p.y) && !std::isnan(p.z);
+            points[i].Set(static_cast<float>(p.x), static_cast<float>(p.y), static_cast<float>(p.z));
+            if (!depth.empty())
+                depth[i] = Base::Distance(p, viewpoint);
+        }
+    });
+
+    const float maxLength2 = static_cast<float>(maxEdgeLength * maxEdgeLength);
+    auto acceptEdge = [&](std::size_t a, std::size_t b) {
+        if (maxEdgeLength > 0 && Base::DistanceP2(points[a], points[b]) > maxLength2)
+            return false;
+        if (!depth.empty() && std::fabs(depth[a] - depth[b]) > maxDepthRatio * std::min(depth[a], depth[b]))
+            return false;
+        return true;
+    };
+    auto acceptTriangle = [&](std::size_t a, std::size_t b, std::size_t c) {
+        return acceptEdge(a, b) && acceptEdge(b, c) && acceptEdge(c, a);
+    };
+
+    // triangulate the cells between two rows, the facets still refer to the grid
+    std::vector<std::vector<MeshCore::MeshFacet> > rowFacets(h - 1);
+    Part::Tools::parallelFor(h - 1, [&](std::size_t row) {
+        std::vector<MeshCore::MeshFacet>& facets = rowFacets[row];
+        facets.reserve(2 * (w - 1));
+        auto addTriangle = [&](std::size_t a, std::size_t b, std::size_t c) {
+            if (acceptTriangle(a, b, c))
+                facets.emplace_back(a, b, c);
+        };
+
+        for (std::size_t col = 0; col < w - 1; col++) {
+            // the corners of the cell in counter-clockwise order
+            std::size_t corner[4];
+            corner[0] = row * w + col;
+            corner[1] = corner[0] + 1;
+            corner[2] = corner[1] + w;
+            corner[3] = corner[0] + w;
+
+            int numValid = 0;
+            int invalid = -1;
+            for (int i = 0; i < 4; i++) {
+                if (valid[corner[i]])
+                    numValid++;
+                else
+                    invalid = i;
+            }
+
+            if (numValid == 4) {
+                if (Base::DistanceP2(points[corner[0]], points[corner[2]]) <=
+                    Base::DistanceP2(points[corner[1]], points[corner[3]])) {
+                    addTriangle(corner[0], corner[1], corner[2]);
+                    addTriangle(corner[0], corner[2], corner[3]);
+                }
+                else {
+                    addTriangle(corner[0], corner[1], corner[3]);
+                    addTriangle(corner[1], corner[2], corner[3]);
+                }
+            }
+            else if (numValid == 3) {
+                addTriangle(corner[(invalid + 1) % 4], corner[(invalid + 2) % 4], corner[(invalid + 3) % 4]);
+            }
+        }
+    });
+
+    // keep only the points used by a facet, the valid flags are not needed any more
+    std::vector<char>& used = valid;
+    std::fill(used.begin(), used.end(), 0);
+    std::vector<std::size_t> facetOffset(h, 0);
+    for (std::size_t row = 0; row < h - 1; row++) {
+        for (const auto& facet : rowFacets[row]) {
+            for (int i = 0; i < 3; i++)
+                used[facet._aulPoints[i]] = 1;
+        }
+        facetOffset[row + 1] = facetOffset[row] + rowFacets[row].size();
+    }
+
+    std::vector<unsigned long> pointIndex(w * h, ULONG_MAX);
+    std::vector<std::size_t> usedPoints;
+    for (std::size_t i = 0; i < w * h; i++) {
+        if (used[i]) {
+            pointIndex[i] = static_cast<unsigned long>(usedPoints.size());
+            usedPoints.push_back(i);
+        }
+    }
+
+    const std::size_t blockSize = 16384;
+    MeshCore::MeshPointArray meshPoints(usedPoints.size());
+    std::size_t numBlocks = (usedPoints.size() + blockSize - 1) / blockSize;
+    Part::Tools::parallelFor(numBlocks, [&](std::size_t block) {
+        std::size_t last = std::min((block + 1) * blockSize, usedPoints.size());
+        for (std::size_t i = block * blockSize; i < last; i++)
+            meshPoints[i] = points[usedPoints[i]];
+    });
+
+    MeshCore::MeshFacetArray meshFacets(facetOffset[h - 1]);
+    Part::Tools::parallelFor(h - 1, [&](std::size_t row) {
+        std::size_t index = facetOffset[row];
+        for (const auto& facet : rowFacets[row]) {
+            MeshCore::MeshFacet& face = meshFacets[index++];
+            for (int i = 0; i < 3; i++)
+                face._aulPoints[i] = pointIndex[facet._aulPoints[i]];
+        }
+        std::vector<MeshCore::MeshFacet>().swap(rowFacets[row]);
+    });
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(meshPoints, meshFacets, true);
+    myMesh.swap(kernel);
+}
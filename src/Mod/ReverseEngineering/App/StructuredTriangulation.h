@@ -0,0 +1,69 @@
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef REEN_STRUCTUREDTRIANGULATION_H
+#define REEN_STRUCTUREDTRIANGULATION_H
+
+#include <Base/Vector3D.h>
+
+namespace Points {class PointKernel;}
+namespace Mesh {class MeshObject;}
+
+namespace Reen {
+
+/**
+ * The StructuredTriangulation class meshes an organized point cloud, i.e. the
+ * points of a scanner image stored row by row with the given width and height.
+ * Each cell of the grid is split into two triangles along its shorter diagonal,
+ * a cell with one invalid (NaN) sample gives one triangle. Triangles spanning a
+ * depth discontinuity are skipped.
+ * No search structure is needed, so the rows are processed in parallel.
+ */
+class ReenExport StructuredTriangulation
+{
+public:
+    StructuredTriangulation(int width, int height, const Points::PointKernel&, Mesh::MeshObject&);
+    /** Skips triangles with an edge longer than \a length, 0 disables the check. */
+    void setMaxEdgeLength(double length)
+    { maxEdgeLength = length; }
+    /** Skips triangles with an edge whose end points differ in their distance to the
+     * view point by more than \a ratio times the smaller distance, 0 disables the check.
+     */
+    void setMaxDepthRatio(double ratio)
+    { maxDepthRatio = ratio; }
+    /** Sets the position of the scanner, by default the origin. */
+    void setViewpoint(const Base::Vector3d& pnt)
+    { viewpoint = pnt; }
+    void perform();
+
+private:
+    int width, height;
+    double maxEdgeLength;
+    double maxDepthRatio;
+    Base::Vector3d viewpoint;
+    const Points::PointKernel& myPoints;
+    Mesh::MeshObject& myMesh;
+};
+
+} // namespace Reen
+
+#endif // REEN_STRUCTUREDTRIANGULATION_H
@@ -51,6 +51,8 @@
 #include <vector>
 #include <set>
 #include <bitset>
+#include <algorithm>
+#include <array>
 
 #include <Python.h>
 
@@ -24,6 +24,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 #endif
 
 #include <Base/Writer.h>
@@ -41,6 +42,7 @@
 
 #include "Robot6Axis.h"
 #include "RobotAlgos.h"
+#include <Mod/Part/App/Tools.h>
 
 #ifndef M_PI
     #define M_PI    3.14159265358979323846 /* pi */
@@ -250,6 +252,57 @@ bool Robot6Axis::setTo(const Placement &To)
     }
 }
 
+void Robot6Axis::solvePoses(const std::vector<Base::Placement> &Poses,
+                            std::vector<std::array<double,6> > &Axis,
+                            std::vector<bool> &Reachable,
+                            std::size_t SegmentSize) const
+{
+    std::size_t numPoses = Poses.size();
+    std::vector<JntArray> results(numPoses, JntArray(Kinematic.getNrOfJoints()));
+    std::vector<char> solved(numPoses, 0);
+    SegmentSize = std::max<std::size_t>(SegmentSize, 1);
+    std::size_t numSegments = (numPoses + SegmentSize - 1) / SegmentSize;
+
+    // the solvers keep an internal state, so every thread needs its own ones
+    auto solve = [this](const Placement &To, const JntArray &Start, JntArray &Result) -> bool {
+        ChainFkSolverPos_recursive fksolver1(Kinematic);//Forward position solver
+        ChainIkSolverVel_pinv iksolver1v(Kinematic);//Inverse velocity solver
+        ChainIkSolverPos_NR_JL iksolver1(Kinematic,Min,Max,fksolver1,iksolver1v,100,1e-6);//Maximum 100 iterations, stop at accuracy 1e-6
+
+        Frame F_dest = Frame(KDL::Rotation::Quaternion(To.getRotation()[0],To.getRotation()[1],To.getRotation()[2],To.getRotation()[3]),KDL::Vector(To.getPosition()[0],To.getPosition()[1],To.getPosition()[2]));
+        return iksolver1.CartToJnt(Start,F_dest,Result) >= 0;
+    };
+
+    // the first poses of the segments, like setTo() an unreachable pose keeps the start position
+    JntArray start = Actuall;
+    for (std::size_t i = 0; i < numSegments; i++) {
+        std::size_t index = i * SegmentSize;
+        solved[index] = solve(Poses[index], start, results[index]);
+        if (solved[index])
+            start = results[index];
+        else
+            results[index] = start;
+    }
+
+    Part::Tools::parallelFor(numSegments, [&](std::size_t segment) {
+        std::size_t begin = segment * SegmentSize;
+        std::size_t end = std::min(begin + SegmentSize, numPoses);
+        for (std::size_t index = begin + 1; index < end; index++) {
+            solved[index] = solve(Poses[index], results[index-1], results[index]);
+            if (!solved[index])
+                results[index] = results[index-1];
+        }
+    });
+
+    Axis.resize(numPoses);
+    Reachable.resize(numPoses);
+    for (std::size_t index = 0; index < numPoses; index++) {
+        for (int i = 0; i < 6; i++)
+            Axis[index][i] = RotDir[i] * (results[index](i)/(M_PI/180)); // radian to degree
+        Reachable[index] = solved[index] != 0;
+    }
+}
+
 Base::Placement Robot6Axis::getTcp(void)
 {
     double x,y,z,w;
@@ -29,6 +29,8 @@
 
 #include <Base/Persistence.h>
 #include <Base/Placement.h>
+#include <array>
+#include <vector>
 
 namespace Robot
 {
@@ -69,6 +71,16 @@ public:
     
     /// set the robot to that position, calculates the Axis
 	bool setTo(const Base::Placement &To);
+    /** Calculates the Axis (in degrees) for all placements of \a Poses without moving the robot.
+     * The poses are split into segments of \a SegmentSize consecutive poses that are solved
+     * in parallel. Each pose starts the solver at the result of its predecessor, the first poses
+     * of the segments are solved in advance, one after the other, starting at the actual Axis.
+     * \a Reachable tells for every pose whether a solution was found.
+     */
+    void solvePoses(const std::vector<Base::Placement> &Poses,
+                    std::vector<std::array<double,6> > &Axis,
+                    std::vector<bool> &Reachable,
+                    std::size_t SegmentSize=50) const;
 	bool setAxis(int Axis,double Value);
 	double getAxis(int Axis);
     double getMaxAngle(int Axis);
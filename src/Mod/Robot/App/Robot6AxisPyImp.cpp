@@ -24,6 +24,7 @@
 #include "PreCompiled.h"
 
 #include "Mod/Robot/App/Robot6Axis.h"
+#include "Mod/Robot/App/TrajectoryPy.h"
 #include <Base/PlacementPy.h>
 #include <Base/MatrixPy.h>
 #include <Base/Exception.h>
@@ -78,6 +79,57 @@ PyObject* Robot6AxisPy::check(PyObject * /*args*/)
 
 
 
+PyObject* Robot6AxisPy::solvePoses(PyObject * args)
+{
+    std::vector<Base::Placement> poses;
+
+    PyObject* o;
+    double step;
+    if (PyArg_ParseTuple(args, "O!d", &(Robot::TrajectoryPy::Type), &o, &step)) {
+        if (step <= 0) {
+            PyErr_SetString(PyExc_ValueError, "step must be positive");
+            return 0;
+        }
+        poses = static_cast<Robot::TrajectoryPy*>(o)->getTrajectoryPtr()->getPositions(step);
+    }
+    else {
+        PyErr_Clear();
+        if (!PyArg_ParseTuple(args, "O", &o))
+            return 0;
+        try {
+            Py::Sequence list(o);
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                if (!PyObject_TypeCheck((*it).ptr(), &(Base::PlacementPy::Type))) {
+                    PyErr_SetString(PyExc_TypeError, "list of placements or trajectory and step expected");
+                    return 0;
+                }
+                poses.push_back(*static_cast<Base::PlacementPy*>((*it).ptr())->getPlacementPtr());
+            }
+        }
+        catch (Py::Exception&) {
+            return 0;
+        }
+    }
+
+    std::vector<std::array<double,6> > axis;
+    std::vector<bool> reachable;
+    getRobot6AxisPtr()->solvePoses(poses, axis, reachable);
+
+    Py::List axisList, reachableList;
+    for (std::size_t i = 0; i < axis.size(); i++) {
+        Py::Tuple tuple(6);
+        for (int j = 0; j < 6; j++)
+            tuple.setItem(j, Py::Float(axis[i][j]));
+        axisList.append(tuple);
+        reachableList.append(Py::Boolean(reachable[i]));
+    }
+
+    Py::Tuple result(2);
+    result.setItem(0, axisList);
+    result.setItem(1, reachableList);
+    return Py::new_reference_to(result);
+}
+
 Py::Float Robot6AxisPy::getAxis1(void) const
 {
     return Py::Float(getRobot6AxisPtr()->getAxis(0));
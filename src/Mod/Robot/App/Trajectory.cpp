@@ -61,13 +61,13 @@ using namespace Base;
 TYPESYSTEM_SOURCE(Robot::Trajectory , Base::Persistence)
 
 Trajectory::Trajectory()
-:pcTrajectory(0)
+:pcTrajectory(0),uGenerated(0),uResumeWaypoint(0),uResumeSegments(0)
 {
 
 }
 
 Trajectory::Trajectory(const Trajectory& Trac)
-:vpcWaypoints(Trac.vpcWaypoints.size()),pcTrajectory(0)
+:vpcWaypoints(Trac.vpcWaypoints.size()),pcTrajectory(0),uGenerated(0),uResumeWaypoint(0),uResumeSegments(0)
 {
     operator=(Trac);
 }
@@ -93,6 +93,18 @@ Trajectory &Trajectory::operator=(const Trajectory& Trac)
     for (std::vector<Waypoint*>::const_iterator it=Trac.vpcWaypoints.begin();it!=Trac.vpcWaypoints.end();++it,i++)
         vpcWaypoints[i] = new Waypoint(**it);
 
+    // an up-to-date trajectory is copied instead of generated again
+    if (Trac.pcTrajectory && Trac.uGenerated == Trac.vpcWaypoints.size()) {
+        delete pcTrajectory;
+        pcTrajectory = static_cast<KDL::Trajectory_Composite*>(Trac.pcTrajectory->Clone());
+        uGenerated = Trac.uGenerated;
+        uResumeWaypoint = Trac.uResumeWaypoint;
+        uResumeSegments = Trac.uResumeSegments;
+        vSegmentStart = Trac.vSegmentStart;
+        return *this;
+    }
+
+    uGenerated = 0;
     generateTrajectory();
     return *this;
 }
@@ -127,6 +139,19 @@ Placement Trajectory::getPosition(double time)const
         return Placement();
 }
 
+std::vector<Placement> Trajectory::getPositions(double step)const
+{
+    std::vector<Placement> positions;
+    if (pcTrajectory && step > 0) {
+        double duration = pcTrajectory->Duration();
+        std::size_t count = static_cast<std::size_t>(duration / step) + 1;
+        positions.reserve(count);
+        for (std::size_t i = 0; i < count; i++)
+            positions.push_back(Placement(toPlacement(pcTrajectory->Pos(i * step))));
+    }
+    return positions;
+}
+
 double Trajectory::getVelocity(double time)const
 {
     if(pcTrajectory){
@@ -143,6 +168,7 @@ void Trajectory::deleteLast(unsigned int n)
         delete(*vpcWaypoints.rbegin());
         vpcWaypoints.pop_back();
     }
+    uGenerated = 0;
 
 }
 
@@ -151,42 +177,61 @@ void Trajectory::generateTrajectory(void)
     if (vpcWaypoints.size()==0)
         return;
 
+    // if waypoints were only appended the segments in front of them stay the same
+    if (pcTrajectory && uGenerated > 0 && uGenerated <= vpcWaypoints.size()) {
+        if (uGenerated == vpcWaypoints.size())
+            return;
+        while (pcTrajectory->Size() > uResumeSegments)
+            pcTrajectory->RemoveLast();
+        vSegmentStart.resize(uResumeSegments);
+        addSegments(uResumeWaypoint);
+        return;
+    }
+
     // delete the old and create a new one
     if (pcTrajectory)
         delete (pcTrajectory);
     pcTrajectory = new KDL::Trajectory_Composite();
+    vSegmentStart.clear();
+    addSegments(0);
+}
+
+void Trajectory::addSegments(std::size_t start)
+{
+    uGenerated = 0;
 
     // pointer to the pieces while iterating
     std::unique_ptr<KDL::Trajectory_Segment> pcTrak;
     std::unique_ptr<KDL::VelocityProfile> pcVelPrf;
     std::unique_ptr<KDL::Path_RoundedComposite> pcRoundComp;
     KDL::Frame Last;
+    // the waypoints of Last, of the start of the running continuous block and of the segment in pcTrak
+    std::size_t LastIndex = start, BlockStart = start, TrakStart = start;
 
     try {
         // handle the first waypoint special
-        bool first=true;
-
-        for (std::vector<Waypoint*>::const_iterator it = vpcWaypoints.begin();it!=vpcWaypoints.end();++it) {
-            if (first) {
-                Last = toFrame((*it)->EndPos);
-                first = false;
+        for (std::size_t i = start; i < vpcWaypoints.size(); i++) {
+            const Waypoint* it = vpcWaypoints[i];
+            if (i == start) {
+                Last = toFrame(it->EndPos);
             }
             else {
                 // destinct the type of movement
-                switch((*it)->Type){
+                switch(it->Type){
                 case Waypoint::LINE:
                 case Waypoint::PTP:{
-                    KDL::Frame Next = toFrame((*it)->EndPos);
+                    KDL::Frame Next = toFrame(it->EndPos);
                     // continues the movement until no continuous waypoint or the end
-                    bool Cont = (*it)->Cont && !(it==--vpcWaypoints.end());
+                    bool Cont = it->Cont && i+1 != vpcWaypoints.size();
                     // start of a continue block
                     if (Cont && !pcRoundComp) {
                         pcRoundComp.reset(new KDL::Path_RoundedComposite(3, 3,
                                           new KDL::RotationalInterpolation_SingleAxis()));
                         // the velocity of the first waypoint is used
-                        pcVelPrf.reset(new KDL::VelocityProfile_Trap((*it)->Velocity,(*it)->Accelaration));
+                        pcVelPrf.reset(new KDL::VelocityProfile_Trap(it->Velocity,it->Accelaration));
                         pcRoundComp->Add(Last);
                         pcRoundComp->Add(Next);
+                        BlockStart = LastIndex;
 
                     // continue a continues block
                     }
@@ -200,6 +245,7 @@ void Trajectory::generateTrajectory(void)
                         pcRoundComp->Finish();
                         pcVelPrf->SetProfile(0,pcRoundComp->PathLength());
                         pcTrak.reset(new KDL::Trajectory_Segment(pcRoundComp.release(),pcVelPrf.release()));
+                        TrakStart = BlockStart;
 
                         // normal block
                     }
@@ -212,11 +258,13 @@ void Trajectory::generateTrajectory(void)
                                                     true
                                                     );
 
-                        pcVelPrf.reset(new KDL::VelocityProfile_Trap((*it)->Velocity,(*it)->Accelaration));
+                        pcVelPrf.reset(new KDL::VelocityProfile_Trap(it->Velocity,it->Accelaration));
                         pcVelPrf->SetProfile(0,pcPath->PathLength());
                         pcTrak.reset(new KDL::Trajectory_Segment(pcPath,pcVelPrf.release()));
+                        TrakStart = LastIndex;
                     }
                     Last = Next;
+                    LastIndex = i;
                     break;}
                 case Waypoint::WAIT:
                     break;
@@ -225,14 +273,29 @@ void Trajectory::generateTrajectory(void)
                 }
 
                 // add the segment if no continuous block is running
-                if (!pcRoundComp && pcTrak)
+                if (!pcRoundComp && pcTrak) {
                     pcTrajectory->Add(pcTrak.release());
+                    vSegmentStart.push_back(TrakStart);
+                }
             }
         }
     }
     catch (KDL::Error &e) {
         throw Base::RuntimeError(e.Description());
     }
+
+    // Appended waypoints continue at the last waypoint. A continuous block that was cut off
+    // by the end of the waypoints is generated again from its start.
+    uResumeWaypoint = LastIndex;
+    uResumeSegments = vSegmentStart.size();
+    if (pcRoundComp) {
+        uResumeWaypoint = BlockStart;
+    }
+    else if (LastIndex != start && vpcWaypoints[LastIndex]->Cont && !vSegmentStart.empty()) {
+        uResumeWaypoint = vSegmentStart.back();
+        uResumeSegments = vSegmentStart.size() - 1;
+    }
+    uGenerated = vpcWaypoints.size();
 }
 
 std::string Trajectory::getUniqueWaypointName(const char *Name) const
@@ -312,6 +375,7 @@ void Trajectory::Save (Writer &writer) const
 void Trajectory::Restore(XMLReader &reader)
 {
     vpcWaypoints.clear();
+    uGenerated = 0;
     // read my element
     reader.readElement("Trajectory");
     // get the value of my Attribute
@@ -72,14 +72,27 @@ public:
     /// return the duration (s) of the Trajectory if -1 or of the Waypoint with the given number
     double getDuration (int n=-1) const;
     Base::Placement getPosition(double time)const;
+    /// returns the positions at the times 0, step, 2*step, ... up to the end of the trajectory
+    std::vector<Base::Placement> getPositions(double step)const;
     double getVelocity(double time)const;
 
 
 protected:
+    /// appends the segments of the waypoints from \a start on to the composite trajectory
+    void addSegments(std::size_t start);
 
     std::vector<Waypoint*> vpcWaypoints;
 
     KDL::Trajectory_Composite *pcTrajectory;
+
+    /// number of waypoints the composite trajectory was generated for, 0 if it's outdated
+    std::size_t uGenerated;
+    /// the waypoint the generation continues at if waypoints are appended
+    std::size_t uResumeWaypoint;
+    /// the number of segments that are kept if waypoints are appended
+    std::size_t uResumeSegments;
+    /// index of the first waypoint of every segment of the composite trajectory
+    std::vector<std::size_t> vSegmentStart;
 };
 
 } //namespace Part
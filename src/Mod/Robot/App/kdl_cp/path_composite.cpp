@@ -43,6 +43,7 @@
 #include "path_composite.hpp"
 #include "utilities/error.h"
 #include <memory>
+#include <algorithm> // FreeCAD change
 
 namespace KDL {
 
@@ -58,17 +59,17 @@ double Path_Composite::Lookup(double s) const
 	if ( (cached_starts <=s) && ( s <= cached_ends) ) {
 		return s - cached_starts;
 	}
-	double previous_s=0;
-	for (unsigned int i=0;i<dv.size();++i) {
-		if ((s <= dv[i])||(i == (dv.size()-1) )) {
-			cached_index = i;
-			cached_starts = previous_s;
-			cached_ends   = dv[i];
-			return s - previous_s;
-		}
-		previous_s = dv[i];
-	}
-	return 0;
+	if (dv.empty())
+		return 0;
+	// FreeCAD change: binary search of the first segment that ends behind s
+	unsigned int i = std::lower_bound(dv.begin(), dv.end(), s) - dv.begin();
+	if (i >= dv.size())
+		i = dv.size()-1;
+	double previous_s = i > 0 ? dv[i-1] : 0;
+	cached_index = i;
+	cached_starts = previous_s;
+	cached_ends   = dv[i];
+	return s - previous_s;
 }
 
 Path_Composite::Path_Composite() {
@@ -84,6 +85,20 @@ void Path_Composite::Add(Path* geom, bool aggregate ) {
 	gv.insert( gv.end(),std::make_pair(geom,aggregate) );
 }
 
+// FreeCAD change
+void Path_Composite::RemoveLast() {
+	if (gv.empty())
+		return;
+	if (gv.back().second)
+		delete gv.back().first;
+	gv.pop_back();
+	dv.pop_back();
+	pathlength = dv.empty() ? 0 : dv.back();
+	cached_starts = 0;
+	cached_ends   = 0;
+	cached_index  = 0;
+}
+
 double Path_Composite::LengthToS(double /*length*/) {
 	throw Error_MotionPlanning_Not_Applicable();
 }
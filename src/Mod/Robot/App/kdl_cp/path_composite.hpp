@@ -90,6 +90,12 @@ namespace KDL {
 		 */
 		void Add(Path* geom, bool aggregate=true);
 
+		/**
+		 * Removes the last Path* of this composite
+		 * FreeCAD change
+		 */
+		void RemoveLast();
+
 
 		virtual double LengthToS(double length);
 		/**
@@ -15,13 +15,14 @@
 
 #include "trajectory_composite.hpp"
 #include "path_composite.hpp"
+#include <algorithm> // FreeCAD change
 
 namespace KDL {
 
     using namespace std;
 
 
-    Trajectory_Composite::Trajectory_Composite():duration(0.0)
+    Trajectory_Composite::Trajectory_Composite():duration(0.0),cached_index(0)
     {
         path = new Path_Composite(); // FreeCAD change
     }
@@ -30,21 +31,27 @@ namespace KDL {
         return duration;
     }
 
+    // FreeCAD change: the segments are searched binary, sequential lookups
+    // within the same segment don't search at all
+    unsigned int Trajectory_Composite::Lookup(double time, double& previoustime) const {
+        unsigned int i = cached_index;
+        if (i >= vd.size() || time >= vd[i] || (i > 0 && time < vd[i-1])) {
+            i = std::upper_bound(vd.begin(), vd.end(), time) - vd.begin();
+            cached_index = i;
+        }
+        previoustime = i > 0 ? vd[i-1] : 0;
+        return i;
+    }
+
     Frame Trajectory_Composite::Pos(double time) const {
-        // not optimal, could be done in log(#elem)
-        // or one could buffer the last segment and start looking from there.
-        unsigned int i;
         double previoustime;
         Trajectory* traj;
         if (time < 0) {
             return vt[0]->Pos(0);
         }
-        previoustime = 0;
-        for (i=0;i<vt.size();i++) {
-            if (time < vd[i]) {
-                return vt[i]->Pos(time-previoustime);
-            }
-            previoustime = vd[i];
+        unsigned int i = Lookup(time, previoustime);
+        if (i < vt.size()) {
+            return vt[i]->Pos(time-previoustime);
         }
         traj = vt[vt.size()-1];
         return traj->Pos(traj->Duration());
@@ -52,38 +59,28 @@ namespace KDL {
 
 
     Twist Trajectory_Composite::Vel(double time) const {
-        // not optimal, could be done in log(#elem)
-        unsigned int i;
-        Trajectory* traj;
         double previoustime;
+        Trajectory* traj;
         if (time < 0) {
             return vt[0]->Vel(0);
         }
-        previoustime = 0;
-        for (i=0;i<vt.size();i++) {
-            if (time < vd[i]) {
-                return vt[i]->Vel(time-previoustime);
-            }
-            previoustime = vd[i];
+        unsigned int i = Lookup(time, previoustime);
+        if (i < vt.size()) {
+            return vt[i]->Vel(time-previoustime);
         }
         traj = vt[vt.size()-1];
         return traj->Vel(traj->Duration());
     }
 
     Twist Trajectory_Composite::Acc(double time) const {
-        // not optimal, could be done in log(#elem)
-    	unsigned int i;
-        Trajectory* traj;
         double previoustime;
+        Trajectory* traj;
         if (time < 0) {
             return vt[0]->Acc(0);
         }
-        previoustime = 0;
-        for (i=0;i<vt.size();i++) {
-		if (time < vd[i]) {
-			return vt[i]->Acc(time-previoustime);
-		}
-		previoustime = vd[i];
+        unsigned int i = Lookup(time, previoustime);
+        if (i < vt.size()) {
+            return vt[i]->Acc(time-previoustime);
         }
         traj = vt[vt.size()-1];
         return traj->Acc(traj->Duration());
@@ -97,6 +94,19 @@ namespace KDL {
             path->Add(elem->GetPath(),false); // FreeCAD change
     }
 
+    // FreeCAD change
+    void Trajectory_Composite::RemoveLast() {
+        if (vt.empty())
+            return;
+        delete vt.back();
+        vt.pop_back();
+        vd.pop_back();
+        duration = vd.empty() ? 0.0 : vd.back();
+        cached_index = 0;
+        if (path)
+            path->RemoveLast();
+    }
+
     void Trajectory_Composite::Destroy() {
         VectorTraj::iterator it;
         for (it=vt.begin();it!=vt.end();it++) {
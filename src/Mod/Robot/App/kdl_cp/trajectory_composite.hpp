@@ -38,6 +38,8 @@ class Trajectory_Composite: public Trajectory
 		double duration;    // total duration of the composed
 				    // Trajectory
         Path_Composite* path; // FreeCAD change
+        mutable unsigned int cached_index; // FreeCAD change: segment of the last lookup
+        unsigned int Lookup(double time, double& previoustime) const; // FreeCAD change
 
 	public:
 		Trajectory_Composite();
@@ -51,6 +53,10 @@ class Trajectory_Composite: public Trajectory
 		virtual void Add(Trajectory* elem);
 		// Adds trajectory <elem> to the end of the sequence.
 
+		// FreeCAD change
+		void RemoveLast();
+		// Removes and deletes the last trajectory of the sequence.
+
 		virtual void Destroy();
 		virtual void Write(std::ostream& os) const;
 		virtual Trajectory* Clone() const;
@@ -59,6 +65,7 @@ class Trajectory_Composite: public Trajectory
         
         // access the single members
         Trajectory *Get(unsigned int n){return vt[n];} // FreeCAD change
+        unsigned int Size() const {return vt.size();} // FreeCAD change
 
 		virtual ~Trajectory_Composite();
 	};
@@ -74,6 +74,7 @@ TYPESYSTEM_SOURCE(Sketcher::Sketch, Base::Persistence)
 Sketch::Sketch()
   : SolveTime(0)
   , RecalculateInitialSolutionWhileMovingPoint(false)
+  , SetUpExtGeoCount(0), SetUpNeedsBlockAnalysis(false)
   , GCSsys(), ConstraintsCounter(0)
   , isInitMove(false), isFine(true), moveStep(0)
   , defaultSolver(GCS::DogLeg)
@@ -121,6 +122,7 @@ void Sketch::clear(void)
     //for (std::vector<Constraint *>::iterator it = NonDrivingConstraints.begin(); it != NonDrivingConstraints.end(); ++it)
     //    if (*it) delete *it;
     Constrs.clear();
+    SetUpConstraints.clear();
 
     GCSsys.clear();
     isInitMove = false;
@@ -216,6 +218,33 @@ int Sketch::setUpSketch(const std::vector<Part::Geometry *> &GeoList,
 {
     Base::TimeInfo start_time;
 
+    // Changing only datums, e.g. from a spreadsheet, keeps the geometry and the structure of the
+    // constraints. The solver is kept then and only the datums are patched before diagnosing again.
+    if (isSetUpReusable(GeoList, ConstraintList, extGeoCount)) {
+        updateDatums(ConstraintList);
+
+        isInitMove = false;
+        pDependencyGroups.clear();
+        clearTemporaryConstraints();
+        GCSsys.invalidatedDiagnosis();
+        GCSsys.initSolution(defaultSolverRedundant);
+
+        GCSsys.getConflicting(Conflicting);
+        GCSsys.getRedundant(Redundant);
+        GCSsys.getPartiallyRedundant (PartiallyRedundant);
+        GCSsys.getDependentParams(pDependentParametersList);
+
+        calculateDependentParametersElements();
+
+        if (debugMode==GCS::Minimal || debugMode==GCS::IterationLevel) {
+            Base::TimeInfo end_time;
+
+            Base::Console().Log("Sketcher::setUpSketch()-Datums-T:%s\n",Base::TimeInfo::diffTime(start_time,end_time).c_str());
+        }
+
+        return GCSsys.dofsNumber();
+    }
+
     clear();
 
     std::vector<Part::Geometry *> intGeoList, extGeoList;
@@ -335,6 +364,12 @@ int Sketch::setUpSketch(const std::vector<Part::Geometry *> &GeoList,
 
     calculateDependentParametersElements();
 
+    SetUpConstraints.reserve(ConstraintList.size());
+    for (auto constr : ConstraintList)
+        SetUpConstraints.emplace_back(constr->clone());
+    SetUpExtGeoCount = extGeoCount;
+    SetUpNeedsBlockAnalysis = doesBlockAffectOtherConstraints;
+
     if (debugMode==GCS::Minimal || debugMode==GCS::IterationLevel) {
         Base::TimeInfo end_time;
 
@@ -344,6 +379,87 @@ int Sketch::setUpSketch(const std::vector<Part::Geometry *> &GeoList,
     return GCSsys.dofsNumber();
 }
 
+// The geometries are compared by their persistent content, as the SketchObject gets new copies
+// of the solver geometry after each solve.
+static bool isSameGeometry(const Part::Geometry *g1, const Part::Geometry *g2)
+{
+    if (g1 == g2)
+        return true;
+    if (!g1 || !g2 || g1->getTypeId() != g2->getTypeId())
+        return false;
+    Base::StringWriter w1, w2;
+    g1->Save(w1);
+    g2->Save(w2);
+    return w1.getString() == w2.getString();
+}
+
+// The datums of these constraints select the kind of the constraint or are converted into other
+// solver parameters, so that they cannot be patched.
+static bool hasPatchableDatum(const Constraint *constr)
+{
+    return constr->Type != Tangent && constr->Type != Perpendicular && constr->Type != SnellsLaw;
+}
+
+static bool isSameConstraintStructure(const Constraint *c1, const Constraint *c2)
+{
+    if (c1->Type != c2->Type || c1->AlignmentType != c2->AlignmentType ||
+        c1->First != c2->First || c1->FirstPos != c2->FirstPos ||
+        c1->Second != c2->Second || c1->SecondPos != c2->SecondPos ||
+        c1->Third != c2->Third || c1->ThirdPos != c2->ThirdPos ||
+        c1->InternalAlignmentIndex != c2->InternalAlignmentIndex ||
+        c1->isDriving != c2->isDriving || c1->isActive != c2->isActive)
+        return false;
+
+    return hasPatchableDatum(c1) || c1->getValue() == c2->getValue();
+}
+
+bool Sketch::isSetUpReusable(const std::vector<Part::Geometry *> &GeoList,
+                             const std::vector<Constraint *> &ConstraintList,
+                             int extGeoCount) const
+{
+    // the post-analysis of block constraints depends on the diagnosis, it is always redone
+    if (SetUpConstraints.empty() || SetUpNeedsBlockAnalysis || extGeoCount != SetUpExtGeoCount)
+        return false;
+    if (ConstraintList.size() != SetUpConstraints.size() || GeoList.size() != Geoms.size())
+        return false;
+
+    std::size_t enforced = 0;
+    for (std::size_t i = 0; i < ConstraintList.size(); i++) {
+        if (!isSameConstraintStructure(ConstraintList[i], SetUpConstraints[i].get()))
+            return false;
+        if (ConstraintList[i]->Type != Block && ConstraintList[i]->isActive)
+            enforced++;
+    }
+    // constraints added after the set up
+    if (enforced != Constrs.size())
+        return false;
+
+    for (std::size_t i = 0; i < GeoList.size(); i++) {
+        if (!isSameGeometry(GeoList[i], Geoms[i].geo))
+            return false;
+    }
+
+    return true;
+}
+
+void Sketch::updateDatums(const std::vector<Constraint *> &ConstraintList)
+{
+    std::vector<ConstrDef>::iterator it = Constrs.begin();
+    for (std::size_t i = 0; i < ConstraintList.size(); i++) {
+        Constraint *constr = ConstraintList[i];
+        if (constr->Type == Block || !constr->isActive)
+            continue;
+
+        // the constraint list is a new one, e.g. after setDatum, the old constraints may be gone
+        it->constr = constr;
+        if (it->driving && it->value && hasPatchableDatum(constr)) {
+            *it->value = constr->getValue();
+            SetUpConstraints[i]->setValue(constr->getValue());
+        }
+        ++it;
+    }
+}
+
 void Sketch::fixParametersAndDiagnose(std::vector<double *> &params_to_block)
 {
     if(params_to_block.size() > 0) { // only there are parameters to fix
@@ -3968,7 +4084,7 @@ int Sketch::movePoint(int geoId, PointPos pos, Base::Vector3d toPoint, bool rela
             }
             else {
                 if( (toPoint-initToPoint).Length() > 20*moveStep) { // I am getting too far away from the original solution so reinit the solution
-                    initMove(geoId, pos);
+                    initMove(geoId, pos, isFine);
                     initToPoint = toPoint;
                 }
             }
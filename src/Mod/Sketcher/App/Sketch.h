@@ -107,6 +107,8 @@ public:
     inline const std::vector<int> &getPartiallyRedundant(void) const { return PartiallyRedundant; }
 
     inline float getSolveTime() const { return SolveTime; }
+    /// number of solver iterations of the last solve
+    inline int getSolveIterations() const { return GCSsys.getIterations(); }
 
     inline bool hasMalformedConstraints(void) const { return !MalformedConstraints.empty(); }
     inline const std::vector<int> &getMalformedConstraints(void) const { return MalformedConstraints; }
@@ -130,6 +132,12 @@ public:
      */
     void resetInitMove();
 
+    /** Makes the following solves of an initialized drag precise again. A drag initialized with
+      * fine=false is solved roughly: only the moved components are solved, starting from the last
+      * solution and within a time budget. The final position of a drag is solved precisely.
+      */
+    inline void setFineMove() { isFine = true; }
+
     /** move this point (or curve) to a new location and solve.
       * This will introduce some additional weak constraints expressing
       * a condition for satisfying the new point location!
@@ -424,6 +432,11 @@ protected:
 
     std::vector<GeoDef> Geoms;
     std::vector<ConstrDef> Constrs;
+
+    // copies of the constraints of the last set up, used to detect a set up with only changed datums
+    std::vector<std::unique_ptr<Constraint>> SetUpConstraints;
+    int SetUpExtGeoCount;
+    bool SetUpNeedsBlockAnalysis;
     GCS::System GCSsys;
     int ConstraintsCounter;
     std::vector<int> Conflicting;
@@ -498,6 +511,15 @@ private:
 
     void clearTemporaryConstraints(void);
 
+    /** returns true if the geometry is the one of the solver and the constraints only differ from the
+      * ones of the last set up in the datums, so that the solver can be kept and only the datums patched
+      */
+    bool isSetUpReusable(const std::vector<Part::Geometry *> &GeoList,
+                         const std::vector<Constraint *> &ConstraintList,
+                         int extGeoCount) const;
+    /// writes the datums of the driving constraints to the solver parameters of a reusable set up
+    void updateDatums(const std::vector<Constraint *> &ConstraintList);
+
     /// checks if the index bounds and converts negative indices to positive
     int checkGeoId(int geoId) const;
     GCS::Curve* getGCSCurveByGeoId(int geoId);
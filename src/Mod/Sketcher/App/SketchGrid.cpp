@@ -0,0 +1,130 @@
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+#endif
+
+#include "SketchGrid.h"
+
+using namespace Sketcher;
+
+// upper limit of cells along each side, keeps huge sketches with a few tiny elements bounded
+static const int MaxCellsPerSide = 1024;
+
+SketchGrid::SketchGrid()
+  : MinX(0), MinY(0), CellSize(1), CountX(0), CountY(0)
+{
+}
+
+bool SketchGrid::isBounded(const Base::BoundBox2d &box)
+{
+    return box.MaxX >= box.MinX && box.MaxY >= box.MinY;
+}
+
+void SketchGrid::clear()
+{
+    Boxes.clear();
+    Cells.clear();
+    Unbounded.clear();
+    CountX = CountY = 0;
+}
+
+void SketchGrid::build(const std::vector<Base::BoundBox2d> &boxes)
+{
+    clear();
+    Boxes = boxes;
+
+    Base::BoundBox2d extent;
+    extent.SetVoid();
+    int bounded = 0;
+    for (int id = 0; id < int(Boxes.size()); id++) {
+        const Base::BoundBox2d &box = Boxes[id];
+        if (!isBounded(box)) {
+            Unbounded.push_back(id);
+            continue;
+        }
+        extent.Add(Base::Vector2d(box.MinX, box.MinY));
+        extent.Add(Base::Vector2d(box.MaxX, box.MaxY));
+        bounded++;
+    }
+    if (bounded == 0)
+        return;
+
+    // about one element per cell for evenly spread elements
+    double width = std::max(extent.Width(), 1e-9);
+    double height = std::max(extent.Height(), 1e-9);
+    CellSize = std::sqrt(width * height / bounded);
+    CellSize = std::max(CellSize, std::max(width, height) / MaxCellsPerSide);
+    MinX = extent.MinX;
+    MinY = extent.MinY;
+    CountX = std::min(MaxCellsPerSide, int(width / CellSize) + 1);
+    CountY = std::min(MaxCellsPerSide, int(height / CellSize) + 1);
+    Cells.resize(CountX * CountY);
+
+    for (int id = 0; id < int(Boxes.size()); id++) {
+        if (!isBounded(Boxes[id]))
+            continue;
+        int imin, jmin, imax, jmax;
+        getCellRange(Boxes[id], imin, jmin, imax, jmax);
+        for (int j = jmin; j <= jmax; j++) {
+            for (int i = imin; i <= imax; i++)
+                Cells[j * CountX + i].push_back(id);
+        }
+    }
+}
+
+void SketchGrid::getCellRange(const Base::BoundBox2d &box, int &imin, int &jmin, int &imax, int &jmax) const
+{
+    auto cell = [this](double value, double origin, int count) {
+        double index = std::floor((value - origin) / CellSize);
+        return int(std::max(0.0, std::min(double(count - 1), index)));
+    };
+    imin = cell(box.MinX, MinX, CountX);
+    imax = cell(box.MaxX, MinX, CountX);
+    jmin = cell(box.MinY, MinY, CountY);
+    jmax = cell(box.MaxY, MinY, CountY);
+}
+
+std::vector<int> SketchGrid::query(const Base::BoundBox2d &box) const
+{
+    std::vector<int> result(Unbounded);
+    if (!Cells.empty()) {
+        int imin, jmin, imax, jmax;
+        getCellRange(box, imin, jmin, imax, jmax);
+        for (int j = jmin; j <= jmax; j++) {
+            for (int i = imin; i <= imax; i++) {
+                for (int id : Cells[j * CountX + i]) {
+                    const Base::BoundBox2d &other = Boxes[id];
+                    if (other.MinX <= box.MaxX && other.MaxX >= box.MinX &&
+                        other.MinY <= box.MaxY && other.MaxY >= box.MinY)
+                        result.push_back(id);
+                }
+            }
+        }
+    }
+
+    // elements spanning several cells are found more than once
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
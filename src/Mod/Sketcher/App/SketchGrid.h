@@ -0,0 +1,63 @@
+/***************************************************************************
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SKETCHER_SKETCHGRID_H
+#define SKETCHER_SKETCHGRID_H
+
+#include <vector>
+#include <Base/Tools2D.h>
+
+namespace Sketcher
+{
+
+/** A uniform grid over the bounding boxes of sketch elements (vertices or
+ *  geometries) to find the elements near a location without scanning all of them.
+ *
+ *  The element ids are the indices of the boxes passed to build(). An invalid
+ *  (void) box marks an element without known extent, it is returned by every query.
+ */
+class SketcherExport SketchGrid
+{
+public:
+    SketchGrid();
+
+    /// builds the grid over the given boxes, replacing the former content
+    void build(const std::vector<Base::BoundBox2d> &boxes);
+    void clear();
+
+    /// returns the ids of the elements whose box intersects the given box, in increasing order
+    std::vector<int> query(const Base::BoundBox2d &box) const;
+
+private:
+    static bool isBounded(const Base::BoundBox2d &box);
+    void getCellRange(const Base::BoundBox2d &box, int &imin, int &jmin, int &imax, int &jmax) const;
+
+private:
+    std::vector<Base::BoundBox2d> Boxes;
+    std::vector< std::vector<int> > Cells;
+    std::vector<int> Unbounded;
+    double MinX, MinY;
+    double CellSize;
+    int CountX, CountY;
+};
+
+} //namespace Sketcher
+
+#endif // SKETCHER_SKETCHGRID_H
@@ -695,7 +695,8 @@ int SketchObject::movePoint(int GeoId, PointPos PosId, const Base::Vector3d& toP
     if (lastHasConflict) // conflicting constraints
         return -1;
 
-    // move the point and solve
+    // move the point and solve, a temporary drag may have been solved roughly so far
+    solvedSketch.setFineMove();
     lastSolverStatus = solvedSketch.movePoint(GeoId, PosId, toPoint, relative);
 
     // moving the point can not result in a conflict that we did not have
@@ -6776,6 +6777,9 @@ void SketchObject::rebuildVertexIndex(void)
 {
     VertexId2GeoId.resize(0);
     VertexId2PosId.resize(0);
+    GeoId2VertexId.assign(getHighestCurveIndex() + 1, -1);
+    ExtGeoId2VertexId.assign(std::max(getExternalGeometryCount() - 2, 0), -1);
+    gridsNeedUpdate = true;
     int imax=getHighestCurveIndex();
     int i=0;
     const std::vector< Part::Geometry * > geometry = getCompleteGeometry();
@@ -6785,6 +6789,10 @@ void SketchObject::rebuildVertexIndex(void)
          it != geometry.end()-2; ++it, i++) {
         if (i > imax)
               i = -getExternalGeometryCount();
+        if (i >= 0)
+            GeoId2VertexId[i] = VertexId2GeoId.size();
+        else
+            ExtGeoId2VertexId[-i-3] = VertexId2GeoId.size();
         if ((*it)->getTypeId() == Part::GeomPoint::getClassTypeId()) {
             VertexId2GeoId.push_back(i);
             VertexId2PosId.push_back(start);
@@ -6833,7 +6841,112 @@ void SketchObject::rebuildVertexIndex(void)
             VertexId2GeoId.push_back(i);
             VertexId2PosId.push_back(end);
         }
+        if (i >= 0 && GeoId2VertexId[i] == int(VertexId2GeoId.size()))
+            GeoId2VertexId[i] = -1;
+        else if (i < 0 && ExtGeoId2VertexId[-i-3] == int(VertexId2GeoId.size()))
+            ExtGeoId2VertexId[-i-3] = -1;
+    }
+}
+
+static Base::BoundBox2d getGeometryBox(const Part::Geometry *geo)
+{
+    // conservative boxes, arcs of conics get the box of the whole conic
+    Base::BoundBox2d box;
+    box.SetVoid();
+    auto add = [&box](const Base::Vector3d &pnt) { box.Add(Base::Vector2d(pnt.x, pnt.y)); };
+    auto addRadius = [&](const Base::Vector3d &center, double radius) {
+        add(center - Base::Vector3d(radius, radius, 0));
+        add(center + Base::Vector3d(radius, radius, 0));
+    };
+
+    if (geo->getTypeId() == Part::GeomPoint::getClassTypeId()) {
+        add(static_cast<const Part::GeomPoint*>(geo)->getPoint());
+    } else if (geo->getTypeId() == Part::GeomLineSegment::getClassTypeId()) {
+        const Part::GeomLineSegment *lineSeg = static_cast<const Part::GeomLineSegment*>(geo);
+        add(lineSeg->getStartPoint());
+        add(lineSeg->getEndPoint());
+    } else if (geo->getTypeId() == Part::GeomCircle::getClassTypeId()) {
+        const Part::GeomCircle *circle = static_cast<const Part::GeomCircle*>(geo);
+        addRadius(circle->getCenter(), circle->getRadius());
+    } else if (geo->getTypeId() == Part::GeomArcOfCircle::getClassTypeId()) {
+        const Part::GeomArcOfCircle *aoc = static_cast<const Part::GeomArcOfCircle*>(geo);
+        addRadius(aoc->getCenter(), aoc->getRadius());
+    } else if (geo->getTypeId() == Part::GeomEllipse::getClassTypeId()) {
+        const Part::GeomEllipse *ellipse = static_cast<const Part::GeomEllipse*>(geo);
+        addRadius(ellipse->getCenter(), ellipse->getMajorRadius());
+    } else if (geo->getTypeId() == Part::GeomArcOfEllipse::getClassTypeId()) {
+        const Part::GeomArcOfEllipse *aoe = static_cast<const Part::GeomArcOfEllipse*>(geo);
+        addRadius(aoe->getCenter(), aoe->getMajorRadius());
+    } else if (geo->getTypeId() == Part::GeomBSplineCurve::getClassTypeId()) {
+        // the curve lies within the convex hull of its poles
+        std::vector<Base::Vector3d> poles = static_cast<const Part::GeomBSplineCurve*>(geo)->getPoles();
+        for (const auto &pole : poles)
+            add(pole);
+    }
+    // arcs of hyperbola and parabola stay void and are returned by every query
+
+    return box;
+}
+
+void SketchObject::updateGrids(void) const
+{
+    if (!gridsNeedUpdate)
+        return;
+
+    // the vertex index is outdated until the next rebuildVertexIndex (e.g. during undo/redo)
+    if (int(GeoId2VertexId.size()) != getHighestCurveIndex() + 1 ||
+        int(ExtGeoId2VertexId.size()) != std::max(getExternalGeometryCount() - 2, 0)) {
+        VertexGrid.clear();
+        GeometryGrid.clear();
+        GeometryGridGeoIds.clear();
+        return;
+    }
+    gridsNeedUpdate = false;
+
+    std::vector<Base::BoundBox2d> boxes;
+    boxes.reserve(VertexId2GeoId.size());
+    for (std::size_t i=0; i<VertexId2GeoId.size(); i++) {
+        Base::Vector3d pnt = getPoint(VertexId2GeoId[i], VertexId2PosId[i]);
+        boxes.emplace_back(pnt.x, pnt.y, pnt.x, pnt.y);
     }
+    VertexGrid.build(boxes);
+
+    boxes.clear();
+    GeometryGridGeoIds.clear();
+    for (int GeoId=0; GeoId<=getHighestCurveIndex(); GeoId++) {
+        boxes.push_back(getGeometryBox(getGeometry(GeoId)));
+        GeometryGridGeoIds.push_back(GeoId);
+    }
+    for (int GeoId=-3; GeoId>=-getExternalGeometryCount(); GeoId--) {
+        boxes.push_back(getGeometryBox(getGeometry(GeoId)));
+        GeometryGridGeoIds.push_back(GeoId);
+    }
+    GeometryGrid.build(boxes);
+}
+
+std::vector<int> SketchObject::getVerticesNear(const Base::Vector3d &point, double tolerance) const
+{
+    updateGrids();
+
+    std::vector<int> result;
+    Base::BoundBox2d box(point.x - tolerance, point.y - tolerance, point.x + tolerance, point.y + tolerance);
+    for (int VertexId : VertexGrid.query(box)) {
+        Base::Vector3d pnt = getPoint(VertexId2GeoId[VertexId], VertexId2PosId[VertexId]);
+        if (Base::Vector2d(pnt.x - point.x, pnt.y - point.y).Length() <= tolerance)
+            result.push_back(VertexId);
+    }
+    return result;
+}
+
+std::vector<int> SketchObject::getGeometriesNear(const Base::BoundBox2d &box, double tolerance) const
+{
+    updateGrids();
+
+    std::vector<int> result;
+    Base::BoundBox2d grown(box.MinX - tolerance, box.MinY - tolerance, box.MaxX + tolerance, box.MaxY + tolerance);
+    for (int id : GeometryGrid.query(grown))
+        result.push_back(GeometryGridGeoIds[id]);
+    return result;
 }
 
 const std::vector< std::map<int, Sketcher::PointPos> > SketchObject::getCoincidenceGroups()
@@ -7414,6 +7527,9 @@ void SketchObject::onChanged(const App::Property* prop)
         }
     }
 
+    if (prop == &Geometry)
+        gridsNeedUpdate = true; // positions may change without a rebuild of the vertex index
+
     if (prop == &Geometry || prop == &Constraints) {
 
         auto doc = getDocument();
@@ -7610,8 +7726,17 @@ void SketchObject::getGeoVertexIndex(int VertexId, int &GeoId, PointPos &PosId)
 
 int SketchObject::getVertexIndexGeoPos(int GeoId, PointPos PosId) const
 {
-    for(std::size_t i=0;i<VertexId2GeoId.size();i++) {
-        if(VertexId2GeoId[i]==GeoId && VertexId2PosId[i]==PosId)
+    int first = -1;
+    if (GeoId >= 0 && GeoId < int(GeoId2VertexId.size()))
+        first = GeoId2VertexId[GeoId];
+    else if (GeoId <= -3 && -GeoId-3 < int(ExtGeoId2VertexId.size()))
+        first = ExtGeoId2VertexId[-GeoId-3];
+    if (first < 0)
+        return -1;
+
+    // the vertices of a geometry are consecutive
+    for(std::size_t i=first;i<VertexId2GeoId.size() && VertexId2GeoId[i]==GeoId;i++) {
+        if(VertexId2PosId[i]==PosId)
             return i;
     }
 
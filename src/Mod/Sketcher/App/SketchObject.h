@@ -40,6 +40,8 @@
 
 #include "Sketch.h"
 
+#include "SketchGrid.h"
+
 #include "SketchGeometryExtension.h"
 
 namespace Sketcher
@@ -289,6 +291,11 @@ public:
     /// retrieves for a GeoId and PosId the Vertex number
     int getVertexIndexGeoPos(int GeoId, PointPos PosId) const;
 
+    /// retrieves the Vertex numbers of the vertices within tolerance of the point (complete geometry, except the axes)
+    std::vector<int> getVerticesNear(const Base::Vector3d &point, double tolerance) const;
+    /// retrieves the GeoIds of the geometries whose bounding box is within tolerance of the given box (complete geometry, except the axes)
+    std::vector<int> getGeometriesNear(const Base::BoundBox2d &box, double tolerance) const;
+
     // retrieves an array of maps, each map containing the points that are coincidence by virtue of
     // any number of direct or indirect coincidence constraints
     const std::vector< std::map<int, Sketcher::PointPos> > getCoincidenceGroups();
@@ -507,6 +514,18 @@ private:
 
     std::vector<int> VertexId2GeoId;
     std::vector<PointPos> VertexId2PosId;
+    // first Vertex number of each internal geometry (indexed by GeoId) and
+    // external geometry (indexed by -GeoId-3), -1 for geometries without vertices
+    std::vector<int> GeoId2VertexId;
+    std::vector<int> ExtGeoId2VertexId;
+
+    // spatial indices over the vertices and the bounding boxes of the geometries,
+    // built on the first query after the geometry changed
+    void updateGrids(void) const;
+    mutable SketchGrid VertexGrid;
+    mutable SketchGrid GeometryGrid;
+    mutable std::vector<int> GeometryGridGeoIds;
+    mutable bool gridsNeedUpdate;
 
     Sketch solvedSketch;
 
@@ -141,6 +141,43 @@ PyObject* SketchPy::addConstraint(PyObject *args)
     }
 }
 
+PyObject* SketchPy::setUp(PyObject *args)
+{
+    PyObject *pcGeo, *pcCon;
+    int extGeoCount=0;
+    if (!PyArg_ParseTuple(args, "OO|i", &pcGeo, &pcCon, &extGeoCount))
+        return 0;
+
+    std::vector<Part::Geometry *> geoList;
+    Py::Sequence geos(pcGeo);
+    for (Py::Sequence::iterator it = geos.begin(); it != geos.end(); ++it) {
+        if (!PyObject_TypeCheck((*it).ptr(), &(Part::GeometryPy::Type))) {
+            std::string error = std::string("type must be 'Geometry', not ");
+            error += (*it).ptr()->ob_type->tp_name;
+            throw Py::TypeError(error);
+        }
+        geoList.push_back(static_cast<Part::GeometryPy*>((*it).ptr())->getGeometryPtr());
+    }
+
+    std::vector<Constraint *> conList;
+    Py::Sequence cons(pcCon);
+    for (Py::Sequence::iterator it = cons.begin(); it != cons.end(); ++it) {
+        if (!PyObject_TypeCheck((*it).ptr(), &(ConstraintPy::Type))) {
+            std::string error = std::string("type must be 'Constraint', not ");
+            error += (*it).ptr()->ob_type->tp_name;
+            throw Py::TypeError(error);
+        }
+        conList.push_back(static_cast<ConstraintPy*>((*it).ptr())->getConstraintPtr());
+    }
+
+    if (extGeoCount < 0 || extGeoCount > int(geoList.size())) {
+        PyErr_SetString(PyExc_ValueError, "external geometry count out of range");
+        return 0;
+    }
+
+    return Py::new_reference_to(Py::Long(getSketchPtr()->setUpSketch(geoList, conList, extGeoCount)));
+}
+
 PyObject* SketchPy::clear(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
@@ -203,6 +240,54 @@ Py::Object SketchPy::getShape(void) const
     return Py::asObject(new TopoShapePy(new TopoShape(getSketchPtr()->toShape())));
 }
 
+Py::String SketchPy::getAlgorithm(void) const
+{
+    switch (getSketchPtr()->defaultSolver) {
+    case GCS::BFGS:
+        return Py::String("BFGS");
+    case GCS::LevenbergMarquardt:
+        return Py::String("LevenbergMarquardt");
+    default:
+        return Py::String("DogLeg");
+    }
+}
+
+void SketchPy::setAlgorithm(Py::String arg)
+{
+    std::string name = arg.as_std_string("ascii");
+    if (name == "BFGS")
+        getSketchPtr()->defaultSolver = GCS::BFGS;
+    else if (name == "LevenbergMarquardt")
+        getSketchPtr()->defaultSolver = GCS::LevenbergMarquardt;
+    else if (name == "DogLeg")
+        getSketchPtr()->defaultSolver = GCS::DogLeg;
+    else
+        throw Py::ValueError("Algorithm must be 'BFGS', 'LevenbergMarquardt' or 'DogLeg'");
+}
+
+Py::String SketchPy::getQRAlgorithm(void) const
+{
+    if (getSketchPtr()->getQRAlgorithm() == GCS::EigenDenseQR)
+        return Py::String("DenseQR");
+    return Py::String("SparseQR");
+}
+
+void SketchPy::setQRAlgorithm(Py::String arg)
+{
+    std::string name = arg.as_std_string("ascii");
+    if (name == "DenseQR")
+        getSketchPtr()->setQRAlgorithm(GCS::EigenDenseQR);
+    else if (name == "SparseQR")
+        getSketchPtr()->setQRAlgorithm(GCS::EigenSparseQR);
+    else
+        throw Py::ValueError("QRAlgorithm must be 'DenseQR' or 'SparseQR'");
+}
+
+Py::Long SketchPy::getIterations(void) const
+{
+    return Py::Long(getSketchPtr()->getSolveIterations());
+}
+
 
 // +++ custom attributes implementer ++++++++++++++++++++++++++++++++++++++++
 
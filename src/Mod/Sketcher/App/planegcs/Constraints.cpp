@@ -79,6 +79,12 @@ double Constraint::grad(double * /*param*/)
     return 0.;
 }
 
+void Constraint::grads(double *deriv)
+{
+    for (std::size_t i=0; i<pvec.size(); i++)
+        deriv[i] = (findParamInPvec(pvec[i]) == static_cast<int>(i)) ? grad(pvec[i]) : 0.;
+}
+
 double Constraint::maxStep(MAP_pD_D & /*dir*/, double lim)
 {
     return lim;
@@ -129,6 +135,12 @@ double ConstraintEqual::grad(double *param)
     return scale * deriv;
 }
 
+void ConstraintEqual::grads(double *deriv)
+{
+    deriv[0] = scale;
+    deriv[1] = -scale;
+}
+
 // Difference
 ConstraintDifference::ConstraintDifference(double *p1, double *p2, double *d)
 {
@@ -163,6 +175,13 @@ double ConstraintDifference::grad(double *param)
     return scale * deriv;
 }
 
+void ConstraintDifference::grads(double *deriv)
+{
+    deriv[0] = -scale;
+    deriv[1] = scale;
+    deriv[2] = -scale;
+}
+
 // P2PDistance
 ConstraintP2PDistance::ConstraintP2PDistance(Point &p1, Point &p2, double *d)
 {
@@ -212,6 +231,18 @@ double ConstraintP2PDistance::grad(double *param)
     return scale * deriv;
 }
 
+void ConstraintP2PDistance::grads(double *deriv)
+{
+    double dx = (*p1x() - *p2x());
+    double dy = (*p1y() - *p2y());
+    double d = sqrt(dx*dx + dy*dy);
+    deriv[0] = scale * (dx/d);
+    deriv[1] = scale * (dy/d);
+    deriv[2] = scale * (-dx/d);
+    deriv[3] = scale * (-dy/d);
+    deriv[4] = -scale;
+}
+
 double ConstraintP2PDistance::maxStep(MAP_pD_D &dir, double lim)
 {
     MAP_pD_D::iterator it;
@@ -303,6 +334,25 @@ double ConstraintP2PAngle::grad(double *param)
     return scale * deriv;
 }
 
+void ConstraintP2PAngle::grads(double *deriv)
+{
+    double dx = (*p2x() - *p1x());
+    double dy = (*p2y() - *p1y());
+    double a = *angle() + da;
+    double ca = cos(a);
+    double sa = sin(a);
+    double x = dx*ca + dy*sa;
+    double y = -dx*sa + dy*ca;
+    double r2 = dx*dx+dy*dy;
+    dx = -y/r2;
+    dy = x/r2;
+    deriv[0] = scale * (-ca*dx + sa*dy);
+    deriv[1] = scale * (-sa*dx - ca*dy);
+    deriv[2] = scale * ( ca*dx - sa*dy);
+    deriv[3] = scale * ( sa*dx + ca*dy);
+    deriv[4] = -scale;
+}
+
 double ConstraintP2PAngle::maxStep(MAP_pD_D &dir, double lim)
 {
     // step(angle()) <= pi/18 = 10°
@@ -381,6 +431,25 @@ double ConstraintP2LDistance::grad(double *param)
     return scale * deriv;
 }
 
+void ConstraintP2LDistance::grads(double *deriv)
+{
+    double x0=*p0x(), x1=*p1x(), x2=*p2x();
+    double y0=*p0y(), y1=*p1y(), y2=*p2y();
+    double dx = x2-x1;
+    double dy = y2-y1;
+    double d2 = dx*dx+dy*dy;
+    double d = sqrt(d2);
+    double area = -x0*dy+y0*dx+x1*y2-x2*y1;
+    double sign = (area < 0) ? -1. : 1.;
+    deriv[0] = scale * (sign * ((y1-y2) / d));
+    deriv[1] = scale * (sign * ((x2-x1) / d));
+    deriv[2] = scale * (sign * (((y2-y0)*d + (dx/d)*area) / d2));
+    deriv[3] = scale * (sign * (((x0-x2)*d + (dy/d)*area) / d2));
+    deriv[4] = scale * (sign * (((y0-y1)*d - (dx/d)*area) / d2));
+    deriv[5] = scale * (sign * (((x1-x0)*d - (dy/d)*area) / d2));
+    deriv[6] = -scale;
+}
+
 double ConstraintP2LDistance::maxStep(MAP_pD_D &dir, double lim)
 {
     MAP_pD_D::iterator it;
@@ -493,6 +562,23 @@ double ConstraintPointOnLine::grad(double *param)
     return scale * deriv;
 }
 
+void ConstraintPointOnLine::grads(double *deriv)
+{
+    double x0=*p0x(), x1=*p1x(), x2=*p2x();
+    double y0=*p0y(), y1=*p1y(), y2=*p2y();
+    double dx = x2-x1;
+    double dy = y2-y1;
+    double d2 = dx*dx+dy*dy;
+    double d = sqrt(d2);
+    double area = -x0*dy+y0*dx+x1*y2-x2*y1;
+    deriv[0] = scale * ((y1-y2) / d);
+    deriv[1] = scale * ((x2-x1) / d);
+    deriv[2] = scale * (((y2-y0)*d + (dx/d)*area) / d2);
+    deriv[3] = scale * (((x0-x2)*d + (dy/d)*area) / d2);
+    deriv[4] = scale * (((y0-y1)*d - (dx/d)*area) / d2);
+    deriv[5] = scale * (((x1-x0)*d - (dy/d)*area) / d2);
+}
+
 // PointOnPerpBisector
 ConstraintPointOnPerpBisector::ConstraintPointOnPerpBisector(Point &p, Line &l)
 {
@@ -622,6 +708,22 @@ double ConstraintParallel::grad(double *param)
     return scale * deriv;
 }
 
+void ConstraintParallel::grads(double *deriv)
+{
+    double dx1 = (*l1p1x() - *l1p2x());
+    double dy1 = (*l1p1y() - *l1p2y());
+    double dx2 = (*l2p1x() - *l2p2x());
+    double dy2 = (*l2p1y() - *l2p2y());
+    deriv[0] = scale * dy2;  // l1p1x
+    deriv[1] = scale * -dx2; // l1p1y
+    deriv[2] = scale * -dy2; // l1p2x
+    deriv[3] = scale * dx2;  // l1p2y
+    deriv[4] = scale * -dy1; // l2p1x
+    deriv[5] = scale * dx1;  // l2p1y
+    deriv[6] = scale * dy1;  // l2p2x
+    deriv[7] = scale * -dx1; // l2p2y
+}
+
 // Perpendicular
 ConstraintPerpendicular::ConstraintPerpendicular(Line &l1, Line &l2)
 {
@@ -691,6 +793,22 @@ double ConstraintPerpendicular::grad(double *param)
     return scale * deriv;
 }
 
+void ConstraintPerpendicular::grads(double *deriv)
+{
+    double dx1 = (*l1p1x() - *l1p2x());
+    double dy1 = (*l1p1y() - *l1p2y());
+    double dx2 = (*l2p1x() - *l2p2x());
+    double dy2 = (*l2p1y() - *l2p2y());
+    deriv[0] = scale * dx2;  // l1p1x
+    deriv[1] = scale * dy2;  // l1p1y
+    deriv[2] = scale * -dx2; // l1p2x
+    deriv[3] = scale * -dy2; // l1p2y
+    deriv[4] = scale * dx1;  // l2p1x
+    deriv[5] = scale * dy1;  // l2p1y
+    deriv[6] = scale * -dx1; // l2p2x
+    deriv[7] = scale * -dy1; // l2p2y
+}
+
 // L2LAngle
 ConstraintL2LAngle::ConstraintL2LAngle(Line &l1, Line &l2, double *a)
 {
@@ -784,6 +902,33 @@ double ConstraintL2LAngle::grad(double *param)
     return scale * deriv;
 }
 
+void ConstraintL2LAngle::grads(double *deriv)
+{
+    double dx1 = (*l1p2x() - *l1p1x());
+    double dy1 = (*l1p2y() - *l1p1y());
+    double r1 = dx1*dx1+dy1*dy1;
+    deriv[0] = scale * (-dy1/r1);
+    deriv[1] = scale * (dx1/r1);
+    deriv[2] = scale * (dy1/r1);
+    deriv[3] = scale * (-dx1/r1);
+
+    double dx2 = (*l2p2x() - *l2p1x());
+    double dy2 = (*l2p2y() - *l2p1y());
+    double a = atan2(dy1,dx1) + *angle();
+    double ca = cos(a);
+    double sa = sin(a);
+    double x2 = dx2*ca + dy2*sa;
+    double y2 = -dx2*sa + dy2*ca;
+    double r2 = dx2*dx2+dy2*dy2;
+    dx2 = -y2/r2;
+    dy2 = x2/r2;
+    deriv[4] = scale * (-ca*dx2 + sa*dy2);
+    deriv[5] = scale * (-sa*dx2 - ca*dy2);
+    deriv[6] = scale * ( ca*dx2 - sa*dy2);
+    deriv[7] = scale * ( sa*dx2 + ca*dy2);
+    deriv[8] = -scale;
+}
+
 double ConstraintL2LAngle::maxStep(MAP_pD_D &dir, double lim)
 {
     // step(angle()) <= pi/18 = 10°
@@ -119,7 +119,10 @@ namespace GCS
         virtual void rescale(double coef=1.);
         virtual double error();
         virtual double grad(double *);
-        // virtual void grad(MAP_pD_D &deriv);  --> TODO: vectorized grad version
+        // Computes the derivatives with respect to all the entries of pvec at once, so that they
+        // share their subexpressions. deriv must hold pvec.size() values. A parameter appearing
+        // more than once in pvec has the sum of its entries as derivative, i.e. grad(param).
+        virtual void grads(double *deriv);
         virtual double maxStep(MAP_pD_D &dir, double lim=1.);
         // Finds first occurrence of param in pvec. This is useful to test if a constraint depends
         // on the parameter (it may not actually depend on it, e.g. angle-via-point doesn't depend
@@ -141,6 +144,7 @@ namespace GCS
         virtual void rescale(double coef=1.);
         virtual double error();
         virtual double grad(double *);
+        virtual void grads(double *deriv);
     };
 
     // Difference
@@ -156,6 +160,7 @@ namespace GCS
         virtual void rescale(double coef=1.);
         virtual double error();
         virtual double grad(double *);
+        virtual void grads(double *deriv);
     };
 
     // P2PDistance
@@ -176,6 +181,7 @@ namespace GCS
         virtual void rescale(double coef=1.);
         virtual double error();
         virtual double grad(double *);
+        virtual void grads(double *deriv);
         virtual double maxStep(MAP_pD_D &dir, double lim=1.);
     };
 
@@ -198,6 +204,7 @@ namespace GCS
         virtual void rescale(double coef=1.);
         virtual double error();
         virtual double grad(double *);
+        virtual void grads(double *deriv);
         virtual double maxStep(MAP_pD_D &dir, double lim=1.);
     };
 
@@ -221,6 +228,7 @@ namespace GCS
         virtual void rescale(double coef=1.);
         virtual double error();
         virtual double grad(double *);
+        virtual void grads(double *deriv);
         virtual double maxStep(MAP_pD_D &dir, double lim=1.);
         double abs(double darea);
     };
@@ -245,6 +253,7 @@ namespace GCS
         virtual void rescale(double coef=1.);
         virtual double error();
         virtual double grad(double *);
+        virtual void grads(double *deriv);
     };
 
     // PointOnPerpBisector
@@ -292,6 +301,7 @@ namespace GCS
         virtual void rescale(double coef=1.);
         virtual double error();
         virtual double grad(double *);
+        virtual void grads(double *deriv);
     };
 
     // Perpendicular
@@ -316,6 +326,7 @@ namespace GCS
         virtual void rescale(double coef=1.);
         virtual double error();
         virtual double grad(double *);
+        virtual void grads(double *deriv);
     };
 
     // L2LAngle
@@ -342,6 +353,7 @@ namespace GCS
         virtual void rescale(double coef=1.);
         virtual double error();
         virtual double grad(double *);
+        virtual void grads(double *deriv);
         virtual double maxStep(MAP_pD_D &dir, double lim=1.);
     };
 
@@ -54,6 +54,9 @@
 #include <cfloat>
 #include <limits>
 #include <future>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -473,6 +476,9 @@ System::System()
   , DL_tolgRedundant(1E-80)
   , DL_tolxRedundant(1E-80)
   , DL_tolfRedundant(1E-10)
+  , sparseSolverThreshold(300)
+  , parallelSolverThreshold(200)
+  , roughSolveTimeLimit(0.02)
 {
     // currently Eigen only supports multithreading for multiplications
     // There is no appreciable gain from using more threads
@@ -1388,6 +1394,18 @@ void System::rescaleConstraint(int id, double coeff)
         clist[id]->rescale(coeff);
 }
 
+int System::getIterations() const
+{
+    int iterations = 0;
+    for (std::size_t cid=0; cid < subSystems.size(); cid++) {
+        if (subSystems[cid])
+            iterations += subSystems[cid]->getIterations();
+        if (subSystemsAux[cid])
+            iterations += subSystemsAux[cid]->getIterations();
+    }
+    return iterations;
+}
+
 void System::declareUnknowns(VEC_pD &params)
 {
     plist = params;
@@ -1563,22 +1581,70 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
     if (!isInit)
         return Failed;
 
-    bool isReset = false;
-    // return success by default in order to permit coincidence constraints to be applied
-    // even if no other system has to be solved
-    int res = Success;
+    // A rough solve (e.g. of a drag) only solves the components with constraints tagged < 0,
+    // i.e. the ones moved by the temporary constraints, the others keep their values. It starts
+    // from the current parameter values (the last applied solution) instead of the reference.
+    std::vector<int> cids;
+    int xsize = 0;
     for (int cid=0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
-             resetToReference();
-             isReset = true;
+        if (isFine ? (subSystems[cid] || subSystemsAux[cid]) : subSystemsAux[cid] != NULL) {
+            cids.push_back(cid);
+            xsize += subSystems[cid] ? subSystems[cid]->pSize() : 0;
+            xsize += subSystemsAux[cid] ? subSystemsAux[cid]->pSize() : 0;
         }
+    }
+    if (!cids.empty() && isFine)
+        resetToReference();
+
+    for (int cid=0; cid < int(subSystems.size()); cid++) {
+        if (subSystems[cid])
+            subSystems[cid]->setIterations(0);
+        if (subSystemsAux[cid])
+            subSystemsAux[cid]->setIterations(0);
+    }
+
+    std::vector<int> results(cids.size(), Success);
+    auto solveComponent = [&](std::size_t i) {
+        int cid = cids[i];
         if (subSystems[cid] && subSystemsAux[cid])
-            res = std::max(res, solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
+            results[i] = solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving);
         else if (subSystems[cid])
-            res = std::max(res, solve(subSystems[cid], isFine, alg, isRedundantsolving));
-        else if (subSystemsAux[cid])
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg, isRedundantsolving));
+            results[i] = solve(subSystems[cid], isFine, alg, isRedundantsolving);
+        else
+            results[i] = solve(subSystemsAux[cid], isFine, alg, isRedundantsolving);
+    };
+
+    // The components share neither constraints nor parameters and every subsystem works on its
+    // own copy of the parameters, so they can be solved concurrently. Base::Console is not
+    // thread-safe, so the iteration level debug output keeps the sequential solving.
+    unsigned int numThreads = std::min<std::size_t>(cids.size(), std::thread::hardware_concurrency());
+    bool parallel = numThreads > 1 && xsize >= parallelSolverThreshold && debugMode != IterationLevel;
+#ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
+    parallel = false;
+#endif
+    if (parallel) {
+        std::atomic<std::size_t> next(0);
+        auto worker = [&]() {
+            for (std::size_t i = next++; i < cids.size(); i = next++)
+                solveComponent(i);
+        };
+        std::vector< std::future<void> > futures;
+        for (unsigned int t=1; t < numThreads; t++)
+            futures.push_back(std::async(std::launch::async, worker));
+        worker();
+        for (std::size_t t=0; t < futures.size(); t++)
+            futures[t].get();
+    }
+    else {
+        for (std::size_t i=0; i < cids.size(); i++)
+            solveComponent(i);
     }
+
+    // return success by default in order to permit coincidence constraints to be applied
+    // even if no other system has to be solved
+    int res = Success;
+    for (std::size_t i=0; i < results.size(); i++)
+        res = std::max(res, results[i]);
     if (res == Success) {
         for (std::set<Constraint *>::const_iterator constr=redundant.begin();
              constr != redundant.end(); ++constr){
@@ -1597,6 +1663,7 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
 
 int System::solve(SubSystem *subsys, bool isFine, Algorithm alg, bool isRedundantsolving)
 {
+    subsys->setIterations(0);
     if (alg == BFGS)
         return solve_BFGS(subsys, isFine, isRedundantsolving);
     else if (alg == LevenbergMarquardt)
@@ -1658,7 +1725,8 @@ int System::solve_BFGS(SubSystem *subsys, bool /*isFine*/, bool isRedundantsolvi
     double divergingLim = 1e6*err + 1e12;
     double h_norm;
 
-    for (int iter=1; iter < maxIterNumber; iter++) {
+    int iter;
+    for (iter=1; iter < maxIterNumber; iter++) {
         h_norm = h.norm();
         if (h_norm <= (isRedundantsolving?convergenceRedundant:convergence) || err <= smallF){
            if(debugMode==IterationLevel) {
@@ -1722,6 +1790,7 @@ int System::solve_BFGS(SubSystem *subsys, bool /*isFine*/, bool isRedundantsolvi
     }
 
     subsys->revertParams();
+    subsys->setIterations(iter);
 
     if (err <= smallF)
         return Success;
@@ -1743,10 +1812,22 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         return Success;
 
     Eigen::VectorXd e(csize), e_new(csize); // vector of all function errors (every constraint is one function)
-    Eigen::MatrixXd J(csize, xsize);        // Jacobi of the subsystem
-    Eigen::MatrixXd A(xsize, xsize);
+    Eigen::MatrixXd J;                      // Jacobi of the subsystem (sized by calcJacobi)
+    Eigen::MatrixXd A;
     Eigen::VectorXd x(xsize), h(xsize), x_new(xsize), g(xsize), diag_A(xsize);
 
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    // In big sketches every constraint only depends on a few parameters, so the normal
+    // equations are sparse and far cheaper to factorize than with a dense LU decomposition
+    bool sparse = xsize >= sparseSolverThreshold;
+    Eigen::SparseMatrix<double> Js, As, Is;
+    Eigen::SimplicialLDLT< Eigen::SparseMatrix<double> > ldltA;
+    if (sparse) {
+        Is.resize(xsize, xsize);
+        Is.setIdentity();
+    }
+#endif
+
     subsys->redirectParams();
 
     subsys->getParams(x);
@@ -1792,14 +1873,29 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         }
 
         // J^T J, J^T e
-        subsys->calcJacobi(J);;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (sparse) {
+            subsys->calcJacobi(Js);
+
+            As = Js.transpose()*Js;
+            g = Js.transpose()*e;
+            diag_A = As.diagonal();
+
+            Eigen::SparseMatrix<double> Aaug = As + Is;
+            ldltA.analyzePattern(Aaug);
+        }
+        else
+#endif
+        {
+            subsys->calcJacobi(J);
 
-        A = J.transpose()*J;
-        g = J.transpose()*e;
+            A = J.transpose()*J;
+            g = J.transpose()*e;
+            diag_A = A.diagonal(); // save diagonal entries so that augmentation can be later canceled
+        }
 
         // Compute ||J^T e||_inf
         double g_inf = g.lpNorm<Eigen::Infinity>();
-        diag_A = A.diagonal(); // save diagonal entries so that augmentation can be later canceled
 
         // check for convergence
         if (g_inf <= eps1) {
@@ -1815,13 +1911,31 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         // determine increment using adaptive damping
         int k=0;
         while (k < 50) {
-            // augment normal equations A = A+uI
-            for (int i=0; i < xsize; ++i)
-                A(i,i) += mu;
+            double rel_error;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            if (sparse) {
+                // augment normal equations A = A+uI and solve A*h=-g,
+                // A is positive definite for u > 0
+                Eigen::SparseMatrix<double> Aaug = As + mu*Is;
+                ldltA.factorize(Aaug);
+                if (ldltA.info() == Eigen::Success) {
+                    h = ldltA.solve(g);
+                    rel_error = (Aaug*h - g).norm() / g.norm();
+                }
+                else
+                    rel_error = std::numeric_limits<double>::infinity();
+            }
+            else
+#endif
+            {
+                // augment normal equations A = A+uI
+                for (int i=0; i < xsize; ++i)
+                    A(i,i) += mu;
 
-            //solve augmented functions A*h=-g
-            h = A.fullPivLu().solve(g);
-            double rel_error = (A*h - g).norm() / g.norm();
+                //solve augmented functions A*h=-g
+                h = A.fullPivLu().solve(g);
+                rel_error = (A*h - g).norm() / g.norm();
+            }
 
             // check if solving works
             if (rel_error < 1e-5) {
@@ -1868,6 +1982,9 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
             mu*=nu;
             nu*=2.0;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            if (!sparse)
+#endif
             for (int i=0; i < xsize; ++i) // restore diagonal J^T J entries
                 A(i,i) = diag_A(i);
 
@@ -1895,6 +2012,7 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         stop = 5;
 
     subsys->revertParams();
+    subsys->setIterations(iter);
 
     return (stop == 1) ? Success : Failed;
 }
@@ -1937,17 +2055,33 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
 
     Eigen::VectorXd x(xsize), x_new(xsize);
     Eigen::VectorXd fx(csize), fx_new(csize);
-    Eigen::MatrixXd Jx(csize, xsize), Jx_new(csize, xsize);
+    Eigen::MatrixXd Jx, Jx_new; // sized by calcJacobi
     Eigen::VectorXd g(xsize), h_sd(xsize), h_gn(xsize), h_dl(xsize);
 
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    // The least norm Gauss-Newton step of big sketches is computed with a sparse LDLT of J*J^T.
+    // The full pivoting LU decompositions have no sparse counterpart giving the same steps
+    // (the basic solution of a sparse QR converges far worse), so they keep the dense jacobian.
+    bool sparse = xsize >= sparseSolverThreshold && dogLegGaussStep == LeastNormLdlt;
+    Eigen::SparseMatrix<double> Jxs, Jxs_new;
+#endif
+
     subsys->redirectParams();
 
     double err;
     subsys->getParams(x);
     subsys->calcResidual(fx, err);
-    subsys->calcJacobi(Jx);
-
-    g = Jx.transpose()*(-fx);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+    if (sparse) {
+        subsys->calcJacobi(Jxs);
+        g = Jxs.transpose()*(-fx);
+    }
+    else
+#endif
+    {
+        subsys->calcJacobi(Jx);
+        g = Jx.transpose()*(-fx);
+    }
 
     // get the infinity norm fx_inf and g_inf
     double g_inf = g.lpNorm<Eigen::Infinity>();
@@ -1974,26 +2108,56 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
             stop = 6;
         }
         else {
-            // get the steepest descent direction
-            alpha = g.squaredNorm()/(Jx*g).squaredNorm();
-            h_sd  = alpha*g;
-
-            // get the gauss-newton step
-            // http://forum.freecadweb.org/viewtopic.php?f=10&t=12769&start=50#p106220
-            // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
-            switch (dogLegGaussStep){
-                case FullPivLU:
-                    h_gn = Jx.fullPivLu().solve(-fx);
-                    break;
-                case LeastNormFullPivLU:
-                    h_gn = Jx.adjoint()*(Jx*Jx.adjoint()).fullPivLu().solve(-fx);
-                    break;
-                case LeastNormLdlt:
-                    h_gn = Jx.adjoint()*(Jx*Jx.adjoint()).ldlt().solve(-fx);
-                    break;
+            bool dense = true;
+            double rel_error = 0.;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            if (sparse) {
+                // get the steepest descent direction
+                alpha = g.squaredNorm()/(Jxs*g).squaredNorm();
+                h_sd  = alpha*g;
+
+                // get the gauss-newton step from the sparse J*J^T; if it is singular
+                // (redundant constraints), the dense decomposition is used for this step
+                Eigen::SparseMatrix<double> JJt = Jxs*Jxs.transpose();
+                Eigen::SimplicialLDLT< Eigen::SparseMatrix<double> > ldltJx(JJt);
+                if (ldltJx.info() == Eigen::Success) {
+                    h_gn = Jxs.transpose()*ldltJx.solve(-fx);
+                    dense = false;
+                }
+
+                if (!dense) {
+                    rel_error = (Jxs*h_gn + fx).norm() / fx.norm();
+                    dense = rel_error > 1e-5;
+                }
+                if (dense)
+                    Jx = Eigen::MatrixXd(Jxs);
+            }
+            else
+#endif
+            {
+                // get the steepest descent direction
+                alpha = g.squaredNorm()/(Jx*g).squaredNorm();
+                h_sd  = alpha*g;
             }
 
-            double rel_error = (Jx*h_gn + fx).norm() / fx.norm();
+            if (dense) {
+                // get the gauss-newton step
+                // http://forum.freecadweb.org/viewtopic.php?f=10&t=12769&start=50#p106220
+                // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
+                switch (dogLegGaussStep){
+                    case FullPivLU:
+                        h_gn = Jx.fullPivLu().solve(-fx);
+                        break;
+                    case LeastNormFullPivLU:
+                        h_gn = Jx.adjoint()*(Jx*Jx.adjoint()).fullPivLu().solve(-fx);
+                        break;
+                    case LeastNormLdlt:
+                        h_gn = Jx.adjoint()*(Jx*Jx.adjoint()).ldlt().solve(-fx);
+                        break;
+                }
+
+                rel_error = (Jx*h_gn + fx).norm() / fx.norm();
+            }
             if (rel_error > 1e15)
                 break;
 
@@ -2041,20 +2205,39 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         x_new = x + h_dl;
         subsys->setParams(x_new);
         subsys->calcResidual(fx_new, err_new);
-        subsys->calcJacobi(Jx_new);
 
         // calculate the linear model and the update ratio
-        double dL = err - 0.5*(fx + Jx*h_dl).squaredNorm();
+        double dL;
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+        if (sparse) {
+            subsys->calcJacobi(Jxs_new);
+            dL = err - 0.5*(fx + Jxs*h_dl).squaredNorm();
+        }
+        else
+#endif
+        {
+            subsys->calcJacobi(Jx_new);
+            dL = err - 0.5*(fx + Jx*h_dl).squaredNorm();
+        }
         double dF = err - err_new;
         double rho = dL/dF;
 
         if (dF > 0 && dL > 0) {
             x  = x_new;
-            Jx = Jx_new;
             fx = fx_new;
             err = err_new;
 
-            g = Jx.transpose()*(-fx);
+#ifdef EIGEN_SPARSEQR_COMPATIBLE
+            if (sparse) {
+                Jxs = Jxs_new;
+                g = Jxs.transpose()*(-fx);
+            }
+            else
+#endif
+            {
+                Jx = Jx_new;
+                g = Jx.transpose()*(-fx);
+            }
 
             // get infinity norms
             g_inf = g.lpNorm<Eigen::Infinity>();
@@ -2095,6 +2278,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
     }
 
     subsys->revertParams();
+    subsys->setIterations(iter);
 
     if(debugMode==IterationLevel) {
         std::stringstream stream;
@@ -3639,8 +3823,10 @@ void System::extractSubsystem(SubSystem *subsys, bool isRedundantsolving)
 
 // The following solver variant solves a system compound of two subsystems
 // treating the first of them as of higher priority than the second
-int System::solve(SubSystem *subsysA, SubSystem *subsysB, bool /*isFine*/, bool isRedundantsolving)
+int System::solve(SubSystem *subsysA, SubSystem *subsysB, bool isFine, bool isRedundantsolving)
 {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     int xsizeA = subsysA->pSize();
     int xsizeB = subsysB->pSize();
     int csizeA = subsysA->cSize();
@@ -3694,7 +3880,8 @@ int System::solve(SubSystem *subsysA, SubSystem *subsysB, bool /*isFine*/, bool
 
     double mu = 0;
     lambda.setZero();
-    for (int iter=1; iter < maxIterNumber; iter++) {
+    int iter;
+    for (iter=1; iter < maxIterNumber; iter++) {
         int status = qp_eq(B, grad, JA, resA, xdir, Y, Z);
         if (status)
             break;
@@ -3787,6 +3974,11 @@ int System::solve(SubSystem *subsysA, SubSystem *subsysB, bool /*isFine*/, bool
             break;
         if (err > divergingLim || err != err) // check for diverging and NaN
             break;
+
+        // a rough solve stops at its time budget, the result is used if the constraints are satisfied
+        if (!isFine && roughSolveTimeLimit > 0. && err <= smallF &&
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > roughSolveTimeLimit)
+            break;
     }
 
     int ret;
@@ -3799,6 +3991,7 @@ int System::solve(SubSystem *subsysA, SubSystem *subsysB, bool /*isFine*/, bool
 
     subsysA->revertParams();
     subsysB->revertParams();
+    subsysA->setIterations(iter);
     return ret;
 
 }
@@ -3827,10 +4020,11 @@ void System::makeReducedJacobian(Eigen::MatrixXd &J,
                                  std::map< int , int> &tagmultiplicity)
 {
     // construct specific parameter list for diagonose ignoring driven constraint parameters
+    SET_pD drivenparams(pdrivenlist.begin(), pdrivenlist.end());
+    MAP_pD_I diagnoseindex;
     for (int j=0; j < int(plist.size()); j++) {
-        auto result1 = std::find(std::begin(pdrivenlist), std::end(pdrivenlist), plist[j]);
-
-        if (result1 == std::end(pdrivenlist)) {
+        if (drivenparams.count(plist[j]) == 0) {
+            diagnoseindex[plist[j]] = static_cast<int>(pdiagnoselist.size());
             pdiagnoselist.push_back(plist[j]);
         }
     }
@@ -3845,8 +4039,12 @@ void System::makeReducedJacobian(Eigen::MatrixXd &J,
         ++allcount;
         if ((*constr)->getTag() >= 0 && (*constr)->isDriving()) {
             jacobianconstraintcount++;
-            for (int j=0; j < int(pdiagnoselist.size()); j++) {
-                J(jacobianconstraintcount-1,j) = (*constr)->grad(pdiagnoselist[j]);
+            // only the parameters of the constraint can have a non-zero derivative
+            VEC_pD constr_params = (*constr)->params();
+            for (VEC_pD::const_iterator param=constr_params.begin(); param != constr_params.end(); ++param) {
+                MAP_pD_I::const_iterator it = diagnoseindex.find(*param);
+                if (it != diagnoseindex.end())
+                    J(jacobianconstraintcount-1,it->second) = (*constr)->grad(*param);
             }
 
             // parallel processing: create tag multiplicity map
@@ -3927,6 +4125,12 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
 
     makeReducedJacobian(J, jacobianconstraintmap, pdiagnoselist, tagmultiplicity);
 
+    DiagnosisCache diagnosisKey = makeDiagnosisKey(J, pdiagnoselist, alg);
+    if (restoreDiagnosis(diagnosisKey, pdiagnoselist)) {
+        hasDiagnosis = true;
+        return dofs;
+    }
+
     // this function will exit with a diagnosis and, unless overridden by functions below, with full DoFs
     hasDiagnosis = true;
     dofs = pdiagnoselist.size();
@@ -4088,9 +4292,124 @@ SolverReportingManager::Manager().LogToFile("GCS::System::diagnose()\n");
     }
 #endif
 
+    storeDiagnosis(diagnosisKey, pdiagnoselist);
+
     return dofs;
 }
 
+System::DiagnosisCache System::makeDiagnosisKey(const Eigen::MatrixXd &J,
+                                                const GCS::VEC_pD &pdiagnoselist,
+                                                Algorithm alg) const
+{
+    DiagnosisCache key;
+    key.J = J.sparseView();
+    key.J.makeCompressed();
+
+    key.values.reserve(pdiagnoselist.size());
+    for (VEC_pD::const_iterator param=pdiagnoselist.begin(); param != pdiagnoselist.end(); ++param)
+        key.values.push_back(**param);
+
+    key.errors.reserve(clist.size());
+    key.tags.reserve(clist.size());
+    key.driving.reserve(clist.size());
+    for (std::vector<Constraint *>::const_iterator constr=clist.begin(); constr != clist.end(); ++constr) {
+        key.errors.push_back((*constr)->error());
+        key.tags.push_back((*constr)->getTag());
+        key.driving.push_back((*constr)->isDriving());
+    }
+
+    // the settings influencing the decomposition and the solving of the redundant system
+    double settings[] = { double(alg), double(qrAlgorithm), qrpivotThreshold, double(dogLegGaussStep),
+                          double(maxIterRedundant), double(sketchSizeMultiplierRedundant),
+                          convergenceRedundant, LM_epsRedundant, LM_eps1Redundant, LM_tauRedundant,
+                          DL_tolgRedundant, DL_tolxRedundant, DL_tolfRedundant,
+                          double(sparseSolverThreshold) };
+    key.settings.assign(settings, settings + sizeof(settings)/sizeof(settings[0]));
+    return key;
+}
+
+bool System::restoreDiagnosis(const DiagnosisCache &key, const GCS::VEC_pD &pdiagnoselist)
+{
+    const DiagnosisCache &cache = diagnosisCache;
+    if (!cache.valid ||
+        cache.values != key.values || cache.errors != key.errors ||
+        cache.tags != key.tags || cache.driving != key.driving ||
+        cache.settings != key.settings ||
+        cache.J.rows() != key.J.rows() || cache.J.cols() != key.J.cols() ||
+        cache.J.nonZeros() != key.J.nonZeros() ||
+        !std::equal(cache.J.valuePtr(), cache.J.valuePtr() + cache.J.nonZeros(), key.J.valuePtr()) ||
+        !std::equal(cache.J.innerIndexPtr(), cache.J.innerIndexPtr() + cache.J.nonZeros(), key.J.innerIndexPtr()) ||
+        !std::equal(cache.J.outerIndexPtr(), cache.J.outerIndexPtr() + cache.J.outerSize(), key.J.outerIndexPtr()))
+        return false;
+
+    dofs = cache.dofs;
+    emptyDiagnoseMatrix = cache.emptyDiagnoseMatrix;
+    conflictingTags = cache.conflictingTags;
+    redundantTags = cache.redundantTags;
+    partiallyRedundantTags = cache.partiallyRedundantTags;
+
+    for (VEC_I::const_iterator it=cache.redundant.begin(); it != cache.redundant.end(); ++it)
+        redundant.insert(clist[*it]);
+
+    pDependentParameters.clear();
+    for (VEC_I::const_iterator it=cache.dependentParameters.begin(); it != cache.dependentParameters.end(); ++it)
+        pDependentParameters.push_back(pdiagnoselist[*it]);
+
+    pDependentParametersGroups.clear();
+    pDependentParametersGroups.resize(cache.dependentParametersGroups.size());
+    for (std::size_t i=0; i < cache.dependentParametersGroups.size(); i++) {
+        const VEC_I &group = cache.dependentParametersGroups[i];
+        for (VEC_I::const_iterator it=group.begin(); it != group.end(); ++it)
+            pDependentParametersGroups[i].push_back(pdiagnoselist[*it]);
+    }
+
+    return true;
+}
+
+void System::storeDiagnosis(DiagnosisCache &key, const GCS::VEC_pD &pdiagnoselist)
+{
+    diagnosisCache.valid = false;
+
+    std::map<Constraint *,int> constrindex;
+    for (int i=0; i < int(clist.size()); i++)
+        constrindex[clist[i]] = i;
+
+    MAP_pD_I paramindex;
+    for (int i=0; i < int(pdiagnoselist.size()); i++)
+        paramindex[pdiagnoselist[i]] = i;
+
+    key.dofs = dofs;
+    key.emptyDiagnoseMatrix = emptyDiagnoseMatrix;
+    key.conflictingTags = conflictingTags;
+    key.redundantTags = redundantTags;
+    key.partiallyRedundantTags = partiallyRedundantTags;
+
+    for (std::set<Constraint *>::const_iterator constr=redundant.begin(); constr != redundant.end(); ++constr)
+        key.redundant.push_back(constrindex[*constr]);
+
+    // the dependent parameters are always diagnosed ones, otherwise nothing is cached
+    for (VEC_pD::const_iterator param=pDependentParameters.begin(); param != pDependentParameters.end(); ++param) {
+        MAP_pD_I::const_iterator it = paramindex.find(*param);
+        if (it == paramindex.end())
+            return;
+        key.dependentParameters.push_back(it->second);
+    }
+
+    key.dependentParametersGroups.resize(pDependentParametersGroups.size());
+    for (std::size_t i=0; i < pDependentParametersGroups.size(); i++) {
+        const std::vector<double *> &group = pDependentParametersGroups[i];
+        for (std::vector<double *>::const_iterator param=group.begin(); param != group.end(); ++param) {
+            MAP_pD_I::const_iterator it = paramindex.find(*param);
+            if (it == paramindex.end())
+                return;
+            key.dependentParametersGroups[i].push_back(it->second);
+        }
+    }
+
+    key.valid = true;
+    std::swap(diagnosisCache, key);
+}
+
 void System::makeDenseQRDecomposition(  const Eigen::MatrixXd &J,
                                         const std::map<int,int> &jacobianconstraintmap,
                                         Eigen::FullPivHouseholderQR<Eigen::MatrixXd>& qrJT,
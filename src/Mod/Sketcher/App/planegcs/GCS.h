@@ -133,12 +133,39 @@ namespace GCS
 
         bool emptyDiagnoseMatrix; // false only if there is at least one driving constraint.
 
+        // The result of the last diagnosis. The Sketcher sets up and diagnoses an unchanged system
+        // several times (e.g. when solving after an edit and again on recompute), so the result is
+        // reused as long as the reduced jacobian, the parameter values, the constraint errors and the
+        // solver settings are the same. It survives clear(), so constraints and parameters are
+        // referenced by their index.
+        struct DiagnosisCache {
+            bool valid;
+            Eigen::SparseMatrix<double> J;
+            VEC_D values;   // values of the diagnosed parameters
+            VEC_D errors;   // errors of all constraints
+            VEC_I tags;     // tags of all constraints
+            std::vector<bool> driving;
+            VEC_D settings;
+            int dofs;
+            bool emptyDiagnoseMatrix;
+            VEC_I redundant; // indices in clist
+            VEC_I conflictingTags, redundantTags, partiallyRedundantTags;
+            VEC_I dependentParameters; // indices in the list of diagnosed parameters
+            std::vector<VEC_I> dependentParametersGroups;
+
+            DiagnosisCache() : valid(false), dofs(0), emptyDiagnoseMatrix(true) {}
+        } diagnosisCache;
+
         int solve_BFGS(SubSystem *subsys, bool isFine=true, bool isRedundantsolving=false);
         int solve_LM(SubSystem *subsys, bool isRedundantsolving=false);
         int solve_DL(SubSystem *subsys, bool isRedundantsolving=false);
 
         void makeReducedJacobian(Eigen::MatrixXd &J, std::map<int,int> &jacobianconstraintmap, GCS::VEC_pD &pdiagnoselist, std::map< int , int> &tagmultiplicity);
 
+        DiagnosisCache makeDiagnosisKey(const Eigen::MatrixXd &J, const GCS::VEC_pD &pdiagnoselist, Algorithm alg) const;
+        bool restoreDiagnosis(const DiagnosisCache &key, const GCS::VEC_pD &pdiagnoselist);
+        void storeDiagnosis(DiagnosisCache &key, const GCS::VEC_pD &pdiagnoselist);
+
         void makeDenseQRDecomposition(  const Eigen::MatrixXd &J,
                                         const std::map<int,int> &jacobianconstraintmap,
                                         Eigen::FullPivHouseholderQR<Eigen::MatrixXd>& qrJT,
@@ -217,6 +244,12 @@ namespace GCS
         double DL_tolgRedundant;
         double DL_tolxRedundant;
         double DL_tolfRedundant;
+        int sparseSolverThreshold; // subsystems with at least this number of parameters are solved
+                                   // with a sparse jacobian by LM and DogLeg
+        int parallelSolverThreshold; // independent components are solved concurrently if they
+                                     // have at least this number of parameters in total
+        double roughSolveTimeLimit; // time budget in seconds of the SQP iterations of a rough solve
+                                    // (isFine=false, e.g. while dragging), 0 for no limit
 
     public:
         System();
@@ -357,6 +390,8 @@ namespace GCS
 
         int diagnose(Algorithm alg=DogLeg);
         int dofsNumber() const { return hasDiagnosis ? dofs : -1; }
+        // total number of iterations of the subsystems in the last solve
+        int getIterations() const;
         void getConflicting(VEC_I &conflictingOut) const
           { conflictingOut = hasDiagnosis ? conflictingTags : VEC_I(0); }
         void getRedundant(VEC_I &redundantOut) const
@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <iterator>
+#include <algorithm>
 #include "SubSystem.h"
 
 namespace GCS
@@ -49,6 +50,7 @@ SubSystem::~SubSystem()
 void SubSystem::initialize(VEC_pD &params, MAP_pD_pD &reductionmap)
 {
     csize = static_cast<int>(clist.size());
+    iterations = 0;
 
     // tmpplist will contain the subset of parameters from params that are
     // relevant for the constraints listed in clist
@@ -107,6 +109,9 @@ void SubSystem::initialize(VEC_pD &params, MAP_pD_pD &reductionmap)
 
     c2p.clear();
     p2c.clear();
+    cparams.clear();
+    cparamsBegin.assign(1, 0);
+    maxcparams = 0;
     for (std::vector<Constraint *>::iterator constr=clist.begin();
          constr != clist.end(); ++constr) {
         (*constr)->revertParams(); // ensure that the constraint points to the original parameters
@@ -115,9 +120,15 @@ void SubSystem::initialize(VEC_pD &params, MAP_pD_pD &reductionmap)
         for (VEC_pD::const_iterator p=constr_params_orig.begin();
              p != constr_params_orig.end(); ++p) {
             MAP_pD_pD::const_iterator pmapfind = pmap.find(*p);
-            if (pmapfind != pmap.end())
+            if (pmapfind != pmap.end()) {
                 constr_params.insert(pmapfind->second);
+                cparams.push_back(static_cast<int>(pmapfind->second - pvals.data()));
+            }
+            else
+                cparams.push_back(-1);
         }
+        cparamsBegin.push_back(static_cast<int>(cparams.size()));
+        maxcparams = std::max(maxcparams, static_cast<int>(constr_params_orig.size()));
         for (SET_pD::const_iterator p=constr_params.begin();
              p != constr_params.end(); ++p) {
 //            jacobi.set(*constr, *p, 0.);
@@ -258,39 +269,118 @@ void SubSystem::calcJacobi()
 }
 */
 
-void SubSystem::calcJacobi(VEC_pD &params, Eigen::MatrixXd &jacobi)
+void SubSystem::paramColumns(VEC_pD &params, VEC_I &cols, std::vector<std::pair<int,int> > &copies)
 {
-    jacobi.setZero(csize, params.size());
+    cols.assign(psize, -1);
+    copies.clear();
+    if (&params == &plist) {
+        for (int j=0; j < psize; j++)
+            cols[j] = j;
+        return;
+    }
+
     for (int j=0; j < int(params.size()); j++) {
         MAP_pD_pD::const_iterator
           pmapfind = pmap.find(params[j]);
-        if (pmapfind != pmap.end())
-            for (int i=0; i < csize; i++)
-                jacobi(i,j) = clist[i]->grad(pmapfind->second);
+        if (pmapfind != pmap.end()) {
+            int &col = cols[pmapfind->second - pvals.data()];
+            if (col < 0)
+                col = j;
+            else
+                copies.push_back(std::make_pair(j, col));
+        }
     }
 }
 
+void SubSystem::calcJacobi(VEC_pD &params, Eigen::MatrixXd &jacobi)
+{
+    // every constraint computes its whole row at once, the derivatives of its parameter
+    // entries are summed into the columns of the corresponding parameters
+    VEC_I cols;
+    std::vector<std::pair<int,int> > copies;
+    paramColumns(params, cols, copies);
+
+    jacobi.setZero(csize, params.size());
+    VEC_D deriv(maxcparams);
+    for (int i=0; i < csize; i++) {
+        clist[i]->grads(deriv.data());
+        for (int k=cparamsBegin[i]; k < cparamsBegin[i+1]; k++) {
+            int col = (cparams[k] >= 0) ? cols[cparams[k]] : -1;
+            if (col >= 0)
+                jacobi(i,col) += deriv[k-cparamsBegin[i]];
+        }
+    }
+    for (std::size_t c=0; c < copies.size(); c++)
+        jacobi.col(copies[c].first) = jacobi.col(copies[c].second);
+}
+
 void SubSystem::calcJacobi(Eigen::MatrixXd &jacobi)
 {
     calcJacobi(plist, jacobi);
 }
 
+void SubSystem::calcJacobi(VEC_pD &params, Eigen::SparseMatrix<double> &jacobi)
+{
+    // The entries of all adjacent constraint/parameter pairs are stored, even if their
+    // derivative is currently zero, so that the sparsity pattern does not change between
+    // iterations.
+    // Repeated entries of a parameter in a constraint are summed by setFromTriplets.
+    VEC_I cols;
+    std::vector<std::pair<int,int> > copies;
+    paramColumns(params, cols, copies);
+
+    std::vector< Eigen::Triplet<double> > triplets;
+    triplets.reserve(cparams.size());
+    VEC_D deriv(maxcparams);
+    for (int i=0; i < csize; i++) {
+        clist[i]->grads(deriv.data());
+        for (int k=cparamsBegin[i]; k < cparamsBegin[i+1]; k++) {
+            int col = (cparams[k] >= 0) ? cols[cparams[k]] : -1;
+            if (col >= 0)
+                triplets.push_back(Eigen::Triplet<double>(i, col, deriv[k-cparamsBegin[i]]));
+        }
+    }
+    if (!copies.empty()) {
+        std::size_t count = triplets.size();
+        for (std::size_t t=0; t < count; t++) {
+            for (std::size_t c=0; c < copies.size(); c++) {
+                if (copies[c].second == triplets[t].col())
+                    triplets.push_back(Eigen::Triplet<double>(triplets[t].row(), copies[c].first,
+                                                              triplets[t].value()));
+            }
+        }
+    }
+
+    jacobi.resize(csize, params.size());
+    jacobi.setFromTriplets(triplets.begin(), triplets.end());
+}
+
+void SubSystem::calcJacobi(Eigen::SparseMatrix<double> &jacobi)
+{
+    calcJacobi(plist, jacobi);
+}
+
 void SubSystem::calcGrad(VEC_pD &params, Eigen::VectorXd &grad)
 {
     assert(grad.size() == int(params.size()));
 
+    VEC_I cols;
+    std::vector<std::pair<int,int> > copies;
+    paramColumns(params, cols, copies);
+
     grad.setZero();
-    for (int j=0; j < int(params.size()); j++) {
-        MAP_pD_pD::const_iterator
-          pmapfind = pmap.find(params[j]);
-        if (pmapfind != pmap.end()) {
-            // assert(p2c.find(pmapfind->second) != p2c.end());
-            std::vector<Constraint *> constrs=p2c[pmapfind->second];
-            for (std::vector<Constraint *>::const_iterator constr = constrs.begin();
-                 constr != constrs.end(); ++constr)
-                grad[j] += (*constr)->error() * (*constr)->grad(pmapfind->second);
+    VEC_D deriv(maxcparams);
+    for (int i=0; i < csize; i++) {
+        double err = clist[i]->error();
+        clist[i]->grads(deriv.data());
+        for (int k=cparamsBegin[i]; k < cparamsBegin[i+1]; k++) {
+            int col = (cparams[k] >= 0) ? cols[cparams[k]] : -1;
+            if (col >= 0)
+                grad[col] += err * deriv[k-cparamsBegin[i]];
         }
     }
+    for (std::size_t c=0; c < copies.size(); c++)
+        grad[copies[c].first] = grad[copies[c].second];
 }
 
 void SubSystem::calcGrad(Eigen::VectorXd &grad)
@@ -27,6 +27,7 @@
 #undef max
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 #include "Constraints.h"
 
 namespace GCS
@@ -43,7 +44,16 @@ namespace GCS
 //        JacobianMatrix jacobi;  // jacobi matrix of the residuals
         std::map<Constraint *,VEC_pD > c2p; // constraint to parameter adjacency list
         std::map<double *,std::vector<Constraint *> > p2c; // parameter to constraint adjacency list
+        // index in pvals of each entry of the parameter vectors of the constraints (-1 for fixed
+        // parameters), the entries of constraint i start at cparamsBegin[i]
+        VEC_I cparams;
+        VEC_I cparamsBegin;
+        int maxcparams;
+        int iterations;    // number of iterations of the last solve
         void initialize(VEC_pD &params, MAP_pD_pD &reductionmap); // called by the constructors
+        // column of each entry of pvals in a jacobian with respect to params (-1 if not in params),
+        // copies lists (column, source column) pairs for parameters reduced to the same entry
+        void paramColumns(VEC_pD &params, VEC_I &cols, std::vector<std::pair<int,int> > &copies);
     public:
         SubSystem(std::vector<Constraint *> &clist_, VEC_pD &params);
         SubSystem(std::vector<Constraint *> &clist_, VEC_pD &params,
@@ -53,6 +63,9 @@ namespace GCS
         int pSize() { return psize; };
         int cSize() { return csize; };
 
+        int getIterations() { return iterations; }
+        void setIterations(int iter) { iterations = iter; }
+
         void redirectParams();
         void revertParams();
 
@@ -71,6 +84,8 @@ namespace GCS
         void calcResidual(Eigen::VectorXd &r, double &err);
         void calcJacobi(VEC_pD &params, Eigen::MatrixXd &jacobi);
         void calcJacobi(Eigen::MatrixXd &jacobi);
+        void calcJacobi(VEC_pD &params, Eigen::SparseMatrix<double> &jacobi);
+        void calcJacobi(Eigen::SparseMatrix<double> &jacobi);
         void calcGrad(VEC_pD &params, Eigen::VectorXd &grad);
         void calcGrad(Eigen::VectorXd &grad);
 
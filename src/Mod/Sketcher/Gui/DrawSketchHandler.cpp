@@ -430,19 +430,20 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
     // Decrease this value when a candidate is found.
     double tangDeviation = 0.1 * sketchgui->getScaleFactor();
 
-    // Get geometry list
-    const std::vector<Part::Geometry *> geomlist = sketchgui->getSketchObject()->getCompleteGeometry();
-
     Base::Vector3d tmpPos(Pos.x, Pos.y, 0.f);                 // Current cursor point
     Base::Vector3d tmpDir(Dir.x, Dir.y, 0.f);                 // Direction of line
     Base::Vector3d tmpStart(Pos.x-Dir.x, Pos.y-Dir.y, 0.f);  // Start point
 
+    // Only geometries close to the segment can be tangent to it, get them from the spatial index
+    Base::BoundBox2d segmentBox(tmpStart.x, tmpStart.y, tmpPos.x, tmpPos.y);
+    const std::vector<int> candidates = sketchgui->getSketchObject()->getGeometriesNear(segmentBox, tangDeviation);
+
     // Iterate through geometry
-    int i = 0;
-    for (std::vector<Part::Geometry *>::const_iterator it=geomlist.begin(); it != geomlist.end(); ++it, i++) {
+    for (int candidate : candidates) {
+        const Part::Geometry *geo = sketchgui->getSketchObject()->getGeometry(candidate);
 
-        if ((*it)->getTypeId() == Part::GeomCircle::getClassTypeId()) {
-            const Part::GeomCircle *circle = static_cast<const Part::GeomCircle *>((*it));
+        if (geo->getTypeId() == Part::GeomCircle::getClassTypeId()) {
+            const Part::GeomCircle *circle = static_cast<const Part::GeomCircle *>(geo);
 
             Base::Vector3d center = circle->getCenter();
 
@@ -458,13 +459,13 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
 
             // Find if nearest
             if (projDist < tangDeviation) {
-                tangId = i;
+                tangId = candidate;
                 tangDeviation = projDist;
             }
 
-        } else if ((*it)->getTypeId() == Part::GeomEllipse::getClassTypeId()) {
+        } else if (geo->getTypeId() == Part::GeomEllipse::getClassTypeId()) {
 
-            const Part::GeomEllipse *ellipse = static_cast<const Part::GeomEllipse *>((*it));
+            const Part::GeomEllipse *ellipse = static_cast<const Part::GeomEllipse *>(geo);
 
             Base::Vector3d center = ellipse->getCenter();
 
@@ -486,12 +487,12 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
             double error = fabs((focus1PMirrored-focus2P).Length() - 2*a);
 
             if ( error< tangDeviation) {
-                    tangId = i;
+                    tangId = candidate;
                     tangDeviation = error;
             }
 
-        } else if ((*it)->getTypeId() == Part::GeomArcOfCircle::getClassTypeId()) {
-            const Part::GeomArcOfCircle *arc = static_cast<const Part::GeomArcOfCircle *>((*it));
+        } else if (geo->getTypeId() == Part::GeomArcOfCircle::getClassTypeId()) {
+            const Part::GeomArcOfCircle *arc = static_cast<const Part::GeomArcOfCircle *>(geo);
 
             Base::Vector3d center = arc->getCenter();
             double radius = arc->getRadius();
@@ -514,12 +515,12 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
 
                 // if the point is on correct side of arc
                 if (angle <= endAngle) {     // Now need to check only one side
-                    tangId = i;
+                    tangId = candidate;
                     tangDeviation = projDist;
                 }
             }
-        } else if ((*it)->getTypeId() == Part::GeomArcOfEllipse::getClassTypeId()) {
-            const Part::GeomArcOfEllipse *aoe = static_cast<const Part::GeomArcOfEllipse *>((*it));
+        } else if (geo->getTypeId() == Part::GeomArcOfEllipse::getClassTypeId()) {
+            const Part::GeomArcOfEllipse *aoe = static_cast<const Part::GeomArcOfEllipse *>(geo);
 
             Base::Vector3d center = aoe->getCenter();
 
@@ -541,7 +542,7 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
             double error = fabs((focus1PMirrored-focus2P).Length() - 2*a);
 
             if ( error< tangDeviation ) {
-                    tangId = i;
+                    tangId = candidate;
                     tangDeviation = error;
             }
 
@@ -559,7 +560,7 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
 
                 // if the point is on correct side of arc
                 if (angle <= endAngle) {     // Now need to check only one side
-                    tangId = i;
+                    tangId = candidate;
                     tangDeviation = error;
                 }
             }
@@ -567,8 +568,6 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
     }
 
     if (tangId != Constraint::GeoUndef) {
-        if (tangId > getHighestCurveIndex()) // external Geometry
-            tangId = getHighestCurveIndex() - tangId;
         // Suggest vertical constraint
         constr.Type = Tangent;
         constr.GeoId = tangId;
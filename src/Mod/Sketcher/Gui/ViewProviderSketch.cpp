@@ -247,6 +247,16 @@ struct EditData {
     std::vector<int> CurvIdToGeoId; // conversion of SoLineSet index to GeoId
     std::vector<int> PointIdToGeoId; // conversion of SoCoordinate3 index to GeoId
 
+    // discretization of the curves by their position in the geometry list, so
+    // that draw() only evaluates the curves whose parameters have changed
+    struct CurveCache {
+        Base::Type type;
+        std::vector<double> key; // parameters the discretization depends on
+        std::vector<Base::Vector3d> coords;
+    };
+    std::vector<CurveCache> curveCache;
+    int curveCacheSegments = 0; // segments per geometry the cache was made with
+
     // helper data structures for the constraint rendering
     std::vector<ConstraintType> vConstrType;
 
@@ -291,6 +301,67 @@ struct EditData {
 };
 
 
+// this function collects the parameters that the discretization of a curve depends on
+static void curveKey(const Part::Geometry *geo, std::vector<double> &key)
+{
+    key.clear();
+    if (geo->isDerivedFrom(Part::GeomConic::getClassTypeId())) {
+        const Part::GeomConic *conic = static_cast<const Part::GeomConic *>(geo);
+        Base::Vector3d center = conic->getCenter();
+        key.insert(key.end(), {center.x, center.y, center.z, conic->getAngleXU(),
+                               conic->isReversed() ? 1.0 : 0.0});
+    }
+    else if (geo->isDerivedFrom(Part::GeomArcOfConic::getClassTypeId())) {
+        const Part::GeomArcOfConic *arc = static_cast<const Part::GeomArcOfConic *>(geo);
+        Base::Vector3d center = arc->getCenter();
+        double u, v;
+        arc->getRange(u, v, /*emulateCCW=*/false);
+        key.insert(key.end(), {center.x, center.y, center.z, arc->getAngleXU(),
+                               arc->isReversed() ? 1.0 : 0.0, u, v});
+    }
+
+    Base::Type type = geo->getTypeId();
+    if (type == Part::GeomCircle::getClassTypeId()) {
+        key.push_back(static_cast<const Part::GeomCircle *>(geo)->getRadius());
+    }
+    else if (type == Part::GeomEllipse::getClassTypeId()) {
+        const Part::GeomEllipse *ellipse = static_cast<const Part::GeomEllipse *>(geo);
+        key.push_back(ellipse->getMajorRadius());
+        key.push_back(ellipse->getMinorRadius());
+    }
+    else if (type == Part::GeomArcOfCircle::getClassTypeId()) {
+        key.push_back(static_cast<const Part::GeomArcOfCircle *>(geo)->getRadius());
+    }
+    else if (type == Part::GeomArcOfEllipse::getClassTypeId()) {
+        const Part::GeomArcOfEllipse *arc = static_cast<const Part::GeomArcOfEllipse *>(geo);
+        key.push_back(arc->getMajorRadius());
+        key.push_back(arc->getMinorRadius());
+    }
+    else if (type == Part::GeomArcOfHyperbola::getClassTypeId()) {
+        const Part::GeomArcOfHyperbola *arc = static_cast<const Part::GeomArcOfHyperbola *>(geo);
+        key.push_back(arc->getMajorRadius());
+        key.push_back(arc->getMinorRadius());
+    }
+    else if (type == Part::GeomArcOfParabola::getClassTypeId()) {
+        key.push_back(static_cast<const Part::GeomArcOfParabola *>(geo)->getFocal());
+    }
+    else if (type == Part::GeomBSplineCurve::getClassTypeId()) {
+        const Part::GeomBSplineCurve *spline = static_cast<const Part::GeomBSplineCurve *>(geo);
+        key.push_back(spline->getDegree());
+        key.push_back(spline->isPeriodic() ? 1.0 : 0.0);
+        key.push_back(spline->getFirstParameter());
+        key.push_back(spline->getLastParameter());
+        for (const Base::Vector3d &pole : spline->getPoles())
+            key.insert(key.end(), {pole.x, pole.y, pole.z});
+        for (double weight : spline->getWeights())
+            key.push_back(weight);
+        for (double knot : spline->getKnots())
+            key.push_back(knot);
+        for (int mult : spline->getMultiplicities())
+            key.push_back(mult);
+    }
+}
+
 // this function is used to simulate cyclic periodic negative geometry indices (for external geometry)
 const Part::Geometry* GeoById(const std::vector<Part::Geometry*> GeoList, int Id)
 {
@@ -3935,9 +4006,33 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
     // RootPoint
     Points.emplace_back(0.,0.,0.);
 
+    // curves with unchanged parameters are taken from the discretization cache
+    if (edit->curveCacheSegments != stdcountsegments) {
+        edit->curveCache.clear();
+        edit->curveCacheSegments = stdcountsegments;
+    }
+    edit->curveCache.resize(geomlist->size());
+    std::vector<double> curveParams;
+    auto fromCache = [&](std::size_t pos, const Part::Geometry *geo) {
+        EditData::CurveCache &cache = edit->curveCache[pos];
+        curveKey(geo, curveParams);
+        if (cache.type != geo->getTypeId() || cache.key != curveParams)
+            return false;
+        Coords.insert(Coords.end(), cache.coords.begin(), cache.coords.end());
+        return true;
+    };
+    // must follow a failed fromCache() of the same geometry
+    auto toCache = [&](std::size_t pos, const Part::Geometry *geo, std::size_t start) {
+        EditData::CurveCache &cache = edit->curveCache[pos];
+        cache.type = geo->getTypeId();
+        cache.key.swap(curveParams);
+        cache.coords.assign(Coords.begin() + start, Coords.end());
+    };
+
     for (std::vector<Part::Geometry *>::const_iterator it = geomlist->begin(); it != geomlist->end()-2; ++it, GeoId++) {
         if (GeoId >= intGeoCount)
             GeoId = -extGeoCount;
+        std::size_t geoIndex = it - geomlist->begin();
         if ((*it)->getTypeId() == Part::GeomPoint::getClassTypeId()) { // add a point
             const Part::GeomPoint *point = static_cast<const Part::GeomPoint *>(*it);
             Points.push_back(point->getPoint());
@@ -3962,6 +4057,7 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
 
             int countSegments = stdcountsegments;
             Base::Vector3d center = circle->getCenter();
+            std::size_t start = Coords.size();
 
             // BSpline weights have a radius corresponding to the weight value
             // However, in order for them proportional to the B-Spline size,
@@ -4033,7 +4129,7 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
                     }
                 }
             }
-            else {
+            else if (!fromCache(geoIndex, *it)) {
 
                 double segment = (2 * M_PI) / countSegments;
 
@@ -4044,6 +4140,7 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
 
                 gp_Pnt pnt = curve->Value(0);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                toCache(geoIndex, *it, start);
             }
 
             Index.push_back(countSegments+1);
@@ -4057,16 +4154,20 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
 
             int countSegments = stdcountsegments;
             Base::Vector3d center = ellipse->getCenter();
-            double segment = (2 * M_PI) / countSegments;
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(i*segment);
+            std::size_t start = Coords.size();
+            if (!fromCache(geoIndex, *it)) {
+                double segment = (2 * M_PI) / countSegments;
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(i*segment);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                }
+
+                gp_Pnt pnt = curve->Value(0);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                toCache(geoIndex, *it, start);
             }
 
-            gp_Pnt pnt = curve->Value(0);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-
-            Index.push_back(countSegments+1);
+            Index.push_back(static_cast<unsigned int>(Coords.size() - start));
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(center);
             edit->PointIdToGeoId.push_back(GeoId);
@@ -4088,17 +4189,21 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             Base::Vector3d start  = arc->getStartPoint(/*emulateCCW=*/true);
             Base::Vector3d end    = arc->getEndPoint(/*emulateCCW=*/true);
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
+            std::size_t start = Coords.size();
+            if (!fromCache(geoIndex, *it)) {
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(startangle);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                    startangle += segment;
+                }
+
+                // end point
+                gp_Pnt pnt = curve->Value(endangle);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
+                toCache(geoIndex, *it, start);
             }
 
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-
-            Index.push_back(countSegments+1);
+            Index.push_back(static_cast<unsigned int>(Coords.size() - start));
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(start);
             Points.push_back(end);
@@ -4124,17 +4229,21 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             Base::Vector3d start  = arc->getStartPoint(/*emulateCCW=*/true);
             Base::Vector3d end    = arc->getEndPoint(/*emulateCCW=*/true);
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
+            std::size_t start = Coords.size();
+            if (!fromCache(geoIndex, *it)) {
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(startangle);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                    startangle += segment;
+                }
+
+                // end point
+                gp_Pnt pnt = curve->Value(endangle);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
+                toCache(geoIndex, *it, start);
             }
 
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-
-            Index.push_back(countSegments+1);
+            Index.push_back(static_cast<unsigned int>(Coords.size() - start));
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(start);
             Points.push_back(end);
@@ -4160,17 +4269,21 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             Base::Vector3d start  = aoh->getStartPoint();
             Base::Vector3d end    = aoh->getEndPoint();
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
+            std::size_t start = Coords.size();
+            if (!fromCache(geoIndex, *it)) {
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(startangle);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                    startangle += segment;
+                }
+
+                // end point
+                gp_Pnt pnt = curve->Value(endangle);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
+                toCache(geoIndex, *it, start);
             }
 
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-
-            Index.push_back(countSegments+1);
+            Index.push_back(static_cast<unsigned int>(Coords.size() - start));
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(start);
             Points.push_back(end);
@@ -4196,17 +4309,21 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             Base::Vector3d start  = aop->getStartPoint();
             Base::Vector3d end    = aop->getEndPoint();
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(startangle);
+            std::size_t start = Coords.size();
+            if (!fromCache(geoIndex, *it)) {
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(startangle);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                    startangle += segment;
+                }
+
+                // end point
+                gp_Pnt pnt = curve->Value(endangle);
                 Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                startangle += segment;
+                toCache(geoIndex, *it, start);
             }
 
-            // end point
-            gp_Pnt pnt = curve->Value(endangle);
-            Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-
-            Index.push_back(countSegments+1);
+            Index.push_back(static_cast<unsigned int>(Coords.size() - start));
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(start);
             Points.push_back(end);
@@ -4232,17 +4349,21 @@ void ViewProviderSketch::draw(bool temp /*=false*/, bool rebuildinformationlayer
             int countSegments = stdcountsegments;
             double segment = range / countSegments;
 
-            for (int i=0; i < countSegments; i++) {
-                gp_Pnt pnt = curve->Value(first);
-                Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
-                first += segment;
-            }
+            std::size_t start = Coords.size();
+            if (!fromCache(geoIndex, *it)) {
+                for (int i=0; i < countSegments; i++) {
+                    gp_Pnt pnt = curve->Value(first);
+                    Coords.emplace_back(pnt.X(), pnt.Y(), pnt.Z());
+                    first += segment;
+                }
 
-            // end point
-            gp_Pnt end = curve->Value(last);
-            Coords.emplace_back(end.X(), end.Y(), end.Z());
+                // end point
+                gp_Pnt end = curve->Value(last);
+                Coords.emplace_back(end.X(), end.Y(), end.Z());
+                toCache(geoIndex, *it, start);
+            }
 
-            Index.push_back(countSegments+1);
+            Index.push_back(static_cast<unsigned int>(Coords.size() - start));
             edit->CurvIdToGeoId.push_back(GeoId);
             Points.push_back(startp);
             Points.push_back(endp);
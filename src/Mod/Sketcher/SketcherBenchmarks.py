@@ -0,0 +1,167 @@
+# -*- coding: utf-8 -*-
+
+#  LGPL
+
+"""Benchmarks for the sketcher solver.
+
+Run it from the FreeCAD Python console or with FreeCADCmd:
+
+    import SketcherBenchmarks
+    SketcherBenchmarks.run()
+
+The synthetic sketches are grids of fully constrained rectangles, closed
+polygon outlines made of many short lines as they come from imported DXF
+drawings, and chains of B-splines with their internal geometry exposed.
+Besides them, the sketches of real documents can be passed as a list of
+FCStd file names:
+
+    SketcherBenchmarks.run(files=["/path/to/part.FCStd"])
+
+For every sketch the set-up (including the diagnosis of redundant and
+conflicting constraints) is timed with both QR algorithms and the solve with
+every solver algorithm. The degrees of freedom, the solver status and the
+number of iterations are printed alongside.
+"""
+
+import math, os, time
+import FreeCAD, Part, Sketcher
+
+try:
+    from BenchmarkApp import record
+except ImportError:
+    def record(*args, **kwargs):
+        pass
+
+# number of rectangles along each side of the grids
+GRID_SIZES = [4, 8, 16]
+# number of edges of the polygon outlines
+OUTLINE_SIZES = [100, 400, 1600]
+# number of B-splines in the chains
+BSPLINE_SIZES = [4, 16, 32]
+
+QR_ALGORITHMS = ["DenseQR", "SparseQR"]
+ALGORITHMS = ["BFGS", "LevenbergMarquardt", "DogLeg"]
+
+
+def addRectangle(sketch, x, y, size):
+    i = sketch.GeometryCount
+    corners = [FreeCAD.Vector(x, y, 0), FreeCAD.Vector(x + size, y, 0),
+               FreeCAD.Vector(x + size, y + size, 0), FreeCAD.Vector(x, y + size, 0)]
+    for k in range(4):
+        sketch.addGeometry(Part.LineSegment(corners[k], corners[(k + 1) % 4]))
+    for k in range(4):
+        sketch.addConstraint(Sketcher.Constraint('Coincident', i + k, 2, i + (k + 1) % 4, 1))
+    sketch.addConstraint(Sketcher.Constraint('Horizontal', i + 0))
+    sketch.addConstraint(Sketcher.Constraint('Horizontal', i + 2))
+    sketch.addConstraint(Sketcher.Constraint('Vertical', i + 1))
+    sketch.addConstraint(Sketcher.Constraint('Vertical', i + 3))
+    sketch.addConstraint(Sketcher.Constraint('DistanceX', i, 1, x))
+    sketch.addConstraint(Sketcher.Constraint('DistanceY', i, 1, y))
+    sketch.addConstraint(Sketcher.Constraint('Distance', i + 0, size * 0.9))
+    sketch.addConstraint(Sketcher.Constraint('Equal', i + 0, i + 1))
+
+
+def makeGrid(sketch, count, size=10.0):
+    """Adds count x count rectangles that are slightly off their constrained size."""
+    for i in range(count):
+        for j in range(count):
+            addRectangle(sketch, i * size * 1.5, j * size * 1.5, size)
+
+
+def makeOutline(sketch, count, radius=100.0):
+    """Adds a closed, wavy outline of count lines joined by coincidences."""
+    points = []
+    for k in range(count):
+        angle = 2 * math.pi * k / count
+        r = radius * (1.0 + 0.05 * math.sin(7 * angle))
+        points.append(FreeCAD.Vector(r * math.cos(angle), r * math.sin(angle), 0))
+    for k in range(count):
+        sketch.addGeometry(Part.LineSegment(points[k], points[(k + 1) % count]))
+    for k in range(count):
+        sketch.addConstraint(Sketcher.Constraint('Coincident', k, 2, (k + 1) % count, 1))
+    sketch.addConstraint(Sketcher.Constraint('Coincident', 0, 1, -1, 1))
+    for k in range(0, count, 4):
+        sketch.addConstraint(Sketcher.Constraint('Distance', k, points[k].distanceToPoint(points[(k + 1) % count]) * 1.01))
+
+
+def makeBSplines(sketch, count, length=20.0):
+    """Adds a chain of count B-splines with exposed control points and knots."""
+    for k in range(count):
+        x = k * length
+        poles = [FreeCAD.Vector(x, 0, 0), FreeCAD.Vector(x + length / 3, length / 4, 0),
+                 FreeCAD.Vector(x + 2 * length / 3, -length / 4, 0), FreeCAD.Vector(x + length, 0, 0)]
+        spline = Part.BSplineCurve()
+        spline.buildFromPolesMultsKnots(poles, [4, 4], [0, 1], False, 3)
+        i = sketch.addGeometry(spline)
+        sketch.exposeInternalGeometry(i)
+        if k > 0:
+            sketch.addConstraint(Sketcher.Constraint('Coincident', previous, 2, i, 1))
+        previous = i
+    sketch.addConstraint(Sketcher.Constraint('Coincident', 0, 1, -1, 1))
+
+
+def axes():
+    # the external geometries every sketch object has, in the order of
+    # SketchObject.getCompleteGeometry(): vertical axis (-2), horizontal axis (-1)
+    return [Part.LineSegment(FreeCAD.Vector(0, 0, 0), FreeCAD.Vector(0, 1, 0)),
+            Part.LineSegment(FreeCAD.Vector(0, 0, 0), FreeCAD.Vector(1, 0, 0))]
+
+
+def report(name, sketch):
+    geometries = sketch.Geometry + axes()
+    constraints = sketch.Constraints
+    line = "%-20s geos %6d  cons %6d" % (name, len(sketch.Geometry), len(constraints))
+
+    for qr in QR_ALGORITHMS:
+        solver = Sketcher.Sketch()
+        solver.QRAlgorithm = qr
+        start = time.time()
+        dofs = solver.setUp(geometries, constraints, 2)
+        seconds = time.time() - start
+        record("Sketcher", name, seconds, operation="setUp", algorithm=qr, geometries=len(sketch.Geometry))
+        line += "  setUp(%s) %8.3f s" % (qr, seconds)
+    line += "  dofs %5d" % dofs
+
+    for algorithm in ALGORITHMS:
+        solver = Sketcher.Sketch()
+        solver.setUp(geometries, constraints, 2)
+        solver.Algorithm = algorithm
+        start = time.time()
+        status = solver.solve()
+        seconds = time.time() - start
+        record("Sketcher", name, seconds, operation="solve", algorithm=algorithm,
+               status=status, iterations=solver.Iterations)
+        line += "  %s %8.3f s %s %4d it" % (algorithm, seconds,
+                                           "ok  " if status == 0 else "fail", solver.Iterations)
+    FreeCAD.Console.PrintMessage(line + "\n")
+
+
+def run(files=None, grids=None, outlines=None, bsplines=None):
+    """Runs the benchmarks on the synthetic sketches and the sketches of the given files."""
+    doc = FreeCAD.newDocument("SketcherBenchmarks")
+    try:
+        for name, builder, sizes in [("grid", makeGrid, grids or GRID_SIZES),
+                                     ("outline", makeOutline, outlines or OUTLINE_SIZES),
+                                     ("bspline", makeBSplines, bsplines or BSPLINE_SIZES)]:
+            for count in sizes:
+                sketch = doc.addObject("Sketcher::SketchObject", "Sketch")
+                builder(sketch, count)
+                report("%s(%d)" % (name, count), sketch)
+                doc.removeObject(sketch.Name)
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+    for filename in files or []:
+        doc = FreeCAD.openDocument(filename)
+        try:
+            for obj in doc.Objects:
+                if not obj.isDerivedFrom("Sketcher::SketchObject"):
+                    continue
+                if obj.ExternalGeometry:
+                    # the projection of external geometry needs the whole document
+                    FreeCAD.Console.PrintWarning("%s: skipping %s with external geometry\n"
+                                                 % (os.path.basename(filename), obj.Label))
+                    continue
+                report("%s:%s" % (os.path.basename(filename), obj.Label), obj)
+        finally:
+            FreeCAD.closeDocument(doc.Name)
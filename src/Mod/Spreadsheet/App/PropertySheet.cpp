@@ -73,6 +73,8 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    cellDependencyMap.clear();
+    revCellDependencyMap.clear();
     aliasProp.clear();
     revAliasProp.clear();
 
@@ -200,6 +202,8 @@ PropertySheet::PropertySheet(const PropertySheet &other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , cellDependencyMap(other.cellDependencyMap)
+    , revCellDependencyMap(other.revCellDependencyMap)
     , aliasProp(other.aliasProp)
     , revAliasProp(other.revAliasProp)
     , updateCount(other.updateCount)
@@ -1064,6 +1068,16 @@ void PropertySheet::addDependencies(CellAddress key)
                     // Insert into maps
                     propertyNameToCellMap[propName].insert(key);
                     cellToPropertyNameMap[key].insert(propName);
+
+                    cellDependencyMap[j->second].insert(key);
+                    revCellDependencyMap[key].insert(j->second);
+                }
+                else {
+                    CellAddress addr = stringToAddress(props.first.c_str(), true);
+                    if (addr.isValid()) {
+                        cellDependencyMap[addr].insert(key);
+                        revCellDependencyMap[key].insert(addr);
+                    }
                 }
             }
         }
@@ -1099,6 +1113,24 @@ void PropertySheet::removeDependencies(CellAddress key)
         cellToPropertyNameMap.erase(i1);
     }
 
+    /* Remove from cell <-> cell maps */
+
+    auto i3 = revCellDependencyMap.find(key);
+
+    if (i3 != revCellDependencyMap.end()) {
+        for (auto &addr : i3->second) {
+            auto k = cellDependencyMap.find(addr);
+
+            if (k != cellDependencyMap.end()) {
+                k->second.erase(key);
+                if (k->second.empty())
+                    cellDependencyMap.erase(k);
+            }
+        }
+
+        revCellDependencyMap.erase(i3);
+    }
+
     /* Remove from DocumentObject <-> Key maps */
 
     std::map<CellAddress, std::set< std::string > >::iterator i2 = cellToDocumentObjectMap.find(key);
@@ -1289,6 +1321,17 @@ const std::set<std::string> &PropertySheet::getDeps(CellAddress pos) const
         return empty;
 }
 
+const std::set<CellAddress> &PropertySheet::getDependentCells(CellAddress pos) const
+{
+    static std::set<CellAddress> empty;
+    auto i = cellDependencyMap.find(pos);
+
+    if (i != cellDependencyMap.end())
+        return i->second;
+    else
+        return empty;
+}
+
 void PropertySheet::recomputeDependencies(CellAddress key)
 {
     AtomicPropertyChange signaller(*this);
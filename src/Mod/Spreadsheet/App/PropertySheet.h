@@ -156,6 +156,9 @@ public:
 
     const std::set<std::string> &getDeps(App::CellAddress pos) const;
 
+    /// Return the cells of this sheet that depend on the cell at \a pos
+    const std::set<App::CellAddress> &getDependentCells(App::CellAddress pos) const;
+
     void recomputeDependencies(App::CellAddress key);
 
     PyObject *getPyObject(void) override;
@@ -251,6 +254,16 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set< std::string > > cellToDocumentObjectMap;
 
+    /*! Cell to cell dependencies inside this sheet, i.e when the cell given in
+      key changes, the set of addresses needs to be recomputed. It holds the same
+      information as propertyNameToCellMap for the cells of the owner sheet, but
+      avoids building and comparing property name strings.
+      */
+    std::map<App::CellAddress, std::set< App::CellAddress > > cellDependencyMap;
+
+    /*! Cells of this sheet the cell given in key depends on */
+    std::map<App::CellAddress, std::set< App::CellAddress > > revCellDependencyMap;
+
     /*! Mapping of cell position to alias property */
     std::map<App::CellAddress, std::string> aliasProp;
 
@@ -26,7 +26,6 @@
 #endif
 
 #include <boost/regex.hpp>
-#include <boost/tokenizer.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/copy.hpp>
 #include <boost/assign.hpp>
@@ -54,6 +53,8 @@
 #include <iomanip>
 #include <boost/regex.hpp>
 #include <deque>
+#include <cstring>
+#include <QFile>
 
 FC_LOG_LEVEL_INIT("Spreadsheet",true,true)
 
@@ -140,50 +141,79 @@ void Sheet::clearAll()
 
 bool Sheet::importFromFile(const std::string &filename, char delimiter, char quoteChar, char escapeChar)
 {
-    Base::FileInfo fi(filename);
-    Base::ifstream file(fi, std::ios::in);
-    int row = 0;
-
-    PropertySheet::AtomicPropertyChange signaller(cells);
+    QFile file(QString::fromUtf8(filename.c_str()));
 
-    clearAll();
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
 
-    if (file.is_open()) {
-        std::string line;
+    // Map the whole file instead of streaming it line by line, large
+    // measurement data files are otherwise dominated by the copying. Fall
+    // back to a single read where mapping is not possible (e.g. empty file).
+    QByteArray buffer;
+    const char *data = 0;
+    qint64 size = file.size();
+
+    if (size > 0)
+        data = reinterpret_cast<const char*>(file.map(0, size));
+    if (!data) {
+        buffer = file.readAll();
+        data = buffer.constData();
+        size = buffer.size();
+    }
 
-        while (std::getline(file, line)) {
-            using namespace boost;
+    // Without a quote character, escapes are disabled as well
+    if (!quoteChar)
+        escapeChar = '\0';
 
-            try {
-                escaped_list_separator<char> e;
-                int col = 0;
+    PropertySheet::AtomicPropertyChange signaller(cells);
 
-                if (quoteChar)
-                    e = escaped_list_separator<char>(escapeChar, delimiter, quoteChar);
-                else
-                    e = escaped_list_separator<char>('\0', delimiter, '\0');
+    clearAll();
 
-                tokenizer<escaped_list_separator<char> > tok(line, e);
+    const char *end = data + size;
+    std::string field;
+    int row = 0;
 
-                for(tokenizer<escaped_list_separator<char> >::iterator i = tok.begin(); i != tok.end();++i) {
-                    if ((*i).size() > 0)
-                        setCell(CellAddress(row, col), (*i).c_str());
-                    col++;
-                }
+    for (const char *line = data; line < end; ++row) {
+        const char *eol = static_cast<const char*>(memchr(line, '\n', end - line));
+        const char *next = eol ? eol + 1 : end;
+
+        if (!eol)
+            eol = end;
+        if (eol > line && eol[-1] == '\r')
+            --eol;
+
+        // Same tokenizing rules as boost::escaped_list_separator
+        bool inQuote = false;
+        int col = 0;
+
+        field.clear();
+        for (const char *c = line; ; ++c) {
+            if (c == eol || (*c == delimiter && !inQuote)) {
+                if (field.size() > 0)
+                    setCell(CellAddress(row, col), field.c_str());
+                if (c == eol)
+                    break;
+                field.clear();
+                ++col;
             }
-            catch (...) {
-                signaller.tryInvoke();
-                return false;
+            else if (escapeChar && *c == escapeChar) {
+                if (++c == eol || (*c != escapeChar && *c != quoteChar && *c != 'n')) {
+                    signaller.tryInvoke();
+                    return false;
+                }
+                field += *c == 'n' ? '\n' : *c;
             }
-
-            ++row;
+            else if (quoteChar && *c == quoteChar)
+                inQuote = !inQuote;
+            else
+                field += *c;
         }
-        file.close();
-        signaller.tryInvoke();
-        return true;
+
+        line = next;
     }
-    else
-        return false;
+
+    signaller.tryInvoke();
+    return true;
 }
 
 /**
@@ -234,13 +264,14 @@ bool Sheet::exportToFile(const std::string &filename, char delimiter, char quote
 
     std::set<CellAddress> usedCells = cells.getUsedCells();
     std::set<CellAddress>::const_iterator i = usedCells.begin();
+    std::stringstream field;
 
     while (i != usedCells.end()) {
         Property * prop = getProperty(*i);
 
         if (prevRow != -1 && prevRow != i->row()) {
             for (int j = prevRow; j < i->row(); ++j)
-                file << std::endl;
+                file << '\n';
             prevCol = 0;
         }
         if (prevCol != -1 && i->col() != prevCol) {
@@ -248,7 +279,7 @@ bool Sheet::exportToFile(const std::string &filename, char delimiter, char quote
                 file << delimiter;
         }
 
-        std::stringstream field;
+        field.str(std::string());
 
         if (prop->isDerivedFrom((PropertyQuantity::getClassTypeId())))
             field << static_cast<PropertyQuantity*>(prop)->getValue();
@@ -833,7 +864,7 @@ DocumentObjectExecReturn *Sheet::execute(void)
         }
 
         // Process cells that depend on the current cell
-        for(auto &dep : providesTo(currPos)) {
+        for(auto &dep : cells.getDependentCells(currPos)) {
             auto resDep = VertexList.emplace(dep,Vertex());
             if(resDep.second) {
                 resDep.first->second = add_vertex(graph);
@@ -892,7 +923,7 @@ DocumentObjectExecReturn *Sheet::execute(void)
                 }
 
                 // Process cells that depend on the current cell
-                for(auto &dep : providesTo(currPos)) {
+                for(auto &dep : cells.getDependentCells(currPos)) {
                     auto resDep = VertexList.emplace(dep,Vertex());
                     if(resDep.second) {
                         resDep.first->second = add_vertex(graph);
@@ -1370,7 +1401,7 @@ std::set<std::string> Sheet::dependsOn(CellAddress address) const
 void Sheet::providesTo(CellAddress address, std::set<std::string> & result) const
 {
     std::string fullName = getFullName() + ".";
-    std::set<CellAddress> tmpResult = cells.getDeps(fullName + address.toString());
+    const std::set<CellAddress> &tmpResult = cells.getDependentCells(address);
 
     for (std::set<CellAddress>::const_iterator i = tmpResult.begin(); i != tmpResult.end(); ++i)
         result.insert(fullName + i->toString());
@@ -1384,7 +1415,7 @@ void Sheet::providesTo(CellAddress address, std::set<std::string> & result) cons
 
 std::set<CellAddress>  Sheet::providesTo(CellAddress address) const
 {
-    return cells.getDeps(getFullName()+"."+address.toString());
+    return cells.getDependentCells(address);
 }
 
 void Sheet::onDocumentRestored()
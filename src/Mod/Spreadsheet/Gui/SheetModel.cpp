@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <QtCore>
 # include <QApplication>
 # include <QLocale>
@@ -48,9 +49,19 @@ namespace bp = boost::placeholders;
 SheetModel::SheetModel(Sheet *_sheet, QObject *parent)
     : QAbstractTableModel(parent)
     , sheet(_sheet)
+    , updatedTop(-1)
+    , updatedLeft(-1)
+    , updatedBottom(-1)
+    , updatedRight(-1)
 {
     cellUpdatedConnection = sheet->cellUpdated.connect(bind(&SheetModel::cellUpdated, this, bp::_1));
 
+    // A recompute updates many cells at once, so collect them and notify the
+    // views once control returns to the event loop
+    updateTimer.setSingleShot(true);
+    updateTimer.setInterval(0);
+    connect(&updateTimer, SIGNAL(timeout()), this, SLOT(emitDataChanged()));
+
     ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Spreadsheet");
     aliasBgColor = QColor(Base::Tools::fromStdString(hGrp->GetASCII("AliasedCellBackgroundColor", "#feff9e")));
     textFgColor = QColor(Base::Tools::fromStdString(hGrp->GetASCII("TextColor", "#000000")));
@@ -148,6 +159,29 @@ static std::string getUnitString(const Base::Unit & unit)
 #endif
 
 QVariant SheetModel::data(const QModelIndex &index, int role) const
+{
+    // The edit value is always taken from the cell's current content
+    if (role == Qt::EditRole || role == Qt::StatusTipRole)
+        return cellData(index, role);
+
+    // Formatting the display values is too slow to be done on every repaint
+    // but the views ask for all roles of the visible cells each time.
+    const int maxCachedCells = 100000;
+    QHash<int, QVariant>& roles = cache[CellAddress(index.row(), index.column()).asInt()];
+    QHash<int, QVariant>::const_iterator it = roles.constFind(role);
+    if (it != roles.constEnd())
+        return it.value();
+
+    QVariant value = cellData(index, role);
+    if (cache.size() > maxCachedCells) {
+        cache.clear();
+        return value;
+    }
+    roles.insert(role, value);
+    return value;
+}
+
+QVariant SheetModel::cellData(const QModelIndex &index, int role) const
 {
     static const Cell * emptyCell = new Cell(CellAddress(0, 0), 0);
     int row = index.row();
@@ -561,9 +595,47 @@ Qt::ItemFlags SheetModel::flags(const QModelIndex & /*index*/) const
 
 void SheetModel::cellUpdated(CellAddress address)
 {
-    QModelIndex i = index(address.row(), address.col());
+    cache.remove(address.asInt());
+
+    int row = address.row();
+    int col = address.col();
+    if (updatedTop < 0) {
+        updatedTop = updatedBottom = row;
+        updatedLeft = updatedRight = col;
+    }
+    else {
+        updatedTop = std::min(updatedTop, row);
+        updatedBottom = std::max(updatedBottom, row);
+        updatedLeft = std::min(updatedLeft, col);
+        updatedRight = std::max(updatedRight, col);
+    }
+
+    if (!updateTimer.isActive())
+        updateTimer.start();
+}
+
+void SheetModel::invalidateCells()
+{
+    cache.clear();
+    updatedTop = 0;
+    updatedLeft = 0;
+    updatedBottom = rowCount() - 1;
+    updatedRight = columnCount() - 1;
+
+    if (!updateTimer.isActive())
+        updateTimer.start();
+}
+
+void SheetModel::emitDataChanged()
+{
+    if (updatedTop < 0)
+        return;
+
+    QModelIndex topLeft = index(updatedTop, updatedLeft);
+    QModelIndex bottomRight = index(updatedBottom, updatedRight);
+    updatedTop = updatedLeft = updatedBottom = updatedRight = -1;
 
-    dataChanged(i, i);
+    dataChanged(topLeft, bottomRight);
 }
 
 #include "moc_SheetModel.cpp"
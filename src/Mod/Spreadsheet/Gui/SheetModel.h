@@ -24,6 +24,8 @@
 #define SHEETMODEL_H
 
 #include <QAbstractTableModel>
+#include <QHash>
+#include <QTimer>
 #include <Mod/Spreadsheet/App/Utils.h>
 #include <App/Range.h>
 
@@ -47,12 +49,23 @@ public:
     QVariant headerData(int section, Qt::Orientation orientation, int role) const;
     bool setData(const QModelIndex &index, const QVariant &value, int role);
     Qt::ItemFlags flags(const QModelIndex &) const;
+    /// Drops the cached display data and schedules a repaint of all cells
+    void invalidateCells();
+
+private Q_SLOTS:
+    void emitDataChanged();
 
 private:
+    QVariant cellData(const QModelIndex &index, int role) const;
     void cellUpdated(App::CellAddress address);
 
     boost::signals2::scoped_connection cellUpdatedConnection;
     Spreadsheet::Sheet * sheet;
+    /// The display data of the cells by role, invalidated by Sheet::cellUpdated
+    mutable QHash<unsigned int, QHash<int, QVariant> > cache;
+    /// The range of the updated cells whose dataChanged() is still to be emitted
+    int updatedTop, updatedLeft, updatedBottom, updatedRight;
+    QTimer updateTimer;
     QColor aliasBgColor;
     QColor textFgColor;
     QColor positiveFgColor;
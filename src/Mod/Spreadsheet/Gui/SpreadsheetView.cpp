@@ -411,6 +411,9 @@ void SheetView::updateCell(const App::Property *prop)
             QString cap = QString::fromUtf8(sheet->Label.getValue());
             setWindowTitle(cap);
         }
+        // cells may have been removed or restyled without being recomputed
+        if (prop->isDerivedFrom(PropertySheet::getClassTypeId()))
+            model->invalidateCells();
         CellAddress address;
 
         if(!sheet->getCellAddress(prop, address))
@@ -156,6 +156,29 @@ class SpreadsheetCases(unittest.TestCase):
         self.assertTrue(sheet.H5.startswith(u'ERR: Quantity::operator -(): Unit mismatch in minus operation'))
         self.assertTrue(sheet.H6.startswith(u'ERR: Quantity::operator +=(): Unit mismatch in plus operation'))
 
+    def testAggregateRangeUpdate(self):
+        """ Test that aggregates follow changes of the cells in the range """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.set('B1', '1')
+        sheet.set('B2', '2')
+        sheet.set('B3', '3')
+        sheet.set('A1', '=sum(B1:B4)')
+        sheet.set('A2', '=max(B1:B4)')
+        self.doc.recompute()
+        self.assertEqual(sheet.A1, 6)
+        self.assertEqual(sheet.A2, 3)
+        # change a value, and fill a cell that did not exist before
+        sheet.set('B2', '5')
+        sheet.set('B4', '10')
+        self.doc.recompute()
+        self.assertEqual(sheet.A1, 19)
+        self.assertEqual(sheet.A2, 10)
+        # change the type of a cell
+        sheet.set('B4', '2.5')
+        self.doc.recompute()
+        self.assertEqual(sheet.A1, 11.5)
+        self.assertEqual(sheet.A2, 5)
+
     def assertMostlyEqual(self, a, b):
         if type(a) is Units.Quantity:
             self.assertTrue( math.fabs(a.Value - b.Value) < 1e-14)
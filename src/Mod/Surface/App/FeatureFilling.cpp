@@ -115,7 +115,7 @@ short Filling::mustExecute() const
     return 0;
 }
 
-void Filling::addConstraints(BRepFill_Filling& builder,
+void Filling::addConstraints(std::vector<Constraint>& constraints,
                              const App::PropertyLinkSubList& edges,
                              const App::PropertyStringList& faces,
                              const App::PropertyIntegerList& orders,
@@ -162,13 +162,13 @@ void Filling::addConstraints(BRepFill_Filling& builder,
                     if (subFace.empty()) {
                         if (!bnd) {
                             // not a boundary edge: safe to add it directly
-                            builder.Add(TopoDS::Edge(edge), cont, bnd);
+                            constraints.push_back({edge, TopoDS_Shape(), cont, bnd != Standard_False});
                         }
                         else {
                             // boundary edge: try to add it to the test wire first
                             testWire.Add(TopoDS::Edge(edge));
                             if (testWire.IsDone()) {
-                                builder.Add(TopoDS::Edge(edge), cont, bnd);
+                                constraints.push_back({edge, TopoDS_Shape(), cont, true});
                             }
                             else {
                                 Standard_Failure::Raise("Boundary edges must be added in a consecutive order");
@@ -180,13 +180,13 @@ void Filling::addConstraints(BRepFill_Filling& builder,
                         if (!face.IsNull() && face.ShapeType() == TopAbs_FACE) {
                             if (!bnd) {
                                 // not a boundary edge: safe to add it directly
-                                builder.Add(TopoDS::Edge(edge), TopoDS::Face(face), cont, bnd);
+                                constraints.push_back({edge, face, cont, false});
                             }
                             else {
                                 // boundary edge: try to add it to the test wire first
                                 testWire.Add(TopoDS::Edge(edge));
                                 if (testWire.IsDone()) {
-                                    builder.Add(TopoDS::Edge(edge), TopoDS::Face(face), cont, bnd);
+                                    constraints.push_back({edge, face, cont, true});
                                 }
                                 else {
                                     Standard_Failure::Raise("Boundary edges must be added in a consecutive order");
@@ -210,7 +210,7 @@ void Filling::addConstraints(BRepFill_Filling& builder,
 }
 
 // Add free support faces with their continuities
-void Filling::addConstraints(BRepFill_Filling& builder,
+void Filling::addConstraints(std::vector<Constraint>& constraints,
                              const App::PropertyLinkSubList& faces,
                              const App::PropertyIntegerList& orders)
 {
@@ -227,8 +227,7 @@ void Filling::addConstraints(BRepFill_Filling& builder,
                 const Part::TopoShape& shape = static_cast<Part::Feature*>(obj)->Shape.getShape();
                 TopoDS_Shape face = shape.getSubShape(sub.c_str());
                 if (!face.IsNull() && face.ShapeType() == TopAbs_FACE) {
-                    GeomAbs_Shape cont = static_cast<GeomAbs_Shape>(contvals[index]);
-                    builder.Add(TopoDS::Face(face), cont);
+                    constraints.push_back({face, TopoDS_Shape(), contvals[index], false});
                 }
                 else {
                     Standard_Failure::Raise("Sub-shape is not a face");
@@ -241,7 +240,7 @@ void Filling::addConstraints(BRepFill_Filling& builder,
     }
 }
 
-void Filling::addConstraints(BRepFill_Filling& builder,
+void Filling::addConstraints(std::vector<Constraint>& constraints,
                              const App::PropertyLinkSubList& pointsList)
 {
     auto points = pointsList.getSubListValues();
@@ -253,14 +252,38 @@ void Filling::addConstraints(BRepFill_Filling& builder,
             for (auto jt : sub) {
                 TopoDS_Shape subShape = shape.getSubShape(jt.c_str());
                 if (!subShape.IsNull() && subShape.ShapeType() == TopAbs_VERTEX) {
-                    gp_Pnt pnt = BRep_Tool::Pnt(TopoDS::Vertex(subShape));
-                    builder.Add(pnt);
+                    constraints.push_back({subShape, TopoDS_Shape(), GeomAbs_C0, false});
                 }
             }
         }
     }
 }
 
+void Filling::addConstraints(BRepFill_Filling& builder,
+                             const std::vector<Constraint>& constraints)
+{
+    for (const auto& it : constraints) {
+        GeomAbs_Shape cont = static_cast<GeomAbs_Shape>(it.order);
+        Standard_Boolean bnd = it.bound ? Standard_True : Standard_False;
+        switch (it.shape.ShapeType()) {
+        case TopAbs_EDGE:
+            if (it.support.IsNull())
+                builder.Add(TopoDS::Edge(it.shape), cont, bnd);
+            else
+                builder.Add(TopoDS::Edge(it.shape), TopoDS::Face(it.support), cont, bnd);
+            break;
+        case TopAbs_FACE:
+            builder.Add(TopoDS::Face(it.shape), cont);
+            break;
+        case TopAbs_VERTEX:
+            builder.Add(BRep_Tool::Pnt(TopoDS::Vertex(it.shape)));
+            break;
+        default:
+            break;
+        }
+    }
+}
+
 App::DocumentObjectExecReturn *Filling::execute(void)
 {
     //Assign Variables
@@ -275,15 +298,18 @@ App::DocumentObjectExecReturn *Filling::execute(void)
     unsigned int maxdeg = MaximumDegree.getValue();
     unsigned int maxseg = MaximumSegments.getValue();
 
-    try {
-        BRepFill_Filling builder(degree, ptsoncurve, numIter, anisotropy, tol2d,
-                                 tol3d, tolG1, tolG2, maxdeg, maxseg);
+    std::vector<double> settings = {
+        double(degree), double(ptsoncurve), double(numIter), double(anisotropy),
+        tol2d, tol3d, tolG1, tolG2, double(maxdeg), double(maxseg)
+    };
 
+    try {
         if ((BoundaryEdges.getSize()) < 1) {
             return new App::DocumentObjectExecReturn("Border must have at least one curve defined.");
         }
 
         // Load the initial surface if set
+        TopoDS_Shape initSurface;
         App::DocumentObject* initFace = InitialFace.getValue();
         if (initFace && initFace->getTypeId().isDerivedFrom(Part::Feature::getClassTypeId())) {
             const Part::TopoShape& shape = static_cast<Part::Feature*>(initFace)->Shape.getShape();
@@ -291,29 +317,47 @@ App::DocumentObjectExecReturn *Filling::execute(void)
             for (auto it : subNames) {
                 TopoDS_Shape subShape = shape.getSubShape(it.c_str());
                 if (!subShape.IsNull() && subShape.ShapeType() == TopAbs_FACE) {
-                    builder.LoadInitSurface(TopoDS::Face(subShape));
+                    initSurface = subShape;
                     break;
                 }
             }
         }
 
+        std::vector<Constraint> constraints;
+
         // Add the constraints of border curves/faces (bound)
-        addConstraints(builder, BoundaryEdges, BoundaryFaces, BoundaryOrder, Standard_True);
+        addConstraints(constraints, BoundaryEdges, BoundaryFaces, BoundaryOrder, Standard_True);
 
         // Add additional edge constraints if available (unbound)
         if (UnboundEdges.getSize() > 0) {
-            addConstraints(builder, UnboundEdges, UnboundFaces, UnboundOrder, Standard_False);
+            addConstraints(constraints, UnboundEdges, UnboundFaces, UnboundOrder, Standard_False);
         }
 
         // Add additional constraint on free faces
         if (FreeFaces.getSize() > 0) {
-            addConstraints(builder, FreeFaces, FreeOrder);
+            addConstraints(constraints, FreeFaces, FreeOrder);
         }
 
         // App point constraints
         if (Points.getSize() > 0) {
-            addConstraints(builder, Points);
+            addConstraints(constraints, Points);
+        }
+
+        // The recompute of a linked object touches this feature even if the constraint
+        // shapes didn't change. As the last input is kept the shapes can't be freed and
+        // an equal shape is really the same one.
+        if (!this->Shape.getValue().IsNull() && settings == lastSettings &&
+            initSurface.IsEqual(lastInitFace) && constraints == lastConstraints) {
+            return App::DocumentObject::StdReturn;
         }
+        lastSettings.clear();
+
+        BRepFill_Filling builder(degree, ptsoncurve, numIter, anisotropy, tol2d,
+                                 tol3d, tolG1, tolG2, maxdeg, maxseg);
+        if (!initSurface.IsNull()) {
+            builder.LoadInitSurface(TopoDS::Face(initSurface));
+        }
+        addConstraints(builder, constraints);
 
         //Build the face
         builder.Build();
@@ -324,6 +368,10 @@ App::DocumentObjectExecReturn *Filling::execute(void)
         //Return the face
         TopoDS_Face aFace = builder.Face();
         this->Shape.setValue(aFace);
+
+        lastConstraints.swap(constraints);
+        lastInitFace = initSurface;
+        lastSettings.swap(settings);
         return App::DocumentObject::StdReturn;
     }
     catch (Standard_Failure& e) {
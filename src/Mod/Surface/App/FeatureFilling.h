@@ -73,16 +73,37 @@ public:
     }
 
 private:
-    void addConstraints(BRepFill_Filling& builder,
+    /// an edge, face or vertex constraint with its support face and continuity
+    struct Constraint {
+        TopoDS_Shape shape;
+        TopoDS_Shape support;
+        long order;
+        bool bound;
+
+        bool operator == (const Constraint& other) const {
+            return shape.IsEqual(other.shape) && support.IsEqual(other.support) &&
+                   order == other.order && bound == other.bound;
+        }
+    };
+
+    void addConstraints(std::vector<Constraint>& constraints,
                         const App::PropertyLinkSubList& edges,
                         const App::PropertyStringList& faces,
                         const App::PropertyIntegerList& orders,
                         Standard_Boolean bnd);
-    void addConstraints(BRepFill_Filling& builder,
+    void addConstraints(std::vector<Constraint>& constraints,
                         const App::PropertyLinkSubList& faces,
                         const App::PropertyIntegerList& orders);
-    void addConstraints(BRepFill_Filling& builder,
+    void addConstraints(std::vector<Constraint>& constraints,
                         const App::PropertyLinkSubList& points);
+    void addConstraints(BRepFill_Filling& builder,
+                        const std::vector<Constraint>& constraints);
+
+private:
+    // input of the last successful build, an unchanged input doesn't need to be built again
+    std::vector<Constraint> lastConstraints;
+    TopoDS_Shape lastInitFace;
+    std::vector<double> lastSettings;
 };
 
 } //Namespace Surface
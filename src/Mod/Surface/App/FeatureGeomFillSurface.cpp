@@ -53,6 +53,7 @@
 
 #include <Base/Exception.h>
 #include <Base/Tools.h>
+#include <Mod/Part/App/Tools.h>
 
 #include "FeatureGeomFillSurface.h"
 
@@ -320,12 +321,17 @@ void GeomFillSurface::createBezierSurface(TopoDS_Wire& aWire)
 
 void GeomFillSurface::createBSplineSurface(TopoDS_Wire& aWire)
 {
-    std::vector<Handle(Geom_BSplineCurve)> curves;
-    curves.reserve(4);
-    Standard_Real u1, u2; // contains output
-    TopExp_Explorer anExp (aWire, TopAbs_EDGE);
-    for (; anExp.More(); anExp.Next()) {
-        const TopoDS_Edge& edge = TopoDS::Edge (anExp.Current());
+    std::vector<TopoDS_Edge> edges;
+    for (TopExp_Explorer anExp (aWire, TopAbs_EDGE); anExp.More(); anExp.Next()) {
+        edges.push_back(TopoDS::Edge (anExp.Current()));
+    }
+
+    // the edges are copies of the input which don't share their curves,
+    // so the approximations are independent of each other
+    std::vector<Handle(Geom_BSplineCurve)> curves(edges.size());
+    Part::Tools::parallelFor(edges.size(), [&](std::size_t index) {
+        const TopoDS_Edge& edge = edges[index];
+        Standard_Real u1, u2; // contains output
         TopLoc_Location heloc; // this will be output
         Handle(Geom_Curve) c_geom = BRep_Tool::Curve(edge, heloc, u1, u2); //The geometric curve
         Handle(Geom_BSplineCurve) bspline = Handle(Geom_BSplineCurve)::DownCast(c_geom); //Try to get BSpline curve
@@ -333,7 +339,7 @@ void GeomFillSurface::createBSplineSurface(TopoDS_Wire& aWire)
         if (!bspline.IsNull()) {
             bspline->Transform(transf); // apply original transformation to control points
             //Store Underlying Geometry
-            curves.push_back(bspline);
+            curves[index] = bspline;
         }
         else {
             // try to convert it into a B-spline
@@ -345,7 +351,7 @@ void GeomFillSurface::createBSplineSurface(TopoDS_Wire& aWire)
             Handle(Geom_BSplineCurve) bspline2 = conv.CurveToBSplineCurve(trim, paratype);
             if (!bspline2.IsNull()) {
                 bspline2->Transform(transf); // apply original transformation to control points
-                curves.push_back(bspline2);
+                curves[index] = bspline2;
             }
             else {
                 // GeomConvert failed, try ShapeConstruct_Curve now
@@ -354,10 +360,10 @@ void GeomFillSurface::createBSplineSurface(TopoDS_Wire& aWire)
                 if (spline.IsNull())
                     Standard_Failure::Raise("A curve was not a B-spline and could not be converted into one.");
                 spline->Transform(transf); // apply original transformation to control points
-                curves.push_back(spline);
+                curves[index] = spline;
             }
         }
-    }
+    });
 
     GeomFill_FillingStyle fstyle = getFillingStyle();
     GeomFill_BSplineCurves aSurfBuilder; //Create Surface Builder
@@ -29,11 +29,11 @@
 #endif
 
 #include "FeatureSewing.h"
-#include <BRepBuilderAPI_Sewing.hxx>
 #include <BRep_Tool.hxx>
 #include <gp_Pnt.hxx>
 #include <Base/Tools.h>
 #include <Base/Exception.h>
+#include <Mod/Part/App/Tools.h>
 
 using namespace Surface;
 
@@ -75,8 +75,7 @@ App::DocumentObjectExecReturn *Sewing::execute(void)
     bool opt4 = Nonmanifold.getValue();
 
     try {
-        BRepBuilderAPI_Sewing builder(atol,opt1,opt2,opt3,opt4);
-
+        std::vector<TopoDS_Shape> shapes;
         std::vector<App::PropertyLinkSubList::SubSet> subset = ShapeList.getSubListValues();
         for(std::vector<App::PropertyLinkSubList::SubSet>::iterator it = subset.begin(); it != subset.end(); ++it) {
             // the subset has the documentobject and the element name which belongs to it,
@@ -87,8 +86,7 @@ App::DocumentObjectExecReturn *Sewing::execute(void)
 
                 //we want only the subshape which is linked
                 for (auto jt: it->second) {
-                    TopoDS_Shape sub = ts.getSubShape(jt.c_str());
-                    builder.Add(sub);
+                    shapes.push_back(ts.getSubShape(jt.c_str()));
                 }
             }
             else {
@@ -96,9 +94,8 @@ App::DocumentObjectExecReturn *Sewing::execute(void)
             }
         }
 
-        builder.Perform(); //Perform Sewing
-
-        TopoDS_Shape aShape = builder.SewedShape(); //Get Shape
+        // large face sets are sewn in clusters of neighbouring faces
+        TopoDS_Shape aShape = Part::Tools::sewShapes(shapes, atol, opt1, opt2, opt3, opt4); //Perform Sewing
         if (aShape.IsNull())
             return new App::DocumentObjectExecReturn("Resulting shape is null");
         this->Shape.setValue(aShape);
@@ -44,6 +44,7 @@
 #include <Base/PyObjectBase.h>
 #include <Base/Exception.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/Interpreter.h>
 #include <Base/Vector3D.h>
 #include <Base/VectorPy.h>
 
@@ -77,6 +78,7 @@
 #include "DrawDimHelper.h"
 #include "HatchLine.h"
 #include "DrawGeomHatch.h"
+#include "SvgPageWriter.h"
 
 namespace TechDraw {
 //module level static C++ functions go here
@@ -118,6 +120,12 @@ public:
         add_varargs_method("writeDXFPage",&Module::writeDXFPage,
             "writeDXFPage(page,filename): Exports a DrawPage to a DXF file."
         );
+        add_varargs_method("writeSVGPage",&Module::writeSVGPage,
+            "writeSVGPage(page,filename): Exports a DrawPage to a SVG file, without the gui."
+        );
+        add_varargs_method("writeSVGPages",&Module::writeSVGPages,
+            "writeSVGPages([pages],[filenames]): Exports each DrawPage to the SVG file of the same index, in parallel."
+        );
         add_varargs_method("findCentroid",&Module::findCentroid,
             "vector = findCentroid(shape,direction): finds geometric centroid of shape looking in direction."
         );
@@ -731,6 +739,81 @@ private:
         return Py::None();
     }
 
+    Py::Object writeSVGPage(const Py::Tuple& args)
+    {
+        PyObject *pageObj;
+        char* name;
+        if (!PyArg_ParseTuple(args.ptr(), "O!et", &(TechDraw::DrawPagePy::Type), &pageObj, "utf-8",&name)) {
+            throw Py::TypeError("expected (page,path");
+        }
+
+        std::string filePath = std::string(name);
+        PyMem_Free(name);
+        TechDraw::DrawPage* dp = static_cast<TechDraw::DrawPage*>(
+                                 static_cast<App::DocumentObjectPy*>(pageObj)->getDocumentObjectPtr());
+        try {
+            TechDraw::SvgPageWriter writer(dp);
+            if (!writer.write(filePath)) {
+                throw Py::RuntimeError("can not write " + filePath);
+            }
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
+    Py::Object writeSVGPages(const Py::Tuple& args)
+    {
+        PyObject *pagesObj;
+        PyObject *namesObj;
+        if (!PyArg_ParseTuple(args.ptr(), "OO", &pagesObj, &namesObj)) {
+            throw Py::TypeError("expected ([pages],[paths])");
+        }
+
+        std::vector<TechDraw::DrawPage*> pages;
+        std::vector<std::string> fileNames;
+        Py::Sequence pageList(pagesObj);
+        Py::Sequence nameList(namesObj);
+        if (pageList.size() != nameList.size()) {
+            throw Py::ValueError("expected a path for each page");
+        }
+        for (Py::Sequence::iterator it = pageList.begin(); it != pageList.end(); ++it) {
+            if (!PyObject_TypeCheck((*it).ptr(), &(TechDraw::DrawPagePy::Type))) {
+                throw Py::TypeError("expected a list of DrawPages");
+            }
+            App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>((*it).ptr())->getDocumentObjectPtr();
+            pages.push_back(static_cast<TechDraw::DrawPage*>(obj));
+        }
+        for (Py::Sequence::iterator it = nameList.begin(); it != nameList.end(); ++it) {
+            fileNames.push_back(Py::String(*it).as_std_string("utf-8"));
+        }
+
+        std::vector<std::string> failed;
+        try {
+            //the writers collect the pages in the main thread, writing needs no python
+            std::vector<TechDraw::SvgPageWriter> writers;
+            for (auto& page : pages) {
+                writers.emplace_back(page);
+            }
+            Base::PyGILStateRelease release;
+            failed = TechDraw::SvgPageWriter::writePages(writers, fileNames);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        if (!failed.empty()) {
+            std::string msg = "can not write";
+            for (auto& f : failed) {
+                msg += " " + f;
+            }
+            throw Py::RuntimeError(msg);
+        }
+        return Py::None();
+    }
+
     Py::Object findCentroid(const Py::Tuple& args)
     {
         PyObject *pcObjShape;
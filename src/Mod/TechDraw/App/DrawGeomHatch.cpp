@@ -27,6 +27,7 @@
 # include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 
 # include <QFile>
 # include <QFileInfo>
@@ -36,6 +37,10 @@
 #include <Bnd_Box.hxx>
 #include <BRepBndLib.hxx>
 #include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepAdaptor_Curve.hxx>
+#include <GCPnts_TangentialDeflection.hxx>
+#include <GeomAbs_CurveType.hxx>
 
 #include <BRepAlgoAPI_Common.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
@@ -83,6 +88,131 @@
 using namespace TechDraw;
 using namespace std;
 
+namespace {
+
+struct BoundarySegment
+{
+    double x1, y1, x2, y2;
+};
+
+//! chord deflection used to discretize curved face boundaries for the scanline clipper
+const double boundaryDeflection = 0.005;
+
+//! break the face boundary into straight segments.  returns true if any edge had to be
+//! discretized, ie the result is only an approximation of the boundary.
+bool discretizeBoundary(const TopoDS_Face& face, std::vector<BoundarySegment>& segments)
+{
+    bool curved = false;
+    for (TopExp_Explorer expl(face, TopAbs_EDGE); expl.More(); expl.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(expl.Current());
+        if (BRep_Tool::Degenerated(edge)) {
+            continue;
+        }
+        BRepAdaptor_Curve adapt(edge);
+        if (adapt.GetType() == GeomAbs_Line) {
+            gp_Pnt p1 = adapt.Value(adapt.FirstParameter());
+            gp_Pnt p2 = adapt.Value(adapt.LastParameter());
+            segments.push_back({p1.X(), p1.Y(), p2.X(), p2.Y()});
+            continue;
+        }
+        curved = true;
+        GCPnts_TangentialDeflection discretizer(adapt, 0.1, boundaryDeflection);
+        for (int i = 1; i < discretizer.NbPoints(); i++) {
+            gp_Pnt p1 = discretizer.Value(i);
+            gp_Pnt p2 = discretizer.Value(i + 1);
+            segments.push_back({p1.X(), p1.Y(), p2.X(), p2.Y()});
+        }
+    }
+    return curved;
+}
+
+//! clip the parallel, evenly spaced overlay lines against the boundary polygon.  each boundary
+//! segment is only intersected with the lines it actually crosses, the crossings are collected
+//! per line and paired up along the line (even-odd rule).
+bool clipOverlay(const std::vector<TopoDS_Edge>& candidates,
+                 const std::vector<BoundarySegment>& boundary,
+                 std::vector<TopoDS_Edge>& resultEdges)
+{
+    if (candidates.empty()) {
+        return true;
+    }
+
+    TopoDS_Vertex v1, v2;
+    TopExp::Vertices(candidates.front(), v1, v2);
+    gp_Pnt start = BRep_Tool::Pnt(v1);
+    gp_Pnt end = BRep_Tool::Pnt(v2);
+    double dirX = end.X() - start.X();
+    double dirY = end.Y() - start.Y();
+    double length = sqrt(dirX * dirX + dirY * dirY);
+    if (length < Precision::Confusion()) {
+        return false;
+    }
+    dirX /= length;
+    dirY /= length;
+    double normX = -dirY;
+    double normY = dirX;
+
+    //makeEdgeOverlay steps the lines by a constant offset. line i lies at normal distance
+    //offset0 + i * step from the origin
+    double offset0 = normX * start.X() + normY * start.Y();
+    double step = 0.0;
+    if (candidates.size() > 1) {
+        TopExp::Vertices(candidates.back(), v1, v2);
+        gp_Pnt last = BRep_Tool::Pnt(v1);
+        step = (normX * last.X() + normY * last.Y() - offset0) / (candidates.size() - 1);
+        if (fabs(step) < Precision::Confusion()) {
+            return false;
+        }
+    } else {
+        step = 1.0;
+    }
+
+    int lineCount = (int) candidates.size();
+    std::vector<std::vector<double> > crossings(lineCount);
+    for (auto& seg: boundary) {
+        double t1 = (normX * seg.x1 + normY * seg.y1 - offset0) / step;
+        double t2 = (normX * seg.x2 + normY * seg.y2 - offset0) / step;
+        if (t1 == t2) {
+            continue;           //parallel to the lines
+        }
+        //lines in the half open interval (tLow, tHigh], so a shared vertex is counted once
+        double tLow = std::min(t1, t2);
+        double tHigh = std::max(t1, t2);
+        int first = std::max((int) floor(tLow) + 1, 0);
+        int last = std::min((int) floor(tHigh), lineCount - 1);
+        for (int i = first; i <= last; i++) {
+            double f = (i - t1) / (t2 - t1);
+            double x = seg.x1 + f * (seg.x2 - seg.x1);
+            double y = seg.y1 + f * (seg.y2 - seg.y1);
+            crossings[i].push_back(dirX * x + dirY * y);
+        }
+    }
+
+    for (int i = 0; i < lineCount; i++) {
+        std::vector<double>& params = crossings[i];
+        if (params.size() < 2) {
+            continue;
+        }
+        std::sort(params.begin(), params.end());
+        double offset = offset0 + i * step;
+        for (size_t j = 0; j + 1 < params.size(); j += 2) {
+            if (params[j + 1] - params[j] < Precision::Confusion()) {
+                continue;
+            }
+            Base::Vector3d s(offset * normX + params[j] * dirX,
+                             offset * normY + params[j] * dirY,
+                             0.0);
+            Base::Vector3d e(offset * normX + params[j + 1] * dirX,
+                             offset * normY + params[j + 1] * dirY,
+                             0.0);
+            resultEdges.push_back(DrawGeomHatch::makeLine(s, e));
+        }
+    }
+    return true;
+}
+
+}
+
 App::PropertyFloatConstraint::Constraints DrawGeomHatch::scaleRange = {Precision::Confusion(),
                                                                        std::numeric_limits<double>::max(),
                                                                        (0.1)}; // increment by 0.1
@@ -288,44 +418,27 @@ std::vector<LineSet> DrawGeomHatch::getTrimmedLines(DrawViewPart* source,
     BRepBndLib::Add(face, bBox);
     bBox.SetGap(0.0);
 
+    //straight boundaries are clipped exactly by the scanline clipper. curved ones are
+    //discretized, unless the user asked for exact trimming by OCC booleans
+    std::vector<BoundarySegment> boundary;
+    bool curved = discretizeBoundary(face, boundary);
+    bool scanline = !(curved && prefExactTrim());
+
     for (auto& ls: lineSets) {
         PATLineSpec hl = ls.getPATLineSpec();
         std::vector<TopoDS_Edge> candidates = DrawGeomHatch::makeEdgeOverlay(hl, bBox, scale);   //completely cover face bbox with lines
 
-        //make Compound for this linespec
-        BRep_Builder builder;
-        TopoDS_Compound grid;
-        builder.MakeCompound(grid);
-        for (auto& c: candidates) {
-           builder.Add(grid, c);
-        }
-
-        //Common(Compound,Face)
-        BRepAlgoAPI_Common mkCommon(face, grid);
-        if ((!mkCommon.IsDone())  ||
-            (mkCommon.Shape().IsNull()) ) {
-            Base::Console().Log("INFO - DGH::getTrimmedLines - Common creation failed\n");
-            return result;
-        }
-        TopoDS_Shape common = mkCommon.Shape();
-
-        //save the boundingBox of hatch pattern
-        Bnd_Box overlayBox;
-        overlayBox.SetGap(0.0);
-        BRepBndLib::Add(common, overlayBox);
-        ls.setBBox(overlayBox);
-
-        //get resulting edges
         std::vector<TopoDS_Edge> resultEdges;
-        TopTools_IndexedMapOfShape mapOfEdges;
-        TopExp::MapShapes(common, TopAbs_EDGE, mapOfEdges);
-        for ( int i = 1 ; i <= mapOfEdges.Extent() ; i++ ) {           //remember, TopExp makes no promises about the order it finds edges
-            const TopoDS_Edge& edge = TopoDS::Edge(mapOfEdges(i));
-            if (edge.IsNull()) {
-                Base::Console().Log("INFO - DGH::getTrimmedLines - edge: %d is NULL\n",i);
-                continue;
+        if (scanline &&
+            clipOverlay(candidates, boundary, resultEdges)) {
+            Bnd_Box overlayBox;
+            overlayBox.SetGap(0.0);
+            for (auto& e: resultEdges) {
+                BRepBndLib::Add(e, overlayBox);
             }
-            resultEdges.push_back(edge);
+            ls.setBBox(overlayBox);
+        } else if (!trimByCommon(face, candidates, ls, resultEdges)) {
+            return result;
         }
 
         std::vector<TechDraw::BaseGeom*> resultGeoms;
@@ -346,6 +459,50 @@ std::vector<LineSet> DrawGeomHatch::getTrimmedLines(DrawViewPart* source,
     return result;
 }
 
+/* static */
+//! trim the overlay lines with a boolean Common against the face
+bool DrawGeomHatch::trimByCommon(TopoDS_Face face,
+                                 std::vector<TopoDS_Edge> candidates,
+                                 LineSet& ls,
+                                 std::vector<TopoDS_Edge>& resultEdges)
+{
+    //make Compound for this linespec
+    BRep_Builder builder;
+    TopoDS_Compound grid;
+    builder.MakeCompound(grid);
+    for (auto& c: candidates) {
+       builder.Add(grid, c);
+    }
+
+    //Common(Compound,Face)
+    BRepAlgoAPI_Common mkCommon(face, grid);
+    if ((!mkCommon.IsDone())  ||
+        (mkCommon.Shape().IsNull()) ) {
+        Base::Console().Log("INFO - DGH::getTrimmedLines - Common creation failed\n");
+        return false;
+    }
+    TopoDS_Shape common = mkCommon.Shape();
+
+    //save the boundingBox of hatch pattern
+    Bnd_Box overlayBox;
+    overlayBox.SetGap(0.0);
+    BRepBndLib::Add(common, overlayBox);
+    ls.setBBox(overlayBox);
+
+    //get resulting edges
+    TopTools_IndexedMapOfShape mapOfEdges;
+    TopExp::MapShapes(common, TopAbs_EDGE, mapOfEdges);
+    for ( int i = 1 ; i <= mapOfEdges.Extent() ; i++ ) {           //remember, TopExp makes no promises about the order it finds edges
+        const TopoDS_Edge& edge = TopoDS::Edge(mapOfEdges(i));
+        if (edge.IsNull()) {
+            Base::Console().Log("INFO - DGH::getTrimmedLines - edge: %d is NULL\n",i);
+            continue;
+        }
+        resultEdges.push_back(edge);
+    }
+    return true;
+}
+
 /* static */
 std::vector<TopoDS_Edge> DrawGeomHatch::makeEdgeOverlay(PATLineSpec hl, Bnd_Box b, double scale)
 {
@@ -641,6 +798,14 @@ std::string DrawGeomHatch::prefGeomHatchName()
     return result;
 }
 
+//! trim hatch lines against curved face boundaries with OCC booleans instead of a discretized boundary
+bool DrawGeomHatch::prefExactTrim()
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/PAT");
+    return hGrp->GetBool("ExactTrim", false);
+}
+
 App::Color DrawGeomHatch::prefGeomHatchColor()
 {
     Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
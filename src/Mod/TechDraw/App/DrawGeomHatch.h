@@ -91,6 +91,7 @@ public:
     static std::string prefGeomHatchFile(void);
     static std::string prefGeomHatchName();
     static App::Color prefGeomHatchColor();
+    static bool prefExactTrim();
 
 
 protected:
@@ -102,6 +103,10 @@ protected:
     void makeLineSets(void);
 
     std::vector<PATLineSpec> getDecodedSpecsFromFile();
+    static bool trimByCommon(TopoDS_Face face,
+                             std::vector<TopoDS_Edge> candidates,
+                             LineSet& ls,
+                             std::vector<TopoDS_Edge>& resultEdges);
     std::vector<LineSet> m_lineSets;
     std::string m_saveFile;
     std::string m_saveName;
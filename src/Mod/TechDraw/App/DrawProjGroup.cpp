@@ -63,7 +63,8 @@ const char* DrawProjGroup::ProjectionTypeEnums[] = {"First Angle",
 PROPERTY_SOURCE(TechDraw::DrawProjGroup, TechDraw::DrawViewCollection)
 
 DrawProjGroup::DrawProjGroup(void) :
-    m_lockScale(false)
+    m_lockScale(false),
+    m_childBatch(0)
 {
     static const char *group = "Base";
     static const char *agroup = "Distribute";
@@ -168,6 +169,12 @@ void DrawProjGroup::onChanged(const App::Property* prop)
 App::DocumentObjectExecReturn *DrawProjGroup::execute(void)
 {
 //    Base::Console().Message("DPG::execute() - %s\n", getNameInDocument());
+    //the group is recomputed after its children
+    if (m_docRecomputed.connected()) {
+        m_docRecomputed.disconnect();
+        endChildBatch();
+    }
+
     if (!keepUpdated()) {
         return App::DocumentObject::StdReturn;
     }
@@ -973,14 +980,80 @@ void DrawProjGroup::makeViewBbs(DrawProjGroupItem *viewPtrs[10],
 void DrawProjGroup::recomputeChildren(void)
 {
 //    Base::Console().Message("DPG::recomputeChildren()\n");
+    std::vector<DrawProjGroupItem*> views;
     for( const auto it : Views.getValues() ) {
         auto view( dynamic_cast<DrawProjGroupItem *>(it) );
         if (view == nullptr) {
             throw Base::TypeError("Error: projection in DPG list is not a DPGI!");
         } else {
-            view->recomputeFeature();
+            views.push_back(view);
+        }
+    }
+    beginChildBatch(views);
+    for (auto& view : views) {
+        view->recomputeFeature();
+    }
+    endChildBatch();
+}
+
+void DrawProjGroup::beginChildBatch(const std::vector<DrawProjGroupItem*>& views)
+{
+    if (m_childBatch++ > 0) {
+        return;
+    }
+    for (auto& view : views) {
+        view->prefetchGeometry();
+    }
+}
+
+void DrawProjGroup::endChildBatch(void)
+{
+    if (m_childBatch == 0 || --m_childBatch > 0) {
+        return;
+    }
+    m_sourceShape.Nullify();
+    m_sourceShapeFused.Nullify();
+    for (auto& view : getViewsAsDPGI()) {
+        view->discardPrefetch();
+    }
+}
+
+void DrawProjGroup::prepareChildRecompute(void)
+{
+    //a recompute of the document executes the touched children one after the other
+    App::Document* doc = getDocument();
+    if (m_childBatch > 0 || !doc || !doc->testStatus(App::Document::Recomputing)) {
+        return;
+    }
+    std::vector<DrawProjGroupItem*> views;
+    for (auto& view : getViewsAsDPGI()) {
+        if (view->isTouched() || view->mustRecompute()) {
+            views.push_back(view);
         }
     }
+    m_docRecomputed = doc->signalRecomputed.connect(
+        [this](const App::Document&, const std::vector<App::DocumentObject*>&) {
+            m_docRecomputed.disconnect();
+            endChildBatch();
+        });
+    beginChildBatch(views);
+}
+
+bool DrawProjGroup::sharesSourceShape(const DrawProjGroupItem* view) const
+{
+    return m_childBatch > 0 &&
+           view->Source.getValues() == Source.getValues() &&
+           view->XSource.getValues() == XSource.getValues();
+}
+
+TopoDS_Shape DrawProjGroup::getSharedSourceShape(const DrawProjGroupItem* view, bool fused)
+{
+    TopoDS_Shape& shape = fused ? m_sourceShapeFused : m_sourceShape;
+    if (shape.IsNull()) {
+        shape = fused ? view->DrawViewPart::getSourceShapeFused() :
+                        view->DrawViewPart::getSourceShape();
+    }
+    return shape;
 }
 
 void DrawProjGroup::autoPositionChildren(void)
@@ -1001,6 +1074,7 @@ void DrawProjGroup::autoPositionChildren(void)
 void DrawProjGroup::updateChildrenScale(void)
 {
 //    Base::Console().Message("DPG::updateChildrenScale\n");
+    std::vector<DrawProjGroupItem*> views;
     for( const auto it : Views.getValues() ) {
         auto view( dynamic_cast<DrawProjGroupItem *>(it) );
         if (view == nullptr) {
@@ -1010,9 +1084,14 @@ void DrawProjGroup::updateChildrenScale(void)
             throw Base::TypeError("Error: projection in DPG list is not a DPGI!");
         } else if(view->Scale.getValue() != Scale.getValue()) {
             view->Scale.setValue(Scale.getValue());
-            view->recomputeFeature();
+            views.push_back(view);
         }
     }
+    beginChildBatch(views);
+    for (auto& view : views) {
+        view->recomputeFeature();
+    }
+    endChildBatch();
 }
 
 /*!
@@ -1059,6 +1138,7 @@ void DrawProjGroup::updateChildrenLock(void)
 
 void DrawProjGroup::updateViews(void) {
     // this is intended to update the views in general, e.g. when the spacing changed
+    std::vector<DrawProjGroupItem*> views;
     for (const auto it : Views.getValues()) {
         auto view(dynamic_cast<DrawProjGroupItem *>(it));
         if (view == nullptr) {
@@ -1068,8 +1148,13 @@ void DrawProjGroup::updateViews(void) {
             throw Base::TypeError("Error: projection in DPG list is not a DPGI!");
         }
         else // the views are OK
-            view->recomputeFeature();
+            views.push_back(view);
+    }
+    beginChildBatch(views);
+    for (auto& view : views) {
+        view->recomputeFeature();
     }
+    endChildBatch();
 }
 
 void DrawProjGroup::updateChildrenEnforce(void)
@@ -34,6 +34,8 @@
 #include <Base/Matrix.h>
 #include <Base/Vector3D.h>
 
+#include <TopoDS_Shape.hxx>
+
 #include "DrawViewCollection.h"
 
 class gp_Dir;
@@ -141,6 +143,14 @@ public:
 
     std::vector<App::DocumentObject*> getAllSources(void) const;
 
+    /// Children recomputed between these calls share their source shape and project concurrently
+    void beginChildBatch(const std::vector<DrawProjGroupItem*>& views);
+    void endChildBatch(void);
+    /// Starts a batch for the touched children if the document is recomputing
+    void prepareChildRecompute(void);
+    bool sharesSourceShape(const DrawProjGroupItem* view) const;
+    TopoDS_Shape getSharedSourceShape(const DrawProjGroupItem* view, bool fused);
+
 
 protected:
     void onChanged(const App::Property* prop) override;
@@ -185,6 +195,11 @@ protected:
     virtual void handleChangedPropertyType(Base::XMLReader &reader, const char *TypeName, App::Property * prop) override;
     
     bool m_lockScale;
+
+    int m_childBatch;
+    TopoDS_Shape m_sourceShape;
+    TopoDS_Shape m_sourceShapeFused;
+    boost::signals2::scoped_connection m_docRecomputed;
 };
 
 } //namespace TechDraw
@@ -144,11 +144,35 @@ App::DocumentObjectExecReturn *DrawProjGroupItem::execute(void)
         return new App::DocumentObjectExecReturn("DPGI: Direction and XDirection are parallel");
     }
 
+    //project the other touched items of the group concurrently
+    auto pgroup = getPGroup();
+    if (pgroup != nullptr) {
+        pgroup->prepareChildRecompute();
+    }
+
     App::DocumentObjectExecReturn* ret = DrawViewPart::execute();
     autoPosition();
     return ret;
 }
 
+TopoDS_Shape DrawProjGroupItem::getSourceShape(void) const
+{
+    auto pgroup = getPGroup();
+    if (pgroup != nullptr && pgroup->sharesSourceShape(this)) {
+        return pgroup->getSharedSourceShape(this, false);
+    }
+    return DrawViewPart::getSourceShape();
+}
+
+TopoDS_Shape DrawProjGroupItem::getSourceShapeFused(void) const
+{
+    auto pgroup = getPGroup();
+    if (pgroup != nullptr && pgroup->sharesSourceShape(this)) {
+        return pgroup->getSharedSourceShape(this, true);
+    }
+    return DrawViewPart::getSourceShapeFused();
+}
+
 void DrawProjGroupItem::autoPosition()
 {
 //    Base::Console().Message("DPGI::autoPosition(%s)\n",Label.getValue());
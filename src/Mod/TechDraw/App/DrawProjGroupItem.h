@@ -82,6 +82,9 @@ public:
                                const bool flip=true) const override;
 
     virtual double getScale(void) const override;
+    //the items of a group share the source shape during a recompute
+    virtual TopoDS_Shape getSourceShape(void) const override;
+    virtual TopoDS_Shape getSourceShapeFused(void) const override;
     void autoPosition(void);
     bool isAnchor(void) const;
 
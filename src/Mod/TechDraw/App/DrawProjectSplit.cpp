@@ -65,8 +65,12 @@
 #include <limits>
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <GeomLib_Tool.hxx>
 
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
 #include <App/Application.h>
 #include <Base/BoundBox.h>
 #include <Base/Console.h>
@@ -88,6 +92,13 @@
 using namespace TechDraw;
 using namespace std;
 
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> EdgePoint2d;
+typedef bg::model::box<EdgePoint2d> EdgeBox;
+typedef std::pair<EdgeBox, int> EdgeBoxEntry;
+
 
 //===========================================================================
 // DrawProjectSplit
@@ -170,63 +181,7 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = origEdges.begin();
-    int iOuter = 0;
-    for (; itOuter != origEdges.end(); ++itOuter, iOuter++) {
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Message("DPS::Extract Faces - outer Bnd_Box is void\n");
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Message("DPS::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = faceEdges.begin();
-        for (; itInner != faceEdges.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DPS::Extract Faces - inner Bnd_Box is void\n");
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = findSplitPoints(origEdges);
 
     std::vector<splitPoint> sorted = sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -241,6 +196,57 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
 }
 
 
+//find the points where a vertex of one edge lies on another edge. Candidate edges
+//come from an rtree of the edge bounding boxes instead of testing every pair.
+std::vector<splitPoint> DrawProjectSplit::findSplitPoints(const std::vector<TopoDS_Edge>& edges)
+{
+    std::vector<splitPoint> splits;
+    std::vector<EdgeBoxEntry> entries;
+    entries.reserve(edges.size());
+    for (int i = 0; i < (int)edges.size(); i++) {
+        if (DrawUtil::isZeroEdge(edges[i])) {
+            continue;  //skip zero length edges. shouldn't happen ;)
+        }
+        Bnd_Box box;
+        BRepBndLib::Add(edges[i], box);
+        box.SetGap(0.1);
+        if (box.IsVoid()) {
+            Base::Console().Log("INFO - DPS::findSplitPoints - Bnd_Box is void for edge %d\n", i);
+            continue;
+        }
+        double xMin, yMin, zMin, xMax, yMax, zMax;
+        box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        entries.emplace_back(EdgeBox(EdgePoint2d(xMin, yMin), EdgePoint2d(xMax, yMax)), i);
+    }
+    //the range constructor packs the tree
+    bgi::rtree<EdgeBoxEntry, bgi::linear<16> > edgeTree(entries.begin(), entries.end());
+
+    std::vector<EdgeBoxEntry> found;
+    for (auto& outer: entries) {
+        const TopoDS_Edge& e = edges[outer.second];
+        TopoDS_Vertex ends[2] = { TopExp::FirstVertex(e), TopExp::LastVertex(e) };
+        for (auto& v: ends) {
+            gp_Pnt pnt = BRep_Tool::Pnt(v);
+            found.clear();
+            edgeTree.query(bgi::intersects(EdgePoint2d(pnt.X(), pnt.Y())), std::back_inserter(found));
+            for (auto& inner: found) {
+                if (inner.second == outer.second) {
+                    continue;
+                }
+                double param = -1;
+                if (isOnEdge(edges[inner.second], v, param, false)) {
+                    splitPoint s;
+                    s.i = inner.second;
+                    s.v = Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z());
+                    s.param = param;
+                    splits.push_back(s);
+                }
+            }
+        }
+    }
+    return splits;
+}
+
 //this routine is the big time consumer.  gets called many times (and is slow?))
 //note param gets modified here
 bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, bool allowEnds)
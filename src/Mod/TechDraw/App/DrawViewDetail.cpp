@@ -259,8 +259,8 @@ App::DocumentObjectExecReturn *DrawViewDetail::execute(void)
     detailExec(shape, dvp, dvs);
     addShapes2d();
 
-    //second pass if required
-    if (ScaleType.isValue("Automatic")) {
+    //second pass if required, once the geometry is known
+    if (ScaleType.isValue("Automatic") && !waitingForHlr()) {
         if (!checkFit()) {
             double newScale = autoScale();
             Scale.setValue(newScale);
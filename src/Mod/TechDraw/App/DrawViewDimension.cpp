@@ -387,7 +387,8 @@ App::DocumentObjectExecReturn *DrawViewDimension::execute(void)
     }
 
     //can't do anything until Source has geometry
-    if (!getViewPart()->hasGeometry()) {                              //happens when loading saved document
+    if (!getViewPart()->hasGeometry() ||
+        getViewPart()->waitingForHlr()) {                              //happens when loading saved document
         //if (isRestoring() ||
         //    getDocument()->testStatus(App::Document::Status::Restoring)) {
             return App::DocumentObject::StdReturn;
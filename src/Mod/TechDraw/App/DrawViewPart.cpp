@@ -30,6 +30,7 @@
 
 #include <Bnd_Box.hxx>
 #include <BRepAdaptor_Curve.hxx>
+#include <BRepAdaptor_Surface.hxx>
 #include <BRepAlgoAPI_Fuse.hxx>
 #include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_Copy.hxx>
@@ -51,12 +52,14 @@
 #include <gp_Dir.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Pnt.hxx>
+#include <gp_Pnt2d.hxx>
 #include <GProp_GProps.hxx>
 #include <gp_XYZ.hxx>
 #include <HLRAlgo_Projector.hxx>
 #include <HLRBRep_Algo.hxx>
 #include <HLRBRep_HLRToShape.hxx>
 #include <HLRBRep_ShapeBounds.hxx>
+#include <Precision.hxx>
 #include <ShapeExtend_WireData.hxx>
 #include <ShapeFix_ShapeTolerance.hxx>
 #include <ShapeFix_Wire.hxx>
@@ -78,6 +81,13 @@
 #include <limits>
 #include <algorithm>
 #include <cmath>
+#include <boost/functional/hash.hpp>
+
+#include <QCoreApplication>
+#include <QFutureWatcher>
+#include <QThread>
+#include <QTimer>
+#include <QtConcurrentRun>
 
 #include <App/Application.h>
 #include <App/Document.h>
@@ -127,7 +137,13 @@ PROPERTY_SOURCE_WITH_EXTENSIONS(TechDraw::DrawViewPart,
                                 TechDraw::DrawView)
 
 DrawViewPart::DrawViewPart(void) :
-    geometryObject(0)
+    geometryObject(0),
+    m_hlrJob(nullptr),
+    m_hlrResult(nullptr),
+    m_hlrRunning(false),
+    m_hlrStale(false),
+    m_hlrPrefetch(false),
+    m_hlrPrefetched(false)
 {
     static const char *group = "Projection";
     static const char *sgroup = "HLR Parameters";
@@ -169,13 +185,29 @@ DrawViewPart::DrawViewPart(void) :
     ADD_PROPERTY_TYPE(IsoHidden ,(prefIsoHid()),sgroup,App::Prop_None,"Show Hidden Iso u,v lines");
     ADD_PROPERTY_TYPE(IsoCount ,(prefIsoCount()),sgroup,App::Prop_None,"Number of iso parameters lines");
 
+    App::PropertyType cacheType = (App::PropertyType)(App::Prop_Hidden | App::Prop_Output | App::Prop_NoRecompute);
+    ADD_PROPERTY_TYPE(ProjectionCache ,(TopoDS_Shape()),sgroup,cacheType,"Projected edges of the last execute");
+    ADD_PROPERTY_TYPE(ProjectionCacheKey ,(""),sgroup,cacheType,"Shape and projection the cached edges belong to");
+    ADD_PROPERTY_TYPE(ProjectionCacheScale ,(1.0),sgroup,cacheType,"Scale of the cached edges");
+
     geometryObject = nullptr;
     //initialize bbox to non-garbage
     bbox = Base::BoundBox3d(Base::Vector3d(0.0, 0.0, 0.0), 0.0);
+
+    m_hlrWatcher = new QFutureWatcher<void>();
+    QObject::connect(m_hlrWatcher, &QFutureWatcher<void>::finished, [this]() {
+        onHlrFinished();
+    });
 }
 
 DrawViewPart::~DrawViewPart()
 {
+    //the projection running in the background owns m_hlrJob
+    m_hlrWatcher->waitForFinished();
+    delete m_hlrWatcher;
+    delete m_hlrJob;
+    delete m_hlrResult;
+
     removeAllReferencesFromGeom();
     delete geometryObject;
 }
@@ -292,8 +324,8 @@ App::DocumentObjectExecReturn *DrawViewPart::execute(void)
     partExec(shape);
     addShapes2d();
 
-    //second pass if required
-    if (ScaleType.isValue("Automatic")) {
+    //second pass if required, once the geometry is known
+    if (ScaleType.isValue("Automatic") && !waitingForHlr()) {
         if (!checkFit()) {
             double newScale = autoScale();
             Scale.setValue(newScale);
@@ -414,6 +446,9 @@ GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
                             inputCenter.Y(),
                             inputCenter.Z());
 
+    //the key only covers what changes the result of the projection
+    m_cacheKey = projectionCacheKey(shape, viewAxis);
+
     //center shape on origin
     TopoDS_Shape centeredShape = TechDraw::moveShape(shape,
                                                      centroid * -1.0);
@@ -429,18 +464,19 @@ GeometryObject* DrawViewPart::makeGeometryForShape(TopoDS_Shape shape)
      }
 //    BRepTools::Write(scaledShape, "DVPScaled.brep");            //debug
     GeometryObject* go =  buildGeometryObject(scaledShape,viewAxis);
+    m_cacheKey.clear();
     return go;
 }
 
-//note: slightly different than routine with same name in DrawProjectSplit
-TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis)
-{
-    TechDraw::GeometryObject* go = new TechDraw::GeometryObject(getNameInDocument(), this);
-    go->setIsoCount(IsoCount.getValue());
-    go->isPerspective(Perspective.getValue());
-    go->setFocus(Focus.getValue());
-    go->usePolygonHLR(CoarseView.getValue());
+namespace {
+
+typedef std::vector<std::pair<TechDraw::edgeClass, bool> > EdgeCategories;
 
+//project the shape and extract the edges of the categories. This only touches go,
+//so it can run in a worker thread.
+void projectGeometry(TechDraw::GeometryObject* go, const TopoDS_Shape& shape,
+                     const gp_Ax2& viewAxis, const EdgeCategories& categories)
+{
     if (go->usePolygonHLR()){
         go->projectShapeWithPolygonAlgo(shape,
             viewAxis);
@@ -450,41 +486,171 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
             viewAxis);
     }
 
-    go->extractGeometry(TechDraw::ecHARD,                   //always show the hard&outline visible lines
-                        true);
-    go->extractGeometry(TechDraw::ecOUTLINE,
-                        true);
+    for (auto& category : categories) {
+        go->extractGeometry(category.first,
+                            category.second);
+    }
+}
+
+long long quantize(double value)
+{
+    return llround(value / Precision::Confusion());
+}
+
+void hashPoint(std::size_t& seed, const gp_Pnt& point)
+{
+    boost::hash_combine(seed, quantize(point.X()));
+    boost::hash_combine(seed, quantize(point.Y()));
+    boost::hash_combine(seed, quantize(point.Z()));
+}
+
+//a hash of the geometry of the shape. The source shape is a new copy on every execute,
+//so the identity of the shape can't be used.
+std::size_t shapeFingerprint(const TopoDS_Shape& shape)
+{
+    std::size_t seed = 0;
+    for (TopExp_Explorer expl(shape, TopAbs_FACE); expl.More(); expl.Next()) {
+        BRepAdaptor_Surface adapt(TopoDS::Face(expl.Current()));
+        boost::hash_combine(seed, int(adapt.GetType()));
+    }
+    for (TopExp_Explorer expl(shape, TopAbs_EDGE); expl.More(); expl.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(expl.Current());
+        if (BRep_Tool::Degenerated(edge)) {
+            continue;
+        }
+        BRepAdaptor_Curve adapt(edge);
+        boost::hash_combine(seed, int(adapt.GetType()));
+        hashPoint(seed, adapt.Value(adapt.FirstParameter()));
+        hashPoint(seed, adapt.Value((adapt.FirstParameter() + adapt.LastParameter()) / 2.0));
+        hashPoint(seed, adapt.Value(adapt.LastParameter()));
+    }
+    for (TopExp_Explorer expl(shape, TopAbs_VERTEX, TopAbs_EDGE); expl.More(); expl.Next()) {
+        hashPoint(seed, BRep_Tool::Pnt(TopoDS::Vertex(expl.Current())));
+    }
+    return seed;
+}
+
+//extent of the shape in the projection plane, shown while the projection is running
+Base::BoundBox3d projectedBoundBox(const TopoDS_Shape& shape, const gp_Ax2& viewAxis)
+{
+    Bnd_Box box;
+    BRepBndLib::Add(shape, box, false);
+    if (box.IsVoid()) {
+        return Base::BoundBox3d(Base::Vector3d(0.0, 0.0, 0.0), 0.0);
+    }
+    double x[2], y[2], z[2];
+    box.Get(x[0], y[0], z[0], x[1], y[1], z[1]);
+
+    HLRAlgo_Projector projector( viewAxis );
+    Base::BoundBox3d result;
+    for (int c = 0; c < 8; c++) {
+        gp_Pnt2d prjPnt;
+        projector.Project(gp_Pnt(x[c & 1], y[(c >> 1) & 1], z[(c >> 2) & 1]), prjPnt);
+        result.Add(DrawUtil::invertY(Base::Vector3d(prjPnt.X(), prjPnt.Y(), 0.0)));
+    }
+    return result;
+}
+
+}
+
+//note: slightly different than routine with same name in DrawProjectSplit
+TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis)
+{
+    //a projection started by prefetchGeometry only has to be waited for
+    if (m_hlrRunning && m_hlrPrefetched) {
+        m_hlrWatcher->waitForFinished();
+        m_hlrRunning = false;
+        m_hlrPrefetched = false;
+        delete m_hlrResult;
+        m_hlrResult = m_hlrJob;
+        m_hlrJob = nullptr;
+    }
+
+    //a projection finished in the background is picked up by the execute it triggers
+    if (m_hlrResult != nullptr) {
+        TechDraw::GeometryObject* go = m_hlrResult;
+        m_hlrResult = nullptr;
+        saveProjectionCache(go);
+        bbox = go->calcBoundingBox();
+        return go;
+    }
+
+    TechDraw::GeometryObject* go = new TechDraw::GeometryObject(getNameInDocument(), this);
+    go->setIsoCount(IsoCount.getValue());
+    go->isPerspective(Perspective.getValue());
+    go->setFocus(Focus.getValue());
+    go->usePolygonHLR(CoarseView.getValue());
+    go->useParallelHLR(prefParallelHLR());
+
+    EdgeCategories categories;
+    categories.emplace_back(TechDraw::ecHARD, true);        //always show the hard&outline visible lines
+    categories.emplace_back(TechDraw::ecOUTLINE, true);
     if (SmoothVisible.getValue()) {
-        go->extractGeometry(TechDraw::ecSMOOTH,
-                            true);
+        categories.emplace_back(TechDraw::ecSMOOTH, true);
     }
     if (SeamVisible.getValue()) {
-        go->extractGeometry(TechDraw::ecSEAM,
-                            true);
+        categories.emplace_back(TechDraw::ecSEAM, true);
     }
     if ((IsoVisible.getValue()) && (IsoCount.getValue() > 0)) {
-        go->extractGeometry(TechDraw::ecUVISO,
-                            true);
+        categories.emplace_back(TechDraw::ecUVISO, true);
     }
     if (HardHidden.getValue()) {
-        go->extractGeometry(TechDraw::ecHARD,
-                            false);
-        go->extractGeometry(TechDraw::ecOUTLINE,
-                            false);
+        categories.emplace_back(TechDraw::ecHARD, false);
+        categories.emplace_back(TechDraw::ecOUTLINE, false);
     }
     if (SmoothHidden.getValue()) {
-        go->extractGeometry(TechDraw::ecSMOOTH,
-                            false);
+        categories.emplace_back(TechDraw::ecSMOOTH, false);
     }
     if (SeamHidden.getValue()) {
-        go->extractGeometry(TechDraw::ecSEAM,
-                            false);
+        categories.emplace_back(TechDraw::ecSEAM, false);
     }
     if (IsoHidden.getValue() && (IsoCount.getValue() > 0)) {
-        go->extractGeometry(TechDraw::ecUVISO,
-                            false);
+        categories.emplace_back(TechDraw::ecUVISO, false);
+    }
+
+    //changes which don't affect the projection, like a new scale, reuse the last one
+    if (useProjectionCache(go)) {
+        if (m_hlrPrefetch) {
+            delete go;
+            return new TechDraw::GeometryObject(getNameInDocument(), this);
+        }
+        if (m_hlrRunning) {
+            m_hlrStale = true;
+        }
+        for (auto& category : categories) {
+            go->extractGeometry(category.first,
+                                category.second);
+        }
+        bbox = go->calcBoundingBox();
+        return go;
+    }
+
+    //the view shows an empty placeholder until the projection has finished. A
+    //projection which is already running is discarded when it finishes.
+    if (m_hlrPrefetch || runHlrInBackground()) {
+        if (m_hlrRunning) {
+            m_hlrStale = true;
+            delete go;
+        } else {
+            m_hlrJob = go;
+            m_hlrRunning = true;
+            m_hlrStale = false;
+            m_hlrPrefetched = m_hlrPrefetch;
+            m_hlrWatcher->setFuture(QtConcurrent::run([go, shape, viewAxis, categories]() {
+                try {
+                    projectGeometry(go, shape, viewAxis, categories);
+                }
+                catch (...) {
+                }
+            }));
+        }
+        bbox = projectedBoundBox(shape, viewAxis);
+        return new TechDraw::GeometryObject(getNameInDocument(), this);
     }
 
+    projectGeometry(go, shape, viewAxis, categories);
+    saveProjectionCache(go);
+
     const std::vector<TechDraw::BaseGeom  *> & edges = go->getEdgeGeometry();
     if (edges.empty()) {
         Base::Console().Log("DVP::buildGO - NO extracted edges!\n");
@@ -493,6 +659,155 @@ TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape,
     return go;
 }
 
+std::string DrawViewPart::projectionCacheKey(const TopoDS_Shape& shape, const gp_Ax2& viewAxis) const
+{
+    std::size_t seed = shapeFingerprint(shape);
+    hashPoint(seed, viewAxis.Location());
+    hashPoint(seed, gp_Pnt(viewAxis.Direction().XYZ()));
+    hashPoint(seed, gp_Pnt(viewAxis.XDirection().XYZ()));
+    boost::hash_combine(seed, quantize(Rotation.getValue()));
+    boost::hash_combine(seed, CoarseView.getValue());
+    boost::hash_combine(seed, IsoCount.getValue());
+    boost::hash_combine(seed, Perspective.getValue());
+    if (Perspective.getValue()) {
+        //a perspective projection doesn't just scale with the shape
+        boost::hash_combine(seed, quantize(Focus.getValue()));
+        boost::hash_combine(seed, quantize(getScale()));
+    }
+
+    std::stringstream ss;
+    ss << std::hex << seed;
+    return ss.str();
+}
+
+//! fill go with the cached projection, if it is the projection of the current state
+bool DrawViewPart::useProjectionCache(TechDraw::GeometryObject* go)
+{
+    if (m_cacheKey.empty() || !prefCacheHLR() ||
+        m_cacheKey != ProjectionCacheKey.getValue() ||
+        ProjectionCacheScale.getValue() < Precision::Confusion()) {
+        return false;
+    }
+    return go->setHLRShapes(ProjectionCache.getValue(),
+                            getScale() / ProjectionCacheScale.getValue());
+}
+
+void DrawViewPart::saveProjectionCache(TechDraw::GeometryObject* go)
+{
+    if (!prefCacheHLR()) {
+        if (!ProjectionCacheKey.isEmpty()) {
+            ProjectionCache.setValue(TopoDS_Shape());
+            ProjectionCacheKey.setValue("");
+        }
+        return;
+    }
+    if (m_cacheKey.empty()) {
+        return;
+    }
+    ProjectionCache.setValue(go->getHLRShapes());
+    ProjectionCacheKey.setValue(m_cacheKey);
+    ProjectionCacheScale.setValue(getScale());
+}
+
+bool DrawViewPart::runHlrInBackground(void)
+{
+    //the finished projection is delivered by the event loop of the gui
+    QCoreApplication* app = QCoreApplication::instance();
+    if (!app || !app->inherits("QApplication") ||
+        QThread::currentThread() != app->thread()) {
+        return false;
+    }
+    return prefBackgroundHLR();
+}
+
+void DrawViewPart::onHlrFinished(void)
+{
+    if (!m_hlrRunning || m_hlrPrefetched || !m_hlrWatcher->isFinished()) {
+        return;
+    }
+    //the event loop may run while the document is recomputing
+    App::Document* doc = getDocument();
+    if (doc && doc->testStatus(App::Document::Recomputing)) {
+        QTimer::singleShot(0, m_hlrWatcher, [this]() {
+            onHlrFinished();
+        });
+        return;
+    }
+
+    m_hlrRunning = false;
+    TechDraw::GeometryObject* go = m_hlrJob;
+    m_hlrJob = nullptr;
+    if (m_hlrStale || nowUnsetting || !doc) {
+        //recompute starts the projection of the current state
+        delete go;
+        m_hlrStale = false;
+        if (!nowUnsetting && doc) {
+            recomputeFeature();
+        }
+        return;
+    }
+
+    m_hlrResult = go;
+    recomputeFeature();
+    //execute didn't get as far as building the geometry
+    delete m_hlrResult;
+    m_hlrResult = nullptr;
+
+    //dimensions and balloons can only find their references now
+    std::vector<App::DocumentObject*> children = getInList();
+    for (auto& child : children) {
+        if (child->isDerivedFrom(DrawViewDimension::getClassTypeId()) ||
+            child->isDerivedFrom(DrawViewBalloon::getClassTypeId())) {
+            child->recomputeFeature();
+        }
+    }
+    requestPaint();
+}
+
+void DrawViewPart::prefetchGeometry(void)
+{
+    //with a gui the views project in the background anyway
+    if (m_hlrRunning || m_hlrResult != nullptr || runHlrInBackground() ||
+        !prefBackgroundHLR() || !keepUpdated() || getAllSources().empty()) {
+        return;
+    }
+    TopoDS_Shape shape = getSourceShape();
+    if (shape.IsNull()) {
+        return;
+    }
+
+    //the view keeps its state until it executes
+    Base::BoundBox3d saveBox = bbox;
+    Base::Vector3d saveCentroid = m_saveCentroid;
+    TopoDS_Shape saveShape = m_saveShape;
+    m_hlrPrefetch = true;
+    delete makeGeometryForShape(shape);
+    m_hlrPrefetch = false;
+    bbox = saveBox;
+    m_saveCentroid = saveCentroid;
+    m_saveShape = saveShape;
+}
+
+//! drop a prefetched projection which no execute has picked up
+void DrawViewPart::discardPrefetch(void)
+{
+    if (m_hlrRunning && m_hlrPrefetched) {
+        m_hlrWatcher->waitForFinished();
+        delete m_hlrJob;
+        m_hlrJob = nullptr;
+        m_hlrRunning = false;
+        m_hlrPrefetched = false;
+    }
+}
+
+void DrawViewPart::waitForHlr(void)
+{
+    if (m_hlrRunning) {
+        m_hlrWatcher->waitForFinished();
+        onHlrFinished();
+    }
+}
+
 //! make faces from the existing edge geometry
 void DrawViewPart::extractFaces()
 {
@@ -520,63 +835,7 @@ void DrawViewPart::extractFaces()
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = nonZero.begin();
-    int iOuter = 0;
-    for (; itOuter != nonZero.end(); ++itOuter, iOuter++) {    //*** itOuter != nonZero.end() - 1
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Log("DVP::Extract Faces - outer Bnd_Box is void for %s\n",getNameInDocument());
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Log("DVP::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = nonZero.begin();   //***sb itOuter + 1;
-        for (; itInner != nonZero.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DVP::Extract Faces - inner Bnd_Box is void for %s\n",getNameInDocument());
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (DrawProjectSplit::isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = DrawProjectSplit::findSplitPoints(nonZero);
 
     std::vector<splitPoint> sorted = DrawProjectSplit::sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -1426,68 +1685,59 @@ void DrawViewPart::handleChangedPropertyName(Base::XMLReader &reader, const char
     DrawView::handleChangedPropertyName(reader, TypeName, PropName);
 }
 
-bool DrawViewPart::prefHardViz(void)
+static Base::Reference<ParameterGrp> hlrParameters()
 {
-    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+    return App::GetApplication().GetUserParameter()
           .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/HLR");
-    bool result = hGrp->GetBool("HardViz", true); 
-    return result;
+}
+
+// the handles cache the values, these are queried for every new view
+bool DrawViewPart::prefHardViz(void)
+{
+    static ParameterHandle<bool> param(hlrParameters(), "HardViz", true);
+    return param;
 }
 
 bool DrawViewPart::prefSeamViz(void)
 {
-    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
-          .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/HLR");
-    bool result = hGrp->GetBool("SeamViz", true); 
-    return result;
+    static ParameterHandle<bool> param(hlrParameters(), "SeamViz", true);
+    return param;
 }
 
 bool DrawViewPart::prefSmoothViz(void)
 {
-    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
-          .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/HLR");
-    bool result = hGrp->GetBool("SmoothViz", true); 
-    return result;
+    static ParameterHandle<bool> param(hlrParameters(), "SmoothViz", true);
+    return param;
 }
 
 bool DrawViewPart::prefIsoViz(void)
 {
-    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
-          .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/HLR");
-    bool result = hGrp->GetBool("IsoViz", false); 
-    return result;
+    static ParameterHandle<bool> param(hlrParameters(), "IsoViz", false);
+    return param;
 }
 
 bool DrawViewPart::prefHardHid(void)
 {
-    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
-          .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/HLR");
-    bool result = hGrp->GetBool("HardHid",  false); 
-    return result;
+    static ParameterHandle<bool> param(hlrParameters(), "HardHid", false);
+    return param;
 }
 
 bool DrawViewPart::prefSeamHid(void)
 {
-    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
-          .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/HLR");
-    bool result = hGrp->GetBool("SeamHid", false); 
-    return result;
+    static ParameterHandle<bool> param(hlrParameters(), "SeamHid", false);
+    return param;
 }
 
 bool DrawViewPart::prefSmoothHid(void)
 {
-    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
-          .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/HLR");
-    bool result = hGrp->GetBool("SmoothHid", false); 
-    return result;
+    static ParameterHandle<bool> param(hlrParameters(), "SmoothHid", false);
+    return param;
 }
 
 bool DrawViewPart::prefIsoHid(void)
 {
-    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
-          .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/HLR");
-    bool result = hGrp->GetBool("IsoHid", false); 
-    return result;
+    static ParameterHandle<bool> param(hlrParameters(), "IsoHid", false);
+    return param;
 }
 
 int DrawViewPart::prefIsoCount(void)
@@ -1498,6 +1748,27 @@ int DrawViewPart::prefIsoCount(void)
     return result;
 }
 
+//project groups of solids which don't overlap in the view in parallel
+bool DrawViewPart::prefParallelHLR(void)
+{
+    static ParameterHandle<bool> param(hlrParameters(), "ParallelHLR", true);
+    return param;
+}
+
+//project the views in the background instead of blocking the gui
+bool DrawViewPart::prefBackgroundHLR(void)
+{
+    static ParameterHandle<bool> param(hlrParameters(), "BackgroundHLR", true);
+    return param;
+}
+
+//keep the projection with the view, so changes which don't affect it and reopening
+//the document don't have to project again
+bool DrawViewPart::prefCacheHLR(void)
+{
+    static ParameterHandle<bool> param(hlrParameters(), "CacheHLR", true);
+    return param;
+}
 
 // Python Drawing feature ---------------------------------------------------------
 
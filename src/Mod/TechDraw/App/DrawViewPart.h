@@ -37,6 +37,8 @@
 
 #include <Base/BoundBox.h>
 
+#include <Mod/Part/App/PropertyTopoShape.h>
+
 #include "PropertyGeomFormatList.h"
 #include "PropertyCenterLineList.h"
 #include "PropertyCosmeticEdgeList.h"
@@ -51,6 +53,7 @@ class gp_Ax2;
 //class TopoDS_Vertex;
 //class TopoDS_Wire;
 class TopoDS_Shape;
+template <typename T> class QFutureWatcher;
 
 namespace App
 {
@@ -112,6 +115,11 @@ public:
     App::PropertyBool   IsoHidden;
     App::PropertyInteger  IsoCount;
 
+    //projection of the last execute, reused while the shape and the view direction don't change
+    Part::PropertyPartShape ProjectionCache;
+    App::PropertyString     ProjectionCacheKey;
+    App::PropertyFloat      ProjectionCacheScale;
+
     virtual short mustExecute() const override;
     virtual void onDocumentRestored() override;
     virtual App::DocumentObjectExecReturn *execute(void) override;
@@ -131,6 +139,12 @@ public:
     const std::vector<TechDraw::Face*> getFaceGeometry() const;
 
     bool hasGeometry(void) const;
+    //the projection of the view is still running in the background
+    bool waitingForHlr(void) const { return m_hlrRunning && !m_hlrPrefetched; }
+    void waitForHlr(void);
+    //start the projection ahead of execute, so the projections of several views run concurrently
+    void prefetchGeometry(void);
+    void discardPrefetch(void);
     TechDraw::GeometryObject* getGeometryObject(void) const { return geometryObject; }
 
     TechDraw::BaseGeom* getGeomByIndex(int idx) const;               //get existing geom for edge idx in projection
@@ -222,6 +236,13 @@ protected:
 
     void extractFaces();
 
+    bool runHlrInBackground(void);
+    void onHlrFinished(void);
+
+    std::string projectionCacheKey(const TopoDS_Shape& shape, const gp_Ax2& viewAxis) const;
+    bool useProjectionCache(TechDraw::GeometryObject* go);
+    void saveProjectionCache(TechDraw::GeometryObject* go);
+
     Base::Vector3d shapeCentroid;
     void getRunControl(void);
 
@@ -241,12 +262,23 @@ protected:
     bool prefSmoothHid(void);
     bool prefIsoHid(void);
     int  prefIsoCount(void);
+    bool prefParallelHLR(void);
+    bool prefBackgroundHLR(void);
+    bool prefCacheHLR(void);
 
     std::vector<TechDraw::Vertex*> m_referenceVerts;
 
 private:
     bool nowUnsetting;
 
+    QFutureWatcher<void>* m_hlrWatcher;
+    TechDraw::GeometryObject* m_hlrJob;       //projection running in the background
+    TechDraw::GeometryObject* m_hlrResult;    //finished projection, used by the next execute
+    bool m_hlrRunning;
+    bool m_hlrStale;                          //the view has changed while the projection was running
+    bool m_hlrPrefetch;                       //buildGeometryObject is called by prefetchGeometry
+    bool m_hlrPrefetched;                     //the running projection is waited for by the next execute
+    std::string m_cacheKey;                   //key of the projection makeGeometryForShape is building
 };
 
 typedef App::FeaturePythonT<DrawViewPart> DrawViewPartPython;
@@ -77,6 +77,7 @@ PyObject* DrawViewPartPy::getVisibleEdges(PyObject *args)
 {
     (void) args;
     DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForHlr();         //scripts expect the geometry after a recompute
     Py::List pEdgeList;
     std::vector<TechDraw::BaseGeom*> geoms = dvp->getEdgeGeometry();
     for (auto& g: geoms) {
@@ -93,6 +94,7 @@ PyObject* DrawViewPartPy::getHiddenEdges(PyObject *args)
 {
     (void) args;
     DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForHlr();
     Py::List pEdgeList;
     std::vector<TechDraw::BaseGeom*> geoms = dvp->getEdgeGeometry();
     for (auto& g: geoms) {
@@ -702,6 +704,7 @@ PyObject* DrawViewPartPy::getEdgeByIndex(PyObject *args)
         throw Py::TypeError("expected (edgeIndex)");
     }
     DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForHlr();
 
     //this is scaled and +Yup
     //need unscaled and +Ydown
@@ -725,6 +728,7 @@ PyObject* DrawViewPartPy::getVertexByIndex(PyObject *args)
         throw Py::TypeError("expected (vertIndex)");
     }
     DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForHlr();
 
     //this is scaled and +Yup
     //need unscaled and +Ydown
@@ -750,6 +754,7 @@ PyObject* DrawViewPartPy::getEdgeBySelection(PyObject *args)
 
     edgeIndex = DrawUtil::getIndexFromName(std::string(selName));
     DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForHlr();
 
     //this is scaled and +Yup
     //need unscaled and +Ydown
@@ -776,6 +781,7 @@ PyObject* DrawViewPartPy::getVertexBySelection(PyObject *args)
 
     vertexIndex = DrawUtil::getIndexFromName(std::string(selName));
     DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForHlr();
 
     //this is scaled and +Yup
     //need unscaled and +Ydown
@@ -334,8 +334,8 @@ App::DocumentObjectExecReturn *DrawViewSection::execute(void)
     sectionExec(baseShape);
     addShapes2d();
 
-    //second pass if required
-    if (ScaleType.isValue("Automatic")) {
+    //second pass if required, once the geometry is known
+    if (ScaleType.isValue("Automatic") && !waitingForHlr()) {
         if (!checkFit()) {
             double newScale = autoScale();
             Scale.setValue(newScale);
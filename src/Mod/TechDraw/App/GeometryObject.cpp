@@ -57,12 +57,14 @@
 
 #include <TopoDS.hxx>
 #include <TopoDS_Shape.hxx>
+#include <TopoDS_Compound.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Wire.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TopoDS_Iterator.hxx>
 
 #endif  // #ifndef _PreComp_
 
@@ -75,6 +77,7 @@
 #include <Base/Tools.h>
 
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/Tools.h>
 
 #include "DrawUtil.h"
 #include "GeometryObject.h"
@@ -95,7 +98,8 @@ GeometryObject::GeometryObject(const string& parent, TechDraw::DrawView* parentO
     m_isoCount(0),
     m_isPersp(false),
     m_focus(100.0),
-    m_usePolygonHLR(false)
+    m_usePolygonHLR(false),
+    m_useParallelHLR(false)
 
 {
 }
@@ -170,23 +174,31 @@ void GeometryObject::clear()
     edgeGeom.clear();
 }
 
-//!set up a hidden line remover and project a shape with it
-void GeometryObject::projectShape(const TopoDS_Shape& input,
-                                  const gp_Ax2& viewAxis)
-{
-//    Base::Console().Message("GO::projectShape() - %s\n", m_parentName.c_str());
-   // Clear previous Geometry
-    clear();
-//    DrawUtil::dumpCS("GO::projectShape - VA in", viewAxis);    //debug
+namespace {
 
-    auto start = chrono::high_resolution_clock::now();
+//the line categories of a projection, in the order of HLRLines::shapes
+enum HLRLineType {
+    hlrVisHard, hlrVisSmooth, hlrVisSeam, hlrVisOutline, hlrVisIso,
+    hlrHidHard, hlrHidSmooth, hlrHidSeam, hlrHidOutline, hlrHidIso,
+    hlrLineCount
+};
+
+struct HLRLines {
+    TopoDS_Shape shapes[hlrLineCount];
+    //errors are collected instead of reported, this may run in a worker thread
+    std::vector<std::string> errors;
+};
 
+//run the exact hidden line remover on a shape and return its mirrored lines
+void runHLR(const TopoDS_Shape& input, const gp_Ax2& viewAxis, int isoCount,
+            bool isPersp, double focus, HLRLines& lines)
+{
     Handle(HLRBRep_Algo) brep_hlr = NULL;
     try {
         brep_hlr = new HLRBRep_Algo();
-        brep_hlr->Add(input, m_isoCount);
-        if (m_isPersp) {
-            double fLength = std::max(Precision::Confusion(),m_focus);
+        brep_hlr->Add(input, isoCount);
+        if (isPersp) {
+            double fLength = std::max(Precision::Confusion(),focus);
             HLRAlgo_Projector projector( viewAxis, fLength );
             brep_hlr->Projector(projector);
         } else {
@@ -198,79 +210,167 @@ void GeometryObject::projectShape(const TopoDS_Shape& input,
 
     }
     catch (const Standard_Failure& e) {
-        Base::Console().Error("GO::projectShape - OCC error - %s - while projecting shape\n",
-                              e.GetMessageString());
-        }
+        lines.errors.push_back(std::string("GO::projectShape - OCC error - ") + e.GetMessageString() +
+                               " - while projecting shape");
+    }
     catch (...) {
-        Base::Console().Error("GeometryObject::projectShape - unknown error occurred while projecting shape\n");
-//        throw Base::RuntimeError("GeometryObject::projectShape - unknown error occurred while projecting shape");
+        lines.errors.push_back("GeometryObject::projectShape - unknown error occurred while projecting shape");
     }
 
-    auto end   = chrono::high_resolution_clock::now();
-    auto diff  = end - start;
-    double diffOut = chrono::duration <double, milli> (diff).count();
-    Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in HLRBRep_Algo & co\n",m_parentName.c_str(),diffOut);
-
-    start = chrono::high_resolution_clock::now();
-
     try {
         HLRBRep_HLRToShape hlrToShape(brep_hlr);
 
-        visHard    = hlrToShape.VCompound();
-        BRepLib::BuildCurves3d(visHard);
-        visHard = invertGeometry(visHard);
-//        BRepTools::Write(visHard, "GOvisHardi.brep");            //debug
+        TopoDS_Shape* shapes = lines.shapes;
+        shapes[hlrVisHard]    = hlrToShape.VCompound();
+        shapes[hlrVisSmooth]  = hlrToShape.Rg1LineVCompound();
+        shapes[hlrVisSeam]    = hlrToShape.RgNLineVCompound();
+        shapes[hlrVisOutline] = hlrToShape.OutLineVCompound();
+        shapes[hlrVisIso]     = hlrToShape.IsoLineVCompound();
+        shapes[hlrHidHard]    = hlrToShape.HCompound();
+        shapes[hlrHidSmooth]  = hlrToShape.Rg1LineHCompound();
+        shapes[hlrHidSeam]    = hlrToShape.RgNLineHCompound();
+        shapes[hlrHidOutline] = hlrToShape.OutLineHCompound();
+        shapes[hlrHidIso]     = hlrToShape.IsoLineHCompound();
+
+        for (int i = 0; i < hlrLineCount; i++) {
+            BRepLib::BuildCurves3d(shapes[i]);
+            shapes[i] = GeometryObject::invertGeometry(shapes[i]);
+        }
+    }
+    catch (const Standard_Failure& e) {
+        lines.errors.push_back(std::string("GO::projectShape - OCC error - ") + e.GetMessageString() +
+                               " - while extracting edges");
+    }
+    catch (...) {
+        lines.errors.push_back("GO::projectShape - unknown error while extracting edges");
+    }
+}
 
-        visSmooth  = hlrToShape.Rg1LineVCompound();
-        BRepLib::BuildCurves3d(visSmooth);
-        visSmooth = invertGeometry(visSmooth);
+}
 
-        visSeam    = hlrToShape.RgNLineVCompound();
-        BRepLib::BuildCurves3d(visSeam);
-        visSeam = invertGeometry(visSeam);
+//!set up a hidden line remover and project a shape with it
+void GeometryObject::projectShape(const TopoDS_Shape& input,
+                                  const gp_Ax2& viewAxis)
+{
+//    Base::Console().Message("GO::projectShape() - %s\n", m_parentName.c_str());
+   // Clear previous Geometry
+    clear();
+//    DrawUtil::dumpCS("GO::projectShape - VA in", viewAxis);    //debug
 
-        visOutline    = hlrToShape.OutLineVCompound();
-        BRepLib::BuildCurves3d(visOutline);
-        visOutline = invertGeometry(visOutline);
+    auto start = chrono::high_resolution_clock::now();
 
-        visIso     = hlrToShape.IsoLineVCompound();
-        BRepLib::BuildCurves3d(visIso);
-        visIso = invertGeometry(visIso);
+    //the groups of a perspective view may overlap even if their extents in
+    //the projection plane don't
+    std::vector<TopoDS_Shape> groups;
+    if (m_useParallelHLR && !m_isPersp) {
+        groups = Part::Tools::splitByProjection(input, viewAxis);
+    }
 
-        hidHard    = hlrToShape.HCompound();
-        BRepLib::BuildCurves3d(hidHard);
-        hidHard = invertGeometry(hidHard);
-//        BRepTools::Write(hidHard, "GOhidHardi.brep");            //debug
+    std::vector<HLRLines> results(std::max<size_t>(groups.size(), 1));
+    if (groups.empty()) {
+        runHLR(input, viewAxis, m_isoCount, m_isPersp, m_focus, results.front());
+    } else {
+        Part::Tools::parallelFor(groups.size(), [&](std::size_t i) {
+            runHLR(groups[i], viewAxis, m_isoCount, m_isPersp, m_focus, results[i]);
+        });
+    }
 
-        hidSmooth  = hlrToShape.Rg1LineHCompound();
-        BRepLib::BuildCurves3d(hidSmooth);
-        hidSmooth = invertGeometry(hidSmooth);
+    TopoDS_Shape lines[hlrLineCount];
+    BRep_Builder builder;
+    for (int i = 0; i < hlrLineCount; i++) {
+        if (results.size() == 1) {
+            lines[i] = results.front().shapes[i];
+            continue;
+        }
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (auto& result : results) {
+            if (!result.shapes[i].IsNull()) {
+                builder.Add(comp, result.shapes[i]);
+            }
+        }
+        lines[i] = comp;
+    }
+    for (auto& result : results) {
+        for (auto& error : result.errors) {
+            Base::Console().Error("%s\n", error.c_str());
+        }
+    }
 
-        hidSeam    = hlrToShape.RgNLineHCompound();
-        BRepLib::BuildCurves3d(hidSeam);
-        hidSeam = invertGeometry(hidSeam);
+    visHard    = lines[hlrVisHard];
+    visSmooth  = lines[hlrVisSmooth];
+    visSeam    = lines[hlrVisSeam];
+    visOutline = lines[hlrVisOutline];
+    visIso     = lines[hlrVisIso];
+    hidHard    = lines[hlrHidHard];
+    hidSmooth  = lines[hlrHidSmooth];
+    hidSeam    = lines[hlrHidSeam];
+    hidOutline = lines[hlrHidOutline];
+    hidIso     = lines[hlrHidIso];
+//    BRepTools::Write(visHard, "GOvisHardi.brep");            //debug
 
-        hidOutline = hlrToShape.OutLineHCompound();
-        BRepLib::BuildCurves3d(hidOutline);
-        hidOutline = invertGeometry(hidOutline);
+    auto end   = chrono::high_resolution_clock::now();
+    auto diff  = end - start;
+    double diffOut = chrono::duration <double, milli> (diff).count();
+    Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in HLRBRep_Algo, hlrToShape and BuildCurves (%d groups)\n",
+                        m_parentName.c_str(), diffOut, int(results.size()));
+}
 
-        hidIso     = hlrToShape.IsoLineHCompound();
-        BRepLib::BuildCurves3d(hidIso);
-        hidIso = invertGeometry(hidIso);
+namespace {
 
+int countChildren(const TopoDS_Shape& shape)
+{
+    int count = 0;
+    for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+        count++;
     }
-    catch (const Standard_Failure& e) {
-        Base::Console().Error("GO::projectShape - OCC error - %s - while extracting edges\n",
-                              e.GetMessageString());
+    return count;
+}
+
+}
+
+TopoDS_Shape GeometryObject::getHLRShapes(void) const
+{
+    const TopoDS_Shape* lines[] = { &visHard, &visOutline, &visSmooth, &visSeam, &visIso,
+                                    &hidHard, &hidOutline, &hidSmooth, &hidSeam, &hidIso };
+    BRep_Builder builder;
+    TopoDS_Compound packed;
+    builder.MakeCompound(packed);
+    for (auto& line : lines) {
+        //keep the position of a missing category
+        if (line->IsNull()) {
+            TopoDS_Compound empty;
+            builder.MakeCompound(empty);
+            builder.Add(packed, empty);
+        } else {
+            builder.Add(packed, *line);
+        }
     }
-    catch (...) {
-        Base::Console().Error("GO::projectShape - unknown error while extracting edges\n");
-//        throw Base::RuntimeError("GeometryObject::projectShape - error occurred while extracting edges");
+    return packed;
+}
+
+bool GeometryObject::setHLRShapes(const TopoDS_Shape& packed, double scale)
+{
+    TopoDS_Shape* lines[] = { &visHard, &visOutline, &visSmooth, &visSeam, &visIso,
+                              &hidHard, &hidOutline, &hidSmooth, &hidSeam, &hidIso };
+    const int lineCount = sizeof(lines) / sizeof(lines[0]);
+    if (packed.IsNull() || countChildren(packed) != lineCount) {
+        return false;
+    }
+
+    clear();
+    int i = 0;
+    for (TopoDS_Iterator it(packed); it.More(); it.Next(), i++) {
+        const TopoDS_Shape& line = it.Value();
+        if (countChildren(line) == 0) {
+            lines[i]->Nullify();
+        } else if (DrawUtil::fpCompare(scale, 1.0)) {
+            *lines[i] = line;
+        } else {
+            *lines[i] = scaleShape(line, scale);
+        }
     }
-    end   = chrono::high_resolution_clock::now();
-    diff  = end - start;
-    diffOut = chrono::duration <double, milli> (diff).count();
-    Base::Console().Log("TIMING - %s GO spent: %.3f millisecs in hlrToShape and BuildCurves\n",m_parentName.c_str(),diffOut);
+    return true;
 }
 
 //mirror a shape thru XZ plane for Qt's inverted Y coordinate
@@ -128,6 +128,8 @@ public:
     bool isPerspective(void) { return m_isPersp; }
     void usePolygonHLR(bool b) { m_usePolygonHLR = b; }
     bool usePolygonHLR(void) const { return m_usePolygonHLR; }
+    void useParallelHLR(bool b) { m_useParallelHLR = b; }
+    bool useParallelHLR(void) const { return m_useParallelHLR; }
     void setFocus(double f) { m_focus = f; }
     double getFocus(void) { return m_focus; }
     void pruneVertexGeom(Base::Vector3d center, double radius);
@@ -146,6 +148,11 @@ public:
     TopoDS_Shape getHidSeam(void)    { return hidSeam; }
     TopoDS_Shape getHidIso(void)     { return hidIso; }
 
+    //! the HLR output packed into one compound, so it can be kept with the view
+    TopoDS_Shape getHLRShapes(void) const;
+    //! restore the HLR output from getHLRShapes, scaled about the origin
+    bool setHLRShapes(const TopoDS_Shape& packed, double scale);
+
     void addVertex(TechDraw::Vertex* v);
     void addEdge(TechDraw::BaseGeom* bg);
 
@@ -204,6 +211,7 @@ protected:
     bool m_isPersp;
     double m_focus;
     bool m_usePolygonHLR;
+    bool m_useParallelHLR;
 };
 
 } //namespace TechDraw
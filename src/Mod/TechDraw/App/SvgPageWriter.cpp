@@ -0,0 +1,364 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef _SvgPageWriter_h_
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <sstream>
+# include <fstream>
+# include <iterator>
+# include <boost/regex.hpp>
+
+#include <BRep_Builder.hxx>
+#include <Precision.hxx>
+#include <Standard_Failure.hxx>
+#include <TopoDS_Compound.hxx>
+
+#endif
+
+#include <App/Application.h>
+#include <Base/Console.h>
+#include <Base/FileInfo.h>
+#include <Base/Parameter.h>
+#include <Base/Stream.h>
+
+#include <Mod/Drawing/App/DrawingExport.h>
+#include <Mod/Part/App/Tools.h>
+
+#include "DrawPage.h"
+#include "DrawProjGroup.h"
+#include "DrawProjGroupItem.h"
+#include "DrawSVGTemplate.h"
+#include "DrawUtil.h"
+#include "DrawViewAnnotation.h"
+#include "DrawViewDimension.h"
+#include "DrawViewPart.h"
+#include "Geometry.h"
+#include "GeometryObject.h"
+#include "Preferences.h"
+#include "SvgPageWriter.h"
+
+using namespace TechDraw;
+
+namespace {
+
+std::string escapeXml(const std::string& text)
+{
+    std::string result;
+    result.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '&': result += "&amp;"; break;
+            case '<': result += "&lt;"; break;
+            case '>': result += "&gt;"; break;
+            case '"': result += "&quot;"; break;
+            default: result += c;
+        }
+    }
+    return result;
+}
+
+}
+
+SvgPageWriter::SvgPageWriter(DrawPage* page) :
+    m_width(page->getPageWidth()),
+    m_height(page->getPageHeight()),
+    m_thickWeight(DrawUtil::getDefaultLineWeight("Thick")),
+    m_thinWeight(DrawUtil::getDefaultLineWeight("Thin")),
+    m_dimFontSize(Preferences::dimFontSizeMM()),
+    m_font(Preferences::labelFont())
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter().
+                                         GetGroup("BaseApp")->GetGroup("Preferences")->
+                                         GetGroup("Mod/TechDraw/Dimensions");
+    m_arrowSize = hGrp->GetFloat("ArrowSize", m_dimFontSize);
+
+    App::DocumentObject* templ = page->Template.getValue();
+    if (templ && templ->isDerivedFrom(DrawSVGTemplate::getClassTypeId())) {
+        m_templateFile = static_cast<DrawSVGTemplate*>(templ)->PageResult.getValue();
+    }
+
+    //dimensions need the geometry of their views, so collect the views first
+    std::vector<App::DocumentObject*> views = page->getAllViews();
+    for (auto& v : views) {
+        if (v->isDerivedFrom(DrawViewPart::getClassTypeId())) {
+            addViewPart(static_cast<DrawViewPart*>(v));
+        }
+    }
+    for (auto& v : views) {
+        if (v->isDerivedFrom(DrawViewDimension::getClassTypeId())) {
+            addDimension(static_cast<DrawViewDimension*>(v));
+        } else if (v->isDerivedFrom(DrawViewAnnotation::getClassTypeId())) {
+            addAnnotation(static_cast<DrawViewAnnotation*>(v));
+        }
+    }
+}
+
+//! position of the view center on the page, y down
+Base::Vector3d SvgPageWriter::viewPosition(DrawViewPart* dvp) const
+{
+    double x = dvp->X.getValue();
+    double y = dvp->Y.getValue();
+    if (dvp->isDerivedFrom(DrawProjGroupItem::getClassTypeId())) {
+        DrawProjGroup* dpg = static_cast<DrawProjGroupItem*>(dvp)->getPGroup();
+        if (dpg != nullptr) {
+            x += dpg->X.getValue();
+            y += dpg->Y.getValue();
+        }
+    }
+    return Base::Vector3d(x, m_height - y, 0.0);
+}
+
+void SvgPageWriter::addViewPart(DrawViewPart* dvp)
+{
+    dvp->waitForHlr();
+    if (!dvp->hasGeometry()) {
+        return;
+    }
+
+    //the edge geometry also has the cosmetic edges and center lines
+    BRep_Builder builder;
+    TopoDS_Compound visible;
+    TopoDS_Compound hidden;
+    builder.MakeCompound(visible);
+    builder.MakeCompound(hidden);
+    for (auto& g : dvp->getEdgeGeometry()) {
+        if (g->occEdge.IsNull()) {
+            continue;
+        }
+        builder.Add(g->hlrVisible ? visible : hidden, g->occEdge);
+    }
+
+    ViewData view;
+    view.position = viewPosition(dvp);
+    view.visible = visible;
+    view.hidden = hidden;
+    m_views.push_back(view);
+}
+
+void SvgPageWriter::addDimension(DrawViewDimension* dvd)
+{
+    DrawViewPart* dvp = dvd->getViewPart();
+    if (dvp == nullptr || !dvp->hasGeometry()) {
+        return;
+    }
+    //dimension points are relative to the view center, y down. The label
+    //position is relative to the view center, y up.
+    Base::Vector3d origin = viewPosition(dvp);
+    Base::Vector3d label = origin + Base::Vector3d(dvd->X.getValue(), -dvd->Y.getValue(), 0.0);
+
+    if (dvd->Type.isValue("Distance")  ||
+        dvd->Type.isValue("DistanceX") ||
+        dvd->Type.isValue("DistanceY")) {
+        pointPair pts = dvd->getLinearPoints();
+        Base::Vector3d p1 = origin + pts.first;
+        Base::Vector3d p2 = origin + pts.second;
+        Base::Vector3d dir = p2 - p1;
+        if (dvd->Type.isValue("DistanceX")) {
+            dir = Base::Vector3d(1.0, 0.0, 0.0);
+        } else if (dvd->Type.isValue("DistanceY")) {
+            dir = Base::Vector3d(0.0, 1.0, 0.0);
+        }
+        if (dir.Length() < Precision::Confusion()) {
+            return;
+        }
+        dir.Normalize();
+        //the dimension line runs through the label
+        Base::Vector3d norm(-dir.y, dir.x, 0.0);
+        Base::Vector3d foot1 = p1 + norm * ((label - p1) * norm);
+        Base::Vector3d foot2 = p2 + norm * ((label - p2) * norm);
+        m_dimLines.push_back({p1, foot1});
+        m_dimLines.push_back({p2, foot2});
+        m_dimLines.push_back({foot1, foot2});
+        m_arrows.push_back({foot1, foot1 - foot2});
+        m_arrows.push_back({foot2, foot2 - foot1});
+    } else if (dvd->Type.isValue("Radius")) {
+        arcPoints pts = dvd->getArcPoints();
+        Base::Vector3d center = origin + pts.center;
+        Base::Vector3d onCurve = origin + pts.onCurve.first;
+        m_dimLines.push_back({center, onCurve});
+        m_arrows.push_back({onCurve, onCurve - center});
+    } else if (dvd->Type.isValue("Diameter")) {
+        arcPoints pts = dvd->getArcPoints();
+        Base::Vector3d end1 = origin + pts.onCurve.first;
+        Base::Vector3d end2 = origin + pts.onCurve.second;
+        m_dimLines.push_back({end1, end2});
+        m_arrows.push_back({end1, end1 - end2});
+        m_arrows.push_back({end2, end2 - end1});
+    } else if (dvd->Type.isValue("Angle")) {
+        anglePoints pts = dvd->getAnglePoints();
+        Base::Vector3d apex = origin + pts.vertex;
+        m_dimLines.push_back({apex, origin + pts.ends.first});
+        m_dimLines.push_back({apex, origin + pts.ends.second});
+    } else {
+        return;
+    }
+
+    TextData text;
+    text.position = label;
+    text.size = m_dimFontSize;
+    text.lines.push_back(dvd->getFormattedDimensionValue());
+    m_texts.push_back(text);
+}
+
+void SvgPageWriter::addAnnotation(DrawViewAnnotation* dva)
+{
+    TextData text;
+    text.position = Base::Vector3d(dva->X.getValue(), m_height - dva->Y.getValue(), 0.0);
+    text.size = dva->TextSize.getValue();
+    text.lines = dva->Text.getValues();
+    m_texts.push_back(text);
+}
+
+//! copy the svg of the template, sized to the page
+void SvgPageWriter::writeTemplate(std::ostream& out) const
+{
+    if (m_templateFile.empty()) {
+        return;
+    }
+    Base::FileInfo fi(m_templateFile);
+    Base::ifstream in(fi, std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        Base::Console().Warning("SvgPageWriter - can not read template %s\n", m_templateFile.c_str());
+        return;
+    }
+    std::string svg((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    boost::smatch match;
+    if (!boost::regex_search(svg, match, boost::regex("<svg[^>]*>"))) {
+        return;
+    }
+    //the template is nested in the page, in page units
+    std::string root = match.str();
+    root = boost::regex_replace(root, boost::regex("\\s(width|height|x|y)\\s*=\\s*\"[^\"]*\""), "");
+    std::stringstream size;
+    size << "<svg x=\"0\" y=\"0\" width=\"" << m_width << "\" height=\"" << m_height << "\"";
+    if (root.find("viewBox") == std::string::npos) {
+        size << " viewBox=\"0 0 " << m_width << " " << m_height << "\"";
+    }
+    root.replace(0, 4, size.str());
+
+    out << root;
+    out.write(svg.data() + match.position(0) + match.length(0),
+              svg.size() - match.position(0) - match.length(0));
+    out << "\n";
+}
+
+void SvgPageWriter::write(std::ostream& out) const
+{
+    out.precision(10);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+        << "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\" version=\"1.1\""
+        << " width=\"" << m_width << "mm\" height=\"" << m_height << "mm\""
+        << " viewBox=\"0 0 " << m_width << " " << m_height << "\">\n";
+
+    writeTemplate(out);
+
+    Drawing::SVGOutput svgOut;
+    for (auto& view : m_views) {
+        out << "<g transform=\"translate(" << view.position.x << "," << view.position.y << ")\""
+            << " fill=\"none\" stroke=\"#000000\" stroke-linecap=\"round\" stroke-linejoin=\"round\">\n";
+        out << "<g stroke-width=\"" << m_thickWeight << "\">\n"
+            << svgOut.exportEdges(view.visible)
+            << "</g>\n";
+        out << "<g stroke-width=\"" << m_thinWeight << "\" stroke-dasharray=\""
+            << 4.0 * m_thinWeight << "," << 2.0 * m_thinWeight << "\">\n"
+            << svgOut.exportEdges(view.hidden)
+            << "</g>\n";
+        out << "</g>\n";
+    }
+
+    out << "<g fill=\"none\" stroke=\"#000000\" stroke-width=\"" << m_thinWeight << "\">\n";
+    for (auto& line : m_dimLines) {
+        out << "<path d=\"M" << line.start.x << " " << line.start.y
+            << " L" << line.end.x << " " << line.end.y << "\" />\n";
+    }
+    out << "</g>\n";
+
+    out << "<g fill=\"#000000\" stroke=\"none\">\n";
+    for (auto& arrow : m_arrows) {
+        Base::Vector3d dir = arrow.direction;
+        if (dir.Length() < Precision::Confusion()) {
+            continue;
+        }
+        dir.Normalize();
+        Base::Vector3d norm(-dir.y, dir.x, 0.0);
+        Base::Vector3d base = arrow.tip - dir * m_arrowSize;
+        Base::Vector3d side1 = base + norm * (m_arrowSize / 6.0);
+        Base::Vector3d side2 = base - norm * (m_arrowSize / 6.0);
+        out << "<path d=\"M" << arrow.tip.x << " " << arrow.tip.y
+            << " L" << side1.x << " " << side1.y
+            << " L" << side2.x << " " << side2.y << " Z\" />\n";
+    }
+    out << "</g>\n";
+
+    out << "<g fill=\"#000000\" stroke=\"none\" text-anchor=\"middle\" font-family=\""
+        << escapeXml(m_font) << "\">\n";
+    for (auto& text : m_texts) {
+        if (text.lines.empty()) {
+            continue;
+        }
+        //the lines are centered on the position
+        double y = text.position.y - (text.lines.size() - 1) * 0.6 * text.size;
+        for (auto& line : text.lines) {
+            out << "<text x=\"" << text.position.x << "\" y=\"" << y
+                << "\" font-size=\"" << text.size << "\">" << escapeXml(line) << "</text>\n";
+            y += 1.2 * text.size;
+        }
+    }
+    out << "</g>\n";
+    out << "</svg>\n";
+}
+
+bool SvgPageWriter::write(const std::string& fileName) const
+{
+    Base::FileInfo fi(fileName);
+    Base::ofstream out(fi, std::ios::out | std::ios::binary);
+    if (!out.is_open()) {
+        return false;
+    }
+    write(out);
+    out.close();
+    return !out.fail();
+}
+
+std::vector<std::string> SvgPageWriter::writePages(const std::vector<SvgPageWriter>& writers,
+                                                   const std::vector<std::string>& fileNames)
+{
+    std::vector<char> written(writers.size(), 0);
+    Part::Tools::parallelFor(writers.size(), [&](std::size_t i) {
+        try {
+            written[i] = writers[i].write(fileNames[i]);
+        }
+        catch (Standard_Failure&) {
+        }
+    });
+
+    std::vector<std::string> failed;
+    for (std::size_t i = 0; i < written.size(); i++) {
+        if (!written[i]) {
+            failed.push_back(fileNames[i]);
+        }
+    }
+    return failed;
+}
@@ -0,0 +1,104 @@
+/***************************************************************************
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef _SvgPageWriter_h_
+#define _SvgPageWriter_h_
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <TopoDS_Shape.hxx>
+
+#include <Base/Vector3D.h>
+
+namespace TechDraw
+{
+class DrawPage;
+class DrawViewPart;
+class DrawViewDimension;
+class DrawViewAnnotation;
+
+//! Writes a page to SVG straight from the App side geometry, without a scene.
+//! The constructor collects everything the page shows and has to run in the
+//! main thread. write() only uses the collected data, so several pages can be
+//! written concurrently.
+class TechDrawExport SvgPageWriter
+{
+public:
+    explicit SvgPageWriter(DrawPage* page);
+
+    bool write(const std::string& fileName) const;
+    void write(std::ostream& out) const;
+
+    //! write each writer's page to the file of the same index, in parallel.
+    //! Returns the names of the files which couldn't be written.
+    static std::vector<std::string> writePages(const std::vector<SvgPageWriter>& writers,
+                                               const std::vector<std::string>& fileNames);
+
+private:
+    struct ViewData
+    {
+        Base::Vector3d position;     //center of the view, y down
+        TopoDS_Shape visible;
+        TopoDS_Shape hidden;
+    };
+    struct TextData
+    {
+        Base::Vector3d position;
+        double size;
+        std::vector<std::string> lines;
+    };
+    struct LineData
+    {
+        Base::Vector3d start;
+        Base::Vector3d end;
+    };
+    struct ArrowData
+    {
+        Base::Vector3d tip;
+        Base::Vector3d direction;
+    };
+
+    void addViewPart(DrawViewPart* dvp);
+    void addDimension(DrawViewDimension* dvd);
+    void addAnnotation(DrawViewAnnotation* dva);
+    Base::Vector3d viewPosition(DrawViewPart* dvp) const;
+    void writeTemplate(std::ostream& out) const;
+
+    double m_width;
+    double m_height;
+    std::string m_templateFile;
+    double m_thickWeight;
+    double m_thinWeight;
+    double m_dimFontSize;
+    double m_arrowSize;
+    std::string m_font;
+
+    std::vector<ViewData> m_views;
+    std::vector<LineData> m_dimLines;
+    std::vector<ArrowData> m_arrows;
+    std::vector<TextData> m_texts;
+};
+
+} //namespace TechDraw
+
+#endif
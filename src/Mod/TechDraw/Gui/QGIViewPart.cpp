@@ -444,6 +444,14 @@ void QGIViewPart::drawViewPart()
         return;
     }
 //    Base::Console().Message("QGIVP::DVP() - %s / %s\n", viewPart->getNameInDocument(), viewPart->Label.getValue());
+    if (viewPart->waitingForHlr()) {
+        prepareGeometryChange();
+        removePrimitives();                      //clean the slate
+        removeDecorations();
+        drawPlaceholder(viewPart);
+        return;
+    }
+
     if (!viewPart->hasGeometry()) {
         removePrimitives();                      //clean the slate
         removeDecorations();
@@ -762,6 +770,30 @@ QGIFace* QGIViewPart::drawFace(TechDraw::Face* f, int idx)
     return gFace;
 }
 
+//! outline of the expected extent of a view whose projection is still running
+void QGIViewPart::drawPlaceholder(TechDraw::DrawViewPart* viewPart)
+{
+    Base::BoundBox3d box = viewPart->getBoundingBox();
+    if (!box.IsValid()) {
+        return;
+    }
+    QPainterPath path;
+    path.addRect(QRectF(Rez::guiX(box.MinX), Rez::guiX(box.MinY),
+                        Rez::guiX(box.LengthX()), Rez::guiX(box.LengthY())));
+
+    QGIPrimPath* item = new QGIPrimPath();
+    item->setFlag(QGraphicsItem::ItemIsSelectable, false);
+    item->setAcceptHoverEvents(false);
+    item->setNormalColor(PreferencesGui::normalQColor());
+    item->setWidth(Rez::guiX(0.1));
+    item->setStyle(Qt::DashLine);
+    addToGroup(item);                       //item is at scene(0,0), not group(0,0)
+    item->setPos(0.0,0.0);                  //now at group(0,0)
+    item->setPath(path);
+    item->setZValue(ZVALUE::EDGE);
+    item->setPrettyNormal();
+}
+
 //! Remove all existing QGIPrimPath items(Vertex,Edge,Face)
 //note this triggers scene selectionChanged signal if vertex/edge/face is selected
 void QGIViewPart::removePrimitives()
@@ -97,6 +97,7 @@ protected:
     QPainterPath drawPainterPath(TechDraw::BaseGeom *baseGeom) const;
     void drawViewPart();
     QGIFace* drawFace(TechDraw::Face* f, int idx);
+    void drawPlaceholder(TechDraw::DrawViewPart* viewPart);
 
     virtual QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
 
@@ -0,0 +1,70 @@
+# -*- coding: utf-8 -*-
+
+#  LGPL
+
+"""Benchmarks for the hidden line removal of TechDraw views.
+
+Run it from the FreeCAD Python console or with FreeCADCmd:
+
+    import TechDrawBenchmarks
+    TechDrawBenchmarks.run()
+
+The test shapes are the fused grids of boxes and cylinders of PartBenchmarks,
+real models can be passed as a list of BREP or STEP file names:
+
+    TechDrawBenchmarks.run(files=["/path/to/model.step"])
+
+Every shape is projected in the front and in an isometric direction, and the
+time of the recompute of the view and the number of visible and hidden edges
+are printed.
+"""
+
+import os, time
+import FreeCAD, Part, TechDraw
+import PartBenchmarks
+
+try:
+    from BenchmarkApp import record
+except ImportError:
+    def record(*args, **kwargs):
+        pass
+
+# number of boxes along each side of the grids
+GRID_SIZES = [4, 8, 16]
+# projection directions
+DIRECTIONS = [("front", FreeCAD.Vector(0, -1, 0)),
+              ("iso", FreeCAD.Vector(1, -1, 1))]
+
+
+def report(name, shape):
+    doc = FreeCAD.newDocument("TechDrawBenchmarks")
+    try:
+        feature = doc.addObject("Part::Feature", "Shape")
+        feature.Shape = shape
+        page = doc.addObject("TechDraw::DrawPage", "Page")
+        for label, direction in DIRECTIONS:
+            view = doc.addObject("TechDraw::DrawViewPart", "View")
+            page.addView(view)
+            view.Source = [feature]
+            view.Direction = direction
+            # time the projection, not the recompute of the source
+            feature.purgeTouched()
+            start = time.time()
+            view.recompute()
+            seconds = time.time() - start
+            edges = len(view.getVisibleEdges()) + len(view.getHiddenEdges())
+            record("TechDraw", name, seconds, direction=label, edges=edges)
+            FreeCAD.Console.PrintMessage("%-20s %-6s %10d edges %8.3f s\n"
+                                         % (name, label, edges, seconds))
+    finally:
+        FreeCAD.closeDocument(doc.Name)
+
+
+def run(files=None, sizes=None):
+    """Runs the benchmarks on the synthetic grids and the given files."""
+    for count in sizes or GRID_SIZES:
+        shape, fuseTime = PartBenchmarks.makeGrid(count)
+        report("grid(%d)" % count, shape)
+
+    for filename in files or []:
+        report(os.path.basename(filename), Part.read(filename))
@@ -0,0 +1,180 @@
+# -*- coding: utf-8 -*-
+
+#  LGPL
+
+"""Common driver for the benchmark scripts of the modules.
+
+Run all suites from the FreeCAD Python console or with FreeCADCmd:
+
+    import BenchmarkApp
+    BenchmarkApp.run()
+
+or only some of them, writing the results to a JSON file for trend tracking:
+
+    BenchmarkApp.run(["Document", "Mesh"], output="/tmp/benchmarks.json")
+
+From the build directory 'cmake --build . --target FreeCADBenchmarks' runs all
+suites and writes the results to benchmarks.json.
+
+The suites are the benchmark scripts of the modules (PartBenchmarks,
+MeshBenchmarks, ...), which can still be run on their own. Every measurement
+they report is also passed to record(), so the results of a run are collected
+in one list together with the version and platform they were taken on.
+Reference models can be passed to the suites that accept files:
+
+    BenchmarkApp.run(files={"Document": ["/path/to/model.FCStd"]})
+"""
+
+import os, sys, json, platform, tempfile, time
+import FreeCAD
+
+try:
+    import resource
+except ImportError:
+    resource = None
+
+# name, module and function of the suites
+SUITES = [
+    ("Document",     "BenchmarkApp",       "runDocument"),
+    ("Part",         "PartBenchmarks",     "run"),
+    ("Tessellation", "PartBenchmarks",     "runTessellation"),
+    ("Mesh",         "MeshBenchmarks",     "run"),
+    ("Sketcher",     "SketcherBenchmarks", "run"),
+    ("TechDraw",     "TechDrawBenchmarks", "run"),
+]
+# sizes of the synthetic parametric documents
+DOCUMENT_SIZES = [10, 50, 200]
+
+_results = []
+_suite = None
+
+
+def peakMemory():
+    """Returns the peak resident set size of the process in MB or None if unknown."""
+    if resource is None:
+        return None
+    rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # macOS reports bytes, Linux kilobytes
+    if sys.platform == "darwin":
+        return rss / (1024.0 * 1024.0)
+    return rss / 1024.0
+
+
+def record(suite, name, seconds, **values):
+    """Adds a measurement to the results of the current run.
+
+    Other values of the measurement like sizes or counts can be passed as
+    keyword arguments. The suite is overridden by the one that is running.
+    """
+    entry = {"suite": _suite or suite, "name": name, "seconds": seconds}
+    entry.update(values)
+    rss = peakMemory()
+    if rss is not None:
+        entry["peakRSS"] = rss
+    _results.append(entry)
+    return entry
+
+
+def results():
+    """Returns the measurements recorded so far."""
+    return list(_results)
+
+
+def makeDocument(count, name="DocumentBenchmark"):
+    """Returns a document with count boxes, each drilled by a cylinder."""
+    doc = FreeCAD.newDocument(name)
+    for i in range(count):
+        box = doc.addObject("Part::Box", "Box")
+        box.Placement.Base = FreeCAD.Vector(i * 20, 0, 0)
+        cyl = doc.addObject("Part::Cylinder", "Cylinder")
+        cyl.Radius = 3
+        cyl.Height = 20
+        cyl.Placement.Base = FreeCAD.Vector(i * 20 + 5, 5, -5)
+        cut = doc.addObject("Part::Cut", "Cut")
+        cut.Base = box
+        cut.Tool = cyl
+    return doc
+
+
+def benchmarkDocument(name, doc, directory):
+    """Recomputes, saves and reopens the document, which is closed afterwards."""
+    def report(operation, seconds):
+        record("Document", name, seconds, operation=operation, objects=len(doc.Objects))
+        FreeCAD.Console.PrintMessage("%-20s %-10s %6d objects %8.3f s\n"
+                                     % (name, operation, len(doc.Objects), seconds))
+
+    for obj in doc.Objects:
+        obj.touch()
+    start = time.time()
+    doc.recompute()
+    report("recompute", time.time() - start)
+
+    filename = os.path.join(directory, "document_benchmark.FCStd")
+    start = time.time()
+    doc.saveAs(filename)
+    report("save", time.time() - start)
+    FreeCAD.closeDocument(doc.Name)
+
+    try:
+        start = time.time()
+        doc = FreeCAD.openDocument(filename)
+        report("open", time.time() - start)
+        FreeCAD.closeDocument(doc.Name)
+    finally:
+        os.remove(filename)
+
+
+def runDocument(files=None, sizes=None, directory=None):
+    """Times recompute, save and open of synthetic documents and the given files."""
+    if directory is None:
+        directory = tempfile.gettempdir()
+    for count in sizes or DOCUMENT_SIZES:
+        benchmarkDocument("cuts(%d)" % count, makeDocument(count), directory)
+
+    for filename in files or []:
+        benchmarkDocument(os.path.basename(filename), FreeCAD.openDocument(filename), directory)
+
+
+def run(suites=None, output=None, files=None):
+    """Runs the given suites, or all, and returns the recorded results.
+
+    files maps suite names to lists of files passed to the suite. If output is
+    given the results are written to it as JSON.
+    """
+    global _suite
+    del _results[:]
+    start = time.time()
+    for name, module, function in SUITES:
+        if suites is not None and name not in suites:
+            continue
+        try:
+            func = getattr(__import__(module), function)
+        except ImportError as e:
+            FreeCAD.Console.PrintWarning("Skipping benchmark suite %s: %s\n" % (name, str(e)))
+            continue
+
+        FreeCAD.Console.PrintMessage("--- %s ---\n" % name)
+        _suite = name
+        try:
+            if files and name in files:
+                func(files=files[name])
+            else:
+                func()
+        except Exception as e:
+            FreeCAD.Console.PrintError("Benchmark suite %s failed: %s\n" % (name, str(e)))
+            _results.append({"suite": name, "name": "failure", "error": str(e)})
+        finally:
+            _suite = None
+
+    if output:
+        data = {
+            "version": ".".join(FreeCAD.Version()[0:3]),
+            "platform": platform.platform(),
+            "python": platform.python_version(),
+            "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+            "seconds": time.time() - start,
+            "results": _results,
+        }
+        with open(output, "w") as f:
+            json.dump(data, f, indent=2)
+    return results()
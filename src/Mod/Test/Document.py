@@ -111,6 +111,33 @@ class DocumentBasicCases(unittest.TestCase):
     L1 = self.Doc.removeObject("Label")
     self.Doc.commitTransaction()
 
+  def testUniqueNames(self):
+    objs = self.Doc.addObjects("App::FeatureTest", ["Box", "Box", "", "Box1"])
+    self.assertEqual([o.Name for o in objs], ["Box", "Box001", "FeatureTest", "Box1"])
+    self.assertEqual(self.Doc.addObject("App::FeatureTest", "Box").Name, "Box002")
+    self.Doc.removeObject("Box001")
+    self.Doc.removeObject("Box002")
+    # the highest remaining suffix is '1'
+    self.assertEqual(self.Doc.addObject("App::FeatureTest", "Box").Name, "Box002")
+    self.Doc.removeObject("Box1")
+    self.Doc.removeObject("Box002")
+    self.assertEqual(self.Doc.addObject("App::FeatureTest", "Box").Name, "Box001")
+
+  def testLabelIndex(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Label")
+    L1.Label = "Relabeled"
+    self.assertEqual(self.Doc.getObjectsByLabel("Label"), [])
+    self.assertEqual(self.Doc.getObjectsByLabel("Relabeled"), [L1])
+    L2 = self.Doc.addObject("App::FeatureTest","Other")
+    L2.Label = "Relabeled"
+    self.assertEqual(L2.Label, "Relabeled001")
+    self.Doc.openTransaction("Rem")
+    self.Doc.removeObject(L1.Name)
+    self.Doc.commitTransaction()
+    self.assertEqual(self.Doc.getObjectsByLabel("Relabeled"), [])
+    self.Doc.undo()
+    self.assertEqual(len(self.Doc.getObjectsByLabel("Relabeled")), 1)
+
   def testObjects(self):
     L1 = self.Doc.addObject("App::FeatureTest","Label_1")
     #call members to check for errors in ref counting
@@ -606,6 +633,57 @@ class DocumentRecomputeCases(unittest.TestCase):
     self.Doc.removeObject(L7.Name)
     self.Doc.removeObject(L8.Name)
 
+  def testDependencyCache(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Label_1")
+    L2 = self.Doc.addObject("App::FeatureTest","Label_2")
+    L3 = self.Doc.addObject("App::FeatureTest","Label_3")
+    L1.Link = L2
+    L2.Link = L3
+    self.Doc.recompute()
+    stats = self.Doc.getDependencyCacheStats()
+
+    # no link changed, so the cached order must be reused
+    L3.enforceRecompute()
+    self.failUnless(self.Doc.recompute()==3)
+    newStats = self.Doc.getDependencyCacheStats()
+    self.failUnless(newStats["Rebuilds"] == stats["Rebuilds"])
+    self.failUnless(newStats["Hits"] > stats["Hits"])
+
+    # changing a link invalidates the cache and the new order is respected
+    L1.Link = None
+    L3.Link = L1
+    self.Doc.recompute()
+    newStats = self.Doc.getDependencyCacheStats()
+    self.failUnless(newStats["Rebuilds"] > stats["Rebuilds"])
+    L1.enforceRecompute()
+    self.failUnless(self.Doc.recompute()==3)
+    self.failUnless((L1.ExecCount,L2.ExecCount,L3.ExecCount) == (4,4,3))
+
+  def testRecomputeProfile(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Label_1")
+    L2 = self.Doc.addObject("App::FeatureTest","Label_2")
+    L1.Link = L2
+    L2.Integer = 2
+    self.Doc.RecomputeProfiling = True
+    self.Doc.recompute()
+    L2.enforceRecompute()
+    self.Doc.recompute()
+    self.Doc.RecomputeProfiling = False
+    profile = dict((entry["Name"], entry) for entry in self.Doc.getRecomputeProfile(True))
+    self.failUnless(profile[L1.Name]["Count"] == 2)
+    self.failUnless(profile[L2.Name]["Count"] == 2)
+    self.failUnless(profile[L1.Name]["WallTime"] >= 0.0)
+    self.failUnless(len(self.Doc.getRecomputeProfile()) == 0)
+
+    import json
+    self.Doc.RecomputeProfiling = True
+    L2.enforceRecompute()
+    self.Doc.recompute()
+    trace = json.loads(self.Doc.exportRecomputeProfile(None, True))
+    self.failUnless(len(trace["traceEvents"]) == 2)
+    self.failUnless(len(json.loads(self.Doc.exportRecomputeProfile())) == 2)
+    self.Doc.RecomputeProfiling = False
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument("RecomputeTests")
@@ -646,6 +724,32 @@ class UndoRedoCases(unittest.TestCase):
     # switch on the Undo OFF
     self.Doc.UndoMode = 0
 
+  def testUndoMemoryLimit(self):
+    self.Doc.UndoMode = 1
+    self.Doc.UndoMemoryLimit = 1024
+    self.assertEqual(self.Doc.UndoMemoryLimit, 1024)
+    obj = self.Doc.getObject("Base")
+    values = [float(i) for i in range(10000)]
+    obj.FloatList = values
+
+    # each step changes a single element of a large list
+    for i in range(5):
+      self.Doc.openTransaction("Step%d" % i)
+      changed = list(obj.FloatList)
+      changed[i] = -1.0
+      obj.FloatList = changed
+      self.Doc.commitTransaction()
+    self.assertTrue(self.Doc.UndoRedoMemSize > 0)
+
+    for i in range(5):
+      self.Doc.undo()
+    self.assertEqual(obj.FloatList, values)
+    for i in range(5):
+      self.Doc.redo()
+    self.assertEqual(obj.FloatList[:5], [-1.0]*5)
+    self.assertEqual(obj.FloatList[5:], values[5:])
+    self.Doc.UndoMemoryLimit = 0
+
   def testUndoClear(self):
     # switch on the Undo
     self.Doc.UndoMode = 1
@@ -1406,6 +1510,29 @@ class DocumentExpressionCases(unittest.TestCase):
     # must not raise a topological error
     self.assertEqual(self.Doc.recompute(), 2)
 
+  def testArithmeticExpression(self):
+    self.Obj1.Integer = 3
+    self.Obj1.Distance = 2
+    self.Obj2.setExpression('Float', u'%s.Integer * 2.5 + -1' % self.Obj1.Name)
+    self.Obj2.setExpression('Integer', u'%s.Integer ^ 2 - 1' % self.Obj1.Name)
+    self.Obj2.setExpression('Distance', u'%s.Distance * 3 + 1 mm' % self.Obj1.Name)
+    self.Doc.recompute()
+    self.assertAlmostEqual(self.Obj2.Float, 6.5)
+    self.assertEqual(self.Obj2.Integer, 8)
+    self.assertAlmostEqual(self.Obj2.Distance.Value, 7.0)
+    # the values must follow the referenced properties
+    self.Obj1.Integer = 4
+    self.Obj1.Distance = 1
+    self.Doc.recompute()
+    self.assertAlmostEqual(self.Obj2.Float, 9.0)
+    self.assertEqual(self.Obj2.Integer, 15)
+    self.assertAlmostEqual(self.Obj2.Distance.Value, 4.0)
+    # a bound property changed by hand must be evaluated again, even if the
+    # inputs are the same
+    self.Obj2.Float = 1.0
+    self.Doc.recompute()
+    self.assertAlmostEqual(self.Obj2.Float, 9.0)
+
   def tearDown(self):
     #closing doc
     FreeCAD.closeDocument(self.Doc.Name)
@@ -1973,6 +2100,27 @@ class DocumentObserverCases(unittest.TestCase):
 
     FreeCAD.Gui.removeDocumentObserver(self.GuiObs)
 
+  def testBatchUpdate(self):
+    self.Doc1 = FreeCAD.newDocument("Observer1")
+    obj = self.Doc1.addObject("App::FeatureTest","obj")
+    self.Obs.signal = []
+    self.Obs.parameter = []
+    self.Obs.parameter2 = []
+    with FreeCAD.BatchUpdate(self.Doc1):
+      for i in range(10):
+        obj.Integer = i
+        obj.Float = float(i)
+      self.assertEqual(self.Obs.signal.count('ObjChanged'), 0)
+    changes = list(zip(self.Obs.signal, self.Obs.parameter2))
+    self.assertEqual(changes.count(('ObjBeforeChange','Integer')), 1)
+    self.assertEqual(changes.count(('ObjChanged','Integer')), 1)
+    self.assertEqual(changes.count(('ObjChanged','Float')), 1)
+    self.assertEqual(obj.Integer, 9)
+    FreeCAD.closeDocument(self.Doc1.Name)
+    self.Obs.signal = []
+    self.Obs.parameter = []
+    self.Obs.parameter2 = []
+
   def tearDown(self):
     #closing doc
     FreeCAD.removeDocumentObserver(self.Obs)
@@ -93,6 +93,17 @@ class UnitBasicCases(unittest.TestCase):
         qu2 = FreeCAD.Units.Quantity("m/s")
         self.assertTrue(qu1/qu2, 1)
 
+    def testSimpleQuantities(self):
+        # simple input is handled without the generated parser, the
+        # expressions in parentheses always go through the parser
+        for simple in ["10 mm", "-2.5e3kg", "1,5 m", ".5 in", "3\"", "4'", "90 \xb0", "7", " 12 N "]:
+            qu1 = FreeCAD.Units.Quantity(simple)
+            unit = simple.strip().lstrip("-.,0123456789e")
+            number = simple.strip()[:len(simple.strip()) - len(unit)]
+            qu2 = FreeCAD.Units.Quantity("({}) {}".format(number, unit))
+            self.assertEqual(qu1.Unit, qu2.Unit, simple)
+            self.assertTrue(compare(qu1.Value, qu2.Value), simple)
+
     def testSchemes(self):
         schemes = FreeCAD.Units.listSchemas()
         num = len(schemes)